@@ -151,6 +151,8 @@ void CPL_DLL GDALUnregisterTransformDeserializer(void* pData);
 
 void GDALCleanupTransformDeserializerMutex();
 
+void GDALCleanupRPCDEMCacheMutex();
+
 /* Transformer cloning */
 
 void* GDALCreateTPSTransformerInt( int nGCPCount, const GDAL_GCP *pasGCPList,
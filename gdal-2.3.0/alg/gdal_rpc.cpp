@@ -36,14 +36,20 @@
 #include <cstring>
 
 #include <algorithm>
+#include <memory>
+#include <new>
 #include <string>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_mem_cache.h"
 #include "cpl_minixml.h"
+#include "cpl_multiproc.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
 #include "gdal.h"
+#include "gdal_alg_priv.h"
 #include "gdal_mdreader.h"
 #include "gdal_priv.h"
 #if defined(__x86_64) || defined(_M_X64)
@@ -66,6 +72,20 @@ CPL_C_END
 constexpr int MAX_ABS_VALUE_WARNINGS = 20;
 constexpr double DEFAULT_PIX_ERR_THRESHOLD = 0.1;
 
+// Number of points evaluated at once by RPCTransformPoints() callers.
+constexpr int RPC_BATCH_SIZE = 64;
+
+// Maximum distance, in pixels, between two consecutive points of the
+// inverse transform for the solution of the first one to be used as the
+// initial guess of the second one.
+constexpr double RPC_WARM_START_MAX_DIST = 16.0;
+
+// Dimension of the DEM tiles shared between transformers.
+constexpr int RPC_DEM_TILE_SIZE = 256;
+
+// Number of tiles an individual transformer keeps references to.
+constexpr int RPC_DEM_TILE_SLOTS = 4;
+
 /************************************************************************/
 /*                            RPCInfoToMD()                             */
 /*                                                                      */
@@ -204,6 +224,101 @@ static void RPCComputeTerms( double dfLong, double dfLat, double dfHeight,
 /* ==================================================================== */
 /************************************************************************/
 
+/************************************************************************/
+/*                         GDALRPCDEMTileCache                          */
+/*                                                                      */
+/*      Tiles of the first band of a DEM, read as doubles, shared by    */
+/*      all the RPC transformers using that DEM (typically one per      */
+/*      warping thread).  Each transformer reads the missing tiles      */
+/*      through its own dataset handle.  The list of caches, the        */
+/*      reference counts and the LRU caches are protected by            */
+/*      hRPCDEMCacheMutex.                                              */
+/************************************************************************/
+
+typedef std::shared_ptr<std::vector<double>> GDALRPCDEMTilePtr;
+
+typedef struct GDALRPCDEMTileCache
+{
+    CPLString   osDEMPath{};
+    int         nRefCount = 0;
+    lru11::Cache<int, GDALRPCDEMTilePtr> oCache;
+    GDALRPCDEMTileCache *psNext = nullptr;
+
+    explicit GDALRPCDEMTileCache( size_t nMaxTiles ) : oCache(nMaxTiles, 0) {}
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALRPCDEMTileCache)
+} GDALRPCDEMTileCache;
+
+static CPLMutex *hRPCDEMCacheMutex = nullptr;
+static GDALRPCDEMTileCache *psRPCDEMCacheList = nullptr;
+
+/************************************************************************/
+/*                     GDALRPCAcquireDEMTileCache()                     */
+/*                                                                      */
+/*      Returns nullptr if the cache is disabled with                   */
+/*      GDAL_RPC_DEM_CACHE_MAX=0.                                       */
+/************************************************************************/
+
+static GDALRPCDEMTileCache *GDALRPCAcquireDEMTileCache( const char* pszDEMPath )
+{
+    // In MB.
+    const int nCacheMax =
+        atoi(CPLGetConfigOption("GDAL_RPC_DEM_CACHE_MAX", "64"));
+    if( nCacheMax <= 0 )
+        return nullptr;
+
+    CPLMutexHolderD( &hRPCDEMCacheMutex );
+    for( GDALRPCDEMTileCache *psIter = psRPCDEMCacheList; psIter != nullptr;
+         psIter = psIter->psNext )
+    {
+        if( psIter->osDEMPath == pszDEMPath )
+        {
+            psIter->nRefCount++;
+            return psIter;
+        }
+    }
+
+    const size_t nMaxTiles = std::max(static_cast<size_t>(1),
+        static_cast<size_t>(nCacheMax) * 1024 * 1024 /
+            (RPC_DEM_TILE_SIZE * RPC_DEM_TILE_SIZE * sizeof(double)));
+    GDALRPCDEMTileCache *psCache = new GDALRPCDEMTileCache(nMaxTiles);
+    psCache->osDEMPath = pszDEMPath;
+    psCache->nRefCount = 1;
+    psCache->psNext = psRPCDEMCacheList;
+    psRPCDEMCacheList = psCache;
+    return psCache;
+}
+
+/************************************************************************/
+/*                     GDALRPCReleaseDEMTileCache()                     */
+/************************************************************************/
+
+static void GDALRPCReleaseDEMTileCache( GDALRPCDEMTileCache *psCache )
+{
+    CPLMutexHolderD( &hRPCDEMCacheMutex );
+    if( --psCache->nRefCount > 0 )
+        return;
+
+    GDALRPCDEMTileCache **ppsIter = &psRPCDEMCacheList;
+    while( *ppsIter != psCache )
+        ppsIter = &((*ppsIter)->psNext);
+    *ppsIter = psCache->psNext;
+    delete psCache;
+}
+
+/************************************************************************/
+/*                    GDALCleanupRPCDEMCacheMutex()                     */
+/************************************************************************/
+
+void GDALCleanupRPCDEMCacheMutex()
+{
+    if( hRPCDEMCacheMutex != nullptr )
+    {
+        CPLDestroyMutex(hRPCDEMCacheMutex);
+        hRPCDEMCacheMutex = nullptr;
+    }
+}
+
 /*! DEM Resampling Algorithm */
 typedef enum {
   /*! Nearest neighbour (select on one input pixel) */ DRA_NearestNeighbour=0,
@@ -263,6 +378,15 @@ typedef struct {
 
     bool        bRPCInverseVerbose;
     char       *pszRPCInverseLog;
+
+    // Shared cache of DEM tiles (nullptr if disabled), and the tiles most
+    // recently used by this transformer, so that they can be accessed
+    // without locking.
+    GDALRPCDEMTileCache *psDEMTileCache;
+    GDALRPCDEMTilePtr apoDEMTiles[RPC_DEM_TILE_SLOTS];
+    int         anDEMTileX[RPC_DEM_TILE_SLOTS];
+    int         anDEMTileY[RPC_DEM_TILE_SLOTS];
+    int         iNextDEMTileSlot;
 } GDALRPCTransformInfo;
 
 static bool GDALRPCOpenDEM( GDALRPCTransformInfo* psTransform );
@@ -334,19 +458,15 @@ static double RPCEvaluate( const double *padfTerms, const double *padfCoefs )
 #endif
 
 /************************************************************************/
-/*                         RPCTransformPoint()                          */
+/*                           RPCNormalize()                             */
 /************************************************************************/
 
-static void RPCTransformPoint( const GDALRPCTransformInfo *psRPCTransformInfo,
-                               double dfLong, double dfLat, double dfHeight,
-                               double *pdfPixel, double *pdfLine )
+static void RPCNormalize( const GDALRPCTransformInfo *psRPCTransformInfo,
+                          double dfLong, double dfLat, double dfHeight,
+                          double *pdfNormalizedLong, double *pdfNormalizedLat,
+                          double *pdfNormalizedHeight )
 
 {
-    double adfTermsWithMargin[20+1] = {};
-    // Make padfTerms aligned on 16-byte boundary for SSE2 aligned loads.
-    double* padfTerms =
-        adfTermsWithMargin + (reinterpret_cast<GUIntptr_t>(adfTermsWithMargin) % 16) / 8;
-
     // Avoid dateline issues.
     double diffLong = dfLong - psRPCTransformInfo->sRPC.dfLONG_OFF;
     if( diffLong < -270 )
@@ -413,6 +533,31 @@ static void RPCTransformPoint( const GDALRPCTransformInfo *psRPCTransformInfo,
         }
     }
 
+    *pdfNormalizedLong = dfNormalizedLong;
+    *pdfNormalizedLat = dfNormalizedLat;
+    *pdfNormalizedHeight = dfNormalizedHeight;
+}
+
+/************************************************************************/
+/*                         RPCTransformPoint()                          */
+/************************************************************************/
+
+static void RPCTransformPoint( const GDALRPCTransformInfo *psRPCTransformInfo,
+                               double dfLong, double dfLat, double dfHeight,
+                               double *pdfPixel, double *pdfLine )
+
+{
+    double adfTermsWithMargin[20+1] = {};
+    // Make padfTerms aligned on 16-byte boundary for SSE2 aligned loads.
+    double* padfTerms =
+        adfTermsWithMargin + (reinterpret_cast<GUIntptr_t>(adfTermsWithMargin) % 16) / 8;
+
+    double dfNormalizedLong = 0.0;
+    double dfNormalizedLat = 0.0;
+    double dfNormalizedHeight = 0.0;
+    RPCNormalize( psRPCTransformInfo, dfLong, dfLat, dfHeight,
+                  &dfNormalizedLong, &dfNormalizedLat, &dfNormalizedHeight );
+
     RPCComputeTerms( dfNormalizedLong, dfNormalizedLat,
                      dfNormalizedHeight, padfTerms );
 
@@ -444,6 +589,164 @@ static void RPCTransformPoint( const GDALRPCTransformInfo *psRPCTransformInfo,
         + psRPCTransformInfo->sRPC.dfLINE_OFF + 0.5;
 }
 
+/************************************************************************/
+/*                         RPCTransformPoints()                         */
+/*                                                                      */
+/*      Same as RPCTransformPoint() on nCount points.  The output       */
+/*      arrays may be the same as the input ones.  With SSE2, two       */
+/*      points are evaluated at once, each lane of the registers        */
+/*      holding one point, and the terms are accumulated in the same    */
+/*      order as RPCEvaluate4() so that results are identical.          */
+/************************************************************************/
+
+static void RPCTransformPoints( const GDALRPCTransformInfo *psRPCTransformInfo,
+                                int nCount,
+                                const double *padfLong, const double *padfLat,
+                                const double *padfHeight,
+                                double *padfPixel, double *padfLine )
+
+{
+    int i = 0;  // Used after for.
+#ifdef USE_SSE2_OPTIM
+    const double* padfCoeffs = psRPCTransformInfo->padfCoeffs;
+    const XMMReg2Double sampScale = XMMReg2Double::Load1ValHighAndLow(
+        &psRPCTransformInfo->sRPC.dfSAMP_SCALE);
+    const XMMReg2Double sampOff = XMMReg2Double::Load1ValHighAndLow(
+        &psRPCTransformInfo->sRPC.dfSAMP_OFF);
+    const XMMReg2Double lineScale = XMMReg2Double::Load1ValHighAndLow(
+        &psRPCTransformInfo->sRPC.dfLINE_SCALE);
+    const XMMReg2Double lineOff = XMMReg2Double::Load1ValHighAndLow(
+        &psRPCTransformInfo->sRPC.dfLINE_OFF);
+    const double dfOne = 1.0;
+    const double dfHalf = 0.5;
+    const XMMReg2Double one = XMMReg2Double::Load1ValHighAndLow(&dfOne);
+    const XMMReg2Double half = XMMReg2Double::Load1ValHighAndLow(&dfHalf);
+
+    for( ; i + 1 < nCount; i += 2 )
+    {
+        double adfNormalizedLong[2] = {};
+        double adfNormalizedLat[2] = {};
+        double adfNormalizedHeight[2] = {};
+        for( int j = 0; j < 2; j++ )
+        {
+            RPCNormalize( psRPCTransformInfo,
+                          padfLong[i+j], padfLat[i+j], padfHeight[i+j],
+                          adfNormalizedLong + j, adfNormalizedLat + j,
+                          adfNormalizedHeight + j );
+        }
+        const XMMReg2Double L = XMMReg2Double::Load2Val(adfNormalizedLong);
+        const XMMReg2Double P = XMMReg2Double::Load2Val(adfNormalizedLat);
+        const XMMReg2Double H = XMMReg2Double::Load2Val(adfNormalizedHeight);
+
+        // Same as RPCComputeTerms().
+        XMMReg2Double aTerms[20];
+        aTerms[0] = one;
+        aTerms[1] = L;
+        aTerms[2] = P;
+        aTerms[3] = H;
+        aTerms[4] = L * P;
+        aTerms[5] = L * H;
+        aTerms[6] = P * H;
+        aTerms[7] = L * L;
+        aTerms[8] = P * P;
+        aTerms[9] = H * H;
+        aTerms[10] = L * P * H;
+        aTerms[11] = L * L * L;
+        aTerms[12] = L * P * P;
+        aTerms[13] = L * H * H;
+        aTerms[14] = L * L * P;
+        aTerms[15] = P * P * P;
+        aTerms[16] = P * H * H;
+        aTerms[17] = L * L * H;
+        aTerms[18] = P * P * H;
+        aTerms[19] = H * H * H;
+
+        // LINE_NUM_COEFF, LINE_DEN_COEFF, SAMP_NUM_COEFF and SAMP_DEN_COEFF,
+        // for the even and odd terms.
+        XMMReg2Double aSumEven[4];
+        XMMReg2Double aSumOdd[4];
+        for( int k = 0; k < 4; k++ )
+        {
+            aSumEven[k] = XMMReg2Double::Zero();
+            aSumOdd[k] = XMMReg2Double::Zero();
+        }
+        for( int iTerm = 0; iTerm < 20; iTerm += 2 )
+        {
+            for( int k = 0; k < 4; k++ )
+            {
+                aSumEven[k] += aTerms[iTerm] *
+                    XMMReg2Double::Load1ValHighAndLow(
+                        padfCoeffs + 20 * k + iTerm);
+                aSumOdd[k] += aTerms[iTerm + 1] *
+                    XMMReg2Double::Load1ValHighAndLow(
+                        padfCoeffs + 20 * k + iTerm + 1);
+            }
+        }
+        const XMMReg2Double resultX =
+            (aSumEven[2] + aSumOdd[2]) / (aSumEven[3] + aSumOdd[3]);
+        const XMMReg2Double resultY =
+            (aSumEven[0] + aSumOdd[0]) / (aSumEven[1] + aSumOdd[1]);
+
+        // See RPCTransformPoint() for the 0.5 shift.
+        const XMMReg2Double pixel = resultX * sampScale + sampOff + half;
+        const XMMReg2Double line = resultY * lineScale + lineOff + half;
+        pixel.Store2Val(padfPixel + i);
+        line.Store2Val(padfLine + i);
+    }
+#endif
+    for( ; i < nCount; i++ )
+    {
+        RPCTransformPoint( psRPCTransformInfo,
+                           padfLong[i], padfLat[i], padfHeight[i],
+                           padfPixel + i, padfLine + i );
+    }
+}
+
+/************************************************************************/
+/*                   RPCTransformPointsWithHeight()                     */
+/*                                                                      */
+/*      Transforms in place the points for which panSuccess[] is set,   */
+/*      using their heights in padfHeight[], by batches of              */
+/*      RPC_BATCH_SIZE points.                                          */
+/************************************************************************/
+
+static void
+RPCTransformPointsWithHeight( const GDALRPCTransformInfo *psRPCTransformInfo,
+                              int nPointCount,
+                              double *padfX, double *padfY,
+                              const double *padfHeight,
+                              const int *panSuccess )
+{
+    double adfLong[RPC_BATCH_SIZE];
+    double adfLat[RPC_BATCH_SIZE];
+    double adfHeight[RPC_BATCH_SIZE];
+    int anIndex[RPC_BATCH_SIZE];
+    int nBatchCount = 0;
+    for( int i = 0; i < nPointCount; i++ )
+    {
+        if( panSuccess[i] )
+        {
+            adfLong[nBatchCount] = padfX[i];
+            adfLat[nBatchCount] = padfY[i];
+            adfHeight[nBatchCount] = padfHeight[i];
+            anIndex[nBatchCount] = i;
+            nBatchCount++;
+        }
+        if( nBatchCount == RPC_BATCH_SIZE ||
+            (nBatchCount > 0 && i == nPointCount - 1) )
+        {
+            RPCTransformPoints( psRPCTransformInfo, nBatchCount,
+                                adfLong, adfLat, adfHeight, adfLong, adfLat );
+            for( int j = 0; j < nBatchCount; j++ )
+            {
+                padfX[anIndex[j]] = adfLong[j];
+                padfY[anIndex[j]] = adfLat[j];
+            }
+            nBatchCount = 0;
+        }
+    }
+}
+
 /************************************************************************/
 /*                     GDALSerializeRPCDEMResample()                    */
 /************************************************************************/
@@ -697,6 +1000,12 @@ retry:
  * makes sense when debugging point by point, since each time
  * RPCInverseTransformPoint() is called, the file is rewritten).
  *
+ * When a DEM is used, its values are read by tiles that are shared by all the
+ * RPC transformers using the same DEM, such as the ones of the different
+ * threads of a multi-threaded warping operation. The GDAL_RPC_DEM_CACHE_MAX
+ * configuration option sets the maximum size of the cache of tiles of each
+ * DEM, in megabytes (default 64). Setting it to 0 disables this cache.
+ *
  * Additional options to the transformer can be supplied in papszOptions.
  *
  * Options:
@@ -767,8 +1076,8 @@ void *GDALCreateRPCTransformer( GDALRPCInfo *psRPCInfo, int bReversed,
 /* -------------------------------------------------------------------- */
 /*      Initialize core info.                                           */
 /* -------------------------------------------------------------------- */
-    GDALRPCTransformInfo *psTransform = static_cast<GDALRPCTransformInfo *>(
-        CPLCalloc(sizeof(GDALRPCTransformInfo), 1));
+    // Value-initialization zeroes the plain members.
+    GDALRPCTransformInfo *psTransform = new GDALRPCTransformInfo();
 
     memcpy( &(psTransform->sRPC), psRPCInfo, sizeof(GDALRPCInfo) );
     psTransform->bReversed = bReversed;
@@ -1023,8 +1332,12 @@ void GDALDestroyRPCTransformer( void *pTransformAlg )
         OCTDestroyCoordinateTransformation(
             reinterpret_cast<OGRCoordinateTransformationH>(psTransform->poCT));
     CPLFree( psTransform->pszRPCInverseLog );
+    for( int i = 0; i < RPC_DEM_TILE_SLOTS; i++ )
+        psTransform->apoDEMTiles[i].reset();
+    if( psTransform->psDEMTileCache )
+        GDALRPCReleaseDEMTileCache( psTransform->psDEMTileCache );
 
-    CPLFree( pTransformAlg );
+    delete psTransform;
 }
 
 /************************************************************************/
@@ -1034,7 +1347,8 @@ void GDALDestroyRPCTransformer( void *pTransformAlg )
 static bool
 RPCInverseTransformPoint( GDALRPCTransformInfo *psTransform,
                           double dfPixel, double dfLine, double dfUserHeight,
-                          double *pdfLong, double *pdfLat )
+                          double *pdfLong, double *pdfLat,
+                          const double* padfInitLongLat = nullptr )
 
 {
     // Memo:
@@ -1043,17 +1357,29 @@ RPCInverseTransformPoint( GDALRPCTransformInfo *psTransform,
 
 /* -------------------------------------------------------------------- */
 /*      Compute an initial approximation based on linear                */
-/*      interpolation from our reference point.                         */
+/*      interpolation from our reference point, unless the caller       */
+/*      provided one (typically derived from the solution for a         */
+/*      neighbouring point).                                            */
 /* -------------------------------------------------------------------- */
-    double dfResultX =
-        psTransform->adfPLToLatLongGeoTransform[0] +
-        psTransform->adfPLToLatLongGeoTransform[1] * dfPixel +
-        psTransform->adfPLToLatLongGeoTransform[2] * dfLine;
-
-    double dfResultY =
-        psTransform->adfPLToLatLongGeoTransform[3] +
-        psTransform->adfPLToLatLongGeoTransform[4] * dfPixel +
-        psTransform->adfPLToLatLongGeoTransform[5] * dfLine;
+    double dfResultX = 0.0;
+    double dfResultY = 0.0;
+    if( padfInitLongLat != nullptr )
+    {
+        dfResultX = padfInitLongLat[0];
+        dfResultY = padfInitLongLat[1];
+    }
+    else
+    {
+        dfResultX =
+            psTransform->adfPLToLatLongGeoTransform[0] +
+            psTransform->adfPLToLatLongGeoTransform[1] * dfPixel +
+            psTransform->adfPLToLatLongGeoTransform[2] * dfLine;
+
+        dfResultY =
+            psTransform->adfPLToLatLongGeoTransform[3] +
+            psTransform->adfPLToLatLongGeoTransform[4] * dfPixel +
+            psTransform->adfPLToLatLongGeoTransform[5] * dfLine;
+    }
 
     if( psTransform->bRPCInverseVerbose )
     {
@@ -1303,6 +1629,125 @@ double BiCubicKernel( double dfVal )
         0.16666666666666666667 * (a - (4.0 * b) + (6.0 * c) - (4.0 * d));
 }
 
+/************************************************************************/
+/*                          GDALRPCGetDEMTile()                         */
+/*                                                                      */
+/*      Returns the tile (nTileX, nTileY) of the DEM, looking first in  */
+/*      the tiles recently used by this transformer, then in the        */
+/*      shared cache, and finally reading it from the DEM.              */
+/************************************************************************/
+
+static const double* GDALRPCGetDEMTile( GDALRPCTransformInfo *psTransform,
+                                        int nTileX, int nTileY )
+{
+    for( int i = 0; i < RPC_DEM_TILE_SLOTS; i++ )
+    {
+        if( psTransform->apoDEMTiles[i] &&
+            psTransform->anDEMTileX[i] == nTileX &&
+            psTransform->anDEMTileY[i] == nTileY )
+        {
+            return psTransform->apoDEMTiles[i]->data();
+        }
+    }
+
+    const int nRasterXSize = psTransform->poDS->GetRasterXSize();
+    const int nRasterYSize = psTransform->poDS->GetRasterYSize();
+    const int nTilesPerRow =
+        (nRasterXSize + RPC_DEM_TILE_SIZE - 1) / RPC_DEM_TILE_SIZE;
+    const int nKey = nTileY * nTilesPerRow + nTileX;
+
+    GDALRPCDEMTilePtr poTile;
+    bool bFound = false;
+    {
+        CPLMutexHolderD( &hRPCDEMCacheMutex );
+        bFound = psTransform->psDEMTileCache->oCache.tryGet(nKey, poTile);
+    }
+    if( !bFound )
+    {
+        // Read outside of the lock, so that transformers with a miss on
+        // different tiles do not wait for each other. Two transformers might
+        // occasionally read the same tile, which is harmless.
+        const int nXOff = nTileX * RPC_DEM_TILE_SIZE;
+        const int nYOff = nTileY * RPC_DEM_TILE_SIZE;
+        const int nXSize = std::min(RPC_DEM_TILE_SIZE, nRasterXSize - nXOff);
+        const int nYSize = std::min(RPC_DEM_TILE_SIZE, nRasterYSize - nYOff);
+        try
+        {
+            poTile = std::make_shared<std::vector<double>>(
+                static_cast<size_t>(nXSize) * nYSize);
+        }
+        catch( const std::bad_alloc& )
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate DEM tile");
+            return nullptr;
+        }
+        if( psTransform->poDS->GetRasterBand(1)->RasterIO(
+                GF_Read, nXOff, nYOff, nXSize, nYSize,
+                poTile->data(), nXSize, nYSize,
+                GDT_Float64, 0, 0, nullptr) != CE_None )
+        {
+            return nullptr;
+        }
+        CPLMutexHolderD( &hRPCDEMCacheMutex );
+        psTransform->psDEMTileCache->oCache.insert(nKey, poTile);
+    }
+
+    const int iSlot = psTransform->iNextDEMTileSlot;
+    psTransform->iNextDEMTileSlot = (iSlot + 1) % RPC_DEM_TILE_SLOTS;
+    psTransform->apoDEMTiles[iSlot] = poTile;
+    psTransform->anDEMTileX[iSlot] = nTileX;
+    psTransform->anDEMTileY[iSlot] = nTileY;
+    return poTile->data();
+}
+
+/************************************************************************/
+/*                        GDALRPCReadDEMTiles()                         */
+/*                                                                      */
+/*      Reads a window of the DEM, that must be within its extent,      */
+/*      from the shared tiles.                                          */
+/************************************************************************/
+
+static bool GDALRPCReadDEMTiles( GDALRPCTransformInfo *psTransform,
+                                 int nX, int nY, int nWidth, int nHeight,
+                                 double* padfOut )
+{
+    const int nRasterXSize = psTransform->poDS->GetRasterXSize();
+    const int nTileXStart = nX / RPC_DEM_TILE_SIZE;
+    const int nTileXEnd = (nX + nWidth - 1) / RPC_DEM_TILE_SIZE;
+    const int nTileYStart = nY / RPC_DEM_TILE_SIZE;
+    const int nTileYEnd = (nY + nHeight - 1) / RPC_DEM_TILE_SIZE;
+    for( int nTileY = nTileYStart; nTileY <= nTileYEnd; nTileY++ )
+    {
+        for( int nTileX = nTileXStart; nTileX <= nTileXEnd; nTileX++ )
+        {
+            const double* padfTile =
+                GDALRPCGetDEMTile(psTransform, nTileX, nTileY);
+            if( padfTile == nullptr )
+                return false;
+
+            const int nTileXOff = nTileX * RPC_DEM_TILE_SIZE;
+            const int nTileYOff = nTileY * RPC_DEM_TILE_SIZE;
+            const int nTileWidth =
+                std::min(RPC_DEM_TILE_SIZE, nRasterXSize - nTileXOff);
+            const int nXMin = std::max(nX, nTileXOff);
+            const int nXMax = std::min(nX + nWidth, nTileXOff + nTileWidth);
+            const int nYMin = std::max(nY, nTileYOff);
+            const int nYMax =
+                std::min(nY + nHeight, nTileYOff + RPC_DEM_TILE_SIZE);
+            for( int iY = nYMin; iY < nYMax; iY++ )
+            {
+                memcpy( padfOut + static_cast<size_t>(iY - nY) * nWidth +
+                            (nXMin - nX),
+                        padfTile + static_cast<size_t>(iY - nTileYOff) *
+                            nTileWidth + (nXMin - nTileXOff),
+                        (nXMax - nXMin) * sizeof(double) );
+            }
+        }
+    }
+    return true;
+}
+
 /************************************************************************/
 /*                        GDALRPCExtractDEMWindow()                     */
 /************************************************************************/
@@ -1312,6 +1757,11 @@ static bool GDALRPCExtractDEMWindow( GDALRPCTransformInfo *psTransform,
                                      double* padfOut )
 {
     psTransform->nDEMExtractions++;
+    if( psTransform->psDEMTileCache != nullptr )
+    {
+        return GDALRPCReadDEMTiles( psTransform, nX, nY, nWidth, nHeight,
+                                    padfOut );
+    }
     if( psTransform->padfDEMBuffer == nullptr )
     {
         // Should only happen in case of failed memory allocation.
@@ -1577,7 +2027,7 @@ near_fallback:
 /************************************************************************/
 
 static int
-GDALRPCTransformWholeLineWithDEM( const GDALRPCTransformInfo *psTransform,
+GDALRPCTransformWholeLineWithDEM( GDALRPCTransformInfo *psTransform,
                                   int nPointCount,
                                   double *padfX, double *padfY, double *padfZ,
                                   int *panSuccess,
@@ -1592,15 +2042,23 @@ GDALRPCTransformWholeLineWithDEM( const GDALRPCTransformInfo *psTransform,
             panSuccess[i] = FALSE;
         return FALSE;
     }
-    CPLErr eErr = psTransform->poDS->GetRasterBand(1)->
-        RasterIO(GF_Read, nXLeft, nYTop, nXWidth, nYHeight,
-                 padfDEMBuffer, nXWidth, nYHeight,
-                 GDT_Float64, 0, 0, nullptr);
-    if( eErr != CE_None )
+    double* padfHeight = static_cast<double *>(
+        VSI_MALLOC2_VERBOSE(sizeof(double), nPointCount));
+    const bool bOK =
+        padfHeight != nullptr &&
+        (psTransform->psDEMTileCache != nullptr ?
+            GDALRPCReadDEMTiles(psTransform, nXLeft, nYTop, nXWidth, nYHeight,
+                                padfDEMBuffer) :
+            psTransform->poDS->GetRasterBand(1)->
+                RasterIO(GF_Read, nXLeft, nYTop, nXWidth, nYHeight,
+                         padfDEMBuffer, nXWidth, nYHeight,
+                         GDT_Float64, 0, 0, nullptr) == CE_None);
+    if( !bOK )
     {
         for( int i = 0; i < nPointCount; i++ )
             panSuccess[i] = FALSE;
         VSIFree(padfDEMBuffer);
+        VSIFree(padfHeight);
         return FALSE;
     }
 
@@ -1710,22 +2168,18 @@ GDALRPCTransformWholeLineWithDEM( const GDALRPCTransformInfo *psTransform,
                     if( k_valid_sample >= 0 )
                     {
                         dfDEMH = adfElevData[k_valid_sample];
-                        RPCTransformPoint( psTransform, padfX[i], padfY[i],
-                            dfZ_i + (psTransform->dfHeightOffset + dfDEMH) *
-                                        psTransform->dfHeightScale,
-                            padfX + i, padfY + i );
-
+                        padfHeight[i] = dfZ_i +
+                            (psTransform->dfHeightOffset + dfDEMH) *
+                                psTransform->dfHeightScale;
                         panSuccess[i] = TRUE;
                         continue;
                     }
                     else if( psTransform->bHasDEMMissingValue )
                     {
                         dfDEMH = psTransform->dfDEMMissingValue;
-                        RPCTransformPoint( psTransform, padfX[i], padfY[i],
-                            dfZ_i + (psTransform->dfHeightOffset + dfDEMH) *
-                                        psTransform->dfHeightScale,
-                            padfX + i, padfY + i );
-
+                        padfHeight[i] = dfZ_i +
+                            (psTransform->dfHeightOffset + dfDEMH) *
+                                psTransform->dfHeightScale;
                         panSuccess[i] = TRUE;
                         continue;
                     }
@@ -1766,15 +2220,17 @@ GDALRPCTransformWholeLineWithDEM( const GDALRPCTransformInfo *psTransform,
             }
         }
 
-        RPCTransformPoint( psTransform, padfX[i], padfY[i],
-                            dfZ_i + (psTransform->dfHeightOffset + dfDEMH) *
-                                        psTransform->dfHeightScale,
-                            padfX + i, padfY + i );
-
+        padfHeight[i] = dfZ_i +
+            (psTransform->dfHeightOffset + dfDEMH) * psTransform->dfHeightScale;
         panSuccess[i] = TRUE;
     }
 
+    // Points that failed are left untouched.
+    RPCTransformPointsWithHeight( psTransform, nPointCount, padfX, padfY,
+                                  padfHeight, panSuccess );
+
     VSIFree(padfDEMBuffer);
+    VSIFree(padfHeight);
 
     return TRUE;
 }
@@ -1816,6 +2272,8 @@ static bool GDALRPCOpenDEM( GDALRPCTransformInfo* psTransform )
         psTransform->nBufferHeight = -1;
         psTransform->nLastQueriedX = -1;
         psTransform->nLastQueriedY = -1;
+        psTransform->psDEMTileCache =
+            GDALRPCAcquireDEMTileCache(psTransform->pszDEMPath);
         const char* pszSpatialRef = psTransform->poDS->GetProjectionRef();
         if( pszSpatialRef != nullptr && pszSpatialRef[0] != '\0' )
         {
@@ -2022,22 +2480,30 @@ int GDALRPCTransform( void *pTransformArg, int bDstToSrc,
             }
         }
 
-        for( int i = 0; i < nPointCount; i++ )
+        // Fetch the heights first, and then evaluate the polynomials on
+        // batches of points.
+        double adfHeight[RPC_BATCH_SIZE];
+        for( int iStart = 0; iStart < nPointCount; iStart += RPC_BATCH_SIZE )
         {
-            double dfHeight = 0.0;
-            if( !GDALRPCGetHeightAtLongLat( psTransform, padfX[i], padfY[i],
-                                            &dfHeight ) )
+            const int nCount = std::min(RPC_BATCH_SIZE, nPointCount - iStart);
+            for( int j = 0; j < nCount; j++ )
             {
-                panSuccess[i] = FALSE;
-                padfX[i] = HUGE_VAL;
-                padfY[i] = HUGE_VAL;
-                continue;
+                const int i = iStart + j;
+                double dfHeight = 0.0;
+                if( !GDALRPCGetHeightAtLongLat( psTransform, padfX[i], padfY[i],
+                                                &dfHeight ) )
+                {
+                    panSuccess[i] = FALSE;
+                    padfX[i] = HUGE_VAL;
+                    padfY[i] = HUGE_VAL;
+                    continue;
+                }
+                adfHeight[j] = (padfZ ? padfZ[i] : 0.0) + dfHeight;
+                panSuccess[i] = TRUE;
             }
-
-            RPCTransformPoint( psTransform, padfX[i], padfY[i],
-                               (padfZ ? padfZ[i] : 0.0) + dfHeight,
-                                padfX + i, padfY + i );
-            panSuccess[i] = TRUE;
+            RPCTransformPointsWithHeight( psTransform, nCount,
+                                          padfX + iStart, padfY + iStart,
+                                          adfHeight, panSuccess + iStart );
         }
 
         return TRUE;
@@ -2053,23 +2519,57 @@ int GDALRPCTransform( void *pTransformArg, int bDstToSrc,
 /* -------------------------------------------------------------------- */
 /*      Compute the inverse (pixel/line/height to lat/long).  This      */
 /*      function uses an iterative method from an initial linear        */
-/*      approximation.                                                  */
+/*      approximation, or from the solution of the previous point       */
+/*      when it is close enough, which is the common case of points     */
+/*      along a scanline.                                               */
 /* -------------------------------------------------------------------- */
+    const double* padfPLToLL = psTransform->adfPLToLatLongGeoTransform;
+    bool bPrevValid = false;
+    double dfPrevPixel = 0.0;
+    double dfPrevLine = 0.0;
+    double dfPrevZ = 0.0;
+    double dfPrevLong = 0.0;
+    double dfPrevLat = 0.0;
     for( int i = 0; i < nPointCount; i++ )
     {
+        const double dfPixel = padfX[i];
+        const double dfLine = padfY[i];
         double dfResultX = 0.0;
         double dfResultY = 0.0;
 
-        if( !RPCInverseTransformPoint( psTransform, padfX[i], padfY[i],
+        double adfInitLongLat[2] = {};
+        const double* padfInitLongLat = nullptr;
+        if( bPrevValid && padfZ[i] == dfPrevZ &&
+            fabs(dfPixel - dfPrevPixel) <= RPC_WARM_START_MAX_DIST &&
+            fabs(dfLine - dfPrevLine) <= RPC_WARM_START_MAX_DIST )
+        {
+            const double dfDeltaPixel = dfPixel - dfPrevPixel;
+            const double dfDeltaLine = dfLine - dfPrevLine;
+            adfInitLongLat[0] = dfPrevLong +
+                padfPLToLL[1] * dfDeltaPixel + padfPLToLL[2] * dfDeltaLine;
+            adfInitLongLat[1] = dfPrevLat +
+                padfPLToLL[4] * dfDeltaPixel + padfPLToLL[5] * dfDeltaLine;
+            padfInitLongLat = adfInitLongLat;
+        }
+
+        if( !RPCInverseTransformPoint( psTransform, dfPixel, dfLine,
                     padfZ[i],
-                    &dfResultX, &dfResultY ) )
+                    &dfResultX, &dfResultY, padfInitLongLat ) )
         {
+            bPrevValid = false;
             panSuccess[i] = FALSE;
             padfX[i] = HUGE_VAL;
             padfY[i] = HUGE_VAL;
             continue;
         }
 
+        bPrevValid = true;
+        dfPrevPixel = dfPixel;
+        dfPrevLine = dfLine;
+        dfPrevZ = padfZ[i];
+        dfPrevLong = dfResultX;
+        dfPrevLat = dfResultY;
+
         padfX[i] = dfResultX;
         padfY[i] = dfResultY;
 
@@ -32,7 +32,10 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <algorithm>
+#include <cmath>
 #include <map>
+#include <new>
 #include <utility>
 
 #include "cpl_atomic_ops.h"
@@ -41,6 +44,7 @@
 #include "cpl_minixml.h"
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_alg.h"
 #include "gdal_alg_priv.h"
@@ -64,6 +68,9 @@ typedef struct
 
     bool      bReversed;
 
+    // Error bound of the approximate evaluation, or 0 for exact evaluation.
+    double    dfMaxErrorInPixel;
+
     int       nGCPCount;
     GDAL_GCP *pasGCPList;
 
@@ -98,9 +105,17 @@ void* GDALCreateSimilarTPSTransformer( void *hTransformArg,
             pasGCPList[i].dfGCPPixel /= dfRatioX;
             pasGCPList[i].dfGCPLine /= dfRatioY;
         }
+        char** papszOptions = nullptr;
+        if( psInfo->dfMaxErrorInPixel > 0.0 )
+        {
+            papszOptions = CSLSetNameValue(
+                papszOptions, "TPS_MAX_ERROR_IN_PIXEL",
+                CPLSPrintf("%.18g", psInfo->dfMaxErrorInPixel));
+        }
         psInfo = static_cast<TPSTransformInfo *>(
-            GDALCreateTPSTransformer( psInfo->nGCPCount, pasGCPList,
-                                      psInfo->bReversed ));
+            GDALCreateTPSTransformerInt( psInfo->nGCPCount, pasGCPList,
+                                         psInfo->bReversed, papszOptions ));
+        CSLDestroy(papszOptions);
         GDALDeinitGCPs( psInfo->nGCPCount, pasGCPList );
         CPLFree( pasGCPList );
     }
@@ -124,8 +139,9 @@ void* GDALCreateSimilarTPSTransformer( void *hTransformArg,
  * Creating the TPS transformer involves solving systems of linear equations
  * related to the number of control points involved.  This solution is
  * computed within this function call.  It can be quite an expensive operation
- * for large numbers of GCPs.  For instance, for reference, it takes on the
- * order of 10s for 400 GCPs on a 2GHz Athlon processor.
+ * for large numbers of GCPs, as its cost grows with the cube of the number of
+ * GCPs.  When GDAL_NUM_THREADS is set, the system is set up and solved with
+ * several threads.
  *
  * TPS Transformers are serializable.
  *
@@ -147,12 +163,6 @@ void *GDALCreateTPSTransformer( int nGCPCount, const GDAL_GCP *pasGCPList,
     return GDALCreateTPSTransformerInt(nGCPCount, pasGCPList, bReversed, nullptr);
 }
 
-static void GDALTPSComputeForwardInThread( void *pData )
-{
-    TPSTransformInfo *psInfo = static_cast<TPSTransformInfo *>(pData);
-    psInfo->bForwardSolved = psInfo->poForward->solve() != 0;
-}
-
 void *GDALCreateTPSTransformerInt( int nGCPCount, const GDAL_GCP *pasGCPList,
                                    int bReversed, char** papszOptions )
 
@@ -268,31 +278,62 @@ void *GDALCreateTPSTransformerInt( int nGCPCount, const GDAL_GCP *pasGCPList,
             nThreads = CPLGetNumCPUs();
         else
             nThreads = atoi(pszWarpThreads);
+        nThreads = std::min(nThreads, 128);
     }
 
+/* -------------------------------------------------------------------- */
+/*      Solve the forward and reverse systems one after the other,      */
+/*      each of them using all the threads.                             */
+/* -------------------------------------------------------------------- */
+    CPLWorkerThreadPool* poThreadPool = nullptr;
     if( nThreads > 1 )
     {
-        // Compute direct and reverse transforms in parallel.
-        CPLJoinableThread* hThread =
-            CPLCreateJoinableThread(GDALTPSComputeForwardInThread, psInfo);
-        psInfo->bReverseSolved = psInfo->poReverse->solve() != 0;
-        if( hThread != nullptr )
-            CPLJoinThread(hThread);
-        else
-            psInfo->bForwardSolved = psInfo->poForward->solve() != 0;
-    }
-    else
-    {
-        psInfo->bForwardSolved = psInfo->poForward->solve() != 0;
-        psInfo->bReverseSolved = psInfo->poReverse->solve() != 0;
+        poThreadPool = new (std::nothrow) CPLWorkerThreadPool();
+        if( poThreadPool != nullptr &&
+            !poThreadPool->Setup(nThreads, nullptr, nullptr) )
+        {
+            delete poThreadPool;
+            poThreadPool = nullptr;
+        }
     }
 
+    psInfo->bForwardSolved = psInfo->poForward->solve(poThreadPool) != 0;
+    psInfo->bReverseSolved = psInfo->bForwardSolved &&
+        psInfo->poReverse->solve(poThreadPool) != 0;
+    delete poThreadPool;
+
     if( !psInfo->bForwardSolved || !psInfo->bReverseSolved )
     {
         GDALDestroyTPSTransformer(psInfo);
         return nullptr;
     }
 
+/* -------------------------------------------------------------------- */
+/*      Optional approximate evaluation.  The error bound is given in   */
+/*      pixels, and converted to georeferenced units with the scale of  */
+/*      the affine fit of the GCPs for the pixel/line to georef spline. */
+/* -------------------------------------------------------------------- */
+    psInfo->dfMaxErrorInPixel =
+        CPLAtof(CSLFetchNameValueDef(papszOptions,
+                                     "TPS_MAX_ERROR_IN_PIXEL", "0"));
+    if( psInfo->dfMaxErrorInPixel > 0.0 )
+    {
+        VizGeorefSpline2D* poPixelSpline =
+            bReversed ? psInfo->poForward : psInfo->poReverse;
+        VizGeorefSpline2D* poGeorefSpline =
+            bReversed ? psInfo->poReverse : psInfo->poForward;
+        poPixelSpline->set_max_error(psInfo->dfMaxErrorInPixel);
+
+        double adfGT[6] = { 0.0, 1.0, 0.0, 0.0, 0.0, 1.0 };
+        if( GDALGCPsToGeoTransform(nGCPCount, pasGCPList, adfGT, TRUE) )
+        {
+            const double dfScale =
+                sqrt(fabs(adfGT[1] * adfGT[5] - adfGT[2] * adfGT[4]));
+            poGeorefSpline->set_max_error(
+                psInfo->dfMaxErrorInPixel * dfScale);
+        }
+    }
+
     return psInfo;
 }
 
@@ -407,6 +448,16 @@ CPLXMLNode *GDALSerializeTPSTransformer( void *pTransformArg )
         psTree, "Reversed",
         CPLString().Printf( "%d", static_cast<int>(psInfo->bReversed) ) );
 
+/* -------------------------------------------------------------------- */
+/*      Serialize the error bound of the approximate evaluation.        */
+/* -------------------------------------------------------------------- */
+    if( psInfo->dfMaxErrorInPixel > 0.0 )
+    {
+        CPLCreateXMLElementAndValue(
+            psTree, "MaxErrorInPixel",
+            CPLString().Printf( "%.18g", psInfo->dfMaxErrorInPixel ) );
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Attach GCP List.                                                */
 /* -------------------------------------------------------------------- */
@@ -448,11 +499,21 @@ void *GDALDeserializeTPSTransformer( CPLXMLNode *psTree )
 /* -------------------------------------------------------------------- */
     const int bReversed = atoi(CPLGetXMLValue(psTree, "Reversed", "0"));
 
+    char** papszOptions = nullptr;
+    const char* pszMaxError = CPLGetXMLValue(psTree, "MaxErrorInPixel", nullptr);
+    if( pszMaxError != nullptr )
+    {
+        papszOptions = CSLSetNameValue(papszOptions, "TPS_MAX_ERROR_IN_PIXEL",
+                                       pszMaxError);
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Generate transformation.                                        */
 /* -------------------------------------------------------------------- */
     void *pResult =
-        GDALCreateTPSTransformer( nGCPCount, pasGCPList, bReversed );
+        GDALCreateTPSTransformerInt( nGCPCount, pasGCPList, bReversed,
+                                     papszOptions );
+    CSLDestroy(papszOptions);
 
 /* -------------------------------------------------------------------- */
 /*      Cleanup GCP copy.                                               */
@@ -37,12 +37,18 @@
 
 #include <algorithm>
 #include <limits>
+#include <memory>
+#include <new>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_mem_cache.h"
 #include "cpl_minixml.h"
+#include "cpl_multiproc.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
 
@@ -65,6 +71,69 @@ const double FSHIFT = 0.5;
 const double ISHIFT = 0.5;
 const double OVERSAMPLE_FACTOR=1.3;
 
+// Number of hole filling iterations of the backmap.
+constexpr int BACKMAP_MAX_ITER = 3;
+
+// Dimension of the tiles in which the backmap is computed.
+constexpr int BACKMAP_TILE_SIZE = 256;
+
+namespace {
+
+/************************************************************************/
+/*                         GDALGeoLocBackMapTiles                       */
+/*                                                                      */
+/*      The backmap is computed by tiles. Each tile only depends on     */
+/*      the geolocation pixels falling within the tile, or within       */
+/*      BACKMAP_MAX_ITER backmap pixels of it since holes are filled    */
+/*      from the immediate neighbours at each iteration. Those pixels   */
+/*      are indexed per tile, in raster order, so that a tile is        */
+/*      identical to the corresponding window of a backmap computed     */
+/*      at once.                                                        */
+/*                                                                      */
+/*      In tiled mode the tiles are computed on demand and kept in an   */
+/*      LRU cache, instead of allocating the whole backmap.  The cache  */
+/*      is protected by hMutex, as the transformer may be used by       */
+/*      several threads, for example by the warper.                     */
+/************************************************************************/
+
+struct GDALGeoLocBackMapTile
+{
+    std::vector<float> afX{};
+    std::vector<float> afY{};
+};
+
+typedef std::shared_ptr<GDALGeoLocBackMapTile> GDALGeoLocBackMapTilePtr;
+
+struct GDALGeoLocBackMapTiles
+{
+    int         nTilesPerRow = 0;
+    int         nTilesPerCol = 0;
+    // Index of the first entry of each tile in anPixels, plus a final one.
+    std::vector<size_t> anPixelStart{};
+    // Geolocation pixel indices (iX + iY * nGeoLocXSize), in raster order.
+    std::vector<int> anPixels{};
+
+    CPLMutex   *hMutex = nullptr;
+    lru11::Cache<int, GDALGeoLocBackMapTilePtr> oCache;
+    int         nLastTile = -1;
+    GDALGeoLocBackMapTilePtr poLastTile{};
+
+    explicit GDALGeoLocBackMapTiles( size_t nMaxTiles ) :
+        oCache(nMaxTiles, 0) {}
+
+    ~GDALGeoLocBackMapTiles()
+    {
+        if( hMutex != nullptr )
+            CPLDestroyMutex(hMutex);
+    }
+
+    GDALGeoLocBackMapTiles( const GDALGeoLocBackMapTiles& ) = delete;
+    GDALGeoLocBackMapTiles& operator=( const GDALGeoLocBackMapTiles& ) =
+                                                                    delete;
+};
+
+} // namespace
+
 typedef struct {
     GDALTransformerInfo sTI;
 
@@ -78,6 +147,10 @@ typedef struct {
     float       *pafBackMapX;
     float       *pafBackMapY;
 
+    // Set in tiled mode, in which case pafBackMapX and pafBackMapY are
+    // not allocated.
+    GDALGeoLocBackMapTiles *poBackMapTiles;
+
     // Geolocation bands.
     GDALDatasetH     hDS_X;
     GDALRasterBandH  hBand_X;
@@ -214,256 +287,295 @@ static bool GeoLocLoadFullData( GDALGeoLocTransformInfo *psTransform )
 }
 
 /************************************************************************/
-/*                       GeoLocGenerateBackMap()                        */
+/*                         GeoLocGetBackMapPos()                        */
+/*                                                                      */
+/*      Position in the backmap of the geolocation pixel i: the top     */
+/*      left backmap pixel it contributes to and the fractional part    */
+/*      used for its weights. Returns false if the pixel is nodata or   */
+/*      too far outside the backmap.                                    */
 /************************************************************************/
 
-static bool GeoLocGenerateBackMap( GDALGeoLocTransformInfo *psTransform )
+static bool GeoLocGetBackMapPos( const GDALGeoLocTransformInfo *psTransform,
+                                 int i, int *piBMX, int *piBMY,
+                                 double *pdfFracBMX, double *pdfFracBMY )
+{
+    if( psTransform->bHasNoData &&
+        psTransform->padfGeoLocX[i] == psTransform->dfNoDataX )
+        return false;
+
+    const double dfMinX = psTransform->adfBackMapGeoTransform[0];
+    const double dfMaxY = psTransform->adfBackMapGeoTransform[3];
+    const double dfPixelSize = psTransform->adfBackMapGeoTransform[1];
 
+    const double dBMX = static_cast<double>(
+            (psTransform->padfGeoLocX[i] - dfMinX) / dfPixelSize) - FSHIFT;
+
+    const double dBMY = static_cast<double>(
+        (dfMaxY - psTransform->padfGeoLocY[i]) / dfPixelSize) - FSHIFT;
+
+    //Get top left index by truncation
+    const int iBMX = static_cast<int>(dBMX);
+    const int iBMY = static_cast<int>(dBMY);
+
+    //Check if the center is in range
+    if( iBMX < -1 || iBMY < -1 ||
+        iBMX > psTransform->nBackMapWidth ||
+        iBMY > psTransform->nBackMapHeight )
+        return false;
+
+    *piBMX = iBMX;
+    *piBMY = iBMY;
+    *pdfFracBMX = dBMX - iBMX;
+    *pdfFracBMY = dBMY - iBMY;
+    return true;
+}
+
+/************************************************************************/
+/*                       GeoLocIndexBackMapTiles()                      */
+/*                                                                      */
+/*      Builds the per-tile lists of geolocation pixels.                */
+/************************************************************************/
+
+static bool GeoLocIndexBackMapTiles( const GDALGeoLocTransformInfo *psTransform,
+                                     int nTilesPerRow, int nTilesPerCol,
+                                     GDALGeoLocBackMapTiles *poTiles )
 {
-    const int nXSize = psTransform->nGeoLocXSize;
-    const int nYSize = psTransform->nGeoLocYSize;
-    const int nMaxIter = 3;
+    const int nPixels = psTransform->nGeoLocXSize * psTransform->nGeoLocYSize;
+    const int nBMXSize = psTransform->nBackMapWidth;
+    const int nBMYSize = psTransform->nBackMapHeight;
+    const int nTiles = nTilesPerRow * nTilesPerCol;
 
-/* -------------------------------------------------------------------- */
-/*      Scan forward map for lat/long extents.                          */
-/* -------------------------------------------------------------------- */
-    double dfMinX = 0.0;
-    double dfMaxX = 0.0;
-    double dfMinY = 0.0;
-    double dfMaxY = 0.0;
-    bool bInit = false;
+    poTiles->nTilesPerRow = nTilesPerRow;
+    poTiles->nTilesPerCol = nTilesPerCol;
 
-    for( int i = nXSize * nYSize - 1; i >= 0; i-- )
+    // The first pass counts the entries of each tile, and the second one
+    // fills them.
+    try
     {
-        if( !psTransform->bHasNoData ||
-            psTransform->padfGeoLocX[i] != psTransform->dfNoDataX )
+        poTiles->anPixelStart.resize(static_cast<size_t>(nTiles) + 1);
+        for( int iPass = 0; iPass < 2; iPass++ )
         {
-            if( bInit )
+            std::vector<size_t> anPos;
+            if( iPass == 1 )
             {
-                dfMinX = std::min(dfMinX, psTransform->padfGeoLocX[i]);
-                dfMaxX = std::max(dfMaxX, psTransform->padfGeoLocX[i]);
-                dfMinY = std::min(dfMinY, psTransform->padfGeoLocY[i]);
-                dfMaxY = std::max(dfMaxY, psTransform->padfGeoLocY[i]);
+                size_t nTotal = 0;
+                for( int i = 0; i <= nTiles; i++ )
+                {
+                    const size_t nCount = poTiles->anPixelStart[i];
+                    poTiles->anPixelStart[i] = nTotal;
+                    nTotal += nCount;
+                }
+                poTiles->anPixels.resize(nTotal);
+                anPos.assign(poTiles->anPixelStart.begin(),
+                             poTiles->anPixelStart.end());
             }
-            else
+
+            for( int i = 0; i < nPixels; i++ )
             {
-                bInit = true;
-                dfMinX = psTransform->padfGeoLocX[i];
-                dfMaxX = psTransform->padfGeoLocX[i];
-                dfMinY = psTransform->padfGeoLocY[i];
-                dfMaxY = psTransform->padfGeoLocY[i];
+                int iBMX = 0;
+                int iBMY = 0;
+                double dfFracBMX = 0.0;
+                double dfFracBMY = 0.0;
+                if( !GeoLocGetBackMapPos( psTransform, i, &iBMX, &iBMY,
+                                          &dfFracBMX, &dfFracBMY ) )
+                    continue;
+
+                // Backmap pixels touched by this geolocation pixel.
+                const int nMinX = std::max(0, iBMX);
+                const int nMaxX = std::min(nBMXSize - 1, iBMX + 1);
+                const int nMinY = std::max(0, iBMY);
+                const int nMaxY = std::min(nBMYSize - 1, iBMY + 1);
+                if( nMinX > nMaxX || nMinY > nMaxY )
+                    continue;
+
+                // Tiles whose margin contains them.
+                const int nTileX0 =
+                    std::max(0, nMinX - BACKMAP_MAX_ITER) / BACKMAP_TILE_SIZE;
+                const int nTileX1 = std::min(nTilesPerRow - 1,
+                    (nMaxX + BACKMAP_MAX_ITER) / BACKMAP_TILE_SIZE);
+                const int nTileY0 =
+                    std::max(0, nMinY - BACKMAP_MAX_ITER) / BACKMAP_TILE_SIZE;
+                const int nTileY1 = std::min(nTilesPerCol - 1,
+                    (nMaxY + BACKMAP_MAX_ITER) / BACKMAP_TILE_SIZE);
+                for( int nTileY = nTileY0; nTileY <= nTileY1; nTileY++ )
+                {
+                    for( int nTileX = nTileX0; nTileX <= nTileX1; nTileX++ )
+                    {
+                        const int iTile = nTileX + nTileY * nTilesPerRow;
+                        if( iPass == 0 )
+                            poTiles->anPixelStart[iTile]++;
+                        else
+                            poTiles->anPixels[anPos[iTile]++] = i;
+                    }
+                }
             }
         }
     }
-
-/* -------------------------------------------------------------------- */
-/*      Decide on resolution for backmap.  We aim for slightly          */
-/*      higher resolution than the source but we can't easily           */
-/*      establish how much dead space there is in the backmap, so it    */
-/*      is approximate.                                                 */
-/* -------------------------------------------------------------------- */
-    const double dfTargetPixels = (nXSize * nYSize * OVERSAMPLE_FACTOR);
-    const double dfPixelSize = sqrt((dfMaxX - dfMinX) * (dfMaxY - dfMinY)
-                              / dfTargetPixels);
-
-    const int nBMYSize = psTransform->nBackMapHeight =
-        static_cast<int>((dfMaxY - dfMinY) / dfPixelSize + 1);
-    const int nBMXSize = psTransform->nBackMapWidth =
-        static_cast<int>((dfMaxX - dfMinX) / dfPixelSize + 1);
-
-    if( nBMXSize > std::numeric_limits<int>::max() / nBMYSize )
+    catch( const std::bad_alloc& )
     {
-        CPLError(CE_Failure, CPLE_AppDefined, "Int overflow : %d x %d",
-                 nBMXSize, nBMYSize);
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate backmap tile index");
         return false;
     }
+    return true;
+}
 
+/************************************************************************/
+/*                       GeoLocFillBackMapWindow()                      */
+/*                                                                      */
+/*      Computes the window of the backmap of nBMXSize x nBMYSize       */
+/*      pixels at (nXOff, nYOff) into pafBackMapX and pafBackMapY,      */
+/*      from the nPixelCount geolocation pixels of panPixels, or from   */
+/*      all of them if panPixels is NULL. Holes are filled from the     */
+/*      pixels of the window only.                                      */
+/************************************************************************/
 
+static bool GeoLocFillBackMapWindow( const GDALGeoLocTransformInfo *psTransform,
+                                     const int *panPixels, size_t nPixelCount,
+                                     int nXOff, int nYOff,
+                                     int nBMXSize, int nBMYSize,
+                                     float *pafBackMapX, float *pafBackMapY )
 
-    dfMinX -= dfPixelSize / 2.0;
-    dfMaxY += dfPixelSize / 2.0;
-
-
-    psTransform->adfBackMapGeoTransform[0] = dfMinX;
-    psTransform->adfBackMapGeoTransform[1] = dfPixelSize;
-    psTransform->adfBackMapGeoTransform[2] = 0.0;
-    psTransform->adfBackMapGeoTransform[3] = dfMaxY;
-    psTransform->adfBackMapGeoTransform[4] = 0.0;
-    psTransform->adfBackMapGeoTransform[5] = -dfPixelSize;
+{
+    const int nXSize = psTransform->nGeoLocXSize;
+    const int nMaxIter = BACKMAP_MAX_ITER;
 
 /* -------------------------------------------------------------------- */
-/*      Allocate backmap, and initialize to nodata value (-1.0).        */
+/*      Initialize the backmap to nodata value (-1.0).                  */
 /* -------------------------------------------------------------------- */
-    GByte *pabyValidFlag = static_cast<GByte *>(
-        VSI_CALLOC_VERBOSE(nBMXSize, nBMYSize));
-
-    psTransform->pafBackMapX = static_cast<float *>(
-        VSI_MALLOC3_VERBOSE(nBMXSize, nBMYSize, sizeof(float)));
-    psTransform->pafBackMapY = static_cast<float *>(
-        VSI_MALLOC3_VERBOSE(nBMXSize, nBMYSize, sizeof(float)));
-
-    float *wgtsBackMap = static_cast<float *>(
-        VSI_MALLOC3_VERBOSE(nBMXSize, nBMYSize, sizeof(float)));
-
-    if( pabyValidFlag == nullptr ||
-        psTransform->pafBackMapX == nullptr ||
-        psTransform->pafBackMapY == nullptr ||
-        wgtsBackMap == nullptr)
+    const size_t nSize = static_cast<size_t>(nBMXSize) * nBMYSize;
+    std::vector<GByte> abyValidFlag;
+    std::vector<float> afWgtsBackMap;
+    try
     {
-        CPLFree( pabyValidFlag );
-        CPLFree( wgtsBackMap );
-        return false;
+        abyValidFlag.resize(nSize);
+        afWgtsBackMap.resize(nSize);
     }
-
-    for( int i = nBMXSize * nBMYSize - 1; i >= 0; i-- )
+    catch( const std::bad_alloc& )
     {
-        psTransform->pafBackMapX[i] = 0.0;
-        psTransform->pafBackMapY[i] = 0.0;
-        wgtsBackMap[i] = 0.0;
-        pabyValidFlag[i] = 0;
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate backmap");
+        return false;
     }
+    GByte *pabyValidFlag = abyValidFlag.data();
+    float *wgtsBackMap = afWgtsBackMap.data();
+    memset(pafBackMapX, 0, nSize * sizeof(float));
+    memset(pafBackMapY, 0, nSize * sizeof(float));
 
 /* -------------------------------------------------------------------- */
-/*      Run through the whole geoloc array forward projecting and       */
-/*      pushing into the backmap.                                       */
+/*      Run through the geoloc pixels forward projecting and pushing    */
+/*      into the backmap.                                               */
 /*      Initialize to the nMaxIter+1 value so we can spot genuinely     */
 /*      valid pixels in the hole-filling loop.                          */
 /* -------------------------------------------------------------------- */
-
-    for( int iY = 0; iY < nYSize; iY++ )
+    if( panPixels == nullptr )
+        nPixelCount = static_cast<size_t>(nXSize) * psTransform->nGeoLocYSize;
+    for( size_t iEntry = 0; iEntry < nPixelCount; iEntry++ )
     {
-        for( int iX = 0; iX < nXSize; iX++ )
+        const int i = panPixels != nullptr ? panPixels[iEntry] :
+                                             static_cast<int>(iEntry);
+        const int iX = i % nXSize;
+        const int iY = i / nXSize;
+
+        int iBMXGlobal = 0;
+        int iBMYGlobal = 0;
+        double fracBMX = 0.0;
+        double fracBMY = 0.0;
+        if( !GeoLocGetBackMapPos( psTransform, i, &iBMXGlobal, &iBMYGlobal,
+                                  &fracBMX, &fracBMY ) )
+            continue;
+        const int iBMX = iBMXGlobal - nXOff;
+        const int iBMY = iBMYGlobal - nYOff;
+
+        const double dfValueX =
+            (iX + FSHIFT) * psTransform->dfPIXEL_STEP +
+            psTransform->dfPIXEL_OFFSET;
+        const double dfValueY =
+            (iY + FSHIFT) * psTransform->dfLINE_STEP +
+            psTransform->dfLINE_OFFSET;
+
+        //Check logic for top left pixel
+        if ((iBMX >= 0) && (iBMY >= 0) && (iBMX < nBMXSize) && (iBMY < nBMYSize))
         {
-            if( psTransform->bHasNoData &&
-                psTransform->padfGeoLocX[iX + iY * nXSize]
-                == psTransform->dfNoDataX )
-                continue;
-
-            const int i = iX + iY * nXSize;
-
-            const double dBMX = static_cast<double>(
-                    (psTransform->padfGeoLocX[i] - dfMinX) / dfPixelSize) - FSHIFT;
-
-            const double dBMY = static_cast<double>(
-                (dfMaxY - psTransform->padfGeoLocY[i]) / dfPixelSize) - FSHIFT;
-
-
-            //Get top left index by truncation
-            const int iBMX = static_cast<int>(dBMX);
-            const int iBMY = static_cast<int>(dBMY);
-            const double fracBMX = dBMX - iBMX;
-            const double fracBMY = dBMY - iBMY;
-
-            //Check if the center is in range
-            if( iBMX < -1 || iBMY < -1 || iBMX > nBMXSize || iBMY > nBMYSize )
-                continue;
-
-            //Check logic for top left pixel
-            if ((iBMX >= 0) && (iBMY >= 0) && (iBMX < nBMXSize) && (iBMY < nBMYSize))
-            {
-                const double tempwt = (1.0 - fracBMX) * (1.0 - fracBMY);
-                psTransform->pafBackMapX[iBMX + iBMY * nBMXSize] +=
-                    static_cast<float>( tempwt * (
-                        (iX + FSHIFT) * psTransform->dfPIXEL_STEP +
-                        psTransform->dfPIXEL_OFFSET));
-
-                psTransform->pafBackMapY[iBMX + iBMY * nBMXSize] +=
-                    static_cast<float>( tempwt * (
-                        (iY + FSHIFT) * psTransform->dfLINE_STEP +
-                        psTransform->dfLINE_OFFSET));
-                wgtsBackMap[iBMX + iBMY * nBMXSize] += static_cast<float>(tempwt);
-
-                //For backward compatibility
-                pabyValidFlag[iBMX + iBMY * nBMXSize] = static_cast<GByte>(nMaxIter+1);
-            }
-
-            //Check logic for top right pixel
-            if (((iBMX+1) >= 0) && (iBMY >= 0) && ((iBMX+1) < nBMXSize) && (iBMY < nBMYSize))
-            {
-                const double tempwt = fracBMX * (1.0 - fracBMY);
-
-                psTransform->pafBackMapX[iBMX + 1 + iBMY * nBMXSize] +=
-                    static_cast<float>( tempwt * (
-                        (iX + FSHIFT) * psTransform->dfPIXEL_STEP +
-                        psTransform->dfPIXEL_OFFSET));
-
-                psTransform->pafBackMapY[iBMX + 1 + iBMY * nBMXSize] +=
-                    static_cast<float>( tempwt * (
-                        (iY + FSHIFT)* psTransform->dfLINE_STEP +
-                        psTransform->dfLINE_OFFSET));
-                wgtsBackMap[iBMX + 1 + iBMY * nBMXSize] +=  static_cast<float>(tempwt);
-
-                //For backward compatibility
-                pabyValidFlag[iBMX + 1 + iBMY * nBMXSize] = static_cast<GByte>(nMaxIter+1);
-            }
+            const double tempwt = (1.0 - fracBMX) * (1.0 - fracBMY);
+            pafBackMapX[iBMX + iBMY * nBMXSize] +=
+                static_cast<float>( tempwt * dfValueX );
+            pafBackMapY[iBMX + iBMY * nBMXSize] +=
+                static_cast<float>( tempwt * dfValueY );
+            wgtsBackMap[iBMX + iBMY * nBMXSize] += static_cast<float>(tempwt);
+
+            //For backward compatibility
+            pabyValidFlag[iBMX + iBMY * nBMXSize] = static_cast<GByte>(nMaxIter+1);
+        }
 
-            //Check logic for bottom right pixel
-            if (((iBMX+1) >= 0) && ((iBMY+1) >= 0) && ((iBMX+1) < nBMXSize) && ((iBMY+1) < nBMYSize))
-            {
-                const double tempwt = fracBMX * fracBMY;
-                psTransform->pafBackMapX[iBMX + 1 + (iBMY+1) * nBMXSize] +=
-                    static_cast<float>( tempwt * (
-                        (iX + FSHIFT) * psTransform->dfPIXEL_STEP +
-                        psTransform->dfPIXEL_OFFSET));
-
-                psTransform->pafBackMapY[iBMX + 1 + (iBMY+1) * nBMXSize] +=
-                    static_cast<float>( tempwt * (
-                        (iY + FSHIFT) * psTransform->dfLINE_STEP +
-                        psTransform->dfLINE_OFFSET));
-                wgtsBackMap[iBMX + 1 + (iBMY+1) * nBMXSize] += static_cast<float>(tempwt);
-
-                //For backward compatibility
-                pabyValidFlag[iBMX + 1 + (iBMY+1) * nBMXSize] = static_cast<GByte>(nMaxIter+1);
-            }
+        //Check logic for top right pixel
+        if (((iBMX+1) >= 0) && (iBMY >= 0) && ((iBMX+1) < nBMXSize) && (iBMY < nBMYSize))
+        {
+            const double tempwt = fracBMX * (1.0 - fracBMY);
+            pafBackMapX[iBMX + 1 + iBMY * nBMXSize] +=
+                static_cast<float>( tempwt * dfValueX );
+            pafBackMapY[iBMX + 1 + iBMY * nBMXSize] +=
+                static_cast<float>( tempwt * dfValueY );
+            wgtsBackMap[iBMX + 1 + iBMY * nBMXSize] +=  static_cast<float>(tempwt);
+
+            //For backward compatibility
+            pabyValidFlag[iBMX + 1 + iBMY * nBMXSize] = static_cast<GByte>(nMaxIter+1);
+        }
 
-            //Check logic for bottom left pixel
-            if ((iBMX >= 0) && ((iBMY+1) >= 0) && (iBMX < nBMXSize) && ((iBMY+1) < nBMYSize))
-            {
-                const double tempwt = (1.0 - fracBMX) * fracBMY;
-                psTransform->pafBackMapX[iBMX + (iBMY+1) * nBMXSize] +=
-                    static_cast<float>( tempwt * (
-                        (iX + FSHIFT) * psTransform->dfPIXEL_STEP +
-                        psTransform->dfPIXEL_OFFSET));
-
-                psTransform->pafBackMapY[iBMX + (iBMY+1) * nBMXSize] +=
-                    static_cast<float>(tempwt * (
-                        (iY + FSHIFT) * psTransform->dfLINE_STEP +
-                        psTransform->dfLINE_OFFSET));
-                wgtsBackMap[iBMX + (iBMY+1) * nBMXSize] += static_cast<float>(tempwt);
-
-                //For backward compatibility
-                pabyValidFlag[iBMX + (iBMY+1) * nBMXSize] = static_cast<GByte>(nMaxIter+1);
-            }
+        //Check logic for bottom right pixel
+        if (((iBMX+1) >= 0) && ((iBMY+1) >= 0) && ((iBMX+1) < nBMXSize) && ((iBMY+1) < nBMYSize))
+        {
+            const double tempwt = fracBMX * fracBMY;
+            pafBackMapX[iBMX + 1 + (iBMY+1) * nBMXSize] +=
+                static_cast<float>( tempwt * dfValueX );
+            pafBackMapY[iBMX + 1 + (iBMY+1) * nBMXSize] +=
+                static_cast<float>( tempwt * dfValueY );
+            wgtsBackMap[iBMX + 1 + (iBMY+1) * nBMXSize] += static_cast<float>(tempwt);
+
+            //For backward compatibility
+            pabyValidFlag[iBMX + 1 + (iBMY+1) * nBMXSize] = static_cast<GByte>(nMaxIter+1);
+        }
 
+        //Check logic for bottom left pixel
+        if ((iBMX >= 0) && ((iBMY+1) >= 0) && (iBMX < nBMXSize) && ((iBMY+1) < nBMYSize))
+        {
+            const double tempwt = (1.0 - fracBMX) * fracBMY;
+            pafBackMapX[iBMX + (iBMY+1) * nBMXSize] +=
+                static_cast<float>( tempwt * dfValueX );
+            pafBackMapY[iBMX + (iBMY+1) * nBMXSize] +=
+                static_cast<float>( tempwt * dfValueY );
+            wgtsBackMap[iBMX + (iBMY+1) * nBMXSize] += static_cast<float>(tempwt);
+
+            //For backward compatibility
+            pabyValidFlag[iBMX + (iBMY+1) * nBMXSize] = static_cast<GByte>(nMaxIter+1);
         }
     }
 
-
     //Each pixel in the backmap may have multiple entries.
-    //We now go in average it out using the weights 
+    //We now go in average it out using the weights
     for(int i = nBMXSize * nBMYSize - 1; i >= 0; i-- )
     {
         //Setting these to -1 for backward compatibility
-        if (pabyValidFlag[i] == 0) 
+        if (pabyValidFlag[i] == 0)
         {
-            psTransform->pafBackMapX[i] = -1.0;
-            psTransform->pafBackMapY[i] = -1.0;
+            pafBackMapX[i] = -1.0;
+            pafBackMapY[i] = -1.0;
         }
         else
         {
             //Check if pixel was only touch during neighbor scan
-            //But no real weight was added as source point matched 
+            //But no real weight was added as source point matched
             //backmap grid node
             if (wgtsBackMap[i] > 0)
             {
-                psTransform->pafBackMapX[i] /= wgtsBackMap[i];
-                psTransform->pafBackMapY[i] /= wgtsBackMap[i];
+                pafBackMapX[i] /= wgtsBackMap[i];
+                pafBackMapY[i] /= wgtsBackMap[i];
                 pabyValidFlag[i] = static_cast<GByte>(nMaxIter+1);
             }
             else
             {
-                psTransform->pafBackMapX[i] = -1.0;
-                psTransform->pafBackMapY[i] = -1.0;
+                pafBackMapX[i] = -1.0;
+                pafBackMapY[i] = -1.0;
                 pabyValidFlag[i] = 0;
             }
         }
@@ -496,80 +608,72 @@ static bool GeoLocGenerateBackMap( GDALGeoLocTransformInfo *psTransform )
                 if( iBMX > 0 &&
                     pabyValidFlag[iBMX-1+iBMY*nBMXSize] > nMarkedAsGood )
                 {
-                    dfXSum += psTransform->pafBackMapX[iBMX-1+iBMY*nBMXSize];
-                    dfYSum += psTransform->pafBackMapY[iBMX-1+iBMY*nBMXSize];
+                    dfXSum += pafBackMapX[iBMX-1+iBMY*nBMXSize];
+                    dfYSum += pafBackMapY[iBMX-1+iBMY*nBMXSize];
                     nCount++;
                 }
                 // Right?
                 if( iBMX + 1 < nBMXSize &&
                     pabyValidFlag[iBMX+1+iBMY*nBMXSize] > nMarkedAsGood )
                 {
-                    dfXSum += psTransform->pafBackMapX[iBMX+1+iBMY*nBMXSize];
-                    dfYSum += psTransform->pafBackMapY[iBMX+1+iBMY*nBMXSize];
+                    dfXSum += pafBackMapX[iBMX+1+iBMY*nBMXSize];
+                    dfYSum += pafBackMapY[iBMX+1+iBMY*nBMXSize];
                     nCount++;
                 }
                 // Top?
                 if( iBMY > 0 &&
                     pabyValidFlag[iBMX+(iBMY-1)*nBMXSize] > nMarkedAsGood )
                 {
-                    dfXSum += psTransform->pafBackMapX[iBMX+(iBMY-1)*nBMXSize];
-                    dfYSum += psTransform->pafBackMapY[iBMX+(iBMY-1)*nBMXSize];
+                    dfXSum += pafBackMapX[iBMX+(iBMY-1)*nBMXSize];
+                    dfYSum += pafBackMapY[iBMX+(iBMY-1)*nBMXSize];
                     nCount++;
                 }
                 // Bottom?
                 if( iBMY + 1 < nBMYSize &&
                     pabyValidFlag[iBMX+(iBMY+1)*nBMXSize] > nMarkedAsGood )
                 {
-                    dfXSum += psTransform->pafBackMapX[iBMX+(iBMY+1)*nBMXSize];
-                    dfYSum += psTransform->pafBackMapY[iBMX+(iBMY+1)*nBMXSize];
+                    dfXSum += pafBackMapX[iBMX+(iBMY+1)*nBMXSize];
+                    dfYSum += pafBackMapY[iBMX+(iBMY+1)*nBMXSize];
                     nCount++;
                 }
                 // Top-left?
                 if( iBMX > 0 && iBMY > 0 &&
                     pabyValidFlag[iBMX-1+(iBMY-1)*nBMXSize] > nMarkedAsGood )
                 {
-                    dfXSum +=
-                        psTransform->pafBackMapX[iBMX-1+(iBMY-1)*nBMXSize];
-                    dfYSum +=
-                        psTransform->pafBackMapY[iBMX-1+(iBMY-1)*nBMXSize];
+                    dfXSum += pafBackMapX[iBMX-1+(iBMY-1)*nBMXSize];
+                    dfYSum += pafBackMapY[iBMX-1+(iBMY-1)*nBMXSize];
                     nCount++;
                 }
                 // Top-right?
                 if( iBMX + 1 < nBMXSize && iBMY > 0 &&
                     pabyValidFlag[iBMX+1+(iBMY-1)*nBMXSize] > nMarkedAsGood )
                 {
-                    dfXSum +=
-                        psTransform->pafBackMapX[iBMX+1+(iBMY-1)*nBMXSize];
-                    dfYSum +=
-                        psTransform->pafBackMapY[iBMX+1+(iBMY-1)*nBMXSize];
+                    dfXSum += pafBackMapX[iBMX+1+(iBMY-1)*nBMXSize];
+                    dfYSum += pafBackMapY[iBMX+1+(iBMY-1)*nBMXSize];
                     nCount++;
                 }
                 // Bottom-left?
                 if( iBMX > 0 && iBMY + 1 < nBMYSize &&
                     pabyValidFlag[iBMX-1+(iBMY+1)*nBMXSize] > nMarkedAsGood )
                 {
-                    dfXSum +=
-                        psTransform->pafBackMapX[iBMX-1+(iBMY+1)*nBMXSize];
-                    dfYSum +=
-                        psTransform->pafBackMapY[iBMX-1+(iBMY+1)*nBMXSize];
+                    dfXSum += pafBackMapX[iBMX-1+(iBMY+1)*nBMXSize];
+                    dfYSum += pafBackMapY[iBMX-1+(iBMY+1)*nBMXSize];
                     nCount++;
                 }
                 // Bottom-right?
                 if( iBMX + 1 < nBMXSize && iBMY + 1 < nBMYSize &&
                     pabyValidFlag[iBMX+1+(iBMY+1)*nBMXSize] > nMarkedAsGood )
                 {
-                    dfXSum +=
-                        psTransform->pafBackMapX[iBMX+1+(iBMY+1)*nBMXSize];
-                    dfYSum +=
-                        psTransform->pafBackMapY[iBMX+1+(iBMY+1)*nBMXSize];
+                    dfXSum += pafBackMapX[iBMX+1+(iBMY+1)*nBMXSize];
+                    dfYSum += pafBackMapY[iBMX+1+(iBMY+1)*nBMXSize];
                     nCount++;
                 }
 
                 if( nCount > 0 )
                 {
-                    psTransform->pafBackMapX[iBMX + iBMY * nBMXSize] =
+                    pafBackMapX[iBMX + iBMY * nBMXSize] =
                         static_cast<float>(dfXSum/nCount);
-                    psTransform->pafBackMapY[iBMX + iBMY * nBMXSize] =
+                    pafBackMapY[iBMX + iBMY * nBMXSize] =
                         static_cast<float>(dfYSum/nCount);
                     // Genuinely valid points will have value iMaxIter + 1.
                     // On each iteration mark newly valid points with a
@@ -584,8 +688,314 @@ static bool GeoLocGenerateBackMap( GDALGeoLocTransformInfo *psTransform )
             break;
     }
 
-    CPLFree( wgtsBackMap );
-    CPLFree( pabyValidFlag );
+    return true;
+}
+
+/************************************************************************/
+/*                       GeoLocComputeBackMapTile()                     */
+/*                                                                      */
+/*      Computes the backmap tile (nTileX, nTileY) into pafOutX and     */
+/*      pafOutY, whose lines are nOutLineStride floats apart. The       */
+/*      backmap is computed on the tile extended by BACKMAP_MAX_ITER    */
+/*      pixels on each side, so that hole filling gives the same        */
+/*      values as when computing the whole backmap at once.             */
+/************************************************************************/
+
+static bool GeoLocComputeBackMapTile( const GDALGeoLocTransformInfo *psTransform,
+                                      const GDALGeoLocBackMapTiles *poTiles,
+                                      int nTileX, int nTileY,
+                                      float *pafOutX, float *pafOutY,
+                                      int nOutLineStride )
+
+{
+    const int nMaxIter = BACKMAP_MAX_ITER;
+
+    const int nTileXOff = nTileX * BACKMAP_TILE_SIZE;
+    const int nTileYOff = nTileY * BACKMAP_TILE_SIZE;
+    const int nTileXSize =
+        std::min(BACKMAP_TILE_SIZE, psTransform->nBackMapWidth - nTileXOff);
+    const int nTileYSize =
+        std::min(BACKMAP_TILE_SIZE, psTransform->nBackMapHeight - nTileYOff);
+
+    // Extended window.
+    const int nXOff = std::max(0, nTileXOff - nMaxIter);
+    const int nYOff = std::max(0, nTileYOff - nMaxIter);
+    const int nBMXSize = std::min(psTransform->nBackMapWidth,
+                                  nTileXOff + nTileXSize + nMaxIter) - nXOff;
+    const int nBMYSize = std::min(psTransform->nBackMapHeight,
+                                  nTileYOff + nTileYSize + nMaxIter) - nYOff;
+
+    std::vector<float> afBackMapX;
+    std::vector<float> afBackMapY;
+    try
+    {
+        const size_t nSize = static_cast<size_t>(nBMXSize) * nBMYSize;
+        afBackMapX.resize(nSize);
+        afBackMapY.resize(nSize);
+    }
+    catch( const std::bad_alloc& )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate backmap tile");
+        return false;
+    }
+
+    // Values next to the edges of the extended window that are not edges
+    // of the backmap may differ from the ones of the whole backmap, but the
+    // error cannot reach the tile itself within nMaxIter iterations.
+    const int iTile = nTileX + nTileY * poTiles->nTilesPerRow;
+    const size_t nStart = poTiles->anPixelStart[iTile];
+    if( !GeoLocFillBackMapWindow(
+            psTransform, poTiles->anPixels.data() + nStart,
+            poTiles->anPixelStart[iTile + 1] - nStart,
+            nXOff, nYOff, nBMXSize, nBMYSize,
+            afBackMapX.data(), afBackMapY.data()) )
+    {
+        return false;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Copy the tile out of the extended window.                       */
+/* -------------------------------------------------------------------- */
+    for( int iY = 0; iY < nTileYSize; iY++ )
+    {
+        const size_t nSrcOffset =
+            static_cast<size_t>(nTileYOff - nYOff + iY) * nBMXSize +
+            (nTileXOff - nXOff);
+        memcpy( pafOutX + static_cast<size_t>(iY) * nOutLineStride,
+                afBackMapX.data() + nSrcOffset, nTileXSize * sizeof(float) );
+        memcpy( pafOutY + static_cast<size_t>(iY) * nOutLineStride,
+                afBackMapY.data() + nSrcOffset, nTileXSize * sizeof(float) );
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                        GeoLocBackMapJobFunc()                        */
+/************************************************************************/
+
+namespace {
+struct GDALGeoLocBackMapJob
+{
+    GDALGeoLocTransformInfo *psTransform;
+    const GDALGeoLocBackMapTiles *poTiles;
+    int nTileX;
+    int nTileY;
+    bool bOK;
+};
+} // namespace
+
+static void GeoLocBackMapJobFunc( void* pData )
+{
+    GDALGeoLocBackMapJob* psJob = static_cast<GDALGeoLocBackMapJob*>(pData);
+    GDALGeoLocTransformInfo *psTransform = psJob->psTransform;
+    const size_t nOffset =
+        static_cast<size_t>(psJob->nTileY) * BACKMAP_TILE_SIZE *
+            psTransform->nBackMapWidth +
+        static_cast<size_t>(psJob->nTileX) * BACKMAP_TILE_SIZE;
+    psJob->bOK = GeoLocComputeBackMapTile(
+        psTransform, psJob->poTiles, psJob->nTileX, psJob->nTileY,
+        psTransform->pafBackMapX + nOffset,
+        psTransform->pafBackMapY + nOffset,
+        psTransform->nBackMapWidth );
+}
+
+/************************************************************************/
+/*                       GeoLocGenerateBackMap()                        */
+/************************************************************************/
+
+static bool GeoLocGenerateBackMap( GDALGeoLocTransformInfo *psTransform )
+
+{
+    const int nXSize = psTransform->nGeoLocXSize;
+    const int nYSize = psTransform->nGeoLocYSize;
+
+/* -------------------------------------------------------------------- */
+/*      Scan forward map for lat/long extents.                          */
+/* -------------------------------------------------------------------- */
+    double dfMinX = 0.0;
+    double dfMaxX = 0.0;
+    double dfMinY = 0.0;
+    double dfMaxY = 0.0;
+    bool bInit = false;
+
+    for( int i = nXSize * nYSize - 1; i >= 0; i-- )
+    {
+        if( !psTransform->bHasNoData ||
+            psTransform->padfGeoLocX[i] != psTransform->dfNoDataX )
+        {
+            if( bInit )
+            {
+                dfMinX = std::min(dfMinX, psTransform->padfGeoLocX[i]);
+                dfMaxX = std::max(dfMaxX, psTransform->padfGeoLocX[i]);
+                dfMinY = std::min(dfMinY, psTransform->padfGeoLocY[i]);
+                dfMaxY = std::max(dfMaxY, psTransform->padfGeoLocY[i]);
+            }
+            else
+            {
+                bInit = true;
+                dfMinX = psTransform->padfGeoLocX[i];
+                dfMaxX = psTransform->padfGeoLocX[i];
+                dfMinY = psTransform->padfGeoLocY[i];
+                dfMaxY = psTransform->padfGeoLocY[i];
+            }
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Decide on resolution for backmap.  We aim for slightly          */
+/*      higher resolution than the source but we can't easily           */
+/*      establish how much dead space there is in the backmap, so it    */
+/*      is approximate.                                                 */
+/* -------------------------------------------------------------------- */
+    const double dfTargetPixels = (nXSize * nYSize * OVERSAMPLE_FACTOR);
+    const double dfPixelSize = sqrt((dfMaxX - dfMinX) * (dfMaxY - dfMinY)
+                              / dfTargetPixels);
+
+    const int nBMYSize = psTransform->nBackMapHeight =
+        static_cast<int>((dfMaxY - dfMinY) / dfPixelSize + 1);
+    const int nBMXSize = psTransform->nBackMapWidth =
+        static_cast<int>((dfMaxX - dfMinX) / dfPixelSize + 1);
+
+    if( nBMXSize > std::numeric_limits<int>::max() / nBMYSize )
+    {
+        CPLError(CE_Failure, CPLE_AppDefined, "Int overflow : %d x %d",
+                 nBMXSize, nBMYSize);
+        return false;
+    }
+
+
+
+    dfMinX -= dfPixelSize / 2.0;
+    dfMaxY += dfPixelSize / 2.0;
+
+
+    psTransform->adfBackMapGeoTransform[0] = dfMinX;
+    psTransform->adfBackMapGeoTransform[1] = dfPixelSize;
+    psTransform->adfBackMapGeoTransform[2] = 0.0;
+    psTransform->adfBackMapGeoTransform[3] = dfMaxY;
+    psTransform->adfBackMapGeoTransform[4] = 0.0;
+    psTransform->adfBackMapGeoTransform[5] = -dfPixelSize;
+
+/* -------------------------------------------------------------------- */
+/*      Decide how to compute the backmap.                              */
+/* -------------------------------------------------------------------- */
+    const int nTilesPerRow =
+        (nBMXSize + BACKMAP_TILE_SIZE - 1) / BACKMAP_TILE_SIZE;
+    const int nTilesPerCol =
+        (nBMYSize + BACKMAP_TILE_SIZE - 1) / BACKMAP_TILE_SIZE;
+    const int nTiles = nTilesPerRow * nTilesPerCol;
+    const size_t nTileBytes = static_cast<size_t>(2) * sizeof(float) *
+                              BACKMAP_TILE_SIZE * BACKMAP_TILE_SIZE;
+    // In MB. Tiles are only computed on demand if a limit is set.
+    const char* pszCacheMax =
+        CPLGetConfigOption("GDAL_GEOLOC_BACKMAP_CACHE_MAX", nullptr);
+    const GUIntBig nCacheMax = pszCacheMax == nullptr ? 0 :
+        static_cast<GUIntBig>(std::max(0, atoi(pszCacheMax)));
+    const bool bTiled = pszCacheMax != nullptr &&
+        static_cast<GUIntBig>(nBMXSize) * nBMYSize * 2 * sizeof(float) >
+            nCacheMax * 1024 * 1024;
+    // Keep at least two rows of tiles, so that points visited in raster
+    // order, as the warper does, do not recompute tiles for each line.
+    const size_t nMaxTiles = std::max(static_cast<size_t>(2) * nTilesPerRow,
+        static_cast<size_t>(nCacheMax * 1024 * 1024 / nTileBytes));
+
+    const char* pszThreads = CPLGetConfigOption("GDAL_NUM_THREADS", "1");
+    int nThreads = EQUAL(pszThreads, "ALL_CPUS") ? CPLGetNumCPUs() :
+                                                   atoi(pszThreads);
+    nThreads = std::min(std::min(nThreads, 128), nTiles);
+
+    if( !bTiled )
+    {
+        psTransform->pafBackMapX = static_cast<float *>(
+            VSI_MALLOC3_VERBOSE(nBMXSize, nBMYSize, sizeof(float)));
+        psTransform->pafBackMapY = static_cast<float *>(
+            VSI_MALLOC3_VERBOSE(nBMXSize, nBMYSize, sizeof(float)));
+        if( psTransform->pafBackMapX == nullptr ||
+            psTransform->pafBackMapY == nullptr )
+        {
+            return false;
+        }
+
+        // With a single thread, compute the backmap in a single pass over
+        // the geolocation arrays, without indexing them by tile.
+        if( nThreads <= 1 )
+        {
+            return GeoLocFillBackMapWindow( psTransform, nullptr, 0,
+                                            0, 0, nBMXSize, nBMYSize,
+                                            psTransform->pafBackMapX,
+                                            psTransform->pafBackMapY );
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Index the geolocation pixels contributing to each tile. The     */
+/*      index has an entry per geolocation pixel, more for pixels in    */
+/*      the margin of several tiles.                                    */
+/* -------------------------------------------------------------------- */
+    GDALGeoLocBackMapTiles *poTiles =
+        new (std::nothrow) GDALGeoLocBackMapTiles(nMaxTiles);
+    if( poTiles == nullptr ||
+        !GeoLocIndexBackMapTiles( psTransform, nTilesPerRow, nTilesPerCol,
+                                  poTiles ) )
+    {
+        delete poTiles;
+        return false;
+    }
+
+    if( bTiled )
+    {
+        CPLDebug("GEOLOC", "Using a tiled backmap of %d x %d "
+                 "(%d x %d tiles, at most %d cached)",
+                 nBMXSize, nBMYSize, nTilesPerRow, nTilesPerCol,
+                 static_cast<int>(nMaxTiles));
+        psTransform->poBackMapTiles = poTiles;
+        return true;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Otherwise compute all the tiles of the backmap in parallel.     */
+/* -------------------------------------------------------------------- */
+    std::vector<GDALGeoLocBackMapJob> asJobs(nTiles);
+    for( int i = 0; i < nTiles; i++ )
+    {
+        asJobs[i].psTransform = psTransform;
+        asJobs[i].poTiles = poTiles;
+        asJobs[i].nTileX = i % nTilesPerRow;
+        asJobs[i].nTileY = i / nTilesPerRow;
+        asJobs[i].bOK = false;
+    }
+
+    CPLWorkerThreadPool *poThreadPool = new (std::nothrow) CPLWorkerThreadPool();
+    if( poThreadPool != nullptr &&
+        !poThreadPool->Setup( nThreads, nullptr, nullptr ) )
+    {
+        delete poThreadPool;
+        poThreadPool = nullptr;
+    }
+    if( poThreadPool != nullptr )
+    {
+        std::vector<void*> apData;
+        for( int i = 0; i < nTiles; i++ )
+            apData.push_back(&asJobs[i]);
+        poThreadPool->SubmitJobs(GeoLocBackMapJobFunc, apData);
+        poThreadPool->WaitCompletion();
+        delete poThreadPool;
+    }
+    else
+    {
+        for( int i = 0; i < nTiles; i++ )
+            GeoLocBackMapJobFunc(&asJobs[i]);
+    }
+
+    delete poTiles;
+
+    for( int i = 0; i < nTiles; i++ )
+    {
+        if( !asJobs[i].bOK )
+            return false;
+    }
 
     return true;
 }
@@ -645,7 +1055,17 @@ void* GDALCreateSimilarGeoLocTransformer( void *hTransformArg,
 /*                    GDALCreateGeoLocTransformer()                     */
 /************************************************************************/
 
-/** Create GeoLocation transformer */
+/** Create GeoLocation transformer
+ *
+ * The backmap used for the georeferenced to pixel/line direction is computed
+ * in a single pass, or by tiles of 256x256 pixels when GDAL_NUM_THREADS
+ * is greater than 1. If GDAL_GEOLOC_BACKMAP_CACHE_MAX is set to a number of
+ * megabytes smaller than the whole backmap, its tiles are computed on demand
+ * instead, and at most that amount of them, but no less than two rows of
+ * tiles, is kept in memory. By default the whole backmap is computed. Tiled
+ * computation also uses an index of the geolocation pixels contributing to
+ * each tile, of about 4 bytes per geolocation pixel.
+ */
 void *GDALCreateGeoLocTransformer( GDALDatasetH hBaseDS,
                                    char **papszGeolocationInfo,
                                    int bReversed )
@@ -827,6 +1247,7 @@ void GDALDestroyGeoLocTransformer( void *pTransformAlg )
 
     CPLFree( psTransform->pafBackMapX );
     CPLFree( psTransform->pafBackMapY );
+    delete psTransform->poBackMapTiles;
     CSLDestroy( psTransform->papszGeolocationInfo );
     CPLFree( psTransform->padfGeoLocX );
     CPLFree( psTransform->padfGeoLocY );
@@ -842,6 +1263,106 @@ void GDALDestroyGeoLocTransformer( void *pTransformAlg )
     CPLFree( pTransformAlg );
 }
 
+/************************************************************************/
+/*                        GeoLocGetBackMapTile()                        */
+/*                                                                      */
+/*      The returned tile stays valid while the caller holds it, even   */
+/*      if another thread evicts it from the cache.                     */
+/************************************************************************/
+
+static GDALGeoLocBackMapTilePtr
+GeoLocGetBackMapTile( GDALGeoLocTransformInfo *psTransform, int iTile )
+{
+    GDALGeoLocBackMapTiles *poTiles = psTransform->poBackMapTiles;
+    GDALGeoLocBackMapTilePtr poTile;
+    {
+        CPLMutexHolderD( &poTiles->hMutex );
+        if( iTile == poTiles->nLastTile )
+            return poTiles->poLastTile;
+        if( poTiles->oCache.tryGet(iTile, poTile) )
+        {
+            poTiles->nLastTile = iTile;
+            poTiles->poLastTile = poTile;
+            return poTile;
+        }
+    }
+
+    // Compute the tile without holding the lock, so that other threads
+    // can use the cached tiles meanwhile. Two threads may compute the same
+    // tile, with identical results.
+    const int nTileX = iTile % poTiles->nTilesPerRow;
+    const int nTileY = iTile / poTiles->nTilesPerRow;
+    try
+    {
+        poTile = std::make_shared<GDALGeoLocBackMapTile>();
+        poTile->afX.resize(BACKMAP_TILE_SIZE * BACKMAP_TILE_SIZE);
+        poTile->afY.resize(BACKMAP_TILE_SIZE * BACKMAP_TILE_SIZE);
+    }
+    catch( const std::bad_alloc& )
+    {
+        CPLError(CE_Failure, CPLE_OutOfMemory,
+                 "Cannot allocate backmap tile");
+        return nullptr;
+    }
+    if( !GeoLocComputeBackMapTile( psTransform, poTiles, nTileX, nTileY,
+                                   poTile->afX.data(), poTile->afY.data(),
+                                   BACKMAP_TILE_SIZE ) )
+    {
+        return nullptr;
+    }
+
+    CPLMutexHolderD( &poTiles->hMutex );
+    poTiles->oCache.insert(iTile, poTile);
+    poTiles->nLastTile = iTile;
+    poTiles->poLastTile = poTile;
+    return poTile;
+}
+
+/************************************************************************/
+/*                        GeoLocGetBackMapValue()                       */
+/*                                                                      */
+/*      Fetches the value of a backmap pixel, or -1 if it is outside    */
+/*      of the backmap.                                                 */
+/************************************************************************/
+
+static void GeoLocGetBackMapValue( GDALGeoLocTransformInfo *psTransform,
+                                   int iBMX, int iBMY,
+                                   float *pfBMX, float *pfBMY )
+{
+    if( iBMX < 0 || iBMY < 0 ||
+        iBMX >= psTransform->nBackMapWidth ||
+        iBMY >= psTransform->nBackMapHeight )
+    {
+        *pfBMX = -1.0f;
+        *pfBMY = -1.0f;
+        return;
+    }
+
+    if( psTransform->poBackMapTiles == nullptr )
+    {
+        const size_t iBM =
+            iBMX + static_cast<size_t>(iBMY) * psTransform->nBackMapWidth;
+        *pfBMX = psTransform->pafBackMapX[iBM];
+        *pfBMY = psTransform->pafBackMapY[iBM];
+        return;
+    }
+
+    const int iTile =
+        iBMX / BACKMAP_TILE_SIZE +
+        (iBMY / BACKMAP_TILE_SIZE) * psTransform->poBackMapTiles->nTilesPerRow;
+    GDALGeoLocBackMapTilePtr poTile = GeoLocGetBackMapTile(psTransform, iTile);
+    if( poTile == nullptr )
+    {
+        *pfBMX = -1.0f;
+        *pfBMY = -1.0f;
+        return;
+    }
+    const int iInTile = (iBMX % BACKMAP_TILE_SIZE) +
+                        (iBMY % BACKMAP_TILE_SIZE) * BACKMAP_TILE_SIZE;
+    *pfBMX = poTile->afX[iInTile];
+    *pfBMY = poTile->afY[iInTile];
+}
+
 /************************************************************************/
 /*                        GDALGeoLocTransform()                         */
 /************************************************************************/
@@ -957,6 +1478,13 @@ int GDALGeoLocTransform( void *pTransformArg,
 /* -------------------------------------------------------------------- */
     else
     {
+        // Backmap fully in memory, read directly except at its edges.
+        const bool bInMemory = psTransform->poBackMapTiles == nullptr;
+        const int nBMXSize = psTransform->nBackMapWidth;
+        const int nBMYSize = psTransform->nBackMapHeight;
+        const float* const pafBackMapX = psTransform->pafBackMapX;
+        const float* const pafBackMapY = psTransform->pafBackMapY;
+
         for( int i = 0; i < nPointCount; i++ )
         {
             if( padfX[i] == HUGE_VAL || padfY[i] == HUGE_VAL )
@@ -975,12 +1503,42 @@ int GDALGeoLocTransform( void *pTransformArg,
             const int iBMX = static_cast<int>(dfBMX);
             const int iBMY = static_cast<int>(dfBMY);
 
-            const int iBM = iBMX + iBMY * psTransform->nBackMapWidth;
+            // Values of the backmap at (iBMX, iBMY), (iBMX + 1, iBMY),
+            // (iBMX, iBMY + 1) and (iBMX + 1, iBMY + 1), read from the
+            // backmap itself when it is in memory, or copied to afBMX and
+            // afBMY.
+            const float* pafBMX = nullptr;
+            const float* pafBMY = nullptr;
+            size_t nStride = 2;
+            float afBMX[4];
+            float afBMY[4];
+            if( bInMemory && iBMX >= 0 && iBMY >= 0 &&
+                iBMX + 1 < nBMXSize && iBMY + 1 < nBMYSize )
+            {
+                const size_t iBM =
+                    iBMX + static_cast<size_t>(iBMY) * nBMXSize;
+                pafBMX = pafBackMapX + iBM;
+                pafBMY = pafBackMapY + iBM;
+                nStride = static_cast<size_t>(nBMXSize);
+            }
+            else
+            {
+                GeoLocGetBackMapValue( psTransform, iBMX, iBMY,
+                                       afBMX, afBMY );
+                if( afBMX[0] >= 0 )
+                {
+                    GeoLocGetBackMapValue( psTransform, iBMX + 1, iBMY,
+                                           afBMX + 1, afBMY + 1 );
+                    GeoLocGetBackMapValue( psTransform, iBMX, iBMY + 1,
+                                           afBMX + 2, afBMY + 2 );
+                    GeoLocGetBackMapValue( psTransform, iBMX + 1, iBMY + 1,
+                                           afBMX + 3, afBMY + 3 );
+                }
+                pafBMX = afBMX;
+                pafBMY = afBMY;
+            }
 
-            if( iBMX < 0 || iBMY < 0
-                || iBMX >= psTransform->nBackMapWidth
-                || iBMY >= psTransform->nBackMapHeight
-                || psTransform->pafBackMapX[iBM] < 0 )
+            if( pafBMX[0] < 0 )
             {
                 panSuccess[i] = FALSE;
                 padfX[i] = HUGE_VAL;
@@ -988,48 +1546,35 @@ int GDALGeoLocTransform( void *pTransformArg,
                 continue;
             }
 
-            float* pafBMX = psTransform->pafBackMapX + iBM;
-            float* pafBMY = psTransform->pafBackMapY + iBM;
-
-            if( iBMX + 1 < psTransform->nBackMapWidth &&
-                iBMY + 1 < psTransform->nBackMapHeight &&
-                pafBMX[1] >=0 && pafBMX[psTransform->nBackMapWidth] >= 0 &&
-                pafBMX[psTransform->nBackMapWidth+1] >= 0)
+            if( pafBMX[1] >= 0 && pafBMX[nStride] >= 0 &&
+                pafBMX[nStride + 1] >= 0 )
             {
                 padfX[i] =
                     (1-(dfBMY - iBMY))
                     * (pafBMX[0] + (dfBMX - iBMX) * (pafBMX[1] - pafBMX[0]))
                     + (dfBMY - iBMY)
-                    * (pafBMX[psTransform->nBackMapWidth] +
-                       (dfBMX - iBMX) * (pafBMX[psTransform->nBackMapWidth+1] -
-                                         pafBMX[psTransform->nBackMapWidth]));
+                    * (pafBMX[nStride] + (dfBMX - iBMX) *
+                       (pafBMX[nStride + 1] - pafBMX[nStride]));
                 padfY[i] =
                     (1-(dfBMY - iBMY))
                     * (pafBMY[0] + (dfBMX - iBMX) * (pafBMY[1] - pafBMY[0]))
                     + (dfBMY - iBMY)
-                    * (pafBMY[psTransform->nBackMapWidth] +
-                       (dfBMX - iBMX) * (pafBMY[psTransform->nBackMapWidth+1] -
-                                         pafBMY[psTransform->nBackMapWidth]));
+                    * (pafBMY[nStride] + (dfBMX - iBMX) *
+                       (pafBMY[nStride + 1] - pafBMY[nStride]));
             }
-            else if( iBMX + 1 < psTransform->nBackMapWidth &&
-                     pafBMX[1] >=0)
+            else if( pafBMX[1] >= 0 )
             {
                 padfX[i] = pafBMX[0] +
                             (dfBMX - iBMX) * (pafBMX[1] - pafBMX[0]);
                 padfY[i] = pafBMY[0] +
                             (dfBMX - iBMX) * (pafBMY[1] - pafBMY[0]);
             }
-            else if( iBMY + 1 < psTransform->nBackMapHeight &&
-                     pafBMX[psTransform->nBackMapWidth] >= 0 )
+            else if( pafBMX[nStride] >= 0 )
             {
-                padfX[i] =
-                    pafBMX[0] +
-                    (dfBMY - iBMY) * (pafBMX[psTransform->nBackMapWidth] -
-                                      pafBMX[0]);
-                padfY[i] =
-                    pafBMY[0] +
-                    (dfBMY - iBMY) * (pafBMY[psTransform->nBackMapWidth] -
-                                      pafBMY[0]);
+                padfX[i] = pafBMX[0] +
+                            (dfBMY - iBMY) * (pafBMX[nStride] - pafBMX[0]);
+                padfY[i] = pafBMY[0] +
+                            (dfBMY - iBMY) * (pafBMY[nStride] - pafBMY[0]);
             }
             else
             {
@@ -38,12 +38,14 @@
 
 #include "cpl_port.h"
 #include "cpl_conv.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdallinearsystem.h"
 
 #ifdef HAVE_ARMADILLO
 #include "armadillo"
 #endif
 
+#include <cmath>
 #include <cstdio>
 #include <vector>
 #include <algorithm>
@@ -129,6 +131,329 @@ bool GDALLinearSystemSolve( const int nDim, const int nRHS,
     return true;
 }
 
+/************************************************************************/
+/*                    GDALLinearSystemSolveInPlace()                    */
+/*                                                                      */
+/*   Same as GDALLinearSystemSolve(), but adfA is used as a work        */
+/*   array and is destroyed, which avoids the N x 2N temporary matrix   */
+/*   of the Gauss-Jordan inversion.  The system is solved with a        */
+/*   blocked LU decomposition with partial pivoting, whose updates are  */
+/*   spread over the threads of poThreadPool when it is not NULL.       */
+/************************************************************************/
+
+#ifndef HAVE_ARMADILLO
+
+// Number of columns factored at once before the trailing matrix is updated.
+constexpr int LU_BLOCK_SIZE = 64;
+// Width of the column tiles of the trailing update, so that the block of U
+// rows being applied stays in cache.
+constexpr int LU_TILE_SIZE = 512;
+// Smallest number of rows (or columns) worth dispatching to a thread.
+constexpr int LU_MIN_ITEMS_PER_JOB = 64;
+
+namespace {
+typedef struct
+{
+    double *padfA;
+    int     nDim;
+    int     iStart;      // Range of rows (or columns for the U job).
+    int     iEnd;
+    int     iCol;        // Pivot column, or first column of the panel.
+    int     iPanelEnd;   // End of the current panel (exclusive).
+    int     iMaxRow;     // Row of the largest |value| of column iCol+1.
+    double  dfMax;
+} GDALLUJob;
+} // namespace
+
+/************************************************************************/
+/*                         GDALLUPanelJobFunc()                         */
+/*                                                                      */
+/*      Eliminates column iCol below the pivot in the rows of the job,  */
+/*      restricted to the columns of the current panel, and looks for   */
+/*      the next pivot candidate in column iCol+1.                      */
+/************************************************************************/
+
+static void GDALLUPanelJobFunc( void *pData )
+{
+    GDALLUJob *psJob = static_cast<GDALLUJob *>(pData);
+    const int nDim = psJob->nDim;
+    const int j = psJob->iCol;
+    const double *padfPivotRow =
+        psJob->padfA + static_cast<size_t>(j) * nDim;
+    const double dfPivot = padfPivotRow[j];
+    const bool bSearchNext = j + 1 < psJob->iPanelEnd;
+
+    for( int i = psJob->iStart; i < psJob->iEnd; i++ )
+    {
+        double *padfRow = psJob->padfA + static_cast<size_t>(i) * nDim;
+        const double dfL = padfRow[j] / dfPivot;
+        padfRow[j] = dfL;
+        if( dfL != 0.0 )
+        {
+            for( int c = j + 1; c < psJob->iPanelEnd; c++ )
+                padfRow[c] -= dfL * padfPivotRow[c];
+        }
+        if( bSearchNext && fabs(padfRow[j + 1]) > psJob->dfMax )
+        {
+            psJob->dfMax = fabs(padfRow[j + 1]);
+            psJob->iMaxRow = i;
+        }
+    }
+}
+
+/************************************************************************/
+/*                           GDALLUUJobFunc()                           */
+/*                                                                      */
+/*      Computes the U12 block of the panel, on a range of columns at   */
+/*      the right of the panel.                                         */
+/************************************************************************/
+
+static void GDALLUUJobFunc( void *pData )
+{
+    const GDALLUJob *psJob = static_cast<const GDALLUJob *>(pData);
+    const int nDim = psJob->nDim;
+    double *padfA = psJob->padfA;
+
+    for( int j = psJob->iCol + 1; j < psJob->iPanelEnd; j++ )
+    {
+        double *padfRow = padfA + static_cast<size_t>(j) * nDim;
+        for( int m = psJob->iCol; m < j; m++ )
+        {
+            const double dfL = padfRow[m];
+            if( dfL == 0.0 )
+                continue;
+            const double *padfU = padfA + static_cast<size_t>(m) * nDim;
+            for( int c = psJob->iStart; c < psJob->iEnd; c++ )
+                padfRow[c] -= dfL * padfU[c];
+        }
+    }
+}
+
+/************************************************************************/
+/*                       GDALLUTrailingJobFunc()                        */
+/*                                                                      */
+/*      A22 -= L21 * U12 on a range of rows of the trailing matrix.     */
+/************************************************************************/
+
+static void GDALLUTrailingJobFunc( void *pData )
+{
+    const GDALLUJob *psJob = static_cast<const GDALLUJob *>(pData);
+    const int nDim = psJob->nDim;
+    const int k0 = psJob->iCol;
+    const int k1 = psJob->iPanelEnd;
+    double *padfA = psJob->padfA;
+
+    for( int c0 = k1; c0 < nDim; c0 += LU_TILE_SIZE )
+    {
+        const int c1 = std::min(nDim, c0 + LU_TILE_SIZE);
+        for( int i = psJob->iStart; i < psJob->iEnd; i++ )
+        {
+            double *padfRow = padfA + static_cast<size_t>(i) * nDim;
+            int m = k0;
+            for( ; m + 3 < k1; m += 4 )
+            {
+                const double dfL0 = padfRow[m];
+                const double dfL1 = padfRow[m + 1];
+                const double dfL2 = padfRow[m + 2];
+                const double dfL3 = padfRow[m + 3];
+                const double *padfU0 = padfA + static_cast<size_t>(m) * nDim;
+                const double *padfU1 = padfU0 + nDim;
+                const double *padfU2 = padfU1 + nDim;
+                const double *padfU3 = padfU2 + nDim;
+                for( int c = c0; c < c1; c++ )
+                {
+                    padfRow[c] -= dfL0 * padfU0[c] + dfL1 * padfU1[c] +
+                                  dfL2 * padfU2[c] + dfL3 * padfU3[c];
+                }
+            }
+            for( ; m < k1; m++ )
+            {
+                const double dfL = padfRow[m];
+                const double *padfU = padfA + static_cast<size_t>(m) * nDim;
+                for( int c = c0; c < c1; c++ )
+                    padfRow[c] -= dfL * padfU[c];
+            }
+        }
+    }
+}
+
+/************************************************************************/
+/*                           GDALLURunJobs()                            */
+/*                                                                      */
+/*      Splits [iStart,iEnd) among the threads of the pool, or runs it  */
+/*      in the current thread if it is too small.  Returns the number   */
+/*      of jobs used.                                                   */
+/************************************************************************/
+
+static int GDALLURunJobs( CPLWorkerThreadPool *poThreadPool,
+                          CPLThreadFunc pfnFunc,
+                          const GDALLUJob &sTemplate,
+                          int iStart, int iEnd,
+                          std::vector<GDALLUJob> &asJobs )
+{
+    const int nItems = iEnd - iStart;
+    int nJobs = 1;
+    if( poThreadPool != nullptr )
+    {
+        nJobs = std::max(1, std::min(static_cast<int>(asJobs.size()),
+                                     nItems / LU_MIN_ITEMS_PER_JOB));
+    }
+
+    std::vector<void *> apData;
+    for( int i = 0; i < nJobs; i++ )
+    {
+        asJobs[i] = sTemplate;
+        asJobs[i].iStart = iStart + static_cast<int>(
+            static_cast<GIntBig>(nItems) * i / nJobs);
+        asJobs[i].iEnd = iStart + static_cast<int>(
+            static_cast<GIntBig>(nItems) * (i + 1) / nJobs);
+        asJobs[i].iMaxRow = -1;
+        asJobs[i].dfMax = -1.0;
+        apData.push_back(&asJobs[i]);
+    }
+
+    if( nJobs == 1 )
+    {
+        pfnFunc(apData[0]);
+    }
+    else
+    {
+        poThreadPool->SubmitJobs(pfnFunc, apData);
+        poThreadPool->WaitCompletion();
+    }
+    return nJobs;
+}
+
+#endif // HAVE_ARMADILLO
+
+bool GDALLinearSystemSolveInPlace( const int nDim, const int nRHS,
+    double adfA[], const double adfRHS[], double adfOut[],
+    CPLWorkerThreadPool* poThreadPool )
+{
+#ifdef HAVE_ARMADILLO
+    // LAPACK already does a blocked factorization.
+    CPL_IGNORE_RET_VAL(poThreadPool);
+    return GDALLinearSystemSolve( nDim, nRHS, adfA, adfRHS, adfOut );
+#else
+    std::vector<int> anPivots(nDim);
+    std::vector<GDALLUJob> asJobs(
+        poThreadPool ? std::max(1, poThreadPool->GetThreadCount()) : 1);
+
+    GDALLUJob sTemplate;
+    sTemplate.padfA = adfA;
+    sTemplate.nDim = nDim;
+    sTemplate.iStart = 0;
+    sTemplate.iEnd = 0;
+    sTemplate.iMaxRow = -1;
+    sTemplate.dfMax = -1.0;
+
+/* -------------------------------------------------------------------- */
+/*      Factor PA = LU, LU_BLOCK_SIZE columns at a time.                */
+/* -------------------------------------------------------------------- */
+    for( int k0 = 0; k0 < nDim; k0 += LU_BLOCK_SIZE )
+    {
+        const int k1 = std::min(nDim, k0 + LU_BLOCK_SIZE);
+        sTemplate.iPanelEnd = k1;
+
+        int iMaxRow = k0;
+        double dfMax = fabs(adfA[static_cast<size_t>(k0) * nDim + k0]);
+        for( int i = k0 + 1; i < nDim; i++ )
+        {
+            const double dfVal = fabs(adfA[static_cast<size_t>(i) * nDim + k0]);
+            if( dfVal > dfMax )
+            {
+                dfMax = dfVal;
+                iMaxRow = i;
+            }
+        }
+
+        for( int j = k0; j < k1; j++ )
+        {
+            if( dfMax == 0.0 )
+            {
+                // Singular matrix.
+                return false;
+            }
+
+            anPivots[j] = iMaxRow;
+            if( iMaxRow != j )
+            {
+                std::swap_ranges(adfA + static_cast<size_t>(j) * nDim,
+                                 adfA + static_cast<size_t>(j + 1) * nDim,
+                                 adfA + static_cast<size_t>(iMaxRow) * nDim);
+            }
+
+            sTemplate.iCol = j;
+            const int nJobs = GDALLURunJobs( poThreadPool, GDALLUPanelJobFunc,
+                                             sTemplate, j + 1, nDim, asJobs );
+
+            // Jobs are visited in row order so that the pivot does not
+            // depend on the number of threads.
+            iMaxRow = j + 1;
+            dfMax = -1.0;
+            for( int i = 0; i < nJobs; i++ )
+            {
+                if( asJobs[i].dfMax > dfMax )
+                {
+                    dfMax = asJobs[i].dfMax;
+                    iMaxRow = asJobs[i].iMaxRow;
+                }
+            }
+        }
+
+        if( k1 < nDim )
+        {
+            sTemplate.iCol = k0;
+            GDALLURunJobs( poThreadPool, GDALLUUJobFunc,
+                           sTemplate, k1, nDim, asJobs );
+            GDALLURunJobs( poThreadPool, GDALLUTrailingJobFunc,
+                           sTemplate, k1, nDim, asJobs );
+        }
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Apply the row interchanges to the right-hand sides and solve    */
+/*      L.U.X = P.RHS by forward and back substitution.                 */
+/* -------------------------------------------------------------------- */
+    std::copy(adfRHS, adfRHS + static_cast<size_t>(nDim) * nRHS, adfOut);
+    for( int j = 0; j < nDim; j++ )
+    {
+        if( anPivots[j] != j )
+        {
+            std::swap_ranges(adfOut + static_cast<size_t>(j) * nRHS,
+                             adfOut + static_cast<size_t>(j + 1) * nRHS,
+                             adfOut + static_cast<size_t>(anPivots[j]) * nRHS);
+        }
+    }
+
+    for( int i = 1; i < nDim; i++ )
+    {
+        const double *padfRow = adfA + static_cast<size_t>(i) * nDim;
+        for( int iRHS = 0; iRHS < nRHS; iRHS++ )
+        {
+            double dfSum = adfOut[static_cast<size_t>(i) * nRHS + iRHS];
+            for( int m = 0; m < i; m++ )
+                dfSum -= padfRow[m] * adfOut[static_cast<size_t>(m) * nRHS + iRHS];
+            adfOut[static_cast<size_t>(i) * nRHS + iRHS] = dfSum;
+        }
+    }
+
+    for( int i = nDim - 1; i >= 0; i-- )
+    {
+        const double *padfRow = adfA + static_cast<size_t>(i) * nDim;
+        for( int iRHS = 0; iRHS < nRHS; iRHS++ )
+        {
+            double dfSum = adfOut[static_cast<size_t>(i) * nRHS + iRHS];
+            for( int m = i + 1; m < nDim; m++ )
+                dfSum -= padfRow[m] * adfOut[static_cast<size_t>(m) * nRHS + iRHS];
+            adfOut[static_cast<size_t>(i) * nRHS + iRHS] = dfSum / padfRow[i];
+        }
+    }
+
+    return true;
+#endif
+}
+
 static int matrixInvert( int N, const double input[], double output[] )
 {
     // Receives an array of dimension NxN as input.  This is passed as a one-
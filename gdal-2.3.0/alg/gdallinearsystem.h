@@ -31,9 +31,15 @@
 #ifndef GDALLINEARSYSTEM_H_INCLUDED
 #define GDALLINEARSYSTEM_H_INCLUDED
 
+class CPLWorkerThreadPool;
+
 bool GDALLinearSystemSolve( const int nDim, const int nRHS,
     const double adfA[], const double adfRHS[], double adfOut[] );
 
+bool GDALLinearSystemSolveInPlace( const int nDim, const int nRHS,
+    double adfA[], const double adfRHS[], double adfOut[],
+    CPLWorkerThreadPool* poThreadPool );
+
 #endif /* #ifndef GDALLINEARSYSTEM_H_INCLUDED */
 
 /*! @endcond */
@@ -32,17 +32,21 @@
 #include "gdal_alg_priv.h"
 
 #include <climits>
+#include <cmath>
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
+#include <new>
 #include <vector>
 #include <algorithm>
+#include <utility>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal.h"
 #include "gdal_priv.h"
 #include "ogr_api.h"
@@ -325,71 +329,23 @@ static void GDALCollectRingsFromGeometry(
 }
 
 /************************************************************************/
-/*                       gv_rasterize_one_shape()                       */
+/*                         gvBurnCollectedRings()                       */
+/*                                                                      */
+/*      Burn rings collected by GDALCollectRingsFromGeometry(), already */
+/*      expressed in pixel/line coordinates of the buffer of psInfo.    */
 /************************************************************************/
-static void
-gv_rasterize_one_shape( unsigned char *pabyChunkBuf, int nXOff, int nYOff,
-                        int nXSize, int nYSize,
-                        int nBands, GDALDataType eType, int bAllTouched,
-                        OGRGeometry *poShape, double *padfBurnValue,
-                        GDALBurnValueSrc eBurnValueSrc,
-                        GDALRasterMergeAlg eMergeAlg,
-                        GDALTransformerFunc pfnTransformer,
-                        void *pTransformArg )
-
-{
-    if( poShape == nullptr || poShape->IsEmpty() )
-        return;
-
-    GDALRasterizeInfo sInfo;
-    sInfo.nXSize = nXSize;
-    sInfo.nYSize = nYSize;
-    sInfo.nBands = nBands;
-    sInfo.pabyChunkBuf = pabyChunkBuf;
-    sInfo.eType = eType;
-    sInfo.padfBurnValue = padfBurnValue;
-    sInfo.eBurnValueSource = eBurnValueSrc;
-    sInfo.eMergeAlg = eMergeAlg;
-
-/* -------------------------------------------------------------------- */
-/*      Transform polygon geometries into a set of rings and a part     */
-/*      size list.                                                      */
-/* -------------------------------------------------------------------- */
-    std::vector<double> aPointX;
-    std::vector<double> aPointY;
-    std::vector<double> aPointVariant;
-    std::vector<int> aPartSize;
-
-    GDALCollectRingsFromGeometry( poShape, aPointX, aPointY, aPointVariant,
-                                  aPartSize, eBurnValueSrc );
-
-/* -------------------------------------------------------------------- */
-/*      Transform points if needed.                                     */
-/* -------------------------------------------------------------------- */
-    if( pfnTransformer != nullptr )
-    {
-        int *panSuccess =
-            static_cast<int *>(CPLCalloc(sizeof(int), aPointX.size()));
 
-        // TODO: We need to add all appropriate error checking at some point.
-        pfnTransformer( pTransformArg, FALSE, static_cast<int>(aPointX.size()),
-                        &(aPointX[0]), &(aPointY[0]), nullptr, panSuccess );
-        CPLFree( panSuccess );
-    }
-
-/* -------------------------------------------------------------------- */
-/*      Shift to account for the buffer offset of this buffer.          */
-/* -------------------------------------------------------------------- */
-    for( unsigned int i = 0; i < aPointX.size(); i++ )
-        aPointX[i] -= nXOff;
-    for( unsigned int i = 0; i < aPointY.size(); i++ )
-        aPointY[i] -= nYOff;
+static void gvBurnCollectedRings( GDALRasterizeInfo *psInfo,
+                                  OGRwkbGeometryType eFlatType,
+                                  int bAllTouched,
+                                  std::vector<double> &aPointX,
+                                  std::vector<double> &aPointY,
+                                  std::vector<double> &aPointVariant,
+                                  std::vector<int> &aPartSize )
 
-/* -------------------------------------------------------------------- */
-/*      Perform the rasterization.                                      */
-/*      According to the C++ Standard/23.2.4, elements of a vector are  */
-/*      stored in continuous memory block.                              */
-/* -------------------------------------------------------------------- */
+{
+    const GDALBurnValueSrc eBurnValueSrc = psInfo->eBurnValueSource;
+    const int nYSize = psInfo->nYSize;
 
     // TODO - mloskot: Check if vectors are empty, otherwise it may
     // lead to undefined behavior by returning non-referencable pointer.
@@ -397,48 +353,48 @@ gv_rasterize_one_shape( unsigned char *pabyChunkBuf, int nXOff, int nYOff,
     //    // Fill polygon.
     // else
     //    // How to report this problem?
-    switch( wkbFlatten(poShape->getGeometryType()) )
+    switch( eFlatType )
     {
       case wkbPoint:
       case wkbMultiPoint:
-        GDALdllImagePoint( sInfo.nXSize, nYSize,
+        GDALdllImagePoint( psInfo->nXSize, nYSize,
                            static_cast<int>(aPartSize.size()), &(aPartSize[0]),
                            &(aPointX[0]), &(aPointY[0]),
                            (eBurnValueSrc == GBV_UserBurnValue)?
                            nullptr : &(aPointVariant[0]),
-                           gvBurnPoint, &sInfo );
+                           gvBurnPoint, psInfo );
         break;
       case wkbLineString:
       case wkbMultiLineString:
       {
           if( bAllTouched )
-              GDALdllImageLineAllTouched( sInfo.nXSize, nYSize,
+              GDALdllImageLineAllTouched( psInfo->nXSize, nYSize,
                                           static_cast<int>(aPartSize.size()),
                                           &(aPartSize[0]),
                                           &(aPointX[0]), &(aPointY[0]),
                                           (eBurnValueSrc == GBV_UserBurnValue)?
                                           nullptr : &(aPointVariant[0]),
-                                          gvBurnPoint, &sInfo );
+                                          gvBurnPoint, psInfo );
           else
-              GDALdllImageLine( sInfo.nXSize, nYSize,
+              GDALdllImageLine( psInfo->nXSize, nYSize,
                                 static_cast<int>(aPartSize.size()),
                                 &(aPartSize[0]),
                                 &(aPointX[0]), &(aPointY[0]),
                                 (eBurnValueSrc == GBV_UserBurnValue)?
                                 nullptr : &(aPointVariant[0]),
-                                gvBurnPoint, &sInfo );
+                                gvBurnPoint, psInfo );
       }
       break;
 
       default:
       {
           GDALdllImageFilledPolygon(
-              sInfo.nXSize, nYSize,
+              psInfo->nXSize, nYSize,
               static_cast<int>(aPartSize.size()), &(aPartSize[0]),
               &(aPointX[0]), &(aPointY[0]),
               (eBurnValueSrc == GBV_UserBurnValue)?
               nullptr : &(aPointVariant[0]),
-              gvBurnScanline, &sInfo );
+              gvBurnScanline, psInfo );
           if( bAllTouched )
           {
               // Reverting the variants to the first value because the
@@ -448,11 +404,11 @@ gv_rasterize_one_shape( unsigned char *pabyChunkBuf, int nXOff, int nYOff,
               if( eBurnValueSrc == GBV_UserBurnValue )
               {
                   GDALdllImageLineAllTouched(
-                      sInfo.nXSize, nYSize,
+                      psInfo->nXSize, nYSize,
                       static_cast<int>(aPartSize.size()), &(aPartSize[0]),
                       &(aPointX[0]), &(aPointY[0]),
                       nullptr,
-                      gvBurnPoint, &sInfo );
+                      gvBurnPoint, psInfo );
               }
               else
               {
@@ -465,11 +421,11 @@ gv_rasterize_one_shape( unsigned char *pabyChunkBuf, int nXOff, int nYOff,
                   }
 
                   GDALdllImageLineAllTouched(
-                      sInfo.nXSize, nYSize,
+                      psInfo->nXSize, nYSize,
                       static_cast<int>(aPartSize.size()), &(aPartSize[0]),
                       &(aPointX[0]), &(aPointY[0]),
                       &(aPointVariant[0]),
-                      gvBurnPoint, &sInfo );
+                      gvBurnPoint, psInfo );
               }
           }
       }
@@ -477,6 +433,569 @@ gv_rasterize_one_shape( unsigned char *pabyChunkBuf, int nXOff, int nYOff,
     }
 }
 
+/************************************************************************/
+/*                       gv_rasterize_one_shape()                       */
+/************************************************************************/
+static void
+gv_rasterize_one_shape( unsigned char *pabyChunkBuf, int nXOff, int nYOff,
+                        int nXSize, int nYSize,
+                        int nBands, GDALDataType eType, int bAllTouched,
+                        OGRGeometry *poShape, double *padfBurnValue,
+                        GDALBurnValueSrc eBurnValueSrc,
+                        GDALRasterMergeAlg eMergeAlg,
+                        GDALTransformerFunc pfnTransformer,
+                        void *pTransformArg )
+
+{
+    if( poShape == nullptr || poShape->IsEmpty() )
+        return;
+
+    GDALRasterizeInfo sInfo;
+    sInfo.nXSize = nXSize;
+    sInfo.nYSize = nYSize;
+    sInfo.nBands = nBands;
+    sInfo.pabyChunkBuf = pabyChunkBuf;
+    sInfo.eType = eType;
+    sInfo.padfBurnValue = padfBurnValue;
+    sInfo.eBurnValueSource = eBurnValueSrc;
+    sInfo.eMergeAlg = eMergeAlg;
+
+/* -------------------------------------------------------------------- */
+/*      Transform polygon geometries into a set of rings and a part     */
+/*      size list.                                                      */
+/* -------------------------------------------------------------------- */
+    std::vector<double> aPointX;
+    std::vector<double> aPointY;
+    std::vector<double> aPointVariant;
+    std::vector<int> aPartSize;
+
+    GDALCollectRingsFromGeometry( poShape, aPointX, aPointY, aPointVariant,
+                                  aPartSize, eBurnValueSrc );
+
+/* -------------------------------------------------------------------- */
+/*      Transform points if needed.                                     */
+/* -------------------------------------------------------------------- */
+    if( pfnTransformer != nullptr )
+    {
+        int *panSuccess =
+            static_cast<int *>(CPLCalloc(sizeof(int), aPointX.size()));
+
+        // TODO: We need to add all appropriate error checking at some point.
+        pfnTransformer( pTransformArg, FALSE, static_cast<int>(aPointX.size()),
+                        &(aPointX[0]), &(aPointY[0]), nullptr, panSuccess );
+        CPLFree( panSuccess );
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Shift to account for the buffer offset of this buffer.          */
+/* -------------------------------------------------------------------- */
+    for( unsigned int i = 0; i < aPointX.size(); i++ )
+        aPointX[i] -= nXOff;
+    for( unsigned int i = 0; i < aPointY.size(); i++ )
+        aPointY[i] -= nYOff;
+
+/* -------------------------------------------------------------------- */
+/*      Perform the rasterization.                                      */
+/*      According to the C++ Standard/23.2.4, elements of a vector are  */
+/*      stored in continuous memory block.                              */
+/* -------------------------------------------------------------------- */
+    gvBurnCollectedRings( &sInfo, wkbFlatten(poShape->getGeometryType()),
+                          bAllTouched, aPointX, aPointY, aPointVariant,
+                          aPartSize );
+}
+
+/************************************************************************/
+/*                     Multithreaded strip rasterization                */
+/*                                                                      */
+/*      The chunk being rendered is divided into horizontal strips of   */
+/*      fixed height. Features are read, converted into pixel/line      */
+/*      rings and bucketed into the strips their Y extent overlaps on   */
+/*      the calling thread, and the strips are then burnt concurrently, */
+/*      each one visiting its shapes in feature order. Since a pixel    */
+/*      belongs to a single strip and the strip layout does not depend  */
+/*      on the number of threads, the result is deterministic, including*/
+/*      with MERGE_ALG=ADD.                                             */
+/************************************************************************/
+
+namespace {
+
+// Shape in pixel/line coordinates of the raster (not shifted by any buffer
+// offset yet).
+struct GDALRasterizeShape
+{
+    OGRwkbGeometryType  eFlatType = wkbUnknown;
+    std::vector<double> aPointX{};
+    std::vector<double> aPointY{};
+    std::vector<double> aPointVariant{};
+    std::vector<int>    aPartSize{};
+    std::vector<double> adfBurnValues{};
+};
+
+struct GDALRasterizeStripJob
+{
+    // Shared state of the chunk.
+    unsigned char      *pabyChunkBuf = nullptr;
+    int                 nXSize = 0;
+    int                 nChunkYOff = 0;
+    int                 nChunkYSize = 0;
+    int                 nBands = 0;
+    GDALDataType        eType = GDT_Byte;
+    int                 bAllTouched = FALSE;
+    GDALBurnValueSrc    eBurnValueSrc = GBV_UserBurnValue;
+    GDALRasterMergeAlg  eMergeAlg = GRMA_Replace;
+    const std::vector<GDALRasterizeShape> *paoShapes = nullptr;
+
+    // Strip specific.
+    int                 nStripYOff = 0;  // Relative to the chunk.
+    int                 nStripYSize = 0;
+    std::vector<int>    anShapes{};      // Indices in *paoShapes.
+
+    // Set by the worker thread if it could not allocate its strip buffer.
+    // Reported by the calling thread.
+    bool                bOutOfMemory = false;
+};
+
+// Supplies the geometries to burn, with their burn values, to
+// GDALRasterizeChunkMultiThreaded().
+class GDALRasterizeShapeSource
+{
+  public:
+    virtual ~GDALRasterizeShapeSource() {}
+
+    // Fetch the next geometry, which may be nullptr, and its nBandCount
+    // burn values. The geometry remains valid until the next call.
+    // Returns false once all geometries have been fetched.
+    virtual bool GetNextShape( OGRGeometry **ppoGeom,
+                               std::vector<double> &adfBurnValues ) = 0;
+};
+
+// Features of a layer, burnt with the value of a field or with fixed
+// values.
+class GDALRasterizeLayerShapeSource final: public GDALRasterizeShapeSource
+{
+    OGRLayer      *m_poLayer;
+    int            m_nBandCount;
+    int            m_iBurnField;
+    const double  *m_padfBurnValues;
+    OGRFeature    *m_poFeature = nullptr;
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALRasterizeLayerShapeSource)
+
+  public:
+    GDALRasterizeLayerShapeSource( OGRLayer *poLayer, int nBandCount,
+                                   int iBurnField,
+                                   const double *padfBurnValues ) :
+        m_poLayer(poLayer), m_nBandCount(nBandCount),
+        m_iBurnField(iBurnField), m_padfBurnValues(padfBurnValues) {}
+
+    ~GDALRasterizeLayerShapeSource() override { delete m_poFeature; }
+
+    bool GetNextShape( OGRGeometry **ppoGeom,
+                       std::vector<double> &adfBurnValues ) override
+    {
+        delete m_poFeature;
+        m_poFeature = m_poLayer->GetNextFeature();
+        if( m_poFeature == nullptr )
+            return false;
+        *ppoGeom = m_poFeature->GetGeometryRef();
+        if( m_iBurnField >= 0 )
+            adfBurnValues.assign(
+                m_nBandCount, m_poFeature->GetFieldAsDouble( m_iBurnField ));
+        else
+            adfBurnValues.assign(m_padfBurnValues,
+                                 m_padfBurnValues + m_nBandCount);
+        return true;
+    }
+};
+
+// Array of geometries, with nBandCount burn values per geometry.
+class GDALRasterizeGeometryShapeSource final: public GDALRasterizeShapeSource
+{
+    int            m_nGeomCount;
+    OGRGeometryH  *m_pahGeometries;
+    int            m_nBandCount;
+    const double  *m_padfBurnValues;
+    int            m_iGeom = 0;
+
+    CPL_DISALLOW_COPY_ASSIGN(GDALRasterizeGeometryShapeSource)
+
+  public:
+    GDALRasterizeGeometryShapeSource( int nGeomCount,
+                                      OGRGeometryH *pahGeometries,
+                                      int nBandCount,
+                                      const double *padfBurnValues ) :
+        m_nGeomCount(nGeomCount), m_pahGeometries(pahGeometries),
+        m_nBandCount(nBandCount), m_padfBurnValues(padfBurnValues) {}
+
+    bool GetNextShape( OGRGeometry **ppoGeom,
+                       std::vector<double> &adfBurnValues ) override
+    {
+        if( m_iGeom == m_nGeomCount )
+            return false;
+        *ppoGeom = reinterpret_cast<OGRGeometry *>(m_pahGeometries[m_iGeom]);
+        const double *padfValues =
+            m_padfBurnValues + static_cast<size_t>(m_iGeom) * m_nBandCount;
+        adfBurnValues.assign(padfValues, padfValues + m_nBandCount);
+        m_iGeom++;
+        return true;
+    }
+};
+
+// Upper bounds of a batch of prepared shapes.
+constexpr size_t RASTERIZE_MAX_SHAPES_PER_BATCH = 10000;
+constexpr size_t RASTERIZE_MAX_POINTS_PER_BATCH = 10 * 1000 * 1000;
+
+// Number of strips a chunk is divided into, unless they would be thinner
+// than RASTERIZE_MIN_STRIP_HEIGHT lines.
+constexpr int RASTERIZE_STRIPS_PER_CHUNK = 64;
+constexpr int RASTERIZE_MIN_STRIP_HEIGHT = 16;
+
+} // namespace
+
+/************************************************************************/
+/*                      GDALRasterizeGetNumThreads()                    */
+/************************************************************************/
+
+static int GDALRasterizeGetNumThreads( char **papszOptions )
+{
+    const char *pszNumThreads =
+        CSLFetchNameValueDef(papszOptions, "NUM_THREADS", "1");
+
+    int nThreads = 0;
+    if( EQUAL(pszNumThreads, "ALL_CPUS") )
+        nThreads = CPLGetNumCPUs();
+    else
+        nThreads = atoi(pszNumThreads);
+    if( nThreads > 128 )
+        nThreads = 128;
+    return nThreads;
+}
+
+/************************************************************************/
+/*                        GDALRasterizePrepareShape()                   */
+/*                                                                      */
+/*      Collect the rings of a geometry and transform them into         */
+/*      pixel/line coordinates. Returns false if there is nothing to    */
+/*      burn.                                                           */
+/************************************************************************/
+
+static bool GDALRasterizePrepareShape( OGRGeometry *poShape,
+                                       GDALBurnValueSrc eBurnValueSrc,
+                                       GDALTransformerFunc pfnTransformer,
+                                       void *pTransformArg,
+                                       GDALRasterizeShape &oShape )
+{
+    if( poShape == nullptr || poShape->IsEmpty() )
+        return false;
+
+    oShape.eFlatType = wkbFlatten(poShape->getGeometryType());
+    GDALCollectRingsFromGeometry( poShape, oShape.aPointX, oShape.aPointY,
+                                  oShape.aPointVariant, oShape.aPartSize,
+                                  eBurnValueSrc );
+    if( oShape.aPartSize.empty() || oShape.aPointX.empty() )
+        return false;
+
+    if( pfnTransformer != nullptr )
+    {
+        int *panSuccess =
+            static_cast<int *>(CPLCalloc(sizeof(int), oShape.aPointX.size()));
+
+        // TODO: We need to add all appropriate error checking at some point.
+        pfnTransformer( pTransformArg, FALSE,
+                        static_cast<int>(oShape.aPointX.size()),
+                        &(oShape.aPointX[0]), &(oShape.aPointY[0]),
+                        nullptr, panSuccess );
+        CPLFree( panSuccess );
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                        GDALRasterizeStripFunc()                      */
+/************************************************************************/
+
+static void GDALRasterizeStripFunc( void *pData )
+{
+    GDALRasterizeStripJob *psJob = static_cast<GDALRasterizeStripJob *>(pData);
+
+    const size_t nLineBytes = static_cast<size_t>(psJob->nXSize) *
+                              GDALGetDataTypeSizeBytes(psJob->eType);
+    const size_t nStripBandBytes = nLineBytes * psJob->nStripYSize;
+
+/* -------------------------------------------------------------------- */
+/*      With a single band, the lines of the strip are contiguous in    */
+/*      the chunk buffer and can be burnt in place. Otherwise work on   */
+/*      a band-sequential copy of the strip.                            */
+/* -------------------------------------------------------------------- */
+    std::vector<GByte> abyStripBuf;
+    unsigned char *pabyStripBuf = nullptr;
+    if( psJob->nBands == 1 )
+    {
+        pabyStripBuf = psJob->pabyChunkBuf + psJob->nStripYOff * nLineBytes;
+    }
+    else
+    {
+        try
+        {
+            abyStripBuf.resize(nStripBandBytes * psJob->nBands);
+        }
+        catch( const std::exception& )
+        {
+            psJob->bOutOfMemory = true;
+            return;
+        }
+        pabyStripBuf = &abyStripBuf[0];
+        for( int iBand = 0; iBand < psJob->nBands; iBand++ )
+        {
+            memcpy( pabyStripBuf + iBand * nStripBandBytes,
+                    psJob->pabyChunkBuf +
+                        (static_cast<size_t>(iBand) * psJob->nChunkYSize +
+                         psJob->nStripYOff) * nLineBytes,
+                    nStripBandBytes );
+        }
+    }
+
+    GDALRasterizeInfo sInfo;
+    sInfo.nXSize = psJob->nXSize;
+    sInfo.nYSize = psJob->nStripYSize;
+    sInfo.nBands = psJob->nBands;
+    sInfo.pabyChunkBuf = pabyStripBuf;
+    sInfo.eType = psJob->eType;
+    sInfo.eBurnValueSource = psJob->eBurnValueSrc;
+    sInfo.eMergeAlg = psJob->eMergeAlg;
+
+    const int nYOff = psJob->nChunkYOff + psJob->nStripYOff;
+    std::vector<double> aPointX;
+    std::vector<double> aPointY;
+    std::vector<double> aPointVariant;
+    std::vector<int> aPartSize;
+    std::vector<double> adfBurnValues;
+
+    for( const int iShape : psJob->anShapes )
+    {
+        const GDALRasterizeShape &oShape = (*psJob->paoShapes)[iShape];
+
+        // The rasterizers work in place, so use scratch copies.
+        aPointX = oShape.aPointX;
+        aPointY.resize(oShape.aPointY.size());
+        for( size_t i = 0; i < aPointY.size(); i++ )
+        {
+            aPointY[i] = oShape.aPointY[i];
+            aPointY[i] -= nYOff;
+        }
+        aPointVariant = oShape.aPointVariant;
+        aPartSize = oShape.aPartSize;
+        adfBurnValues = oShape.adfBurnValues;
+        sInfo.padfBurnValue = &adfBurnValues[0];
+
+        gvBurnCollectedRings( &sInfo, oShape.eFlatType, psJob->bAllTouched,
+                              aPointX, aPointY, aPointVariant, aPartSize );
+    }
+
+    if( psJob->nBands > 1 )
+    {
+        for( int iBand = 0; iBand < psJob->nBands; iBand++ )
+        {
+            memcpy( psJob->pabyChunkBuf +
+                        (static_cast<size_t>(iBand) * psJob->nChunkYSize +
+                         psJob->nStripYOff) * nLineBytes,
+                    pabyStripBuf + iBand * nStripBandBytes,
+                    nStripBandBytes );
+        }
+    }
+}
+
+/************************************************************************/
+/*                  GDALRasterizeCheckStripJobs()                       */
+/*                                                                      */
+/*      Report a failure of the worker threads once they are done with */
+/*      asJobs.                                                         */
+/************************************************************************/
+
+static CPLErr GDALRasterizeCheckStripJobs(
+    const std::vector<GDALRasterizeStripJob> &asJobs )
+{
+    for( const auto &sJob : asJobs )
+    {
+        if( sJob.bOutOfMemory )
+        {
+            CPLError(CE_Failure, CPLE_OutOfMemory,
+                     "Cannot allocate strip buffer");
+            return CE_Failure;
+        }
+    }
+    return CE_None;
+}
+
+/************************************************************************/
+/*                     GDALRasterizeChunkMultiThreaded()                */
+/*                                                                      */
+/*      Burn all shapes of oSource into the chunk buffer, with the      */
+/*      strips being processed by the worker threads of poThreadPool.   */
+/*      While a batch of shapes is burnt, the next one is read and      */
+/*      prepared on the calling thread.                                 */
+/************************************************************************/
+
+static CPLErr GDALRasterizeChunkMultiThreaded(
+    CPLWorkerThreadPool *poThreadPool, GDALRasterizeShapeSource &oSource,
+    unsigned char *pabyChunkBuf, int nXSize, int nYChunkSize,
+    int nChunkYOff, int nThisYChunkSize,
+    int nBandCount, GDALDataType eType, int bAllTouched,
+    GDALBurnValueSrc eBurnValueSrc, GDALRasterMergeAlg eMergeAlg,
+    GDALTransformerFunc pfnTransformer, void *pTransformArg )
+{
+    // The strip layout only depends on the chunk size, so that the result
+    // does not depend on the number of threads.
+    const int nStripYSize = std::max(
+        RASTERIZE_MIN_STRIP_HEIGHT,
+        (nYChunkSize + RASTERIZE_STRIPS_PER_CHUNK - 1) /
+            RASTERIZE_STRIPS_PER_CHUNK);
+    const int nStrips = (nThisYChunkSize + nStripYSize - 1) / nStripYSize;
+
+    // Two sets of shapes and jobs, so that a batch can be prepared while the
+    // previous one is being burnt.
+    std::vector<GDALRasterizeShape> aoShapes[2];
+    std::vector<GDALRasterizeStripJob> asJobs[2];
+    for( int iSet = 0; iSet < 2; iSet++ )
+    {
+        asJobs[iSet].resize(nStrips);
+        for( int iStrip = 0; iStrip < nStrips; iStrip++ )
+        {
+            GDALRasterizeStripJob &sJob = asJobs[iSet][iStrip];
+            sJob.pabyChunkBuf = pabyChunkBuf;
+            sJob.nXSize = nXSize;
+            sJob.nChunkYOff = nChunkYOff;
+            sJob.nChunkYSize = nThisYChunkSize;
+            sJob.nBands = nBandCount;
+            sJob.eType = eType;
+            sJob.bAllTouched = bAllTouched;
+            sJob.eBurnValueSrc = eBurnValueSrc;
+            sJob.eMergeAlg = eMergeAlg;
+            sJob.paoShapes = &aoShapes[iSet];
+            sJob.nStripYOff = iStrip * nStripYSize;
+            sJob.nStripYSize =
+                std::min(nStripYSize, nThisYChunkSize - sJob.nStripYOff);
+        }
+    }
+
+    int iSet = 0;
+    bool bEOF = false;
+    CPLErr eErr = CE_None;
+    while( !bEOF && eErr == CE_None )
+    {
+        std::vector<GDALRasterizeShape> &aoBatch = aoShapes[iSet];
+        std::vector<GDALRasterizeStripJob> &asBatchJobs = asJobs[iSet];
+        aoBatch.clear();
+        for( auto &sJob : asBatchJobs )
+            sJob.anShapes.clear();
+
+/* -------------------------------------------------------------------- */
+/*      Read and prepare a batch of shapes.                             */
+/* -------------------------------------------------------------------- */
+        size_t nBatchPoints = 0;
+        while( aoBatch.size() < RASTERIZE_MAX_SHAPES_PER_BATCH &&
+               nBatchPoints < RASTERIZE_MAX_POINTS_PER_BATCH )
+        {
+            OGRGeometry *poGeom = nullptr;
+            GDALRasterizeShape oShape;
+            if( !oSource.GetNextShape( &poGeom, oShape.adfBurnValues ) )
+            {
+                bEOF = true;
+                break;
+            }
+
+            if( !GDALRasterizePrepareShape( poGeom,
+                                            eBurnValueSrc, pfnTransformer,
+                                            pTransformArg, oShape ) )
+            {
+                continue;
+            }
+
+/* -------------------------------------------------------------------- */
+/*      Find the strips the shape may burn into. A shape never burns    */
+/*      outside the lines spanned by its vertices, we add a margin of   */
+/*      one line to be on the safe side.                                */
+/* -------------------------------------------------------------------- */
+            double dfMinY = oShape.aPointY[0];
+            double dfMaxY = oShape.aPointY[0];
+            for( const double dfY : oShape.aPointY )
+            {
+                dfMinY = std::min(dfMinY, dfY);
+                dfMaxY = std::max(dfMaxY, dfY);
+            }
+            int iFirstStrip = 0;
+            int iLastStrip = nStrips - 1;
+            if( CPLIsFinite(dfMinY) && CPLIsFinite(dfMaxY) )
+            {
+                const double dfFirstLine = floor(dfMinY - nChunkYOff) - 1;
+                const double dfLastLine = floor(dfMaxY - nChunkYOff) + 1;
+                if( dfLastLine < 0 || dfFirstLine >= nThisYChunkSize )
+                    continue;
+                if( dfFirstLine > 0 )
+                    iFirstStrip = static_cast<int>(dfFirstLine) / nStripYSize;
+                if( dfLastLine < nThisYChunkSize )
+                    iLastStrip = static_cast<int>(dfLastLine) / nStripYSize;
+            }
+
+            const int iShape = static_cast<int>(aoBatch.size());
+            for( int iStrip = iFirstStrip; iStrip <= iLastStrip; iStrip++ )
+                asBatchJobs[iStrip].anShapes.push_back(iShape);
+            nBatchPoints += oShape.aPointX.size();
+            aoBatch.push_back(std::move(oShape));
+        }
+
+/* -------------------------------------------------------------------- */
+/*      Wait for the previous batch to be burnt, and submit this one.   */
+/* -------------------------------------------------------------------- */
+        poThreadPool->WaitCompletion();
+        eErr = GDALRasterizeCheckStripJobs( asJobs[1 - iSet] );
+        if( eErr != CE_None )
+            break;
+
+        std::vector<void*> apJobs;
+        for( auto &sJob : asBatchJobs )
+        {
+            if( !sJob.anShapes.empty() )
+                apJobs.push_back(&sJob);
+        }
+        if( !apJobs.empty() )
+            poThreadPool->SubmitJobs(GDALRasterizeStripFunc, apJobs);
+
+        iSet = 1 - iSet;
+    }
+
+    poThreadPool->WaitCompletion();
+    if( eErr == CE_None )
+        eErr = GDALRasterizeCheckStripJobs( asJobs[1 - iSet] );
+    return eErr;
+}
+
+/************************************************************************/
+/*                     GDALRasterizeCreateThreadPool()                  */
+/*                                                                      */
+/*      Create the pool of worker threads requested by the NUM_THREADS  */
+/*      option, or return nullptr to rasterize on the calling thread.   */
+/************************************************************************/
+
+static CPLWorkerThreadPool *GDALRasterizeCreateThreadPool(
+                                                    char **papszOptions )
+{
+    const int nThreads = GDALRasterizeGetNumThreads( papszOptions );
+    if( nThreads <= 1 )
+        return nullptr;
+
+    CPLDebug( "GDAL", "Rasterizer using %d threads.", nThreads );
+    CPLWorkerThreadPool *poThreadPool =
+        new (std::nothrow) CPLWorkerThreadPool();
+    if( poThreadPool == nullptr ||
+        !poThreadPool->Setup( nThreads, nullptr, nullptr ) )
+    {
+        delete poThreadPool;
+        poThreadPool = nullptr;
+    }
+    return poThreadPool;
+}
+
 /************************************************************************/
 /*                        GDALRasterizeOptions()                        */
 /*                                                                      */
@@ -620,6 +1139,11 @@ static CPLErr GDALRasterizeOptions( char **papszOptions,
  * used. Default size will be estimated based on the GDAL cache buffer size
  * using formula: cache_size_bytes/scanline_size_bytes, so the chunk will
  * not exceed the cache. Not used in OPTIM=RASTER mode.</li>
+ * <li>"NUM_THREADS": (GDAL >= 2.4) Number of worker threads, or ALL_CPUS.
+ * When greater than 1, each chunk is divided into horizontal strips that
+ * are burnt concurrently, the geometries being transformed on the calling
+ * thread. The result does not depend on the number of threads. Only used
+ * in OPTIM=RASTER mode. Defaults to 1.</li>
  * </ul>
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
@@ -778,6 +1302,9 @@ CPLErr GDALRasterizeGeometries( GDALDatasetH hDS,
             return CE_Failure;
         }
 
+        CPLWorkerThreadPool *poThreadPool =
+            GDALRasterizeCreateThreadPool( papszOptions );
+
 /* ==================================================================== */
 /*      Loop over image in designated chunks.                           */
 /* ==================================================================== */
@@ -801,7 +1328,24 @@ CPLErr GDALRasterizeGeometries( GDALDatasetH hDS,
             if( eErr != CE_None )
                 break;
 
-            for( int iShape = 0; iShape < nGeomCount; iShape++ )
+            if( poThreadPool != nullptr )
+            {
+                GDALRasterizeGeometryShapeSource oSource(
+                    nGeomCount, pahGeometries, nBandCount,
+                    padfGeomBurnValue );
+                eErr = GDALRasterizeChunkMultiThreaded(
+                    poThreadPool, oSource, pabyChunkBuf,
+                    poDS->GetRasterXSize(), nYChunkSize,
+                    iY, nThisYChunkSize,
+                    nBandCount, eType, bAllTouched,
+                    eBurnValueSource, eMergeAlg,
+                    pfnTransformer, pTransformArg );
+                if( eErr != CE_None )
+                    break;
+            }
+
+            for( int iShape = 0;
+                 poThreadPool == nullptr && iShape < nGeomCount; iShape++ )
             {
                 gv_rasterize_one_shape( pabyChunkBuf, 0, iY,
                                         poDS->GetRasterXSize(), nThisYChunkSize,
@@ -828,6 +1372,8 @@ CPLErr GDALRasterizeGeometries( GDALDatasetH hDS,
                 eErr = CE_Failure;
             }
         }
+
+        delete poThreadPool;
     }
 /* -------------------------------------------------------------------- */
 /*      The new algorithm                                               */
@@ -1042,6 +1588,12 @@ CPLErr GDALRasterizeGeometries( GDALDatasetH hDS,
  * <li>"MERGE_ALG": May be REPLACE (the default) or ADD.  REPLACE results in
  * overwriting of value, while ADD adds the new value to the existing raster,
  * suitable for heatmaps for instance.</li>
+ * <li>"NUM_THREADS": (GDAL >= 2.4) Number of worker threads, or ALL_CPUS.
+ * When greater than 1, each chunk is divided into horizontal strips that
+ * are burnt concurrently, the features being read and transformed on the
+ * calling thread. The result does not depend on the number of threads.
+ * Defaults to 1.
+ * </li>
  * </ul>
  * @param pfnProgress the progress function to report completion.
  * @param pProgressArg callback data for progress function.
@@ -1149,6 +1701,12 @@ CPLErr GDALRasterizeLayers( GDALDatasetH hDS,
         }
     }
 
+/* -------------------------------------------------------------------- */
+/*      Setup thread pool for multithreaded strip rasterization.        */
+/* -------------------------------------------------------------------- */
+    CPLWorkerThreadPool *poThreadPool =
+        GDALRasterizeCreateThreadPool( papszOptions );
+
 /* ==================================================================== */
 /*      Read the specified layers transforming and rasterizing          */
 /*      geometries.                                                     */
@@ -1246,6 +1804,7 @@ CPLErr GDALRasterizeLayers( GDALDatasetH hDS,
             CSLDestroy( papszTransformerOptions );
             if( pTransformArg == nullptr )
             {
+                delete poThreadPool;
                 CPLFree( pabyChunkBuf );
                 return CE_Failure;
             }
@@ -1285,7 +1844,8 @@ CPLErr GDALRasterizeLayers( GDALDatasetH hDS,
             }
 
             OGRFeature *poFeat = nullptr;
-            while( (poFeat = poLayer->GetNextFeature()) != nullptr )
+            while( poThreadPool == nullptr &&
+                   (poFeat = poLayer->GetNextFeature()) != nullptr )
             {
                 OGRGeometry *poGeom = poFeat->GetGeometryRef();
 
@@ -1310,6 +1870,21 @@ CPLErr GDALRasterizeLayers( GDALDatasetH hDS,
                 delete poFeat;
             }
 
+            if( poThreadPool != nullptr )
+            {
+                GDALRasterizeLayerShapeSource oSource(
+                    poLayer, nBandCount, iBurnField, padfBurnValues );
+                eErr = GDALRasterizeChunkMultiThreaded(
+                    poThreadPool, oSource, pabyChunkBuf,
+                    poDS->GetRasterXSize(), nYChunkSize,
+                    iY, nThisYChunkSize,
+                    nBandCount, eType, bAllTouched,
+                    eBurnValueSource, eMergeAlg,
+                    pfnTransformer, pTransformArg );
+                if( eErr != CE_None )
+                    break;
+            }
+
             // Only write image if not a single chunk is being rendered.
             if( nYChunkSize < poDS->GetRasterYSize() )
             {
@@ -1359,6 +1934,7 @@ CPLErr GDALRasterizeLayers( GDALDatasetH hDS,
 /* -------------------------------------------------------------------- */
 /*      cleanup                                                         */
 /* -------------------------------------------------------------------- */
+    delete poThreadPool;
     VSIFree( pabyChunkBuf );
 
     return eErr;
@@ -1238,6 +1238,13 @@ static GDALGenImgProjTransformInfo* GDALCreateGenImgProjTransformerInternal()
  * <li> MAX_GCP_ORDER: the maximum order to use for GCP derived polynomials if
  * possible.  The default is to autoselect based on the number of GCPs.
  * A value of -1 triggers use of Thin Plate Spline instead of polynomials.
+ * <li> TPS_MAX_ERROR_IN_PIXEL=err_threshold_in_pixel: if set, the Thin Plate
+ * Spline is evaluated with an approximation that groups the contribution of the
+ * GCPs far from the transformed point, instead of summing over all the GCPs.
+ * The error of the approximation is bounded by the threshold (converted to
+ * georeferenced units with the mean pixel size of the GCPs for the pixel/line
+ * to georef direction).  This makes evaluation much faster with thousands of
+ * GCPs.  The default is to use the exact evaluation.
  * <li> SRC_METHOD: may have a value which is one of GEOTRANSFORM,
  * GCP_POLYNOMIAL, GCP_TPS, GEOLOC_ARRAY, RPC to force only one geolocation
  * method to be considered on the source dataset. Will be used for pixel/line
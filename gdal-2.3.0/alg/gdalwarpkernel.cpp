@@ -5197,6 +5197,182 @@ static CPLErr GWKRealCase( GDALWarpKernel *poWK )
     return GWKRun( poWK, "GWKRealCase", GWKRealCaseThread );
 }
 
+/* We restrict to 64bit processors because they are guaranteed to have SSE2 */
+#if defined(__x86_64) || defined(_M_X64)
+
+/************************************************************************/
+/*                 GWKResampleNoMasks4SampleBatch4T()                   */
+/*                                                                      */
+/*      Bilinear or cubic resampling of 4 consecutive destination       */
+/*      pixels at once, with the arithmetic done in SIMD registers      */
+/*      (one lane per destination pixel). Only handles pixels whose     */
+/*      whole kernel lies in the source window, so the result is        */
+/*      bit-identical to GWKBilinearResampleNoMasks4SampleT() and       */
+/*      GWKCubicResampleNoMasks4SampleT(). Returns false if any of the  */
+/*      4 pixels needs the per-pixel code path.                         */
+/************************************************************************/
+
+template<class T, GDALResampleAlg eResample>
+static bool GWKResampleNoMasks4SampleBatch4T( GDALWarpKernel *poWK,
+                                              const double* padfX,
+                                              const double* padfY,
+                                              const int* pabSuccess,
+                                              int iDstOffset )
+{
+    CPLAssert(eResample == GRA_Bilinear || eResample == GRA_Cubic);
+
+    const int nSrcXSize = poWK->nSrcXSize;
+    const int nSrcYSize = poWK->nSrcYSize;
+    // Number of source pixels needed before and after the one at iSrcX.
+    const int nBefore = eResample == GRA_Cubic ? 1 : 0;
+    const int nAfter = eResample == GRA_Cubic ? 2 : 1;
+
+    int anSrcOffset[4] = {};
+    double adfDeltaX[4] = {};
+    double adfDeltaY[4] = {};
+    for( int k = 0; k < 4; k++ )
+    {
+        if( !pabSuccess[k] )
+            return false;
+        const double dfSrcX = padfX[k] - poWK->nSrcXOff;
+        const double dfSrcY = padfY[k] - poWK->nSrcYOff;
+        // Written so that NaN coordinates are rejected too.
+        if( !(dfSrcX - 0.5 >= nBefore && dfSrcX - 0.5 < nSrcXSize - nAfter &&
+              dfSrcY - 0.5 >= nBefore && dfSrcY - 0.5 < nSrcYSize - nAfter) )
+            return false;
+        const int iSrcX = static_cast<int>(dfSrcX - 0.5);
+        const int iSrcY = static_cast<int>(dfSrcY - 0.5);
+        anSrcOffset[k] = iSrcX + iSrcY * nSrcXSize;
+        // Same expressions as the per-pixel functions.
+        if( eResample == GRA_Bilinear )
+        {
+            adfDeltaX[k] = 1.5 - (dfSrcX - iSrcX);
+            adfDeltaY[k] = 1.5 - (dfSrcY - iSrcY);
+        }
+        else
+        {
+            adfDeltaX[k] = dfSrcX - 0.5 - iSrcX;
+            adfDeltaY[k] = dfSrcY - 0.5 - iSrcY;
+        }
+    }
+
+    const double dfOne = 1.0;
+    const XMMReg4Double v_one = XMMReg4Double::Load1ValHighAndLow(&dfOne);
+    double adfValues[4] = {};
+
+    if( eResample == GRA_Bilinear )
+    {
+        const XMMReg4Double v_ratioX = XMMReg4Double::Load4Val(adfDeltaX);
+        const XMMReg4Double v_ratioY = XMMReg4Double::Load4Val(adfDeltaY);
+        const XMMReg4Double v_ratioXCompl = v_one - v_ratioX;
+        const XMMReg4Double v_ratioYCompl = v_one - v_ratioY;
+
+        for( int iBand = 0; iBand < poWK->nBands; iBand++ )
+        {
+            const T* pSrc =
+                reinterpret_cast<const T*>(poWK->papabySrcImage[iBand]);
+            double adfUL[4], adfUR[4], adfLL[4], adfLR[4];
+            for( int k = 0; k < 4; k++ )
+            {
+                const T* pSrcK = pSrc + anSrcOffset[k];
+                adfUL[k] = static_cast<double>(pSrcK[0]);
+                adfUR[k] = static_cast<double>(pSrcK[1]);
+                adfLL[k] = static_cast<double>(pSrcK[nSrcXSize]);
+                adfLR[k] = static_cast<double>(pSrcK[nSrcXSize + 1]);
+            }
+            const XMMReg4Double v_acc =
+                (XMMReg4Double::Load4Val(adfUL) * v_ratioX +
+                 XMMReg4Double::Load4Val(adfUR) * v_ratioXCompl) * v_ratioY +
+                (XMMReg4Double::Load4Val(adfLL) * v_ratioX +
+                 XMMReg4Double::Load4Val(adfLR) * v_ratioXCompl) *
+                v_ratioYCompl;
+            v_acc.Store4Val(adfValues);
+
+            T* pDst = reinterpret_cast<T*>(poWK->papabyDstImage[iBand]) +
+                      iDstOffset;
+            for( int k = 0; k < 4; k++ )
+                pDst[k] = GWKRoundValueT<T>(adfValues[k]);
+        }
+        return true;
+    }
+
+    // Cubic: per-pixel horizontal coefficients, stored by coefficient index
+    // so that each one can be loaded as a vector over the 4 pixels.
+    double adfCoeffsX[4 * 4];
+    for( int k = 0; k < 4; k++ )
+    {
+        double adfCoeffs[4] = {};
+        GWKCubicComputeWeights(adfDeltaX[k], adfCoeffs);
+        for( int c = 0; c < 4; c++ )
+            adfCoeffsX[c * 4 + k] = adfCoeffs[c];
+    }
+    const XMMReg4Double v_coeffX0 = XMMReg4Double::Load4Val(adfCoeffsX);
+    const XMMReg4Double v_coeffX1 = XMMReg4Double::Load4Val(adfCoeffsX + 4);
+    const XMMReg4Double v_coeffX2 = XMMReg4Double::Load4Val(adfCoeffsX + 8);
+    const XMMReg4Double v_coeffX3 = XMMReg4Double::Load4Val(adfCoeffsX + 12);
+
+    const XMMReg4Double v_deltaY = XMMReg4Double::Load4Val(adfDeltaY);
+    const XMMReg4Double v_deltaY2 = v_deltaY * v_deltaY;
+    const XMMReg4Double v_deltaY3 = v_deltaY2 * v_deltaY;
+    const double adfConstants[5] = { 0.5, 2.0, 5.0, 4.0, 3.0 };
+    const XMMReg4Double v_half =
+        XMMReg4Double::Load1ValHighAndLow(&adfConstants[0]);
+    const XMMReg4Double v_two =
+        XMMReg4Double::Load1ValHighAndLow(&adfConstants[1]);
+    const XMMReg4Double v_five =
+        XMMReg4Double::Load1ValHighAndLow(&adfConstants[2]);
+    const XMMReg4Double v_four =
+        XMMReg4Double::Load1ValHighAndLow(&adfConstants[3]);
+    const XMMReg4Double v_three =
+        XMMReg4Double::Load1ValHighAndLow(&adfConstants[4]);
+
+    for( int iBand = 0; iBand < poWK->nBands; iBand++ )
+    {
+        const T* pSrc = reinterpret_cast<const T*>(poWK->papabySrcImage[iBand]);
+
+        // Horizontal convolution of the 4 source rows, in the same order
+        // as CONVOL4().
+        XMMReg4Double av_rows[4];
+        for( int i = 0; i < 4; i++ )
+        {
+            double adfTaps[4 * 4];
+            for( int k = 0; k < 4; k++ )
+            {
+                const T* pSrcK =
+                    pSrc + anSrcOffset[k] + (i - 1) * nSrcXSize - 1;
+                adfTaps[k] = static_cast<double>(pSrcK[0]);
+                adfTaps[4 + k] = static_cast<double>(pSrcK[1]);
+                adfTaps[8 + k] = static_cast<double>(pSrcK[2]);
+                adfTaps[12 + k] = static_cast<double>(pSrcK[3]);
+            }
+            av_rows[i] =
+                v_coeffX0 * XMMReg4Double::Load4Val(adfTaps) +
+                v_coeffX1 * XMMReg4Double::Load4Val(adfTaps + 4) +
+                v_coeffX2 * XMMReg4Double::Load4Val(adfTaps + 8) +
+                v_coeffX3 * XMMReg4Double::Load4Val(adfTaps + 12);
+        }
+
+        // Vertical interpolation, mirroring the CubicConvolution() macro.
+        const XMMReg4Double& f0 = av_rows[0];
+        const XMMReg4Double& f1 = av_rows[1];
+        const XMMReg4Double& f2 = av_rows[2];
+        const XMMReg4Double& f3 = av_rows[3];
+        const XMMReg4Double v_value =
+            f1 + v_half * (v_deltaY * (f2 - f0)
+                 + v_deltaY2 * (v_two * f0 - v_five * f1 + v_four * f2 - f3)
+                 + v_deltaY3 * (v_three * (f1 - f2) + f3 - f0));
+        v_value.Store4Val(adfValues);
+
+        T* pDst = reinterpret_cast<T*>(poWK->papabyDstImage[iBand]) +
+                  iDstOffset;
+        for( int k = 0; k < 4; k++ )
+            pDst[k] = GWKClampValueT<T>(adfValues[k]);
+    }
+    return true;
+}
+
+#endif /* defined(__x86_64) || defined(_M_X64) */
+
 /************************************************************************/
 /*                GWKResampleNoMasksOrDstDensityOnlyThreadInternal()    */
 /************************************************************************/
@@ -5275,8 +5451,34 @@ static void GWKResampleNoMasksOrDstDensityOnlyThreadInternal( void* pData )
 /* ==================================================================== */
 /*      Loop over pixels in output scanline.                            */
 /* ==================================================================== */
+#if defined(__x86_64) || defined(_M_X64)
+        // Pixels before that index have been rejected by the vectorized
+        // code and must go through the per-pixel code.
+        int iDstXScalarEnd = 0;
+#endif
         for( int iDstX = 0; iDstX < nDstXSize; iDstX++ )
         {
+#if defined(__x86_64) || defined(_M_X64)
+            if( bUse4SamplesFormula && eResample != GRA_NearestNeighbour &&
+                iDstX >= iDstXScalarEnd && iDstX + 4 <= nDstXSize )
+            {
+                const int iDstOffset = iDstX + iDstY * nDstXSize;
+                if( GWKResampleNoMasks4SampleBatch4T<T, eResample>(
+                        poWK, padfX + iDstX, padfY + iDstX, pabSuccess + iDstX,
+                        iDstOffset) )
+                {
+                    if( poWK->pafDstDensity )
+                    {
+                        for( int k = 0; k < 4; k++ )
+                            poWK->pafDstDensity[iDstOffset + k] = 1.0f;
+                    }
+                    iDstX += 3;
+                    continue;
+                }
+                iDstXScalarEnd = iDstX + 4;
+            }
+#endif
+
             int iSrcOffset = 0;
             if( !GWKCheckAndComputeSrcOffsets(pabSuccess, iDstX, padfX, padfY,
                                               poWK, nSrcXSize, nSrcYSize,
@@ -36,14 +36,59 @@
 
 #include <algorithm>
 #include <utility>
+#include <vector>
 
 #include "gdal_alg.h"
 
 CPL_CVSID("$Id: llrasterize.cpp 9ff327806cd64df6d73a6c91f92d12ca0c5e07df 2018-04-07 20:25:06 +0200 Even Rouault $")
 
-static int llCompareInt(const void *a, const void *b)
+namespace {
+
+// Non-horizontal edge of the polygon, with dfY1 < dfY2. It crosses the center
+// of the lines nFirstLine <= y < nEndLine.
+struct llEdge
+{
+    double dfX1;
+    double dfY1;
+    double dfX2;
+    double dfY2;
+    int    nFirstLine;
+    int    nEndLine;
+};
+
+// Bottom horizontal edge, filled separately on the line whose center it
+// lies on (or on every line, see below).
+struct llHorizontalEdge
+{
+    int nEdge;  // Index in the polygon, to preserve the emission order.
+    int nLine;
+    int nXStart;
+    int nXEnd;
+};
+
+} // namespace
+
+/************************************************************************/
+/*                        llFirstLineAtOrAbove()                        */
+/*                                                                      */
+/*      Return the first line y of [nMinY, nMaxY+1] whose center        */
+/*      y + 0.5 is greater or equal to dfY, nMaxY+1 if there is none.   */
+/*      The comparison is done exactly as in the scanline loop.         */
+/************************************************************************/
+
+static int llFirstLineAtOrAbove( double dfY, int nMinY, int nMaxY )
 {
-    return *static_cast<const int*>(a) - *static_cast<const int*>(b);
+    if( !(dfY > nMinY + 0.5) )
+        return nMinY;
+    if( dfY > nMaxY + 0.5 )
+        return nMaxY + 1;
+    int y = static_cast<int>(ceil(dfY - 0.5));
+    y = std::max(nMinY, std::min(nMaxY + 1, y));
+    while( y > nMinY && (y - 1) + 0.5 >= dfY )
+        y--;
+    while( y <= nMaxY && y + 0.5 < dfY )
+        y++;
+    return y;
 }
 
 /************************************************************************/
@@ -86,6 +131,11 @@ static int llCompareInt(const void *a, const void *b)
  *
  * It was later adapted for direct inclusion in GDAL and relicensed under
  * the GDAL MIT/X license (pulled from the OpenEV distribution).
+ *
+ * Edges are now sorted by first crossed line and kept in an active edge
+ * table, so that each line only visits the edges crossing it. Crossings
+ * are still evaluated from the edge end points for each line (and not
+ * incrementally) so that the burnt pixels are unchanged.
  */
 
 void GDALdllImageFilledPolygon(int nRasterXSize, int nRasterYSize,
@@ -109,9 +159,6 @@ No known bug
     for( int part = 0; part < nPartCount; part++ )
         n += panPartSize[part];
 
-    // +1 to make clang static analyzer not warn about potential malloc(0).
-    int *polyInts = static_cast<int *>(malloc(sizeof(int) * (n + 1)));
-
     double dminy = padfY[0];
     double dmaxy = padfY[0];
     for( int i = 1; i < n; i++ )
@@ -136,104 +183,190 @@ No known bug
     int minx = 0;
     const int maxx = nRasterXSize - 1;
 
-    // Fix in 1.3: count a vertex only once.
-    for( int y = miny; y <= maxy; y++ )
-    {
-        int partoffset = 0;
+    if( miny > maxy )
+        return;
 
-        const double dy = y + 0.5;  // Center height of line.
+/* -------------------------------------------------------------------- */
+/*      Build the edge table. Edges are visited in the same order as    */
+/*      the original per-scanline loop, so that horizontal segments are */
+/*      emitted in the same order.                                      */
+/*      Edges with a NaN Y coordinate are neither above nor below any   */
+/*      line center, and used to be processed as horizontal edges on    */
+/*      every line: keep that behaviour.                                */
+/* -------------------------------------------------------------------- */
+    std::vector<llEdge> asEdges;
+    std::vector<llHorizontalEdge> asHorizontalEdges;
+    std::vector<llHorizontalEdge> asAllLinesHorizontalEdges;
+    asEdges.reserve(n);
+
+    int partoffset = 0;
+    int part = 0;
+    for( int i = 0; i < n; i++ )
+    {
+        if( i == partoffset + panPartSize[part] )
+        {
+            partoffset += panPartSize[part];
+            part++;
+        }
 
-        int part = 0;
-        int ints = 0;
+        int ind1 = 0;
+        int ind2 = 0;
+        if( i == partoffset )
+        {
+            ind1 = partoffset + panPartSize[part] - 1;
+            ind2 = partoffset;
+        }
+        else
+        {
+            ind1 = i-1;
+            ind2 = i;
+        }
 
-        // Initialize polyInts, otherwise it can sometimes causes a seg fault.
-        memset(polyInts, -1, sizeof(int) * n);
+        const double dy1 = padfY[ind1];
+        const double dy2 = padfY[ind2];
 
-        for( int i = 0; i < n; i++ )
+        llEdge sEdge;
+        if( dy1 < dy2 )
         {
-            if( i == partoffset + panPartSize[part] )
-            {
-                partoffset += panPartSize[part];
-                part++;
-            }
+            sEdge.dfX1 = padfX[ind1];
+            sEdge.dfY1 = dy1;
+            sEdge.dfX2 = padfX[ind2];
+            sEdge.dfY2 = dy2;
+        }
+        else if( dy1 > dy2 )
+        {
+            sEdge.dfX1 = padfX[ind2];
+            sEdge.dfY1 = dy2;
+            sEdge.dfX2 = padfX[ind1];
+            sEdge.dfY2 = dy1;
+        }
+        else
+        {
+            // AE: DO NOT skip bottom horizontal segments
+            // -Fill them separately-
+            // They are not taken into account twice.
+            // Top horizontal segments are skipped: they are already filled
+            // with the regular edges.
+            if( !(padfX[ind1] > padfX[ind2]) )
+                continue;
+
+            llHorizontalEdge sHEdge;
+            sHEdge.nEdge = i;
+            sHEdge.nXStart = static_cast<int>(floor(padfX[ind2] + 0.5));
+            sHEdge.nXEnd = static_cast<int>(floor(padfX[ind1] + 0.5));
+            if( (sHEdge.nXStart >  maxx) ||  (sHEdge.nXEnd <= minx) )
+                continue;
 
-            int ind1 = 0;
-            int ind2 = 0;
-            if( i == partoffset )
+            if( CPLIsNan(dy1) || CPLIsNan(dy2) )
             {
-                ind1 = partoffset + panPartSize[part] - 1;
-                ind2 = partoffset;
+                sHEdge.nLine = miny;
+                asAllLinesHorizontalEdges.push_back(sHEdge);
             }
             else
             {
-                ind1 = i-1;
-                ind2 = i;
+                // Only processed on the line whose center is exactly dy1.
+                sHEdge.nLine = llFirstLineAtOrAbove(dy1, miny, maxy);
+                if( sHEdge.nLine <= maxy && sHEdge.nLine + 0.5 == dy1 )
+                    asHorizontalEdges.push_back(sHEdge);
             }
+            continue;
+        }
 
-            double dy1 = padfY[ind1];
-            double dy2 = padfY[ind2];
+        sEdge.nFirstLine = llFirstLineAtOrAbove(sEdge.dfY1, miny, maxy);
+        sEdge.nEndLine = llFirstLineAtOrAbove(sEdge.dfY2, miny, maxy);
+        if( sEdge.nFirstLine < sEdge.nEndLine )
+            asEdges.push_back(sEdge);
+    }
 
-            if( (dy1 < dy && dy2 < dy) || (dy1 > dy && dy2 > dy) )
-                continue;
+    std::stable_sort(asEdges.begin(), asEdges.end(),
+                     [](const llEdge& a, const llEdge& b)
+                     { return a.nFirstLine < b.nFirstLine; });
+    std::stable_sort(asHorizontalEdges.begin(), asHorizontalEdges.end(),
+                     [](const llHorizontalEdge& a, const llHorizontalEdge& b)
+                     { return a.nLine < b.nLine; });
 
-            double dx1 = 0.0;
-            double dx2 = 0.0;
-            if( dy1 < dy2 )
-            {
-                dx1 = padfX[ind1];
-                dx2 = padfX[ind2];
-            }
-            else if( dy1 > dy2 )
-            {
-                dy2 = padfY[ind1];
-                dy1 = padfY[ind2];
-                dx2 = padfX[ind1];
-                dx1 = padfX[ind2];
-            }
-            else // if( fabs(dy1-dy2) < 1.e-6 )
-            {
+/* -------------------------------------------------------------------- */
+/*      Scan the lines, maintaining the list of active edges, kept in   */
+/*      the order of their crossings on the previous line so that       */
+/*      insertion sort is almost linear.                                */
+/* -------------------------------------------------------------------- */
+    std::vector<int> anActiveEdges;
+    std::vector<int> polyInts;
+    size_t iNextEdge = 0;
+    size_t iNextHorizontalEdge = 0;
 
-                // AE: DO NOT skip bottom horizontal segments
-                // -Fill them separately-
-                // They are not taken into account twice.
-                if( padfX[ind1] > padfX[ind2] )
-                {
-                    const int horizontal_x1 =
-                        static_cast<int>(floor(padfX[ind2] + 0.5));
-                    const int horizontal_x2 =
-                        static_cast<int>(floor(padfX[ind1] + 0.5));
-
-                    if( (horizontal_x1 >  maxx) ||  (horizontal_x2 <= minx) )
-                        continue;
-
-                    // Fill the horizontal segment (separately from the rest).
-                    pfnScanlineFunc( pCBData, y, horizontal_x1,
-                                     horizontal_x2 - 1,
-                                     (dfVariant == nullptr)?0:dfVariant[0] );
-                }
-                // else: Skip top horizontal segments.
-                // They are already filled in the regular loop.
-                continue;
-            }
+    for( int y = miny; y <= maxy; y++ )
+    {
+        const double dy = y + 0.5;  // Center height of line.
 
-            if( dy < dy2 && dy >= dy1 )
-            {
-                const double intersect = (dy-dy1) * (dx2-dx1) / (dy2-dy1) + dx1;
+        // Fill the horizontal segments (separately from the rest), in
+        // polygon order.
+        size_t iAllLinesHorizontalEdge = 0;
+        while( true )
+        {
+            const bool bHasLineEdge =
+                iNextHorizontalEdge < asHorizontalEdges.size() &&
+                asHorizontalEdges[iNextHorizontalEdge].nLine == y;
+            const bool bHasAllLinesEdge =
+                iAllLinesHorizontalEdge < asAllLinesHorizontalEdges.size();
+            if( !bHasLineEdge && !bHasAllLinesEdge )
+                break;
+            const llHorizontalEdge* psHEdge = nullptr;
+            if( bHasLineEdge && (!bHasAllLinesEdge ||
+                    asHorizontalEdges[iNextHorizontalEdge].nEdge <
+                    asAllLinesHorizontalEdges[iAllLinesHorizontalEdge].nEdge) )
+                psHEdge = &asHorizontalEdges[iNextHorizontalEdge++];
+            else
+                psHEdge = &asAllLinesHorizontalEdges[iAllLinesHorizontalEdge++];
+            pfnScanlineFunc( pCBData, y, psHEdge->nXStart, psHEdge->nXEnd - 1,
+                             (dfVariant == nullptr)?0:dfVariant[0] );
+        }
 
-                polyInts[ints++] = static_cast<int>(floor(intersect + 0.5));
-            }
+        // Update the active edge table.
+        anActiveEdges.erase(
+            std::remove_if(anActiveEdges.begin(), anActiveEdges.end(),
+                           [&asEdges, y](int iEdge)
+                           { return asEdges[iEdge].nEndLine <= y; }),
+            anActiveEdges.end());
+        while( iNextEdge < asEdges.size() &&
+               asEdges[iNextEdge].nFirstLine <= y )
+        {
+            anActiveEdges.push_back(static_cast<int>(iNextEdge));
+            iNextEdge++;
         }
 
-        // It would be more efficient to do this inline, to avoid
-        // a function call for each comparison.
-        // NOTE - mloskot: make llCompareInt a functor and use std
-        // algorithm and it will be optimized and expanded
-        // automatically in compile-time, with modularity preserved.
-        //
-        // TODO(schwehr): Use std::sort.
-        qsort(polyInts, ints, sizeof(int), llCompareInt);
+        const int ints = static_cast<int>(anActiveEdges.size());
+        polyInts.resize(ints);
+        for( int i = 0; i < ints; i++ )
+        {
+            const llEdge& sEdge = asEdges[anActiveEdges[i]];
+            const double dy1 = sEdge.dfY1;
+            const double dy2 = sEdge.dfY2;
+            const double dx1 = sEdge.dfX1;
+            const double dx2 = sEdge.dfX2;
+            const double intersect = (dy-dy1) * (dx2-dx1) / (dy2-dy1) + dx1;
+
+            polyInts[i] = static_cast<int>(floor(intersect + 0.5));
+        }
+
+        // Insertion sort of the crossings, together with their edges.
+        for( int i = 1; i < ints; i++ )
+        {
+            const int nInt = polyInts[i];
+            const int iEdge = anActiveEdges[i];
+            int j = i - 1;
+            for( ; j >= 0 && polyInts[j] > nInt; j-- )
+            {
+                polyInts[j+1] = polyInts[j];
+                anActiveEdges[j+1] = anActiveEdges[j];
+            }
+            polyInts[j+1] = nInt;
+            anActiveEdges[j+1] = iEdge;
+        }
 
-        for( int i = 0; i < ints; i += 2 )
+        // An odd trailing crossing can only happen with degenerate input,
+        // and is ignored.
+        for( int i = 0; i + 1 < ints; i += 2 )
         {
             if( polyInts[i] <= maxx && polyInts[i+1] > minx )
             {
@@ -242,8 +375,6 @@ No known bug
             }
         }
     }
-
-    free( polyInts );
 }
 
 /************************************************************************/
@@ -42,10 +42,13 @@
 
 #include <algorithm>
 #include <limits>
+#include <new>
+#include <numeric>
 #include <utility>
 
 #include "cpl_error.h"
 #include "cpl_vsi.h"
+#include "cpl_worker_thread_pool.h"
 
 CPL_CVSID("$Id: thinplatespline.cpp 9ff327806cd64df6d73a6c91f92d12ca0c5e07df 2018-04-07 20:25:06 +0200 Even Rouault $")
 
@@ -433,7 +436,38 @@ static void VizGeorefSpline2DBase_func4( double* res,
 }
 #endif // defined(USE_OPTIMIZED_VizGeorefSpline2DBase_func4)
 
-int VizGeorefSpline2D::solve()
+namespace {
+typedef struct
+{
+    double       *padfA;
+    const double *padfX;
+    const double *padfY;
+    int           nPoints;
+    int           iStartRow;
+    int           iEndRow;
+} VizGeorefSpline2DFillJob;
+} // namespace
+
+static void VizGeorefSpline2DFillJobFunc( void* pData )
+{
+    const VizGeorefSpline2DFillJob* psJob =
+        static_cast<const VizGeorefSpline2DFillJob*>(pData);
+    const int nEqs = psJob->nPoints + 3;
+    for( int r = psJob->iStartRow; r < psJob->iEndRow; r++ )
+    {
+        double* padfRow = psJob->padfA + static_cast<size_t>(r + 3) * nEqs + 3;
+        const double xr = psJob->padfX[r];
+        const double yr = psJob->padfY[r];
+        for( int c = 0; c < psJob->nPoints; c++ )
+        {
+            padfRow[c] = VizGeorefSpline2DBase_func( xr, yr,
+                                                     psJob->padfX[c],
+                                                     psJob->padfY[c] );
+        }
+    }
+}
+
+int VizGeorefSpline2D::solve( CPLWorkerThreadPool* poThreadPool )
 {
     // No points at all.
     if( _nof_points < 1 )
@@ -583,13 +617,34 @@ int VizGeorefSpline2D::solve()
         A(c+3, 2) = y[c];
     }
 
-    for( int r = 0; r < _nof_points; r++ )
-        for( int c = r; c < _nof_points; c++ )
-        {
-            A(r+3, c+3) = VizGeorefSpline2DBase_func( x[r], y[r], x[c], y[c] );
-            if( r != c )
-                A(c+3, r+3) = A(r+3, c+3);
-        }
+    // The kernel part is computed by blocks of whole rows, one per thread.
+    // The matrix is symmetric, but filling both triangles from the same
+    // thread would make threads write into the same cache lines.
+    const int nJobs = poThreadPool != nullptr && _nof_points > 100 ?
+        std::max(1, poThreadPool->GetThreadCount()) : 1;
+    std::vector<VizGeorefSpline2DFillJob> asJobs(nJobs);
+    std::vector<void*> apData;
+    for( int i = 0; i < nJobs; i++ )
+    {
+        asJobs[i].padfA = _AA;
+        asJobs[i].padfX = x;
+        asJobs[i].padfY = y;
+        asJobs[i].nPoints = _nof_points;
+        asJobs[i].iStartRow = static_cast<int>(
+            static_cast<GIntBig>(_nof_points) * i / nJobs);
+        asJobs[i].iEndRow = static_cast<int>(
+            static_cast<GIntBig>(_nof_points) * (i + 1) / nJobs);
+        apData.push_back(&asJobs[i]);
+    }
+    if( nJobs == 1 )
+    {
+        VizGeorefSpline2DFillJobFunc(apData[0]);
+    }
+    else
+    {
+        poThreadPool->SubmitJobs(VizGeorefSpline2DFillJobFunc, apData);
+        poThreadPool->WaitCompletion();
+    }
 
 #if VIZ_GEOREF_SPLINE_DEBUG
 
@@ -609,7 +664,8 @@ int VizGeorefSpline2D::solve()
 
     double* adfCoef = static_cast<double*>(VSICalloc( _nof_eqs * _nof_vars, sizeof(double) ));
 
-    if( !GDALLinearSystemSolve( _nof_eqs, _nof_vars, _AA, adfRHS, adfCoef ) )
+    if( !GDALLinearSystemSolveInPlace( _nof_eqs, _nof_vars, _AA, adfRHS,
+                                       adfCoef, poThreadPool ) )
     {
         VSIFree(adfRHS);
         VSIFree(adfCoef);
@@ -625,9 +681,269 @@ int VizGeorefSpline2D::solve()
     VSIFree(adfCoef);
     VSIFree(_AA);
 
+    _nodes.clear();
+
     return 4;
 }
 
+/************************************************************************/
+/*                           set_max_error()                            */
+/*                                                                      */
+/*      Enables the approximate evaluation of the spline, which         */
+/*      replaces the contribution of groups of points far enough from   */
+/*      the evaluated point by a truncated far field expansion around   */
+/*      the center of the group.  With z the evaluated point and t the  */
+/*      points relative to that center, and since U(d) = d*log(d) is    */
+/*      2*|z-t|^2*Re(log(z-t)), the expansion is obtained from          */
+/*      log(z-t) = log(z) - sum(k>=1, t^k / (k*z^k)).  For points       */
+/*      within rho of the center and q = rho/|z| < 1, stopping at order */
+/*      p leaves a remainder of at most                                 */
+/*      2 * (|z|+rho)^2 * q^(p+1) / ((p+1)*(1-q)) times the sum of the  */
+/*      |coef| of the group.  A group is only accepted if that bound    */
+/*      does not exceed its share (sum of its |coef| / sum of all       */
+/*      |coef|) of max_error, so the total error stays below max_error. */
+/*      Must be called after solve().                                   */
+/************************************************************************/
+
+// Maximum number of points of the leaves of the tree.
+constexpr int VIZ_GEOREF_SPLINE_LEAF_SIZE = 16;
+
+bool VizGeorefSpline2D::set_max_error( double max_error )
+{
+    _nodes.clear();
+    _sorted_x.clear();
+    _sorted_y.clear();
+    for( int v = 0; v < _nof_vars; v++ )
+        _sorted_coef[v].clear();
+
+    if( type != VIZ_GEOREF_SPLINE_FULL || !(max_error > 0.0) ||
+        _nof_points <= 4 * VIZ_GEOREF_SPLINE_LEAF_SIZE )
+    {
+        return false;
+    }
+
+    double sum_abs_coef = 0.0;
+    for( int v = 0; v < _nof_vars; v++ )
+    {
+        double sum = 0.0;
+        for( int r = 0; r < _nof_points; r++ )
+            sum += fabs(coef[v][r+3]);
+        sum_abs_coef = std::max(sum_abs_coef, sum);
+    }
+    if( sum_abs_coef == 0.0 )
+        return false;
+    _max_error_factor = max_error / sum_abs_coef;
+
+    try
+    {
+        std::vector<int> perm(_nof_points);
+        std::iota(perm.begin(), perm.end(), 0);
+        _nodes.reserve(4 * _nof_points / VIZ_GEOREF_SPLINE_LEAF_SIZE + 1);
+        build_node(perm, 0, _nof_points);
+
+        _sorted_x.resize(_nof_points);
+        _sorted_y.resize(_nof_points);
+        for( int v = 0; v < _nof_vars; v++ )
+            _sorted_coef[v].resize(_nof_points);
+        for( int i = 0; i < _nof_points; i++ )
+        {
+            _sorted_x[i] = x[perm[i]];
+            _sorted_y[i] = y[perm[i]];
+            for( int v = 0; v < _nof_vars; v++ )
+                _sorted_coef[v][i] = coef[v][perm[i]+3];
+        }
+    }
+    catch( const std::bad_alloc& )
+    {
+        CPLError(CE_Warning, CPLE_OutOfMemory,
+                 "Cannot allocate TPS approximation tree. "
+                 "Using exact evaluation.");
+        _nodes.clear();
+        return false;
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                             build_node()                             */
+/*                                                                      */
+/*      Builds the subtree of the points perm[first, first+count[ by    */
+/*      splitting them at the median of the widest axis.  Returns the   */
+/*      index of the node.                                              */
+/************************************************************************/
+
+int VizGeorefSpline2D::build_node( std::vector<int>& perm,
+                                   int first, int count )
+{
+    double xmin = x[perm[first]];
+    double xmax = xmin;
+    double ymin = y[perm[first]];
+    double ymax = ymin;
+    for( int i = first + 1; i < first + count; i++ )
+    {
+        xmin = std::min(xmin, x[perm[i]]);
+        xmax = std::max(xmax, x[perm[i]]);
+        ymin = std::min(ymin, y[perm[i]]);
+        ymax = std::max(ymax, y[perm[i]]);
+    }
+
+    vizGeorefSplineNode node;
+    memset(&node, 0, sizeof(node));
+    node.cx = 0.5 * (xmin + xmax);
+    node.cy = 0.5 * (ymin + ymax);
+    node.first_point = first;
+    node.nof_points = count;
+    node.child[0] = -1;
+    node.child[1] = -1;
+
+    double radius2 = 0.0;
+    for( int i = first; i < first + count; i++ )
+    {
+        const double dx = x[perm[i]] - node.cx;
+        const double dy = y[perm[i]] - node.cy;
+        radius2 = std::max(radius2, dx * dx + dy * dy);
+        for( int v = 0; v < _nof_vars; v++ )
+        {
+            const double c = coef[v][perm[i]+3];
+            // c * t^k, and c * conj(t) * t^k = c * |t|^2 * t^(k-1).
+            double tk_re = c;
+            double tk_im = 0.0;
+            node.b[v][0][0] += c * dx;
+            node.b[v][0][1] -= c * dy;
+            for( int k = 0; k <= VIZ_GEOREF_SPLINE_ORDER + 1; k++ )
+            {
+                node.a[v][k][0] += tk_re;
+                node.a[v][k][1] += tk_im;
+                if( k <= VIZ_GEOREF_SPLINE_ORDER )
+                {
+                    node.b[v][k+1][0] += (dx * dx + dy * dy) * tk_re;
+                    node.b[v][k+1][1] += (dx * dx + dy * dy) * tk_im;
+                }
+                const double tmp = tk_re * dx - tk_im * dy;
+                tk_im = tk_re * dy + tk_im * dx;
+                tk_re = tmp;
+            }
+        }
+    }
+    node.radius = sqrt(radius2);
+
+    const int iNode = static_cast<int>(_nodes.size());
+    _nodes.push_back(node);
+
+    if( count > VIZ_GEOREF_SPLINE_LEAF_SIZE )
+    {
+        const double* coord = (xmax - xmin >= ymax - ymin) ? x : y;
+        const int half = count / 2;
+        std::nth_element(perm.begin() + first,
+                         perm.begin() + first + half,
+                         perm.begin() + first + count,
+                         [coord](int a, int b) { return coord[a] < coord[b]; });
+        const int child0 = build_node(perm, first, half);
+        const int child1 = build_node(perm, first + half, count - half);
+        _nodes[iNode].child[0] = child0;
+        _nodes[iNode].child[1] = child1;
+    }
+
+    return iNode;
+}
+
+/************************************************************************/
+/*                          add_approx_terms()                          */
+/*                                                                      */
+/*      Adds the non-affine terms of the spline at (Px,Py), using the   */
+/*      expansion of the nodes accepted by the error criterion, and     */
+/*      the exact terms of the points of the other leaves.              */
+/************************************************************************/
+
+void VizGeorefSpline2D::add_approx_terms( const double Px, const double Py,
+                                          double *vars )
+{
+    const double Pxy[2] = { Px, Py };
+    // The depth of the tree is bounded by log2(number of points).
+    int stack[64];
+    int nStackSize = 0;
+    stack[nStackSize++] = 0;
+
+    while( nStackSize > 0 )
+    {
+        const vizGeorefSplineNode& node = _nodes[stack[--nStackSize]];
+        const double sx = Px - node.cx;
+        const double sy = Py - node.cy;
+        const double d = sx * sx + sy * sy;
+        const double s = sqrt(d);
+        const double q = node.radius / s;
+        if( q < 1.0 &&
+            2.0 * SQ(s + node.radius) * pow(q, VIZ_GEOREF_SPLINE_ORDER + 1) <=
+                _max_error_factor * (VIZ_GEOREF_SPLINE_ORDER + 1) * (1.0 - q) )
+        {
+            // U = 2 * (C0 * log|z| - Re(sum(k=1..p, T_k / (k*z^k))))
+            // with C0 = sum(coef * |z-t|^2) = |z|^2 a_0 - 2 Re(conj(z) a_1) + b_1
+            // and T_k = |z|^2 a_k - conj(z) a_(k+1) - z b_k + b_(k+1).
+            double wk[VIZ_GEOREF_SPLINE_ORDER + 1][2];
+            const double w_re = sx / d;
+            const double w_im = -sy / d;
+            wk[1][0] = w_re;
+            wk[1][1] = w_im;
+            for( int k = 2; k <= VIZ_GEOREF_SPLINE_ORDER; k++ )
+            {
+                wk[k][0] = wk[k-1][0] * w_re - wk[k-1][1] * w_im;
+                wk[k][1] = wk[k-1][0] * w_im + wk[k-1][1] * w_re;
+            }
+            const double log_z = 0.5 * log(d);
+            for( int v = 0; v < _nof_vars; v++ )
+            {
+                const double (*a)[2] = node.a[v];
+                const double (*b)[2] = node.b[v];
+                const double C0 = d * a[0][0] -
+                    2.0 * (sx * a[1][0] + sy * a[1][1]) + b[1][0];
+                double sum = 0.0;
+                for( int k = 1; k <= VIZ_GEOREF_SPLINE_ORDER; k++ )
+                {
+                    const double T_re = d * a[k][0]
+                        - (sx * a[k+1][0] + sy * a[k+1][1])
+                        - (sx * b[k][0] - sy * b[k][1]) + b[k+1][0];
+                    const double T_im = d * a[k][1]
+                        - (sx * a[k+1][1] - sy * a[k+1][0])
+                        - (sx * b[k][1] + sy * b[k][0]) + b[k+1][1];
+                    sum += (T_re * wk[k][0] - T_im * wk[k][1]) / k;
+                }
+                vars[v] += 2.0 * (C0 * log_z - sum);
+            }
+        }
+        else if( node.child[0] < 0 )
+        {
+            const int first = node.first_point;
+            const int last = first + node.nof_points;
+            int r = first;
+            for( ; r + 3 < last; r += 4 )
+            {
+                double dfTmp[4] = {};
+                VizGeorefSpline2DBase_func4( dfTmp, Pxy,
+                                             &_sorted_x[r], &_sorted_y[r] );
+                for( int v = 0; v < _nof_vars; v++ )
+                {
+                    const double* c = &_sorted_coef[v][r];
+                    vars[v] += c[0] * dfTmp[0] + c[1] * dfTmp[1] +
+                               c[2] * dfTmp[2] + c[3] * dfTmp[3];
+                }
+            }
+            for( ; r < last; r++ )
+            {
+                const double tmp = VizGeorefSpline2DBase_func(
+                    Px, Py, _sorted_x[r], _sorted_y[r] );
+                for( int v = 0; v < _nof_vars; v++ )
+                    vars[v] += _sorted_coef[v][r] * tmp;
+            }
+        }
+        else
+        {
+            stack[nStackSize++] = node.child[1];
+            stack[nStackSize++] = node.child[0];
+        }
+    }
+}
+
 int VizGeorefSpline2D::get_point( const double Px, const double Py,
                                   double *vars )
 {
@@ -690,6 +1006,12 @@ int VizGeorefSpline2D::get_point( const double Px, const double Py,
         for( int v = 0; v < _nof_vars; v++ )
             vars[v] = coef[v][0] + coef[v][1] * Px + coef[v][2] * Py;
 
+        if( !_nodes.empty() )
+        {
+            add_approx_terms( Px, Py, vars );
+            break;
+        }
+
         int r = 0;  // Used after for.
         for( ; r < (_nof_points & (~3)); r+=4 )
         {
@@ -38,6 +38,10 @@
 #include "gdal_alg.h"
 #include "cpl_conv.h"
 
+#include <vector>
+
+class CPLWorkerThreadPool;
+
 typedef enum
 {
     VIZ_GEOREF_SPLINE_ZERO_POINTS,
@@ -53,6 +57,24 @@ typedef enum
 //#define VIZ_GEOREF_SPLINE_MAX_POINTS 40
 #define VIZGEOREF_MAX_VARS 2
 
+// Order of the far field expansion used by the approximate evaluation.
+#define VIZ_GEOREF_SPLINE_ORDER 12
+
+// Node of the tree used by the approximate evaluation of the spline.
+typedef struct
+{
+    double cx, cy;      // Center of the expansion.
+    double radius;      // Largest distance of the points to the center.
+    // Complex moments sum(coef * t^k) and sum(coef * conj(t) * t^k), for k
+    // from 0 to VIZ_GEOREF_SPLINE_ORDER + 1, t = (dx, dy) being the position
+    // of the point relative to the center.
+    double a[VIZGEOREF_MAX_VARS][VIZ_GEOREF_SPLINE_ORDER + 2][2];
+    double b[VIZGEOREF_MAX_VARS][VIZ_GEOREF_SPLINE_ORDER + 2][2];
+    int first_point;    // Range of the points in the sorted arrays.
+    int nof_points;
+    int child[2];       // Children, or -1 for a leaf.
+} vizGeorefSplineNode;
+
 class VizGeorefSpline2D
 {
     bool grow_points();
@@ -72,6 +94,7 @@ class VizGeorefSpline2D
 #endif
         _dx(0.0),
         _dy(0.0),
+        _max_error_factor(0.0),
         x(nullptr),
         y(nullptr),
         u(nullptr),
@@ -156,10 +179,14 @@ class VizGeorefSpline2D
     bool change_point(int index, double x, double y, double* Pvars);
     void reset(void) { _nof_points = 0; }
 #endif
-    int solve(void);
+    int solve( CPLWorkerThreadPool* poThreadPool = nullptr );
+    bool set_max_error( double max_error );
 
   private:
 
+    int build_node( std::vector<int>& perm, int first, int count );
+    void add_approx_terms( const double Px, const double Py, double *vars );
+
     vizGeorefInterType type;
 
     const int _nof_vars;
@@ -175,6 +202,14 @@ class VizGeorefSpline2D
 
     double _dx, _dy;
 
+    // Approximate evaluation: max_error divided by the largest sum of
+    // |coef| over the points, and tree over the points sorted by node.
+    double _max_error_factor;
+    std::vector<vizGeorefSplineNode> _nodes;
+    std::vector<double> _sorted_x;
+    std::vector<double> _sorted_y;
+    std::vector<double> _sorted_coef[VIZGEOREF_MAX_VARS];
+
     double *x; // [VIZ_GEOREF_SPLINE_MAX_POINTS+3];
     double *y; // [VIZ_GEOREF_SPLINE_MAX_POINTS+3];
 
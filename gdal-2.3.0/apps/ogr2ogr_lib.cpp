@@ -39,7 +39,9 @@
 #include <cstring>
 
 #include <algorithm>
+#include <deque>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <utility>
@@ -48,6 +50,7 @@
 #include "commonutils.h"
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_multiproc.h"
 #include "cpl_progress.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
@@ -1280,6 +1283,9 @@ GDALVectorTranslateWrappedLayer::GDALVectorTranslateWrappedLayer(
                  static_cast<OGRCoordinateTransformation*>(nullptr) ),
         m_poFDefn( nullptr )
 {
+    // The features returned by this layer have its own definition, so
+    // RecycleFeature() keeps them instead of giving them to the base layer.
+    SetRecycleFeatureTarget( nullptr );
 }
 
 GDALVectorTranslateWrappedLayer* GDALVectorTranslateWrappedLayer::New(
@@ -1370,7 +1376,7 @@ OGRFeature* GDALVectorTranslateWrappedLayer::TranslateFeature(
 {
     if( poSrcFeat == nullptr )
         return nullptr;
-    OGRFeature* poNewFeat = new OGRFeature(m_poFDefn);
+    OGRFeature* poNewFeat = AcquireFeature(m_poFDefn);
     poNewFeat->SetFrom(poSrcFeat);
     poNewFeat->SetFID(poSrcFeat->GetFID());
     for( int i=0; i < poNewFeat->GetGeomFieldCount(); i++ )
@@ -1384,7 +1390,7 @@ OGRFeature* GDALVectorTranslateWrappedLayer::TranslateFeature(
                     m_poFDefn->GetGeomFieldDefn(i)->GetSpatialRef() );
         }
     }
-    delete poSrcFeat;
+    GetBaseLayer()->RecycleFeature(poSrcFeat);
     return poNewFeat;
 }
 
@@ -4320,6 +4326,313 @@ static bool SetupCT( TargetLayerInfo* psInfo,
     return true;
 }
 
+/************************************************************************/
+/*                          FeatureReadAhead                            */
+/************************************************************************/
+
+/* Reads the features of a source layer in a worker thread, through a    */
+/* bounded queue, so that reading and decoding of the source, and        */
+/* optionally the reprojection of its geometry, overlap with the rest of */
+/* the processing and the writing in the calling thread.                 */
+/*                                                                       */
+/* Once started, the worker thread is the only one to use the source     */
+/* layer and the coordinate transformation, until the object is          */
+/* destroyed. The CPLError() emitted by the worker are collected with    */
+/* each feature and emitted again in the calling thread when the feature */
+/* is fetched. The features given back with RecycleFeature() are passed  */
+/* to OGRLayer::RecycleFeature() by the worker thread.                   */
+
+namespace {
+class ReadAheadError final
+{
+  public:
+    CPLErr type;
+    CPLErrorNum no;
+    CPLString msg;
+
+    ReadAheadError() : type(CE_None), no(CPLE_None) {}
+    ReadAheadError(CPLErr eErrIn, CPLErrorNum noIn, const char* msgIn) :
+        type(eErrIn), no(noIn), msg(msgIn) {}
+};
+}
+
+class FeatureReadAhead
+{
+  public:
+    /* Status of the reprojection of a feature read ahead. */
+    enum CTStatus
+    {
+        CT_NOT_DONE,
+        CT_DONE,
+        CT_FAILED
+    };
+
+  private:
+    struct Item
+    {
+        OGRFeature*                 poFeature;
+        CTStatus                    eCTStatus;
+        std::vector<ReadAheadError> aoErrors;
+    };
+
+    OGRLayer             *m_poSrcLayer;
+    size_t                m_nMaxQueueSize;
+    GIntBig               m_nMaxFeatures;
+    int                   m_iSrcGeomField;
+    OGRCoordinateTransformation *m_poCT;
+    char                **m_papszTransformOptions;
+    CPLJoinableThread    *m_hThread;
+    CPLMutex             *m_hMutex;
+    CPLCond              *m_hCond;
+    std::deque<Item>      m_aoQueue;
+    std::vector<OGRFeature*> m_apoRecycledFeatures;
+    bool                  m_bEOF;
+    bool                  m_bStop;
+
+    static void           ThreadFunc( void* pData );
+    static void CPL_STDCALL ErrorHandler( CPLErr eErr, CPLErrorNum no,
+                                          const char* msg );
+
+    CPL_DISALLOW_COPY_ASSIGN(FeatureReadAhead)
+
+  public:
+                          FeatureReadAhead( OGRLayer* poSrcLayer,
+                                            size_t nMaxQueueSize,
+                                            GIntBig nMaxFeatures );
+                         ~FeatureReadAhead();
+
+    void                  SetReprojection( int iSrcGeomField,
+                                           OGRCoordinateTransformation* poCT,
+                                           char** papszTransformOptions );
+    bool                  Start();
+    OGRFeature           *GetNextFeature( CTStatus& eCTStatus );
+    void                  RecycleFeature( OGRFeature* poFeature );
+};
+
+/************************************************************************/
+/*                          FeatureReadAhead()                          */
+/************************************************************************/
+
+/* nMaxFeatures is the maximum number of features to read, or -1.        */
+
+FeatureReadAhead::FeatureReadAhead( OGRLayer* poSrcLayer,
+                                    size_t nMaxQueueSize,
+                                    GIntBig nMaxFeatures ) :
+    m_poSrcLayer(poSrcLayer),
+    m_nMaxQueueSize(nMaxQueueSize),
+    m_nMaxFeatures(nMaxFeatures),
+    m_iSrcGeomField(-1),
+    m_poCT(nullptr),
+    m_papszTransformOptions(nullptr),
+    m_hThread(nullptr),
+    m_hMutex(nullptr),
+    m_hCond(nullptr),
+    m_bEOF(false),
+    m_bStop(false)
+{
+}
+
+/************************************************************************/
+/*                         ~FeatureReadAhead()                          */
+/************************************************************************/
+
+FeatureReadAhead::~FeatureReadAhead()
+{
+    if( m_hThread )
+    {
+        CPLAcquireMutex(m_hMutex, 1000.0);
+        m_bStop = true;
+        CPLCondBroadcast(m_hCond);
+        CPLReleaseMutex(m_hMutex);
+        CPLJoinThread(m_hThread);
+    }
+    for( size_t i = 0; i < m_aoQueue.size(); i++ )
+        OGRFeature::DestroyFeature(m_aoQueue[i].poFeature);
+    for( size_t i = 0; i < m_apoRecycledFeatures.size(); i++ )
+        OGRFeature::DestroyFeature(m_apoRecycledFeatures[i]);
+    if( m_hCond )
+        CPLDestroyCond(m_hCond);
+    if( m_hMutex )
+        CPLDestroyMutex(m_hMutex);
+}
+
+/************************************************************************/
+/*                          SetReprojection()                           */
+/************************************************************************/
+
+/* Make the worker thread reproject the geometry of field iSrcGeomField  */
+/* of the features, as GDALVectorTranslate() would do it. Must be called */
+/* before Start().                                                       */
+
+void FeatureReadAhead::SetReprojection( int iSrcGeomField,
+                                        OGRCoordinateTransformation* poCT,
+                                        char** papszTransformOptions )
+{
+    m_iSrcGeomField = iSrcGeomField;
+    m_poCT = poCT;
+    m_papszTransformOptions = papszTransformOptions;
+}
+
+/************************************************************************/
+/*                               Start()                                */
+/************************************************************************/
+
+bool FeatureReadAhead::Start()
+{
+    m_hMutex = CPLCreateMutex();
+    if( m_hMutex == nullptr )
+        return false;
+    CPLReleaseMutex(m_hMutex);
+    m_hCond = CPLCreateCond();
+    if( m_hCond == nullptr )
+        return false;
+    m_hThread = CPLCreateJoinableThread(ThreadFunc, this);
+    return m_hThread != nullptr;
+}
+
+/************************************************************************/
+/*                            ErrorHandler()                            */
+/************************************************************************/
+
+void CPL_STDCALL FeatureReadAhead::ErrorHandler( CPLErr eErr,
+                                                 CPLErrorNum no,
+                                                 const char* msg )
+{
+    std::vector<ReadAheadError>* paoErrors =
+        static_cast<std::vector<ReadAheadError> *>(
+            CPLGetErrorHandlerUserData());
+    paoErrors->push_back(ReadAheadError(eErr, no, msg));
+}
+
+/************************************************************************/
+/*                             ThreadFunc()                             */
+/************************************************************************/
+
+void FeatureReadAhead::ThreadFunc( void* pData )
+{
+    FeatureReadAhead* psThis = static_cast<FeatureReadAhead*>(pData);
+
+    GIntBig nRead = 0;
+    std::vector<OGRFeature*> apoRecycledFeatures;
+    while( psThis->m_nMaxFeatures < 0 || nRead < psThis->m_nMaxFeatures )
+    {
+        CPLAcquireMutex(psThis->m_hMutex, 1000.0);
+        while( !psThis->m_bStop &&
+               psThis->m_aoQueue.size() >= psThis->m_nMaxQueueSize )
+        {
+            CPLCondWait(psThis->m_hCond, psThis->m_hMutex);
+        }
+        const bool bStop = psThis->m_bStop;
+        apoRecycledFeatures.swap(psThis->m_apoRecycledFeatures);
+        CPLReleaseMutex(psThis->m_hMutex);
+
+        for( size_t i = 0; i < apoRecycledFeatures.size(); i++ )
+            psThis->m_poSrcLayer->RecycleFeature(apoRecycledFeatures[i]);
+        apoRecycledFeatures.clear();
+        if( bStop )
+            return;
+
+        Item oItem;
+        oItem.eCTStatus = CT_NOT_DONE;
+        CPLPushErrorHandlerEx(ErrorHandler, &oItem.aoErrors);
+        CPLSetCurrentErrorHandlerCatchDebug(FALSE);
+
+        oItem.poFeature = psThis->m_poSrcLayer->GetNextFeature();
+        OGRGeometry* poGeom = nullptr;
+        if( oItem.poFeature != nullptr && psThis->m_iSrcGeomField >= 0 )
+            poGeom = oItem.poFeature->GetGeomFieldRef(psThis->m_iSrcGeomField);
+        if( poGeom != nullptr )
+        {
+            OGRGeometry* poReprojectedGeom =
+                OGRGeometryFactory::transformWithOptions(
+                    poGeom, psThis->m_poCT, psThis->m_papszTransformOptions);
+            if( poReprojectedGeom != nullptr )
+            {
+                oItem.poFeature->SetGeomFieldDirectly(
+                    psThis->m_iSrcGeomField, poReprojectedGeom);
+                oItem.eCTStatus = CT_DONE;
+            }
+            else
+            {
+                oItem.eCTStatus = CT_FAILED;
+            }
+        }
+
+        CPLPopErrorHandler();
+
+        CPLAcquireMutex(psThis->m_hMutex, 1000.0);
+        const bool bEOF = oItem.poFeature == nullptr;
+        psThis->m_aoQueue.push_back(oItem);
+        CPLCondBroadcast(psThis->m_hCond);
+        CPLReleaseMutex(psThis->m_hMutex);
+
+        if( bEOF )
+            return;
+        nRead++;
+    }
+
+    // Limit reached: signal the end of the layer.
+    CPLAcquireMutex(psThis->m_hMutex, 1000.0);
+    Item oItem;
+    oItem.poFeature = nullptr;
+    oItem.eCTStatus = CT_NOT_DONE;
+    psThis->m_aoQueue.push_back(oItem);
+    CPLCondBroadcast(psThis->m_hCond);
+    CPLReleaseMutex(psThis->m_hMutex);
+}
+
+/************************************************************************/
+/*                          GetNextFeature()                            */
+/************************************************************************/
+
+/* Returns the next feature, or NULL at the end of the layer, after      */
+/* having emitted the errors raised while reading it. eCTStatus tells    */
+/* whether the geometry has been reprojected.                            */
+
+OGRFeature* FeatureReadAhead::GetNextFeature( CTStatus& eCTStatus )
+{
+    eCTStatus = CT_NOT_DONE;
+    if( m_bEOF )
+        return nullptr;
+
+    CPLAcquireMutex(m_hMutex, 1000.0);
+    while( m_aoQueue.empty() )
+        CPLCondWait(m_hCond, m_hMutex);
+    Item oItem = m_aoQueue.front();
+    m_aoQueue.pop_front();
+    CPLCondBroadcast(m_hCond);
+    CPLReleaseMutex(m_hMutex);
+
+    for( size_t i = 0; i < oItem.aoErrors.size(); i++ )
+    {
+        CPLError( oItem.aoErrors[i].type, oItem.aoErrors[i].no, "%s",
+                  oItem.aoErrors[i].msg.c_str() );
+    }
+    if( oItem.poFeature == nullptr )
+        m_bEOF = true;
+    eCTStatus = oItem.eCTStatus;
+    return oItem.poFeature;
+}
+
+/************************************************************************/
+/*                           RecycleFeature()                           */
+/************************************************************************/
+
+/* Give back a feature returned by GetNextFeature(), for the worker      */
+/* thread to pass it to the source layer.                                */
+
+void FeatureReadAhead::RecycleFeature( OGRFeature* poFeature )
+{
+    if( m_bEOF )
+    {
+        OGRFeature::DestroyFeature(poFeature);
+        return;
+    }
+    CPLAcquireMutex(m_hMutex, 1000.0);
+    m_apoRecycledFeatures.push_back(poFeature);
+    CPLReleaseMutex(m_hMutex);
+}
+
 /************************************************************************/
 /*                     LayerTranslator::Translate()                     */
 /************************************************************************/
@@ -4375,6 +4688,23 @@ int LayerTranslator::Translate( OGRFeature* poFeatureIn,
     GIntBig      nCount = 0; /* written + failed */
     GIntBig      nFeaturesWritten = 0;
 
+/* -------------------------------------------------------------------- */
+/*      Optionally read the source layer in a worker thread, once the   */
+/*      first feature has been read and the coordinate transformation   */
+/*      set up. Not done when the source and target datasets are the    */
+/*      same, as drivers are not safe for concurrent use of a dataset.  */
+/*      This is also worth it on a single CPU, as reading can then      */
+/*      overlap with I/O waits of the writing.                          */
+/* -------------------------------------------------------------------- */
+    const bool bReadAhead =
+        poFeatureIn == nullptr && psOptions->nFIDToFetch == OGRNullFID &&
+        m_poSrcDS != m_poODS &&
+        CPLTestBool(CPLGetConfigOption("OGR2OGR_READ_AHEAD", "NO"));
+    std::unique_ptr<FeatureReadAhead> poReadAhead;
+    // The source layer must not be used in this thread once the worker
+    // thread is started.
+    const CPLString osSrcLayerName(poSrcLayer->GetName());
+
     bool bRet = true;
     CPLErrorReset();
     while( true )
@@ -4384,10 +4714,13 @@ int LayerTranslator::Translate( OGRFeature* poFeatureIn,
             break;
         }
 
+        FeatureReadAhead::CTStatus eCTStatus = FeatureReadAhead::CT_NOT_DONE;
         if( poFeatureIn != nullptr )
             poFeature = poFeatureIn;
         else if( psOptions->nFIDToFetch != OGRNullFID )
             poFeature = poSrcLayer->GetFeature(psOptions->nFIDToFetch);
+        else if( poReadAhead )
+            poFeature = poReadAhead->GetNextFeature(eCTStatus);
         else
             poFeature = poSrcLayer->GetNextFeature();
 
@@ -4411,6 +4744,40 @@ int LayerTranslator::Translate( OGRFeature* poFeatureIn,
             }
         }
 
+        if( bReadAhead && psInfo->nFeaturesRead == 0 &&
+            !psInfo->bPerFeatureCT )
+        {
+            const int nQueueSize = atoi(
+                CPLGetConfigOption("OGR2OGR_READ_AHEAD_QUEUE_SIZE", "1000"));
+            poReadAhead.reset(new FeatureReadAhead(
+                poSrcLayer, std::max(1, nQueueSize),
+                m_nLimit >= 0 ? std::max(static_cast<GIntBig>(0),
+                                         m_nLimit - 1) : -1));
+
+            // The reprojection is also done by the worker thread when it
+            // is the first operation done on the geometry.
+            OGRCoordinateTransformation* poCT =
+                m_bTransform ? psInfo->papoCT[0] : m_poGCPCoordTrans;
+            int iSrcGeomField = -1;
+            if( nSrcGeomFieldCount == 1 )
+                iSrcGeomField = 0;
+            else if( psInfo->iRequestedSrcGeomField >= 0 )
+                iSrcGeomField = psInfo->iRequestedSrcGeomField;
+            if( nDstGeomFieldCount == 1 && iSrcGeomField >= 0 &&
+                !bExplodeCollections && iSrcZField == -1 &&
+                m_nCoordDim == COORD_DIM_UNCHANGED &&
+                m_eGeomOp == GEOMOP_NONE && m_poClipSrc == nullptr &&
+                (poCT != nullptr ||
+                 psInfo->papapszTransformOptions[0] != nullptr) )
+            {
+                poReadAhead->SetReprojection(
+                    iSrcGeomField, poCT, psInfo->papapszTransformOptions[0]);
+            }
+
+            if( !poReadAhead->Start() )
+                poReadAhead.reset();
+        }
+
         psInfo->nFeaturesRead ++;
 
         int nParts = 0;
@@ -4496,7 +4863,7 @@ int LayerTranslator::Translate( OGRFeature* poFeatureIn,
 
                 CPLError( CE_Failure, CPLE_AppDefined,
                         "Unable to translate feature " CPL_FRMT_GIB " from layer %s.",
-                        poFeature->GetFID(), poSrcLayer->GetName() );
+                        poFeature->GetFID(), osSrcLayerName.c_str() );
 
                 OGRFeature::DestroyFeature( poFeature );
                 OGRFeature::DestroyFeature( poDstFeature );
@@ -4605,9 +4972,14 @@ int LayerTranslator::Translate( OGRFeature* poFeatureIn,
                     poCT = m_poGCPCoordTrans;
                 char** papszTransformOptions = psInfo->papapszTransformOptions[iGeom];
 
-                if( poCT != nullptr || papszTransformOptions != nullptr)
+                if( eCTStatus == FeatureReadAhead::CT_DONE )
+                {
+                    // Already reprojected by the read-ahead thread.
+                }
+                else if( poCT != nullptr || papszTransformOptions != nullptr)
                 {
                     OGRGeometry* poReprojectedGeom =
+                        eCTStatus == FeatureReadAhead::CT_FAILED ? nullptr :
                         OGRGeometryFactory::transformWithOptions(poDstGeometry, poCT, papszTransformOptions);
                     if( poReprojectedGeom == nullptr )
                     {
@@ -4703,7 +5075,7 @@ int LayerTranslator::Translate( OGRFeature* poFeatureIn,
 
                 CPLError( CE_Failure, CPLE_AppDefined,
                         "Unable to write feature " CPL_FRMT_GIB " from layer %s.",
-                        poFeature->GetFID(), poSrcLayer->GetName() );
+                        poFeature->GetFID(), osSrcLayerName.c_str() );
 
                 OGRFeature::DestroyFeature( poFeature );
                 OGRFeature::DestroyFeature( poDstFeature );
@@ -4712,7 +5084,7 @@ int LayerTranslator::Translate( OGRFeature* poFeatureIn,
             else
             {
                 CPLDebug( "GDALVectorTranslate", "Unable to write feature " CPL_FRMT_GIB " into layer %s.",
-                           poFeature->GetFID(), poSrcLayer->GetName() );
+                           poFeature->GetFID(), osSrcLayerName.c_str() );
                 if( psOptions->nGroupTransactions )
                 {
                     if( psOptions->nLayerTransaction )
@@ -4732,7 +5104,13 @@ end_loop:
             OGRFeature::DestroyFeature( poDstFeature );
         }
 
-        OGRFeature::DestroyFeature( poFeature );
+        // Give the source feature back for reuse by the driver.
+        if( poReadAhead )
+            poReadAhead->RecycleFeature( poFeature );
+        else if( poFeatureIn == nullptr )
+            poSrcLayer->RecycleFeature( poFeature );
+        else
+            OGRFeature::DestroyFeature( poFeature );
 
         /* Report progress */
         nCount ++;
@@ -0,0 +1,201 @@
+/******************************************************************************
+ *
+ * Project:  GDAL
+ * Purpose:  Benchmark reads of a VRT mosaic with many sources, with and
+ *           without the spatial index of its sources.
+ * Author:   GDAL contributors
+ *
+ ******************************************************************************
+ * Copyright (c) 2018, GDAL contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ ****************************************************************************/
+
+#include "cpl_conv.h"
+#include "cpl_string.h"
+#include "gdal.h"
+#include "gdal_vrt.h"
+
+#include <chrono>
+#include <vector>
+
+CPL_CVSID("$Id$")
+
+/************************************************************************/
+/*                               Usage()                                */
+/************************************************************************/
+
+static void Usage()
+{
+    printf("testvrtsourceindex [-nx <sources>] [-ny <sources>]\n"
+           "                   [-tile <size>] [-reads <count>]\n"
+           "                   [-read_size <size>]\n");
+    exit(1);
+}
+
+/************************************************************************/
+/*                             ReadWindows()                            */
+/*                                                                      */
+/*      Read nReads windows spread over the band, and return a hash of  */
+/*      their content.                                                  */
+/************************************************************************/
+
+static GUInt32 ReadWindows( GDALRasterBandH hBand, int nReads,
+                            int nReadSize, double* pdfFirstReadMs,
+                            double* pdfOtherReadsMs )
+{
+    const int nXSize = GDALGetRasterBandXSize(hBand);
+    const int nYSize = GDALGetRasterBandYSize(hBand);
+    std::vector<GByte> abyBuffer(static_cast<size_t>(nReadSize) * nReadSize);
+    GUInt32 nHash = 0;
+
+    *pdfFirstReadMs = 0;
+    *pdfOtherReadsMs = 0;
+    for( int i = 0; i < nReads; i++ )
+    {
+        const int nXOff = static_cast<int>(
+            (static_cast<GIntBig>(i) * 7919) % (nXSize - nReadSize + 1));
+        const int nYOff = static_cast<int>(
+            (static_cast<GIntBig>(i) * 104729) % (nYSize - nReadSize + 1));
+
+        const auto tStart = std::chrono::steady_clock::now();
+        if( GDALRasterIO( hBand, GF_Read, nXOff, nYOff,
+                          nReadSize, nReadSize, &abyBuffer[0],
+                          nReadSize, nReadSize, GDT_Byte, 0, 0 ) != CE_None )
+        {
+            exit(1);
+        }
+        const double dfMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - tStart).count();
+        if( i == 0 )
+            *pdfFirstReadMs = dfMs;
+        else
+            *pdfOtherReadsMs += dfMs;
+
+        for( size_t j = 0; j < abyBuffer.size(); j++ )
+            nHash = nHash * 31 + abyBuffer[j];
+    }
+    if( nReads > 1 )
+        *pdfOtherReadsMs /= nReads - 1;
+
+    return nHash;
+}
+
+/************************************************************************/
+/*                                main()                                */
+/************************************************************************/
+
+int main( int argc, char* argv[] )
+{
+    int nSourcesX = 400;
+    int nSourcesY = 250;
+    int nTileSize = 64;
+    int nReads = 200;
+    int nReadSize = 256;
+
+    for( int i = 1; i < argc; i++ )
+    {
+        if( EQUAL(argv[i], "-nx") && i+1 < argc )
+            nSourcesX = atoi(argv[++i]);
+        else if( EQUAL(argv[i], "-ny") && i+1 < argc )
+            nSourcesY = atoi(argv[++i]);
+        else if( EQUAL(argv[i], "-tile") && i+1 < argc )
+            nTileSize = atoi(argv[++i]);
+        else if( EQUAL(argv[i], "-reads") && i+1 < argc )
+            nReads = atoi(argv[++i]);
+        else if( EQUAL(argv[i], "-read_size") && i+1 < argc )
+            nReadSize = atoi(argv[++i]);
+        else
+            Usage();
+    }
+    if( nSourcesX <= 0 || nSourcesY <= 0 || nTileSize <= 0 || nReads <= 0 ||
+        nReadSize <= 0 || nReadSize > nSourcesX * nTileSize ||
+        nReadSize > nSourcesY * nTileSize )
+    {
+        Usage();
+    }
+
+    GDALAllRegister();
+
+/* -------------------------------------------------------------------- */
+/*      All the sources point to the same in-memory tile. Every other   */
+/*      row of sources is shifted so that sources overlap.              */
+/* -------------------------------------------------------------------- */
+    GDALDatasetH hTileDS = GDALCreate( GDALGetDriverByName("MEM"), "",
+                                       nTileSize, nTileSize, 1, GDT_Byte,
+                                       nullptr );
+    std::vector<GByte> abyTile(static_cast<size_t>(nTileSize) * nTileSize);
+    for( size_t i = 0; i < abyTile.size(); i++ )
+        abyTile[i] = static_cast<GByte>(i * 7);
+    GDALRasterBandH hTileBand = GDALGetRasterBand(hTileDS, 1);
+    CPL_IGNORE_RET_VAL( GDALRasterIO( hTileBand, GF_Write, 0, 0,
+                                      nTileSize, nTileSize, &abyTile[0],
+                                      nTileSize, nTileSize, GDT_Byte,
+                                      0, 0 ) );
+
+    VRTDatasetH hVRTDS = VRTCreate( nSourcesX * nTileSize,
+                                    nSourcesY * nTileSize );
+    GDALAddBand( hVRTDS, GDT_Byte, nullptr );
+    GDALRasterBandH hVRTBand = GDALGetRasterBand(hVRTDS, 1);
+    for( int j = 0; j < nSourcesY; j++ )
+    {
+        for( int i = 0; i < nSourcesX; i++ )
+        {
+            VRTAddSimpleSource( hVRTBand, hTileBand, 0, 0,
+                                nTileSize, nTileSize,
+                                i * nTileSize + (j % 3), j * nTileSize,
+                                nTileSize, nTileSize, nullptr,
+                                VRT_NODATA_UNSET );
+        }
+    }
+
+    printf("%d sources, %d reads of %dx%d\n",
+           nSourcesX * nSourcesY, nReads, nReadSize, nReadSize);
+
+/* -------------------------------------------------------------------- */
+/*      Read the same windows with and without the index. The first     */
+/*      read with the index includes building it.                       */
+/* -------------------------------------------------------------------- */
+    GUInt32 anHash[2] = { 0, 0 };
+    const char* const apszModes[2] = { "YES", "NO" };
+    for( int iMode = 0; iMode < 2; iMode++ )
+    {
+        CPLSetConfigOption( "VRT_SOURCE_INDEX", apszModes[iMode] );
+        double dfFirstReadMs = 0;
+        double dfOtherReadsMs = 0;
+        anHash[iMode] = ReadWindows( hVRTBand, nReads, nReadSize,
+                                     &dfFirstReadMs, &dfOtherReadsMs );
+        printf("VRT_SOURCE_INDEX=%s: first read %.3f ms, "
+               "next reads %.3f ms each\n",
+               apszModes[iMode], dfFirstReadMs, dfOtherReadsMs);
+    }
+    CPLSetConfigOption( "VRT_SOURCE_INDEX", nullptr );
+
+    GDALClose( hVRTDS );
+    GDALClose( hTileDS );
+    GDALDestroyDriverManager();
+
+    if( anHash[0] != anHash[1] )
+    {
+        printf("FAILURE: the reads differ with and without the index\n");
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,232 @@
+#!/usr/bin/env python
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  Test that the backmap of the geolocation transformer gives the
+#           same results whether it is computed in a single pass, by tiles
+#           in parallel, or by tiles on demand, also from several threads.
+#
+###############################################################################
+# Copyright (c) 2018, GDAL contributors
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+import math
+import struct
+import sys
+import threading
+
+sys.path.append('../pymod')
+
+from osgeo import gdal
+
+import gdaltest
+
+###############################################################################
+# Create the geolocation arrays of a curved swath of xsize x ysize pixels,
+# with a nodata hole, and a dataset referencing them.
+
+
+def geoloc_backmap_create_dataset(xsize, ysize):
+
+    x_ds = gdal.GetDriverByName('GTiff').Create(
+        '/vsimem/geoloc_backmap_x.tif', xsize, ysize, 1, gdal.GDT_Float64)
+    y_ds = gdal.GetDriverByName('GTiff').Create(
+        '/vsimem/geoloc_backmap_y.tif', xsize, ysize, 1, gdal.GDT_Float64)
+    for j in range(ysize):
+        v = float(j) / ysize
+        xs = []
+        ys = []
+        for i in range(xsize):
+            u = float(i) / xsize
+            if (i - xsize // 2) ** 2 + (j - ysize // 3) ** 2 < \
+               xsize * xsize // 100:
+                xs.append(-999)
+            else:
+                xs.append(10 + 5 * u + 0.8 * v * v + 0.3 * math.sin(6 * v))
+            ys.append(40 + 4 * v - 0.6 * u * u)
+        x_ds.WriteRaster(0, j, xsize, 1, struct.pack('d' * xsize, *xs))
+        y_ds.WriteRaster(0, j, xsize, 1, struct.pack('d' * xsize, *ys))
+    x_ds.GetRasterBand(1).SetNoDataValue(-999)
+    x_ds = None
+    y_ds = None
+
+    ds = gdal.GetDriverByName('MEM').Create('', xsize, ysize)
+    ds.SetMetadata({'X_DATASET': '/vsimem/geoloc_backmap_x.tif',
+                    'X_BAND': '1',
+                    'Y_DATASET': '/vsimem/geoloc_backmap_y.tif',
+                    'Y_BAND': '1',
+                    'PIXEL_OFFSET': '0', 'PIXEL_STEP': '1',
+                    'LINE_OFFSET': '0', 'LINE_STEP': '1'}, 'GEOLOCATION')
+    return ds
+
+###############################################################################
+# Transform georeferenced points to pixel/line with the given configuration
+# options, and collect the debug messages of the transformer.
+
+
+def geoloc_backmap_transform(ds, points, options):
+
+    messages = []
+
+    def handler(err_class, err_no, msg):
+        # pylint: disable=unused-argument
+        if err_class == gdal.CE_Debug and msg.startswith('GEOLOC'):
+            messages.append(msg)
+
+    gdal.PushErrorHandler(handler)
+    old_debug = gdal.GetConfigOption('CPL_DEBUG')
+    gdal.SetConfigOption('CPL_DEBUG', 'ON')
+    for (key, value) in options:
+        gdal.SetConfigOption(key, value)
+    tr = gdal.Transformer(ds, None, ['METHOD=GEOLOC_ARRAY'])
+    for (key, value) in options:
+        gdal.SetConfigOption(key, None)
+    gdal.SetConfigOption('CPL_DEBUG', old_debug)
+    gdal.PopErrorHandler()
+
+    res = tr.TransformPoints(1, points)
+    return (res, messages)
+
+###############################################################################
+# Georeferenced points spread over the geolocation arrays and around them.
+
+
+def geoloc_backmap_points():
+
+    points = []
+    for k in range(20000):
+        points.append((9.8 + 6.4 * ((k * 7919) % 100003) / 100003.0,
+                       39.3 + 4.6 * ((k * 104729) % 99991) / 99991.0))
+    return points
+
+###############################################################################
+# The single pass backmap, the tiles computed in parallel, and the tiles
+# computed on demand with a cache smaller than the backmap give the same
+# pixel/line. Tiles are only computed on demand if
+# GDAL_GEOLOC_BACKMAP_CACHE_MAX is set and smaller than the backmap.
+
+
+def geoloc_backmap_1():
+
+    ds = geoloc_backmap_create_dataset(800, 600)
+    points = geoloc_backmap_points()
+
+    ref, ref_messages = geoloc_backmap_transform(ds, points, [])
+    if [msg for msg in ref_messages if 'tiled backmap' in msg]:
+        gdaltest.post_reason('single pass backmap expected')
+        print(ref_messages)
+        return 'fail'
+    if len([1 for success in ref[1] if success]) < 10000:
+        gdaltest.post_reason('too few points transformed')
+        return 'fail'
+
+    for (options, expected_tiled) in [
+            ([('GDAL_NUM_THREADS', '4')], False),
+            ([('GDAL_GEOLOC_BACKMAP_CACHE_MAX', '100')], False),
+            ([('GDAL_GEOLOC_BACKMAP_CACHE_MAX', '0')], True),
+            ([('GDAL_GEOLOC_BACKMAP_CACHE_MAX', '0'),
+              ('GDAL_NUM_THREADS', '4')], True)]:
+        got, messages = geoloc_backmap_transform(ds, points, options)
+        tiled = len([msg for msg in messages if 'tiled backmap' in msg]) > 0
+        if tiled != expected_tiled:
+            gdaltest.post_reason('wrong backmap mode')
+            print(options, messages)
+            return 'fail'
+        # At least two rows of tiles are kept, even with a zero cache size.
+        for msg in messages:
+            if 'tiled backmap' in msg:
+                fields = msg[msg.find('(') + 1:].split(' ')
+                if int(fields[6]) < 2 * int(fields[0]):
+                    gdaltest.post_reason('cache smaller than 2 tile rows')
+                    print(msg)
+                    return 'fail'
+        if got != ref:
+            gdaltest.post_reason('results differ')
+            print(options)
+            return 'fail'
+
+    gdal.Unlink('/vsimem/geoloc_backmap_x.tif')
+    gdal.Unlink('/vsimem/geoloc_backmap_y.tif')
+
+    return 'success'
+
+
+###############################################################################
+# A transformer with tiles computed on demand, used concurrently by several
+# threads evicting each other's tiles, gives the same pixel/line as the
+# single pass backmap.
+
+
+def geoloc_backmap_2():
+
+    ds = geoloc_backmap_create_dataset(800, 600)
+    points = geoloc_backmap_points()
+
+    ref, _ = geoloc_backmap_transform(ds, points, [])
+
+    gdal.SetConfigOption('GDAL_GEOLOC_BACKMAP_CACHE_MAX', '0')
+    tr = gdal.Transformer(ds, None, ['METHOD=GEOLOC_ARRAY'])
+    gdal.SetConfigOption('GDAL_GEOLOC_BACKMAP_CACHE_MAX', None)
+
+    results = {}
+
+    def worker(k):
+        # Each thread visits the points in a different order.
+        order = list(range(k, len(points), 4)) + \
+            list(range(0, len(points)))
+        res = []
+        for i in range(0, len(order), 1000):
+            chunk = [points[j] for j in order[i:i + 1000]]
+            res += tr.TransformPoints(1, chunk)[0]
+        results[k] = (order, res)
+
+    threads = [threading.Thread(target=worker, args=(k,)) for k in range(4)]
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+
+    for k in range(4):
+        (order, res) = results[k]
+        for (i, j) in enumerate(order):
+            if ref[1][j] and res[i] != ref[0][j]:
+                gdaltest.post_reason('results differ')
+                print(k, j, res[i], ref[0][j])
+                return 'fail'
+
+    gdal.Unlink('/vsimem/geoloc_backmap_x.tif')
+    gdal.Unlink('/vsimem/geoloc_backmap_y.tif')
+
+    return 'success'
+
+
+gdaltest_list = [
+    geoloc_backmap_1,
+    geoloc_backmap_2]
+
+if __name__ == '__main__':
+
+    gdaltest.setup_run('geoloc_backmap')
+
+    gdaltest.run_tests(gdaltest_list)
+
+    gdaltest.summarize()
@@ -0,0 +1,388 @@
+#!/usr/bin/env python
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  Test the polygon filler of the rasterization algorithms on edge
+#           cases, and compare it with the scanline algorithm it replaced.
+#
+###############################################################################
+# Copyright (c) 2018, GDAL contributors
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+import math
+import random
+import struct
+import sys
+
+sys.path.append('../pymod')
+
+from osgeo import gdal
+from osgeo import ogr
+
+import gdaltest
+
+###############################################################################
+# Rasterize geometries given in pixel/line coordinates with MERGE_ALG=ADD,
+# so that pixels burnt twice show up, and return the raster as a list of
+# strings of digits, one per line.
+
+
+def rasterize_filler_burn(wkts, xsize, ysize, options=None):
+
+    ds = ogr.GetDriverByName('Memory').CreateDataSource('')
+    lyr = ds.CreateLayer('shapes')
+    for wkt in wkts:
+        feat = ogr.Feature(lyr.GetLayerDefn())
+        feat.SetGeometryDirectly(ogr.CreateGeometryFromWkt(wkt))
+        lyr.CreateFeature(feat)
+
+    raster_ds = gdal.GetDriverByName('MEM').Create('', xsize, ysize)
+    raster_ds.SetGeoTransform([0, 1, 0, 0, 0, 1])
+    gdal.RasterizeLayer(raster_ds, [1], lyr, burn_values=[1],
+                        options=['MERGE_ALG=ADD'] + (options or []))
+    data = struct.unpack('B' * (xsize * ysize),
+                         raster_ds.GetRasterBand(1).ReadRaster())
+    return [''.join('%d' % v for v in data[y * xsize:(y + 1) * xsize])
+            for y in range(ysize)]
+
+###############################################################################
+# Python version of the GDALdllImageFilledPolygon() implementation that
+# visited every edge for each line, as called by RasterizeLayer() with
+# MERGE_ALG=ADD. parts are the rings, with their points in the order in
+# which they are collected by the rasterizer (reversed).
+
+
+def rasterize_filler_reference(parts, xsize, ysize):
+
+    raster = [[0] * xsize for _ in range(ysize)]
+
+    def burn(y, x_start, x_end):
+        if x_start > x_end:
+            return
+        x_start = max(x_start, 0)
+        x_end = min(x_end, xsize - 1)
+        for x in range(x_start, x_end + 1):
+            raster[y][x] += 1
+
+    xs = [p[0] for part in parts for p in part]
+    ys = [p[1] for part in parts for p in part]
+    part_sizes = [len(part) for part in parts]
+    n = len(xs)
+
+    miny = max(int(min(ys)), 0)
+    maxy = min(int(max(ys)), ysize - 1)
+    minx = 0
+    maxx = xsize - 1
+
+    for y in range(miny, maxy + 1):
+        dy = y + 0.5
+        part = 0
+        partoffset = 0
+        ints = []
+        for i in range(n):
+            if i == partoffset + part_sizes[part]:
+                partoffset += part_sizes[part]
+                part += 1
+            if i == partoffset:
+                ind1 = partoffset + part_sizes[part] - 1
+                ind2 = partoffset
+            else:
+                ind1 = i - 1
+                ind2 = i
+
+            dy1 = ys[ind1]
+            dy2 = ys[ind2]
+            if (dy1 < dy and dy2 < dy) or (dy1 > dy and dy2 > dy):
+                continue
+
+            if dy1 < dy2:
+                dx1 = xs[ind1]
+                dx2 = xs[ind2]
+            elif dy1 > dy2:
+                dy2 = ys[ind1]
+                dy1 = ys[ind2]
+                dx2 = xs[ind1]
+                dx1 = xs[ind2]
+            else:
+                if xs[ind1] > xs[ind2]:
+                    horizontal_x1 = int(math.floor(xs[ind2] + 0.5))
+                    horizontal_x2 = int(math.floor(xs[ind1] + 0.5))
+                    if horizontal_x1 > maxx or horizontal_x2 <= minx:
+                        continue
+                    burn(y, horizontal_x1, horizontal_x2 - 1)
+                continue
+
+            if dy < dy2 and dy >= dy1:
+                intersect = (dy - dy1) * (dx2 - dx1) / (dy2 - dy1) + dx1
+                ints.append(int(math.floor(intersect + 0.5)))
+
+        ints.sort()
+        for i in range(0, len(ints) - 1, 2):
+            if ints[i] <= maxx and ints[i + 1] > minx:
+                burn(y, ints[i], ints[i + 1] - 1)
+
+    return [''.join('%d' % v for v in row) for row in raster]
+
+###############################################################################
+# Pixel centres of polygons lying exactly on edges and vertices.
+
+
+def rasterize_filler_1():
+
+    tests = [
+        # Square with its vertices and edges on pixel centres: the centres
+        # on the right edge are in, the ones on the left edge are out, and
+        # the lines whose centre is on the top edge are in, the ones on the
+        # bottom edge out. The top edge, which goes from right to left in the
+        # collected ring, is also burnt on its own.
+        (['POLYGON ((1.5 1.5,4.5 1.5,4.5 4.5,1.5 4.5,1.5 1.5))'],
+         ['000000',
+          '002220',
+          '001110',
+          '001110',
+          '000000',
+          '000000']),
+        # Same square with integer vertices.
+        (['POLYGON ((1 1,4 1,4 4,1 4,1 1))'],
+         ['000000',
+          '011100',
+          '011100',
+          '011100',
+          '000000',
+          '000000']),
+        # Diamond with its vertices on pixel centres: the top vertex is in,
+        # the bottom one out, and the crossings are rounded to the nearest
+        # pixel boundary.
+        (['POLYGON ((3.5 0.5,6.5 3.5,3.5 6.5,0.5 3.5,3.5 0.5))'],
+         ['0000000',
+          '0001100',
+          '0011110',
+          '0111111',
+          '0011110',
+          '0001100',
+          '0000000']),
+        # Triangle with a vertex on a pixel centre and edges that do not
+        # go through pixel centres.
+        (['POLYGON ((0 0,6 0,3.5 5.5,0 0))'],
+         ['111111',
+          '011110',
+          '001110',
+          '001100',
+          '000100',
+          '000000']),
+    ]
+    for (wkts, expected) in tests:
+        got = rasterize_filler_burn(wkts, len(expected[0]), len(expected))
+        if got != expected:
+            gdaltest.post_reason('fail')
+            print(wkts)
+            print('\n'.join(got))
+            return 'fail'
+
+    return 'success'
+
+###############################################################################
+# Shared vertices and edges: a vertex is counted once per ring through it,
+# two polygons sharing an edge do not both burn the pixels next to it, and
+# the horizontal edges going from right to left in the collected rings are
+# burnt on top of the fill.
+
+
+def rasterize_filler_2():
+
+    tests = [
+        # Bow-tie made of a single ring crossing itself on a pixel centre.
+        (['POLYGON ((0.5 0.5,6.5 6.5,6.5 0.5,0.5 6.5,0.5 0.5))'],
+         ['0000000',
+          '0100001',
+          '0110011',
+          '0111111',
+          '0110011',
+          '0100001',
+          '0000000']),
+        # Two triangles sharing a vertex on a pixel centre.
+        (['POLYGON ((0.5 0.5,3.5 3.5,0.5 6.5,0.5 0.5))',
+          'POLYGON ((6.5 0.5,6.5 6.5,3.5 3.5,6.5 0.5))'],
+         ['0000000',
+          '0100001',
+          '0110011',
+          '0111111',
+          '0110011',
+          '0100001',
+          '0000000']),
+        # Two squares sharing an edge going through pixel centres.
+        (['POLYGON ((0.5 0.5,3.5 0.5,3.5 4.5,0.5 4.5,0.5 0.5))',
+          'POLYGON ((3.5 0.5,6.5 0.5,6.5 4.5,3.5 4.5,3.5 0.5))'],
+         ['0222222',
+          '0111111',
+          '0111111',
+          '0111111',
+          '0000000',
+          '0000000']),
+        # Polygon with a hole sharing a vertex with the exterior ring.
+        (['POLYGON ((0.5 0.5,6.5 0.5,6.5 6.5,0.5 6.5,0.5 0.5),'
+          '(0.5 0.5,3.5 2.5,2.5 3.5,0.5 0.5))'],
+         ['0222222',
+          '0011111',
+          '0100111',
+          '0111111',
+          '0111111',
+          '0111111',
+          '0000000']),
+    ]
+    for (wkts, expected) in tests:
+        got = rasterize_filler_burn(wkts, len(expected[0]), len(expected))
+        if got != expected:
+            gdaltest.post_reason('fail')
+            print(wkts)
+            print('\n'.join(got))
+            return 'fail'
+
+    return 'success'
+
+###############################################################################
+# Horizontal edges lying on a line centre are burnt on their own when they
+# go from right to left in the collected ring, in addition to the fill.
+# The others are ignored.
+
+
+def rasterize_filler_3():
+
+    tests = [
+        # Staircase, with horizontal edges on line centres and in between.
+        (['POLYGON ((0.5 0.5,2.5 0.5,2.5 2.5,4.5 2.5,4.5 4,6 4,6 6,'
+          '0.5 6,0.5 0.5))'],
+         ['0220000',
+          '0110000',
+          '0112200',
+          '0111100',
+          '0111110',
+          '0111110',
+          '0000000']),
+        # U shape whose inner bottom edge is on a line centre.
+        (['POLYGON ((0.5 0.5,2.5 0.5,2.5 3.5,4.5 3.5,4.5 0.5,6.5 0.5,'
+          '6.5 5.5,0.5 5.5,0.5 0.5))'],
+         ['0220022',
+          '0110011',
+          '0110011',
+          '0112211',
+          '0111111',
+          '0000000',
+          '0000000']),
+        # Degenerate rings made of horizontal edges only: only one edge of
+        # each ring is burnt.
+        (['POLYGON ((0.5 2.5,5.5 2.5,0.5 2.5))',
+          'POLYGON ((5.5 4.5,0.5 4.5,5.5 4.5))'],
+         ['000000',
+          '000000',
+          '011111',
+          '000000',
+          '011111',
+          '000000']),
+    ]
+    for (wkts, expected) in tests:
+        got = rasterize_filler_burn(wkts, len(expected[0]), len(expected))
+        if got != expected:
+            gdaltest.post_reason('fail')
+            print(wkts)
+            print('\n'.join(got))
+            return 'fail'
+
+    return 'success'
+
+###############################################################################
+# Compare with the previous algorithm on pseudo-random polygons, with
+# vertices on integer coordinates, pixel centres or anywhere, partly out of
+# the raster, with holes and several parts.
+
+
+def rasterize_filler_4():
+
+    rng = random.Random(37)
+    xsize = 13
+    ysize = 11
+
+    def random_coord(vmax):
+        kind = rng.randint(0, 2)
+        if kind == 0:
+            return float(rng.randint(-2, vmax + 2))
+        if kind == 1:
+            return rng.randint(-2, vmax + 2) + 0.5
+        return round(rng.uniform(-2, vmax + 2), 3)
+
+    def random_ring():
+        npoints = rng.randint(3, 9)
+        points = []
+        for _ in range(npoints):
+            if points and rng.randint(0, 3) == 0:
+                # Horizontal edge.
+                points.append((random_coord(xsize), points[-1][1]))
+            elif points and rng.randint(0, 5) == 0:
+                # Vertical edge.
+                points.append((points[-1][0], random_coord(ysize)))
+            else:
+                points.append((random_coord(xsize), random_coord(ysize)))
+        points.append(points[0])
+        return points
+
+    for iter_count in range(1000):
+        polygons = []
+        for _ in range(rng.randint(1, 2)):
+            polygons.append([random_ring()
+                             for _ in range(rng.randint(1, 2))])
+
+        wkt = 'MULTIPOLYGON (%s)' % ','.join(
+            '(%s)' % ','.join(
+                '(%s)' % ','.join('%.17g %.17g' % p for p in ring)
+                for ring in polygon)
+            for polygon in polygons)
+        got = rasterize_filler_burn([wkt], xsize, ysize)
+
+        # The rasterizer collects the points of each ring in reverse order.
+        parts = [list(reversed(ring))
+                 for polygon in polygons for ring in polygon]
+        expected = rasterize_filler_reference(parts, xsize, ysize)
+
+        if got != expected:
+            gdaltest.post_reason('fail')
+            print(iter_count, wkt)
+            print('\n'.join(got))
+            print('')
+            print('\n'.join(expected))
+            return 'fail'
+
+    return 'success'
+
+
+gdaltest_list = [
+    rasterize_filler_1,
+    rasterize_filler_2,
+    rasterize_filler_3,
+    rasterize_filler_4]
+
+if __name__ == '__main__':
+
+    gdaltest.setup_run('rasterize_filler')
+
+    gdaltest.run_tests(gdaltest_list)
+
+    gdaltest.summarize()
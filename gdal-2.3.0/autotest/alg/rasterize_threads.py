@@ -0,0 +1,258 @@
+#!/usr/bin/env python
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  Test the NUM_THREADS option of the rasterization algorithms.
+#
+###############################################################################
+# Copyright (c) 2018, GDAL contributors
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+import random
+import sys
+
+sys.path.append('../pymod')
+
+from osgeo import gdal
+from osgeo import ogr
+
+import gdaltest
+
+###############################################################################
+# Create a memory layer with pseudo-random polygons, lines and points, in
+# the pixel/line coordinates of the rasters created by
+# rasterize_threads_create_raster().
+
+
+def rasterize_threads_create_layer():
+
+    random.seed(1234)
+
+    ds = gdal.GetDriverByName('Memory').Create('', 0, 0, 0, gdal.GDT_Unknown)
+    lyr = ds.CreateLayer('shapes')
+    lyr.CreateField(ogr.FieldDefn('val', ogr.OFTReal))
+
+    for i in range(300):
+        kind = i % 3
+        cx = random.uniform(-20, 220)
+        cy = random.uniform(20, 220)
+        if kind == 0:
+            npoints = random.randint(3, 12)
+            coords = ['%f %f' % (cx + random.uniform(0, 60),
+                                 cy - random.uniform(0, 60))
+                      for _ in range(npoints)]
+            wkt = 'POLYGON ((%s, %s))' % (', '.join(coords), coords[0])
+        elif kind == 1:
+            coords = ['%f %f' % (cx + random.uniform(-40, 40),
+                                 cy + random.uniform(-40, 40))
+                      for _ in range(4)]
+            wkt = 'LINESTRING (%s)' % ', '.join(coords)
+        else:
+            wkt = 'POINT (%f %f)' % (cx, cy)
+        feat = ogr.Feature(lyr.GetLayerDefn())
+        feat.SetField('val', i % 7 + 1)
+        feat.SetGeometryDirectly(ogr.CreateGeometryFromWkt(wkt))
+        lyr.CreateFeature(feat)
+
+    return (ds, lyr)
+
+###############################################################################
+
+
+def rasterize_threads_create_raster(nbands=1, datatype=gdal.GDT_Byte):
+
+    ds = gdal.GetDriverByName('MEM').Create('', 200, 200, nbands, datatype)
+    ds.SetGeoTransform([0, 1, 0, 200, 0, -1])
+    return ds
+
+###############################################################################
+# Rasterize a layer and return the checksums of the bands.
+
+
+def rasterize_threads_layer(lyr, options, nbands=1,
+                            datatype=gdal.GDT_Byte):
+
+    ds = rasterize_threads_create_raster(nbands, datatype)
+    bands = [i + 1 for i in range(nbands)]
+    if 'ATTRIBUTE=val' in options:
+        burn_values = []
+    else:
+        burn_values = [i + 10 for i in range(nbands)]
+    ret = gdal.RasterizeLayer(ds, bands, lyr, burn_values=burn_values,
+                              options=options)
+    if ret != 0:
+        return None
+    return [ds.GetRasterBand(i).Checksum() for i in bands]
+
+###############################################################################
+# The multithreaded strip mode gives the same result as the single threaded
+# mode with chunks of the strip height, which is 16 lines for a 200 lines
+# raster rendered in a single chunk.
+
+
+def rasterize_threads_1():
+
+    (_, lyr) = rasterize_threads_create_layer()
+
+    for (extra_options, nbands, datatype) in [
+            ([], 1, gdal.GDT_Byte),
+            (['ALL_TOUCHED=TRUE'], 1, gdal.GDT_Byte),
+            (['ATTRIBUTE=val'], 1, gdal.GDT_Byte),
+            (['MERGE_ALG=ADD'], 1, gdal.GDT_Float32),
+            (['MERGE_ALG=ADD', 'ATTRIBUTE=val'], 3, gdal.GDT_Float32)]:
+
+        ref_cs = rasterize_threads_layer(
+            lyr, extra_options + ['CHUNKYSIZE=16'], nbands, datatype)
+        if ref_cs is None:
+            gdaltest.post_reason('fail')
+            return 'fail'
+
+        for num_threads in ['2', '4']:
+            cs = rasterize_threads_layer(
+                lyr, extra_options + ['NUM_THREADS=' + num_threads],
+                nbands, datatype)
+            if cs != ref_cs:
+                gdaltest.post_reason('fail')
+                print(extra_options, num_threads, cs, ref_cs)
+                return 'fail'
+
+    return 'success'
+
+###############################################################################
+# Collect the debug messages emitted while running a function.
+
+
+def rasterize_threads_debug_messages(func):
+
+    messages = []
+
+    def handler(err_class, err_no, msg):
+        # pylint: disable=unused-argument
+        if err_class == gdal.CE_Debug:
+            messages.append(msg)
+
+    gdal.PushErrorHandler(handler)
+    old_debug = gdal.GetConfigOption('CPL_DEBUG')
+    gdal.SetConfigOption('CPL_DEBUG', 'ON')
+    func()
+    gdal.SetConfigOption('CPL_DEBUG', old_debug)
+    gdal.PopErrorHandler()
+
+    return messages
+
+###############################################################################
+# Worker threads are only used when the NUM_THREADS option asks for them.
+# The GDAL_NUM_THREADS configuration option is not taken into account.
+
+
+def rasterize_threads_2():
+
+    (_, lyr) = rasterize_threads_create_layer()
+
+    msg = 'GDAL: Rasterizer using 4 threads.'
+
+    messages = rasterize_threads_debug_messages(
+        lambda: rasterize_threads_layer(lyr, []))
+    if msg in messages:
+        gdaltest.post_reason('threads used by default')
+        return 'fail'
+
+    gdal.SetConfigOption('GDAL_NUM_THREADS', '4')
+    messages = rasterize_threads_debug_messages(
+        lambda: rasterize_threads_layer(lyr, []))
+    gdal.SetConfigOption('GDAL_NUM_THREADS', None)
+    if msg in messages:
+        gdaltest.post_reason('GDAL_NUM_THREADS should be ignored')
+        return 'fail'
+
+    messages = rasterize_threads_debug_messages(
+        lambda: rasterize_threads_layer(lyr, ['NUM_THREADS=4']))
+    if msg not in messages:
+        gdaltest.post_reason('NUM_THREADS=4 should use threads')
+        print(messages)
+        return 'fail'
+
+    for num_threads in ['0', '1']:
+        messages = rasterize_threads_debug_messages(
+            lambda: rasterize_threads_layer(
+                lyr, ['NUM_THREADS=' + num_threads]))
+        if [m for m in messages if m.startswith('GDAL: Rasterizer using')]:
+            gdaltest.post_reason('fail')
+            print(num_threads, messages)
+            return 'fail'
+
+    return 'success'
+
+###############################################################################
+# gdal_rasterize -num_threads, which goes through GDALRasterizeGeometries().
+
+
+def rasterize_threads_3():
+
+    (src_ds, _) = rasterize_threads_create_layer()
+
+    for extra_options in ['', '-at', '-add', '-a val']:
+        burn = '' if '-a ' in extra_options else '-burn 10'
+        ds = rasterize_threads_create_raster(1, gdal.GDT_Float32)
+        ret = gdal.Rasterize(ds, src_ds,
+                             options='%s %s -optim RASTER -chunkysize 16' %
+                             (burn, extra_options))
+        if ret != 1:
+            gdaltest.post_reason('fail')
+            return 'fail'
+        ref_cs = ds.GetRasterBand(1).Checksum()
+
+        ds = rasterize_threads_create_raster(1, gdal.GDT_Float32)
+        results = []
+        messages = rasterize_threads_debug_messages(
+            lambda: results.append(gdal.Rasterize(
+                ds, src_ds,
+                options='%s %s -optim RASTER -num_threads 4' %
+                (burn, extra_options))))
+        if results != [1]:
+            gdaltest.post_reason('fail')
+            return 'fail'
+        if 'GDAL: Rasterizer using 4 threads.' not in messages:
+            gdaltest.post_reason('threads not used')
+            print(messages)
+            return 'fail'
+        cs = ds.GetRasterBand(1).Checksum()
+        if cs != ref_cs:
+            gdaltest.post_reason('fail')
+            print(extra_options, cs, ref_cs)
+            return 'fail'
+
+    return 'success'
+
+
+gdaltest_list = [
+    rasterize_threads_1,
+    rasterize_threads_2,
+    rasterize_threads_3]
+
+if __name__ == '__main__':
+
+    gdaltest.setup_run('rasterize_threads')
+
+    gdaltest.run_tests(gdaltest_list)
+
+    gdaltest.summarize()
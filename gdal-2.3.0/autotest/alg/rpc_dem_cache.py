@@ -0,0 +1,231 @@
+#!/usr/bin/env python
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  Test that the RPC transformer gives the same results with
+#           the shared cache of DEM tiles (GDAL_RPC_DEM_CACHE_MAX) and
+#           without it.
+#
+###############################################################################
+# Copyright (c) 2018, GDAL contributors
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+import math
+import struct
+import sys
+
+sys.path.append('../pymod')
+
+from osgeo import gdal
+
+import gdaltest
+
+###############################################################################
+# Create a DEM in WGS84, spanning several 256x256 tiles of the cache, with
+# a nodata hole. The heights are offset by the given value.
+
+
+def rpc_dem_cache_create_dem(filename, offset):
+
+    xsize = 900
+    ysize = 800
+    ds = gdal.GetDriverByName('GTiff').Create(filename, xsize, ysize, 1,
+                                              gdal.GDT_Float32)
+    ds.SetGeoTransform([1.9, 0.001, 0, 49.7, 0, -0.001])
+    ds.SetProjection('GEOGCS["WGS 84",DATUM["WGS_1984",SPHEROID["WGS 84",'
+                     '6378137,298.257223563]],PRIMEM["Greenwich",0],'
+                     'UNIT["degree",0.0174532925199433],'
+                     'AUTHORITY["EPSG","4326"]]')
+    for j in range(ysize):
+        row = []
+        for i in range(xsize):
+            if (i - 450) ** 2 + (j - 500) ** 2 < 400:
+                row.append(-32768)
+            else:
+                row.append(offset + 200 * math.sin(i / 37.0) *
+                           math.cos(j / 23.0) + ((i * 7 + j * 13) % 17))
+        ds.WriteRaster(0, j, xsize, 1, struct.pack('f' * xsize, *row),
+                       buf_type=gdal.GDT_Float32)
+    ds.GetRasterBand(1).SetNoDataValue(-32768)
+    ds = None
+
+###############################################################################
+# Create an image with RPC whose line and sample depend on the height.
+
+
+def rpc_dem_cache_create_image():
+
+    ds = gdal.GetDriverByName('MEM').Create('', 700, 600)
+    zeros = ['0'] * 20
+    line_num = list(zeros)
+    line_num[2] = '-1'
+    line_num[3] = '0.05'
+    samp_num = list(zeros)
+    samp_num[1] = '1'
+    samp_num[3] = '0.05'
+    samp_num[4] = '0.01'
+    den = list(zeros)
+    den[0] = '1'
+    ds.SetMetadata({'LINE_OFF': '300', 'SAMP_OFF': '350',
+                    'LAT_OFF': '49.3', 'LONG_OFF': '2.35',
+                    'HEIGHT_OFF': '100',
+                    'LINE_SCALE': '300', 'SAMP_SCALE': '350',
+                    'LAT_SCALE': '0.3', 'LONG_SCALE': '0.35',
+                    'HEIGHT_SCALE': '500',
+                    'LINE_NUM_COEFF': ' '.join(line_num),
+                    'LINE_DEN_COEFF': ' '.join(den),
+                    'SAMP_NUM_COEFF': ' '.join(samp_num),
+                    'SAMP_DEN_COEFF': ' '.join(den)}, 'RPC')
+    return ds
+
+###############################################################################
+# Create a RPC transformer using the DEM, with the given size of the DEM
+# cache.
+
+
+def rpc_dem_cache_transformer(ds, dem, interpolation, cache_max):
+
+    gdal.SetConfigOption('GDAL_RPC_DEM_CACHE_MAX', cache_max)
+    tr = gdal.Transformer(ds, None,
+                          ['METHOD=RPC', 'RPC_DEM=' + dem,
+                           'RPC_DEMINTERPOLATION=' + interpolation])
+    gdal.SetConfigOption('GDAL_RPC_DEM_CACHE_MAX', None)
+    return tr
+
+###############################################################################
+# Transform pixel/line points to long/lat, and long/lat points to
+# pixel/line.
+
+
+def rpc_dem_cache_transform(tr):
+
+    pixels = []
+    for j in range(0, 600, 7):
+        for i in range(0, 700, 11):
+            pixels.append((i + 0.5, j + 0.5, 0))
+    lonlats = []
+    for k in range(3000):
+        lonlats.append((2.0 + 0.7 * ((k * 7919) % 10007) / 10007.0,
+                        49.0 + 0.6 * ((k * 104729) % 9973) / 9973.0, 0))
+
+    return (tr.TransformPoints(0, pixels), tr.TransformPoints(1, lonlats))
+
+###############################################################################
+# The results are the same without the cache, with the default cache, and
+# with a cache too small for the DEM, for each DEM interpolation.
+
+
+def rpc_dem_cache_1():
+
+    rpc_dem_cache_create_dem('/vsimem/rpc_dem_cache.tif', 0)
+    ds = rpc_dem_cache_create_image()
+
+    for interpolation in ['near', 'bilinear', 'cubic']:
+        tr = rpc_dem_cache_transformer(ds, '/vsimem/rpc_dem_cache.tif',
+                                       interpolation, '0')
+        ref = rpc_dem_cache_transform(tr)
+        tr = None
+        if len([1 for success in ref[0][1] if success]) < 1000 or \
+           len([1 for success in ref[1][1] if success]) < 1000:
+            gdaltest.post_reason('too few points transformed')
+            return 'fail'
+
+        for cache_max in [None, '1']:
+            tr = rpc_dem_cache_transformer(ds, '/vsimem/rpc_dem_cache.tif',
+                                           interpolation, cache_max)
+            got = rpc_dem_cache_transform(tr)
+            tr = None
+            if got != ref:
+                gdaltest.post_reason('results differ')
+                print(interpolation, cache_max)
+                return 'fail'
+
+    return 'success'
+
+###############################################################################
+# Transformers sharing the cached tiles of a DEM give the same results as a
+# single one, and a DEM rewritten once they are all destroyed is read again.
+
+
+def rpc_dem_cache_2():
+
+    ds = rpc_dem_cache_create_image()
+
+    tr = rpc_dem_cache_transformer(ds, '/vsimem/rpc_dem_cache.tif',
+                                   'bilinear', None)
+    ref = rpc_dem_cache_transform(tr)
+    tr2 = rpc_dem_cache_transformer(ds, '/vsimem/rpc_dem_cache.tif',
+                                    'bilinear', None)
+    tr3 = rpc_dem_cache_transformer(ds, '/vsimem/rpc_dem_cache.tif',
+                                    'bilinear', '1')
+    for t in [tr2, tr3, tr]:
+        if rpc_dem_cache_transform(t) != ref:
+            gdaltest.post_reason('results differ')
+            return 'fail'
+    t = None
+    tr = None
+    tr2 = None
+    tr3 = None
+
+    gdal.Unlink('/vsimem/rpc_dem_cache.tif')
+    rpc_dem_cache_create_dem('/vsimem/rpc_dem_cache.tif', 300)
+
+    tr = rpc_dem_cache_transformer(ds, '/vsimem/rpc_dem_cache.tif',
+                                   'bilinear', '0')
+    ref_new_dem = rpc_dem_cache_transform(tr)
+    tr = None
+    if ref_new_dem == ref:
+        gdaltest.post_reason('the DEM should change the results')
+        return 'fail'
+
+    tr = rpc_dem_cache_transformer(ds, '/vsimem/rpc_dem_cache.tif',
+                                   'bilinear', None)
+    if rpc_dem_cache_transform(tr) != ref_new_dem:
+        gdaltest.post_reason('stale DEM tiles used')
+        return 'fail'
+    tr = None
+
+    return 'success'
+
+###############################################################################
+# Cleanup
+
+
+def rpc_dem_cache_cleanup():
+
+    gdal.Unlink('/vsimem/rpc_dem_cache.tif')
+
+    return 'success'
+
+
+gdaltest_list = [
+    rpc_dem_cache_1,
+    rpc_dem_cache_2,
+    rpc_dem_cache_cleanup]
+
+if __name__ == '__main__':
+
+    gdaltest.setup_run('rpc_dem_cache')
+
+    gdaltest.run_tests(gdaltest_list)
+
+    gdaltest.summarize()
@@ -0,0 +1,176 @@
+#!/usr/bin/env python
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  Test the thin plate spline transformer with many GCPs: the
+#           blocked LU solve with several threads, and the approximate
+#           evaluation enabled with TPS_MAX_ERROR_IN_PIXEL.
+#
+###############################################################################
+# Copyright (c) 2018, GDAL contributors
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+import sys
+
+sys.path.append('../pymod')
+
+from osgeo import gdal
+
+import gdaltest
+
+###############################################################################
+# Create a 1000x1000 dataset with count GCPs, spread with a simple
+# congruential generator, and a smooth mapping plus some noise so that the
+# spline does not reduce to an affine transformation.
+
+
+def tps_solve_create_dataset(count):
+
+    gcps = []
+    seed = 12345
+    for i in range(count):
+        seed = (seed * 1103515245 + 12345) % 2147483648
+        pixel = 1000.0 * seed / 2147483648.0
+        seed = (seed * 1103515245 + 12345) % 2147483648
+        line = 1000.0 * seed / 2147483648.0
+        seed = (seed * 1103515245 + 12345) % 2147483648
+        noise = (seed / 2147483648.0 - 0.5) * 0.002
+        x = 2 + 0.001 * pixel + 1e-7 * pixel * line + noise
+        y = 49 - 0.001 * line + 2e-8 * pixel * pixel - noise
+        gcps.append(gdal.GCP(x, y, 0, pixel, line, '', str(i)))
+
+    ds = gdal.GetDriverByName('MEM').Create('', 1000, 1000)
+    ds.SetGCPs(gcps, 'GEOGCS["WGS 84",DATUM["WGS_1984",SPHEROID["WGS 84",'
+                     '6378137,298.257223563]],PRIMEM["Greenwich",0],'
+                     'UNIT["degree",0.0174532925199433]]')
+    return ds
+
+###############################################################################
+# Evaluation points: the GCPs, and points spread over the raster.
+
+
+def tps_solve_points(ds):
+
+    pixels = []
+    georefs = []
+    for gcp in ds.GetGCPs():
+        pixels.append((gcp.GCPPixel, gcp.GCPLine, 0))
+        georefs.append((gcp.GCPX, gcp.GCPY, 0))
+    for k in range(3000):
+        pixel = 1000.0 * ((k * 7919) % 10007) / 10007.0
+        line = 1000.0 * ((k * 104729) % 9973) / 9973.0
+        pixels.append((pixel, line, 0))
+        georefs.append((2 + 0.001 * pixel, 49 - 0.001 * line, 0))
+    return (pixels, georefs)
+
+###############################################################################
+# The spline interpolates the GCPs in both directions, and gives the same
+# results with several threads as with one.
+
+
+def tps_solve_1():
+
+    ds = tps_solve_create_dataset(1500)
+    (pixels, georefs) = tps_solve_points(ds)
+    gcps = ds.GetGCPs()
+
+    ref = None
+    for options in [[], ['NUM_THREADS=4']]:
+        tr = gdal.Transformer(ds, None, ['METHOD=GCP_TPS'] + options)
+        if tr is None:
+            gdaltest.post_reason('fail')
+            return 'fail'
+        got = (tr.TransformPoints(0, pixels), tr.TransformPoints(1, georefs))
+        tr = None
+
+        if ref is None:
+            ref = got
+            for (i, gcp) in enumerate(gcps):
+                (x, y, _) = got[0][0][i]
+                if abs(x - gcp.GCPX) > 1e-9 or abs(y - gcp.GCPY) > 1e-9:
+                    gdaltest.post_reason('GCP not interpolated')
+                    print(i, x, y, gcp.GCPX, gcp.GCPY)
+                    return 'fail'
+                (pixel, line, _) = got[1][0][i]
+                if abs(pixel - gcp.GCPPixel) > 1e-6 or \
+                   abs(line - gcp.GCPLine) > 1e-6:
+                    gdaltest.post_reason('GCP not interpolated')
+                    print(i, pixel, line, gcp.GCPPixel, gcp.GCPLine)
+                    return 'fail'
+        elif got != ref:
+            gdaltest.post_reason('results differ with threads')
+            print(options)
+            return 'fail'
+
+    return 'success'
+
+###############################################################################
+# With TPS_MAX_ERROR_IN_PIXEL, the approximate evaluation stays within the
+# threshold of the exact one, expressed in pixels.
+
+
+def tps_solve_2():
+
+    ds = tps_solve_create_dataset(3000)
+    (pixels, georefs) = tps_solve_points(ds)
+
+    tr = gdal.Transformer(ds, None, ['METHOD=GCP_TPS'])
+    ref = (tr.TransformPoints(0, pixels), tr.TransformPoints(1, georefs))
+    tr = None
+
+    for max_error in [0.01, 0.5]:
+        tr = gdal.Transformer(ds, None, [
+            'METHOD=GCP_TPS', 'TPS_MAX_ERROR_IN_PIXEL=%g' % max_error])
+        got = (tr.TransformPoints(0, pixels), tr.TransformPoints(1, georefs))
+        tr = None
+
+        # Pixel/line to georef, with a pixel size of at most 0.0011 degree.
+        for (a, b) in zip(ref[0][0], got[0][0]):
+            if abs(a[0] - b[0]) > max_error * 0.0011 or \
+               abs(a[1] - b[1]) > max_error * 0.0011:
+                gdaltest.post_reason('error above the threshold')
+                print(max_error, a, b)
+                return 'fail'
+        # Georef to pixel/line.
+        for (a, b) in zip(ref[1][0], got[1][0]):
+            if abs(a[0] - b[0]) > max_error or abs(a[1] - b[1]) > max_error:
+                gdaltest.post_reason('error above the threshold')
+                print(max_error, a, b)
+                return 'fail'
+        if got[0][1] != ref[0][1] or got[1][1] != ref[1][1]:
+            gdaltest.post_reason('success flags differ')
+            return 'fail'
+
+    return 'success'
+
+
+gdaltest_list = [
+    tps_solve_1,
+    tps_solve_2]
+
+if __name__ == '__main__':
+
+    gdaltest.setup_run('tps_solve')
+
+    gdaltest.run_tests(gdaltest_list)
+
+    gdaltest.summarize()
@@ -0,0 +1,143 @@
+#!/usr/bin/env python
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  Test that the bilinear and cubic warp kernels give the same
+#           output whether destination pixels are processed 4 at a time
+#           or one at a time.
+#
+###############################################################################
+# Copyright (c) 2018, GDAL contributors
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+import random
+import struct
+import sys
+
+sys.path.append('../pymod')
+
+from osgeo import gdal
+
+import gdaltest
+
+# Source of 40x30 pixels of size 1, and destination pixels of size 0.625,
+# so that the 4-sample kernels are used. All coordinates are dyadic
+# fractions, so a destination pixel gets the same source coordinates
+# whatever the extent of the warp it belongs to.
+warp_kernel_batch_src_size = (40, 30)
+warp_kernel_batch_origin = (100.0, 200.0)
+warp_kernel_batch_res = 0.625
+warp_kernel_batch_dst_bounds = (99.6875, 180.3125, 140.3125, 200.3125)
+
+###############################################################################
+# Create a 3-band source of the given data type, with values spanning the
+# range of the type, so that cubic overshoots are clamped.
+
+
+def warp_kernel_batch_create_source(datatype):
+
+    (xsize, ysize) = warp_kernel_batch_src_size
+    ds = gdal.GetDriverByName('MEM').Create('', xsize, ysize, 3, datatype)
+    ds.SetGeoTransform([warp_kernel_batch_origin[0], 1, 0,
+                        warp_kernel_batch_origin[1], 0, -1])
+    rng = random.Random(datatype)
+    for i in range(3):
+        if datatype == gdal.GDT_Byte:
+            data = struct.pack('B' * xsize * ysize,
+                               *[rng.randint(0, 255)
+                                 for _ in range(xsize * ysize)])
+        elif datatype == gdal.GDT_Int16:
+            data = struct.pack('h' * xsize * ysize,
+                               *[rng.randint(-32768, 32767)
+                                 for _ in range(xsize * ysize)])
+        elif datatype == gdal.GDT_UInt16:
+            data = struct.pack('H' * xsize * ysize,
+                               *[rng.randint(0, 65535)
+                                 for _ in range(xsize * ysize)])
+        else:
+            data = struct.pack('f' * xsize * ysize,
+                               *[rng.uniform(-1e6, 1e6)
+                                 for _ in range(xsize * ysize)])
+        ds.GetRasterBand(i + 1).WriteRaster(0, 0, xsize, ysize, data)
+    return ds
+
+###############################################################################
+# Warp the source to the given bounds, without approximating the transformer,
+# and return the raw bytes of each band.
+
+
+def warp_kernel_batch_warp(src_ds, bounds, resample_alg):
+
+    ds = gdal.Warp('', src_ds, format='MEM', outputBounds=bounds,
+                   xRes=warp_kernel_batch_res, yRes=warp_kernel_batch_res,
+                   resampleAlg=resample_alg, errorThreshold=0)
+    return [ds.GetRasterBand(i + 1).ReadRaster() for i in range(3)]
+
+###############################################################################
+# Warp the whole destination at once, where chunks of 4 pixels are processed
+# together, and column by column, where every pixel goes through the
+# per-pixel code, and compare.
+
+
+def warp_kernel_batch_1():
+
+    (minx, miny, maxx, maxy) = warp_kernel_batch_dst_bounds
+    res = warp_kernel_batch_res
+    ncols = int((maxx - minx) / res + 0.5)
+
+    for datatype in [gdal.GDT_Byte, gdal.GDT_Int16, gdal.GDT_UInt16,
+                     gdal.GDT_Float32]:
+        src_ds = warp_kernel_batch_create_source(datatype)
+        pixel_size = gdal.GetDataTypeSize(datatype) // 8
+        for resample_alg in ['bilinear', 'cubic']:
+            ref = warp_kernel_batch_warp(src_ds, warp_kernel_batch_dst_bounds,
+                                         resample_alg)
+            nrows = len(ref[0]) // (ncols * pixel_size)
+            for col in range(ncols):
+                got = warp_kernel_batch_warp(
+                    src_ds,
+                    (minx + col * res, miny, minx + (col + 1) * res, maxy),
+                    resample_alg)
+                for i in range(3):
+                    expected = b''.join(
+                        ref[i][(row * ncols + col) * pixel_size:
+                               (row * ncols + col + 1) * pixel_size]
+                        for row in range(nrows))
+                    if got[i] != expected:
+                        gdaltest.post_reason('results differ')
+                        print(gdal.GetDataTypeName(datatype), resample_alg,
+                              col, i + 1)
+                        return 'fail'
+
+    return 'success'
+
+
+gdaltest_list = [
+    warp_kernel_batch_1]
+
+if __name__ == '__main__':
+
+    gdaltest.setup_run('warp_kernel_batch')
+
+    gdaltest.run_tests(gdaltest_list)
+
+    gdaltest.summarize()
@@ -0,0 +1,281 @@
+#!/usr/bin/env python
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  Test that DEFLATE strips and tiles, and the CPLZLib helpers,
+#           interoperate with zlib, whether GDAL is built with libdeflate
+#           or not.
+#
+###############################################################################
+# Copyright (c) 2018, GDAL contributors
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+import binascii
+import struct
+import sys
+import zlib
+
+sys.path.append('../pymod')
+
+from osgeo import gdal
+from osgeo import ogr
+
+import gdaltest
+
+###############################################################################
+# Single band UInt16 data of xsize x ysize pixels, with smooth areas and
+# noise, as a list of rows of bytes.
+
+
+def tiff_deflate_rows(xsize, ysize):
+
+    rows = []
+    state = 12345
+    for y in range(ysize):
+        values = []
+        for x in range(xsize):
+            if (x // 8 + y // 8) % 3 == 0:
+                state = (state * 1103515245 + 12345) % 2147483648
+                values.append(state % 65536)
+            else:
+                values.append((x * 37 + y * 11) % 4096)
+        rows.append(struct.pack('<' + 'H' * xsize, *values))
+    return rows
+
+###############################################################################
+# Build a little endian tiled TIFF whose tiles are compressed with zlib by
+# the given compressor factory.
+
+
+def tiff_deflate_build_tiff(xsize, ysize, tile_size, rows, compressor):
+
+    tiles_across = (xsize + tile_size - 1) // tile_size
+    tiles_down = (ysize + tile_size - 1) // tile_size
+    tiles = []
+    for ty in range(tiles_down):
+        for tx in range(tiles_across):
+            data = b''
+            for y in range(ty * tile_size, (ty + 1) * tile_size):
+                row = rows[y] if y < ysize else b''
+                chunk = row[tx * tile_size * 2:(tx + 1) * tile_size * 2]
+                data += chunk + b'\0' * (tile_size * 2 - len(chunk))
+            c = compressor()
+            tiles.append(c.compress(data) + c.flush())
+
+    ntiles = len(tiles)
+    nentries = 12
+    ifd_offset = 8
+    ifd_size = 2 + nentries * 12 + 4
+    offsets_offset = ifd_offset + ifd_size
+    counts_offset = offsets_offset + 4 * ntiles
+    data_offset = counts_offset + 4 * ntiles
+    tile_offsets = []
+    offset = data_offset
+    for t in tiles:
+        tile_offsets.append(offset)
+        offset += len(t)
+
+    def entry(tag, typ, count, value):
+        if typ == 3 and count == 1:
+            return struct.pack('<HHIHH', tag, typ, count, value, 0)
+        return struct.pack('<HHII', tag, typ, count, value)
+
+    if ntiles == 1:
+        offsets_entry = entry(324, 4, 1, tile_offsets[0])
+        counts_entry = entry(325, 4, 1, len(tiles[0]))
+    else:
+        offsets_entry = entry(324, 4, ntiles, offsets_offset)
+        counts_entry = entry(325, 4, ntiles, counts_offset)
+
+    ifd = struct.pack('<H', nentries) + \
+        entry(256, 4, 1, xsize) + \
+        entry(257, 4, 1, ysize) + \
+        entry(258, 3, 1, 16) + \
+        entry(259, 3, 1, 8) + \
+        entry(262, 3, 1, 1) + \
+        entry(277, 3, 1, 1) + \
+        entry(284, 3, 1, 1) + \
+        entry(322, 3, 1, tile_size) + \
+        entry(323, 3, 1, tile_size) + \
+        offsets_entry + \
+        counts_entry + \
+        entry(339, 3, 1, 1) + \
+        struct.pack('<I', 0)
+
+    return b'II*\0' + struct.pack('<I', ifd_offset) + ifd + \
+        struct.pack('<' + 'I' * ntiles, *tile_offsets) + \
+        struct.pack('<' + 'I' * ntiles, *[len(t) for t in tiles]) + \
+        b''.join(tiles)
+
+###############################################################################
+# Tiles compressed by zlib with all levels and strategies are decoded.
+
+
+def tiff_deflate_1():
+
+    (xsize, ysize) = (75, 50)
+    rows = tiff_deflate_rows(xsize, ysize)
+    expected = b''.join(rows)
+    filename = '/vsimem/tiff_deflate_1.tif'
+
+    compressors = []
+    for level in range(10):
+        compressors.append(
+            ('level %d' % level,
+             lambda level=level: zlib.compressobj(level)))
+    for (name, strategy) in [('huffman only', zlib.Z_HUFFMAN_ONLY),
+                             ('rle', zlib.Z_RLE),
+                             ('fixed', zlib.Z_FIXED),
+                             ('filtered', zlib.Z_FILTERED)]:
+        compressors.append(
+            (name, lambda strategy=strategy: zlib.compressobj(
+                6, zlib.DEFLATED, 15, 8, strategy)))
+    compressors.append(
+        ('small window', lambda: zlib.compressobj(9, zlib.DEFLATED, 9)))
+
+    for tile_size in (16, 64, 128):
+        for (name, compressor) in compressors:
+            gdal.FileFromMemBuffer(
+                filename,
+                tiff_deflate_build_tiff(xsize, ysize, tile_size, rows,
+                                        compressor))
+            ds = gdal.Open(filename)
+            got = ds.GetRasterBand(1).ReadRaster()
+            ds = None
+            gdal.Unlink(filename)
+            if got != expected:
+                gdaltest.post_reason('data differs')
+                print(tile_size, name)
+                return 'fail'
+
+    return 'success'
+
+###############################################################################
+# Strips and tiles written by GDAL at several levels are valid zlib streams,
+# and are read back unchanged.
+
+
+def tiff_deflate_2():
+
+    (xsize, ysize) = (75, 50)
+    rows = tiff_deflate_rows(xsize, ysize)
+    expected = b''.join(rows)
+    src_ds = gdal.GetDriverByName('MEM').Create('', xsize, ysize, 1,
+                                                gdal.GDT_UInt16)
+    src_ds.GetRasterBand(1).WriteRaster(0, 0, xsize, ysize, expected)
+    filename = '/vsimem/tiff_deflate_2.tif'
+
+    for level in (1, 6, 9):
+        for layout in [['BLOCKYSIZE=7'],
+                       ['TILED=YES', 'BLOCKXSIZE=32', 'BLOCKYSIZE=16']]:
+            gdal.GetDriverByName('GTiff').CreateCopy(
+                filename, src_ds,
+                options=['COMPRESS=DEFLATE', 'ZLEVEL=%d' % level] + layout)
+            ds = gdal.Open(filename)
+            band = ds.GetRasterBand(1)
+            (block_xsize, block_ysize) = band.GetBlockSize()
+            for by in range((ysize + block_ysize - 1) // block_ysize):
+                for bx in range((xsize + block_xsize - 1) // block_xsize):
+                    offset = int(band.GetMetadataItem(
+                        'BLOCK_OFFSET_%d_%d' % (bx, by), 'TIFF'))
+                    size = int(band.GetMetadataItem(
+                        'BLOCK_SIZE_%d_%d' % (bx, by), 'TIFF'))
+                    f = gdal.VSIFOpenL(filename, 'rb')
+                    gdal.VSIFSeekL(f, offset, 0)
+                    data = zlib.decompress(gdal.VSIFReadL(1, size, f))
+                    gdal.VSIFCloseL(f)
+                    for y in range(by * block_ysize,
+                                   min(ysize, (by + 1) * block_ysize)):
+                        start = (y - by * block_ysize) * block_xsize * 2
+                        width = min(xsize - bx * block_xsize, block_xsize)
+                        if data[start:start + width * 2] != \
+                           rows[y][bx * block_xsize * 2:
+                                   (bx * block_xsize + width) * 2]:
+                            gdaltest.post_reason('block content differs')
+                            print(level, layout, bx, by, y)
+                            return 'fail'
+            got = band.ReadRaster()
+            ds = None
+            gdal.Unlink(filename)
+            if got != expected:
+                gdaltest.post_reason('data differs')
+                print(level, layout)
+                return 'fail'
+
+    return 'success'
+
+###############################################################################
+# CPLZLibDeflate() and CPLZLibInflate(), through the ogr_deflate() and
+# ogr_inflate() functions of the SQLite dialect.
+
+
+def tiff_deflate_3():
+
+    if ogr.GetDriverByName('SQLite') is None:
+        return 'skip'
+
+    data = b''.join(tiff_deflate_rows(75, 50))
+    ds = ogr.GetDriverByName('Memory').CreateDataSource('')
+
+    def sql_hex(sql):
+        lyr = ds.ExecuteSQL(sql, dialect='SQLite')
+        f = lyr.GetNextFeature()
+        value = f.GetField(0)
+        ds.ReleaseResultSet(lyr)
+        return value
+
+    hex_data = binascii.hexlify(data).decode('ascii')
+    for level in (None, 1, 6, 9):
+        if level is None:
+            sql = "SELECT hex(ogr_deflate(x'%s'))" % hex_data
+        else:
+            sql = "SELECT hex(ogr_deflate(x'%s', %d))" % (hex_data, level)
+        compressed = binascii.unhexlify(sql_hex(sql))
+        if zlib.decompress(compressed) != data:
+            gdaltest.post_reason('ogr_deflate() output differs')
+            print(level)
+            return 'fail'
+
+    for level in range(10):
+        compressed = zlib.compress(data, level)
+        got = sql_hex("SELECT hex(ogr_inflate(x'%s'))" %
+                      binascii.hexlify(compressed).decode('ascii'))
+        if binascii.unhexlify(got) != data:
+            gdaltest.post_reason('ogr_inflate() output differs')
+            print(level)
+            return 'fail'
+
+    return 'success'
+
+
+gdaltest_list = [
+    tiff_deflate_1,
+    tiff_deflate_2,
+    tiff_deflate_3]
+
+if __name__ == '__main__':
+
+    gdaltest.setup_run('tiff_deflate')
+
+    gdaltest.run_tests(gdaltest_list)
+
+    gdaltest.summarize()
@@ -0,0 +1,209 @@
+#!/usr/bin/env python
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  Test that GeoTIFF files written with the horizontal and
+#           floating-point predictors are read back bit-identical.
+#
+###############################################################################
+# Copyright (c) 2018, GDAL contributors
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+import struct
+import sys
+
+sys.path.append('../pymod')
+
+from osgeo import gdal
+
+import gdaltest
+
+# Widths that are not a multiple of the 16 byte vectors of the predictor
+# code, so that the scalar remainders are exercised too.
+tiff_predictor_widths = [1, 3, 7, 17, 33, 101]
+
+tiff_predictor_band_counts = [1, 2, 3, 4, 5, 8]
+
+###############################################################################
+# Values of the given data type, mixing small steps and large jumps so that
+# the differences wrap around, and for floating-point types, special values.
+
+
+def tiff_predictor_values(datatype, count, seed):
+
+    state = [seed * 2654435761 % 4294967296]
+
+    def rand32():
+        state[0] = (state[0] * 1103515245 + 12345) % 4294967296
+        return state[0]
+
+    values = []
+    if datatype == gdal.GDT_Byte:
+        fmt = 'B'
+        for i in range(count):
+            values.append((i * 3 + rand32() % 7) % 256 if i % 5
+                          else rand32() % 256)
+    elif datatype == gdal.GDT_UInt16:
+        fmt = 'H'
+        for i in range(count):
+            values.append((i * 257 + rand32() % 11) % 65536 if i % 5
+                          else rand32() % 65536)
+    elif datatype == gdal.GDT_Int16:
+        fmt = 'h'
+        for i in range(count):
+            values.append(rand32() % 65536 - 32768)
+    elif datatype == gdal.GDT_UInt32:
+        fmt = 'I'
+        for i in range(count):
+            values.append((i * 65537 + rand32() % 13) % 4294967296 if i % 5
+                          else rand32())
+    elif datatype == gdal.GDT_Int32:
+        fmt = 'i'
+        for i in range(count):
+            values.append(rand32() - 2147483648)
+    else:
+        fmt = 'f' if datatype == gdal.GDT_Float32 else 'd'
+        specials = [0.0, -0.0, 1e-40, -1e-310, float('inf'), float('-inf'),
+                    1e30, -3.5, 65504.0]
+        for i in range(count):
+            if i % 7 == 3:
+                values.append(specials[rand32() % len(specials)])
+            else:
+                values.append(i * 0.125 + (rand32() % 1000) / 1000.0)
+    return struct.pack(fmt * count, *values)
+
+###############################################################################
+# Return the value of the Predictor tag of the first IFD of a little endian
+# classic TIFF file.
+
+
+def tiff_predictor_get_tag(filename):
+
+    f = gdal.VSIFOpenL(filename, 'rb')
+    data = gdal.VSIFReadL(1, 1000000, f)
+    gdal.VSIFCloseL(f)
+    ifd_offset = struct.unpack('<I', data[4:8])[0]
+    nentries = struct.unpack('<H', data[ifd_offset:ifd_offset + 2])[0]
+    for i in range(nentries):
+        entry = data[ifd_offset + 2 + 12 * i:ifd_offset + 14 + 12 * i]
+        (tag, _, _, value) = struct.unpack('<HHIH', entry[0:10])
+        if tag == 317:
+            return value
+    return None
+
+###############################################################################
+# Write a file with the given predictor and creation options, read it back,
+# and compare the raw bytes of each band.
+
+
+def tiff_predictor_check(datatype, predictor, width, band_count, options):
+
+    height = 3
+    filename = '/vsimem/tiff_predictor.tif'
+    src_ds = gdal.GetDriverByName('MEM').Create('', width, height,
+                                                band_count, datatype)
+    data = []
+    for i in range(band_count):
+        data.append(tiff_predictor_values(datatype, width * height,
+                                          width * 100 + band_count * 10 + i))
+        src_ds.GetRasterBand(i + 1).WriteRaster(0, 0, width, height, data[i])
+
+    gdal.GetDriverByName('GTiff').CreateCopy(
+        filename, src_ds,
+        options=['PREDICTOR=%d' % predictor] + options)
+    src_ds = None
+    if tiff_predictor_get_tag(filename) != predictor:
+        gdaltest.post_reason('predictor not set')
+        gdal.Unlink(filename)
+        return False
+
+    ds = gdal.Open(filename)
+    ret = True
+    for i in range(band_count):
+        got = ds.GetRasterBand(i + 1).ReadRaster(0, 0, width, height)
+        if got != data[i]:
+            gdaltest.post_reason('data differs')
+            print(gdal.GetDataTypeName(datatype), predictor, width,
+                  band_count, options, i + 1)
+            ret = False
+            break
+    ds = None
+    gdal.Unlink(filename)
+    return ret
+
+###############################################################################
+# PREDICTOR=2 on integer data types, pixel and band interleaved, stripped and
+# tiled.
+
+
+def tiff_predictor_1():
+
+    for datatype in [gdal.GDT_Byte, gdal.GDT_UInt16, gdal.GDT_Int16,
+                     gdal.GDT_UInt32, gdal.GDT_Int32]:
+        for width in tiff_predictor_widths:
+            for band_count in tiff_predictor_band_counts:
+                for options in [['COMPRESS=DEFLATE', 'INTERLEAVE=PIXEL'],
+                                ['COMPRESS=LZW', 'INTERLEAVE=BAND']]:
+                    if not tiff_predictor_check(datatype, 2, width,
+                                                band_count, options):
+                        return 'fail'
+            if not tiff_predictor_check(datatype, 2, width, 3,
+                                        ['COMPRESS=DEFLATE', 'TILED=YES',
+                                         'BLOCKXSIZE=16', 'BLOCKYSIZE=16']):
+                return 'fail'
+
+    return 'success'
+
+###############################################################################
+# PREDICTOR=3 on floating-point data types, including signed zeros,
+# denormals and infinities.
+
+
+def tiff_predictor_2():
+
+    for datatype in [gdal.GDT_Float32, gdal.GDT_Float64]:
+        for width in tiff_predictor_widths:
+            for band_count in tiff_predictor_band_counts:
+                for options in [['COMPRESS=DEFLATE', 'INTERLEAVE=PIXEL'],
+                                ['COMPRESS=LZW', 'INTERLEAVE=BAND']]:
+                    if not tiff_predictor_check(datatype, 3, width,
+                                                band_count, options):
+                        return 'fail'
+            if not tiff_predictor_check(datatype, 3, width, 3,
+                                        ['COMPRESS=DEFLATE', 'TILED=YES',
+                                         'BLOCKXSIZE=16', 'BLOCKYSIZE=16']):
+                return 'fail'
+
+    return 'success'
+
+
+gdaltest_list = [
+    tiff_predictor_1,
+    tiff_predictor_2]
+
+if __name__ == '__main__':
+
+    gdaltest.setup_run('tiff_predictor')
+
+    gdaltest.run_tests(gdaltest_list)
+
+    gdaltest.summarize()
@@ -0,0 +1,189 @@
+#!/usr/bin/env python
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  Test multi-threaded decompression of GeoTIFF blocks.
+#
+###############################################################################
+# Copyright (c) 2018, GDAL contributors
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+import struct
+import sys
+
+sys.path.append('../pymod')
+
+from osgeo import gdal
+
+import gdaltest
+
+###############################################################################
+# Create a DEFLATE compressed tiled file, with 3 bands.
+
+
+def tiff_read_multithread_create(filename, options):
+
+    src_ds = gdal.GetDriverByName('MEM').Create('', 100, 70, 3)
+    for i in range(3):
+        data = b''.join(struct.pack('B' * 100,
+                                    *[(x * (i + 1) + 7 * y) % 256
+                                      for x in range(100)])
+                        for y in range(70))
+        src_ds.GetRasterBand(i + 1).WriteRaster(0, 0, 100, 70, data)
+    gdal.GetDriverByName('GTiff').CreateCopy(
+        filename, src_ds,
+        options=['TILED=YES', 'BLOCKXSIZE=16', 'BLOCKYSIZE=16',
+                 'COMPRESS=DEFLATE'] + options)
+    return [src_ds.GetRasterBand(i + 1).Checksum() for i in range(3)]
+
+###############################################################################
+# Open a file, and collect the GTiff debug messages emitted by the open
+# and by a first RasterIO() request.
+
+
+def tiff_read_multithread_open_and_read(filename, open_options, window):
+
+    open_messages = []
+    read_messages = []
+    messages = [open_messages]
+
+    def handler(err_class, err_no, msg):
+        # pylint: disable=unused-argument
+        if err_class == gdal.CE_Debug and msg.startswith('GTiff: '):
+            messages[0].append(msg)
+
+    gdal.PushErrorHandler(handler)
+    old_debug = gdal.GetConfigOption('CPL_DEBUG')
+    gdal.SetConfigOption('CPL_DEBUG', 'ON')
+    ds = gdal.OpenEx(filename, open_options=open_options)
+    messages[0] = read_messages
+    ds.ReadRaster(*window)
+    gdal.SetConfigOption('CPL_DEBUG', old_debug)
+    gdal.PopErrorHandler()
+
+    return (ds, open_messages, read_messages)
+
+###############################################################################
+# Parallel decoding gives the same result as sequential reading, with
+# pixel and band interleaving.
+
+
+def tiff_read_multithread_1():
+
+    for interleave in ['PIXEL', 'BAND']:
+        filename = '/vsimem/tiff_read_multithread_1.tif'
+        ref_cs = tiff_read_multithread_create(filename,
+                                              ['INTERLEAVE=' + interleave])
+
+        ds = gdal.OpenEx(filename, open_options=['NUM_THREADS=4'])
+        cs = [ds.GetRasterBand(i + 1).Checksum() for i in range(3)]
+        if cs != ref_cs:
+            gdaltest.post_reason('fail')
+            print(interleave, cs, ref_cs)
+            return 'fail'
+
+        ref_ds = gdal.Open(filename)
+        for window in [(0, 0, 100, 70), (5, 7, 60, 41), (17, 3, 80, 66, 40, 33)]:
+            ds = gdal.OpenEx(filename, open_options=['NUM_THREADS=4'])
+            data = ds.ReadRaster(*window)
+            ref_data = ref_ds.ReadRaster(*window)
+            if data != ref_data:
+                gdaltest.post_reason('fail')
+                print(interleave, window)
+                return 'fail'
+            for i in range(3):
+                data = ds.GetRasterBand(i + 1).ReadRaster(*window)
+                ref_data = ref_ds.GetRasterBand(i + 1).ReadRaster(*window)
+                if data != ref_data:
+                    gdaltest.post_reason('fail')
+                    print(interleave, window, i)
+                    return 'fail'
+        ds = None
+        ref_ds = None
+
+        gdal.Unlink(filename)
+
+    return 'success'
+
+###############################################################################
+# The worker threads are only created by the first read spanning several
+# blocks, and only if the NUM_THREADS open option is set.
+
+
+def tiff_read_multithread_2():
+
+    filename = '/vsimem/tiff_read_multithread_2.tif'
+    tiff_read_multithread_create(filename, [])
+
+    msg = 'GTiff: Using 4 threads for decompression'
+
+    # Single block read: no threads.
+    (ds, open_messages, read_messages) = \
+        tiff_read_multithread_open_and_read(filename, ['NUM_THREADS=4'],
+                                            (0, 0, 16, 16))
+    if msg in open_messages or msg in read_messages:
+        gdaltest.post_reason('threads should not have been created')
+        print(open_messages, read_messages)
+        return 'fail'
+    ds = None
+
+    # Multiple block read: threads are created by the read.
+    (ds, open_messages, read_messages) = \
+        tiff_read_multithread_open_and_read(filename, ['NUM_THREADS=4'],
+                                            (0, 0, 100, 70))
+    if msg in open_messages:
+        gdaltest.post_reason('threads should not be created at open time')
+        print(open_messages)
+        return 'fail'
+    if msg not in read_messages:
+        gdaltest.post_reason('threads should have been created')
+        print(read_messages)
+        return 'fail'
+    ds = None
+
+    # GDAL_NUM_THREADS alone does not enable multi-threaded decoding.
+    gdal.SetConfigOption('GDAL_NUM_THREADS', '4')
+    (ds, open_messages, read_messages) = \
+        tiff_read_multithread_open_and_read(filename, [], (0, 0, 100, 70))
+    gdal.SetConfigOption('GDAL_NUM_THREADS', None)
+    if msg in open_messages or msg in read_messages:
+        gdaltest.post_reason('GDAL_NUM_THREADS should be ignored')
+        print(open_messages, read_messages)
+        return 'fail'
+    ds = None
+
+    gdal.Unlink(filename)
+
+    return 'success'
+
+
+gdaltest_list = [
+    tiff_read_multithread_1,
+    tiff_read_multithread_2]
+
+if __name__ == '__main__':
+
+    gdaltest.setup_run('tiff_read_multithread')
+
+    gdaltest.run_tests(gdaltest_list)
+
+    gdaltest.summarize()
@@ -0,0 +1,249 @@
+#!/usr/bin/env python
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  Test the LAYOUT=COG creation option of the GTiff driver.
+#
+###############################################################################
+# Copyright (c) 2018, GDAL contributors
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+import struct
+import sys
+
+sys.path.append('../pymod')
+sys.path.append('../../swig/python/samples')
+
+from osgeo import gdal
+
+import gdaltest
+
+# Directory of the temporary files created by CreateCopy(), so that it can
+# be checked that they are removed.
+tiff_cog_tmpdir = '/vsimem/tiff_cog_tmp'
+
+###############################################################################
+# Create a MEM dataset with a different pattern in each band.
+
+
+def tiff_cog_create_source(xsize, ysize, nbands):
+
+    ds = gdal.GetDriverByName('MEM').Create('', xsize, ysize, nbands)
+    for i in range(nbands):
+        data = b''.join(struct.pack('B' * xsize,
+                                    *[(x * (i + 1) + 7 * y) % 253
+                                      for x in range(xsize)])
+                        for y in range(ysize))
+        ds.GetRasterBand(i + 1).WriteRaster(0, 0, xsize, ysize, data)
+    return ds
+
+###############################################################################
+# CreateCopy() with LAYOUT=COG and the temporary files in tiff_cog_tmpdir.
+
+
+def tiff_cog_create_copy(filename, src_ds, options):
+
+    gdal.SetConfigOption('CPL_TMPDIR', tiff_cog_tmpdir)
+    ds = gdal.GetDriverByName('GTiff').CreateCopy(
+        filename, src_ds, options=['LAYOUT=COG'] + options)
+    gdal.SetConfigOption('CPL_TMPDIR', None)
+    return ds
+
+###############################################################################
+# Check that a file has the cloud optimized layout and no temporary file is
+# left behind.
+
+
+def tiff_cog_check_layout(filename):
+
+    try:
+        import validate_cloud_optimized_geotiff
+    except ImportError:
+        print('validate_cloud_optimized_geotiff.py not found')
+        return False
+
+    errors, _ = validate_cloud_optimized_geotiff.validate(filename)
+    if errors:
+        gdaltest.post_reason('file is not cloud optimized')
+        print(errors)
+        return False
+
+    if gdal.ReadDir(tiff_cog_tmpdir):
+        gdaltest.post_reason('temporary files left behind')
+        print(gdal.ReadDir(tiff_cog_tmpdir))
+        return False
+
+    return True
+
+###############################################################################
+# Source without overviews: they are computed down to the level that fits
+# in a single tile, with the same result as gdaladdo -ro. The comparison is
+# against external overviews because with NEAREST the result of a non
+# integer decimation depends on the block layout of the overview.
+
+
+def tiff_cog_1():
+
+    src_ds = tiff_cog_create_source(600, 500, 1)
+
+    for resampling in ['NEAREST', 'AVERAGE']:
+        ds = tiff_cog_create_copy('/vsimem/tiff_cog_1.tif', src_ds,
+                                  ['BLOCKXSIZE=128', 'BLOCKYSIZE=128',
+                                   'OVERVIEW_RESAMPLING=' + resampling])
+        if ds is None:
+            gdaltest.post_reason('fail')
+            return 'fail'
+        ds = None
+        if not tiff_cog_check_layout('/vsimem/tiff_cog_1.tif'):
+            return 'fail'
+
+        ref_ds = gdal.GetDriverByName('GTiff').CreateCopy(
+            '/vsimem/tiff_cog_1_ref.tif', src_ds)
+        ref_ds = None
+        ref_ds = gdal.Open('/vsimem/tiff_cog_1_ref.tif')
+        ref_ds.BuildOverviews(resampling, [2, 4, 8])
+
+        ds = gdal.Open('/vsimem/tiff_cog_1.tif')
+        band = ds.GetRasterBand(1)
+        ref_band = ref_ds.GetRasterBand(1)
+        if band.GetBlockSize() != [128, 128] or \
+           band.GetOverviewCount() != 3 or \
+           band.Checksum() != ref_band.Checksum():
+            gdaltest.post_reason('fail')
+            print(resampling, band.GetBlockSize(), band.GetOverviewCount())
+            return 'fail'
+        for i in range(3):
+            ovr_band = band.GetOverview(i)
+            ref_ovr_band = ref_band.GetOverview(i)
+            if ovr_band.GetBlockSize() != [128, 128] or \
+               ovr_band.Checksum() != ref_ovr_band.Checksum():
+                gdaltest.post_reason('overview %d differs' % i)
+                print(resampling, ovr_band.GetBlockSize())
+                return 'fail'
+        ds = None
+        ref_ds = None
+
+        gdal.Unlink('/vsimem/tiff_cog_1.tif')
+        gdal.Unlink('/vsimem/tiff_cog_1_ref.tif')
+        gdal.Unlink('/vsimem/tiff_cog_1_ref.tif.ovr')
+
+    return 'success'
+
+###############################################################################
+# Source with overviews and a mask, with INTERLEAVE=BAND.
+
+
+def tiff_cog_2():
+
+    src_ds = tiff_cog_create_source(700, 600, 3)
+    src_ds.CreateMaskBand(gdal.GMF_PER_DATASET)
+    mask_data = b''.join(struct.pack('B' * 700,
+                                     *[255 if (x + y) % 5 else 0
+                                       for x in range(700)])
+                         for y in range(600))
+    src_ds.GetRasterBand(1).GetMaskBand().WriteRaster(0, 0, 700, 600,
+                                                      mask_data)
+    src_ds.BuildOverviews('NEAREST', [2, 4])
+
+    gdal.SetConfigOption('GDAL_TIFF_INTERNAL_MASK', 'YES')
+    ds = tiff_cog_create_copy('/vsimem/tiff_cog_2.tif', src_ds,
+                              ['INTERLEAVE=BAND'])
+    gdal.SetConfigOption('GDAL_TIFF_INTERNAL_MASK', None)
+    if ds is None:
+        gdaltest.post_reason('fail')
+        return 'fail'
+    ds = None
+    if not tiff_cog_check_layout('/vsimem/tiff_cog_2.tif'):
+        return 'fail'
+
+    ds = gdal.Open('/vsimem/tiff_cog_2.tif')
+    if ds.GetMetadataItem('INTERLEAVE', 'IMAGE_STRUCTURE') != 'BAND':
+        gdaltest.post_reason('fail')
+        return 'fail'
+    for i in range(3):
+        band = ds.GetRasterBand(i + 1)
+        src_band = src_ds.GetRasterBand(i + 1)
+        if band.Checksum() != src_band.Checksum() or \
+           band.GetOverviewCount() != 2:
+            gdaltest.post_reason('fail')
+            return 'fail'
+        for j in range(2):
+            if band.GetOverview(j).Checksum() != \
+               src_band.GetOverview(j).Checksum():
+                gdaltest.post_reason('fail')
+                return 'fail'
+    mask_band = ds.GetRasterBand(1).GetMaskBand()
+    if ds.GetRasterBand(1).GetMaskFlags() != gdal.GMF_PER_DATASET or \
+       mask_band.Checksum() != \
+       src_ds.GetRasterBand(1).GetMaskBand().Checksum():
+        gdaltest.post_reason('fail')
+        return 'fail'
+    ds = None
+
+    gdal.Unlink('/vsimem/tiff_cog_2.tif')
+
+    return 'success'
+
+###############################################################################
+# Errors: TILED=NO is rejected, and the temporary files are removed when the
+# overviews cannot be computed.
+
+
+def tiff_cog_3():
+
+    src_ds = tiff_cog_create_source(600, 500, 1)
+
+    with gdaltest.error_handler():
+        ds = tiff_cog_create_copy('/vsimem/tiff_cog_3.tif', src_ds,
+                                  ['TILED=NO'])
+    if ds is not None:
+        gdaltest.post_reason('fail')
+        return 'fail'
+
+    with gdaltest.error_handler():
+        ds = tiff_cog_create_copy('/vsimem/tiff_cog_3.tif', src_ds,
+                                  ['OVERVIEW_RESAMPLING=INVALID'])
+    if ds is not None:
+        gdaltest.post_reason('fail')
+        return 'fail'
+    if gdal.ReadDir(tiff_cog_tmpdir):
+        gdaltest.post_reason('temporary files left behind')
+        print(gdal.ReadDir(tiff_cog_tmpdir))
+        return 'fail'
+
+    gdal.Unlink('/vsimem/tiff_cog_3.tif')
+
+    return 'success'
+
+
+gdaltest_list = [
+    tiff_cog_1,
+    tiff_cog_2,
+    tiff_cog_3]
+
+if __name__ == '__main__':
+
+    gdaltest.setup_run('tiff_cog')
+
+    gdaltest.run_tests(gdaltest_list)
+
+    gdaltest.summarize()
@@ -0,0 +1,215 @@
+#!/usr/bin/env python
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  Test the sharded pool of datasets behind the sources of VRT
+#           files (GDAL_MAX_DATASET_POOL_SIZE), with concurrent readers.
+#
+###############################################################################
+# Copyright (c) 2018, GDAL contributors
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+import struct
+
+import struct
+import sys
+import threading
+
+sys.path.append('../pymod')
+
+from osgeo import gdal
+
+import gdaltest
+
+###############################################################################
+# Create a mosaic of 10x6 GTiff tiles of 10x10 pixels, where the pixel at
+# (x, y) of the mosaic has the value (x + 3 * y) % 251, and the XML of its
+# VRT.
+
+
+def vrt_proxy_pool_init():
+
+    xml = '<VRTDataset rasterXSize="100" rasterYSize="60">\n'
+    xml += '  <VRTRasterBand dataType="Byte" band="1">\n'
+    for ty in range(6):
+        for tx in range(10):
+            filename = '/vsimem/vrt_proxy_pool_%d_%d.tif' % (tx, ty)
+            ds = gdal.GetDriverByName('GTiff').Create(filename, 10, 10)
+            data = b''.join(struct.pack('B' * 10,
+                                        *[(tx * 10 + i + 3 * (ty * 10 + j))
+                                          % 251 for i in range(10)])
+                            for j in range(10))
+            ds.GetRasterBand(1).WriteRaster(0, 0, 10, 10, data)
+            ds = None
+            xml += """    <SimpleSource>
+      <SourceFilename>%s</SourceFilename>
+      <SourceBand>1</SourceBand>
+      <SrcRect xOff="0" yOff="0" xSize="10" ySize="10"/>
+      <DstRect xOff="%d" yOff="%d" xSize="10" ySize="10"/>
+    </SimpleSource>
+""" % (filename, tx * 10, ty * 10)
+    xml += '  </VRTRasterBand>\n'
+    xml += '</VRTDataset>\n'
+    gdaltest.vrt_proxy_pool_xml = xml
+
+    return 'success'
+
+###############################################################################
+# Read random windows of the VRT, and check their content. Returns an error
+# message, or None.
+
+
+def vrt_proxy_pool_read_windows(seed, count):
+
+    ds = gdal.Open(gdaltest.vrt_proxy_pool_xml)
+    band = ds.GetRasterBand(1)
+    for _ in range(count):
+        seed = (seed * 1103515245 + 12345) % 2147483648
+        xoff = seed % 90
+        seed = (seed * 1103515245 + 12345) % 2147483648
+        yoff = seed % 50
+        seed = (seed * 1103515245 + 12345) % 2147483648
+        xsize = 1 + seed % (100 - xoff)
+        seed = (seed * 1103515245 + 12345) % 2147483648
+        ysize = 1 + seed % (60 - yoff)
+        data = struct.unpack('B' * (xsize * ysize),
+                             band.ReadRaster(xoff, yoff, xsize, ysize))
+        for j in range(ysize):
+            for i in range(xsize):
+                expected = (xoff + i + 3 * (yoff + j)) % 251
+                if data[j * xsize + i] != expected:
+                    return 'wrong value at (%d, %d): %d instead of %d' % (
+                        xoff + i, yoff + j, data[j * xsize + i], expected)
+        # Drop the cached blocks so that the next windows go back to the
+        # sources.
+        band.FlushCache()
+    ds = None
+    return None
+
+###############################################################################
+# Read the VRT from one thread and from several threads, with pools smaller
+# and larger than the number of sources.
+
+
+def vrt_proxy_pool_1():
+
+    old_pool_size = gdal.GetConfigOption('GDAL_MAX_DATASET_POOL_SIZE')
+    ret = 'success'
+    for pool_size in ['2', '8', '20', '100']:
+        gdal.SetConfigOption('GDAL_MAX_DATASET_POOL_SIZE', pool_size)
+
+        error = vrt_proxy_pool_read_windows(1, 50)
+        if error is not None:
+            gdaltest.post_reason(error)
+            print(pool_size)
+            ret = 'fail'
+            break
+
+        errors = []
+
+        def reader(seed):
+            error = vrt_proxy_pool_read_windows(seed, 50)
+            if error is not None:
+                errors.append(error)
+
+        threads = [threading.Thread(target=reader, args=(seed,))
+                   for seed in range(8)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        if errors:
+            gdaltest.post_reason(errors[0])
+            print(pool_size)
+            ret = 'fail'
+            break
+
+    gdal.SetConfigOption('GDAL_MAX_DATASET_POOL_SIZE', old_pool_size)
+
+    return ret
+
+###############################################################################
+# Several datasets of the VRT opened at the same time share the pool, and
+# closing some of them does not affect the others.
+
+
+def vrt_proxy_pool_2():
+
+    old_pool_size = gdal.GetConfigOption('GDAL_MAX_DATASET_POOL_SIZE')
+    gdal.SetConfigOption('GDAL_MAX_DATASET_POOL_SIZE', '4')
+
+    datasets = [gdal.Open(gdaltest.vrt_proxy_pool_xml) for _ in range(5)]
+    checksums = [ds.GetRasterBand(1).Checksum() for ds in datasets]
+    datasets[1] = None
+    datasets[3] = None
+    for ds in [datasets[0], datasets[2], datasets[4]]:
+        ds.GetRasterBand(1).FlushCache()
+        checksums.append(ds.GetRasterBand(1).Checksum())
+    datasets = None
+
+    gdal.SetConfigOption('GDAL_MAX_DATASET_POOL_SIZE', old_pool_size)
+
+    if len(set(checksums)) != 1:
+        gdaltest.post_reason('fail')
+        print(checksums)
+        return 'fail'
+
+    ds = gdal.GetDriverByName('MEM').Create('', 100, 60)
+    ds.GetRasterBand(1).WriteRaster(
+        0, 0, 100, 60,
+        b''.join(struct.pack('B' * 100,
+                             *[(i + 3 * j) % 251 for i in range(100)])
+                 for j in range(60)))
+    if ds.GetRasterBand(1).Checksum() != checksums[0]:
+        gdaltest.post_reason('fail')
+        print(checksums[0])
+        return 'fail'
+
+    return 'success'
+
+###############################################################################
+# Cleanup
+
+
+def vrt_proxy_pool_cleanup():
+
+    for ty in range(6):
+        for tx in range(10):
+            gdal.Unlink('/vsimem/vrt_proxy_pool_%d_%d.tif' % (tx, ty))
+    gdaltest.vrt_proxy_pool_xml = None
+
+    return 'success'
+
+
+gdaltest_list = [
+    vrt_proxy_pool_init,
+    vrt_proxy_pool_1,
+    vrt_proxy_pool_2,
+    vrt_proxy_pool_cleanup]
+
+if __name__ == '__main__':
+
+    gdaltest.setup_run('vrt_proxy_pool')
+
+    gdaltest.run_tests(gdaltest_list)
+
+    gdaltest.summarize()
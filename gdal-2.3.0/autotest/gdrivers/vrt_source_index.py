@@ -0,0 +1,244 @@
+#!/usr/bin/env python
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  Compare reading VRT bands with many sources through the spatial
+#           index of their sources and by testing every source.
+#
+###############################################################################
+# Copyright (c) 2018, GDAL contributors
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+import random
+import struct
+import sys
+
+sys.path.append('../pymod')
+
+from osgeo import gdal
+
+import gdaltest
+
+###############################################################################
+# Create 16x16 GTiff sources with different patterns.
+
+
+def vrt_source_index_init():
+
+    for k in range(4):
+        ds = gdal.GetDriverByName('GTiff').Create(
+            '/vsimem/vrt_source_index_%d.tif' % k, 16, 16)
+        data = b''.join(struct.pack('B' * 16,
+                                    *[(1 + 11 * k + 3 * j + i * (k + 1)) % 251
+                                      for i in range(16)])
+                        for j in range(16))
+        ds.GetRasterBand(1).WriteRaster(0, 0, 16, 16, data)
+        ds = None
+
+    return 'success'
+
+###############################################################################
+# XML of a source: a random part of a random file, to a random window that
+# may be fractional, partly or fully out of the raster, or empty.
+
+
+def vrt_source_index_source_xml(rng, xsize, ysize):
+
+    def coord(vmax):
+        if rng.randint(0, 3) == 0:
+            return rng.randint(-20, vmax + 5) + 0.5
+        return float(rng.randint(-20, vmax + 5))
+
+    src_xoff = rng.randint(0, 8)
+    src_yoff = rng.randint(0, 8)
+    src_xsize = rng.randint(1, 16 - src_xoff)
+    src_ysize = rng.randint(1, 16 - src_yoff)
+    dst_xsize = 0.0 if rng.randint(0, 30) == 0 else \
+        float(rng.choice([src_xsize, rng.randint(1, 40)]))
+    dst_ysize = float(rng.choice([src_ysize, rng.randint(1, 40)]))
+
+    if rng.randint(0, 2) == 0:
+        tag = 'ComplexSource'
+        extra = '<NODATA>%d</NODATA>' % rng.randint(0, 250)
+    else:
+        tag = 'SimpleSource'
+        extra = ''
+    return ('<%s><SourceFilename>/vsimem/vrt_source_index_%d.tif'
+            '</SourceFilename><SourceBand>1</SourceBand>'
+            '<SrcRect xOff="%d" yOff="%d" xSize="%d" ySize="%d"/>'
+            '<DstRect xOff="%.17g" yOff="%.17g" xSize="%.17g" ySize="%.17g"/>'
+            '%s</%s>' % (tag, rng.randint(0, 3), src_xoff, src_yoff,
+                         src_xsize, src_ysize, coord(xsize), coord(ysize),
+                         dst_xsize, dst_ysize, extra, tag))
+
+###############################################################################
+# XML of a VRT with nbands bands made of the same nsources random sources.
+
+
+def vrt_source_index_vrt_xml(rng, xsize, ysize, nbands, nsources):
+
+    sources = [vrt_source_index_source_xml(rng, xsize, ysize)
+               for _ in range(nsources)]
+    xml = '<VRTDataset rasterXSize="%d" rasterYSize="%d">' % (xsize, ysize)
+    for i in range(nbands):
+        xml += '<VRTRasterBand dataType="Byte" band="%d">' % (i + 1)
+        xml += ''.join(sources)
+        xml += '</VRTRasterBand>'
+    xml += '</VRTDataset>'
+    return xml
+
+###############################################################################
+# Read random windows of a dataset with and without the index, at full
+# resolution and with resampling, through the band and the dataset.
+
+
+def vrt_source_index_compare_reads(ds, rng, nreads):
+
+    for _ in range(nreads):
+        xoff = rng.randint(0, ds.RasterXSize - 1)
+        yoff = rng.randint(0, ds.RasterYSize - 1)
+        xsize = rng.randint(1, ds.RasterXSize - xoff)
+        ysize = rng.randint(1, ds.RasterYSize - yoff)
+        if rng.randint(0, 1) == 0:
+            buf_xsize = xsize
+            buf_ysize = ysize
+        else:
+            buf_xsize = rng.randint(1, 2 * xsize)
+            buf_ysize = rng.randint(1, 2 * ysize)
+
+        res = []
+        for source_index in ['YES', 'NO']:
+            gdal.SetConfigOption('VRT_SOURCE_INDEX', source_index)
+            res.append((ds.GetRasterBand(1).ReadRaster(
+                xoff, yoff, xsize, ysize, buf_xsize, buf_ysize),
+                ds.ReadRaster(xoff, yoff, xsize, ysize,
+                              buf_xsize, buf_ysize)))
+            gdal.SetConfigOption('VRT_SOURCE_INDEX', None)
+        if res[0] != res[1]:
+            gdaltest.post_reason('reads differ')
+            print(xoff, yoff, xsize, ysize, buf_xsize, buf_ysize)
+            return False
+
+    return True
+
+###############################################################################
+# Random windows of random mosaics give the same result with and without
+# the index.
+
+
+def vrt_source_index_1():
+
+    rng = random.Random(50)
+    for _ in range(5):
+        xml = vrt_source_index_vrt_xml(rng, 200, 170, 2, 300)
+        ds = gdal.Open(xml)
+        if not vrt_source_index_compare_reads(ds, rng, 100):
+            return 'fail'
+        ds = None
+
+    return 'success'
+
+###############################################################################
+# Checksum, statistics and histogram are the same with and without the
+# index.
+
+
+def vrt_source_index_2():
+
+    rng = random.Random(51)
+    xml = vrt_source_index_vrt_xml(rng, 200, 170, 1, 200)
+
+    res = []
+    for source_index in ['YES', 'NO']:
+        gdal.SetConfigOption('VRT_SOURCE_INDEX', source_index)
+        ds = gdal.Open(xml)
+        band = ds.GetRasterBand(1)
+        res.append((band.Checksum(), band.ComputeStatistics(False),
+                    band.GetHistogram(approx_ok=0)))
+        ds = None
+        gdal.SetConfigOption('VRT_SOURCE_INDEX', None)
+
+    if res[0] != res[1]:
+        gdaltest.post_reason('fail')
+        print(res[0][:2])
+        print(res[1][:2])
+        return 'fail'
+
+    return 'success'
+
+###############################################################################
+# Sources added or replaced after the index is built, inside and outside of
+# its bounds, are taken into account.
+
+
+def vrt_source_index_3():
+
+    rng = random.Random(52)
+    xml = vrt_source_index_vrt_xml(rng, 200, 170, 1, 100)
+    ds = gdal.Open(xml)
+    band = ds.GetRasterBand(1)
+    if not vrt_source_index_compare_reads(ds, rng, 10):
+        return 'fail'
+
+    for i in range(40):
+        band.SetMetadataItem('source_%d' % i,
+                             vrt_source_index_source_xml(rng, 200, 170),
+                             'new_vrt_sources')
+        if not vrt_source_index_compare_reads(ds, rng, 5):
+            print('after the addition of source %d' % i)
+            return 'fail'
+
+    for i in range(0, 140, 7):
+        band.SetMetadataItem('source_%d' % i,
+                             vrt_source_index_source_xml(rng, 200, 170),
+                             'vrt_sources')
+        if not vrt_source_index_compare_reads(ds, rng, 5):
+            print('after the replacement of source %d' % i)
+            return 'fail'
+
+    return 'success'
+
+###############################################################################
+
+
+def vrt_source_index_cleanup():
+
+    for k in range(4):
+        gdal.Unlink('/vsimem/vrt_source_index_%d.tif' % k)
+
+    return 'success'
+
+
+gdaltest_list = [
+    vrt_source_index_init,
+    vrt_source_index_1,
+    vrt_source_index_2,
+    vrt_source_index_3,
+    vrt_source_index_cleanup]
+
+if __name__ == '__main__':
+
+    gdaltest.setup_run('vrt_source_index')
+
+    gdaltest.run_tests(gdaltest_list)
+
+    gdaltest.summarize()
@@ -0,0 +1,287 @@
+#!/usr/bin/env python
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  Test reading the sources of a VRT with worker threads.
+#
+###############################################################################
+# Copyright (c) 2018, GDAL contributors
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+import struct
+import sys
+
+sys.path.append('../pymod')
+
+from osgeo import gdal
+
+import gdaltest
+
+###############################################################################
+# Create a 10x10 GTiff source whose pixel values depend on its origin.
+
+
+def vrtmultithread_create_source(filename, xoff, yoff):
+
+    ds = gdal.GetDriverByName('GTiff').Create(filename, 10, 10)
+    data = b''.join(struct.pack('B' * 10,
+                                *[(xoff + 3 * (yoff + j) + i) % 251
+                                  for i in range(10)])
+                    for j in range(10))
+    ds.GetRasterBand(1).WriteRaster(0, 0, 10, 10, data)
+    ds = None
+
+###############################################################################
+# Build the XML of a VRT from a list of (filename, dstxoff, dstyoff).
+
+
+def vrtmultithread_vrt_xml(xsize, ysize, sources):
+
+    xml = '<VRTDataset rasterXSize="%d" rasterYSize="%d">\n' % (xsize, ysize)
+    xml += '  <VRTRasterBand dataType="Byte" band="1">\n'
+    for (filename, xoff, yoff) in sources:
+        xml += """    <SimpleSource>
+      <SourceFilename>%s</SourceFilename>
+      <SourceBand>1</SourceBand>
+      <SrcRect xOff="0" yOff="0" xSize="10" ySize="10"/>
+      <DstRect xOff="%d" yOff="%d" xSize="10" ySize="10"/>
+    </SimpleSource>
+""" % (filename, xoff, yoff)
+    xml += '  </VRTRasterBand>\n'
+    xml += '</VRTDataset>\n'
+    return xml
+
+###############################################################################
+# Read a VRT and collect the debug messages of the VRT driver.
+
+
+def vrtmultithread_read(xml, open_options=None):
+
+    messages = []
+
+    def handler(err_class, err_no, msg):
+        # pylint: disable=unused-argument
+        if err_class == gdal.CE_Debug and msg.startswith('VRT: '):
+            messages.append(msg)
+
+    gdal.PushErrorHandler(handler)
+    old_debug = gdal.GetConfigOption('CPL_DEBUG')
+    gdal.SetConfigOption('CPL_DEBUG', 'ON')
+    if open_options is None:
+        ds = gdal.Open(xml)
+    else:
+        ds = gdal.OpenEx(xml, open_options=open_options)
+    data = ds.ReadRaster(0, 0, ds.RasterXSize, ds.RasterYSize)
+    ds = None
+    gdal.SetConfigOption('CPL_DEBUG', old_debug)
+    gdal.PopErrorHandler()
+
+    return (data, messages)
+
+###############################################################################
+# Sources that do not overlap are all read in a single wave, and the
+# result is the one of the sequential path.
+
+
+def vrtmultithread_1():
+
+    sources = []
+    for j in range(2):
+        for i in range(2):
+            filename = '/vsimem/vrtmultithread_%d_%d.tif' % (i, j)
+            vrtmultithread_create_source(filename, 10 * i, 10 * j)
+            sources.append((filename, 10 * i, 10 * j))
+    xml = vrtmultithread_vrt_xml(20, 20, sources)
+
+    (ref_data, messages) = vrtmultithread_read(xml)
+    if [msg for msg in messages if 'waves' in msg]:
+        gdaltest.post_reason('sources should be read sequentially')
+        print(messages)
+        return 'fail'
+
+    (data, messages) = vrtmultithread_read(xml, ['NUM_THREADS=4'])
+    if 'VRT: Reading 4 sources in 1 waves' not in messages:
+        gdaltest.post_reason('sources should be read by worker threads')
+        print(messages)
+        return 'fail'
+    if data != ref_data:
+        gdaltest.post_reason('result differs from sequential read')
+        return 'fail'
+
+    # The VRT_NUM_THREADS configuration option is used when the open
+    # option is not set.
+    gdal.SetConfigOption('VRT_NUM_THREADS', '4')
+    (data, messages) = vrtmultithread_read(xml)
+    gdal.SetConfigOption('VRT_NUM_THREADS', None)
+    if 'VRT: Reading 4 sources in 1 waves' not in messages:
+        gdaltest.post_reason('sources should be read by worker threads')
+        print(messages)
+        return 'fail'
+    if data != ref_data:
+        gdaltest.post_reason('result differs from sequential read')
+        return 'fail'
+
+    return 'success'
+
+###############################################################################
+# Overlapping sources are read in successive waves, so that the last
+# source still wins.
+
+
+def vrtmultithread_2():
+
+    sources = [('/vsimem/vrtmultithread_0_0.tif', 0, 0),
+               ('/vsimem/vrtmultithread_1_0.tif', 10, 0),
+               ('/vsimem/vrtmultithread_0_1.tif', 5, 5)]
+    xml = vrtmultithread_vrt_xml(20, 20, sources)
+
+    (ref_data, _) = vrtmultithread_read(xml)
+    (data, messages) = vrtmultithread_read(xml, ['NUM_THREADS=4'])
+    if 'VRT: Reading 3 sources in 2 waves' not in messages:
+        gdaltest.post_reason('fail')
+        print(messages)
+        return 'fail'
+    if data != ref_data:
+        gdaltest.post_reason('result differs from sequential read')
+        return 'fail'
+
+    return 'success'
+
+###############################################################################
+# Read a single-source VRT, then a VRT whose last wave has a single
+# source, then a multi-source VRT, all from the same thread. Reading a
+# wave must not prevent the calling thread from using worker threads
+# afterwards.
+
+
+def vrtmultithread_3():
+
+    gdal.SetConfigOption('VRT_NUM_THREADS', '4')
+
+    single_xml = vrtmultithread_vrt_xml(
+        10, 10, [('/vsimem/vrtmultithread_0_0.tif', 0, 0)])
+    (data, _) = vrtmultithread_read(single_xml)
+    if len(data) != 100:
+        gdal.SetConfigOption('VRT_NUM_THREADS', None)
+        gdaltest.post_reason('fail')
+        return 'fail'
+
+    overlap_xml = vrtmultithread_vrt_xml(
+        20, 20, [('/vsimem/vrtmultithread_0_0.tif', 0, 0),
+                 ('/vsimem/vrtmultithread_1_0.tif', 10, 0),
+                 ('/vsimem/vrtmultithread_0_1.tif', 5, 5)])
+    (_, messages) = vrtmultithread_read(overlap_xml)
+    if 'VRT: Reading 3 sources in 2 waves' not in messages:
+        gdal.SetConfigOption('VRT_NUM_THREADS', None)
+        gdaltest.post_reason('fail')
+        print(messages)
+        return 'fail'
+
+    sources = []
+    for j in range(2):
+        for i in range(2):
+            sources.append(('/vsimem/vrtmultithread_%d_%d.tif' % (i, j),
+                            10 * i, 10 * j))
+    mosaic_xml = vrtmultithread_vrt_xml(20, 20, sources)
+    for _ in range(2):
+        (_, messages) = vrtmultithread_read(mosaic_xml)
+        if 'VRT: Reading 4 sources in 1 waves' not in messages:
+            gdal.SetConfigOption('VRT_NUM_THREADS', None)
+            gdaltest.post_reason('sources should be read by worker threads')
+            print(messages)
+            return 'fail'
+
+    gdal.SetConfigOption('VRT_NUM_THREADS', None)
+
+    return 'success'
+
+###############################################################################
+# Errors raised while reading sources in worker threads are reported
+# to the calling thread.
+
+
+def vrtmultithread_4():
+
+    # Truncate a copy of a source so that reading its pixels fails.
+    filename = '/vsimem/vrtmultithread_truncated.tif'
+    vrtmultithread_create_source(filename, 0, 0)
+    f = gdal.VSIFOpenL(filename, 'rb')
+    content = gdal.VSIFReadL(1, 100000, f)
+    gdal.VSIFCloseL(f)
+    gdal.Unlink(filename)
+    ds = gdal.Open('/vsimem/vrtmultithread_0_0.tif')
+    offset = int(ds.GetRasterBand(1).GetMetadataItem('BLOCK_OFFSET_0_0',
+                                                     'TIFF'))
+    ds = None
+    f = gdal.VSIFOpenL(filename, 'wb')
+    gdal.VSIFWriteL(content[0:offset], 1, offset, f)
+    gdal.VSIFCloseL(f)
+
+    xml = vrtmultithread_vrt_xml(
+        20, 10, [('/vsimem/vrtmultithread_0_0.tif', 0, 0),
+                 (filename, 10, 0)])
+
+    ds = gdal.OpenEx(xml, open_options=['NUM_THREADS=2'])
+    gdal.ErrorReset()
+    with gdaltest.error_handler():
+        data = ds.ReadRaster(0, 0, 20, 10)
+    ds = None
+    gdal.Unlink(filename)
+
+    if data is not None:
+        gdaltest.post_reason('read should have failed')
+        return 'fail'
+    if gdal.GetLastErrorType() != gdal.CE_Failure or \
+       gdal.GetLastErrorMsg() == '':
+        gdaltest.post_reason('error of the worker thread not reported')
+        print(gdal.GetLastErrorMsg())
+        return 'fail'
+
+    return 'success'
+
+###############################################################################
+# Cleanup.
+
+
+def vrtmultithread_cleanup():
+
+    for j in range(2):
+        for i in range(2):
+            gdal.Unlink('/vsimem/vrtmultithread_%d_%d.tif' % (i, j))
+
+    return 'success'
+
+
+gdaltest_list = [
+    vrtmultithread_1,
+    vrtmultithread_2,
+    vrtmultithread_3,
+    vrtmultithread_4,
+    vrtmultithread_cleanup]
+
+if __name__ == '__main__':
+
+    gdaltest.setup_run('vrtmultithread')
+
+    gdaltest.run_tests(gdaltest_list)
+
+    gdaltest.summarize()
@@ -0,0 +1,234 @@
+#!/usr/bin/env python
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  Test the conversion of the numeric fields of the CSV driver, and
+#           the splitting of its records.
+#
+###############################################################################
+# Copyright (c) 2018, GDAL contributors
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+import sys
+
+sys.path.append('../pymod')
+
+from osgeo import gdal
+from osgeo import ogr
+
+import gdaltest
+
+# Tokens that CPLGetValueType() considers as numbers, and that the driver
+# must convert as OGRFeature::SetField(int, const char*) does.
+numeric_tokens = [
+    '0', '-0', '+12', '007', '2147483647', '-2147483648', '2147483648',
+    '-2147483649', '123456789012345678', '-123456789012345678',
+    '1234567890123456789', '-9223372036854775808', '99999999999999999999',
+    '1.5', '-.5', '1.', '.5e1', '1e3', '1E-3', '+2.5e+2', '1e308', '1e999',
+    '1d3', '0.1', '3.141592653589793238', '123456789.123456789e-5',
+    '9007199254740993', '.', '-', '1e+', '-0.0', '-0e5', '-00']
+
+# Tokens that are not numbers, for which the field is left unset.
+string_tokens = ['1e1000', '0x10', 'nan', 'inf', '1.2.3', '12abc', '1e',
+                 'e5', '--1']
+
+###############################################################################
+# Read a CSV file with an Integer, an Integer64 and a Real field, with one
+# record per token.
+
+
+def ogr_csv_numbers_read(tokens, delimiter=','):
+
+    filename = '/vsimem/ogr_csv_numbers.csv'
+    content = 'i%si64%sr\n' % (delimiter, delimiter)
+    for token in tokens:
+        content += '%s%s%s%s%s\n' % (token, delimiter, token, delimiter, token)
+    gdal.FileFromMemBuffer(filename, content)
+    gdal.FileFromMemBuffer('/vsimem/ogr_csv_numbers.csvt',
+                           'Integer,Integer64,Real\n')
+
+    ret = []
+    with gdaltest.error_handler():
+        ds = ogr.Open(filename)
+        lyr = ds.GetLayer(0)
+        feat = lyr.GetNextFeature()
+        while feat is not None:
+            ret.append([feat.GetField(i) if feat.IsFieldSet(i) else None
+                        for i in range(3)])
+            feat = lyr.GetNextFeature()
+    ds = None
+
+    gdal.Unlink(filename)
+    gdal.Unlink('/vsimem/ogr_csv_numbers.csvt')
+    return ret
+
+###############################################################################
+# Values set from strings on a feature of a memory layer with the same
+# fields.
+
+
+def ogr_csv_numbers_expected(tokens):
+
+    ds = ogr.GetDriverByName('Memory').CreateDataSource('')
+    lyr = ds.CreateLayer('test')
+    lyr.CreateField(ogr.FieldDefn('i', ogr.OFTInteger))
+    lyr.CreateField(ogr.FieldDefn('i64', ogr.OFTInteger64))
+    lyr.CreateField(ogr.FieldDefn('r', ogr.OFTReal))
+
+    ret = []
+    with gdaltest.error_handler():
+        for token in tokens:
+            feat = ogr.Feature(lyr.GetLayerDefn())
+            for i in range(3):
+                feat.SetField(i, token)
+            ret.append([feat.GetField(i) for i in range(3)])
+    return ret
+
+###############################################################################
+# Numbers are converted as by OGRFeature::SetField(int, const char*), and
+# other tokens leave the field unset. The values are compared by their repr()
+# so that the sign of zero is checked.
+
+
+def ogr_csv_numbers_1():
+
+    got = ogr_csv_numbers_read(numeric_tokens)
+    expected = ogr_csv_numbers_expected(numeric_tokens)
+    for (token, got_values, expected_values) in \
+            zip(numeric_tokens, got, expected):
+        if repr(got_values) != repr(expected_values):
+            gdaltest.post_reason('fail')
+            print(token, got_values, expected_values)
+            return 'fail'
+
+    got = ogr_csv_numbers_read(string_tokens)
+    for (token, got_values) in zip(string_tokens, got):
+        if got_values != [None, None, None]:
+            gdaltest.post_reason('fail')
+            print(token, got_values)
+            return 'fail'
+
+    return 'success'
+
+###############################################################################
+# Decimal comma with the semicolon delimiter.
+
+
+def ogr_csv_numbers_2():
+
+    got = ogr_csv_numbers_read(['1,5', '-2', '3,25e2'], delimiter=';')
+    if got != [[None, None, 1.5], [-2, -2, -2.0], [None, None, 325.0]]:
+        gdaltest.post_reason('fail')
+        print(got)
+        return 'fail'
+
+    return 'success'
+
+###############################################################################
+# The warnings about values that do not fit the field are still emitted.
+
+
+def ogr_csv_numbers_3():
+
+    for (csvt, value, expected_msg) in [
+            ('Integer', '1.5', 'Invalid value type found in record 2'),
+            ('Integer(2)', '123', 'Value with a width greater'),
+            ('Real(5.1)', '1.25', 'Value with a precision greater')]:
+        content = 'id,v\n1,1\n2,%s\n' % value
+        csvt = 'Integer,' + csvt
+        gdal.FileFromMemBuffer('/vsimem/ogr_csv_numbers_3.csv', content)
+        gdal.FileFromMemBuffer('/vsimem/ogr_csv_numbers_3.csvt', csvt)
+
+        ds = ogr.Open('/vsimem/ogr_csv_numbers_3.csv')
+        lyr = ds.GetLayer(0)
+        gdal.ErrorReset()
+        with gdaltest.error_handler():
+            while lyr.GetNextFeature() is not None:
+                pass
+        msg = gdal.GetLastErrorMsg()
+        ds = None
+
+        gdal.Unlink('/vsimem/ogr_csv_numbers_3.csv')
+        gdal.Unlink('/vsimem/ogr_csv_numbers_3.csvt')
+
+        if msg.find(expected_msg) < 0:
+            gdaltest.post_reason('fail')
+            print(csvt, msg)
+            return 'fail'
+
+    return 'success'
+
+
+###############################################################################
+# Records split by the in-place tokenizer: a nul character ends the line as
+# for OGRCSVReadParseLineL(), quoted values span several lines, and records
+# longer than the previous ones grow the buffers.
+
+
+def ogr_csv_numbers_4():
+
+    long_value = 'x' * 100000
+    content = ('id,name\n' +
+               '1,"a"\n' +
+               '2,b\x00,"c\n' +
+               '3,"multi\nline ""quoted"""\n' +
+               '4,%s\n' % long_value +
+               '5,' + ','.join(['%d' % i for i in range(5000)]) + '\n' +
+               '6,"%s"\n' % long_value +
+               '7,e\n')
+    gdal.FileFromMemBuffer('/vsimem/ogr_csv_numbers_4.csv', content)
+
+    ds = ogr.Open('/vsimem/ogr_csv_numbers_4.csv')
+    lyr = ds.GetLayer(0)
+    got = []
+    feat = lyr.GetNextFeature()
+    while feat is not None:
+        got.append((feat.GetField(0), feat.GetField(1)))
+        feat = lyr.GetNextFeature()
+    ds = None
+
+    gdal.Unlink('/vsimem/ogr_csv_numbers_4.csv')
+
+    expected = [('1', 'a'), ('2', 'b'), ('3', 'multi\nline "quoted"'),
+                ('4', long_value), ('5', '0'), ('6', long_value),
+                ('7', 'e')]
+    if got != expected:
+        gdaltest.post_reason('fail')
+        print([(a, b[0:30]) for (a, b) in got])
+        return 'fail'
+
+    return 'success'
+
+
+gdaltest_list = [
+    ogr_csv_numbers_1,
+    ogr_csv_numbers_2,
+    ogr_csv_numbers_3,
+    ogr_csv_numbers_4]
+
+if __name__ == '__main__':
+
+    gdaltest.setup_run('ogr_csv_numbers')
+
+    gdaltest.run_tests(gdaltest_list)
+
+    gdaltest.summarize()
@@ -0,0 +1,136 @@
+#!/usr/bin/env python
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  Test that the envelope and the length of curves are those of
+#           a point by point scan, for all point counts.
+#
+###############################################################################
+# Copyright (c) 2018, GDAL contributors
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+import math
+import random
+import struct
+import sys
+
+sys.path.append('../pymod')
+
+from osgeo import ogr
+
+import gdaltest
+
+###############################################################################
+# Random curves of 1 to 12 points, some with signed zeros and NaN.
+
+
+def ogr_curve_kernels_points(rng, count):
+
+    values = [0.0, -0.0, 0.0, -0.0, float('nan'), 1.5, -1.5, 1e300, -1e300]
+    points = []
+    for _ in range(count):
+        if rng.randint(0, 2) == 0:
+            points.append((rng.choice(values), rng.choice(values)))
+        else:
+            points.append((rng.uniform(-1000, 1000),
+                           rng.uniform(-1000, 1000)))
+    return points
+
+
+def ogr_curve_kernels_same(a, b):
+    return struct.pack('d' * len(a), *a) == struct.pack('d' * len(b), *b)
+
+###############################################################################
+# The envelope is the one of the point by point scan, including which of 0
+# and -0 is kept, and NaN propagation from the first point.
+
+
+def ogr_curve_kernels_1():
+
+    rng = random.Random(1)
+    for _ in range(3000):
+        points = ogr_curve_kernels_points(rng, rng.randint(1, 12))
+        g = ogr.Geometry(ogr.wkbLineString)
+        for (x, y) in points:
+            g.AddPoint_2D(x, y)
+
+        (minx, miny) = points[0]
+        (maxx, maxy) = points[0]
+        for (x, y) in points[1:]:
+            if maxx < x:
+                maxx = x
+            if maxy < y:
+                maxy = y
+            if minx > x:
+                minx = x
+            if miny > y:
+                miny = y
+
+        got = g.GetEnvelope()
+        if not ogr_curve_kernels_same(got, (minx, maxx, miny, maxy)):
+            gdaltest.post_reason('envelope differs')
+            print(points, got, (minx, maxx, miny, maxy))
+            return 'fail'
+
+    return 'success'
+
+###############################################################################
+# The length is the sum of the segment lengths in order.
+
+
+def ogr_curve_kernels_2():
+
+    rng = random.Random(2)
+    for _ in range(3000):
+        n = rng.randint(1, 12)
+        points = [(rng.uniform(-1000, 1000), rng.uniform(-1000, 1000))
+                  for _ in range(n)]
+        g = ogr.Geometry(ogr.wkbLineString)
+        for (x, y) in points:
+            g.AddPoint_2D(x, y)
+
+        expected = 0.0
+        for i in range(n - 1):
+            dx = points[i + 1][0] - points[i][0]
+            dy = points[i + 1][1] - points[i][1]
+            expected += math.sqrt(dx * dx + dy * dy)
+
+        got = g.Length()
+        if not ogr_curve_kernels_same([got], [expected]):
+            gdaltest.post_reason('length differs')
+            print(points, got, expected)
+            return 'fail'
+
+    return 'success'
+
+
+gdaltest_list = [
+    ogr_curve_kernels_1,
+    ogr_curve_kernels_2]
+
+if __name__ == '__main__':
+
+    gdaltest.setup_run('ogr_curve_kernels')
+
+    gdaltest.run_tests(gdaltest_list)
+
+    gdaltest.summarize()
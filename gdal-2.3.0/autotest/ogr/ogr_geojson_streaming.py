@@ -0,0 +1,171 @@
+#!/usr/bin/env python
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  Test that the geometries built by the streaming GeoJSON reader
+#           match the ones of the in-memory reader.
+#
+###############################################################################
+# Copyright (c) 2018, GDAL contributors
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+import sys
+
+import sys
+
+sys.path.append('../pymod')
+
+from osgeo import gdal
+from osgeo import ogr
+
+import gdaltest
+
+###############################################################################
+# Return the geometries, as WKT, of the features of a GeoJSON document, read
+# either from a file (streaming reader) or from a string (in-memory reader).
+
+
+def ogr_geojson_streaming_read(content, streaming):
+
+    if streaming:
+        filename = '/vsimem/ogr_geojson_streaming.json'
+        gdal.FileFromMemBuffer(filename, content)
+    else:
+        filename = content
+
+    ret = []
+    with gdaltest.error_handler():
+        ds = ogr.Open(filename)
+        if ds is None:
+            ret = None
+        else:
+            lyr = ds.GetLayer(0)
+            feat = lyr.GetNextFeature()
+            while feat is not None:
+                geom = feat.GetGeometryRef()
+                ret.append(geom.ExportToWkt() if geom is not None else None)
+                feat = lyr.GetNextFeature()
+    ds = None
+
+    if streaming:
+        gdal.Unlink(filename)
+
+    return ret
+
+###############################################################################
+# Several "geometry" members in a feature, or a streamed geometry followed by
+# a null or non-object "geometry": the last one wins, as with the in-memory
+# reader, and the streamed geometry must not be used once it is replaced.
+
+
+def ogr_geojson_streaming_1():
+
+    point = '{"type":"Point","coordinates":[1,2]}'
+    line = '{"type":"LineString","coordinates":[[3,4],[5,6]]}'
+    collection = ('{"type":"GeometryCollection","geometries":[' + point +
+                  ']}')
+    with_crs = ('{"type":"Point","coordinates":[7,8],"crs":{"type":"name",' +
+                '"properties":{"name":"EPSG:4326"}}}')
+    members = [
+        [point, line],
+        [line, point, line],
+        [point, 'null'],
+        [line, 'null', point],
+        [point, '"foo"'],
+        [point, '[1,2]'],
+        [point, '3'],
+        [point, 'true'],
+        [collection, point],
+        [point, collection],
+        [with_crs, line],
+        [line, with_crs],
+        [point, '{}'],
+        ['null', point],
+    ]
+
+    for geoms in members:
+        feature = '{"type":"Feature",'
+        for geom in geoms:
+            feature += '"geometry":%s,' % geom
+        feature += '"properties":{"a":1}}'
+        # A second feature checks that no state is kept between features.
+        content = ('{"type":"FeatureCollection","features":[' + feature +
+                   ',{"type":"Feature","geometry":' + point +
+                   ',"properties":{"a":2}}]}')
+
+        ref = ogr_geojson_streaming_read(content, False)
+        got = ogr_geojson_streaming_read(content, True)
+        if got != ref or got is None or len(got) != 2:
+            gdaltest.post_reason('fail')
+            print(content)
+            print(ref)
+            print(got)
+            return 'fail'
+
+    return 'success'
+
+###############################################################################
+# Same with "geometry" members differing by their case, that json-c keeps
+# as distinct members.
+
+
+def ogr_geojson_streaming_2():
+
+    point = '{"type":"Point","coordinates":[1,2]}'
+    line = '{"type":"LineString","coordinates":[[3,4],[5,6]]}'
+    members = [
+        [('geometry', point), ('GEOMETRY', line)],
+        [('geometry', point), ('Geometry', 'null')],
+        [('geometry', point), ('GEOMETRY', '"foo"'), ('geometry', line)],
+    ]
+
+    for geoms in members:
+        feature = '{"type":"Feature",'
+        for (key, geom) in geoms:
+            feature += '"%s":%s,' % (key, geom)
+        feature += '"properties":{"a":1}}'
+        content = ('{"type":"FeatureCollection","features":[' + feature +
+                   ']}')
+
+        ref = ogr_geojson_streaming_read(content, False)
+        got = ogr_geojson_streaming_read(content, True)
+        if got != ref or got is None:
+            gdaltest.post_reason('fail')
+            print(content)
+            print(ref)
+            print(got)
+            return 'fail'
+
+    return 'success'
+
+
+gdaltest_list = [
+    ogr_geojson_streaming_1,
+    ogr_geojson_streaming_2]
+
+if __name__ == '__main__':
+
+    gdaltest.setup_run('ogr_geojson_streaming')
+
+    gdaltest.run_tests(gdaltest_list)
+
+    gdaltest.summarize()
@@ -0,0 +1,363 @@
+#!/usr/bin/env python
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  Test the GEOS cache enabled with OGR_G_EnableGEOSCache().
+#
+###############################################################################
+# Copyright (c) 2018, GDAL contributors
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+import ctypes
+import sys
+
+sys.path.append('../pymod')
+
+from osgeo import ogr
+
+import gdaltest
+import ogrtest
+
+# OGR_G_EnableGEOSCache() is not exposed by the bindings, so it is called
+# through ctypes.
+gdaltest.ogr_geos_cache_lib = None
+gdaltest.ogr_geos_cache_have_geos = False
+
+###############################################################################
+# Find the GDAL library used by the bindings.
+
+
+def ogr_geos_cache_init():
+
+    try:
+        maps = open('/proc/self/maps').read()
+    except (IOError, OSError):
+        return 'skip'
+    libname = None
+    for line in maps.split('\n'):
+        if 'libgdal' in line and '/' in line:
+            libname = line[line.find('/'):]
+            break
+    if libname is None:
+        return 'skip'
+
+    lib = ctypes.CDLL(libname)
+    lib.OGR_G_EnableGEOSCache.argtypes = [ctypes.c_void_p, ctypes.c_int]
+    gdaltest.ogr_geos_cache_lib = lib
+    gdaltest.ogr_geos_cache_have_geos = ogrtest.have_geos()
+
+    return 'success'
+
+###############################################################################
+# Enable or disable the GEOS cache of a geometry.
+
+
+def ogr_geos_cache_enable(geom, enable=True):
+
+    gdaltest.ogr_geos_cache_lib.OGR_G_EnableGEOSCache(int(geom.this),
+                                                      1 if enable else 0)
+
+###############################################################################
+# Evaluate all the predicates between geom and the test geometries, in both
+# orders.
+
+
+def ogr_geos_cache_predicates(geom, others):
+
+    ret = []
+    for other in others:
+        for (a, b) in [(geom, other), (other, geom)]:
+            ret.append((a.Intersects(b), a.Disjoint(b), a.Touches(b),
+                        a.Crosses(b), a.Within(b), a.Contains(b),
+                        a.Overlaps(b)))
+    return ret
+
+###############################################################################
+# Points, lines and polygons to test against, around the square
+# (0 0, 10 10).
+
+
+def ogr_geos_cache_test_geometries():
+
+    wkts = []
+    for x in range(-2, 14, 2):
+        for y in range(-2, 14, 3):
+            wkts.append('POINT (%d %d)' % (x, y))
+    wkts += ['LINESTRING (-5 5,15 5)', 'LINESTRING (0 0,10 0)',
+             'LINESTRING (4 4,6 6)', 'LINESTRING (20 20,30 30)',
+             'POLYGON ((5 5,15 5,15 15,5 15,5 5))',
+             'POLYGON ((1 1,9 1,9 9,1 9,1 1))',
+             'POLYGON ((-10 -10,20 -10,20 20,-10 20,-10 -10))',
+             'POLYGON ((10 0,20 0,20 10,10 10,10 0))',
+             'POLYGON ((4 4,6 4,6 6,4 6,4 4))']
+    return [ogr.CreateGeometryFromWkt(wkt) for wkt in wkts]
+
+###############################################################################
+# The predicates give the same result with the cache enabled, whichever
+# side of the call the cached geometry is on.
+
+
+def ogr_geos_cache_1():
+
+    if not gdaltest.ogr_geos_cache_have_geos:
+        return 'skip'
+
+    others = ogr_geos_cache_test_geometries()
+    for wkt in ['POLYGON ((0 0,10 0,10 10,0 10,0 0),(3 3,7 3,7 7,3 7,3 3))',
+                'MULTIPOLYGON (((0 0,10 0,10 10,0 10,0 0)),'
+                '((20 20,30 20,30 30,20 20)))',
+                'LINESTRING (0 0,10 10)', 'POINT (4 4)',
+                'CURVEPOLYGON (CIRCULARSTRING (0 5,5 0,10 5,5 10,0 5))',
+                'GEOMETRYCOLLECTION (POINT (4 4),LINESTRING (0 10,10 0))']:
+        geom = ogr.CreateGeometryFromWkt(wkt)
+        ref = ogr_geos_cache_predicates(geom, others)
+
+        ogr_geos_cache_enable(geom)
+        got = ogr_geos_cache_predicates(geom, others)
+        # Second time with the cache filled.
+        got2 = ogr_geos_cache_predicates(geom, others)
+        if got != ref or got2 != ref:
+            gdaltest.post_reason('fail')
+            print(wkt)
+            return 'fail'
+
+        ogr_geos_cache_enable(geom, False)
+        if ogr_geos_cache_predicates(geom, others) != ref:
+            gdaltest.post_reason('fail')
+            print(wkt)
+            return 'fail'
+
+    return 'success'
+
+###############################################################################
+# The cache is rebuilt when the geometry, or one of its parts, is modified.
+
+
+def ogr_geos_cache_2():
+
+    if not gdaltest.ogr_geos_cache_have_geos:
+        return 'skip'
+
+    inside = ogr.CreateGeometryFromWkt('POINT (15 5)')
+
+    # Modification of a ring of a polygon.
+    poly = ogr.CreateGeometryFromWkt('POLYGON ((0 0,10 0,10 10,0 10,0 0))')
+    ogr_geos_cache_enable(poly)
+    if poly.Contains(inside) or inside.Within(poly):
+        gdaltest.post_reason('fail')
+        return 'fail'
+    ring = poly.GetGeometryRef(0)
+    ring.SetPoint_2D(1, 20, 0)
+    ring.SetPoint_2D(2, 20, 10)
+    if not poly.Contains(inside) or not inside.Within(poly):
+        gdaltest.post_reason('ring modification not taken into account')
+        return 'fail'
+    ring.SwapXY()
+    if poly.Contains(inside):
+        gdaltest.post_reason('ring modification not taken into account')
+        return 'fail'
+    poly.SwapXY()
+    if not poly.Contains(inside):
+        gdaltest.post_reason('polygon modification not taken into account')
+        return 'fail'
+    poly.Empty()
+    if poly.Intersects(inside):
+        gdaltest.post_reason('polygon modification not taken into account')
+        return 'fail'
+
+    # Addition of a member to a collection, and modification of a member.
+    multi = ogr.CreateGeometryFromWkt(
+        'MULTIPOLYGON (((0 0,10 0,10 10,0 10,0 0)))')
+    ogr_geos_cache_enable(multi)
+    if multi.Intersects(inside):
+        gdaltest.post_reason('fail')
+        return 'fail'
+    multi.AddGeometry(ogr.CreateGeometryFromWkt(
+        'POLYGON ((12 0,20 0,20 10,12 10,12 0))'))
+    if not multi.Intersects(inside):
+        gdaltest.post_reason('member addition not taken into account')
+        return 'fail'
+    member_ring = multi.GetGeometryRef(1).GetGeometryRef(0)
+    member_ring.SetPoint_2D(0, 16, 0)
+    member_ring.SetPoint_2D(3, 16, 10)
+    member_ring.SetPoint_2D(4, 16, 0)
+    if multi.Intersects(inside):
+        gdaltest.post_reason('member modification not taken into account')
+        return 'fail'
+    # The ring is destroyed with its polygon.
+    member_ring = None
+    multi.RemoveGeometry(1)
+    multi.GetGeometryRef(0).GetGeometryRef(0).SetPoint_2D(1, 30, 0)
+    multi.GetGeometryRef(0).GetGeometryRef(0).SetPoint_2D(2, 30, 10)
+    if not multi.Intersects(inside):
+        gdaltest.post_reason('member modification not taken into account')
+        return 'fail'
+
+    # Modification of a point.
+    point = ogr.CreateGeometryFromWkt('POINT (5 5)')
+    square = ogr.CreateGeometryFromWkt('POLYGON ((0 0,10 0,10 10,0 10,0 0))')
+    ogr_geos_cache_enable(point)
+    if not point.Within(square):
+        gdaltest.post_reason('fail')
+        return 'fail'
+    point.SetPoint_2D(0, 50, 50)
+    if point.Within(square) or square.Intersects(point):
+        gdaltest.post_reason('point modification not taken into account')
+        return 'fail'
+
+    # Re-import of the geometry.
+    line = ogr.CreateGeometryFromWkt('LINESTRING (0 0,10 10)')
+    ogr_geos_cache_enable(line)
+    if not line.Intersects(square):
+        gdaltest.post_reason('fail')
+        return 'fail'
+    line.Segmentize(1)
+    if not line.Intersects(square):
+        gdaltest.post_reason('fail')
+        return 'fail'
+    line.FlattenTo2D()
+    line.Empty()
+    line.AddPoint_2D(20, 20)
+    line.AddPoint_2D(30, 30)
+    if line.Intersects(square):
+        gdaltest.post_reason('line modification not taken into account')
+        return 'fail'
+
+    return 'success'
+
+###############################################################################
+# Parts of a geometry with the cache enabled can be destroyed, and outlive
+# their parent, and copies of a geometry do not share its cache.
+
+
+def ogr_geos_cache_3():
+
+    if not gdaltest.ogr_geos_cache_have_geos:
+        return 'skip'
+
+    square = ogr.CreateGeometryFromWkt('POLYGON ((0 0,10 0,10 10,0 10,0 0))')
+    inside = ogr.CreateGeometryFromWkt('POINT (5 5)')
+
+    multi = ogr.CreateGeometryFromWkt(
+        'MULTIPOLYGON (((0 0,10 0,10 10,0 10,0 0)),'
+        '((20 0,30 0,30 10,20 10,20 0)))')
+    ogr_geos_cache_enable(multi)
+    if not multi.Intersects(inside):
+        gdaltest.post_reason('fail')
+        return 'fail'
+    member = multi.GetGeometryRef(1).Clone()
+    ogr_geos_cache_enable(member)
+    multi.RemoveGeometry(0)
+    if multi.Intersects(inside) or member.Intersects(inside):
+        gdaltest.post_reason('fail')
+        return 'fail'
+
+    # The ring is owned by the polygon, and kept alive by the binding.
+    poly = square.Clone()
+    ring = poly.GetGeometryRef(0)
+    ogr_geos_cache_enable(poly)
+    ogr_geos_cache_enable(ring)
+    if not poly.Contains(inside) or ring.Intersects(inside):
+        gdaltest.post_reason('fail')
+        return 'fail'
+
+    copy = poly.Clone()
+    poly.GetGeometryRef(0).SetPoint_2D(2, 4, 4)
+    if poly.Contains(inside) or not copy.Contains(inside):
+        gdaltest.post_reason('fail')
+        return 'fail'
+    poly = None
+    ring = None
+    if not copy.Contains(inside):
+        gdaltest.post_reason('fail')
+        return 'fail'
+
+    return 'success'
+
+###############################################################################
+# Geometries of all types with the cache enabled can be modified, copied,
+# emptied and destroyed, with or without GEOS, and give the same geometries
+# as without the cache.
+
+
+def ogr_geos_cache_modify(geom):
+
+    geom.SwapXY()
+    # Not supported by triangles.
+    with gdaltest.error_handler():
+        geom.Segmentize(2)
+    geom.FlattenTo2D()
+    copy = geom.Clone()
+    geom.Empty()
+    geom.AssignSpatialReference(None)
+    return copy.ExportToIsoWkt()
+
+
+def ogr_geos_cache_4():
+
+    if gdaltest.ogr_geos_cache_lib is None:
+        return 'skip'
+
+    for wkt in ['POINT (1 2)', 'LINESTRING (0 0,10 10)',
+                'POLYGON ((0 0,10 0,10 10,0 10,0 0),(3 3,7 3,7 7,3 7,3 3))',
+                'MULTIPOINT ((1 2),(3 4))',
+                'MULTILINESTRING ((0 0,1 1),(2 2,3 3))',
+                'MULTIPOLYGON (((0 0,10 0,10 10,0 10,0 0)))',
+                'GEOMETRYCOLLECTION (POINT (4 4),LINESTRING (0 10,10 0))',
+                'CIRCULARSTRING (0 0,1 1,2 0)',
+                'COMPOUNDCURVE ((0 0,1 1),CIRCULARSTRING (1 1,2 2,3 1))',
+                'CURVEPOLYGON (CIRCULARSTRING (0 5,5 0,10 5,5 10,0 5))',
+                'MULTICURVE ((0 0,1 1),CIRCULARSTRING (1 1,2 2,3 1))',
+                'MULTISURFACE (((0 0,10 0,10 10,0 10,0 0)))',
+                'POLYHEDRALSURFACE Z (((0 0 0,0 1 0,1 1 0,0 0 0)))',
+                'TIN Z (((0 0 0,0 1 0,1 1 0,0 0 0)))',
+                'TRIANGLE ((0 0,0 1,1 1,0 0))']:
+        ref = ogr_geos_cache_modify(ogr.CreateGeometryFromWkt(wkt))
+
+        geom = ogr.CreateGeometryFromWkt(wkt)
+        ogr_geos_cache_enable(geom)
+        for i in range(geom.GetGeometryCount()):
+            ogr_geos_cache_enable(geom.GetGeometryRef(i))
+        got = ogr_geos_cache_modify(geom)
+        geom = None
+        if got != ref:
+            gdaltest.post_reason('fail')
+            print(wkt, got, ref)
+            return 'fail'
+
+    return 'success'
+
+
+gdaltest_list = [
+    ogr_geos_cache_init,
+    ogr_geos_cache_1,
+    ogr_geos_cache_2,
+    ogr_geos_cache_3,
+    ogr_geos_cache_4]
+
+if __name__ == '__main__':
+
+    gdaltest.setup_run('ogr_geos_cache')
+
+    gdaltest.run_tests(gdaltest_list)
+
+    gdaltest.summarize()
@@ -0,0 +1,228 @@
+#!/usr/bin/env python
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  Test that the polygons assembled from the rings of a shapefile
+#           polygon are the expected ones, for small and large numbers of
+#           parts.
+#
+###############################################################################
+# Copyright (c) 2018, GDAL contributors
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+import math
+import random
+import sys
+
+sys.path.append('../pymod')
+
+from osgeo import gdal
+from osgeo import ogr
+
+import gdaltest
+
+###############################################################################
+# Return a ring as a list of (x, y) tuples, closed, with the shapefile
+# orientation: clockwise for outer rings and islands, counter-clockwise for
+# holes.
+
+
+def ogr_organize_polygons_ring(cx, cy, radius, nvertices, clockwise, phase=0):
+
+    sign = -1 if clockwise else 1
+    ring = []
+    for k in range(nvertices):
+        a = phase + sign * 2 * math.pi * k / nvertices
+        ring.append((cx + radius * math.cos(a), cy + radius * math.sin(a)))
+    ring.append(ring[0])
+    return ring
+
+###############################################################################
+# Build a grid of size x size cells. Each cell holds an outer ring with 5 to
+# 10 vertices. Every other cell has a hole, and every fourth cell an island
+# in that hole. Some holes are triangles whose first vertex is a vertex of
+# the outer ring. Return the rings in the order of the cells, and the
+# expected polygons, each as a list of rings, the exterior ring first.
+
+
+def ogr_organize_polygons_grid(size):
+
+    rings = []
+    expected = []
+    for idx in range(size * size):
+        cx = 10.0 * (idx % size)
+        cy = 10.0 * (idx // size)
+        outer = ogr_organize_polygons_ring(cx, cy, 4.5, 5 + idx % 6, True)
+        rings.append(outer)
+        polygon = [outer]
+        if idx % 6 == 2:
+            hole = [outer[0], (cx + 1, cy + 1), (cx + 1, cy - 1), outer[0]]
+            rings.append(hole)
+            polygon.append(hole)
+        elif idx % 2 == 0:
+            hole = ogr_organize_polygons_ring(cx, cy, 3, 4 + idx % 5, False)
+            rings.append(hole)
+            polygon.append(hole)
+            if idx % 4 == 0:
+                island = ogr_organize_polygons_ring(cx, cy, 1.5, 7, True,
+                                                    0.3)
+                rings.append(island)
+                expected.append([island])
+        expected.append(polygon)
+    return (rings, expected)
+
+###############################################################################
+# Canonical representation of a list of polygons given as lists of rings.
+
+
+def ogr_organize_polygons_canonical(polygons):
+
+    def ring_key(ring):
+        return tuple(ring)
+
+    return sorted((ring_key(p[0]), sorted(ring_key(r) for r in p[1:]))
+                  for p in polygons)
+
+
+def ogr_organize_polygons_from_geometry(geom):
+
+    if geom.GetGeometryType() == ogr.wkbPolygon:
+        geoms = [geom]
+    else:
+        geoms = [geom.GetGeometryRef(i)
+                 for i in range(geom.GetGeometryCount())]
+    polygons = []
+    for poly in geoms:
+        polygon = []
+        for i in range(poly.GetGeometryCount()):
+            ring = poly.GetGeometryRef(i)
+            polygon.append([(ring.GetX(k), ring.GetY(k))
+                            for k in range(ring.GetPointCount())])
+        polygons.append(polygon)
+    return ogr_organize_polygons_canonical(polygons)
+
+###############################################################################
+# Write each list of rings as the parts of a shapefile polygon, in the given
+# order and orientation, and read the polygons back with each organization
+# method.
+
+
+def ogr_organize_polygons_check(ring_lists, expected_lists, methods):
+
+    filename = '/vsimem/ogr_organize_polygons.shp'
+
+    gdal.SetConfigOption('SHAPE_REWIND_ON_WRITE', 'NO')
+    ds = ogr.GetDriverByName('ESRI Shapefile').CreateDataSource(filename)
+    lyr = ds.CreateLayer('ogr_organize_polygons', geom_type=ogr.wkbPolygon)
+    gdal.SetConfigOption('SHAPE_REWIND_ON_WRITE', None)
+    for rings in ring_lists:
+        # One single ring polygon per part, so that the parts are written
+        # in this order and with this orientation.
+        multi = ogr.Geometry(ogr.wkbMultiPolygon)
+        for ring in rings:
+            lr = ogr.Geometry(ogr.wkbLinearRing)
+            for (x, y) in ring:
+                lr.AddPoint_2D(x, y)
+            poly = ogr.Geometry(ogr.wkbPolygon)
+            poly.AddGeometry(lr)
+            multi.AddGeometry(poly)
+        f = ogr.Feature(lyr.GetLayerDefn())
+        f.SetGeometry(multi)
+        lyr.CreateFeature(f)
+    ds = None
+
+    ret = True
+    for method in methods:
+        gdal.SetConfigOption('OGR_ORGANIZE_POLYGONS', method)
+        ds = ogr.Open(filename)
+        lyr = ds.GetLayer(0)
+        for (i, expected) in enumerate(expected_lists):
+            f = lyr.GetNextFeature()
+            got = ogr_organize_polygons_from_geometry(f.GetGeometryRef())
+            if got != ogr_organize_polygons_canonical(expected):
+                gdaltest.post_reason('wrong polygons')
+                print(method, i, len(got), len(expected))
+                ret = False
+        ds = None
+        gdal.SetConfigOption('OGR_ORGANIZE_POLYGONS', None)
+        if not ret:
+            break
+
+    ogr.GetDriverByName('ESRI Shapefile').DeleteDataSource(filename)
+    return ret
+
+###############################################################################
+# Rings in the order of the cells: outer ring, then its hole, then the
+# island of the hole. Less than 16 parts go through the exhaustive scan,
+# more through the index of candidate enclosing rings.
+
+
+def ogr_organize_polygons_1():
+
+    ring_lists = []
+    expected_lists = []
+    for size in (1, 2, 3, 6, 12):
+        (rings, expected) = ogr_organize_polygons_grid(size)
+        ring_lists.append(rings)
+        expected_lists.append(expected)
+
+    if not ogr_organize_polygons_check(
+            ring_lists, expected_lists,
+            ['ONLY_CCW', 'DEFAULT', 'CCW_INNER_JUST_AFTER_CW_OUTER']):
+        return 'fail'
+
+    return 'success'
+
+###############################################################################
+# Same with the rings shuffled.
+
+
+def ogr_organize_polygons_2():
+
+    rng = random.Random(1)
+    ring_lists = []
+    expected_lists = []
+    for size in (2, 3, 6, 12):
+        for _ in range(3):
+            (rings, expected) = ogr_organize_polygons_grid(size)
+            rng.shuffle(rings)
+            ring_lists.append(rings)
+            expected_lists.append(expected)
+
+    if not ogr_organize_polygons_check(ring_lists, expected_lists,
+                                       ['ONLY_CCW', 'DEFAULT']):
+        return 'fail'
+
+    return 'success'
+
+
+gdaltest_list = [
+    ogr_organize_polygons_1,
+    ogr_organize_polygons_2]
+
+if __name__ == '__main__':
+
+    gdaltest.setup_run('ogr_organize_polygons')
+
+    gdaltest.run_tests(gdaltest_list)
+
+    gdaltest.summarize()
@@ -0,0 +1,279 @@
+#!/usr/bin/env python
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  Test OGR_L_RecycleFeature(): reading layers while giving the
+#           features back to them gives the same features as destroying
+#           them.
+#
+###############################################################################
+# Copyright (c) 2018, GDAL contributors
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+
+import ctypes
+import sys
+
+sys.path.append('../pymod')
+
+from osgeo import gdal
+from osgeo import ogr
+
+import gdaltest
+
+# OGR_L_RecycleFeature() is not exposed in the bindings, so the layers are
+# read through the C API with ctypes.
+gdaltest.ogr_recycle_feature_lib = None
+
+###############################################################################
+# Find the GDAL library used by the bindings, and create the test files: a
+# CSV file whose string fields alternate between short and long values, with
+# empty ones, and a shapefile with the same records.
+
+
+def ogr_recycle_feature_init():
+
+    try:
+        maps = open('/proc/self/maps').read()
+    except (IOError, OSError):
+        return 'skip'
+    libname = None
+    for line in maps.split('\n'):
+        if 'libgdal' in line and '/' in line:
+            libname = line[line.find('/'):]
+            break
+    if libname is None:
+        return 'skip'
+
+    lib = ctypes.CDLL(libname)
+    lib.OGR_L_ResetReading.argtypes = [ctypes.c_void_p]
+    lib.OGR_L_GetNextFeature.restype = ctypes.c_void_p
+    lib.OGR_L_GetNextFeature.argtypes = [ctypes.c_void_p]
+    lib.OGR_L_RecycleFeature.argtypes = [ctypes.c_void_p, ctypes.c_void_p]
+    lib.OGR_F_Destroy.argtypes = [ctypes.c_void_p]
+    lib.OGR_F_GetFID.restype = ctypes.c_longlong
+    lib.OGR_F_GetFID.argtypes = [ctypes.c_void_p]
+    lib.OGR_F_GetFieldCount.argtypes = [ctypes.c_void_p]
+    lib.OGR_F_IsFieldSetAndNotNull.argtypes = [ctypes.c_void_p, ctypes.c_int]
+    lib.OGR_F_GetFieldAsString.restype = ctypes.c_char_p
+    lib.OGR_F_GetFieldAsString.argtypes = [ctypes.c_void_p, ctypes.c_int]
+    lib.OGR_F_GetGeometryRef.restype = ctypes.c_void_p
+    lib.OGR_F_GetGeometryRef.argtypes = [ctypes.c_void_p]
+    lib.OGR_G_ExportToIsoWkt.argtypes = [ctypes.c_void_p,
+                                         ctypes.POINTER(ctypes.c_void_p)]
+    lib.VSIFree.argtypes = [ctypes.c_void_p]
+    gdaltest.ogr_recycle_feature_lib = lib
+
+    content = 'id,name,val,x,y\n'
+    for i in range(200):
+        if i % 7 == 3:
+            name = ''
+        elif i % 2 == 0:
+            name = 'a' * (1 + i % 5)
+        else:
+            name = 'long value ' * (1 + i % 13)
+        content += '%d,"%s",%s,%d.5,%d.25\n' % (
+            i, name, '' if i % 5 == 0 else str(i * 3), i % 17, i % 11)
+    gdal.FileFromMemBuffer('/vsimem/ogr_recycle_feature.csv', content)
+    gdal.FileFromMemBuffer('/vsimem/ogr_recycle_feature.csvt',
+                           'Integer,String,Integer,Real,Real\n')
+
+    src_ds = gdal.OpenEx('/vsimem/ogr_recycle_feature.csv',
+                         open_options=['X_POSSIBLE_NAMES=x',
+                                       'Y_POSSIBLE_NAMES=y'])
+    ds = gdal.VectorTranslate('/vsimem/ogr_recycle_feature.shp', src_ds,
+                              format='ESRI Shapefile')
+    ds = None
+    src_ds = None
+
+    return 'success'
+
+###############################################################################
+# Read all the features of a layer, and return their FID, fields and
+# geometry. The features are given back to the layer with
+# OGR_L_RecycleFeature() if recycle is True, and destroyed otherwise.
+
+
+def ogr_recycle_feature_read(lyr, recycle):
+
+    lib = gdaltest.ogr_recycle_feature_lib
+    hLayer = int(lyr.this)
+
+    ret = []
+    lib.OGR_L_ResetReading(hLayer)
+    while True:
+        hFeat = lib.OGR_L_GetNextFeature(hLayer)
+        if not hFeat:
+            break
+        values = [lib.OGR_F_GetFID(hFeat)]
+        for i in range(lib.OGR_F_GetFieldCount(hFeat)):
+            if lib.OGR_F_IsFieldSetAndNotNull(hFeat, i):
+                values.append(lib.OGR_F_GetFieldAsString(hFeat, i))
+            else:
+                values.append(None)
+        hGeom = lib.OGR_F_GetGeometryRef(hFeat)
+        if hGeom:
+            wkt = ctypes.c_void_p()
+            lib.OGR_G_ExportToIsoWkt(hGeom, ctypes.byref(wkt))
+            values.append(ctypes.string_at(wkt.value))
+            lib.VSIFree(wkt)
+        ret.append(values)
+        if recycle:
+            lib.OGR_L_RecycleFeature(hLayer, hFeat)
+        else:
+            lib.OGR_F_Destroy(hFeat)
+    return ret
+
+###############################################################################
+# Compare the features read with and without recycling, twice in a row so
+# that the second pass starts with features in the pool of the layer.
+
+
+def ogr_recycle_feature_compare(lyr, min_count):
+
+    ref = ogr_recycle_feature_read(lyr, False)
+    if len(ref) < min_count:
+        gdaltest.post_reason('too few features')
+        print(len(ref))
+        return False
+    for _ in range(2):
+        got = ogr_recycle_feature_read(lyr, True)
+        if got != ref:
+            gdaltest.post_reason('features differ when recycled')
+            for (a, b) in zip(ref, got):
+                if a != b:
+                    print(a, b)
+                    break
+            return False
+
+    # With an attribute filter, the drivers recycle the features they skip.
+    lyr.SetAttributeFilter('val > 300')
+    ref = ogr_recycle_feature_read(lyr, False)
+    got = ogr_recycle_feature_read(lyr, True)
+    lyr.SetAttributeFilter(None)
+    if got != ref or not ref:
+        gdaltest.post_reason('filtered features differ when recycled')
+        return False
+
+    return True
+
+###############################################################################
+# CSV, shapefile and a union of both in an OGR VRT.
+
+
+def ogr_recycle_feature_1():
+
+    if gdaltest.ogr_recycle_feature_lib is None:
+        return 'skip'
+
+    for filename in ['/vsimem/ogr_recycle_feature.csv',
+                     '/vsimem/ogr_recycle_feature.shp']:
+        ds = ogr.Open(filename)
+        if not ogr_recycle_feature_compare(ds.GetLayer(0), 200):
+            print(filename)
+            return 'fail'
+        ds = None
+
+    ds = ogr.Open("""<OGRVRTDataSource>
+    <OGRVRTUnionLayer name="union">
+        <OGRVRTLayer name="ogr_recycle_feature">
+            <SrcDataSource>/vsimem/ogr_recycle_feature.csv</SrcDataSource>
+        </OGRVRTLayer>
+        <OGRVRTLayer name="ogr_recycle_feature">
+            <SrcDataSource>/vsimem/ogr_recycle_feature.shp</SrcDataSource>
+        </OGRVRTLayer>
+    </OGRVRTUnionLayer>
+</OGRVRTDataSource>""")
+    if not ogr_recycle_feature_compare(ds.GetLayer(0), 400):
+        print('union')
+        return 'fail'
+    ds = None
+
+    return 'success'
+
+###############################################################################
+# Fields added to the layer while features are kept by it.
+
+
+def ogr_recycle_feature_2():
+
+    if gdaltest.ogr_recycle_feature_lib is None:
+        return 'skip'
+
+    src_ds = ogr.Open('/vsimem/ogr_recycle_feature.csv')
+    ds = ogr.GetDriverByName('Memory').CreateDataSource('')
+    lyr = ds.CopyLayer(src_ds.GetLayer(0), 'test')
+    src_ds = None
+
+    before = ogr_recycle_feature_read(lyr, True)
+    lyr.CreateField(ogr.FieldDefn('added', ogr.OFTString))
+    lyr.ResetReading()
+    feat = lyr.GetNextFeature()
+    while feat is not None:
+        feat.SetField('added', 'added value %d' % feat.GetFID())
+        lyr.SetFeature(feat)
+        feat = lyr.GetNextFeature()
+    got = ogr_recycle_feature_read(lyr, True)
+    ref = ogr_recycle_feature_read(lyr, False)
+    if got != ref:
+        gdaltest.post_reason('features differ when recycled')
+        return 'fail'
+    if [values[0:-1] for values in got] != before:
+        gdaltest.post_reason('fail')
+        return 'fail'
+
+    # Features recycled with the new field, then the layer destroyed after
+    # another field is added.
+    ogr_recycle_feature_read(lyr, True)
+    lyr.CreateField(ogr.FieldDefn('added2', ogr.OFTString))
+    lyr = None
+    ds = None
+
+    return 'success'
+
+###############################################################################
+# Cleanup
+
+
+def ogr_recycle_feature_cleanup():
+
+    gdal.Unlink('/vsimem/ogr_recycle_feature.csv')
+    gdal.Unlink('/vsimem/ogr_recycle_feature.csvt')
+    ogr.GetDriverByName('ESRI Shapefile').DeleteDataSource(
+        '/vsimem/ogr_recycle_feature.shp')
+
+    return 'success'
+
+
+gdaltest_list = [
+    ogr_recycle_feature_init,
+    ogr_recycle_feature_1,
+    ogr_recycle_feature_2,
+    ogr_recycle_feature_cleanup]
+
+if __name__ == '__main__':
+
+    gdaltest.setup_run('ogr_recycle_feature')
+
+    gdaltest.run_tests(gdaltest_list)
+
+    gdaltest.summarize()
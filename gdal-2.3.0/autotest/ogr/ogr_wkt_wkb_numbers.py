@@ -0,0 +1,329 @@
+#!/usr/bin/env python
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  Test the byte swapping of big endian WKB, and the parsing and
+#           formatting of WKT coordinates.
+#
+###############################################################################
+# Copyright (c) 2018, GDAL contributors
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+import math
+import random
+import struct
+import sys
+
+sys.path.append('../pymod')
+
+from osgeo import ogr
+
+import gdaltest
+
+###############################################################################
+# Coordinates of various magnitudes, with many decimals, with trailing
+# 0s and 9s after rounding, and special values.
+
+
+def ogr_wkt_wkb_numbers_values(count, seed):
+
+    rng = random.Random(seed)
+    values = []
+    for i in range(count):
+        kind = i % 8
+        if kind == 0:
+            values.append(rng.uniform(-180, 180))
+        elif kind == 1:
+            values.append(rng.uniform(-1, 1))
+        elif kind == 2:
+            values.append(rng.uniform(-1e7, 1e7))
+        elif kind == 3:
+            values.append(round(rng.uniform(-1000, 1000), rng.randint(0, 9)))
+        elif kind == 4:
+            values.append(rng.randint(-100000, 100000) / 10.0 + 1e-9)
+        elif kind == 5:
+            values.append(rng.randint(-100000, 100000) / 10.0 - 1e-9)
+        elif kind == 6:
+            values.append(math.ldexp(rng.random(), rng.randint(-60, 60)))
+        else:
+            values.append(rng.choice([0.1 + 0.2, 1.0 / 3, 2.0 / 3, 1e-5,
+                                      123456789012.5, -0.0, 0.5, 1e15,
+                                      1e16 + 2, 4.35, 0.000001234]))
+    return values
+
+###############################################################################
+# Port of OGRFormatDouble(). Python formats doubles exactly, like the C
+# library does.
+
+
+def ogr_wkt_wkb_numbers_format_double(val, precision, spec):
+
+    if math.isinf(val):
+        return 'inf' if val > 0 else '-inf'
+    if math.isnan(val):
+        return 'nan'
+
+    buf = ('%%.%d%s' % (precision, spec)) % val
+    if spec == 'g' and 'e' in buf:
+        return buf
+
+    truncations = 0
+    while precision > 0:
+        count_before_dot = 0
+        dot_pos = -1
+        for (i, c) in enumerate(buf):
+            if c == '.':
+                dot_pos = i
+            elif dot_pos < 0 and c != '-':
+                count_before_dot += 1
+        if dot_pos < 0:
+            break
+
+        i = len(buf)
+        if i > 10:
+            if buf[i - 6:i - 1] == '00000':
+                i -= 1
+                buf = buf[:i]
+            elif i - 8 > dot_pos and \
+                    (count_before_dot >= 4 or buf[i - 3] == '0') and \
+                    (count_before_dot >= 5 or buf[i - 4] == '0') and \
+                    (count_before_dot >= 6 or buf[i - 5] == '0') and \
+                    (count_before_dot >= 7 or buf[i - 6] == '0') and \
+                    (count_before_dot >= 8 or buf[i - 7] == '0') and \
+                    buf[i - 8] == '0' and buf[i - 9] == '0':
+                i -= 8
+                buf = buf[:i]
+
+        while i > 2 and buf[i - 1] == '0' and buf[i - 2] != '.':
+            i -= 1
+            buf = buf[:i]
+
+        if i > 10 and precision + truncations >= 15:
+            if buf[i - 6:i - 1] == '99999' or \
+               (i - 9 > dot_pos and
+                (count_before_dot >= 4 or buf[i - 3] == '9') and
+                (count_before_dot >= 5 or buf[i - 4] == '9') and
+                (count_before_dot >= 6 or buf[i - 5] == '9') and
+                (count_before_dot >= 7 or buf[i - 6] == '9') and
+                (count_before_dot >= 8 or buf[i - 7] == '9') and
+                buf[i - 8] == '9' and buf[i - 9] == '9'):
+                precision -= 1
+                truncations += 1
+                buf = ('%%.%d%s' % (precision, spec)) % val
+                if spec == 'g' and 'e' in buf:
+                    return buf
+                continue
+
+        break
+
+    return buf
+
+###############################################################################
+# Port of OGRMakeWktCoordinateM() with the default precision of 15.
+
+
+def ogr_wkt_wkb_numbers_is_int(d):
+    if not -2147483648 <= d <= 2147483647:
+        return False
+    return d == float(int(d))
+
+
+def ogr_wkt_wkb_numbers_coordinate(coords):
+
+    x, y = coords[0], coords[1]
+    if ogr_wkt_wkb_numbers_is_int(x) and ogr_wkt_wkb_numbers_is_int(y):
+        parts = ['%d' % int(x), '%d' % int(y)]
+    else:
+        parts = []
+        for v in (x, y):
+            s = ogr_wkt_wkb_numbers_format_double(
+                v, 15, 'f' if abs(v) < 1 else 'g')
+            if not math.isinf(v) and not math.isnan(v) and \
+               '.' not in s and 'e' not in s:
+                s += '.0'
+            parts.append(s)
+    for v in coords[2:]:
+        if ogr_wkt_wkb_numbers_is_int(v):
+            parts.append('%d' % int(v))
+        else:
+            parts.append(ogr_wkt_wkb_numbers_format_double(v, 15, 'g'))
+    return ' '.join(parts)
+
+###############################################################################
+# Formatting of XY, XYZ and XYZM coordinates matches the formatting rules
+# applied with snprintf().
+
+
+def ogr_wkt_wkb_numbers_1():
+
+    values = ogr_wkt_wkb_numbers_values(40000, 1)
+    values += [float('inf'), float('-inf')]
+
+    for dim in (2, 3, 4):
+        g = ogr.Geometry(ogr.wkbLineString)
+        if dim == 3:
+            g.Set3D(True)
+        elif dim == 4:
+            g.Set3D(True)
+            g.SetMeasured(True)
+        coords = []
+        for i in range(0, len(values) - dim + 1, dim):
+            c = values[i:i + dim]
+            coords.append(c)
+            if dim == 2:
+                g.AddPoint_2D(c[0], c[1])
+            elif dim == 3:
+                g.AddPoint(c[0], c[1], c[2])
+            else:
+                g.AddPointZM(c[0], c[1], c[2], c[3])
+        got = g.ExportToIsoWkt()
+        got = got[got.find('(') + 1:-1].split(',')
+        for (i, c) in enumerate(coords):
+            expected = ogr_wkt_wkb_numbers_coordinate(c)
+            if got[i] != expected:
+                gdaltest.post_reason('formatting differs')
+                print(c, got[i], expected)
+                return 'fail'
+
+    return 'success'
+
+###############################################################################
+# Parsing decimal tokens gives the correctly rounded double, including
+# significands longer than 2^53 and large powers of ten.
+
+
+def ogr_wkt_wkb_numbers_2():
+
+    rng = random.Random(2)
+    tokens = ['0', '-0', '0.0', '.5', '5.', '-.25', '1e22', '1e23',
+              '9007199254740992', '9007199254740993', '9007199254740993.0',
+              '123456789012345678901234567890', '0.1', '-0.3', '1e-22',
+              '1e-23', '4.9e-324', '2.2250738585072014e-308',
+              '1.7976931348623157e308', '1E5', '1e+5', '2.5E-3']
+    for _ in range(20000):
+        digits = ''.join(rng.choice('0123456789')
+                         for _ in range(rng.randint(1, 20)))
+        dot = rng.randint(0, len(digits))
+        token = digits[:dot] + '.' + digits[dot:] if dot < len(digits) \
+            else digits
+        if rng.randint(0, 3) == 0:
+            token += 'e%d' % rng.randint(-30, 30)
+        if rng.randint(0, 1) == 0:
+            token = '-' + token
+        tokens.append(token)
+
+    for dim in (2, 3, 4):
+        if len(tokens) % dim:
+            tokens_dim = tokens[:len(tokens) - len(tokens) % dim]
+        else:
+            tokens_dim = tokens
+        points = [' '.join(tokens_dim[i:i + dim])
+                  for i in range(0, len(tokens_dim), dim)]
+        wkt = 'LINESTRING %s(%s)' % (['', '', 'Z ', 'ZM '][dim - 1],
+                                     ','.join(points))
+        g = ogr.CreateGeometryFromWkt(wkt)
+        if g is None or g.GetPointCount() != len(points):
+            gdaltest.post_reason('parsing failed')
+            return 'fail'
+        for i in range(g.GetPointCount()):
+            got = [g.GetX(i), g.GetY(i), g.GetZ(i), g.GetM(i)][:dim]
+            expected = [float(t) for t in tokens_dim[i * dim:i * dim + dim]]
+            if struct.pack('d' * dim, *got) != \
+               struct.pack('d' * dim, *expected):
+                gdaltest.post_reason('parsing differs')
+                print(tokens_dim[i * dim:i * dim + dim], got, expected)
+                return 'fail'
+
+    return 'success'
+
+###############################################################################
+# Big endian WKB of curves and rings of every length up to a few vectors is
+# written as expected, and read back to the same coordinates.
+
+
+def ogr_wkt_wkb_numbers_3():
+
+    values = ogr_wkt_wkb_numbers_values(64, 3)
+
+    for n in range(12):
+        for (dim, flag, iso) in [(2, 0, False), (3, 0x80000000, False),
+                                 (3, 1000, True), (4, 3000, True)]:
+            coords = [values[i * dim:i * dim + dim] for i in range(n)]
+            ls = ogr.Geometry(ogr.wkbLineString)
+            ring = ogr.Geometry(ogr.wkbLinearRing)
+            for g in (ls, ring):
+                if dim >= 3:
+                    g.Set3D(True)
+                if dim == 4:
+                    g.SetMeasured(True)
+                for c in coords:
+                    if dim == 2:
+                        g.AddPoint_2D(c[0], c[1])
+                    elif dim == 3:
+                        g.AddPoint(c[0], c[1], c[2])
+                    else:
+                        g.AddPointZM(c[0], c[1], c[2], c[3])
+            poly = ogr.Geometry(ogr.wkbPolygon)
+            if dim >= 3:
+                poly.Set3D(True)
+            if dim == 4:
+                poly.SetMeasured(True)
+            poly.AddGeometry(ring)
+
+            flat = [v for c in coords for v in c]
+            body = struct.pack('>I', n) + struct.pack('>' + 'd' * len(flat),
+                                                      *flat)
+            expected_ls = struct.pack('>BI', 0, 2 + flag) + body
+            expected_poly = struct.pack('>BII', 0, 3 + flag, 1) + body
+
+            for (g, expected) in [(ls, expected_ls), (poly, expected_poly)]:
+                if iso:
+                    got = g.ExportToIsoWkb(ogr.wkbXDR)
+                else:
+                    got = g.ExportToWkb(ogr.wkbXDR)
+                if bytes(got) != expected:
+                    gdaltest.post_reason('WKB differs')
+                    print(n, dim, g.ExportToIsoWkt())
+                    return 'fail'
+                g2 = ogr.CreateGeometryFromWkb(expected)
+                if g2 is None or \
+                   bytes(g2.ExportToIsoWkb(ogr.wkbNDR)) != \
+                   bytes(g.ExportToIsoWkb(ogr.wkbNDR)):
+                    gdaltest.post_reason('WKB read differs')
+                    print(n, dim, g.ExportToIsoWkt())
+                    return 'fail'
+
+    return 'success'
+
+
+gdaltest_list = [
+    ogr_wkt_wkb_numbers_1,
+    ogr_wkt_wkb_numbers_2,
+    ogr_wkt_wkb_numbers_3]
+
+if __name__ == '__main__':
+
+    gdaltest.setup_run('ogr_wkt_wkb_numbers')
+
+    gdaltest.run_tests(gdaltest_list)
+
+    gdaltest.summarize()
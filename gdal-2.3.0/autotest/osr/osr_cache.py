@@ -0,0 +1,218 @@
+#!/usr/bin/env python
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  Test the caches of EPSG imports and of coordinate
+#           transformations (OSR_EPSG_CACHE_SIZE and OGR_CT_CACHE_SIZE).
+#
+###############################################################################
+# Copyright (c) 2018, GDAL contributors
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+
+import os
+import subprocess
+import sys
+
+sys.path.append('../pymod')
+
+from osgeo import osr
+
+import gdaltest
+
+# The cache sizes are read once per process, so the comparisons with and
+# without the caches are done in child processes, with CPL_DEBUG=ON. The
+# child prints the WKT of the imports and of the transformed points on its
+# standard output, and the cache statistics are emitted as debug messages
+# on its standard error when GDALDestroyDriverManager() releases the
+# caches.
+osr_cache_child_script = """
+from osgeo import gdal
+from osgeo import osr
+
+for i in range(3):
+    for code in [4326, 4269, 32631, 2154, 27700, 3857]:
+        srs = osr.SpatialReference()
+        srs.ImportFromEPSG(code)
+        print(srs.ExportToWkt())
+        srs = osr.SpatialReference()
+        srs.ImportFromEPSGA(code)
+        print(srs.ExportToWkt())
+        # Modifying an imported SRS must not change later imports.
+        srs.SetLinearUnits('foot', 0.3048)
+        srs.SetAttrValue('GEOGCS|DATUM', 'modified')
+
+    src = osr.SpatialReference()
+    src.ImportFromEPSG(4326)
+    for code in [32631, 2154, 3857]:
+        dst = osr.SpatialReference()
+        dst.ImportFromEPSG(code)
+        ct = osr.CoordinateTransformation(src, dst)
+        if ct is None or ct.this is None:
+            print('no CT')
+            continue
+        print(ct.TransformPoint(2, 49, 0))
+        print(ct.TransformPoints([(-1, 45, 0), (3, 50, 10)]))
+        ct = None
+
+gdal.GDALDestroyDriverManager()
+"""
+
+###############################################################################
+# Run the child script with the given cache sizes. Returns the list of
+# results, and the list of debug messages.
+
+
+def osr_cache_run(epsg_cache_size, ct_cache_size):
+
+    env = dict(os.environ)
+    for (key, val) in [('OSR_EPSG_CACHE_SIZE', epsg_cache_size),
+                       ('OGR_CT_CACHE_SIZE', ct_cache_size)]:
+        if val is None:
+            env.pop(key, None)
+        else:
+            env[key] = val
+    env['PYTHONPATH'] = os.pathsep.join(sys.path)
+    env['CPL_DEBUG'] = 'ON'
+
+    p = subprocess.Popen([sys.executable, '-c', osr_cache_child_script],
+                         env=env, stdout=subprocess.PIPE,
+                         stderr=subprocess.PIPE)
+    (out, err) = p.communicate()
+    if p.returncode != 0:
+        return (None, None)
+    if sys.version_info >= (3, 0, 0):
+        out = out.decode('utf-8')
+        err = err.decode('utf-8')
+
+    return (out.split('\n'), err.split('\n'))
+
+###############################################################################
+# Find the "<category>: <what>: N hits, M misses" debug message, and return
+# (N, M), or None if it was not emitted.
+
+
+def osr_cache_stats(messages, what):
+
+    for msg in messages:
+        pos = msg.find(': ' + what + ': ')
+        if pos >= 0:
+            fields = msg[pos + len(what) + 4:].split(' ')
+            return (int(fields[0]), int(fields[2]))
+    return None
+
+###############################################################################
+# EPSG imports are identical with and without the cache, the cache is hit
+# for repeated imports, and OSR_EPSG_CACHE_SIZE=0 disables it.
+
+
+def osr_cache_1():
+
+    (ref, ref_messages) = osr_cache_run('0', '0')
+    if ref is None:
+        gdaltest.post_reason('child process failed')
+        return 'fail'
+    if osr_cache_stats(ref_messages, 'EPSG import cache') is not None:
+        gdaltest.post_reason('cache should be disabled')
+        print(ref_messages)
+        return 'fail'
+
+    # Each import of the child script is done 3 times, with its WKT
+    # printed each time.
+    for (epsg_cache_size, min_hits) in [(None, 24), ('256', 24), ('1', 0)]:
+        (got, messages) = osr_cache_run(epsg_cache_size, '0')
+        if got != ref:
+            gdaltest.post_reason('imports differ with the cache')
+            print(epsg_cache_size)
+            return 'fail'
+        stats = osr_cache_stats(messages, 'EPSG import cache')
+        if stats is None or stats[0] < min_hits or stats[1] == 0:
+            gdaltest.post_reason('fail')
+            print(epsg_cache_size, messages)
+            return 'fail'
+
+    # The imports repeated in the parent process give the same results.
+    for code in [4326, 32631]:
+        srs = osr.SpatialReference()
+        srs.ImportFromEPSG(code)
+        wkt = srs.ExportToWkt()
+        srs.SetLinearUnits('foot', 0.3048)
+        srs2 = osr.SpatialReference()
+        srs2.ImportFromEPSG(code)
+        if srs2.ExportToWkt() != wkt:
+            gdaltest.post_reason('fail')
+            print(code)
+            return 'fail'
+
+    return 'success'
+
+###############################################################################
+# Coordinate transformations are identical with and without the cache, and
+# OGR_CT_CACHE_SIZE=0 disables it.
+
+
+def osr_cache_2():
+
+    (ref, ref_messages) = osr_cache_run('0', '0')
+    if ref is None:
+        gdaltest.post_reason('child process failed')
+        return 'fail'
+    if 'no CT' in ref:
+        return 'skip'
+    stats = osr_cache_stats(ref_messages, 'Transformation cache')
+    if stats is not None and stats[0] != 0:
+        gdaltest.post_reason('cache should be disabled')
+        print(ref_messages)
+        return 'fail'
+
+    # 3 transformations per iteration, the first one of each pair misses.
+    for ct_cache_size in [None, '64', '1']:
+        (got, messages) = osr_cache_run('0', ct_cache_size)
+        if got != ref:
+            gdaltest.post_reason('transformations differ with the cache')
+            print(ct_cache_size)
+            return 'fail'
+        stats = osr_cache_stats(messages, 'Transformation cache')
+        if stats is None:
+            gdaltest.post_reason('fail')
+            print(ct_cache_size, messages)
+            return 'fail'
+        expected_hits = 0 if ct_cache_size == '1' else 6
+        if stats[0] != expected_hits or stats[0] + stats[1] != 9:
+            gdaltest.post_reason('fail')
+            print(ct_cache_size, messages)
+            return 'fail'
+
+    return 'success'
+
+
+gdaltest_list = [
+    osr_cache_1,
+    osr_cache_2]
+
+if __name__ == '__main__':
+
+    gdaltest.setup_run('osr_cache')
+
+    gdaltest.run_tests(gdaltest_list)
+
+    gdaltest.summarize()
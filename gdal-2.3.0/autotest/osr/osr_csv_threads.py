@@ -0,0 +1,191 @@
+#!/usr/bin/env python
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  Test the lookups in the CSV files of GDAL_DATA from several
+#           threads, which share the ingested content of the files.
+#
+###############################################################################
+# Copyright (c) 2018, GDAL contributors
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+
+
+import os
+import subprocess
+import sys
+
+sys.path.append('../pymod')
+
+from osgeo import gdal
+
+import gdaltest
+
+# The lookups are done in a child process, with the EPSG import cache
+# disabled so that each import reads the CSV files, and with GDAL_DATA
+# pointing to a copy of the CSV files in /vsimem, so that they can be
+# modified. The child prints one line per check.
+osr_csv_threads_child_script = """
+import os
+import sys
+import threading
+from osgeo import gdal
+from osgeo import osr
+
+for f in os.listdir(sys.argv[1]):
+    if f.endswith('.csv'):
+        with open(os.path.join(sys.argv[1], f), 'rb') as fp:
+            gdal.FileFromMemBuffer('/vsimem/osr_csv_data/' + f, fp.read())
+gdal.SetConfigOption('GDAL_DATA', '/vsimem/osr_csv_data')
+
+def srs_name(code, result):
+    srs = osr.SpatialReference()
+    srs.ImportFromEPSG(code)
+    result.append(srs.GetAttrValue('PROJCS') or srs.GetAttrValue('GEOGCS'))
+
+# A thread keeps a reference on the ingested pcs.override.csv, while it is
+# modified. A thread starting afterwards must see the new content.
+result1 = []
+release = threading.Event()
+def holder():
+    srs_name(32631, result1)
+    release.wait()
+    srs_name(32631, result1)
+t1 = threading.Thread(target=holder)
+t1.start()
+while not result1:
+    release.wait(0.01)
+
+line = '32631,"Modified UTM zone 31N",9001,4326,16031,9807,1,0,4400,' + \\
+    '8801,0,9102,8802,3,9102,8805,0.9996,9201,8806,500000,9001,' + \\
+    '8807,0,9001,,,,,,,,,,,,,\\n'
+f = gdal.VSIFOpenL('/vsimem/osr_csv_data/pcs.override.csv', 'ab')
+gdal.VSIFWriteL(line, 1, len(line), f)
+gdal.VSIFCloseL(f)
+
+result2 = []
+t2 = threading.Thread(target=srs_name, args=(32631, result2))
+t2.start()
+t2.join()
+release.set()
+t1.join()
+print('stale %s' % (result1 + result2))
+
+# Concurrent lookups, from threads that start and end at different times,
+# give the same results as a single thread.
+codes = [4326, 4267, 4258, 2154, 27700, 3857, 26910, 28992, 31467] + \\
+    list(range(32601, 32661, 3)) + list(range(32701, 32761, 7))
+ref = []
+t = threading.Thread(target=lambda: [srs_name(c, ref) for c in codes])
+t.start()
+t.join()
+
+errors = []
+def worker(k):
+    for i in range(3 + k % 4):
+        got = []
+        for c in codes[k:] + codes[:k]:
+            srs_name(c, got)
+        got = got[len(codes) - k:] + got[:len(codes) - k]
+        if got != ref:
+            errors.append(k)
+threads = [threading.Thread(target=worker, args=(k,)) for k in range(8)]
+for t in threads:
+    t.start()
+for t in threads:
+    t.join()
+print('threads %d %d %d' % (len(codes), len([r for r in ref if r]),
+                             len(errors)))
+
+gdal.GDALDestroyDriverManager()
+"""
+
+###############################################################################
+# Run the child script. Returns its output lines.
+
+
+def osr_csv_threads_run():
+
+    data_dir = gdal.GetConfigOption('GDAL_DATA')
+    if data_dir is None or \
+       not os.path.exists(os.path.join(data_dir, 'pcs.override.csv')):
+        return None
+
+    env = dict(os.environ)
+    env['OSR_EPSG_CACHE_SIZE'] = '0'
+    env['PYTHONPATH'] = os.pathsep.join(sys.path)
+
+    p = subprocess.Popen([sys.executable, '-c', osr_csv_threads_child_script,
+                          data_dir],
+                         env=env, stdout=subprocess.PIPE,
+                         stderr=subprocess.PIPE)
+    (out, err) = p.communicate()
+    if sys.version_info >= (3, 0, 0):
+        out = out.decode('utf-8')
+        err = err.decode('utf-8')
+    if p.returncode != 0:
+        print(err)
+        return []
+
+    return out.split('\n')
+
+###############################################################################
+# A CSV file modified while another thread still uses its previous content
+# is read again by the threads that access it afterwards, and concurrent
+# lookups agree with the single threaded ones.
+
+
+def osr_csv_threads_1():
+
+    lines = osr_csv_threads_run()
+    if lines is None:
+        return 'skip'
+    if len(lines) < 2:
+        gdaltest.post_reason('child process failed')
+        return 'fail'
+
+    expected = "stale ['WGS 84 / UTM zone 31N', 'WGS 84 / UTM zone 31N', " + \
+        "'Modified UTM zone 31N']"
+    if lines[0] != expected:
+        gdaltest.post_reason('modified CSV file not read again')
+        print(lines[0])
+        return 'fail'
+
+    fields = lines[1].split(' ')
+    if fields[0] != 'threads' or fields[1] != fields[2] or fields[3] != '0':
+        gdaltest.post_reason('lookups differ between threads')
+        print(lines[1])
+        return 'fail'
+
+    return 'success'
+
+
+gdaltest_list = [
+    osr_csv_threads_1]
+
+if __name__ == '__main__':
+
+    gdaltest.setup_run('osr_csv_threads')
+
+    gdaltest.run_tests(gdaltest_list)
+
+    gdaltest.summarize()
@@ -0,0 +1,343 @@
+#!/usr/bin/env python
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  Compare the built-in coordinate transformations enabled with
+#           OGR_CT_FAST_PATH=YES with PROJ.
+#
+###############################################################################
+# Copyright (c) 2018, GDAL contributors
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+import ctypes
+import math
+import sys
+
+sys.path.append('../pymod')
+
+from osgeo import gdal
+from osgeo import osr
+
+import gdaltest
+
+# The transformations are done through the C API with ctypes, so as to
+# get the per-point success flags, and to be able to pass a NULL Z array.
+gdaltest.osr_ct_fastpath_lib = None
+
+###############################################################################
+# Find the GDAL library used by the bindings, and check that PROJ is
+# available.
+
+
+def osr_ct_fastpath_init():
+
+    try:
+        maps = open('/proc/self/maps').read()
+    except (IOError, OSError):
+        return 'skip'
+    libname = None
+    for line in maps.split('\n'):
+        if 'libgdal' in line and '/' in line:
+            libname = line[line.find('/'):]
+            break
+    if libname is None:
+        return 'skip'
+
+    lib = ctypes.CDLL(libname)
+    lib.OSRNewSpatialReference.restype = ctypes.c_void_p
+    lib.OSRNewSpatialReference.argtypes = [ctypes.c_char_p]
+    lib.OSRImportFromEPSG.argtypes = [ctypes.c_void_p, ctypes.c_int]
+    lib.OSRImportFromProj4.argtypes = [ctypes.c_void_p, ctypes.c_char_p]
+    lib.OSRDestroySpatialReference.argtypes = [ctypes.c_void_p]
+    lib.OCTNewCoordinateTransformation.restype = ctypes.c_void_p
+    lib.OCTNewCoordinateTransformation.argtypes = [ctypes.c_void_p,
+                                                   ctypes.c_void_p]
+    lib.OCTDestroyCoordinateTransformation.argtypes = [ctypes.c_void_p]
+    lib.OCTTransformEx.argtypes = [ctypes.c_void_p, ctypes.c_int,
+                                   ctypes.POINTER(ctypes.c_double),
+                                   ctypes.POINTER(ctypes.c_double),
+                                   ctypes.POINTER(ctypes.c_double),
+                                   ctypes.POINTER(ctypes.c_int)]
+
+    src = osr.SpatialReference()
+    src.ImportFromEPSG(4326)
+    dst = osr.SpatialReference()
+    dst.ImportFromEPSG(32631)
+    with gdaltest.error_handler():
+        ct = osr.CoordinateTransformation(src, dst)
+    if ct is None or ct.this is None:
+        return 'skip'
+
+    gdaltest.osr_ct_fastpath_lib = lib
+
+    return 'success'
+
+###############################################################################
+# Create a spatial reference through the C API, from an EPSG code or from a
+# PROJ.4 definition.
+
+
+def osr_ct_fastpath_srs(epsg_or_proj4):
+
+    lib = gdaltest.osr_ct_fastpath_lib
+
+    srs = lib.OSRNewSpatialReference(None)
+    if isinstance(epsg_or_proj4, int):
+        lib.OSRImportFromEPSG(srs, epsg_or_proj4)
+    else:
+        lib.OSRImportFromProj4(srs, epsg_or_proj4.encode('ascii'))
+    return srs
+
+###############################################################################
+# Transform points one at a time, with PROJ or with the built-in paths.
+# Returns a list of (success, x, y, z) tuples, z being None when points are
+# transformed without a Z array.
+
+
+def osr_ct_fastpath_transform(src_epsg, dst_epsg, points, fast_path,
+                              with_z=True):
+
+    lib = gdaltest.osr_ct_fastpath_lib
+
+    gdal.SetConfigOption('OGR_CT_FAST_PATH', fast_path)
+    src = osr_ct_fastpath_srs(src_epsg)
+    dst = osr_ct_fastpath_srs(dst_epsg)
+    ct = lib.OCTNewCoordinateTransformation(src, dst)
+    gdal.SetConfigOption('OGR_CT_FAST_PATH', None)
+
+    ret = []
+    for point in points:
+        x = ctypes.c_double(point[0])
+        y = ctypes.c_double(point[1])
+        z = ctypes.c_double(point[2])
+        success = ctypes.c_int(0)
+        with gdaltest.error_handler():
+            lib.OCTTransformEx(ct, 1, ctypes.byref(x), ctypes.byref(y),
+                               ctypes.byref(z) if with_z else None,
+                               ctypes.byref(success))
+        ret.append((success.value != 0, x.value, y.value,
+                    z.value if with_z else None))
+
+    lib.OCTDestroyCoordinateTransformation(ct)
+    lib.OSRDestroySpatialReference(src)
+    lib.OSRDestroySpatialReference(dst)
+
+    return ret
+
+###############################################################################
+# Check that both paths agree on the points that can be transformed, and on
+# their coordinates.
+
+
+def osr_ct_fastpath_compare(src_epsg, dst_epsg, points, tolerance,
+                            with_z=True):
+
+    ref = osr_ct_fastpath_transform(src_epsg, dst_epsg, points, 'NO', with_z)
+    got = osr_ct_fastpath_transform(src_epsg, dst_epsg, points, 'YES', with_z)
+
+    for (point, ref_res, got_res) in zip(points, ref, got):
+        if ref_res[0] != got_res[0]:
+            gdaltest.post_reason('success flags differ')
+            print(src_epsg, dst_epsg, point, ref_res, got_res)
+            return False
+        if not ref_res[0]:
+            continue
+        for i in range(1, 4):
+            if ref_res[i] is None:
+                continue
+            if not (abs(ref_res[i] - got_res[i]) <= tolerance[i - 1]):
+                gdaltest.post_reason('coordinates differ')
+                print(src_epsg, dst_epsg, point, ref_res, got_res)
+                return False
+
+    return True
+
+###############################################################################
+# Grid of geographic points, with the poles, the antimeridian and the
+# origin.
+
+
+def osr_ct_fastpath_geog_grid(heights=(0,)):
+
+    points = []
+    for lon in [-180, -179.5, -90, -3, -0.5, 0, 0.5, 3, 6, 45, 120,
+                179.999, 180]:
+        for lat in [-90, -89.9999, -80, -45, -1, 0, 1, 45, 80, 89.9999, 90]:
+            for h in heights:
+                points.append((lon, lat, h))
+    return points
+
+###############################################################################
+# Extended transverse Mercator definitions, always handled by the built-in
+# path. UTM definitions only are with PROJ >= 5.
+
+osr_ct_fastpath_etmerc = [
+    '+proj=etmerc +lat_0=0 +lon_0=3 +k=0.9996 +x_0=500000 +y_0=0 '
+    '+datum=WGS84 +units=m +no_defs',
+    '+proj=etmerc +lat_0=0 +lon_0=3 +k=0.9996 +x_0=500000 +y_0=10000000 '
+    '+datum=WGS84 +units=m +no_defs',
+    '+proj=etmerc +lat_0=46.5 +lon_0=3 +k=1 +x_0=700000 +y_0=6600000 '
+    '+ellps=GRS80 +units=m +no_defs']
+
+###############################################################################
+# The built-in paths are only used with OGR_CT_FAST_PATH=YES.
+
+
+def osr_ct_fastpath_1():
+
+    if gdaltest.osr_ct_fastpath_lib is None:
+        return 'skip'
+
+    src = osr.SpatialReference()
+    src.ImportFromEPSG(4326)
+    dst = osr.SpatialReference()
+    dst.ImportFromEPSG(4978)
+
+    for (fast_path, expected) in [(None, False), ('NO', False),
+                                  ('YES', True)]:
+        messages = []
+
+        def handler(err_class, err_no, msg):
+            # pylint: disable=unused-argument
+            if err_class == gdal.CE_Debug:
+                messages.append(msg)
+
+        gdal.PushErrorHandler(handler)
+        old_debug = gdal.GetConfigOption('CPL_DEBUG')
+        gdal.SetConfigOption('CPL_DEBUG', 'ON')
+        gdal.SetConfigOption('OGR_CT_FAST_PATH', fast_path)
+        ct = osr.CoordinateTransformation(src, dst)
+        gdal.SetConfigOption('OGR_CT_FAST_PATH', None)
+        gdal.SetConfigOption('CPL_DEBUG', old_debug)
+        gdal.PopErrorHandler()
+        ct = None
+
+        used = 'OGRCT: Using built-in transformation' in messages
+        if used != expected:
+            gdaltest.post_reason('fail')
+            print(fast_path, messages)
+            return 'fail'
+
+    return 'success'
+
+###############################################################################
+# Geographic to and from Web Mercator, UTM and extended transverse Mercator.
+
+
+def osr_ct_fastpath_2():
+
+    if gdaltest.osr_ct_fastpath_lib is None:
+        return 'skip'
+
+    points = osr_ct_fastpath_geog_grid()
+    for dst_epsg in [3857, 32631, 32731, 32660] + osr_ct_fastpath_etmerc:
+        if not osr_ct_fastpath_compare(4326, dst_epsg, points,
+                                       (1e-5, 1e-5, 1e-8)):
+            return 'fail'
+
+    projected = []
+    for x in [-1e6, 0, 166021.44, 500000, 500000.5, 833978.56, 2e6]:
+        for y in [-1e7, -5e6, 0, 1e6, 5e6, 9997964.94, 1e7, 2e7]:
+            projected.append((x, y, 0))
+    for src_epsg in [32631, 32731] + osr_ct_fastpath_etmerc:
+        if not osr_ct_fastpath_compare(src_epsg, 4326, projected,
+                                       (1e-10, 1e-10, 1e-8)):
+            return 'fail'
+
+    return 'success'
+
+###############################################################################
+# Geographic to and from geocentric, including the poles and the center
+# of the Earth.
+
+
+def osr_ct_fastpath_3():
+
+    if gdaltest.osr_ct_fastpath_lib is None:
+        return 'skip'
+
+    points = osr_ct_fastpath_geog_grid((-6356752.314245, -1000, 0, 1000))
+    if not osr_ct_fastpath_compare(4326, 4978, points, (1e-6, 1e-6, 1e-6)):
+        return 'fail'
+
+    geocentric = [(0, 0, 0), (0, 0, 6356752.314245), (0, 0, -6356752.314245),
+                  (0, 0, 1000), (1e-9, 0, 0), (6378137, 0, 0),
+                  (-6378137, 0, 0), (0, -6378137, 0), (4e6, 4e6, 3e6),
+                  (-4e6, 1e3, -4.5e6), (1e7, 1e7, 1e7), (1, 1, 1)]
+    if not osr_ct_fastpath_compare(4978, 4326, geocentric,
+                                   (1e-10, 1e-10, 1e-6)):
+        return 'fail'
+
+    # The center of the Earth is at the north pole, at height -b.
+    res = osr_ct_fastpath_transform(4978, 4326, [(0, 0, 0)], 'YES')[0]
+    if not res[0] or res[1] != 0 or res[2] != 90 or \
+       abs(res[3] - -6356752.314245) > 1e-6:
+        gdaltest.post_reason('fail')
+        print(res)
+        return 'fail'
+
+    return 'success'
+
+###############################################################################
+# Transformations without a Z array.
+
+
+def osr_ct_fastpath_4():
+
+    if gdaltest.osr_ct_fastpath_lib is None:
+        return 'skip'
+
+    points = [(2, 49, 0), (0, 0, 0), (-180, -90, 0)]
+    for dst_epsg in [3857, 32631, 4978]:
+        if not osr_ct_fastpath_compare(4326, dst_epsg, points,
+                                       (1e-5, 1e-5, 1e-6), with_z=False):
+            return 'fail'
+
+    geocentric = [(6378137, 0, 0), (0, 0, 0), (4e6, 4e6, 3e6)]
+    if not osr_ct_fastpath_compare(4978, 4326, geocentric,
+                                   (1e-10, 1e-10, 1e-6), with_z=False):
+        return 'fail'
+
+    # The result of the built-in paths must be finite when they succeed.
+    for (success, x, y, _) in osr_ct_fastpath_transform(
+            4326, 4978, points, 'YES', with_z=False):
+        if success and (math.isinf(x) or math.isinf(y)):
+            gdaltest.post_reason('fail')
+            return 'fail'
+
+    return 'success'
+
+
+gdaltest_list = [
+    osr_ct_fastpath_init,
+    osr_ct_fastpath_1,
+    osr_ct_fastpath_2,
+    osr_ct_fastpath_3,
+    osr_ct_fastpath_4]
+
+if __name__ == '__main__':
+
+    gdaltest.setup_run('osr_ct_fastpath')
+
+    gdaltest.run_tests(gdaltest_list)
+
+    gdaltest.summarize()
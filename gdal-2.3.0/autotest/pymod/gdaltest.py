@@ -0,0 +1,139 @@
+#!/usr/bin/env python
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  Helper functions shared by the test scripts: running a list of
+#           tests, reporting failures and muting errors.
+#
+###############################################################################
+# Copyright (c) 2018, GDAL contributors
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+import contextlib
+import sys
+import traceback
+
+from osgeo import gdal
+
+cur_name = 'default'
+success_counter = 0
+failure_counter = 0
+skip_counter = 0
+failure_summary = []
+
+reason = None
+
+###############################################################################
+# Start a test script.
+
+
+def setup_run(name):
+
+    global cur_name
+
+    cur_name = name
+    print('Running tests from %s' % name)
+
+###############################################################################
+# Run each test function of the list. A test returns 'success', 'fail' or
+# 'skip'; an exception counts as a failure.
+
+
+def run_tests(test_list):
+
+    global success_counter, failure_counter, skip_counter, reason
+
+    for func in test_list:
+        reason = None
+        try:
+            result = func()
+        except Exception:
+            traceback.print_exc()
+            result = 'fail'
+            reason = 'Python exception'
+
+        line = '  TEST: %s ... %s' % (func.__name__, result)
+        if result == 'success':
+            success_counter += 1
+        elif result == 'skip':
+            skip_counter += 1
+        else:
+            failure_counter += 1
+            if reason is not None:
+                line += ' (%s)' % reason
+            failure_summary.append('%s:%s' % (cur_name, func.__name__))
+        print(line)
+
+###############################################################################
+# Print the counters, and exit with a non zero status if a test failed.
+
+
+def summarize():
+
+    print('')
+    print('Test Script: %s' % cur_name)
+    print('Succeeded: %d' % success_counter)
+    print('Failed:    %d' % failure_counter)
+    print('Skipped:   %d' % skip_counter)
+    for name in failure_summary:
+        print('  failed: %s' % name)
+
+    if failure_counter:
+        sys.exit(1)
+
+###############################################################################
+# Record why the current test is going to fail, with the line of the caller.
+
+
+def post_reason(msg, frames=2):
+
+    global reason
+
+    frame = sys._getframe(frames - 1)
+    reason = '%s (line %d)' % (msg, frame.f_lineno)
+
+###############################################################################
+# Silence the errors emitted within a with block.
+
+
+@contextlib.contextmanager
+def error_handler(error_name='CPLQuietErrorHandler'):
+
+    gdal.PushErrorHandler(error_name)
+    try:
+        yield
+    finally:
+        gdal.PopErrorHandler()
+
+###############################################################################
+# Set a configuration option within a with block.
+
+
+@contextlib.contextmanager
+def config_option(key, val):
+
+    oldval = gdal.GetConfigOption(key)
+    gdal.SetConfigOption(key, val)
+    try:
+        yield
+    finally:
+        gdal.SetConfigOption(key, oldval)
@@ -0,0 +1,168 @@
+#!/usr/bin/env python
+###############################################################################
+# $Id$
+#
+# Project:  GDAL/OGR Test Suite
+# Purpose:  Test the OGR2OGR_READ_AHEAD mode of GDALVectorTranslate().
+#
+###############################################################################
+# Copyright (c) 2018, GDAL contributors
+#
+# Permission is hereby granted, free of charge, to any person obtaining a
+# copy of this software and associated documentation files (the "Software"),
+# to deal in the Software without restriction, including without limitation
+# the rights to use, copy, modify, merge, publish, distribute, sublicense,
+# and/or sell copies of the Software, and to permit persons to whom the
+# Software is furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included
+# in all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+# OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+# THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+# DEALINGS IN THE SOFTWARE.
+###############################################################################
+
+import sys
+
+sys.path.append('../pymod')
+
+from osgeo import gdal
+from osgeo import ogr
+from osgeo import osr
+
+import gdaltest
+
+###############################################################################
+# Create a memory layer in WGS84 with lines crossing the antimeridian.
+
+
+def ogr2ogr_read_ahead_create_source(nfeatures):
+
+    ds = gdal.GetDriverByName('Memory').Create('', 0, 0, 0, gdal.GDT_Unknown)
+    srs = osr.SpatialReference()
+    srs.SetWellKnownGeogCS('WGS84')
+    lyr = ds.CreateLayer('src', srs=srs)
+    lyr.CreateField(ogr.FieldDefn('id', ogr.OFTInteger))
+    for i in range(nfeatures):
+        feat = ogr.Feature(lyr.GetLayerDefn())
+        feat.SetField('id', i)
+        if i % 10 != 9:
+            lat = -80 + (i % 160)
+            feat.SetGeometryDirectly(ogr.CreateGeometryFromWkt(
+                'LINESTRING (%d %d,%d %d)' % (170 + i % 7, lat,
+                                              190 + i % 5, lat + 0.5)))
+        lyr.CreateFeature(feat)
+    return ds
+
+###############################################################################
+# Translate a dataset to a memory dataset, and return the WKT and the id of
+# its features.
+
+
+def ogr2ogr_read_ahead_translate(src_ds, options, read_ahead):
+
+    gdal.SetConfigOption('OGR2OGR_READ_AHEAD', read_ahead)
+    gdal.SetConfigOption('OGR2OGR_READ_AHEAD_QUEUE_SIZE', '7')
+    ds = gdal.VectorTranslate('', src_ds, options='-f Memory ' + options)
+    gdal.SetConfigOption('OGR2OGR_READ_AHEAD', None)
+    gdal.SetConfigOption('OGR2OGR_READ_AHEAD_QUEUE_SIZE', None)
+    if ds is None:
+        return None
+
+    ret = []
+    lyr = ds.GetLayer(0)
+    feat = lyr.GetNextFeature()
+    while feat is not None:
+        geom = feat.GetGeometryRef()
+        ret.append((feat.GetField('id'),
+                    geom.ExportToWkt() if geom is not None else None))
+        feat = lyr.GetNextFeature()
+    return ret
+
+###############################################################################
+# The result is the same with and without the read-ahead thread, including
+# when the geometries are processed by the read-ahead thread
+# (-wrapdateline), and with -limit.
+
+
+def ogr2ogr_read_ahead_1():
+
+    src_ds = ogr2ogr_read_ahead_create_source(100)
+
+    for options in ['', '-wrapdateline', '-wrapdateline -datelineoffset 20',
+                    '-wrapdateline -explodecollections', '-limit 1',
+                    '-limit 5', '-limit 0', '-wrapdateline -limit 50',
+                    '-where "id >= 40"', '-spat 175 -10 185 10']:
+        ref = ogr2ogr_read_ahead_translate(src_ds, options, 'NO')
+        got = ogr2ogr_read_ahead_translate(src_ds, options, 'YES')
+        if ref is None or got != ref:
+            gdaltest.post_reason('fail')
+            print(options)
+            print(ref)
+            print(got)
+            return 'fail'
+
+    if len(ogr2ogr_read_ahead_translate(src_ds, '-limit 5', 'YES')) != 5:
+        gdaltest.post_reason('fail')
+        return 'fail'
+
+    return 'success'
+
+###############################################################################
+# The errors emitted while reading features in the read-ahead thread are
+# reported in the calling thread.
+
+
+def ogr2ogr_read_ahead_2():
+
+    gdal.FileFromMemBuffer('/vsimem/ogr2ogr_read_ahead_2.csv',
+                           'id,val\n1,1\n2,2\n3,3\n4,four\n5,5\n')
+    gdal.FileFromMemBuffer('/vsimem/ogr2ogr_read_ahead_2.csvt',
+                           'Integer,Integer\n')
+    for read_ahead in ['NO', 'YES']:
+        # The CSV driver warns once per layer, so the file is reopened.
+        src_ds = gdal.OpenEx('/vsimem/ogr2ogr_read_ahead_2.csv')
+        messages = []
+
+        def handler(err_class, err_no, msg):
+            # pylint: disable=unused-argument
+            if err_class == gdal.CE_Warning:
+                messages.append(msg)
+
+        gdal.PushErrorHandler(handler)
+        ret = ogr2ogr_read_ahead_translate(src_ds, '', read_ahead)
+        gdal.PopErrorHandler()
+
+        if ret is None or len(ret) != 5:
+            gdaltest.post_reason('fail')
+            print(read_ahead, ret)
+            return 'fail'
+        if len(messages) != 1 or \
+           messages[0].find('Invalid value type found in record 4') < 0:
+            gdaltest.post_reason('warning not reported')
+            print(read_ahead, messages)
+            return 'fail'
+
+    src_ds = None
+    gdal.Unlink('/vsimem/ogr2ogr_read_ahead_2.csv')
+    gdal.Unlink('/vsimem/ogr2ogr_read_ahead_2.csvt')
+
+    return 'success'
+
+
+gdaltest_list = [
+    ogr2ogr_read_ahead_1,
+    ogr2ogr_read_ahead_2]
+
+if __name__ == '__main__':
+
+    gdaltest.setup_run('ogr2ogr_read_ahead')
+
+    gdaltest.run_tests(gdaltest_list)
+
+    gdaltest.summarize()
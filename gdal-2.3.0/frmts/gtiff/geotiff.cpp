@@ -236,6 +236,28 @@ typedef struct
     int           nCompressedBufferSize;
     bool          bReady;
 } GTiffCompressionJob;
+
+typedef struct
+{
+    int           nBlockId;
+    int           nBlockXOff;
+    int           nBlockYOff;
+    int           nBand;        // 0 for pixel interleaved data.
+    int           nBlockReqSize;
+    GByte        *pabyData;
+    bool          bOK;
+} GTiffDecodedBlock;
+
+typedef struct
+{
+    TIFF              *hTIFF;
+    bool               bTiled;
+    int                nBlockBufSize;
+    GTiffDecodedBlock *pasBlocks;
+    int                nBlocks;
+    int                iFirstBlock;
+    int                nBlockStep;
+} GTiffDecompressionJob;
 #if !defined(__MINGW32__)
 }
 #endif
@@ -425,7 +447,12 @@ class GTiffDataset final : public GDALPamDataset
     bool          bDebugDontWriteBlocks;
 
     CPLErr        RegisterNewOverviewDataset( toff_t nOverviewOffset, int l_nJpegQuality );
-    CPLErr        CreateOverviewsFromSrcOverviews( GDALDataset* poSrcDS );
+    CPLErr        CreateOverviewsFromSrcOverviews( GDALDataset* poSrcDS,
+                                                   GDALDataset* poOvrDS = nullptr,
+                                                   bool bUseMainBlockSize = false );
+    CPLErr        CopyImageryTileInterleaved( GDALDataset* poSrcDS,
+                                              GDALProgressFunc pfnProgress,
+                                              void * pProgressData );
     CPLErr        CreateInternalMaskOverviews( int nOvrBlockXSize,
                                                int nOvrBlockYSize );
 
@@ -465,6 +492,25 @@ class GTiffDataset final : public GDALPamDataset
     bool           SubmitCompressionJob( int nStripOrTile, GByte* pabyData,
                                          int cc, int nHeight) ;
 
+    int            m_nDecompressionThreads;
+    std::vector<TIFF*> m_ahDecompressionTIFF;
+    void           InitDecompressionThreads( char** papszOptions );
+    CPLWorkerThreadPool* GetDecompressionThreadPool();
+    static void    ThreadDecompressionFunc( void* pData );
+    bool           GetDecompressionTIFFHandles( int nCount );
+    void           ComputeBlockWindow( int nXOff, int nYOff,
+                                       int nXSize, int nYSize,
+                                       int nBufXSize, int nBufYSize,
+                                       GDALRasterIOExtraArg* psExtraArg,
+                                       int& nBlockX1, int& nBlockY1,
+                                       int& nBlockX2, int& nBlockY2 ) const;
+    void           DecodeBlocksMultiThreaded( int nXOff, int nYOff,
+                                              int nXSize, int nYSize,
+                                              int nBufXSize, int nBufYSize,
+                                              GDALRasterIOExtraArg* psExtraArg,
+                                              int nBandCount,
+                                              const int* panBandMap );
+
     int            GuessJPEGQuality( bool& bOutHasQuantizationTable,
                                      bool& bOutHasHuffmanTable );
 
@@ -2082,6 +2128,350 @@ int GTiffDataset::HasOptimizedReadMultiRange()
     return m_nHasOptimizedReadMultiRange;
 }
 
+/************************************************************************/
+/*                        ComputeBlockWindow()                          */
+/************************************************************************/
+
+void GTiffDataset::ComputeBlockWindow( int nXOff, int nYOff,
+                                       int nXSize, int nYSize,
+                                       int nBufXSize, int nBufYSize,
+                                       GDALRasterIOExtraArg* psExtraArg,
+                                       int& nBlockX1, int& nBlockY1,
+                                       int& nBlockX2, int& nBlockY2 ) const
+{
+    // Same logic as in GDALRasterBand::IRasterIO()
+    double dfXOff = nXOff;
+    double dfYOff = nYOff;
+    double dfXSize = nXSize;
+    double dfYSize = nYSize;
+    if( psExtraArg->bFloatingPointWindowValidity )
+    {
+        dfXOff = psExtraArg->dfXOff;
+        dfYOff = psExtraArg->dfYOff;
+        dfXSize = psExtraArg->dfXSize;
+        dfYSize = psExtraArg->dfYSize;
+    }
+    const double dfSrcXInc = dfXSize / static_cast<double>( nBufXSize );
+    const double dfSrcYInc = dfYSize / static_cast<double>( nBufYSize );
+    const double EPS = 1e-10;
+    nBlockX1 = static_cast<int>((0+0.5) * dfSrcXInc + dfXOff + EPS) / nBlockXSize;
+    nBlockY1 = static_cast<int>((0+0.5) * dfSrcYInc + dfYOff + EPS) / nBlockYSize;
+    nBlockX2 = static_cast<int>((nBufXSize-1+0.5) * dfSrcXInc + dfXOff + EPS) / nBlockXSize;
+    nBlockY2 = static_cast<int>((nBufYSize-1+0.5) * dfSrcYInc + dfYOff + EPS) / nBlockYSize;
+}
+
+/************************************************************************/
+/*                      ThreadDecompressionFunc()                       */
+/************************************************************************/
+
+void GTiffDataset::ThreadDecompressionFunc( void* pData )
+{
+    GTiffDecompressionJob* psJob = static_cast<GTiffDecompressionJob *>(pData);
+
+    // Errors are not reported from here: failed blocks are left to
+    // IReadBlock(), which will emit them in the calling thread.
+    CPLPushErrorHandler(CPLQuietErrorHandler);
+    for( int i = psJob->iFirstBlock; i < psJob->nBlocks;
+         i += psJob->nBlockStep )
+    {
+        GTiffDecodedBlock* psBlock = &(psJob->pasBlocks[i]);
+        if( psBlock->nBlockReqSize < psJob->nBlockBufSize )
+            memset( psBlock->pabyData, 0, psJob->nBlockBufSize );
+        if( psJob->bTiled )
+        {
+            psBlock->bOK =
+                TIFFReadEncodedTile( psJob->hTIFF, psBlock->nBlockId,
+                                     psBlock->pabyData,
+                                     psBlock->nBlockReqSize ) != -1;
+        }
+        else
+        {
+            psBlock->bOK =
+                TIFFReadEncodedStrip( psJob->hTIFF, psBlock->nBlockId,
+                                      psBlock->pabyData,
+                                      psBlock->nBlockReqSize ) != -1;
+        }
+    }
+    CPLPopErrorHandler();
+}
+
+/************************************************************************/
+/*                    GetDecompressionTIFFHandles()                     */
+/*                                                                      */
+/*      libtiff handles are not thread-safe, so each decompression      */
+/*      job works on its own handle, opened on the same file and        */
+/*      kept for the lifetime of the dataset.                           */
+/************************************************************************/
+
+bool GTiffDataset::GetDecompressionTIFFHandles( int nCount )
+{
+    GTiffDataset* poOwnerDS = this;
+    while( poOwnerDS->poBaseDS != nullptr )
+        poOwnerDS = poOwnerDS->poBaseDS;
+
+    while( static_cast<int>(poOwnerDS->m_ahDecompressionTIFF.size()) <
+                                                                    nCount )
+    {
+        VSILFILE* fp = VSIFOpenL( poOwnerDS->osFilename, "rb" );
+        if( fp == nullptr )
+            return false;
+        CPLPushErrorHandler(CPLQuietErrorHandler);
+        TIFF* l_hTIFF = VSI_TIFFOpen( poOwnerDS->osFilename, "r", fp );
+        CPLPopErrorHandler();
+        if( l_hTIFF == nullptr )
+        {
+            CPL_IGNORE_RET_VAL(VSIFCloseL(fp));
+            return false;
+        }
+        poOwnerDS->m_ahDecompressionTIFF.push_back(l_hTIFF);
+    }
+
+    for( int i = 0; i < nCount; ++i )
+    {
+        TIFF* l_hTIFF = poOwnerDS->m_ahDecompressionTIFF[i];
+        if( TIFFCurrentDirOffset(l_hTIFF) != nDirOffset &&
+            !TIFFSetSubDirectory(l_hTIFF, nDirOffset) )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/************************************************************************/
+/*                     DecodeBlocksMultiThreaded()                      */
+/*                                                                      */
+/*      Decompress in parallel the blocks intersecting a RasterIO()     */
+/*      request that are not yet in the block cache, and push them      */
+/*      into it, so that the block based RasterIO() that follows only   */
+/*      has to copy pixels. Blocks that fail to decode are left to      */
+/*      IReadBlock().                                                   */
+/************************************************************************/
+
+void GTiffDataset::DecodeBlocksMultiThreaded( int nXOff, int nYOff,
+                                              int nXSize, int nYSize,
+                                              int nBufXSize, int nBufYSize,
+                                              GDALRasterIOExtraArg* psExtraArg,
+                                              int nBandCount,
+                                              const int* panBandMap )
+{
+    GTiffDataset* poOwnerDS = this;
+    while( poOwnerDS->poBaseDS != nullptr )
+        poOwnerDS = poOwnerDS->poBaseDS;
+    if( poOwnerDS->m_nDecompressionThreads <= 1 ||
+        eAccess != GA_ReadOnly || bStreamingIn ||
+        nCompression == COMPRESSION_NONE ||
+        nCompression == COMPRESSION_JPEG ||
+        bTreatAsRGBA || bTreatAsSplit || bTreatAsSplitBitmap )
+    {
+        return;
+    }
+
+    const GDALDataType eDT = GetRasterBand(1)->GetRasterDataType();
+    const int nDTSize = GDALGetDataTypeSizeBytes(eDT);
+    if( nBitsPerSample != nDTSize * 8 || !SetDirectory() )
+        return;
+
+    const bool bTiled = CPL_TO_BOOL( TIFFIsTiled(hTIFF) );
+    const GIntBig nBlockBufSize64 = bTiled ? TIFFTileSize64(hTIFF) :
+                                             TIFFStripSize64(hTIFF);
+    const bool bPixelInterleaved =
+        nBands > 1 && nPlanarConfig == PLANARCONFIG_CONTIG;
+    const GIntBig nBandBlockSize =
+        static_cast<GIntBig>(nBlockXSize) * nBlockYSize * nDTSize;
+    if( nBlockBufSize64 !=
+                    nBandBlockSize * (bPixelInterleaved ? nBands : 1) )
+    {
+        return;
+    }
+    const int nBlockBufSize = static_cast<int>(nBlockBufSize64);
+
+    int nBlockX1 = 0;
+    int nBlockY1 = 0;
+    int nBlockX2 = 0;
+    int nBlockY2 = 0;
+    ComputeBlockWindow( nXOff, nYOff, nXSize, nYSize,
+                        nBufXSize, nBufYSize, psExtraArg,
+                        nBlockX1, nBlockY1, nBlockX2, nBlockY2 );
+
+/* -------------------------------------------------------------------- */
+/*      Collect the blocks that need to be decoded.                     */
+/* -------------------------------------------------------------------- */
+    const int nBlocksPerRow = DIV_ROUND_UP(nRasterXSize, nBlockXSize);
+    const GIntBig nMaxDecodedSize = GDALGetCacheMax64() / 4;
+    std::vector<GTiffDecodedBlock> asBlocks;
+    const int nPasses = bPixelInterleaved ? 1 : nBandCount;
+    for( int iPass = 0; iPass < nPasses; ++iPass )
+    {
+        for( int iY = nBlockY1; iY <= nBlockY2; ++iY )
+        {
+            for( int iX = nBlockX1; iX <= nBlockX2; ++iX )
+            {
+                bool bMissing = false;
+                for( int i = 0; !bMissing && i < nBandCount; ++i )
+                {
+                    if( !bPixelInterleaved && i != iPass )
+                        continue;
+                    GTiffRasterBand* poBand = cpl::down_cast<GTiffRasterBand*>(
+                                            GetRasterBand(panBandMap[i]));
+                    GDALRasterBlock* poBlock =
+                        poBand->TryGetLockedBlockRef(iX, iY);
+                    if( poBlock == nullptr )
+                        bMissing = true;
+                    else
+                        poBlock->DropLock();
+                }
+                if( !bMissing )
+                    continue;
+
+                GTiffDecodedBlock sBlock;
+                sBlock.nBlockId = iX + iY * nBlocksPerRow;
+                sBlock.nBand = 0;
+                if( nPlanarConfig == PLANARCONFIG_SEPARATE )
+                {
+                    sBlock.nBand = panBandMap[iPass];
+                    sBlock.nBlockId += (sBlock.nBand - 1) * nBlocksPerBand;
+                }
+                else if( nBands == 1 )
+                {
+                    sBlock.nBand = 1;
+                }
+                if( sBlock.nBlockId == nLoadedBlock ||
+                    !IsBlockAvailable(sBlock.nBlockId) )
+                {
+                    continue;
+                }
+                sBlock.nBlockXOff = iX;
+                sBlock.nBlockYOff = iY;
+                // Same as in IReadBlock(): do not request more than what
+                // the bottom most partial block holds.
+                sBlock.nBlockReqSize = nBlockBufSize;
+                if( iY * nBlockYSize > nRasterYSize - nBlockYSize )
+                {
+                    sBlock.nBlockReqSize = (nBlockBufSize / nBlockYSize)
+                        * (nBlockYSize - static_cast<int>(
+                            (static_cast<GIntBig>(iY + 1) * nBlockYSize)
+                                % nRasterYSize));
+                }
+                sBlock.pabyData = nullptr;
+                sBlock.bOK = false;
+                asBlocks.push_back(sBlock);
+
+                // Do not decode more than what the block cache can keep.
+                if( static_cast<GIntBig>(asBlocks.size()) * nBlockBufSize >
+                                                            nMaxDecodedSize )
+                {
+                    return;
+                }
+            }
+        }
+    }
+
+    if( asBlocks.size() < 2 )
+        return;
+
+    // Only create the pool once a read spans several blocks to decode.
+    CPLWorkerThreadPool* poPool = poOwnerDS->GetDecompressionThreadPool();
+    if( poPool == nullptr )
+        return;
+
+    const int nJobs = std::min( poPool->GetThreadCount(),
+                                static_cast<int>(asBlocks.size()) );
+    if( !GetDecompressionTIFFHandles(nJobs) )
+        return;
+
+    GByte* pabyDecoded = static_cast<GByte*>(
+        VSI_MALLOC2_VERBOSE(asBlocks.size(), nBlockBufSize) );
+    if( pabyDecoded == nullptr )
+        return;
+    for( size_t i = 0; i < asBlocks.size(); ++i )
+        asBlocks[i].pabyData = pabyDecoded + i * nBlockBufSize;
+
+/* -------------------------------------------------------------------- */
+/*      Decode. Each job processes one block every nJobs, with its      */
+/*      own TIFF handle. If the compressed blocks have been fetched by  */
+/*      CacheMultiRange(), share them with the job handles.             */
+/* -------------------------------------------------------------------- */
+    thandle_t th = TIFFClientdata( hTIFF );
+    const bool bHasCachedRanges = CPL_TO_BOOL(VSI_TIFFHasCachedRanges(th));
+    std::vector<GTiffDecompressionJob> asJobs(nJobs);
+    std::vector<void*> apJobs(nJobs);
+    for( int i = 0; i < nJobs; ++i )
+    {
+        asJobs[i].hTIFF = poOwnerDS->m_ahDecompressionTIFF[i];
+        asJobs[i].bTiled = bTiled;
+        asJobs[i].nBlockBufSize = nBlockBufSize;
+        asJobs[i].pasBlocks = &asBlocks[0];
+        asJobs[i].nBlocks = static_cast<int>(asBlocks.size());
+        asJobs[i].iFirstBlock = i;
+        asJobs[i].nBlockStep = nJobs;
+        apJobs[i] = &asJobs[i];
+        if( bHasCachedRanges )
+            VSI_TIFFShareCachedRanges( TIFFClientdata(asJobs[i].hTIFF), th );
+    }
+    poPool->SubmitJobs(ThreadDecompressionFunc, apJobs);
+    poPool->WaitCompletion();
+
+    for( int i = 0; bHasCachedRanges && i < nJobs; ++i )
+    {
+        VSI_TIFFSetCachedRanges( TIFFClientdata(asJobs[i].hTIFF),
+                                 0, nullptr, nullptr, nullptr );
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Push the decoded blocks into the block cache. Pixel             */
+/*      interleaved blocks are dispatched to all bands, as done by      */
+/*      FillCacheForOtherBands(), unless the cache is too small.        */
+/* -------------------------------------------------------------------- */
+    const int nWordBytes = nDTSize;
+    for( size_t i = 0; i < asBlocks.size(); ++i )
+    {
+        const GTiffDecodedBlock& sBlock = asBlocks[i];
+        if( !sBlock.bOK )
+            continue;
+
+        const int nBandIterCount =
+            sBlock.nBand > 0 ? 1 :
+            (bLoadingOtherBands || nBands >= 128) ? nBandCount : nBands;
+        for( int iIter = 0; iIter < nBandIterCount; ++iIter )
+        {
+            const int iBand =
+                sBlock.nBand > 0 ? sBlock.nBand :
+                (nBandIterCount == nBands) ? iIter + 1 : panBandMap[iIter];
+            GTiffRasterBand* poBand =
+                cpl::down_cast<GTiffRasterBand*>(GetRasterBand(iBand));
+            GDALRasterBlock* poBlock =
+                poBand->TryGetLockedBlockRef( sBlock.nBlockXOff,
+                                              sBlock.nBlockYOff );
+            if( poBlock != nullptr )
+            {
+                poBlock->DropLock();
+                continue;
+            }
+            poBlock = poBand->GetLockedBlockRef( sBlock.nBlockXOff,
+                                                 sBlock.nBlockYOff, TRUE );
+            if( poBlock == nullptr )
+                continue;
+
+            if( sBlock.nBand > 0 )
+            {
+                memcpy( poBlock->GetDataRef(), sBlock.pabyData,
+                        static_cast<size_t>(nBandBlockSize) );
+            }
+            else
+            {
+                GDALCopyWords( sBlock.pabyData + (iBand - 1) * nWordBytes,
+                               eDT, nBands * nWordBytes,
+                               poBlock->GetDataRef(), eDT, nWordBytes,
+                               nBlockXSize * nBlockYSize );
+            }
+            poBlock->DropLock();
+        }
+    }
+
+    VSIFree(pabyDecoded);
+}
+
 /************************************************************************/
 /*                            IRasterIO()                               */
 /************************************************************************/
@@ -2150,6 +2540,13 @@ CPLErr GTiffDataset::IRasterIO( GDALRWFlag eRWFlag,
                                                psExtraArg);
     }
 
+    if( eAccess == GA_ReadOnly && eRWFlag == GF_Read )
+    {
+        DecodeBlocksMultiThreaded(nXOff, nYOff, nXSize, nYSize,
+                                  nBufXSize, nBufYSize, psExtraArg,
+                                  nBandCount, panBandMap);
+    }
+
     ++nJPEGOverviewVisibilityCounter;
     const CPLErr eErr =
         GDALPamDataset::IRasterIO(
@@ -3996,25 +4393,13 @@ void* GTiffRasterBand::CacheMultiRange( int nXOff, int nYOff,
                                         GDALRasterIOExtraArg* psExtraArg )
 {
     void* pBufferedData = nullptr;
-    // Same logic as in GDALRasterBand::IRasterIO()
-    double dfXOff = nXOff;
-    double dfYOff = nYOff;
-    double dfXSize = nXSize;
-    double dfYSize = nYSize;
-    if( psExtraArg->bFloatingPointWindowValidity )
-    {
-        dfXOff = psExtraArg->dfXOff;
-        dfYOff = psExtraArg->dfYOff;
-        dfXSize = psExtraArg->dfXSize;
-        dfYSize = psExtraArg->dfYSize;
-    }
-    const double dfSrcXInc = dfXSize / static_cast<double>( nBufXSize );
-    const double dfSrcYInc = dfYSize / static_cast<double>( nBufYSize );
-    const double EPS = 1e-10;
-    const int nBlockX1 = static_cast<int>((0+0.5) * dfSrcXInc + dfXOff + EPS) / nBlockXSize;
-    const int nBlockY1 = static_cast<int>((0+0.5) * dfSrcYInc + dfYOff + EPS) / nBlockYSize;
-    const int nBlockX2 = static_cast<int>((nBufXSize-1+0.5) * dfSrcXInc + dfXOff + EPS) / nBlockXSize;
-    const int nBlockY2 = static_cast<int>((nBufYSize-1+0.5) * dfSrcYInc + dfYOff + EPS) / nBlockYSize;
+    int nBlockX1 = 0;
+    int nBlockY1 = 0;
+    int nBlockX2 = 0;
+    int nBlockY2 = 0;
+    poGDS->ComputeBlockWindow( nXOff, nYOff, nXSize, nYSize,
+                               nBufXSize, nBufYSize, psExtraArg,
+                               nBlockX1, nBlockY1, nBlockX2, nBlockY2 );
 
     thandle_t th = TIFFClientdata( poGDS->hTIFF );
     if( poGDS->SetDirectory() && !VSI_TIFFHasCachedRanges(th) )
@@ -4191,6 +4576,13 @@ CPLErr GTiffRasterBand::IRasterIO( GDALRWFlag eRWFlag,
         }
     }
 
+    if( poGDS->eAccess == GA_ReadOnly && eRWFlag == GF_Read )
+    {
+        poGDS->DecodeBlocksMultiThreaded(nXOff, nYOff, nXSize, nYSize,
+                                         nBufXSize, nBufYSize, psExtraArg,
+                                         1, &nBand);
+    }
+
     ++poGDS->nJPEGOverviewVisibilityCounter;
     const CPLErr eErr =
         GDALPamRasterBand::IRasterIO( eRWFlag, nXOff, nYOff, nXSize, nYSize,
@@ -7323,6 +7715,7 @@ GTiffDataset::GTiffDataset() :
     bHasDiscardedLsb(false),
     poCompressThreadPool(nullptr),
     hCompressThreadPoolMutex(nullptr),
+    m_nDecompressionThreads(0),
     m_pTempBufferForCommonDirectIO(nullptr),
     m_nTempBufferForCommonDirectIOSize(0),
     m_bReadGeoTransform(false),
@@ -7447,8 +7840,19 @@ int GTiffDataset::Finalize()
                 CPLFree(asCompressionJobs[i].pszTmpFilename);
             }
         }
-        CPLDestroyMutex(hCompressThreadPoolMutex);
+        // Not created in read-only mode.
+        if( hCompressThreadPoolMutex )
+            CPLDestroyMutex(hCompressThreadPoolMutex);
+    }
+
+    for( size_t i = 0; i < m_ahDecompressionTIFF.size(); ++i )
+    {
+        VSILFILE* fpTIFF =
+            VSI_TIFFGetVSILFile( TIFFClientdata(m_ahDecompressionTIFF[i]) );
+        XTIFFClose( m_ahDecompressionTIFF[i] );
+        CPL_IGNORE_RET_VAL(VSIFCloseL(fpTIFF));
     }
+    m_ahDecompressionTIFF.clear();
 
 /* -------------------------------------------------------------------- */
 /*      If there is still changed metadata, then presumably we want     */
@@ -8406,6 +8810,44 @@ bool GTiffDataset::WriteEncodedStrip( uint32 strip, GByte* pabyData,
     return bRet;
 }
 
+/************************************************************************/
+/*                       GTiffAcquireThreadPool()                       */
+/*                                                                      */
+/*      Return a pool of nThreads threads, reusing the one saved by     */
+/*      the last closed dataset if it has the right size.               */
+/************************************************************************/
+
+static CPLWorkerThreadPool* GTiffAcquireThreadPool( int nThreads )
+{
+    CPLWorkerThreadPool* poPool = nullptr;
+
+    // Try to reuse previously created thread pool
+    {
+        std::lock_guard<std::mutex> oLock(gMutexThreadPool);
+        if( gpoCompressThreadPool &&
+            gpoCompressThreadPool->GetThreadCount() == nThreads )
+        {
+            poPool = gpoCompressThreadPool;
+        }
+        else
+        {
+            delete gpoCompressThreadPool;
+        }
+        gpoCompressThreadPool = nullptr;
+    }
+
+    if( poPool == nullptr )
+    {
+        poPool = new CPLWorkerThreadPool();
+        if( !poPool->Setup(nThreads, nullptr, nullptr) )
+        {
+            delete poPool;
+            poPool = nullptr;
+        }
+    }
+    return poPool;
+}
+
 /************************************************************************/
 /*                        InitCompressionThreads()                      */
 /************************************************************************/
@@ -8435,30 +8877,7 @@ void GTiffDataset::InitCompressionThreads( char** papszOptions )
             {
                 CPLDebug("GTiff", "Using %d threads for compression", nThreads);
 
-                // Try to reuse previously created thread pool
-                {
-                    std::lock_guard<std::mutex> oLock(gMutexThreadPool);
-                    if( gpoCompressThreadPool &&
-                        gpoCompressThreadPool->GetThreadCount() == nThreads )
-                    {
-                        poCompressThreadPool = gpoCompressThreadPool;
-                    }
-                    else
-                    {
-                        delete gpoCompressThreadPool;
-                    }
-                    gpoCompressThreadPool = nullptr;
-                }
-
-                if( poCompressThreadPool == nullptr )
-                {
-                    poCompressThreadPool = new CPLWorkerThreadPool();
-                    if( !poCompressThreadPool->Setup(nThreads, nullptr, nullptr) )
-                    {
-                        delete poCompressThreadPool;
-                        poCompressThreadPool = nullptr;
-                    }
-                }
+                poCompressThreadPool = GTiffAcquireThreadPool(nThreads);
                 if( poCompressThreadPool != nullptr )
                 {
                     // Add a margin of an extra job w.r.t thread number
@@ -8502,6 +8921,68 @@ void GTiffDataset::InitCompressionThreads( char** papszOptions )
     }
 }
 
+/************************************************************************/
+/*                      InitDecompressionThreads()                      */
+/*                                                                      */
+/*      Read-only datasets only take the NUM_THREADS open option into   */
+/*      account. The pool itself is created by                          */
+/*      GetDecompressionThreadPool() on the first read that spans       */
+/*      several blocks to decode.                                       */
+/************************************************************************/
+
+void GTiffDataset::InitDecompressionThreads( char** papszOptions )
+{
+    // Raster == tile, then no need for threads
+    if( nBlockXSize == nRasterXSize && nBlockYSize == nRasterYSize )
+        return;
+
+    const char* pszValue = CSLFetchNameValue( papszOptions, "NUM_THREADS" );
+    if( pszValue == nullptr )
+        return;
+
+    const int nThreads =
+        EQUAL(pszValue, "ALL_CPUS") ? CPLGetNumCPUs() : atoi(pszValue);
+    if( nThreads > 1 )
+    {
+        if( nCompression == COMPRESSION_NONE ||
+            nCompression == COMPRESSION_JPEG )
+        {
+            CPLDebug( "GTiff",
+                      "NUM_THREADS ignored with uncompressed or JPEG" );
+        }
+        else
+        {
+            m_nDecompressionThreads = nThreads;
+        }
+    }
+    else if( nThreads < 0 ||
+             (!EQUAL(pszValue, "0") &&
+              !EQUAL(pszValue, "1") &&
+              !EQUAL(pszValue, "ALL_CPUS")) )
+    {
+        CPLError(CE_Warning, CPLE_AppDefined,
+                 "Invalid value for NUM_THREADS: %s", pszValue);
+    }
+}
+
+/************************************************************************/
+/*                     GetDecompressionThreadPool()                     */
+/************************************************************************/
+
+CPLWorkerThreadPool* GTiffDataset::GetDecompressionThreadPool()
+{
+    if( poCompressThreadPool == nullptr && m_nDecompressionThreads > 1 )
+    {
+        CPLDebug("GTiff", "Using %d threads for decompression",
+                 m_nDecompressionThreads);
+        poCompressThreadPool = GTiffAcquireThreadPool(m_nDecompressionThreads);
+        // Do not retry at each request.
+        if( poCompressThreadPool == nullptr )
+            m_nDecompressionThreads = 0;
+    }
+    return poCompressThreadPool;
+}
+
 /************************************************************************/
 /*                       GetGTIFFKeysFlavor()                           */
 /************************************************************************/
@@ -10008,11 +10489,33 @@ static void CreateTIFFColorTable(GDALColorTable* poColorTable,
     panBlue = &(anTBlue[0]);
 }
 
+/************************************************************************/
+/*                      GTIFFGetSrcOverviewBand()                       */
+/*                                                                      */
+/*      Return the band of the iOvr-th overview level to copy: an       */
+/*      overview of poSrcDS, or if poOvrDS (overviews computed by       */
+/*      CreateCopy()) is provided, poOvrDS itself for the first level   */
+/*      and its overviews for the next ones.                            */
+/************************************************************************/
+
+static GDALRasterBand* GTIFFGetSrcOverviewBand( GDALDataset* poSrcDS,
+                                                GDALDataset* poOvrDS,
+                                                int nBand, int iOvr )
+{
+    if( poOvrDS == nullptr )
+        return poSrcDS->GetRasterBand(nBand)->GetOverview(iOvr);
+    if( iOvr == 0 )
+        return poOvrDS->GetRasterBand(nBand);
+    return poOvrDS->GetRasterBand(nBand)->GetOverview(iOvr - 1);
+}
+
 /************************************************************************/
 /*                  CreateOverviewsFromSrcOverviews()                   */
 /************************************************************************/
 
-CPLErr GTiffDataset::CreateOverviewsFromSrcOverviews(GDALDataset* poSrcDS)
+CPLErr GTiffDataset::CreateOverviewsFromSrcOverviews( GDALDataset* poSrcDS,
+                                                      GDALDataset* poOvrDS,
+                                                      bool bUseMainBlockSize )
 {
     CPLAssert(poSrcDS->GetRasterCount() != 0);
     CPLAssert(nOverviewCount == 0);
@@ -10081,16 +10584,21 @@ CPLErr GTiffDataset::CreateOverviewsFromSrcOverviews(GDALDataset* poSrcDS)
     if( nCompression == COMPRESSION_LZW ||
         nCompression == COMPRESSION_ADOBE_DEFLATE )
         TIFFGetField( hTIFF, TIFFTAG_PREDICTOR, &nPredictor );
-    int nOvrBlockXSize = 0;
-    int nOvrBlockYSize = 0;
-    GTIFFGetOverviewBlockSize(&nOvrBlockXSize, &nOvrBlockYSize);
-
-    int nSrcOverviews = poSrcDS->GetRasterBand(1)->GetOverviewCount();
+    int nOvrBlockXSize = nBlockXSize;
+    int nOvrBlockYSize = nBlockYSize;
+    if( !bUseMainBlockSize )
+        GTIFFGetOverviewBlockSize(&nOvrBlockXSize, &nOvrBlockYSize);
+
+    const int nSrcOverviews =
+        poOvrDS != nullptr ?
+            1 + poOvrDS->GetRasterBand(1)->GetOverviewCount() :
+            poSrcDS->GetRasterBand(1)->GetOverviewCount();
     CPLErr eErr = CE_None;
 
     for( int i = 0; i < nSrcOverviews && eErr == CE_None; ++i )
     {
-        GDALRasterBand* poOvrBand = poSrcDS->GetRasterBand(1)->GetOverview(i);
+        GDALRasterBand* poOvrBand =
+            GTIFFGetSrcOverviewBand(poSrcDS, poOvrDS, 1, i);
 
         int nOXSize = poOvrBand->GetXSize();
         int nOYSize = poOvrBand->GetYSize();
@@ -12369,6 +12877,10 @@ GDALDataset *GTiffDataset::Open( GDALOpenInfo * poOpenInfo )
     {
         poDS->InitCreationOrOpenOptions(poOpenInfo->papszOpenOptions);
     }
+    else if( !bStreaming )
+    {
+        poDS->InitDecompressionThreads(poOpenInfo->papszOpenOptions);
+    }
 
     poDS->m_bLoadPam = true;
     poDS->bColorProfileMetadataChanged = false;
@@ -14922,12 +15434,18 @@ static int GTiffGetZSTDPreset(char** papszOptions)
 
 static int GTiffGetZLevel(char** papszOptions)
 {
+#ifdef LIBDEFLATE_SUPPORT
+    // Levels 10 to 12 are handled by libdeflate in the internal libtiff.
+    const int nMaxZLevel = 12;
+#else
+    const int nMaxZLevel = 9;
+#endif
     int nZLevel = -1;
     const char* pszValue = CSLFetchNameValue( papszOptions, "ZLEVEL" );
     if( pszValue != nullptr )
     {
         nZLevel = atoi( pszValue );
-        if( nZLevel < 1 || nZLevel > 9 )
+        if( nZLevel < 1 || nZLevel > nMaxZLevel )
         {
             CPLError( CE_Warning, CPLE_IllegalArg,
                       "ZLEVEL=%s value not recognised, ignoring.",
@@ -16348,6 +16866,118 @@ GDALDataset *GTiffDataset::Create( const char * pszFilename,
     return poDS;
 }
 
+/************************************************************************/
+/*                     CopyImageryTileInterleaved()                     */
+/*                                                                      */
+/*      Copy the imagery of poSrcDS into this tiled, band interleaved,  */
+/*      dataset such that the tiles of all bands at a given position    */
+/*      are written next to each other in the file.                     */
+/************************************************************************/
+
+CPLErr GTiffDataset::CopyImageryTileInterleaved( GDALDataset* poSrcDS,
+                                                 GDALProgressFunc pfnProgress,
+                                                 void * pProgressData )
+{
+    if( !SetDirectory() )
+        return CE_Failure;
+
+    const GDALDataType eDT = GetRasterBand(1)->GetRasterDataType();
+    const int nDTSize = GDALGetDataTypeSizeBytes(eDT);
+    const GPtrDiff_t nTileSize =
+        static_cast<GPtrDiff_t>(nBlockXSize) * nBlockYSize * nDTSize;
+    GByte* pabyTiles = static_cast<GByte *>(
+        VSI_MALLOC2_VERBOSE(nTileSize, nBands) );
+    if( pabyTiles == nullptr )
+        return CE_Failure;
+
+    const int nBlocksPerRow = DIV_ROUND_UP(nRasterXSize, nBlockXSize);
+    const int nBlocksPerColumn = DIV_ROUND_UP(nRasterYSize, nBlockYSize);
+    CPLErr eErr = CE_None;
+    for( int iY = 0; eErr == CE_None && iY < nBlocksPerColumn; ++iY )
+    {
+        const int nReqYSize =
+            std::min(nBlockYSize, nRasterYSize - iY * nBlockYSize);
+        for( int iX = 0; eErr == CE_None && iX < nBlocksPerRow; ++iX )
+        {
+            const int nReqXSize =
+                std::min(nBlockXSize, nRasterXSize - iX * nBlockXSize);
+            if( nReqXSize < nBlockXSize || nReqYSize < nBlockYSize )
+                memset( pabyTiles, 0, nTileSize * nBands );
+
+            eErr = poSrcDS->RasterIO(
+                GF_Read, iX * nBlockXSize, iY * nBlockYSize,
+                nReqXSize, nReqYSize,
+                pabyTiles, nReqXSize, nReqYSize, eDT,
+                nBands, nullptr,
+                nDTSize, static_cast<GSpacing>(nBlockXSize) * nDTSize,
+                nTileSize, nullptr );
+
+            for( int iBand = 0; eErr == CE_None && iBand < nBands; ++iBand )
+            {
+                eErr = WriteEncodedTileOrStrip(
+                    iX + iY * nBlocksPerRow + iBand * nBlocksPerBand,
+                    pabyTiles + iBand * nTileSize, FALSE );
+            }
+
+            if( eErr == CE_None &&
+                !pfnProgress( (iY * nBlocksPerRow + iX + 1) * 1.0 /
+                                (nBlocksPerRow * nBlocksPerColumn),
+                              nullptr, pProgressData ) )
+            {
+                CPLError( CE_Failure, CPLE_UserInterrupt,
+                          "User terminated" );
+                eErr = CE_Failure;
+            }
+        }
+    }
+
+    VSIFree( pabyTiles );
+    return eErr;
+}
+
+/************************************************************************/
+/*                     GTIFFGetCOGOverviewFactors()                     */
+/*                                                                      */
+/*      Decimation factors of the overviews computed with LAYOUT=COG    */
+/*      when the source has none: powers of 2 until the overview fits   */
+/*      in a single tile.                                               */
+/************************************************************************/
+
+static std::vector<int> GTIFFGetCOGOverviewFactors( int nXSize, int nYSize,
+                                                    int nBlockXSize,
+                                                    int nBlockYSize )
+{
+    std::vector<int> anFactors;
+    int nFactor = 1;
+    while( nFactor < INT_MAX / 2 &&
+           (DIV_ROUND_UP(nXSize, nFactor) > nBlockXSize ||
+            DIV_ROUND_UP(nYSize, nFactor) > nBlockYSize) )
+    {
+        nFactor *= 2;
+        anFactors.push_back(nFactor);
+    }
+    return anFactors;
+}
+
+/************************************************************************/
+/*                       GTIFFGetCOGTmpFilename()                       */
+/*                                                                      */
+/*      Name of a temporary file holding the overviews computed with    */
+/*      LAYOUT=COG. It is created in CPL_TMPDIR, or the current         */
+/*      directory, rather than next to the output file, which may be    */
+/*      on a read-only or network file system.                          */
+/************************************************************************/
+
+static CPLString GTIFFGetCOGTmpFilename( const char* pszFilename,
+                                         const char* pszExt )
+{
+    CPLString osTmpFilename(
+        CPLGenerateTempFilename(CPLGetBasename(pszFilename)) );
+    osTmpFilename += pszExt;
+    VSIUnlink(osTmpFilename);
+    return osTmpFilename;
+}
+
 /************************************************************************/
 /*                             CreateCopy()                             */
 /************************************************************************/
@@ -16423,6 +17053,31 @@ GTiffDataset::CreateCopy( const char * pszFilename, GDALDataset *poSrcDS,
 /* -------------------------------------------------------------------- */
     char **papszCreateOptions = CSLDuplicate( papszOptions );
 
+/* -------------------------------------------------------------------- */
+/*      Cloud optimized layout: a tiled file with all the IFDs at its   */
+/*      beginning, and the overviews (computed if the source has none)  */
+/*      written smallest first before the full resolution imagery.      */
+/* -------------------------------------------------------------------- */
+    const bool bCOGLayout =
+        EQUAL(CSLFetchNameValueDef(papszOptions, "LAYOUT", "DEFAULT"), "COG");
+    if( bCOGLayout )
+    {
+        if( !CPLFetchBool(papszOptions, "TILED", true) )
+        {
+            CPLError( CE_Failure, CPLE_NotSupported,
+                      "LAYOUT=COG cannot be used with TILED=NO" );
+            CSLDestroy(papszCreateOptions);
+            return nullptr;
+        }
+        papszCreateOptions =
+            CSLSetNameValue( papszCreateOptions, "TILED", "YES" );
+        // So that CreateLL() rejects streaming.
+        papszCreateOptions =
+            CSLSetNameValue( papszCreateOptions, "COPY_SRC_OVERVIEWS", "YES" );
+    }
+    const bool bCopySrcOverviews =
+        bCOGLayout || CPLFetchBool(papszOptions, "COPY_SRC_OVERVIEWS", false);
+
     if( poPBand->GetMetadataItem( "NBITS", "IMAGE_STRUCTURE" ) != nullptr
         && atoi(poPBand->GetMetadataItem( "NBITS", "IMAGE_STRUCTURE" )) > 0
         && CSLFetchNameValue( papszCreateOptions, "NBITS") == nullptr )
@@ -16488,10 +17143,26 @@ GTiffDataset::CreateCopy( const char * pszFilename, GDALDataset *poSrcDS,
     }
 
     double dfExtraSpaceForOverviews = 0;
-    if( CPLFetchBool(papszOptions, "COPY_SRC_OVERVIEWS", false) )
+    if( bCopySrcOverviews )
     {
         const int nSrcOverviews = poSrcDS->GetRasterBand(1)->GetOverviewCount();
-        if( nSrcOverviews )
+        if( bCOGLayout && nSrcOverviews == 0 )
+        {
+            const std::vector<int> anFactors = GTIFFGetCOGOverviewFactors(
+                poSrcDS->GetRasterXSize(), poSrcDS->GetRasterYSize(),
+                atoi(CSLFetchNameValueDef(papszOptions, "BLOCKXSIZE", "256")),
+                atoi(CSLFetchNameValueDef(papszOptions, "BLOCKYSIZE", "256")));
+            for( size_t i = 0; i < anFactors.size(); ++i )
+            {
+                dfExtraSpaceForOverviews +=
+                    static_cast<double>(
+                        DIV_ROUND_UP(poSrcDS->GetRasterXSize(), anFactors[i]) ) *
+                        DIV_ROUND_UP(poSrcDS->GetRasterYSize(), anFactors[i]);
+            }
+            dfExtraSpaceForOverviews *=
+                                l_nBands * GDALGetDataTypeSizeBytes(eType);
+        }
+        else if( nSrcOverviews )
         {
             for( int j = 1; j <= l_nBands; ++j )
             {
@@ -17339,13 +18010,87 @@ GTiffDataset::CreateCopy( const char * pszFilename, GDALDataset *poSrcDS,
     double dfTotalPixels = static_cast<double>(nXSize) * nYSize;
     double dfCurPixels = 0;
 
-    if( eErr == CE_None &&
-        CPLFetchBool(papszOptions, "COPY_SRC_OVERVIEWS", false) )
-    {
-        const int nSrcOverviews = poSrcDS->GetRasterBand(1)->GetOverviewCount();
-        if( nSrcOverviews )
+    // With LAYOUT=COG, write the tiles of all bands at a given position
+    // next to each other, even for INTERLEAVE=BAND.
+    const bool bTileInterleaved =
+        bCOGLayout && poDS->nPlanarConfig == PLANARCONFIG_SEPARATE &&
+        l_nBands > 1 &&
+        poDS->nBitsPerSample == GDALGetDataTypeSizeBits(eType);
+
+    if( eErr == CE_None && bCopySrcOverviews )
+    {
+        int nSrcOverviews = poSrcDS->GetRasterBand(1)->GetOverviewCount();
+
+        // With LAYOUT=COG, compute the overviews of a source that has none
+        // in a temporary file, so that they can be written before the full
+        // resolution imagery. The temporary files are removed at the end of
+        // this block, whether the copy succeeded or not.
+        GDALDataset* poOvrDS = nullptr;
+        GDALDataset* poMaskOvrDS = nullptr;
+        CPLString osTmpOvrFilename;
+        CPLString osTmpMaskOvrFilename;
+        if( bCOGLayout && nSrcOverviews == 0 )
+        {
+            std::vector<int> anFactors = GTIFFGetCOGOverviewFactors(
+                nXSize, nYSize, poDS->nBlockXSize, poDS->nBlockYSize );
+            const char* pszResampling =
+                CSLFetchNameValueDef(papszOptions, "OVERVIEW_RESAMPLING",
+                                     "NEAREST");
+            const char* const apszGTiffDriver[] = { "GTiff", nullptr };
+            if( !anFactors.empty() )
+            {
+                std::vector<GDALRasterBand*> apoSrcBands;
+                for( int i = 1; i <= l_nBands; ++i )
+                    apoSrcBands.push_back(poSrcDS->GetRasterBand(i));
+
+                osTmpOvrFilename =
+                    GTIFFGetCOGTmpFilename(pszFilename, ".ovr.tif");
+                eErr = GTIFFBuildOverviews(
+                    osTmpOvrFilename, l_nBands, &apoSrcBands[0],
+                    static_cast<int>(anFactors.size()), &anFactors[0],
+                    pszResampling, GDALDummyProgress, nullptr );
+                if( eErr == CE_None )
+                {
+                    poOvrDS = static_cast<GDALDataset *>( GDALOpenEx(
+                        osTmpOvrFilename, GDAL_OF_RASTER | GDAL_OF_INTERNAL,
+                        apszGTiffDriver, nullptr, nullptr) );
+                    if( poOvrDS == nullptr )
+                        eErr = CE_Failure;
+                }
+
+                if( eErr == CE_None && poDS->poMaskDS != nullptr )
+                {
+                    GDALRasterBand* poSrcMaskBand =
+                        poSrcDS->GetRasterBand(1)->GetMaskBand();
+                    osTmpMaskOvrFilename =
+                        GTIFFGetCOGTmpFilename(pszFilename, ".msk.ovr.tif");
+                    eErr = GTIFFBuildOverviews(
+                        osTmpMaskOvrFilename, 1, &poSrcMaskBand,
+                        static_cast<int>(anFactors.size()), &anFactors[0],
+                        "NEAREST", GDALDummyProgress, nullptr );
+                    if( eErr == CE_None )
+                    {
+                        poMaskOvrDS = static_cast<GDALDataset *>( GDALOpenEx(
+                            osTmpMaskOvrFilename,
+                            GDAL_OF_RASTER | GDAL_OF_INTERNAL,
+                            apszGTiffDriver, nullptr, nullptr) );
+                        if( poMaskOvrDS == nullptr )
+                            eErr = CE_Failure;
+                    }
+                }
+
+                if( poOvrDS != nullptr )
+                {
+                    nSrcOverviews =
+                        1 + poOvrDS->GetRasterBand(1)->GetOverviewCount();
+                }
+            }
+        }
+
+        if( eErr == CE_None && nSrcOverviews )
         {
-            eErr = poDS->CreateOverviewsFromSrcOverviews(poSrcDS);
+            eErr = poDS->CreateOverviewsFromSrcOverviews(poSrcDS, poOvrDS,
+                                                         bCOGLayout);
 
             if( poDS->nOverviewCount != nSrcOverviews )
             {
@@ -17359,7 +18104,7 @@ GTiffDataset::CreateCopy( const char * pszFilename, GDALDataset *poSrcDS,
             for( int i = 0; i < nSrcOverviews; ++i )
             {
                 GDALRasterBand* poOvrBand =
-                    poSrcDS->GetRasterBand(1)->GetOverview(i);
+                    GTIFFGetSrcOverviewBand(poSrcDS, poOvrDS, 1, i);
                 dfTotalPixels += static_cast<double>(poOvrBand->GetXSize()) *
                                 poOvrBand->GetYSize();
             }
@@ -17377,10 +18122,13 @@ GTiffDataset::CreateCopy( const char * pszFilename, GDALDataset *poSrcDS,
                 // Create a fake dataset with the source overview level so that
                 // GDALDatasetCopyWholeRaster can cope with it.
                 GDALDataset* poSrcOvrDS =
-                    GDALCreateOverviewDataset(poSrcDS, iOvrLevel, TRUE);
+                    poOvrDS == nullptr ?
+                        GDALCreateOverviewDataset(poSrcDS, iOvrLevel, TRUE) :
+                    iOvrLevel == 0 ? poOvrDS :
+                        GDALCreateOverviewDataset(poOvrDS, iOvrLevel - 1, TRUE);
 
                 GDALRasterBand* poOvrBand =
-                        poSrcDS->GetRasterBand(1)->GetOverview(iOvrLevel);
+                    GTIFFGetSrcOverviewBand(poSrcDS, poOvrDS, 1, iOvrLevel);
                 double dfNextCurPixels =
                     dfCurPixels +
                     static_cast<double>(poOvrBand->GetXSize()) *
@@ -17391,26 +18139,46 @@ GTiffDataset::CreateCopy( const char * pszFilename, GDALDataset *poSrcDS,
                                             dfNextCurPixels / dfTotalPixels,
                                             pfnProgress, pProgressData );
 
-                eErr =
-                    GDALDatasetCopyWholeRaster(
-                        (GDALDatasetH) poSrcOvrDS,
-                        (GDALDatasetH) poDS->papoOverviewDS[iOvrLevel],
-                        papszCopyWholeRasterOptions,
-                        GDALScaledProgress, pScaledData );
+                if( poSrcOvrDS == nullptr )
+                {
+                    eErr = CE_Failure;
+                }
+                else if( bTileInterleaved )
+                {
+                    eErr =
+                        poDS->papoOverviewDS[iOvrLevel]->
+                            CopyImageryTileInterleaved(
+                                poSrcOvrDS, GDALScaledProgress, pScaledData );
+                }
+                else
+                {
+                    eErr =
+                        GDALDatasetCopyWholeRaster(
+                            (GDALDatasetH) poSrcOvrDS,
+                            (GDALDatasetH) poDS->papoOverviewDS[iOvrLevel],
+                            papszCopyWholeRasterOptions,
+                            GDALScaledProgress, pScaledData );
+                }
 
                 dfCurPixels = dfNextCurPixels;
                 GDALDestroyScaledProgress(pScaledData);
 
-                delete poSrcOvrDS;
+                if( poSrcOvrDS != poOvrDS )
+                    delete poSrcOvrDS;
                 poSrcOvrDS = nullptr;
                 poDS->papoOverviewDS[iOvrLevel]->FlushCache();
 
                 // Copy mask of the overview.
                 if( eErr == CE_None && poDS->poMaskDS != nullptr )
                 {
+                    GDALRasterBand* poSrcMaskBand =
+                        poMaskOvrDS != nullptr ?
+                            GTIFFGetSrcOverviewBand(nullptr, poMaskOvrDS, 1,
+                                                    iOvrLevel) :
+                            poOvrBand->GetMaskBand();
                     eErr =
                         GDALRasterBandCopyWholeRaster(
-                            poOvrBand->GetMaskBand(),
+                            poSrcMaskBand,
                             poDS->papoOverviewDS[iOvrLevel]->
                             poMaskDS->GetRasterBand(1),
                             papszCopyWholeRasterOptions,
@@ -17419,6 +18187,15 @@ GTiffDataset::CreateCopy( const char * pszFilename, GDALDataset *poSrcDS,
                 }
             }
         }
+
+        if( poOvrDS != nullptr )
+            GDALClose(poOvrDS);
+        if( poMaskOvrDS != nullptr )
+            GDALClose(poMaskOvrDS);
+        if( !osTmpOvrFilename.empty() )
+            VSIUnlink(osTmpOvrFilename);
+        if( !osTmpMaskOvrFilename.empty() )
+            VSIUnlink(osTmpMaskOvrFilename);
     }
 
 /* -------------------------------------------------------------------- */
@@ -17600,11 +18377,19 @@ GTiffDataset::CreateCopy( const char * pszFilename, GDALDataset *poSrcDS,
             poDS->bWriteEmptyTiles = true;
         }
 
-        eErr = GDALDatasetCopyWholeRaster(
-            /* (GDALDatasetH) */ poSrcDS,
-            /* (GDALDatasetH) */ poDS,
-            papszCopyWholeRasterOptions,
-            GDALScaledProgress, pScaledData );
+        if( bTileInterleaved )
+        {
+            eErr = poDS->CopyImageryTileInterleaved(
+                poSrcDS, GDALScaledProgress, pScaledData );
+        }
+        else
+        {
+            eErr = GDALDatasetCopyWholeRaster(
+                /* (GDALDatasetH) */ poSrcDS,
+                /* (GDALDatasetH) */ poDS,
+                papszCopyWholeRasterOptions,
+                GDALScaledProgress, pScaledData );
+        }
     }
 
     GDALDestroyScaledProgress(pScaledData);
@@ -18800,8 +19585,15 @@ void GDALRegister_GTiff()
 #endif
     }
     if( bHasDEFLATE )
+    {
+#ifdef LIBDEFLATE_SUPPORT
+        osOptions += ""
+"   <Option name='ZLEVEL' type='int' description='DEFLATE compression level 1-12' default='6'/>";
+#else
         osOptions += ""
 "   <Option name='ZLEVEL' type='int' description='DEFLATE compression level 1-9' default='6'/>";
+#endif
+    }
     if( bHasLZMA )
         osOptions += ""
 "   <Option name='LZMA_PRESET' type='int' description='LZMA compression level 0(fast)-9(slow)' default='6'/>";
@@ -18864,6 +19656,11 @@ void GDALRegister_GTiff()
 "       <Value>BIG</Value>"
 "   </Option>"
 "   <Option name='COPY_SRC_OVERVIEWS' type='boolean' default='NO' description='Force copy of overviews of source dataset (CreateCopy())'/>"
+"   <Option name='LAYOUT' type='string-select' default='DEFAULT' description='Layout of the file (CreateCopy()). COG implies TILED=YES and COPY_SRC_OVERVIEWS=YES, computing the overviews if the source has none'>"
+"       <Value>DEFAULT</Value>"
+"       <Value>COG</Value>"
+"   </Option>"
+"   <Option name='OVERVIEW_RESAMPLING' type='string' default='NEAREST' description='Resampling method of the overviews computed with LAYOUT=COG'/>"
 "   <Option name='SOURCE_ICC_PROFILE' type='string' description='ICC profile'/>"
 "   <Option name='SOURCE_PRIMARIES_RED' type='string' description='x,y,1.0 (xyY) red chromaticity'/>"
 "   <Option name='SOURCE_PRIMARIES_GREEN' type='string' description='x,y,1.0 (xyY) green chromaticity'/>"
@@ -18897,7 +19694,7 @@ void GDALRegister_GTiff()
     poDriver->SetMetadataItem( GDAL_DMD_CREATIONOPTIONLIST, osOptions );
     poDriver->SetMetadataItem( GDAL_DMD_OPENOPTIONLIST,
 "<OpenOptionList>"
-"   <Option name='NUM_THREADS' type='string' description='Number of worker threads for compression. Can be set to ALL_CPUS' default='1'/>"
+"   <Option name='NUM_THREADS' type='string' description='Number of worker threads for compression, or decompression in read-only mode. Can be set to ALL_CPUS' default='1'/>"
 "   <Option name='GEOTIFF_KEYS_FLAVOR' type='string-select' default='STANDARD' description='Which flavor of GeoTIFF keys must be used (for writing)'>"
 "       <Value>STANDARD</Value>"
 "       <Value>ESRI_PE</Value>"
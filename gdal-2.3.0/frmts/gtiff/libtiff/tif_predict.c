@@ -275,6 +275,188 @@ PredictorSetupEncode(TIFF* tif)
 /* - when storing into the byte stream, we explicitly mask with 0xff so */
 /*   as to make icc -check=conversions happy (not necessary by the standard) */
 
+#if defined(__x86_64__) || defined(_M_X64)
+/*
+ * SSE2 is always available on x86_64, so the vector versions below need no
+ * run-time CPU detection. They operate on 16 bytes at a time and return the
+ * number of bytes they have processed; the callers finish the remainder
+ * with the scalar code. "bstride" is the predictor stride in bytes.
+ */
+#define PREDICTOR_SSE2
+#include <emmintrin.h>
+
+/*
+ * Horizontal accumulation is a prefix sum with a stride: within a vector it
+ * is computed in log2(16/bstride) shift-and-add steps, and the last
+ * bstride bytes of the previous vector are carried into the next one.
+ * This requires bstride to divide 16.
+ */
+#define PREDICTOR_ACC_SSE2_OK(bstride)	((bstride) <= 16 && (16 % (bstride)) == 0)
+
+#define PREDICTOR_PREFIX_SUM_SSE2(v, bstride, add)	\
+    switch (bstride) {					\
+    case 1:  v = add(v, _mm_slli_si128(v, 1)); /*-fallthrough*/ \
+    case 2:  v = add(v, _mm_slli_si128(v, 2)); /*-fallthrough*/ \
+    case 4:  v = add(v, _mm_slli_si128(v, 4)); /*-fallthrough*/ \
+    case 8:  v = add(v, _mm_slli_si128(v, 8)); /*-fallthrough*/ \
+    default: ;						\
+    }
+
+#define PREDICTOR_ACC_SSE2(cp, cc, bstride, add) {			\
+	__m128i carry = _mm_setzero_si128();				\
+	tmsize_t off;							\
+	for (off = 0; off + 16 <= (cc); off += 16) {			\
+		__m128i v = _mm_loadu_si128((const __m128i*) ((cp) + off)); \
+		PREDICTOR_PREFIX_SUM_SSE2(v, bstride, add)		\
+		v = add(v, carry);					\
+		_mm_storeu_si128((__m128i*) ((cp) + off), v);		\
+		carry = predictorLastBytesSSE2(v, bstride);		\
+	}								\
+	return off;							\
+}
+
+/*
+ * Horizontal differencing reads each vector and the one bstride bytes
+ * before it. Going from the end of the row towards its start, the latter
+ * has not been modified yet, so any stride can be handled. Returns the
+ * offset below which bytes are left to the caller.
+ */
+#define PREDICTOR_DIFF_SSE2(cp, cc, bstride, sub) {			\
+	tmsize_t off = (cc) - 16;					\
+	while (off >= (bstride)) {					\
+		__m128i v = _mm_loadu_si128((const __m128i*) ((cp) + off)); \
+		__m128i p = _mm_loadu_si128((const __m128i*) ((cp) + off - (bstride))); \
+		_mm_storeu_si128((__m128i*) ((cp) + off), sub(v, p));	\
+		off -= 16;						\
+	}								\
+	return off + 16;						\
+}
+
+/* Replicate the last bstride bytes of v over the whole vector. */
+static __m128i
+predictorLastBytesSSE2(__m128i v, tmsize_t bstride)
+{
+	switch (bstride) {
+	case 1:
+		v = _mm_unpackhi_epi8(v, v);
+		/*-fallthrough*/
+	case 2:
+		v = _mm_shufflehi_epi16(v, 0xFF);
+		return _mm_unpackhi_epi64(v, v);
+	case 4:
+		return _mm_shuffle_epi32(v, 0xFF);
+	case 8:
+		return _mm_unpackhi_epi64(v, v);
+	default:
+		return v;
+	}
+}
+
+static tmsize_t
+horAcc8SSE2(uint8* cp, tmsize_t cc, tmsize_t bstride)
+{
+	PREDICTOR_ACC_SSE2(cp, cc, bstride, _mm_add_epi8)
+}
+
+static tmsize_t
+horAcc16SSE2(uint8* cp, tmsize_t cc, tmsize_t bstride)
+{
+	PREDICTOR_ACC_SSE2(cp, cc, bstride, _mm_add_epi16)
+}
+
+static tmsize_t
+horAcc32SSE2(uint8* cp, tmsize_t cc, tmsize_t bstride)
+{
+	PREDICTOR_ACC_SSE2(cp, cc, bstride, _mm_add_epi32)
+}
+
+static tmsize_t
+horDiff8SSE2(uint8* cp, tmsize_t cc, tmsize_t bstride)
+{
+	PREDICTOR_DIFF_SSE2(cp, cc, bstride, _mm_sub_epi8)
+}
+
+static tmsize_t
+horDiff16SSE2(uint8* cp, tmsize_t cc, tmsize_t bstride)
+{
+	PREDICTOR_DIFF_SSE2(cp, cc, bstride, _mm_sub_epi16)
+}
+
+static tmsize_t
+horDiff32SSE2(uint8* cp, tmsize_t cc, tmsize_t bstride)
+{
+	PREDICTOR_DIFF_SSE2(cp, cc, bstride, _mm_sub_epi32)
+}
+
+/*
+ * Interleave the bps byte planes of tmp, most significant first, into the
+ * little endian samples of cp. Returns the number of samples processed.
+ */
+static tmsize_t
+fpAccReassembleSSE2(uint8* cp, const uint8* tmp, tmsize_t wc, uint32 bps)
+{
+	tmsize_t i = 0;
+
+	if (bps == 2) {
+		for (; i + 16 <= wc; i += 16) {
+			__m128i b0 = _mm_loadu_si128((const __m128i*) (tmp + i));
+			__m128i b1 = _mm_loadu_si128((const __m128i*) (tmp + wc + i));
+			uint8* out = cp + 2 * i;
+			_mm_storeu_si128((__m128i*) out, _mm_unpacklo_epi8(b1, b0));
+			_mm_storeu_si128((__m128i*) (out + 16), _mm_unpackhi_epi8(b1, b0));
+		}
+	} else if (bps == 4) {
+		for (; i + 16 <= wc; i += 16) {
+			__m128i b0 = _mm_loadu_si128((const __m128i*) (tmp + i));
+			__m128i b1 = _mm_loadu_si128((const __m128i*) (tmp + wc + i));
+			__m128i b2 = _mm_loadu_si128((const __m128i*) (tmp + 2 * wc + i));
+			__m128i b3 = _mm_loadu_si128((const __m128i*) (tmp + 3 * wc + i));
+			__m128i lo = _mm_unpacklo_epi8(b3, b2);
+			__m128i hi = _mm_unpacklo_epi8(b1, b0);
+			uint8* out = cp + 4 * i;
+			_mm_storeu_si128((__m128i*) out, _mm_unpacklo_epi16(lo, hi));
+			_mm_storeu_si128((__m128i*) (out + 16), _mm_unpackhi_epi16(lo, hi));
+			lo = _mm_unpackhi_epi8(b3, b2);
+			hi = _mm_unpackhi_epi8(b1, b0);
+			_mm_storeu_si128((__m128i*) (out + 32), _mm_unpacklo_epi16(lo, hi));
+			_mm_storeu_si128((__m128i*) (out + 48), _mm_unpackhi_epi16(lo, hi));
+		}
+	} else if (bps == 8) {
+		for (; i + 16 <= wc; i += 16) {
+			__m128i b[8];
+			__m128i p01, p23, p45, p67, q0, q1;
+			uint8* out = cp + 8 * i;
+			int half, k;
+			for (k = 0; k < 8; k++)
+				b[k] = _mm_loadu_si128((const __m128i*) (tmp + k * wc + i));
+			for (half = 0; half < 2; half++) {
+				if (half == 0) {
+					p67 = _mm_unpacklo_epi8(b[7], b[6]);
+					p45 = _mm_unpacklo_epi8(b[5], b[4]);
+					p23 = _mm_unpacklo_epi8(b[3], b[2]);
+					p01 = _mm_unpacklo_epi8(b[1], b[0]);
+				} else {
+					p67 = _mm_unpackhi_epi8(b[7], b[6]);
+					p45 = _mm_unpackhi_epi8(b[5], b[4]);
+					p23 = _mm_unpackhi_epi8(b[3], b[2]);
+					p01 = _mm_unpackhi_epi8(b[1], b[0]);
+				}
+				q0 = _mm_unpacklo_epi16(p67, p45);
+				q1 = _mm_unpacklo_epi16(p23, p01);
+				_mm_storeu_si128((__m128i*) out, _mm_unpacklo_epi32(q0, q1));
+				_mm_storeu_si128((__m128i*) (out + 16), _mm_unpackhi_epi32(q0, q1));
+				q0 = _mm_unpackhi_epi16(p67, p45);
+				q1 = _mm_unpackhi_epi16(p23, p01);
+				_mm_storeu_si128((__m128i*) (out + 32), _mm_unpacklo_epi32(q0, q1));
+				_mm_storeu_si128((__m128i*) (out + 48), _mm_unpackhi_epi32(q0, q1));
+				out += 64;
+			}
+		}
+	}
+	return i;
+}
+#endif
+
 TIFF_NOSANITIZE_UNSIGNED_INT_OVERFLOW
 static int
 horAcc8(TIFF* tif, uint8* cp0, tmsize_t cc)
@@ -290,6 +472,16 @@ horAcc8(TIFF* tif, uint8* cp0, tmsize_t cc)
     }
 
 	if (cc > stride) {
+#ifdef PREDICTOR_SSE2
+		if (PREDICTOR_ACC_SSE2_OK(stride)) {
+			tmsize_t i = horAcc8SSE2(cp, cc, stride);
+			if (i < stride)
+				i = stride;
+			for (; i < cc; i++)
+				cp[i] = (unsigned char) ((cp[i] + cp[i - stride]) & 0xff);
+			return 1;
+		}
+#endif
 		/*
 		 * Pipeline the most common cases.
 		 */
@@ -359,6 +551,16 @@ horAcc16(TIFF* tif, uint8* cp0, tmsize_t cc)
     }
 
 	if (wc > stride) {
+#ifdef PREDICTOR_SSE2
+		if (PREDICTOR_ACC_SSE2_OK(2 * stride)) {
+			tmsize_t i = horAcc16SSE2(cp0, cc, 2 * stride) / 2;
+			if (i < stride)
+				i = stride;
+			for (; i < wc; i++)
+				wp[i] = (uint16)(((unsigned int)wp[i] + (unsigned int)wp[i - stride]) & 0xffff);
+			return 1;
+		}
+#endif
 		wc -= stride;
 		do {
 			REPEAT4(stride, wp[stride] = (uint16)(((unsigned int)wp[stride] + (unsigned int)wp[0]) & 0xffff); wp++)
@@ -394,6 +596,16 @@ horAcc32(TIFF* tif, uint8* cp0, tmsize_t cc)
     }
 
 	if (wc > stride) {
+#ifdef PREDICTOR_SSE2
+		if (PREDICTOR_ACC_SSE2_OK(4 * stride)) {
+			tmsize_t i = horAcc32SSE2(cp0, cc, 4 * stride) / 4;
+			if (i < stride)
+				i = stride;
+			for (; i < wc; i++)
+				wp[i] += wp[i - stride];
+			return 1;
+		}
+#endif
 		wc -= stride;
 		do {
 			REPEAT4(stride, wp[stride] += wp[0]; wp++)
@@ -427,6 +639,16 @@ fpAcc(TIFF* tif, uint8* cp0, tmsize_t cc)
 	if (!tmp)
 		return 0;
 
+#ifdef PREDICTOR_SSE2
+	if (count > stride && PREDICTOR_ACC_SSE2_OK(stride)) {
+		tmsize_t i = horAcc8SSE2(cp, cc, stride);
+		if (i < stride)
+			i = stride;
+		for (; i < cc; i++)
+			cp[i] = (unsigned char) ((cp[i] + cp[i - stride]) & 0xff);
+		count = 0;
+	}
+#endif
 	while (count > stride) {
 		REPEAT4(stride, cp[stride] =
                         (unsigned char) ((cp[stride] + cp[0]) & 0xff); cp++)
@@ -435,7 +657,11 @@ fpAcc(TIFF* tif, uint8* cp0, tmsize_t cc)
 
 	_TIFFmemcpy(tmp, cp0, cc);
 	cp = (uint8 *) cp0;
-	for (count = 0; count < wc; count++) {
+	count = 0;
+#if defined(PREDICTOR_SSE2) && !WORDS_BIGENDIAN
+	count = fpAccReassembleSSE2(cp, tmp, wc, bps);
+#endif
+	for (; count < wc; count++) {
 		uint32 byte;
 		for (byte = 0; byte < bps; byte++) {
 			#if WORDS_BIGENDIAN
@@ -520,6 +746,12 @@ horDiff8(TIFF* tif, uint8* cp0, tmsize_t cc)
     }
 
 	if (cc > stride) {
+#ifdef PREDICTOR_SSE2
+		tmsize_t i = horDiff8SSE2(cp, cc, stride);
+		for (i--; i >= stride; i--)
+			cp[i] = (unsigned char) ((cp[i] - cp[i - stride]) & 0xff);
+		return 1;
+#else
 		cc -= stride;
 		/*
 		 * Pipeline the most common cases.
@@ -554,6 +786,7 @@ horDiff8(TIFF* tif, uint8* cp0, tmsize_t cc)
 				REPEAT4(stride, cp[stride] = (unsigned char)((cp[stride] - cp[0])&0xff); cp--)
 			} while ((cc -= stride) > 0);
 		}
+#endif
 	}
 	return 1;
 }
@@ -575,12 +808,19 @@ horDiff16(TIFF* tif, uint8* cp0, tmsize_t cc)
     }
 
 	if (wc > stride) {
+#ifdef PREDICTOR_SSE2
+		tmsize_t i = horDiff16SSE2(cp0, cc, 2 * stride) / 2;
+		for (i--; i >= stride; i--)
+			wp[i] = (uint16)(((unsigned int)wp[i] - (unsigned int)wp[i - stride]) & 0xffff);
+		return 1;
+#else
 		wc -= stride;
 		wp += wc - 1;
 		do {
 			REPEAT4(stride, wp[stride] = (uint16)(((unsigned int)wp[stride] - (unsigned int)wp[0]) & 0xffff); wp--)
 			wc -= stride;
 		} while (wc > 0);
+#endif
 	}
 	return 1;
 }
@@ -615,12 +855,19 @@ horDiff32(TIFF* tif, uint8* cp0, tmsize_t cc)
     }
 
 	if (wc > stride) {
+#ifdef PREDICTOR_SSE2
+		tmsize_t i = horDiff32SSE2(cp0, cc, 4 * stride) / 4;
+		for (i--; i >= stride; i--)
+			wp[i] -= wp[i - stride];
+		return 1;
+#else
 		wc -= stride;
 		wp += wc - 1;
 		do {
 			REPEAT4(stride, wp[stride] -= wp[0]; wp--)
 			wc -= stride;
 		} while (wc > 0);
+#endif
 	}
 	return 1;
 }
@@ -678,6 +925,14 @@ fpDiff(TIFF* tif, uint8* cp0, tmsize_t cc)
 	_TIFFfree(tmp);
 
 	cp = (uint8 *) cp0;
+#ifdef PREDICTOR_SSE2
+	if (cc > stride) {
+		tmsize_t i = horDiff8SSE2(cp, cc, stride);
+		for (i--; i >= stride; i--)
+			cp[i] = (unsigned char) ((cp[i] - cp[i - stride]) & 0xff);
+		return 1;
+	}
+#endif
 	cp += cc - stride - 1;
 	for (count = cc; count > stride; count -= stride)
 		REPEAT4(stride, cp[stride] = (unsigned char)((cp[stride] - cp[0])&0xff); cp--)
@@ -652,6 +652,19 @@ TIFFWriteBufferSetup(TIFF* tif, void* bp, tmsize_t size)
 		 */
 		if (size < 8*1024)
 			size = 8*1024;
+#if LIBDEFLATE_SUPPORT
+		/*
+		 * Add a 10% margin so that the worst case of a whole
+		 * strip/tile compressed in one call by libdeflate fits in
+		 * the buffer.
+		 */
+		{
+			uint64 size_with_margin = (uint64)size + (uint64)size / 10;
+			if ((uint64)(tmsize_t)size_with_margin == size_with_margin &&
+			    (tmsize_t)size_with_margin > size)
+				size = (tmsize_t)size_with_margin;
+		}
+#endif
 		bp = NULL;			/* NB: force malloc */
 	}
 	if (bp == NULL) {
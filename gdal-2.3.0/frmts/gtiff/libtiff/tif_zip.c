@@ -43,9 +43,16 @@
  * zlib-3.1.doc, deflate-1.1.doc and gzip-4.1.doc, available in the
  * directory ftp://ftp.uu.net/pub/archiving/zip/doc.  The library was
  * last found at ftp://ftp.uu.net/pub/archiving/zip/zlib/zlib-0.99.tar.gz.
+ *
+ * When built with LIBDEFLATE_SUPPORT, whole strips or tiles are decoded and
+ * encoded in a single call to libdeflate, which is significantly faster than
+ * zlib.  zlib remains used for partial (scanline) access.
  */
 #include "tif_predict.h"
 #include "zlib.h"
+#if LIBDEFLATE_SUPPORT
+#include "libdeflate.h"
+#endif
 
 #include <stdio.h>
 
@@ -72,6 +79,11 @@ typedef struct {
 	int             state;                 /* state flags */
 #define ZSTATE_INIT_DECODE 0x01
 #define ZSTATE_INIT_ENCODE 0x02
+#if LIBDEFLATE_SUPPORT
+	int             libdeflate_state;       /* -1 = until first time ZIPEncode() / ZIPDecode() is called, 0 = use zlib, 1 = use libdeflate */
+	struct libdeflate_decompressor* libdeflate_dec;
+	struct libdeflate_compressor*   libdeflate_enc;
+#endif
 
 	TIFFVGetMethod  vgetparent;            /* super-class method */
 	TIFFVSetMethod  vsetparent;            /* super-class method */
@@ -91,6 +103,33 @@ ZIPFixupTags(TIFF* tif)
 	return (1);
 }
 
+#if LIBDEFLATE_SUPPORT
+/*
+ * Return whether cc bytes is the size of the whole current strip or tile,
+ * which is the only case where libdeflate can be used.
+ */
+static int
+ZIPIsWholeStripOrTile(TIFF* tif, tmsize_t cc)
+{
+	TIFFDirectory *td = &tif->tif_dir;
+
+	if (isTiled(tif)) {
+		if (TIFFTileSize64(tif) != (uint64)cc)
+			return 0;
+	} else {
+		uint32 strip_height = td->td_imagelength - tif->tif_row;
+		if (strip_height > td->td_rowsperstrip)
+			strip_height = td->td_rowsperstrip;
+		if (TIFFVStripSize64(tif, strip_height) != (uint64)cc)
+			return 0;
+	}
+	/* Check for overflow */
+	if ((uint64)(size_t)cc != (uint64)cc)
+		return 0;
+	return 1;
+}
+#endif
+
 static int
 ZIPSetupDecode(TIFF* tif)
 {
@@ -144,6 +183,9 @@ ZIPPreDecode(TIFF* tif, uint16 s)
 		TIFFErrorExt(tif->tif_clientdata, module, "ZLib cannot deal with buffers this size");
 		return (0);
 	}
+#if LIBDEFLATE_SUPPORT
+	sp->libdeflate_state = -1;
+#endif
 	return (inflateReset(&sp->stream) == Z_OK);
 }
 
@@ -157,6 +199,42 @@ ZIPDecode(TIFF* tif, uint8* op, tmsize_t occ, uint16 s)
 	assert(sp != NULL);
 	assert(sp->state == ZSTATE_INIT_DECODE);
 
+#if LIBDEFLATE_SUPPORT
+	if (sp->libdeflate_state == 1)
+		return (0);
+
+	/* If we are asked to read a whole strip/tile, use libdeflate */
+	if (sp->libdeflate_state == -1 && ZIPIsWholeStripOrTile(tif, occ) &&
+	    (uint64)(size_t)tif->tif_rawcc == (uint64)tif->tif_rawcc) {
+		if (sp->libdeflate_dec == NULL)
+			sp->libdeflate_dec = libdeflate_alloc_decompressor();
+		if (sp->libdeflate_dec != NULL) {
+			enum libdeflate_result res;
+
+			sp->libdeflate_state = 1;
+			res = libdeflate_zlib_decompress(sp->libdeflate_dec,
+			    tif->tif_rawcp, (size_t) tif->tif_rawcc,
+			    op, (size_t) occ, NULL);
+
+			tif->tif_rawcp += tif->tif_rawcc;
+			tif->tif_rawcc = 0;
+
+			/* LIBDEFLATE_INSUFFICIENT_SPACE is accepted: some files */
+			/* in the wild have a last strip holding data for */
+			/* td_rowsperstrip lines, which zlib silently ignores too. */
+			if (res != LIBDEFLATE_SUCCESS &&
+			    res != LIBDEFLATE_INSUFFICIENT_SPACE) {
+				TIFFErrorExt(tif->tif_clientdata, module,
+				    "Decoding error at scanline %lu",
+				    (unsigned long) tif->tif_row);
+				return (0);
+			}
+			return (1);
+		}
+	}
+	sp->libdeflate_state = 0;
+#endif
+
         sp->stream.next_in = tif->tif_rawcp;
 	sp->stream.avail_in = (uInt) tif->tif_rawcc;
         
@@ -214,7 +292,10 @@ ZIPSetupEncode(TIFF* tif)
 		sp->state = 0;
 	}
 
-	if (deflateInit(&sp->stream, sp->zipquality) != Z_OK) {
+	/* Levels 10 to 12 are only available with libdeflate */
+	if (deflateInit(&sp->stream,
+	    sp->zipquality > Z_BEST_COMPRESSION ? Z_BEST_COMPRESSION :
+	    sp->zipquality) != Z_OK) {
 		TIFFErrorExt(tif->tif_clientdata, module, "%s", SAFE_MSG(sp));
 		return (0);
 	} else {
@@ -248,6 +329,9 @@ ZIPPreEncode(TIFF* tif, uint16 s)
 		TIFFErrorExt(tif->tif_clientdata, module, "ZLib cannot deal with buffers this size");
 		return (0);
 	}
+#if LIBDEFLATE_SUPPORT
+	sp->libdeflate_state = -1;
+#endif
 	return (deflateReset(&sp->stream) == Z_OK);
 }
 
@@ -264,6 +348,46 @@ ZIPEncode(TIFF* tif, uint8* bp, tmsize_t cc, uint16 s)
 	assert(sp->state == ZSTATE_INIT_ENCODE);
 
 	(void) s;
+
+#if LIBDEFLATE_SUPPORT
+	if (sp->libdeflate_state == 1)
+		return (0);
+
+	/* If we are asked to write a whole strip/tile, use libdeflate. */
+	/* It does not support the 0-compression level. */
+	if (sp->libdeflate_state == -1 && sp->zipquality != Z_NO_COMPRESSION &&
+	    ZIPIsWholeStripOrTile(tif, cc) &&
+	    (uint64)(size_t)tif->tif_rawdatasize == (uint64)tif->tif_rawdatasize) {
+		if (sp->libdeflate_enc == NULL) {
+			/* Default to 6 as with zlib */
+			sp->libdeflate_enc = libdeflate_alloc_compressor(
+			    sp->zipquality == Z_DEFAULT_COMPRESSION ? 6 :
+			    sp->zipquality);
+		}
+		/* If the worst case does not fit in the output buffer, */
+		/* let zlib flush it as many times as needed. */
+		if (sp->libdeflate_enc != NULL &&
+		    libdeflate_zlib_compress_bound(sp->libdeflate_enc,
+			(size_t)cc) <= (size_t)tif->tif_rawdatasize) {
+			size_t nCompressedBytes;
+
+			sp->libdeflate_state = 1;
+			nCompressedBytes = libdeflate_zlib_compress(
+			    sp->libdeflate_enc, bp, (size_t)cc,
+			    tif->tif_rawdata, (size_t)tif->tif_rawdatasize);
+			if (nCompressedBytes == 0) {
+				TIFFErrorExt(tif->tif_clientdata, module,
+				    "Encoder error at scanline %lu",
+				    (unsigned long) tif->tif_row);
+				return (0);
+			}
+			tif->tif_rawcc = (tmsize_t) nCompressedBytes;
+			return (TIFFFlushData1(tif));
+		}
+	}
+	sp->libdeflate_state = 0;
+#endif
+
 	sp->stream.next_in = bp;
 	assert(sizeof(sp->stream.avail_in)==4);  /* if this assert gets raised,
 	    we need to simplify this code to reflect a ZLib that is likely updated
@@ -303,6 +427,11 @@ ZIPPostEncode(TIFF* tif)
 	ZIPState *sp = EncoderState(tif);
 	int state;
 
+#if LIBDEFLATE_SUPPORT
+	if (sp->libdeflate_state == 1)
+		return (1);
+#endif
+
 	sp->stream.avail_in = 0;
 	do {
 		state = deflate(&sp->stream, Z_FINISH);
@@ -345,6 +474,14 @@ ZIPCleanup(TIFF* tif)
 		inflateEnd(&sp->stream);
 		sp->state = 0;
 	}
+
+#if LIBDEFLATE_SUPPORT
+	if (sp->libdeflate_dec)
+		libdeflate_free_decompressor(sp->libdeflate_dec);
+	if (sp->libdeflate_enc)
+		libdeflate_free_compressor(sp->libdeflate_enc);
+#endif
+
 	_TIFFfree(sp);
 	tif->tif_data = NULL;
 
@@ -360,8 +497,17 @@ ZIPVSetField(TIFF* tif, uint32 tag, va_list ap)
 	switch (tag) {
 	case TIFFTAG_ZIPQUALITY:
 		sp->zipquality = (int) va_arg(ap, int);
+#if LIBDEFLATE_SUPPORT
+		/* The compressor is allocated for a given level */
+		if (sp->libdeflate_enc) {
+			libdeflate_free_compressor(sp->libdeflate_enc);
+			sp->libdeflate_enc = NULL;
+		}
+#endif
+		/* Levels 10 to 12 are only available with libdeflate */
 		if ( sp->state&ZSTATE_INIT_ENCODE ) {
 			if (deflateParams(&sp->stream,
+			    sp->zipquality > Z_BEST_COMPRESSION ? Z_BEST_COMPRESSION :
 			    sp->zipquality, Z_DEFAULT_STRATEGY) != Z_OK) {
 				TIFFErrorExt(tif->tif_clientdata, module, "ZLib error: %s",
 					     SAFE_MSG(sp));
@@ -435,6 +581,11 @@ TIFFInitZIP(TIFF* tif, int scheme)
 	/* Default values for codec-specific fields */
 	sp->zipquality = Z_DEFAULT_COMPRESSION;	/* default comp. level */
 	sp->state = 0;
+#if LIBDEFLATE_SUPPORT
+	sp->libdeflate_state = -1;
+	sp->libdeflate_dec = NULL;
+	sp->libdeflate_enc = NULL;
+#endif
 
 	/*
 	 * Install codec methods.
@@ -316,6 +316,17 @@ void VSI_TIFFSetCachedRanges( thandle_t th, int nRanges,
     }
 }
 
+// Make thDst serve the ranges cached on thSrc. The memory remains owned by
+// the caller of VSI_TIFFSetCachedRanges() on thSrc.
+void VSI_TIFFShareCachedRanges( thandle_t thDst, thandle_t thSrc )
+{
+    GDALTiffHandle* psSrc = reinterpret_cast<GDALTiffHandle*>( thSrc );
+    VSI_TIFFSetCachedRanges( thDst, psSrc->nCachedRanges,
+                             psSrc->ppCachedData,
+                             psSrc->panCachedOffsets,
+                             psSrc->panCachedSizes );
+}
+
 // Open a TIFF file for read/writing.
 TIFF* VSI_TIFFOpen( const char* name, const char* mode,
                     VSILFILE* fpL )
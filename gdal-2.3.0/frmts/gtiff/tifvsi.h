@@ -45,5 +45,6 @@ void VSI_TIFFSetCachedRanges( thandle_t th, int nRanges,
                               void ** ppData, // memory pointed by ppData[i] must be kept alive by caller
                               const vsi_l_offset* panOffsets,
                               const size_t* panSizes );
+void VSI_TIFFShareCachedRanges( thandle_t thDst, thandle_t thSrc );
 
 #endif // TIFVSI_H_INCLUDED
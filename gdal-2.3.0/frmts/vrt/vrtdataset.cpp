@@ -30,17 +30,29 @@
 #include "vrtdataset.h"
 
 #include "cpl_minixml.h"
+#include "cpl_multiproc.h"
 #include "cpl_string.h"
+#include "cpl_worker_thread_pool.h"
 #include "gdal_frmts.h"
 #include "ogr_spatialref.h"
 
 #include <algorithm>
+#include <map>
 #include <typeinfo>
+#include <vector>
 
 /*! @cond Doxygen_Suppress */
 
 CPL_CVSID("$Id: vrtdataset.cpp 56578e74c2851abf597312e07504cfe639cceedd 2018-04-24 20:38:09 +0200 Even Rouault $")
 
+// Worker threads used by ParallelSourcesRasterIO(). nNumThreads is -1
+// until resolved from VRT_NUM_THREADS.
+struct VRTDataset::SourceThreads
+{
+    int                  nNumThreads = -1;
+    CPLWorkerThreadPool *poPool = nullptr;
+};
+
 /************************************************************************/
 /*                            VRTDataset()                             */
 /************************************************************************/
@@ -56,7 +68,8 @@ VRTDataset::VRTDataset( int nXSize, int nYSize ) :
     m_pszVRTPath(nullptr),
     m_poMaskBand(nullptr),
     m_bCompatibleForDatasetIO(-1),
-    m_papszXMLVRTMetadata(nullptr)
+    m_papszXMLVRTMetadata(nullptr),
+    m_poSourceThreads(new SourceThreads())
 {
     nRasterXSize = nXSize;
     nRasterYSize = nYSize;
@@ -116,6 +129,8 @@ VRTDataset::~VRTDataset()
     for(size_t i=0;i<m_apoOverviewsBak.size();i++)
         delete m_apoOverviewsBak[i];
     CSLDestroy( m_papszXMLVRTMetadata );
+    delete m_poSourceThreads->poPool;
+    delete m_poSourceThreads;
 }
 
 /************************************************************************/
@@ -789,8 +804,15 @@ GDALDataset *VRTDataset::Open( GDALOpenInfo * poOpenInfo )
         OpenXML( pszXML, pszVRTPath, poOpenInfo->eAccess ) );
 
     if( poDS != nullptr )
+    {
         poDS->m_bNeedsFlush = FALSE;
 
+        const char* pszNumThreads =
+            CSLFetchNameValue(poOpenInfo->papszOpenOptions, "NUM_THREADS");
+        if( pszNumThreads != nullptr )
+            poDS->SetNumThreads(pszNumThreads);
+    }
+
     CPLFree( pszXML );
     CPLFree( pszVRTPath );
 
@@ -1584,20 +1606,38 @@ CPLErr VRTDataset::IRasterIO( GDALRWFlag eRWFlag,
         // they don't necessary instantiate all underlying rasterbands.
         VRTSourcedRasterBand* poBand = reinterpret_cast<VRTSourcedRasterBand *>(
             papoBands[nBands - 1] );
+
+        std::vector<VRTSource*> apoSourcesInWindow;
+        VRTSource** papoSourcesInWindow = nullptr;
+        const int nSourcesInWindow =
+            poBand->GetSourcesInWindow( nXOff, nYOff, nXSize, nYSize,
+                                        &papoSourcesInWindow,
+                                        apoSourcesInWindow );
+
+        bool bTried = false;
+        eErr = ParallelSourcesRasterIO( nSourcesInWindow, papoSourcesInWindow,
+                                        poBand->GetRasterDataType(),
+                                        nXOff, nYOff, nXSize, nYSize,
+                                        pData, nBufXSize, nBufYSize,
+                                        eBufType,
+                                        nBandCount, panBandMap,
+                                        nPixelSpace, nLineSpace, nBandSpace,
+                                        psExtraArg, &bTried );
+
         for( int iSource = 0;
-             eErr == CE_None && iSource < poBand->nSources;
+             !bTried && eErr == CE_None && iSource < nSourcesInWindow;
              iSource++ )
         {
             psExtraArg->pfnProgress = GDALScaledProgress;
             psExtraArg->pProgressData =
                 GDALCreateScaledProgress(
-                    1.0 * iSource / poBand->nSources,
-                    1.0 * (iSource + 1) / poBand->nSources,
+                    1.0 * iSource / nSourcesInWindow,
+                    1.0 * (iSource + 1) / nSourcesInWindow,
                     pfnProgressGlobal,
                     pProgressDataGlobal );
 
             VRTSimpleSource* poSource = reinterpret_cast<VRTSimpleSource *>(
-                poBand->papoSources[iSource] );
+                papoSourcesInWindow[iSource] );
 
             eErr = poSource->DatasetRasterIO( poBand->GetRasterDataType(),
                                               nXOff, nYOff, nXSize, nYSize,
@@ -1625,6 +1665,361 @@ CPLErr VRTDataset::IRasterIO( GDALRWFlag eRWFlag,
                                    psExtraArg );
 }
 
+/************************************************************************/
+/*                           SetNumThreads()                            */
+/************************************************************************/
+
+/* Number of worker threads used by ParallelSourcesRasterIO(). */
+/* Integer value or ALL_CPUS. 0 or 1 means that sources are read */
+/* sequentially. */
+
+void VRTDataset::SetNumThreads( const char* pszNumThreads )
+{
+    int nThreads = EQUAL(pszNumThreads, "ALL_CPUS") ? CPLGetNumCPUs() :
+                                                      atoi(pszNumThreads);
+    nThreads = std::max(0, std::min(nThreads, 128));
+    if( nThreads != m_poSourceThreads->nNumThreads )
+    {
+        delete m_poSourceThreads->poPool;
+        m_poSourceThreads->poPool = nullptr;
+        m_poSourceThreads->nNumThreads = nThreads;
+    }
+}
+
+/************************************************************************/
+/*                           GetThreadPool()                            */
+/************************************************************************/
+
+/* Return the pool of worker threads used to read sources concurrently, */
+/* creating it on the first call, or nullptr if sources must be read */
+/* sequentially. */
+
+CPLWorkerThreadPool* VRTDataset::GetThreadPool()
+{
+    if( m_poSourceThreads->nNumThreads < 0 )
+        SetNumThreads(CPLGetConfigOption("VRT_NUM_THREADS", "1"));
+
+    int& nNumThreads = m_poSourceThreads->nNumThreads;
+    CPLWorkerThreadPool*& poPool = m_poSourceThreads->poPool;
+    if( nNumThreads <= 1 )
+        return nullptr;
+
+    if( poPool == nullptr )
+    {
+        CPLDebug("VRT", "Using %d threads to read sources", nNumThreads);
+        poPool = new (std::nothrow) CPLWorkerThreadPool();
+        if( poPool == nullptr ||
+            !poPool->Setup( nNumThreads, nullptr, nullptr ) )
+        {
+            delete poPool;
+            poPool = nullptr;
+            // Do not retry at each request.
+            nNumThreads = 1;
+        }
+    }
+    return poPool;
+}
+
+/************************************************************************/
+/*                      ParallelSourcesRasterIO()                       */
+/************************************************************************/
+
+namespace {
+
+class VRTErrorStruct final
+{
+  public:
+    CPLErr type;
+    CPLErrorNum no;
+    CPLString msg;
+
+    VRTErrorStruct() : type(CE_None), no(CPLE_None) {}
+    VRTErrorStruct(CPLErr eErrIn, CPLErrorNum noIn, const char* msgIn) :
+        type(eErrIn), no(noIn), msg(msgIn) {}
+};
+
+struct VRTSourceReadJob
+{
+    VRTSimpleSource      *poSource;
+    GDALDataType          eBandDataType;
+    int                   nXOff;
+    int                   nYOff;
+    int                   nXSize;
+    int                   nYSize;
+    void                 *pData;
+    int                   nBufXSize;
+    int                   nBufYSize;
+    GDALDataType          eBufType;
+    int                   nBandCount;
+    int                  *panBandMap;
+    GSpacing              nPixelSpace;
+    GSpacing              nLineSpace;
+    GSpacing              nBandSpace;
+    GDALRasterIOExtraArg  sExtraArg;
+    CPLErr                eErr;
+    std::vector<VRTErrorStruct> aoErrors;
+};
+
+// Only used for its address, to tag worker threads.
+int nVRTSourceReadJobTag = 0;
+
+}  // namespace
+
+static void CPL_STDCALL VRTSourceReadJobErrorHandler( CPLErr eErr,
+                                                      CPLErrorNum no,
+                                                      const char* msg )
+{
+    std::vector<VRTErrorStruct>* paoErrors =
+        static_cast<std::vector<VRTErrorStruct> *>(
+            CPLGetErrorHandlerUserData());
+    paoErrors->push_back(VRTErrorStruct(eErr, no, msg));
+}
+
+static void VRTSourceReadJobFunc( void* pData )
+{
+    VRTSourceReadJob* psJob = static_cast<VRTSourceReadJob*>(pData);
+
+    // Prevent VRT sources that are themselves VRT from spawning threads
+    // from this worker thread. This function only runs in threads of the
+    // pool, so the tag never reaches the thread that issued the request.
+    CPLSetTLS( CTLS_VRTSOURCEREADJOB, &nVRTSourceReadJobTag, FALSE );
+
+    // Errors are collected and emitted again by the calling thread, since
+    // the error handlers installed by the caller are thread-local.
+    CPLPushErrorHandlerEx( VRTSourceReadJobErrorHandler, &psJob->aoErrors );
+    CPLSetCurrentErrorHandlerCatchDebug( FALSE );
+
+    if( psJob->panBandMap != nullptr )
+    {
+        psJob->eErr = psJob->poSource->DatasetRasterIO(
+            psJob->eBandDataType,
+            psJob->nXOff, psJob->nYOff, psJob->nXSize, psJob->nYSize,
+            psJob->pData, psJob->nBufXSize, psJob->nBufYSize,
+            psJob->eBufType,
+            psJob->nBandCount, psJob->panBandMap,
+            psJob->nPixelSpace, psJob->nLineSpace, psJob->nBandSpace,
+            &psJob->sExtraArg );
+    }
+    else
+    {
+        psJob->eErr = psJob->poSource->RasterIO(
+            psJob->eBandDataType,
+            psJob->nXOff, psJob->nYOff, psJob->nXSize, psJob->nYSize,
+            psJob->pData, psJob->nBufXSize, psJob->nBufYSize,
+            psJob->eBufType,
+            psJob->nPixelSpace, psJob->nLineSpace,
+            &psJob->sExtraArg );
+    }
+
+    CPLPopErrorHandler();
+}
+
+/* Read the sources intersecting the request with the worker threads of */
+/* GetThreadPool(). panBandMap is nullptr for a single band request, in */
+/* which case VRTSimpleSource::RasterIO() is used, and */
+/* VRTSimpleSource::DatasetRasterIO() otherwise. */
+/* */
+/* Sources are dispatched in successive waves. A source goes to a later */
+/* wave than any previous source whose destination window overlaps its */
+/* own, or that reads from the same dataset, since dataset handles must */
+/* not be used by several threads at a time. The buffer is thus composed */
+/* in the same order as with the sequential loop, and the result does */
+/* not depend on the scheduling of the threads. */
+/* */
+/* *pbTried is set to false, and nothing done, when the request is not */
+/* worth or not safe to be processed in parallel. The caller must then */
+/* read the sources sequentially. */
+
+CPLErr VRTDataset::ParallelSourcesRasterIO(
+                               int nSources, VRTSource **papoSources,
+                               GDALDataType eBandDataType,
+                               int nXOff, int nYOff, int nXSize, int nYSize,
+                               void * pData, int nBufXSize, int nBufYSize,
+                               GDALDataType eBufType,
+                               int nBandCount, int *panBandMap,
+                               GSpacing nPixelSpace, GSpacing nLineSpace,
+                               GSpacing nBandSpace,
+                               GDALRasterIOExtraArg* psExtraArg,
+                               bool* pbTried )
+{
+    *pbTried = false;
+
+    if( nSources < 2 || CPLGetTLS(CTLS_VRTSOURCEREADJOB) != nullptr )
+        return CE_None;
+
+    CPLWorkerThreadPool* poThreadPool = GetThreadPool();
+    if( poThreadPool == nullptr )
+        return CE_None;
+
+/* -------------------------------------------------------------------- */
+/*      Collect the sources that contribute to the request, and         */
+/*      assign them to waves.                                           */
+/* -------------------------------------------------------------------- */
+    std::vector<VRTSourceReadJob> asJobs;
+    std::vector<int> anOutWindows;  // nOutXOff, nOutYOff, nOutXEnd, nOutYEnd
+    std::vector<int> anWave;
+    std::map<CPLString, int> oMapDatasetToLastWave;
+    int nWaveCount = 0;
+
+    for( int iSource = 0; iSource < nSources; iSource++ )
+    {
+        if( !papoSources[iSource]->IsSimpleSource() )
+            return CE_None;
+
+        VRTSimpleSource* poSource =
+            reinterpret_cast<VRTSimpleSource *>( papoSources[iSource] );
+        if( !EQUAL(poSource->GetType(), "SimpleSource") &&
+            !EQUAL(poSource->GetType(), "ComplexSource") )
+            return CE_None;
+
+        double dfReqXOff = 0.0;
+        double dfReqYOff = 0.0;
+        double dfReqXSize = 0.0;
+        double dfReqYSize = 0.0;
+        int nReqXOff = 0;
+        int nReqYOff = 0;
+        int nReqXSize = 0;
+        int nReqYSize = 0;
+        int nOutXOff = 0;
+        int nOutYOff = 0;
+        int nOutXSize = 0;
+        int nOutYSize = 0;
+        if( !poSource->GetSrcDstWindow( nXOff, nYOff, nXSize, nYSize,
+                                        nBufXSize, nBufYSize,
+                                        &dfReqXOff, &dfReqYOff,
+                                        &dfReqXSize, &dfReqYSize,
+                                        &nReqXOff, &nReqYOff,
+                                        &nReqXSize, &nReqYSize,
+                                        &nOutXOff, &nOutYOff,
+                                        &nOutXSize, &nOutYSize ) )
+        {
+            continue;
+        }
+
+        // Mask band sources, whose GetBand() is nullptr, or bands not
+        // attached to a dataset, are not handled.
+        GDALRasterBand* poSrcBand = poSource->GetBand();
+        GDALDataset* poSrcDS =
+            poSrcBand ? poSrcBand->GetDataset() : nullptr;
+        if( poSrcDS == nullptr )
+            return CE_None;
+
+        // Shared proxy datasets on the same file end up using the same
+        // underlying dataset, so identify datasets by name when possible.
+        CPLString osKey(poSrcDS->GetDescription());
+        if( osKey.empty() )
+            osKey.Printf("%p", poSrcDS);
+
+        int nWave = 0;
+        std::map<CPLString, int>::const_iterator oIter =
+            oMapDatasetToLastWave.find(osKey);
+        if( oIter != oMapDatasetToLastWave.end() )
+            nWave = oIter->second + 1;
+
+        const int nOutXEnd = nOutXOff + nOutXSize;
+        const int nOutYEnd = nOutYOff + nOutYSize;
+        for( size_t i = 0; i < anWave.size(); i++ )
+        {
+            if( anWave[i] >= nWave &&
+                anOutWindows[4 * i] < nOutXEnd &&
+                anOutWindows[4 * i + 1] < nOutYEnd &&
+                anOutWindows[4 * i + 2] > nOutXOff &&
+                anOutWindows[4 * i + 3] > nOutYOff )
+            {
+                nWave = anWave[i] + 1;
+            }
+        }
+
+        oMapDatasetToLastWave[osKey] = nWave;
+        nWaveCount = std::max(nWaveCount, nWave + 1);
+        anWave.push_back(nWave);
+        anOutWindows.push_back(nOutXOff);
+        anOutWindows.push_back(nOutYOff);
+        anOutWindows.push_back(nOutXEnd);
+        anOutWindows.push_back(nOutYEnd);
+
+        VRTSourceReadJob sJob;
+        sJob.poSource = poSource;
+        sJob.eBandDataType = eBandDataType;
+        sJob.nXOff = nXOff;
+        sJob.nYOff = nYOff;
+        sJob.nXSize = nXSize;
+        sJob.nYSize = nYSize;
+        sJob.pData = pData;
+        sJob.nBufXSize = nBufXSize;
+        sJob.nBufYSize = nBufYSize;
+        sJob.eBufType = eBufType;
+        sJob.nBandCount = nBandCount;
+        sJob.panBandMap = panBandMap;
+        sJob.nPixelSpace = nPixelSpace;
+        sJob.nLineSpace = nLineSpace;
+        sJob.nBandSpace = nBandSpace;
+        sJob.sExtraArg = *psExtraArg;
+        sJob.sExtraArg.pfnProgress = nullptr;
+        sJob.sExtraArg.pProgressData = nullptr;
+        sJob.eErr = CE_None;
+        asJobs.push_back(sJob);
+    }
+
+    // Nothing to gain if every wave has a single source.
+    if( static_cast<size_t>(nWaveCount) == asJobs.size() )
+        return CE_None;
+
+    *pbTried = true;
+
+    CPLDebug( "VRT", "Reading %d sources in %d waves",
+              static_cast<int>(asJobs.size()), nWaveCount );
+
+/* -------------------------------------------------------------------- */
+/*      Run the waves in turn.                                          */
+/* -------------------------------------------------------------------- */
+    const int nJobCount = static_cast<int>(asJobs.size());
+    int nJobsDone = 0;
+    for( int iWave = 0; iWave < nWaveCount; iWave++ )
+    {
+        std::vector<void*> apJobs;
+        for( int i = 0; i < nJobCount; i++ )
+        {
+            if( anWave[i] == iWave )
+                apJobs.push_back(&asJobs[i]);
+        }
+        // Waves of a single source also go through the pool: the job
+        // function tags its thread as a worker one.
+        poThreadPool->SubmitJobs(VRTSourceReadJobFunc, apJobs);
+        poThreadPool->WaitCompletion();
+
+        bool bFailed = false;
+        for( size_t i = 0; i < apJobs.size(); i++ )
+        {
+            const VRTSourceReadJob* psJob =
+                static_cast<VRTSourceReadJob*>(apJobs[i]);
+            for( size_t iError = 0; iError < psJob->aoErrors.size();
+                 ++iError )
+            {
+                CPLError( psJob->aoErrors[iError].type,
+                          psJob->aoErrors[iError].no,
+                          "%s",
+                          psJob->aoErrors[iError].msg.c_str() );
+            }
+            if( psJob->eErr != CE_None )
+                bFailed = true;
+        }
+        if( bFailed )
+            return CE_Failure;
+
+        nJobsDone += static_cast<int>(apJobs.size());
+        if( psExtraArg->pfnProgress != nullptr &&
+            !psExtraArg->pfnProgress(1.0 * nJobsDone / nJobCount, "",
+                                     psExtraArg->pProgressData) )
+        {
+            CPLError( CE_Failure, CPLE_UserInterrupt, "User terminated" );
+            return CE_Failure;
+        }
+    }
+
+    return CE_None;
+}
+
 /************************************************************************/
 /*                  UnsetPreservedRelativeFilenames()                   */
 /************************************************************************/
@@ -34,6 +34,7 @@
 #ifndef DOXYGEN_SKIP
 
 #include "cpl_hash_set.h"
+#include "cpl_quad_tree.h"
 #include "gdal_pam.h"
 #include "gdal_priv.h"
 #include "gdal_rat.h"
@@ -130,6 +131,7 @@ VRTSource *VRTParseFilterSources( CPLXMLNode *psTree, const char *, void* pUniqu
 /************************************************************************/
 
 class VRTRasterBand;
+class CPLWorkerThreadPool;
 
 class CPL_DLL VRTDataset : public GDALDataset
 {
@@ -157,6 +159,10 @@ class CPL_DLL VRTDataset : public GDALDataset
     std::vector<GDALDataset*> m_apoOverviewsBak;
     char         **m_papszXMLVRTMetadata;
 
+    // Worker threads used to read sources concurrently.
+    struct SourceThreads;
+    SourceThreads *m_poSourceThreads;
+
     VRTRasterBand*      InitBand(const char* pszSubclass, int nBand,
                                  bool bAllowPansharpened);
 
@@ -225,6 +231,20 @@ class CPL_DLL VRTDataset : public GDALDataset
 
     void                UnsetPreservedRelativeFilenames();
 
+    void                SetNumThreads( const char* pszNumThreads );
+    CPLWorkerThreadPool* GetThreadPool();
+    CPLErr              ParallelSourcesRasterIO(
+                               int nSources, VRTSource **papoSources,
+                               GDALDataType eBandDataType,
+                               int nXOff, int nYOff, int nXSize, int nYSize,
+                               void * pData, int nBufXSize, int nBufYSize,
+                               GDALDataType eBufType,
+                               int nBandCount, int *panBandMap,
+                               GSpacing nPixelSpace, GSpacing nLineSpace,
+                               GSpacing nBandSpace,
+                               GDALRasterIOExtraArg* psExtraArg,
+                               bool* pbTried );
+
     static int          Identify( GDALOpenInfo * );
     static GDALDataset *Open( GDALOpenInfo * );
     static GDALDataset *OpenXML( const char *, const char * = nullptr,
@@ -503,6 +523,15 @@ class CPL_DLL VRTSourcedRasterBand : public VRTRasterBand
     bool           CanUseSourcesMinMaxImplementations();
     void           CheckSource( VRTSimpleSource *poSS );
 
+    // Index of the destination windows of the sources, built on demand
+    // for bands with many sources.
+    struct SourceIndex;
+    SourceIndex   *m_poSourceIndex;
+
+    bool           GetSourceIndexBounds( int iSource, CPLRectObj* psRect );
+    bool           BuildSourceIndex();
+    void           InvalidateSourceIndex();
+
   public:
     int            nSources;
     VRTSource    **papoSources;
@@ -554,6 +583,10 @@ class CPL_DLL VRTSourcedRasterBand : public VRTRasterBand
                                   void *pProgressData ) override;
 
     CPLErr         AddSource( VRTSource * );
+    int            GetSourcesInWindow( int nXOff, int nYOff,
+                                       int nXSize, int nYSize,
+                                       VRTSource*** ppapoSourcesOut,
+                                       std::vector<VRTSource*>& apoSourcesInWindow );
     CPLErr         AddSimpleSource( GDALRasterBand *poSrcBand,
                                     double dfSrcXOff=-1, double dfSrcYOff=-1,
                                     double dfSrcXSize=-1, double dfSrcYSize=-1,
@@ -36,13 +36,16 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <algorithm>
 #include <string>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_hash_set.h"
 #include "cpl_minixml.h"
 #include "cpl_progress.h"
+#include "cpl_quad_tree.h"
 #include "cpl_string.h"
 #include "cpl_vsi.h"
 #include "gdal.h"
@@ -53,6 +56,15 @@ CPL_CVSID("$Id: vrtsourcedrasterband.cpp 22f8ae3bf7bc3cccd970992655c63fc5254d320
 
 /*! @cond Doxygen_Suppress */
 
+// Quad tree of the destination windows of the first nCount sources.
+// hQuadTree stays nullptr if they cannot be indexed.
+struct VRTSourcedRasterBand::SourceIndex
+{
+    CPLQuadTree *hQuadTree = nullptr;
+    int          nCount = 0;
+    CPLRectObj   sBounds{0, 0, 0, 0};
+};
+
 /************************************************************************/
 /* ==================================================================== */
 /*                          VRTSourcedRasterBand                        */
@@ -66,6 +78,7 @@ CPL_CVSID("$Id: vrtsourcedrasterband.cpp 22f8ae3bf7bc3cccd970992655c63fc5254d320
 VRTSourcedRasterBand::VRTSourcedRasterBand( GDALDataset *poDSIn, int nBandIn ) :
     m_nRecursionCounter(0),
     m_papszSourceList(nullptr),
+    m_poSourceIndex(nullptr),
     nSources(0),
     papoSources(nullptr),
     bSkipBufferInitialization(FALSE)
@@ -85,6 +98,7 @@ VRTSourcedRasterBand::VRTSourcedRasterBand( GDALDataType eType,
                                             int nXSize, int nYSize ) :
     m_nRecursionCounter(0),
     m_papszSourceList(nullptr),
+    m_poSourceIndex(nullptr),
     nSources(0),
     papoSources(nullptr),
     bSkipBufferInitialization(FALSE)
@@ -103,6 +117,7 @@ VRTSourcedRasterBand::VRTSourcedRasterBand( GDALDataset *poDSIn, int nBandIn,
                                             int nXSize, int nYSize ) :
     m_nRecursionCounter(0),
     m_papszSourceList(nullptr),
+    m_poSourceIndex(nullptr),
     nSources(0),
     papoSources(nullptr),
     bSkipBufferInitialization(FALSE)
@@ -124,6 +139,7 @@ VRTSourcedRasterBand::~VRTSourcedRasterBand()
 {
     VRTSourcedRasterBand::CloseDependentDatasets();
     CSLDestroy(m_papszSourceList);
+    delete m_poSourceIndex;
 }
 
 /************************************************************************/
@@ -176,6 +192,13 @@ CPLErr VRTSourcedRasterBand::IRasterIO( GDALRWFlag eRWFlag,
             return CE_None;
     }
 
+    // Only consider the sources that may intersect the request.
+    std::vector<VRTSource*> apoSourcesInWindow;
+    VRTSource** papoSourcesInWindow = nullptr;
+    const int nSourcesInWindow =
+        GetSourcesInWindow( nXOff, nYOff, nXSize, nYSize,
+                            &papoSourcesInWindow, apoSourcesInWindow );
+
     // If resampling with non-nearest neighbour, we need to be careful
     // if the VRT band exposes a nodata value, but the sources do not have it
     if( eRWFlag == GF_Read &&
@@ -183,17 +206,18 @@ CPLErr VRTSourcedRasterBand::IRasterIO( GDALRWFlag eRWFlag,
         psExtraArg->eResampleAlg != GRIORA_NearestNeighbour &&
         m_bNoDataValueSet )
     {
-        for( int i = 0; i < nSources; i++ )
+        for( int i = 0; i < nSourcesInWindow; i++ )
         {
             bool bFallbackToBase = false;
-            if( !papoSources[i]->IsSimpleSource() )
+            if( !papoSourcesInWindow[i]->IsSimpleSource() )
             {
                 bFallbackToBase = true;
             }
             else
             {
                 VRTSimpleSource* const poSource
-                    = reinterpret_cast<VRTSimpleSource *>( papoSources[i] );
+                    = reinterpret_cast<VRTSimpleSource *>(
+                        papoSourcesInWindow[i] );
                 // The window we will actually request from the source raster band.
                 double dfReqXOff = 0.0;
                 double dfReqYOff = 0.0;
@@ -284,26 +308,46 @@ CPLErr VRTSourcedRasterBand::IRasterIO( GDALRWFlag eRWFlag,
     void * const pProgressDataGlobal = psExtraArg->pProgressData;
 
 /* -------------------------------------------------------------------- */
-/*      Overlay each source in turn over top this.                      */
+/*      Read the sources concurrently if the VRT is configured so.      */
 /* -------------------------------------------------------------------- */
     CPLErr eErr = CE_None;
-    for( int iSource = 0; eErr == CE_None && iSource < nSources; iSource++ )
+    bool bTried = false;
+    VRTDataset* poVRTDS = dynamic_cast<VRTDataset *>( poDS );
+    if( poVRTDS != nullptr )
+    {
+        eErr = poVRTDS->ParallelSourcesRasterIO( nSourcesInWindow,
+                                                 papoSourcesInWindow,
+                                                 eDataType,
+                                                 nXOff, nYOff, nXSize, nYSize,
+                                                 pData, nBufXSize, nBufYSize,
+                                                 eBufType, 0, nullptr,
+                                                 nPixelSpace, nLineSpace, 0,
+                                                 psExtraArg, &bTried );
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Otherwise overlay each source in turn over top this.            */
+/* -------------------------------------------------------------------- */
+    for( int iSource = 0;
+         !bTried && eErr == CE_None && iSource < nSourcesInWindow;
+         iSource++ )
     {
         psExtraArg->pfnProgress = GDALScaledProgress;
         psExtraArg->pProgressData =
-            GDALCreateScaledProgress( 1.0 * iSource / nSources,
-                                      1.0 * (iSource + 1) / nSources,
+            GDALCreateScaledProgress( 1.0 * iSource / nSourcesInWindow,
+                                      1.0 * (iSource + 1) / nSourcesInWindow,
                                       pfnProgressGlobal,
                                       pProgressDataGlobal );
         if( psExtraArg->pProgressData == nullptr )
             psExtraArg->pfnProgress = nullptr;
 
         eErr =
-            papoSources[iSource]->RasterIO( eDataType,
-                                            nXOff, nYOff, nXSize, nYSize,
-                                            pData, nBufXSize, nBufYSize,
-                                            eBufType, nPixelSpace, nLineSpace,
-                                            psExtraArg);
+            papoSourcesInWindow[iSource]->RasterIO(
+                eDataType,
+                nXOff, nYOff, nXSize, nYSize,
+                pData, nBufXSize, nBufYSize,
+                eBufType, nPixelSpace, nLineSpace,
+                psExtraArg);
 
         GDALDestroyScaledProgress( psExtraArg->pProgressData );
     }
@@ -354,15 +398,21 @@ int  VRTSourcedRasterBand::IGetDataCoverageStatus( int nXOff,
     poLR->addPoint( nXOff, nYOff );
     poPolyNonCoveredBySources->addRingDirectly(poLR);
 
-    for( int iSource = 0; iSource < nSources; iSource++ )
+    std::vector<VRTSource*> apoSourcesInWindow;
+    VRTSource** papoSourcesInWindow = nullptr;
+    const int nSourcesInWindow =
+        GetSourcesInWindow( nXOff, nYOff, nXSize, nYSize,
+                            &papoSourcesInWindow, apoSourcesInWindow );
+
+    for( int iSource = 0; iSource < nSourcesInWindow; iSource++ )
     {
-        if( !papoSources[iSource]->IsSimpleSource() )
+        if( !papoSourcesInWindow[iSource]->IsSimpleSource() )
         {
             delete poPolyNonCoveredBySources;
             return GDAL_DATA_COVERAGE_STATUS_UNIMPLEMENTED |
                    GDAL_DATA_COVERAGE_STATUS_DATA;
         }
-        VRTSimpleSource* poSS = reinterpret_cast<VRTSimpleSource*>(papoSources[iSource]);
+        VRTSimpleSource* poSS = reinterpret_cast<VRTSimpleSource*>(papoSourcesInWindow[iSource]);
         // Check if the AOI is fully inside the source
         if( nXOff >= poSS->m_dfDstXOff &&
             nYOff >= poSS->m_dfDstYOff &&
@@ -899,6 +949,37 @@ CPLErr VRTSourcedRasterBand::AddSource( VRTSource *poNewSource )
         CPLRealloc( papoSources, sizeof(void*) * nSources ) );
     papoSources[nSources-1] = poNewSource;
 
+    // Keep the source index up to date, or drop it if the new source
+    // falls outside of its bounds. It will be rebuilt on demand.
+    if( m_poSourceIndex != nullptr && m_poSourceIndex->hQuadTree != nullptr )
+    {
+        CPLRectObj sRect;
+        if( m_poSourceIndex->nCount != nSources - 1 ||
+            !poNewSource->IsSimpleSource() )
+        {
+            InvalidateSourceIndex();
+        }
+        else if( !GetSourceIndexBounds( nSources - 1, &sRect ) )
+        {
+            m_poSourceIndex->nCount = nSources;
+        }
+        else if( sRect.minx >= m_poSourceIndex->sBounds.minx &&
+                 sRect.miny >= m_poSourceIndex->sBounds.miny &&
+                 sRect.maxx <= m_poSourceIndex->sBounds.maxx &&
+                 sRect.maxy <= m_poSourceIndex->sBounds.maxy )
+        {
+            CPLQuadTreeInsertWithBounds(
+                m_poSourceIndex->hQuadTree,
+                reinterpret_cast<void*>(static_cast<GUIntptr_t>(nSources - 1)),
+                &sRect );
+            m_poSourceIndex->nCount = nSources;
+        }
+        else
+        {
+            InvalidateSourceIndex();
+        }
+    }
+
     reinterpret_cast<VRTDataset *>( poDS )->SetNeedsFlush();
 
     if( poNewSource->IsSimpleSource() )
@@ -940,6 +1021,187 @@ CPLErr CPL_STDCALL VRTAddSource( VRTSourcedRasterBandH hVRTBand,
 
 /*! @cond Doxygen_Suppress */
 
+/************************************************************************/
+/*                        GetSourceIndexBounds()                        */
+/************************************************************************/
+
+/* Compute the rectangle under which iSource is indexed. Returns false if */
+/* the source can never contribute to a request. */
+
+bool VRTSourcedRasterBand::GetSourceIndexBounds( int iSource,
+                                                 CPLRectObj* psRect )
+{
+    VRTSimpleSource* poSS =
+        reinterpret_cast<VRTSimpleSource *>( papoSources[iSource] );
+
+    if( poSS->m_dfSrcXSize == 0.0 || poSS->m_dfSrcYSize == 0.0 ||
+        poSS->m_dfDstXSize == 0.0 || poSS->m_dfDstYSize == 0.0 )
+    {
+        return false;
+    }
+
+    const bool bDstWinSet =
+        poSS->m_dfDstXOff != -1 || poSS->m_dfDstXSize != -1 ||
+        poSS->m_dfDstYOff != -1 || poSS->m_dfDstYSize != -1;
+    if( !bDstWinSet )
+    {
+        // The source covers any request.
+        psRect->minx = 0;
+        psRect->miny = 0;
+        psRect->maxx = nRasterXSize;
+        psRect->maxy = nRasterYSize;
+        return true;
+    }
+
+    psRect->minx = poSS->m_dfDstXOff;
+    psRect->miny = poSS->m_dfDstYOff;
+    psRect->maxx = poSS->m_dfDstXOff + poSS->m_dfDstXSize;
+    psRect->maxy = poSS->m_dfDstYOff + poSS->m_dfDstYSize;
+    return true;
+}
+
+/************************************************************************/
+/*                          BuildSourceIndex()                          */
+/************************************************************************/
+
+bool VRTSourcedRasterBand::BuildSourceIndex()
+{
+    InvalidateSourceIndex();
+    if( m_poSourceIndex == nullptr )
+        m_poSourceIndex = new SourceIndex();
+
+    // Only simple sources have a destination window. Remember the failure
+    // until sources are added.
+    for( int iSource = 0; iSource < nSources; iSource++ )
+    {
+        if( !papoSources[iSource]->IsSimpleSource() )
+        {
+            m_poSourceIndex->nCount = nSources;
+            return false;
+        }
+    }
+
+    CPLRectObj& sBounds = m_poSourceIndex->sBounds;
+    sBounds.minx = 0;
+    sBounds.miny = 0;
+    sBounds.maxx = nRasterXSize;
+    sBounds.maxy = nRasterYSize;
+    std::vector<CPLRectObj> asRects(nSources);
+    std::vector<bool> abIndexed(nSources);
+    for( int iSource = 0; iSource < nSources; iSource++ )
+    {
+        abIndexed[iSource] = GetSourceIndexBounds( iSource, &asRects[iSource] );
+        if( abIndexed[iSource] )
+        {
+            const CPLRectObj& sRect = asRects[iSource];
+            sBounds.minx =
+                std::min(sBounds.minx, sRect.minx);
+            sBounds.miny =
+                std::min(sBounds.miny, sRect.miny);
+            sBounds.maxx =
+                std::max(sBounds.maxx, sRect.maxx);
+            sBounds.maxy =
+                std::max(sBounds.maxy, sRect.maxy);
+        }
+    }
+
+    m_poSourceIndex->hQuadTree = CPLQuadTreeCreate( &sBounds, nullptr );
+    CPLQuadTreeSetMaxDepth( m_poSourceIndex->hQuadTree,
+                            CPLQuadTreeGetAdvisedMaxDepth(nSources) );
+    for( int iSource = 0; iSource < nSources; iSource++ )
+    {
+        if( abIndexed[iSource] )
+        {
+            CPLQuadTreeInsertWithBounds(
+                m_poSourceIndex->hQuadTree,
+                reinterpret_cast<void*>(static_cast<GUIntptr_t>(iSource)),
+                &asRects[iSource] );
+        }
+    }
+    m_poSourceIndex->nCount = nSources;
+
+    return true;
+}
+
+/************************************************************************/
+/*                        InvalidateSourceIndex()                       */
+/************************************************************************/
+
+void VRTSourcedRasterBand::InvalidateSourceIndex()
+{
+    if( m_poSourceIndex == nullptr )
+        return;
+    if( m_poSourceIndex->hQuadTree != nullptr )
+    {
+        CPLQuadTreeDestroy( m_poSourceIndex->hQuadTree );
+        m_poSourceIndex->hQuadTree = nullptr;
+    }
+    m_poSourceIndex->nCount = 0;
+}
+
+/************************************************************************/
+/*                         GetSourcesInWindow()                         */
+/************************************************************************/
+
+/* Return the number of sources, and in *ppapoSourcesOut the sources in */
+/* declaration order, whose destination window may intersect the given */
+/* window of the band. This is a superset of the sources for which */
+/* VRTSimpleSource::GetSrcDstWindow() succeeds. */
+/* */
+/* Bands with few sources simply return all of them, as do all bands when */
+/* the VRT_SOURCE_INDEX configuration option is set to NO. Otherwise the */
+/* sources are looked up in a quad tree of their destination windows, */
+/* built on the first call, and stored in apoSourcesInWindow. */
+
+int VRTSourcedRasterBand::GetSourcesInWindow(
+                                int nXOff, int nYOff, int nXSize, int nYSize,
+                                VRTSource*** ppapoSourcesOut,
+                                std::vector<VRTSource*>& apoSourcesInWindow )
+{
+    // Below this, testing each source is about as fast as the lookup.
+    constexpr int MIN_SOURCES_FOR_INDEX = 64;
+
+    *ppapoSourcesOut = papoSources;
+    if( nSources < MIN_SOURCES_FOR_INDEX ||
+        !CPLTestBool(CPLGetConfigOption("VRT_SOURCE_INDEX", "YES")) )
+    {
+        return nSources;
+    }
+
+    // nSources and papoSources are public, so check that the index still
+    // matches them.
+    if( m_poSourceIndex == nullptr || m_poSourceIndex->nCount != nSources )
+        BuildSourceIndex();
+    if( m_poSourceIndex->hQuadTree == nullptr )
+        return nSources;
+
+    CPLRectObj sAoi;
+    sAoi.minx = nXOff;
+    sAoi.miny = nYOff;
+    sAoi.maxx = static_cast<double>(nXOff) + nXSize;
+    sAoi.maxy = static_cast<double>(nYOff) + nYSize;
+    int nFeatureCount = 0;
+    void** pahFeatures =
+        CPLQuadTreeSearch( m_poSourceIndex->hQuadTree, &sAoi, &nFeatureCount );
+    std::vector<int> anSources;
+    anSources.reserve(nFeatureCount);
+    for( int i = 0; i < nFeatureCount; i++ )
+    {
+        anSources.push_back(static_cast<int>(
+            reinterpret_cast<GUIntptr_t>(pahFeatures[i])));
+    }
+    CPLFree(pahFeatures);
+
+    // Sources must be composited in declaration order.
+    std::sort(anSources.begin(), anSources.end());
+
+    apoSourcesInWindow.resize(anSources.size());
+    for( size_t i = 0; i < anSources.size(); i++ )
+        apoSourcesInWindow[i] = papoSources[anSources[i]];
+    *ppapoSourcesOut = apoSourcesInWindow.data();
+    return static_cast<int>(apoSourcesInWindow.size());
+}
+
 /************************************************************************/
 /*                              XMLInit()                               */
 /************************************************************************/
@@ -1595,6 +1857,7 @@ CPLErr VRTSourcedRasterBand::SetMetadataItem( const char *pszName,
         {
             delete papoSources[iSource];
             papoSources[iSource] = poSource;
+            InvalidateSourceIndex();
             reinterpret_cast<VRTDataset *>( poDS )->SetNeedsFlush();
             return CE_None;
         }
@@ -1626,6 +1889,7 @@ CPLErr VRTSourcedRasterBand::SetMetadata( char **papszNewMD, const char *pszDoma
             CPLFree( papoSources );
             papoSources = nullptr;
             nSources = 0;
+            InvalidateSourceIndex();
         }
 
         for( int i = 0; i < CSLCount(papszNewMD); i++ )
@@ -1678,6 +1942,8 @@ void VRTSourcedRasterBand::GetFileList( char*** ppapszFileList, int *pnSize,
 
 int VRTSourcedRasterBand::CloseDependentDatasets()
 {
+    InvalidateSourceIndex();
+
     if( nSources == 0 )
         return FALSE;
 
@@ -34,6 +34,7 @@
 #include <map>
 
 #include "cpl_conv.h"
+#include "cpl_csv.h"
 #include "cpl_error.h"
 #include "cpl_http.h"
 #include "cpl_multiproc.h"
@@ -148,6 +149,9 @@ GDALDriverManager::GDALDriverManager() :
 void GDALDatasetPoolPreventDestroy();
 void GDALDatasetPoolForceDestroy();
 
+// Keep in sync with cpl_csv.cpp.
+void CPLCleanupCSVMutex();
+
 GDALDriverManager::~GDALDriverManager()
 
 {
@@ -296,6 +300,11 @@ GDALDriverManager::~GDALDriverManager()
 /* -------------------------------------------------------------------- */
     GDALCleanupTransformDeserializerMutex();
 
+/* -------------------------------------------------------------------- */
+/*      Cleanup gdal_rpc.cpp DEM cache mutex.                           */
+/* -------------------------------------------------------------------- */
+    GDALCleanupRPCDEMCacheMutex();
+
 /* -------------------------------------------------------------------- */
 /*      Cleanup cpl_error.cpp mutex.                                    */
 /* -------------------------------------------------------------------- */
@@ -306,6 +315,11 @@ GDALDriverManager::~GDALDriverManager()
 /* -------------------------------------------------------------------- */
     CPLCleanupSetlocaleMutex();
 
+/* -------------------------------------------------------------------- */
+/*      Cleanup cpl_csv.cpp mutex.                                      */
+/* -------------------------------------------------------------------- */
+    CPLCleanupCSVMutex();
+
 /* -------------------------------------------------------------------- */
 /*      Cleanup QHull mutex.                                            */
 /* -------------------------------------------------------------------- */
@@ -30,10 +30,14 @@
 #include "cpl_port.h"
 #include "gdal_proxy.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <map>
+#include <vector>
 
+#include "cpl_atomic_ops.h"
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_hash_set.h"
@@ -46,10 +50,13 @@
 
 CPL_CVSID("$Id: gdalproxypool.cpp ec7b85e6bb8f9737693a31f0bf7166e31e10992e 2018-04-16 00:08:36 +0200 Even Rouault $")
 
-/* We *must* share the same mutex as the gdaldataset.cpp file, as we are */
-/* doing GDALOpen() calls that can indirectly call GDALOpenShared() on */
-/* an auxiliary dataset ... */
-/* Then we could get dead-locks in multi-threaded use case */
+/* The pool is split into shards, selected from the hash of the dataset */
+/* name, each with its own LRU list, name index and mutex, so that */
+/* threads working on different datasets do not contend on the same lock. */
+/* Those mutexes are never held while calling code outside of this file: */
+/* datasets are opened and closed outside of them, since GDALOpen() can */
+/* indirectly call GDALOpenShared() on an auxiliary dataset, or create */
+/* another GDALProxyPoolDataset. */
 
 /* ******************************************************************** */
 /*                         GDALDatasetPool                              */
@@ -63,6 +70,8 @@ static GDALDatasetPool* singleton = nullptr;
 
 void GDALNullifyProxyPoolSingleton() { singleton = nullptr; }
 
+constexpr int PROXY_POOL_SHARD_COUNT = 16;
+
 struct _GDALProxyPoolCacheEntry
 {
     GIntBig       responsiblePID;
@@ -70,13 +79,52 @@ struct _GDALProxyPoolCacheEntry
     char         *pszOwner;
     GDALDataset  *poDS;
 
-    /* Ref count of the cached dataset */
-    int           refCount;
+    /* Ref count of the cached dataset. Taken under the mutex of the */
+    /* shard, but released with an atomic decrement */
+    volatile int  refCount;
+
+    /* Set while the dataset is opened outside of the mutex of the shard */
+    /* by the thread openingThreadId */
+    bool          bOpening;
+    GIntBig       openingThreadId;
+
+    /* Thread that took the last reference, so that a thread keeps on */
+    /* reusing the same handle among the ones of a same dataset */
+    GIntBig       lastThreadId;
 
     GDALProxyPoolCacheEntry* prev;
     GDALProxyPoolCacheEntry* next;
 };
 
+struct GDALProxyPoolShard
+{
+    CPLMutex* hMutex = nullptr;
+    CPLCond*  hCond = nullptr;  /* Signaled when an entry has been opened */
+    GDALProxyPoolCacheEntry* firstEntry = nullptr;
+    GDALProxyPoolCacheEntry* lastEntry = nullptr;
+    std::map<CPLString, std::vector<GDALProxyPoolCacheEntry*> > oMapNameToEntries{};
+};
+
+/************************************************************************/
+/*                   GDALProxyPoolGetDisableRefCount()                  */
+/************************************************************************/
+
+/* Per-thread counter that prevents a dataset that is going to be opened */
+/* or closed by the pool from taking a reference on the pool, if it */
+/* creates a GDALProxyPoolDataset. It is per-thread since opening and */
+/* closing are done outside of any mutex. */
+
+static int* GDALProxyPoolGetDisableRefCount()
+{
+    int* pnCount = static_cast<int*>(CPLGetTLS(CTLS_PROXYPOOL_DISABLEREFCOUNT));
+    if( pnCount == nullptr )
+    {
+        pnCount = static_cast<int*>(CPLCalloc(1, sizeof(int)));
+        CPLSetTLS(CTLS_PROXYPOOL_DISABLEREFCOUNT, pnCount, TRUE);
+    }
+    return pnCount;
+}
+
 class GDALDatasetPool
 {
     private:
@@ -89,13 +137,18 @@ class GDALDatasetPool
         int refCount;
 
         int maxSize;
-        int currentSize;
-        GDALProxyPoolCacheEntry* firstEntry;
-        GDALProxyPoolCacheEntry* lastEntry;
-
-        /* This variable prevents a dataset that is going to be opened in GDALDatasetPool::_RefDataset */
-        /* from increasing refCount if, during its opening, it creates a GDALProxyPoolDataset */
-        /* We increment it before opening or closing a cached dataset and decrement it afterwards */
+        /* Number of entries, over all the shards */
+        volatile int currentSize;
+        /* Incremented each time an entry becomes evictable. Used by */
+        /* ReserveSlot() to detect that its scan of the shards, which is */
+        /* not atomic, may have missed a victim */
+        volatile int nReleaseCount;
+        GDALProxyPoolShard aoShards[PROXY_POOL_SHARD_COUNT];
+
+        /* This variable prevents the pool from being destroyed by the */
+        /* datasets closed by GDALDestroyDriverManager(). */
+        /* See also GDALProxyPoolGetDisableRefCount() for the datasets */
+        /* opened or closed by the pool itself */
         /* The typical use case is a VRT made of simple sources that are VRT */
         /* We don't want the "inner" VRT to take a reference on the pool, otherwise there is */
         /* a high chance that this reference will not be dropped and the pool remain ghost */
@@ -113,10 +166,23 @@ class GDALDatasetPool
                                              const char* pszOwner);
         void _CloseDataset(const char* pszFileName, GDALAccess eAccess);
 
+        static GDALProxyPoolCacheEntry* FindEntry(GDALProxyPoolShard& oShard,
+                                                  const char* pszFileName,
+                                                  int bShared,
+                                                  const char* pszOwner);
+        static void MoveToFront(GDALProxyPoolShard& oShard,
+                                GDALProxyPoolCacheEntry* cur);
+        static void DetachEntry(GDALProxyPoolShard& oShard,
+                                GDALProxyPoolCacheEntry* cur);
+        static void DestroyEntry(GDALProxyPoolCacheEntry* cur);
+        static void TakeRef(GDALProxyPoolShard& oShard,
+                            GDALProxyPoolCacheEntry* cur);
+        bool ReserveSlot(int iShard);
+
 #ifdef DEBUG_PROXY_POOL
         // cppcheck-suppress unusedPrivateFunction
         void ShowContent();
-        void CheckLinks();
+        void CheckLinks(GDALProxyPoolShard& oShard);
 #endif
 
     public:
@@ -144,10 +210,11 @@ GDALDatasetPool::GDALDatasetPool(int maxSizeIn)
     bInDestruction = false;
     maxSize = maxSizeIn;
     currentSize = 0;
-    firstEntry = nullptr;
-    lastEntry = nullptr;
+    nReleaseCount = 0;
     refCount = 0;
     refCountOfDisableRefCount = 0;
+    for( int i = 0; i < PROXY_POOL_SHARD_COUNT; i++ )
+        aoShards[i].hCond = CPLCreateCond();
 }
 
 /************************************************************************/
@@ -157,23 +224,24 @@ GDALDatasetPool::GDALDatasetPool(int maxSizeIn)
 GDALDatasetPool::~GDALDatasetPool()
 {
     bInDestruction = true;
-    GDALProxyPoolCacheEntry* cur = firstEntry;
-    GIntBig responsiblePID = GDALGetResponsiblePIDForCurrentThread();
-    while(cur)
+    for( int i = 0; i < PROXY_POOL_SHARD_COUNT; i++ )
     {
-        GDALProxyPoolCacheEntry* next = cur->next;
-        CPLFree(cur->pszFileName);
-        CPLFree(cur->pszOwner);
-        CPLAssert(cur->refCount == 0);
-        if (cur->poDS)
+        GDALProxyPoolCacheEntry* cur = aoShards[i].firstEntry;
+        while(cur)
         {
-            GDALSetResponsiblePIDForCurrentThread(cur->responsiblePID);
-            GDALClose(cur->poDS);
+            GDALProxyPoolCacheEntry* next = cur->next;
+            CPLAssert(cur->refCount == 0);
+            DestroyEntry(cur);
+            cur = next;
         }
-        CPLFree(cur);
-        cur = next;
+        aoShards[i].firstEntry = nullptr;
+        aoShards[i].lastEntry = nullptr;
+        aoShards[i].oMapNameToEntries.clear();
+        if( aoShards[i].hCond )
+            CPLDestroyCond(aoShards[i].hCond);
+        if( aoShards[i].hMutex )
+            CPLDestroyMutex(aoShards[i].hMutex);
     }
-    GDALSetResponsiblePIDForCurrentThread(responsiblePID);
 }
 
 #ifdef DEBUG_PROXY_POOL
@@ -183,16 +251,19 @@ GDALDatasetPool::~GDALDatasetPool()
 
 void GDALDatasetPool::ShowContent()
 {
-    GDALProxyPoolCacheEntry* cur = firstEntry;
     int i = 0;
-    while(cur)
+    for( int iShard = 0; iShard < PROXY_POOL_SHARD_COUNT; iShard++ )
     {
-        printf("[%d] pszFileName=%s, owner=%s, refCount=%d, responsiblePID=%d\n",/*ok*/
-               i, cur->pszFileName,
-               cur->pszOwner ? cur->pszOwner : "(null)",
-               cur->refCount, (int)cur->responsiblePID);
-        i++;
-        cur = cur->next;
+        GDALProxyPoolCacheEntry* cur = aoShards[iShard].firstEntry;
+        while(cur)
+        {
+            printf("[%d] shard=%d, pszFileName=%s, owner=%s, refCount=%d, responsiblePID=%d\n",/*ok*/
+                   i, iShard, cur->pszFileName,
+                   cur->pszOwner ? cur->pszOwner : "(null)",
+                   cur->refCount, (int)cur->responsiblePID);
+            i++;
+            cur = cur->next;
+        }
     }
 }
 
@@ -200,161 +271,315 @@ void GDALDatasetPool::ShowContent()
 /*                             CheckLinks()                             */
 /************************************************************************/
 
-void GDALDatasetPool::CheckLinks()
+void GDALDatasetPool::CheckLinks(GDALProxyPoolShard& oShard)
 {
-    GDALProxyPoolCacheEntry* cur = firstEntry;
-    int i = 0;
+    GDALProxyPoolCacheEntry* cur = oShard.firstEntry;
     while(cur)
     {
-        CPLAssert(cur == firstEntry || cur->prev->next == cur);
-        CPLAssert(cur == lastEntry || cur->next->prev == cur);
-        ++i;
-        CPLAssert(cur->next != nullptr || cur == lastEntry);
+        CPLAssert(cur == oShard.firstEntry || cur->prev->next == cur);
+        CPLAssert(cur == oShard.lastEntry || cur->next->prev == cur);
+        CPLAssert(cur->next != nullptr || cur == oShard.lastEntry);
         cur = cur->next;
     }
-    CPLAssert(i == currentSize);
+    CPLAssert(currentSize <= maxSize);
 }
 #endif
 
 /************************************************************************/
-/*                            _RefDataset()                             */
+/*                             FindEntry()                              */
+/*                                                                      */
+/*      Must be called with the mutex of the shard held.                */
 /************************************************************************/
 
-GDALProxyPoolCacheEntry* GDALDatasetPool::_RefDataset(const char* pszFileName,
-                                                      GDALAccess eAccess,
-                                                      char** papszOpenOptions,
-                                                      int bShared,
-                                                      bool bForceOpen,
-                                                      const char* pszOwner)
+GDALProxyPoolCacheEntry* GDALDatasetPool::FindEntry(GDALProxyPoolShard& oShard,
+                                                    const char* pszFileName,
+                                                    int bShared,
+                                                    const char* pszOwner)
 {
-    if( bInDestruction )
+    auto oIter = oShard.oMapNameToEntries.find(pszFileName);
+    if( oIter == oShard.oMapNameToEntries.end() )
         return nullptr;
 
-    GDALProxyPoolCacheEntry* cur = firstEntry;
-    GIntBig responsiblePID = GDALGetResponsiblePIDForCurrentThread();
-    GDALProxyPoolCacheEntry* lastEntryWithZeroRefCount = nullptr;
-
-    while(cur)
+    const GIntBig responsiblePID = GDALGetResponsiblePIDForCurrentThread();
+    const GIntBig threadId = CPLGetPID();
+    GDALProxyPoolCacheEntry* found = nullptr;
+    for( GDALProxyPoolCacheEntry* cur : oIter->second )
     {
-        GDALProxyPoolCacheEntry* next = cur->next;
-
-        if (strcmp(cur->pszFileName, pszFileName) == 0 &&
-            ((bShared && cur->responsiblePID == responsiblePID &&
-              ((cur->pszOwner == nullptr && pszOwner == nullptr) ||
-                (cur->pszOwner != nullptr && pszOwner != nullptr &&
-                 strcmp(cur->pszOwner, pszOwner) == 0))) ||
-             (!bShared && cur->refCount == 0)) )
+        if( bShared )
         {
-            if (cur != firstEntry)
+            if( cur->responsiblePID == responsiblePID &&
+                ((cur->pszOwner == nullptr && pszOwner == nullptr) ||
+                 (cur->pszOwner != nullptr && pszOwner != nullptr &&
+                  strcmp(cur->pszOwner, pszOwner) == 0)) )
             {
-                /* Move to begin */
-                if (cur->next)
-                    cur->next->prev = cur->prev;
-                else
-                    lastEntry = cur->prev;
-                cur->prev->next = cur->next;
-                cur->prev = nullptr;
-                firstEntry->prev = cur;
-                cur->next = firstEntry;
-                firstEntry = cur;
-
-#ifdef DEBUG_PROXY_POOL
-                CheckLinks();
-#endif
+                return cur;
             }
-
-            cur->refCount ++;
-            return cur;
         }
+        else if( cur->refCount == 0 )
+        {
+            /* Prefer the handle last used by this thread */
+            if( cur->lastThreadId == threadId )
+                return cur;
+            if( found == nullptr )
+                found = cur;
+        }
+    }
+    return found;
+}
+
+/************************************************************************/
+/*                            MoveToFront()                             */
+/************************************************************************/
+
+void GDALDatasetPool::MoveToFront(GDALProxyPoolShard& oShard,
+                                  GDALProxyPoolCacheEntry* cur)
+{
+    if (cur == oShard.firstEntry)
+        return;
+
+    if (cur->next)
+        cur->next->prev = cur->prev;
+    else
+        oShard.lastEntry = cur->prev;
+    cur->prev->next = cur->next;
+    cur->prev = nullptr;
+    oShard.firstEntry->prev = cur;
+    cur->next = oShard.firstEntry;
+    oShard.firstEntry = cur;
+}
+
+/************************************************************************/
+/*                            DetachEntry()                             */
+/*                                                                      */
+/*      Removes an entry from the LRU list and the name index of its    */
+/*      shard, whose mutex must be held.                                */
+/************************************************************************/
+
+void GDALDatasetPool::DetachEntry(GDALProxyPoolShard& oShard,
+                                  GDALProxyPoolCacheEntry* cur)
+{
+    if (cur->prev)
+        cur->prev->next = cur->next;
+    else
+        oShard.firstEntry = cur->next;
+    if (cur->next)
+        cur->next->prev = cur->prev;
+    else
+        oShard.lastEntry = cur->prev;
+    cur->prev = nullptr;
+    cur->next = nullptr;
+
+    auto oIter = oShard.oMapNameToEntries.find(cur->pszFileName);
+    if( oIter != oShard.oMapNameToEntries.end() )
+    {
+        std::vector<GDALProxyPoolCacheEntry*>& apoEntries = oIter->second;
+        apoEntries.erase(std::remove(apoEntries.begin(), apoEntries.end(), cur),
+                         apoEntries.end());
+        if( apoEntries.empty() )
+            oShard.oMapNameToEntries.erase(oIter);
+    }
+}
 
-        if (cur->refCount == 0)
-            lastEntryWithZeroRefCount = cur;
+/************************************************************************/
+/*                           DestroyEntry()                             */
+/*                                                                      */
+/*      Closes the dataset of a detached entry and frees it. Must be    */
+/*      called without any mutex of the pool held.                      */
+/************************************************************************/
 
-        cur = next;
+void GDALDatasetPool::DestroyEntry(GDALProxyPoolCacheEntry* cur)
+{
+    if (cur->poDS)
+    {
+        /* Close by pretending we are the thread that GDALOpen'ed this */
+        /* dataset */
+        const GIntBig responsiblePID = GDALGetResponsiblePIDForCurrentThread();
+        GDALSetResponsiblePIDForCurrentThread(cur->responsiblePID);
+
+        int* pnDisableRefCount = GDALProxyPoolGetDisableRefCount();
+        (*pnDisableRefCount) ++;
+        GDALClose(cur->poDS);
+        (*pnDisableRefCount) --;
+
+        GDALSetResponsiblePIDForCurrentThread(responsiblePID);
     }
+    CPLFree(cur->pszFileName);
+    CPLFree(cur->pszOwner);
+    CPLFree(cur);
+}
 
-    if( !bForceOpen )
-        return nullptr;
+/************************************************************************/
+/*                            ReserveSlot()                             */
+/*                                                                      */
+/*      Accounts for a new entry, closing the least recently used       */
+/*      unreferenced dataset if the pool is full. The shard of the new  */
+/*      entry is tried first, then the other ones.                      */
+/************************************************************************/
 
-    if (currentSize == maxSize)
+bool GDALDatasetPool::ReserveSlot(int iShard)
+{
+    while( true )
     {
-        if (lastEntryWithZeroRefCount == nullptr)
+        const int nSize = currentSize;
+        if( nSize < maxSize )
+        {
+            if( CPLAtomicCompareAndExchange(&currentSize, nSize, nSize + 1) )
+                return true;
+            continue;
+        }
+
+        const int nReleaseCountBefore = nReleaseCount;
+        GDALProxyPoolCacheEntry* victim = nullptr;
+        for( int i = 0; i < PROXY_POOL_SHARD_COUNT && victim == nullptr; i++ )
+        {
+            GDALProxyPoolShard& oShard =
+                aoShards[(iShard + i) % PROXY_POOL_SHARD_COUNT];
+            CPLMutexHolderD(&oShard.hMutex);
+            for( GDALProxyPoolCacheEntry* cur = oShard.lastEntry;
+                 cur != nullptr; cur = cur->prev )
+            {
+                if( cur->refCount == 0 && !cur->bOpening )
+                {
+                    victim = cur;
+                    DetachEntry(oShard, victim);
+#ifdef DEBUG_PROXY_POOL
+                    CheckLinks(oShard);
+#endif
+                    break;
+                }
+            }
+        }
+
+        if( victim == nullptr )
         {
+            /* Entries released or slots freed while we were scanning */
+            if( nReleaseCount != nReleaseCountBefore ||
+                currentSize < maxSize )
+                continue;
             CPLError(CE_Failure, CPLE_AppDefined,
                      "Too many threads are running for the current value of the dataset pool size (%d).\n"
                      "or too many proxy datasets are opened in a cascaded way.\n"
                      "Try increasing GDAL_MAX_DATASET_POOL_SIZE.", maxSize);
-            return nullptr;
+            return false;
         }
 
-        lastEntryWithZeroRefCount->pszFileName[0] = '\0';
-        if (lastEntryWithZeroRefCount->poDS)
-        {
-            /* Close by pretending we are the thread that GDALOpen'ed this */
-            /* dataset */
-            GDALSetResponsiblePIDForCurrentThread(lastEntryWithZeroRefCount->responsiblePID);
+        CPLAtomicDec(&currentSize);
+        DestroyEntry(victim);
+    }
+}
 
-            refCountOfDisableRefCount ++;
-            GDALClose(lastEntryWithZeroRefCount->poDS);
-            refCountOfDisableRefCount --;
+/************************************************************************/
+/*                              TakeRef()                               */
+/*                                                                      */
+/*      Takes a reference on an entry found in a shard, whose mutex     */
+/*      must be held.                                                   */
+/************************************************************************/
 
-            lastEntryWithZeroRefCount->poDS = nullptr;
-            GDALSetResponsiblePIDForCurrentThread(responsiblePID);
-        }
-        CPLFree(lastEntryWithZeroRefCount->pszFileName);
-        CPLFree(lastEntryWithZeroRefCount->pszOwner);
-
-        /* Recycle this entry for the to-be-opened dataset and */
-        /* moves it to the top of the list */
-        if (lastEntryWithZeroRefCount->prev)
-            lastEntryWithZeroRefCount->prev->next = lastEntryWithZeroRefCount->next;
-        else {
-            CPLAssert(false);
-        }
-        if (lastEntryWithZeroRefCount->next)
-            lastEntryWithZeroRefCount->next->prev = lastEntryWithZeroRefCount->prev;
-        else
-        {
-            CPLAssert(lastEntryWithZeroRefCount == lastEntry);
-            lastEntry->prev->next = nullptr;
-            lastEntry = lastEntry->prev;
-        }
-        lastEntryWithZeroRefCount->prev = nullptr;
-        lastEntryWithZeroRefCount->next = firstEntry;
-        firstEntry->prev = lastEntryWithZeroRefCount;
-        cur = firstEntry = lastEntryWithZeroRefCount;
+void GDALDatasetPool::TakeRef(GDALProxyPoolShard& oShard,
+                              GDALProxyPoolCacheEntry* cur)
+{
+    MoveToFront(oShard, cur);
 #ifdef DEBUG_PROXY_POOL
-        CheckLinks();
+    CheckLinks(oShard);
 #endif
+    const GIntBig nThreadId = CPLGetPID();
+    CPLAtomicInc(&(cur->refCount));
+    cur->lastThreadId = nThreadId;
+
+    /* Another thread with the same responsible PID may be opening it. */
+    /* If this thread is the one opening it (re-entrant open of the same */
+    /* file), return the entry with a null dataset, as it is not */
+    /* available yet */
+    while( cur->bOpening && cur->openingThreadId != nThreadId )
+        CPLCondWait(oShard.hCond, oShard.hMutex);
+}
+
+/************************************************************************/
+/*                            _RefDataset()                             */
+/************************************************************************/
+
+GDALProxyPoolCacheEntry* GDALDatasetPool::_RefDataset(const char* pszFileName,
+                                                      GDALAccess eAccess,
+                                                      char** papszOpenOptions,
+                                                      int bShared,
+                                                      bool bForceOpen,
+                                                      const char* pszOwner)
+{
+    if( bInDestruction )
+        return nullptr;
+
+    const int iShard = static_cast<int>(
+        CPLHashSetHashStr(pszFileName) % PROXY_POOL_SHARD_COUNT);
+    GDALProxyPoolShard& oShard = aoShards[iShard];
+
+    {
+        CPLMutexHolderD(&oShard.hMutex);
+        GDALProxyPoolCacheEntry* cur =
+            FindEntry(oShard, pszFileName, bShared, pszOwner);
+        if( cur != nullptr )
+        {
+            TakeRef(oShard, cur);
+            return cur;
+        }
     }
-    else
+
+    if( !bForceOpen )
+        return nullptr;
+
+    /* Make room for the new entry outside of the mutex of the shard, */
+    /* since this may close a dataset */
+    if( !ReserveSlot(iShard) )
+        return nullptr;
+
+    GDALProxyPoolCacheEntry* cur = nullptr;
     {
+        CPLMutexHolderD(&oShard.hMutex);
+
+        /* Another thread may have opened it meanwhile */
+        cur = FindEntry(oShard, pszFileName, bShared, pszOwner);
+        if( cur != nullptr )
+        {
+            CPLAtomicDec(&currentSize);
+            TakeRef(oShard, cur);
+            return cur;
+        }
+
         /* Prepend */
-        cur = static_cast<GDALProxyPoolCacheEntry*>(CPLMalloc(sizeof(GDALProxyPoolCacheEntry)));
-        if (lastEntry == nullptr)
-            lastEntry = cur;
-        cur->prev = nullptr;
-        cur->next = firstEntry;
-        if (firstEntry)
-            firstEntry->prev = cur;
-        firstEntry = cur;
-        currentSize ++;
+        cur = static_cast<GDALProxyPoolCacheEntry*>(
+            CPLCalloc(1, sizeof(GDALProxyPoolCacheEntry)));
+        cur->pszFileName = CPLStrdup(pszFileName);
+        cur->pszOwner = (pszOwner) ? CPLStrdup(pszOwner) : nullptr;
+        cur->responsiblePID = GDALGetResponsiblePIDForCurrentThread();
+        cur->refCount = 1;
+        cur->bOpening = true;
+        cur->openingThreadId = CPLGetPID();
+        cur->lastThreadId = cur->openingThreadId;
+        cur->next = oShard.firstEntry;
+        if (oShard.firstEntry)
+            oShard.firstEntry->prev = cur;
+        else
+            oShard.lastEntry = cur;
+        oShard.firstEntry = cur;
+        oShard.oMapNameToEntries[pszFileName].push_back(cur);
 #ifdef DEBUG_PROXY_POOL
-        CheckLinks();
+        CheckLinks(oShard);
 #endif
     }
 
-    cur->pszFileName = CPLStrdup(pszFileName);
-    cur->pszOwner = (pszOwner) ? CPLStrdup(pszOwner) : nullptr;
-    cur->responsiblePID = responsiblePID;
-    cur->refCount = 1;
-
-    refCountOfDisableRefCount ++;
+    int* pnDisableRefCount = GDALProxyPoolGetDisableRefCount();
+    (*pnDisableRefCount) ++;
     int nFlag = ((eAccess == GA_Update) ? GDAL_OF_UPDATE : GDAL_OF_READONLY) | GDAL_OF_RASTER | GDAL_OF_VERBOSE_ERROR;
     CPLConfigOptionSetter oSetter("CPL_ALLOW_VSISTDIN", "NO", true);
-    cur->poDS = GDALDataset::Open( pszFileName, nFlag, nullptr,
-                                            papszOpenOptions, nullptr );
-    refCountOfDisableRefCount --;
+    GDALDataset* poDS = GDALDataset::Open( pszFileName, nFlag, nullptr,
+                                           papszOpenOptions, nullptr );
+    (*pnDisableRefCount) --;
+
+    {
+        CPLMutexHolderD(&oShard.hMutex);
+        cur->poDS = poDS;
+        cur->bOpening = false;
+        CPLCondBroadcast(oShard.hCond);
+    }
 
     return cur;
 }
@@ -366,36 +591,37 @@ GDALProxyPoolCacheEntry* GDALDatasetPool::_RefDataset(const char* pszFileName,
 void GDALDatasetPool::_CloseDataset( const char* pszFileName,
                                      GDALAccess /* eAccess */ )
 {
-    GDALProxyPoolCacheEntry* cur = firstEntry;
-    GIntBig responsiblePID = GDALGetResponsiblePIDForCurrentThread();
+    if( bInDestruction )
+        return;
 
-    while(cur)
-    {
-        GDALProxyPoolCacheEntry* next = cur->next;
+    const int iShard = static_cast<int>(
+        CPLHashSetHashStr(pszFileName) % PROXY_POOL_SHARD_COUNT);
+    GDALProxyPoolShard& oShard = aoShards[iShard];
+    GDALProxyPoolCacheEntry* victim = nullptr;
 
-        CPLAssert(cur->pszFileName);
-        if (strcmp(cur->pszFileName, pszFileName) == 0 && cur->refCount == 0 &&
-            cur->poDS != nullptr )
+    {
+        CPLMutexHolderD(&oShard.hMutex);
+        auto oIter = oShard.oMapNameToEntries.find(pszFileName);
+        if( oIter == oShard.oMapNameToEntries.end() )
+            return;
+        for( GDALProxyPoolCacheEntry* cur : oIter->second )
         {
-            /* Close by pretending we are the thread that GDALOpen'ed this */
-            /* dataset */
-            GDALSetResponsiblePIDForCurrentThread(cur->responsiblePID);
-
-            refCountOfDisableRefCount ++;
-            GDALClose(cur->poDS);
-            refCountOfDisableRefCount --;
-
-            GDALSetResponsiblePIDForCurrentThread(responsiblePID);
-
-            cur->poDS = nullptr;
-            cur->pszFileName[0] = '\0';
-            CPLFree(cur->pszOwner);
-            cur->pszOwner = nullptr;
-            break;
+            if( cur->refCount == 0 && cur->poDS != nullptr && !cur->bOpening )
+            {
+                victim = cur;
+                break;
+            }
         }
-
-        cur = next;
+        if( victim == nullptr )
+            return;
+        DetachEntry(oShard, victim);
+#ifdef DEBUG_PROXY_POOL
+        CheckLinks(oShard);
+#endif
     }
+
+    CPLAtomicDec(&currentSize);
+    DestroyEntry(victim);
 }
 
 /************************************************************************/
@@ -412,7 +638,8 @@ void GDALDatasetPool::Ref()
             l_maxSize = 100;
         singleton = new GDALDatasetPool(l_maxSize);
     }
-    if (singleton->refCountOfDisableRefCount == 0)
+    if (singleton->refCountOfDisableRefCount == 0 &&
+        *GDALProxyPoolGetDisableRefCount() == 0)
       singleton->refCount++;
 }
 
@@ -445,7 +672,8 @@ void GDALDatasetPool::Unref()
         CPLAssert(false);
         return;
     }
-    if (singleton->refCountOfDisableRefCount == 0)
+    if (singleton->refCountOfDisableRefCount == 0 &&
+        *GDALProxyPoolGetDisableRefCount() == 0)
     {
       singleton->refCount--;
       if (singleton->refCount == 0)
@@ -488,7 +716,6 @@ GDALProxyPoolCacheEntry* GDALDatasetPool::RefDataset(const char* pszFileName,
                                                      bool bForceOpen,
                                                      const char* pszOwner)
 {
-    CPLMutexHolderD( GDALGetphDLMutex() );
     return singleton->_RefDataset(pszFileName, eAccess, papszOpenOptions,
                                   bShared, bForceOpen, pszOwner);
 }
@@ -499,8 +726,8 @@ GDALProxyPoolCacheEntry* GDALDatasetPool::RefDataset(const char* pszFileName,
 
 void GDALDatasetPool::UnrefDataset(GDALProxyPoolCacheEntry* cacheEntry)
 {
-    CPLMutexHolderD( GDALGetphDLMutex() );
-    cacheEntry->refCount --;
+    if( CPLAtomicDec(&(cacheEntry->refCount)) == 0 && singleton != nullptr )
+        CPLAtomicInc(&(singleton->nReleaseCount));
 }
 
 /************************************************************************/
@@ -509,7 +736,6 @@ void GDALDatasetPool::UnrefDataset(GDALProxyPoolCacheEntry* cacheEntry)
 
 void GDALDatasetPool::CloseDataset(const char* pszFileName, GDALAccess eAccess)
 {
-    CPLMutexHolderD( GDALGetphDLMutex() );
     singleton->_CloseDataset(pszFileName, eAccess);
 }
 
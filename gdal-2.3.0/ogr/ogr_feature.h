@@ -362,6 +362,14 @@ class CPL_DLL OGRFeature
     char                *m_pszNativeMediaType;
 
     bool                SetFieldInternal( int i, OGRField * puValue );
+    bool                CopyStringField( int iField, const char* pszValue );
+
+    friend class OGRLayer;
+    void                FreeResetStorage();
+    void                TakeStringBuffers( std::vector<char*>& apszBuffers,
+                                           std::vector<size_t>& anSizes );
+    void                GiveStringBuffers( std::vector<char*>& apszBuffers,
+                                           std::vector<size_t>& anSizes );
 
   protected:
 //! @cond Doxygen_Suppress
@@ -595,6 +603,7 @@ class CPL_DLL OGRFeature
 
     OGRFeature         *Clone() const CPL_WARN_UNUSED_RESULT;
     virtual OGRBoolean  Equal( const OGRFeature * poFeature ) const;
+    void                Reset();
 
     int                 GetFieldCount() const
         { return poDefn->GetFieldCount(); }
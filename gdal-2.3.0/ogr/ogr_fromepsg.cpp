@@ -47,6 +47,7 @@
 #include "cpl_conv.h"
 #include "cpl_csv.h"
 #include "cpl_error.h"
+#include "cpl_mem_cache.h"
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
 #include "ogr_core.h"
@@ -61,6 +62,7 @@ int EPSGGetWGS84Transform( int nGeogCS, std::vector<CPLString>& asTransform );
 void OGREPSGDatumNameMassage( char ** ppszDatum );
 
 void CleanupFindMatchesCacheAndMutex();
+void CleanupEPSGImportCache();
 
 static const char * const apszDatumEquiv[] =
 {
@@ -83,6 +85,16 @@ static std::vector<OGRSpatialReference*>* papoSRSCache_GEOGCS = nullptr;
 static std::map<CPLString, int>* poMapESRIPROJCSNameToEPSGCode = nullptr;
 static std::map<CPLString, int>* poMapESRIGEOGCSNameToEPSGCode = nullptr;
 
+// Process-wide cache of the SRS built by importFromEPSGA(), keyed by code,
+// requested SRS type and location of the EPSG support files.
+typedef lru11::Cache<std::string, std::shared_ptr<OGRSpatialReference>>
+                                                        OGREPSGImportCache;
+static CPLMutex* hEPSGImportCacheMutex = nullptr;
+static OGREPSGImportCache* poEPSGImportCache = nullptr;
+static bool bEPSGImportCacheInitialized = false;
+static GUIntBig nEPSGImportCacheHits = 0;
+static GUIntBig nEPSGImportCacheMisses = 0;
+
 /************************************************************************/
 /*                      OGREPSGDatumNameMassage()                       */
 /*                                                                      */
@@ -2205,6 +2217,52 @@ OGRErr OGRSpatialReference::importFromEPSGA( int nCode )
     return importFromEPSGAInternal(nCode, nullptr);
 }
 
+/************************************************************************/
+/*                      GetEPSGImportCache_unlocked()                   */
+/*                                                                      */
+/*      Returns nullptr if the cache is disabled with                   */
+/*      OSR_EPSG_CACHE_SIZE=0.  Must be called with                     */
+/*      hEPSGImportCacheMutex held.                                     */
+/************************************************************************/
+
+static OGREPSGImportCache* GetEPSGImportCache_unlocked()
+{
+    if( !bEPSGImportCacheInitialized )
+    {
+        bEPSGImportCacheInitialized = true;
+        const int nCacheSize =
+            atoi(CPLGetConfigOption("OSR_EPSG_CACHE_SIZE", "256"));
+        if( nCacheSize > 0 )
+            poEPSGImportCache = new OGREPSGImportCache(nCacheSize, 0);
+    }
+    return poEPSGImportCache;
+}
+
+/************************************************************************/
+/*                        CleanupEPSGImportCache()                      */
+/************************************************************************/
+
+void CleanupEPSGImportCache()
+{
+    if( poEPSGImportCache != nullptr )
+    {
+        CPLDebug( "OSR",
+                  "EPSG import cache: " CPL_FRMT_GUIB " hits, "
+                  CPL_FRMT_GUIB " misses",
+                  nEPSGImportCacheHits, nEPSGImportCacheMisses );
+    }
+    delete poEPSGImportCache;
+    poEPSGImportCache = nullptr;
+    bEPSGImportCacheInitialized = false;
+    nEPSGImportCacheHits = 0;
+    nEPSGImportCacheMisses = 0;
+    if( hEPSGImportCacheMutex != nullptr )
+    {
+        CPLDestroyMutex(hEPSGImportCacheMutex);
+        hEPSGImportCacheMutex = nullptr;
+    }
+}
+
 /************************************************************************/
 /*                       importFromEPSGAInternal()                      */
 /************************************************************************/
@@ -2227,6 +2285,25 @@ OGRErr OGRSpatialReference::importFromEPSGAInternal( int nCode,
         poRoot = nullptr;
     }
 
+/* -------------------------------------------------------------------- */
+/*      Reuse a previous import of the same code if we have one.        */
+/* -------------------------------------------------------------------- */
+    const std::string osCacheKey(
+        CPLSPrintf("%d|%s|%s", nCodeIn, pszSRSType ? pszSRSType : "",
+                   CSVFilename( "gcs.csv" )));
+    {
+        CPLMutexHolderD( &hEPSGImportCacheMutex );
+        OGREPSGImportCache* poCache = GetEPSGImportCache_unlocked();
+        std::shared_ptr<OGRSpatialReference> poCachedSRS;
+        if( poCache != nullptr && poCache->tryGet(osCacheKey, poCachedSRS) )
+        {
+            nEPSGImportCacheHits++;
+            *this = *poCachedSRS;
+            return OGRERR_NONE;
+        }
+        nEPSGImportCacheMisses++;
+    }
+
 /* -------------------------------------------------------------------- */
 /*      Verify that we can find the required filename(s).               */
 /* -------------------------------------------------------------------- */
@@ -2340,6 +2417,15 @@ OGRErr OGRSpatialReference::importFromEPSGAInternal( int nCode,
         eErr = FixupOrdering();
     }
 
+    if( eErr == OGRERR_NONE )
+    {
+        std::shared_ptr<OGRSpatialReference> poCachedSRS(Clone());
+        CPLMutexHolderD( &hEPSGImportCacheMutex );
+        OGREPSGImportCache* poCache = GetEPSGImportCache_unlocked();
+        if( poCache != nullptr )
+            poCache->insert(osCacheKey, poCachedSRS);
+    }
+
     return eErr;
 }
 
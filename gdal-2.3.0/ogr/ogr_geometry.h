@@ -283,11 +283,21 @@ class CPL_DLL OGRDefaultConstGeometryVisitor: public IOGRConstGeometryVisitor
  *
  */
 
+//! @cond Doxygen_Suppress
+struct OGRGeometryGEOSCache;
+//! @endcond
+
 class CPL_DLL OGRGeometry
 {
   private:
     OGRSpatialReference * poSRS;                // may be NULL
 
+//! @cond Doxygen_Suppress
+    friend struct OGRGeometryGEOSCache;
+
+    void         invalidateGEOSCacheSlow() const;
+//! @endcond
+
   protected:
 //! @cond Doxygen_Suppress
     friend class OGRCurveCollection;
@@ -322,6 +332,12 @@ class CPL_DLL OGRGeometry
 
     void         HomogenizeDimensionalityWith( OGRGeometry* poOtherGeom );
 
+    // To be called by the methods that modify the geometry, so that the
+    // GEOS cache of this geometry, or of a geometry it is part of, is
+    // rebuilt. See enableGEOSCache().
+    void         invalidateGEOSCache()
+        { if( flags & OGR_G_GEOS_CACHED ) invalidateGEOSCacheSlow(); }
+
 //! @endcond
 
   public:
@@ -337,6 +353,9 @@ class CPL_DLL OGRGeometry
     static const unsigned int OGR_G_NOT_EMPTY_POINT = 0x1;
     static const unsigned int OGR_G_3D = 0x2;
     static const unsigned int OGR_G_MEASURED = 0x4;
+    // Set on geometries on which enableGEOSCache() has been called, and on
+    // their parts. See invalidateGEOSCache().
+    static const unsigned int OGR_G_GEOS_CACHED = 0x8;
 //! @endcond
 
                 OGRGeometry();
@@ -412,6 +431,7 @@ class CPL_DLL OGRGeometry
     static void freeGEOSContext( GEOSContextHandle_t hGEOSCtxt );
     virtual GEOSGeom exportToGEOS( GEOSContextHandle_t hGEOSCtxt )
         const CPL_WARN_UNUSED_RESULT;
+    void enableGEOSCache( bool bEnable = true );
     virtual OGRBoolean hasCurveGeometry(int bLookForNonLinear = FALSE) const;
     virtual OGRGeometry* getCurveGeometry(
         const char* const* papszOptions = nullptr ) const CPL_WARN_UNUSED_RESULT;
@@ -862,21 +882,25 @@ class CPL_DLL OGRPoint : public OGRGeometry
     /** Set x
      * @param xIn x
      */
-    void        setX( double xIn ) { x = xIn; flags |= OGR_G_NOT_EMPTY_POINT; }
+    void        setX( double xIn )
+        { invalidateGEOSCache(); x = xIn; flags |= OGR_G_NOT_EMPTY_POINT; }
     /** Set y
      * @param yIn y
      */
-    void        setY( double yIn ) { y = yIn; flags |= OGR_G_NOT_EMPTY_POINT; }
+    void        setY( double yIn )
+        { invalidateGEOSCache(); y = yIn; flags |= OGR_G_NOT_EMPTY_POINT; }
     /** Set z
      * @param zIn z
      */
     void        setZ( double zIn )
-        { z = zIn; flags |= (OGR_G_NOT_EMPTY_POINT | OGR_G_3D); }
+        { invalidateGEOSCache();
+          z = zIn; flags |= (OGR_G_NOT_EMPTY_POINT | OGR_G_3D); }
     /** Set m
      * @param mIn m
      */
     void        setM( double mIn )
-        { m = mIn; flags |= (OGR_G_NOT_EMPTY_POINT | OGR_G_MEASURED); }
+        { invalidateGEOSCache();
+          m = mIn; flags |= (OGR_G_NOT_EMPTY_POINT | OGR_G_MEASURED); }
 
     // ISpatialRelation
     virtual OGRBoolean  Equals( const OGRGeometry * ) const override;
@@ -94,6 +94,8 @@ void CPL_DLL OGRMakeWktCoordinateM( char *, double, double, double, double, OGRB
 void OGRFormatDouble( char *pszBuffer, int nBufferLen, double dfVal,
                       char chDecimalSep, int nPrecision = 15, char chConversionSpecifier = 'f' );
 
+void OGRSwapDoubleArray( void *pData, size_t nCount );
+
 /* -------------------------------------------------------------------- */
 /*      Date-time parsing and processing functions                      */
 /* -------------------------------------------------------------------- */
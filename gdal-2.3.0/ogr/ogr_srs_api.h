@@ -955,6 +955,7 @@ OCTTransformEx( OGRCoordinateTransformationH hCT,
 char *OCTProj4Normalize( const char *pszProj4Src );
 
 void OCTCleanupProjMutex( void );
+void OCTCleanupTransformationCache( void );
 /*! @endcond */
 
 /* -------------------------------------------------------------------- */
@@ -352,6 +352,7 @@ void OGRCircularString::getEnvelope( OGREnvelope3D * psEnvelope ) const
 
 void OGRCircularString::segmentize( double dfMaxLength )
 {
+    invalidateGEOSCache();
     if( !IsValidFast() || nPointCount == 0 )
         return;
 
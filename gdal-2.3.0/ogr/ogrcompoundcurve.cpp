@@ -226,7 +226,7 @@ OGRGeometry *OGRCompoundCurve::clone() const
 {
     OGRCompoundCurve *poNewCC = new OGRCompoundCurve;
     poNewCC->assignSpatialReference( getSpatialReference() );
-    poNewCC->flags = flags;
+    poNewCC->flags = flags & ~OGR_G_GEOS_CACHED;
 
     for( int i = 0; i < oCC.nCurveCount; i++ )
     {
@@ -499,6 +499,7 @@ const OGRCurve *OGRCompoundCurve::getCurve( int iCurve ) const
 
 OGRCurve* OGRCompoundCurve::stealCurve( int iCurve )
 {
+    invalidateGEOSCache();
     return oCC.stealCurve(iCurve);
 }
 
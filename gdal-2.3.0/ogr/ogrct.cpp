@@ -30,11 +30,16 @@
 #include "cpl_port.h"
 #include "ogr_spatialref.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_mem_cache.h"
 #include "cpl_multiproc.h"
 #include "cpl_string.h"
 #include "ogr_core.h"
@@ -144,6 +149,795 @@ void OCTCleanupProjMutex()
 #endif
 }
 
+/************************************************************************/
+/*                    Coordinate transformation cache                   */
+/*                                                                      */
+/*      Process-wide LRU cache, keyed by the WKT of the source and      */
+/*      target SRS, of the PROJ.4 definitions computed for the pair.    */
+/*      Each entry also keeps a small pool of idle PROJ handles that    */
+/*      released transformations hand back.  A pooled handle set owns   */
+/*      its own context, so it is only used by one OGRProj4CT at a      */
+/*      time.                                                           */
+/************************************************************************/
+
+namespace {
+
+struct OGRProj4CTHandles
+{
+#if PROJ_VERSION == 4
+    projCtx     pjctx = nullptr;
+    void       *psPJSource = nullptr;
+    void       *psPJTarget = nullptr;
+#else
+    PJ_CONTEXT *pjctx = nullptr;
+    PJ         *pj = nullptr;
+#endif
+};
+
+struct OGRProj4CTCacheEntry
+{
+    CPLString   osSrcProj4Defn{};
+    CPLString   osDstProj4Defn{};
+    bool        bWebMercatorToWGS84 = false;
+    std::vector<OGRProj4CTHandles> aoIdleHandles{};
+
+    OGRProj4CTCacheEntry() = default;
+    ~OGRProj4CTCacheEntry();
+
+    CPL_DISALLOW_COPY_ASSIGN(OGRProj4CTCacheEntry)
+};
+
+} // namespace
+
+typedef lru11::Cache<std::string, std::shared_ptr<OGRProj4CTCacheEntry>>
+                                                            OGRProj4CTCache;
+
+// Maximum number of idle handle sets kept for a given SRS pair.
+constexpr size_t MAX_IDLE_HANDLES_PER_ENTRY = 8;
+
+static CPLMutex *hCTCacheMutex = nullptr;
+static OGRProj4CTCache *poCTCache = nullptr;
+static bool bCTCacheInitialized = false;
+static GUIntBig nCTCacheHits = 0;
+static GUIntBig nCTCacheMisses = 0;
+
+/************************************************************************/
+/*                         OGRProj4CTFreeHandles()                      */
+/************************************************************************/
+
+static void OGRProj4CTFreeHandles( OGRProj4CTHandles& sHandles )
+{
+#if PROJ_VERSION == 4
+    if( sHandles.psPJSource != nullptr )
+        pfn_pj_free( sHandles.psPJSource );
+    if( sHandles.psPJTarget != nullptr )
+        pfn_pj_free( sHandles.psPJTarget );
+    if( sHandles.pjctx != nullptr )
+        pfn_pj_ctx_free( sHandles.pjctx );
+#else
+    if( sHandles.pj != nullptr )
+        proj_destroy( sHandles.pj );
+    if( sHandles.pjctx != nullptr )
+        proj_context_destroy( sHandles.pjctx );
+#endif
+    sHandles = OGRProj4CTHandles();
+}
+
+/************************************************************************/
+/*                        ~OGRProj4CTCacheEntry()                       */
+/************************************************************************/
+
+OGRProj4CTCacheEntry::~OGRProj4CTCacheEntry()
+{
+    for( size_t i = 0; i < aoIdleHandles.size(); i++ )
+        OGRProj4CTFreeHandles( aoIdleHandles[i] );
+}
+
+/************************************************************************/
+/*                         GetCTCache_unlocked()                        */
+/*                                                                      */
+/*      Returns nullptr if the cache is disabled with                   */
+/*      OGR_CT_CACHE_SIZE=0.  Must be called with hCTCacheMutex held.   */
+/************************************************************************/
+
+static OGRProj4CTCache *GetCTCache_unlocked()
+{
+    if( !bCTCacheInitialized )
+    {
+        bCTCacheInitialized = true;
+        const int nCacheSize =
+            atoi(CPLGetConfigOption("OGR_CT_CACHE_SIZE", "64"));
+        if( nCacheSize > 0 )
+            poCTCache = new OGRProj4CTCache(nCacheSize, 0);
+    }
+    return poCTCache;
+}
+
+/************************************************************************/
+/*                      OCTCleanupTransformationCache()                 */
+/************************************************************************/
+
+void OCTCleanupTransformationCache()
+{
+    if( poCTCache != nullptr || nCTCacheHits + nCTCacheMisses > 0 )
+    {
+        CPLDebug( "OGRCT",
+                  "Transformation cache: " CPL_FRMT_GUIB " hits, "
+                  CPL_FRMT_GUIB " misses",
+                  nCTCacheHits, nCTCacheMisses );
+    }
+    delete poCTCache;
+    poCTCache = nullptr;
+    bCTCacheInitialized = false;
+    nCTCacheHits = 0;
+    nCTCacheMisses = 0;
+    if( hCTCacheMutex != nullptr )
+    {
+        CPLDestroyMutex(hCTCacheMutex);
+        hCTCacheMutex = nullptr;
+    }
+}
+
+/************************************************************************/
+/*                       Built-in transformation paths                  */
+/*                                                                      */
+/*      Direct implementations of a few common transformations that     */
+/*      do not involve a datum shift, so that they do not need to go    */
+/*      through pj_transform(): geographic to Web Mercator, geographic  */
+/*      to and from UTM / extended transverse Mercator, and geographic  */
+/*      to and from geocentric.  The transverse Mercator uses the       */
+/*      6th order Krüger series (Karney, 2011) also used by PROJ's      */
+/*      etmerc, and by its utm since PROJ 5.  Before PROJ 5, utm uses   */
+/*      the series of tmerc, which departs from it far from the         */
+/*      central meridian, so utm definitions go through PROJ then.      */
+/*                                                                      */
+/*      They are only used when the OGR_CT_FAST_PATH configuration      */
+/*      option is set to YES.                                           */
+/************************************************************************/
+
+namespace {
+
+enum OGRCTFastPathType
+{
+    OGRCT_FAST_PATH_NONE,
+    OGRCT_FAST_PATH_GEOG_TO_WEBMERC,
+    OGRCT_FAST_PATH_GEOG_TO_TM,
+    OGRCT_FAST_PATH_TM_TO_GEOG,
+    OGRCT_FAST_PATH_GEOG_TO_GEOCENT,
+    OGRCT_FAST_PATH_GEOCENT_TO_GEOG
+};
+
+constexpr int OGRCT_TM_ORDER = 6;
+
+struct OGRCTFastPath
+{
+    OGRCTFastPathType eType = OGRCT_FAST_PATH_NONE;
+
+    // Ellipsoid.
+    double      dfA = 0.0;
+    double      dfEs = 0.0;   // Eccentricity squared.
+    double      dfE = 0.0;
+
+    // Transverse Mercator.
+    double      dfLon0 = 0.0;
+    double      dfK0A = 0.0;  // Scale factor times rectifying radius.
+    double      dfX0 = 0.0;
+    double      dfY0 = 0.0;   // False northing minus northing of lat_0.
+    double      adfAlpha[OGRCT_TM_ORDER] = {};
+    double      adfBeta[OGRCT_TM_ORDER] = {};
+};
+
+} // namespace
+
+/************************************************************************/
+/*                            OGRCTAdjLon()                             */
+/*                                                                      */
+/*      Same as PROJ's adjlon().                                        */
+/************************************************************************/
+
+static double OGRCTAdjLon( double dfLon )
+{
+    constexpr double SPI = 3.14159265359;
+    if( fabs(dfLon) <= SPI )
+        return dfLon;
+    dfLon += M_PI;
+    dfLon -= 2 * M_PI * floor(dfLon / (2 * M_PI));
+    dfLon -= M_PI;
+    return dfLon;
+}
+
+/************************************************************************/
+/*                        OGRCTCheckGeogInput()                         */
+/*                                                                      */
+/*      Input validation done by pj_fwd().  Returns false if the point  */
+/*      must be rejected, and snaps latitudes just beyond the poles.    */
+/************************************************************************/
+
+static bool OGRCTCheckGeogInput( double dfLon, double& dfLat )
+{
+    constexpr double EPS = 1.0e-12;
+    const double t = fabs(dfLat) - M_PI / 2;
+    if( t > EPS || fabs(dfLon) > 10.0 )
+        return false;
+    if( fabs(t) <= EPS )
+        dfLat = dfLat < 0.0 ? -M_PI / 2 : M_PI / 2;
+    return true;
+}
+
+/************************************************************************/
+/*                      OGRCTParseProj4Ellipsoid()                      */
+/*                                                                      */
+/*      Parse a PROJ.4 definition made only of the listed parameters    */
+/*      plus datum / ellipsoid ones.  The datum parameters are          */
+/*      returned in osDatum so that two definitions can be checked for  */
+/*      the same datum, and the ellipsoid in dfA and dfEs.  Only a few  */
+/*      common ellipsoids are recognized.                               */
+/************************************************************************/
+
+static bool OGRCTParseProj4Ellipsoid( const char *pszProj4Defn,
+                                      const char * const *papszAllowedKeys,
+                                      CPLStringList& aosParams,
+                                      CPLString& osDatum,
+                                      double& dfA, double& dfEs )
+{
+    const CPLStringList aosTokens(CSLTokenizeString2(pszProj4Defn, " ", 0));
+    for( int i = 0; i < aosTokens.size(); i++ )
+    {
+        const char *pszToken = aosTokens[i];
+        if( pszToken[0] != '+' )
+            return false;
+        char *pszKey = nullptr;
+        const char *pszValue = CPLParseNameValue(pszToken + 1, &pszKey);
+        if( pszKey == nullptr )
+        {
+            // Flag parameter such as +no_defs or +south.
+            pszKey = CPLStrdup(pszToken + 1);
+            pszValue = "";
+        }
+        const CPLString osKey(pszKey);
+        CPLFree(pszKey);
+
+        if( osKey == "datum" || osKey == "ellps" || osKey == "towgs84" )
+        {
+            osDatum += pszToken;
+            osDatum += ' ';
+            aosParams.SetNameValue(osKey, pszValue);
+        }
+        else if( osKey == "no_defs" )
+        {
+            // ignore
+        }
+        else if( osKey == "units" )
+        {
+            if( !EQUAL(pszValue, "m") )
+                return false;
+        }
+        else if( CSLFindString(papszAllowedKeys, osKey) >= 0 )
+        {
+            aosParams.SetNameValue(osKey, pszValue);
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    const char *pszDatum = aosParams.FetchNameValue("datum");
+    const char *pszEllps = aosParams.FetchNameValue("ellps");
+    if( pszDatum != nullptr )
+    {
+        if( EQUAL(pszDatum, "WGS84") )
+            pszEllps = "WGS84";
+        else if( EQUAL(pszDatum, "NAD83") )
+            pszEllps = "GRS80";
+        else
+            return false;
+    }
+    if( pszEllps == nullptr )
+        return false;
+
+    double dfInvFlattening = 0.0;
+    if( EQUAL(pszEllps, "WGS84") )
+        dfInvFlattening = 298.257223563;
+    else if( EQUAL(pszEllps, "GRS80") )
+        dfInvFlattening = 298.257222101;
+    else
+        return false;
+
+    const double dfFlattening = 1.0 / dfInvFlattening;
+    dfA = 6378137.0;
+    dfEs = dfFlattening * (2 - dfFlattening);
+    return true;
+}
+
+/************************************************************************/
+/*                        OGRCTSetupTMFastPath()                        */
+/************************************************************************/
+
+static bool OGRCTSetupTMFastPath( const CPLStringList& aosParams,
+                                  OGRCTFastPath& oFastPath )
+{
+    double dfLat0 = 0.0;
+    double dfK0 = 0.0;
+#if PROJ_VERSION >= 5
+    if( EQUAL(aosParams.FetchNameValue("proj"), "utm") )
+    {
+        const char *pszZone = aosParams.FetchNameValue("zone");
+        const int nZone = pszZone ? atoi(pszZone) : 0;
+        if( nZone < 1 || nZone > 60 )
+            return false;
+        oFastPath.dfLon0 = ((nZone - 0.5) * 6.0 - 180.0) * DEG_TO_RAD;
+        dfK0 = 0.9996;
+        oFastPath.dfX0 = 500000.0;
+        oFastPath.dfY0 =
+            aosParams.FetchNameValue("south") != nullptr ? 10000000.0 : 0.0;
+    }
+    else
+#endif
+    {
+        if( aosParams.FetchNameValue("south") != nullptr ||
+            aosParams.FetchNameValue("zone") != nullptr )
+            return false;
+        dfLat0 = CPLAtof(aosParams.FetchNameValueDef("lat_0", "0"))
+                                                                * DEG_TO_RAD;
+        oFastPath.dfLon0 =
+            CPLAtof(aosParams.FetchNameValueDef("lon_0", "0")) * DEG_TO_RAD;
+        dfK0 = CPLAtof(aosParams.FetchNameValueDef(
+                    "k", aosParams.FetchNameValueDef("k_0", "1")));
+        oFastPath.dfX0 = CPLAtof(aosParams.FetchNameValueDef("x_0", "0"));
+        oFastPath.dfY0 = CPLAtof(aosParams.FetchNameValueDef("y_0", "0"));
+        if( fabs(dfLat0) >= M_PI / 2 || dfK0 <= 0.0 )
+            return false;
+    }
+
+    oFastPath.dfE = sqrt(oFastPath.dfEs);
+    const double dfFlattening = 1 - sqrt(1 - oFastPath.dfEs);
+    const double n = dfFlattening / (2 - dfFlattening);
+    const double n2 = n * n;
+    const double n3 = n2 * n;
+    const double n4 = n3 * n;
+    const double n5 = n4 * n;
+    const double n6 = n5 * n;
+
+    oFastPath.dfK0A = dfK0 * oFastPath.dfA / (1 + n) *
+                      (1 + n2 / 4 + n4 / 64 + n6 / 256);
+
+    double *a = oFastPath.adfAlpha;
+    a[0] = n / 2 - 2 * n2 / 3 + 5 * n3 / 16 + 41 * n4 / 180
+           - 127 * n5 / 288 + 7891 * n6 / 37800;
+    a[1] = 13 * n2 / 48 - 3 * n3 / 5 + 557 * n4 / 1440
+           + 281 * n5 / 630 - 1983433 * n6 / 1935360;
+    a[2] = 61 * n3 / 240 - 103 * n4 / 140 + 15061 * n5 / 26880
+           + 167603 * n6 / 181440;
+    a[3] = 49561 * n4 / 161280 - 179 * n5 / 168 + 6601661 * n6 / 7257600;
+    a[4] = 34729 * n5 / 80640 - 3418889 * n6 / 1995840;
+    a[5] = 212378941 * n6 / 319334400;
+
+    double *b = oFastPath.adfBeta;
+    b[0] = n / 2 - 2 * n2 / 3 + 37 * n3 / 96 - n4 / 360
+           - 81 * n5 / 512 + 96199 * n6 / 604800;
+    b[1] = n2 / 48 + n3 / 15 - 437 * n4 / 1440 + 46 * n5 / 105
+           - 1118711 * n6 / 3870720;
+    b[2] = 17 * n3 / 480 - 37 * n4 / 840 - 209 * n5 / 4480
+           + 5569 * n6 / 90720;
+    b[3] = 4397 * n4 / 161280 - 11 * n5 / 504 - 830251 * n6 / 7257600;
+    b[4] = 4583 * n5 / 161280 - 108847 * n6 / 3991680;
+    b[5] = 20648693 * n6 / 638668800;
+
+    // Northing of the natural origin.
+    if( dfLat0 != 0.0 )
+    {
+        const double dfSinLat0 = sin(dfLat0);
+        const double dfXip = atan(sinh(atanh(dfSinLat0) -
+                                  oFastPath.dfE *
+                                      atanh(oFastPath.dfE * dfSinLat0)));
+        double dfXi = dfXip;
+        for( int j = 0; j < OGRCT_TM_ORDER; j++ )
+            dfXi += a[j] * sin(2 * (j + 1) * dfXip);
+        oFastPath.dfY0 -= oFastPath.dfK0A * dfXi;
+    }
+
+    return true;
+}
+
+/************************************************************************/
+/*                         OGRCTSetupFastPath()                         */
+/************************************************************************/
+
+static bool OGRCTSetupFastPath( const char *pszSrcProj4Defn,
+                                const char *pszDstProj4Defn,
+                                OGRCTFastPath& oFastPath )
+{
+    oFastPath = OGRCTFastPath();
+
+    // Reverse of the bWebMercatorToWGS84 case, once the definitions have
+    // been massaged.
+    if( strcmp(pszSrcProj4Defn,
+               "+proj=longlat +ellps=WGS84 +no_defs") == 0 &&
+        strcmp(pszDstProj4Defn,
+               "+proj=merc +a=6378137 +b=6378137 +lat_ts=0.0 +lon_0=0.0 "
+               "+x_0=0.0 +y_0=0 +k=1.0 +units=m +no_defs") == 0 )
+    {
+        oFastPath.eType = OGRCT_FAST_PATH_GEOG_TO_WEBMERC;
+        oFastPath.dfA = 6378137.0;
+        return true;
+    }
+
+    static const char * const apszAllowedKeys[] = {
+        "proj", "zone", "south", "lat_0", "lon_0", "k", "k_0", "x_0", "y_0",
+        nullptr };
+
+    CPLStringList aosSrcParams;
+    CPLStringList aosDstParams;
+    CPLString osSrcDatum;
+    CPLString osDstDatum;
+    double dfA = 0.0;
+    double dfEs = 0.0;
+    double dfDstA = 0.0;
+    double dfDstEs = 0.0;
+    if( !OGRCTParseProj4Ellipsoid(pszSrcProj4Defn, apszAllowedKeys,
+                                  aosSrcParams, osSrcDatum, dfA, dfEs) ||
+        !OGRCTParseProj4Ellipsoid(pszDstProj4Defn, apszAllowedKeys,
+                                  aosDstParams, osDstDatum,
+                                  dfDstA, dfDstEs) ||
+        osSrcDatum != osDstDatum )
+    {
+        return false;
+    }
+    oFastPath.dfA = dfA;
+    oFastPath.dfEs = dfEs;
+    oFastPath.dfE = sqrt(dfEs);
+
+    const char *pszSrcProj = aosSrcParams.FetchNameValueDef("proj", "");
+    const char *pszDstProj = aosDstParams.FetchNameValueDef("proj", "");
+    // Geographic and geocentric definitions must not have any projection
+    // parameter.
+    const auto HasOnlyDatumParams = [](const CPLStringList& aosParams)
+    {
+        for( int i = 0; i < aosParams.size(); i++ )
+        {
+            if( !STARTS_WITH(aosParams[i], "proj=") &&
+                !STARTS_WITH(aosParams[i], "datum=") &&
+                !STARTS_WITH(aosParams[i], "ellps=") &&
+                !STARTS_WITH(aosParams[i], "towgs84=") )
+                return false;
+        }
+        return true;
+    };
+    const bool bSrcLongLat = EQUAL(pszSrcProj, "longlat") &&
+                             HasOnlyDatumParams(aosSrcParams);
+    const bool bDstLongLat = EQUAL(pszDstProj, "longlat") &&
+                             HasOnlyDatumParams(aosDstParams);
+    const auto IsTM = [](const char *pszProj)
+    {
+#if PROJ_VERSION >= 5
+        if( EQUAL(pszProj, "utm") )
+            return true;
+#endif
+        return EQUAL(pszProj, "etmerc");
+    };
+
+    if( bSrcLongLat && IsTM(pszDstProj) )
+    {
+        oFastPath.eType = OGRCT_FAST_PATH_GEOG_TO_TM;
+        return OGRCTSetupTMFastPath(aosDstParams, oFastPath);
+    }
+    if( IsTM(pszSrcProj) && bDstLongLat )
+    {
+        oFastPath.eType = OGRCT_FAST_PATH_TM_TO_GEOG;
+        return OGRCTSetupTMFastPath(aosSrcParams, oFastPath);
+    }
+    if( bSrcLongLat && EQUAL(pszDstProj, "geocent") &&
+        HasOnlyDatumParams(aosDstParams) )
+    {
+        oFastPath.eType = OGRCT_FAST_PATH_GEOG_TO_GEOCENT;
+        return true;
+    }
+    if( EQUAL(pszSrcProj, "geocent") && HasOnlyDatumParams(aosSrcParams) &&
+        bDstLongLat )
+    {
+        oFastPath.eType = OGRCT_FAST_PATH_GEOCENT_TO_GEOG;
+        return true;
+    }
+    oFastPath.eType = OGRCT_FAST_PATH_NONE;
+    return false;
+}
+
+/************************************************************************/
+/*                       OGRCTGeogToWebMercator()                       */
+/************************************************************************/
+
+static void OGRCTGeogToWebMercator( const OGRCTFastPath& oFastPath,
+                                    int nCount, double *x, double *y )
+{
+    const double dfR = oFastPath.dfA;
+    for( int i = 0; i < nCount; i++ )
+    {
+        if( x[i] == HUGE_VAL )
+            continue;
+        double dfLat = y[i];
+        if( !OGRCTCheckGeogInput(x[i], dfLat) ||
+            fabs(fabs(dfLat) - M_PI / 2) <= 1.0e-10 )
+        {
+            x[i] = HUGE_VAL;
+            y[i] = HUGE_VAL;
+            continue;
+        }
+        x[i] = dfR * OGRCTAdjLon(x[i]);
+        y[i] = dfR * log(tan(M_PI / 4 + 0.5 * dfLat));
+    }
+}
+
+/************************************************************************/
+/*                           OGRCTGeogToTM()                            */
+/************************************************************************/
+
+static void OGRCTGeogToTM( const OGRCTFastPath& oFastPath,
+                           int nCount, double *x, double *y )
+{
+    const double e = oFastPath.dfE;
+    const double *a = oFastPath.adfAlpha;
+    for( int i = 0; i < nCount; i++ )
+    {
+        if( x[i] == HUGE_VAL )
+            continue;
+        double dfLat = y[i];
+        if( !OGRCTCheckGeogInput(x[i], dfLat) )
+        {
+            x[i] = HUGE_VAL;
+            y[i] = HUGE_VAL;
+            continue;
+        }
+        const double dfLam = OGRCTAdjLon(x[i] - oFastPath.dfLon0);
+
+        // Conformal latitude, as tan(chi).
+        const double dfSinLat = sin(dfLat);
+        const double dfTauP = sinh(atanh(dfSinLat) - e * atanh(e * dfSinLat));
+        const double dfCosLam = cos(dfLam);
+        const double dfXip = atan2(dfTauP, dfCosLam);
+        const double dfEtap =
+            asinh(sin(dfLam) / sqrt(dfTauP * dfTauP + dfCosLam * dfCosLam));
+
+        double dfXi = dfXip;
+        double dfEta = dfEtap;
+        for( int j = 0; j < OGRCT_TM_ORDER; j++ )
+        {
+            const double k = 2.0 * (j + 1);
+            dfXi += a[j] * sin(k * dfXip) * cosh(k * dfEtap);
+            dfEta += a[j] * cos(k * dfXip) * sinh(k * dfEtap);
+        }
+
+        // Same validity limit as PROJ's etmerc.
+        if( !(fabs(dfEta) <= 2.623395162778) )
+        {
+            x[i] = HUGE_VAL;
+            y[i] = HUGE_VAL;
+            continue;
+        }
+        x[i] = oFastPath.dfK0A * dfEta + oFastPath.dfX0;
+        y[i] = oFastPath.dfK0A * dfXi + oFastPath.dfY0;
+    }
+}
+
+/************************************************************************/
+/*                           OGRCTTMToGeog()                            */
+/************************************************************************/
+
+static void OGRCTTMToGeog( const OGRCTFastPath& oFastPath,
+                           int nCount, double *x, double *y )
+{
+    const double e = oFastPath.dfE;
+    const double dfOneMinusEs = 1.0 - oFastPath.dfEs;
+    const double *b = oFastPath.adfBeta;
+    for( int i = 0; i < nCount; i++ )
+    {
+        if( x[i] == HUGE_VAL )
+            continue;
+        const double dfXi = (y[i] - oFastPath.dfY0) / oFastPath.dfK0A;
+        const double dfEta = (x[i] - oFastPath.dfX0) / oFastPath.dfK0A;
+        if( !(fabs(dfEta) <= 2.623395162778) )
+        {
+            x[i] = HUGE_VAL;
+            y[i] = HUGE_VAL;
+            continue;
+        }
+
+        double dfXip = dfXi;
+        double dfEtap = dfEta;
+        for( int j = 0; j < OGRCT_TM_ORDER; j++ )
+        {
+            const double k = 2.0 * (j + 1);
+            dfXip -= b[j] * sin(k * dfXi) * cosh(k * dfEta);
+            dfEtap -= b[j] * cos(k * dfXi) * sinh(k * dfEta);
+        }
+
+        const double dfSinhEtap = sinh(dfEtap);
+        const double dfCosXip = cos(dfXip);
+        const double dfTauP =
+            sin(dfXip) / sqrt(dfSinhEtap * dfSinhEtap + dfCosXip * dfCosXip);
+        const double dfLam = atan2(dfSinhEtap, dfCosXip);
+
+        // Newton iterations to recover tan(latitude) from tan(chi).
+        double dfTau = dfTauP / dfOneMinusEs;
+        for( int iIter = 0; iIter < 5; iIter++ )
+        {
+            const double dfTau1 = sqrt(1 + dfTau * dfTau);
+            const double dfSig = sinh(e * atanh(e * dfTau / dfTau1));
+            const double dfTauPi =
+                sqrt(1 + dfSig * dfSig) * dfTau - dfSig * dfTau1;
+            const double dfDelta =
+                (dfTauP - dfTauPi) / sqrt(1 + dfTauPi * dfTauPi) *
+                (1 + dfOneMinusEs * dfTau * dfTau) /
+                (dfOneMinusEs * dfTau1);
+            dfTau += dfDelta;
+            if( !(fabs(dfDelta) >= 1e-14 * std::max(1.0, fabs(dfTau))) )
+                break;
+        }
+
+        x[i] = OGRCTAdjLon(dfLam + oFastPath.dfLon0);
+        y[i] = atan(dfTau);
+    }
+}
+
+/************************************************************************/
+/*                        OGRCTGeogToGeocent()                          */
+/************************************************************************/
+
+static void OGRCTGeogToGeocent( const OGRCTFastPath& oFastPath,
+                                int nCount, double *x, double *y, double *z )
+{
+    const double dfA = oFastPath.dfA;
+    const double dfEs = oFastPath.dfEs;
+    for( int i = 0; i < nCount; i++ )
+    {
+        if( x[i] == HUGE_VAL )
+            continue;
+
+        // Same latitude tolerance as pj_Convert_Geodetic_To_Geocentric().
+        double dfLat = y[i];
+        if( dfLat < -M_PI / 2 && dfLat > -1.001 * M_PI / 2 )
+            dfLat = -M_PI / 2;
+        else if( dfLat > M_PI / 2 && dfLat < 1.001 * M_PI / 2 )
+            dfLat = M_PI / 2;
+        else if( dfLat < -M_PI / 2 || dfLat > M_PI / 2 )
+        {
+            x[i] = HUGE_VAL;
+            y[i] = HUGE_VAL;
+            continue;
+        }
+        double dfLon = x[i];
+        if( dfLon > M_PI )
+            dfLon -= 2 * M_PI;
+
+        const double dfSinLat = sin(dfLat);
+        const double dfCosLat = cos(dfLat);
+        const double dfRn = dfA / sqrt(1 - dfEs * dfSinLat * dfSinLat);
+        const double dfH = z[i];
+        x[i] = (dfRn + dfH) * dfCosLat * cos(dfLon);
+        y[i] = (dfRn + dfH) * dfCosLat * sin(dfLon);
+        z[i] = (dfRn * (1 - dfEs) + dfH) * dfSinLat;
+    }
+}
+
+/************************************************************************/
+/*                        OGRCTGeocentToGeog()                          */
+/************************************************************************/
+
+static void OGRCTGeocentToGeog( const OGRCTFastPath& oFastPath,
+                                int nCount, double *x, double *y, double *z )
+{
+    const double dfA = oFastPath.dfA;
+    const double dfEs = oFastPath.dfEs;
+    for( int i = 0; i < nCount; i++ )
+    {
+        if( x[i] == HUGE_VAL )
+            continue;
+
+        const double dfP = sqrt(x[i] * x[i] + y[i] * y[i]);
+        const double dfZ = z[i];
+
+        // Same special cases as pj_Convert_Geocentric_To_Geodetic(): on
+        // the polar axis, the longitude is 0, and the center of the
+        // ellipsoid is at the north pole, at height -b.
+        constexpr double GENAU = 1.0e-12;
+        double dfLon = 0.0;
+        if( dfP / dfA < GENAU )
+        {
+            if( sqrt(dfP * dfP + dfZ * dfZ) / dfA < GENAU )
+            {
+                x[i] = 0.0;
+                y[i] = M_PI / 2;
+                z[i] = -dfA * sqrt(1 - dfEs);
+                continue;
+            }
+        }
+        else
+        {
+            dfLon = atan2(y[i], x[i]);
+        }
+
+        double dfLat = atan2(dfZ, dfP * (1 - dfEs));
+        double dfH = 0.0;
+        for( int iIter = 0; iIter < 10; iIter++ )
+        {
+            const double dfSinLat = sin(dfLat);
+            const double dfCosLat = cos(dfLat);
+            const double dfW = sqrt(1 - dfEs * dfSinLat * dfSinLat);
+            const double dfRn = dfA / dfW;
+            dfH = dfP * dfCosLat + dfZ * dfSinLat - dfA * dfW;
+            const double dfNewLat =
+                atan2(dfZ, dfP * (1 - dfEs * dfRn / (dfRn + dfH)));
+            const bool bConverged = fabs(dfNewLat - dfLat) < 1e-14;
+            dfLat = dfNewLat;
+            if( bConverged )
+                break;
+        }
+        {
+            const double dfSinLat = sin(dfLat);
+            dfH = dfP * cos(dfLat) + dfZ * dfSinLat -
+                  dfA * sqrt(1 - dfEs * dfSinLat * dfSinLat);
+        }
+
+        x[i] = dfLon;
+        y[i] = dfLat;
+        z[i] = dfH;
+    }
+}
+
+/************************************************************************/
+/*                         OGRCTApplyFastPath()                         */
+/*                                                                      */
+/*      Geographic coordinates are in radians.  Returns 0 or the PROJ   */
+/*      error code that pj_transform() would have returned.             */
+/************************************************************************/
+
+static int OGRCTApplyFastPath( const OGRCTFastPath& oFastPath,
+                               int nCount, double *x, double *y, double *z )
+{
+    switch( oFastPath.eType )
+    {
+        case OGRCT_FAST_PATH_GEOG_TO_WEBMERC:
+            OGRCTGeogToWebMercator(oFastPath, nCount, x, y);
+            break;
+
+        case OGRCT_FAST_PATH_GEOG_TO_TM:
+            OGRCTGeogToTM(oFastPath, nCount, x, y);
+            break;
+
+        case OGRCT_FAST_PATH_TM_TO_GEOG:
+            OGRCTTMToGeog(oFastPath, nCount, x, y);
+            break;
+
+        case OGRCT_FAST_PATH_GEOG_TO_GEOCENT:
+        case OGRCT_FAST_PATH_GEOCENT_TO_GEOG:
+        {
+#if PROJ_VERSION == 4
+            // PJD_ERR_GEOCENTRIC: pj_transform() needs Z for geocentric
+            // source or target coordinates.
+            if( z == nullptr )
+                return -45;
+#else
+            // proj_trans_generic() takes a missing Z as 0.
+            std::vector<double> adfZ;
+            if( z == nullptr )
+            {
+                adfZ.resize(nCount);
+                z = adfZ.data();
+            }
+#endif
+            if( oFastPath.eType == OGRCT_FAST_PATH_GEOG_TO_GEOCENT )
+                OGRCTGeogToGeocent(oFastPath, nCount, x, y, z);
+            else
+                OGRCTGeocentToGeog(oFastPath, nCount, x, y, z);
+            break;
+        }
+
+        case OGRCT_FAST_PATH_NONE:
+            break;
+    }
+    return 0;
+}
+
 /************************************************************************/
 /*                              OGRProj4CT                              */
 /************************************************************************/
@@ -164,6 +958,7 @@ class OGRProj4CT : public OGRCoordinateTransformation
 
     bool        bIdentityTransform = false;
     bool        bWebMercatorToWGS84 = false;
+    OGRCTFastPath oFastPath{};
 
     int         nErrorCount = 0;
 
@@ -179,8 +974,14 @@ class OGRProj4CT : public OGRCoordinateTransformation
     PJ*         m_pj = nullptr;
 #endif
 
+    CPLString   m_osCacheKey{};
+
     int         InitializeNoLock( OGRSpatialReference *poSource,
                                   OGRSpatialReference *poTarget );
+    int         ComputeProj4Defns( char **ppszSrcProj4Defn,
+                                   char **ppszDstProj4Defn );
+    bool        AcquireCachedHandles( OGRProj4CTCacheEntry& oEntry );
+    bool        ReleaseHandlesToCache();
 
     int         nMaxCount = 0;
     double     *padfOriX = nullptr;
@@ -582,39 +1383,123 @@ OGRProj4CT::~OGRProj4CT()
             delete poSRSTarget;
     }
 
-#if PROJ_VERSION == 4
-    if( pjctx != nullptr )
+    // Hand our PROJ handles back to the transformation cache if possible,
+    // otherwise free them.
+    if( !ReleaseHandlesToCache() )
     {
-        if( psPJSource != nullptr )
-            pfn_pj_free( psPJSource );
+#if PROJ_VERSION == 4
+        if( pjctx != nullptr )
+        {
+            if( psPJSource != nullptr )
+                pfn_pj_free( psPJSource );
 
-        if( psPJTarget != nullptr )
-            pfn_pj_free( psPJTarget );
+            if( psPJTarget != nullptr )
+                pfn_pj_free( psPJTarget );
 
-        pfn_pj_ctx_free(pjctx);
+            pfn_pj_ctx_free(pjctx);
+        }
+        else
+        {
+            CPLMutexHolderD( &hPROJMutex );
+
+            if( psPJSource != nullptr )
+                pfn_pj_free( psPJSource );
+
+            if( psPJTarget != nullptr )
+                pfn_pj_free( psPJTarget );
+        }
+#else
+        if( m_pj )
+            proj_destroy(m_pj);
+        proj_context_destroy(m_pjctx);
+#endif
     }
-    else
-    {
-        CPLMutexHolderD( &hPROJMutex );
 
-        if( psPJSource != nullptr )
-            pfn_pj_free( psPJSource );
+    CPLFree(padfOriX);
+    CPLFree(padfOriY);
+    CPLFree(padfOriZ);
+    CPLFree(padfTargetX);
+    CPLFree(padfTargetY);
+    CPLFree(padfTargetZ);
+}
+
+/************************************************************************/
+/*                        AcquireCachedHandles()                        */
+/*                                                                      */
+/*      Takes over an idle set of PROJ handles from a cache entry, in   */
+/*      place of the context allocated by the constructor.  Must be     */
+/*      called with hCTCacheMutex held.                                 */
+/************************************************************************/
+
+bool OGRProj4CT::AcquireCachedHandles( OGRProj4CTCacheEntry& oEntry )
+{
+    if( oEntry.aoIdleHandles.empty() )
+        return false;
+
+    OGRProj4CTHandles sHandles = oEntry.aoIdleHandles.back();
+    oEntry.aoIdleHandles.pop_back();
+
+#if PROJ_VERSION == 4
+    if( pjctx != nullptr )
+        pfn_pj_ctx_free( pjctx );
+    pjctx = sHandles.pjctx;
+    psPJSource = sHandles.psPJSource;
+    psPJTarget = sHandles.psPJTarget;
+#else
+    proj_context_destroy( m_pjctx );
+    m_pjctx = sHandles.pjctx;
+    m_pj = sHandles.pj;
+#endif
+    return true;
+}
+
+/************************************************************************/
+/*                        ReleaseHandlesToCache()                       */
+/*                                                                      */
+/*      Returns true if the PROJ handles of this object have been       */
+/*      handed over to the transformation cache.                        */
+/************************************************************************/
+
+bool OGRProj4CT::ReleaseHandlesToCache()
+{
+    if( m_osCacheKey.empty() )
+        return false;
+
+    OGRProj4CTHandles sHandles;
+#if PROJ_VERSION == 4
+    // Handles created without a context are shared with the global PROJ
+    // state and cannot be handed out to another thread.
+    if( pjctx == nullptr || psPJSource == nullptr || psPJTarget == nullptr )
+        return false;
+    sHandles.pjctx = pjctx;
+    sHandles.psPJSource = psPJSource;
+    sHandles.psPJTarget = psPJTarget;
+#else
+    if( m_pj == nullptr )
+        return false;
+    sHandles.pjctx = m_pjctx;
+    sHandles.pj = m_pj;
+#endif
 
-        if( psPJTarget != nullptr )
-            pfn_pj_free( psPJTarget );
+    CPLMutexHolderD( &hCTCacheMutex );
+    OGRProj4CTCache *poCache = GetCTCache_unlocked();
+    std::shared_ptr<OGRProj4CTCacheEntry> poEntry;
+    if( poCache == nullptr || !poCache->tryGet(m_osCacheKey, poEntry) ||
+        poEntry->aoIdleHandles.size() >= MAX_IDLE_HANDLES_PER_ENTRY )
+    {
+        return false;
     }
+
+    poEntry->aoIdleHandles.push_back(sHandles);
+#if PROJ_VERSION == 4
+    pjctx = nullptr;
+    psPJSource = nullptr;
+    psPJTarget = nullptr;
 #else
-    if( m_pj )
-        proj_destroy(m_pj);
-    proj_context_destroy(m_pjctx);
+    m_pjctx = nullptr;
+    m_pj = nullptr;
 #endif
-
-    CPLFree(padfOriX);
-    CPLFree(padfOriY);
-    CPLFree(padfOriZ);
-    CPLFree(padfTargetX);
-    CPLFree(padfTargetY);
-    CPLFree(padfTargetZ);
+    return true;
 }
 
 /************************************************************************/
@@ -739,126 +1624,90 @@ int OGRProj4CT::InitializeNoLock( OGRSpatialReference * poSourceIn,
     // means debug output could be one "increment" late.
     static int nDebugReportCount = 0;
 
-    char *pszSrcProj4Defn = nullptr;
-
-    if( poSRSSource->exportToProj4( &pszSrcProj4Defn ) != OGRERR_NONE )
+/* -------------------------------------------------------------------- */
+/*      Look up the PROJ.4 definitions, and possibly ready to use       */
+/*      PROJ handles, in the process-wide transformation cache.         */
+/* -------------------------------------------------------------------- */
+    bool bCacheEnabled = false;
     {
-        CPLFree( pszSrcProj4Defn );
-        return FALSE;
+        CPLMutexHolderD( &hCTCacheMutex );
+        bCacheEnabled = GetCTCache_unlocked() != nullptr;
     }
 
-    if( strlen(pszSrcProj4Defn) == 0 )
+    CPLString osCacheKey;
+    if( bCacheEnabled )
     {
-        CPLFree( pszSrcProj4Defn );
-        CPLError( CE_Failure, CPLE_AppDefined,
-                  "No PROJ.4 translation for source SRS, coordinate "
-                  "transformation initialization has failed." );
-        return FALSE;
+        char *pszSrcWKT = nullptr;
+        char *pszDstWKT = nullptr;
+        if( poSRSSource->exportToWkt( &pszSrcWKT ) == OGRERR_NONE &&
+            poSRSTarget->exportToWkt( &pszDstWKT ) == OGRERR_NONE )
+        {
+            osCacheKey = pszSrcWKT;
+            osCacheKey += '\n';
+            osCacheKey += pszDstWKT;
+            // exportToProj4() output depends on those options.
+            osCacheKey += '\n';
+            osCacheKey += CPLGetConfigOption("OSR_USE_ETMERC", "");
+            osCacheKey += '\n';
+            osCacheKey += CPLGetConfigOption(
+                "OVERRIDE_PROJ_DATUM_WITH_TOWGS84", "");
+        }
+        CPLFree( pszSrcWKT );
+        CPLFree( pszDstWKT );
     }
 
+    char *pszSrcProj4Defn = nullptr;
     char *pszDstProj4Defn = nullptr;
+    bool bCacheHit = false;
 
-    if( poSRSTarget->exportToProj4( &pszDstProj4Defn ) != OGRERR_NONE )
+    if( !osCacheKey.empty() )
     {
-        CPLFree( pszSrcProj4Defn );
-        CPLFree( pszDstProj4Defn );
-        return FALSE;
+        CPLMutexHolderD( &hCTCacheMutex );
+        OGRProj4CTCache *poCache = GetCTCache_unlocked();
+        std::shared_ptr<OGRProj4CTCacheEntry> poEntry;
+        if( poCache != nullptr && poCache->tryGet(osCacheKey, poEntry) )
+        {
+            nCTCacheHits++;
+            bCacheHit = true;
+            pszSrcProj4Defn = CPLStrdup(poEntry->osSrcProj4Defn);
+            pszDstProj4Defn = CPLStrdup(poEntry->osDstProj4Defn);
+            bWebMercatorToWGS84 = poEntry->bWebMercatorToWGS84;
+            AcquireCachedHandles(*poEntry);
+        }
+        else
+        {
+            nCTCacheMisses++;
+        }
     }
 
-    if( strlen(pszDstProj4Defn) == 0 )
+    if( !bCacheHit &&
+        !ComputeProj4Defns( &pszSrcProj4Defn, &pszDstProj4Defn ) )
     {
-        CPLFree( pszSrcProj4Defn );
-        CPLFree( pszDstProj4Defn );
-        CPLError( CE_Failure, CPLE_AppDefined,
-                  "No PROJ.4 translation for destination SRS, coordinate "
-                  "transformation initialization has failed." );
         return FALSE;
     }
 
 /* -------------------------------------------------------------------- */
-/*      Optimization to avoid useless nadgrids evaluation.              */
-/*      For example when converting between WGS84 and WebMercator       */
+/*      Check if one of the built-in transformations can be used        */
+/*      instead of PROJ.4.                                              */
 /* -------------------------------------------------------------------- */
-    if( pszSrcProj4Defn[strlen(pszSrcProj4Defn)-1] == ' ' )
-        pszSrcProj4Defn[strlen(pszSrcProj4Defn)-1] = 0;
-    if( pszDstProj4Defn[strlen(pszDstProj4Defn)-1] == ' ' )
-        pszDstProj4Defn[strlen(pszDstProj4Defn)-1] = 0;
-    char* pszNeedle = strstr(pszSrcProj4Defn, "  ");
-    if( pszNeedle )
-        memmove(pszNeedle, pszNeedle + 1, strlen(pszNeedle + 1)+1);
-    pszNeedle = strstr(pszDstProj4Defn, "  ");
-    if( pszNeedle )
-        memmove(pszNeedle, pszNeedle + 1, strlen(pszNeedle + 1)+1);
-
-    if( (strstr(pszSrcProj4Defn, "+datum=WGS84") != nullptr ||
-         strstr(pszSrcProj4Defn,
-                "+ellps=WGS84 +towgs84=0,0,0,0,0,0,0 ") != nullptr) &&
-        strstr(pszDstProj4Defn, "+nadgrids=@null ") != nullptr &&
-        strstr(pszDstProj4Defn, "+towgs84") == nullptr )
+    if( !bWebMercatorToWGS84 && !bCheckWithInvertProj &&
+        CPLTestBool(CPLGetConfigOption("OGR_CT_FAST_PATH", "NO")) &&
+        OGRCTSetupFastPath(pszSrcProj4Defn, pszDstProj4Defn, oFastPath) )
     {
-        char* pszDst = strstr(pszSrcProj4Defn, "+towgs84=0,0,0,0,0,0,0 ");
-        if( pszDst != nullptr )
-        {
-            char *pszSrc = pszDst + strlen("+towgs84=0,0,0,0,0,0,0 ");
-            memmove(pszDst, pszSrc, strlen(pszSrc)+1);
-        }
-        else
-        {
-            memcpy(strstr(pszSrcProj4Defn, "+datum=WGS84"), "+ellps", 6);
-        }
-
-        pszDst = strstr(pszDstProj4Defn, "+nadgrids=@null ");
-        char *pszSrc = pszDst + strlen("+nadgrids=@null ");
-        memmove(pszDst, pszSrc, strlen(pszSrc)+1);
-
-        pszDst = strstr(pszDstProj4Defn, "+wktext ");
-        if( pszDst )
-        {
-            pszSrc = pszDst + strlen("+wktext ");
-            memmove(pszDst, pszSrc, strlen(pszSrc)+1);
-        }
+        CPLDebug( "OGRCT", "Using built-in transformation" );
     }
     else
-    if( (strstr(pszDstProj4Defn, "+datum=WGS84") != nullptr ||
-         strstr(pszDstProj4Defn,
-                "+ellps=WGS84 +towgs84=0,0,0,0,0,0,0 ") != nullptr) &&
-        strstr(pszSrcProj4Defn, "+nadgrids=@null ") != nullptr &&
-        strstr(pszSrcProj4Defn, "+towgs84") == nullptr )
     {
-        char* pszDst = strstr(pszDstProj4Defn, "+towgs84=0,0,0,0,0,0,0 ");
-        if( pszDst != nullptr)
-        {
-            char* pszSrc = pszDst + strlen("+towgs84=0,0,0,0,0,0,0 ");
-            memmove(pszDst, pszSrc, strlen(pszSrc)+1);
-        }
-        else
-        {
-            memcpy(strstr(pszDstProj4Defn, "+datum=WGS84"), "+ellps", 6);
-        }
-
-        pszDst = strstr(pszSrcProj4Defn, "+nadgrids=@null ");
-        char* pszSrc = pszDst + strlen("+nadgrids=@null ");
-        memmove(pszDst, pszSrc, strlen(pszSrc)+1);
-
-        pszDst = strstr(pszSrcProj4Defn, "+wktext ");
-        if( pszDst )
-        {
-            pszSrc = pszDst + strlen("+wktext ");
-            memmove(pszDst, pszSrc, strlen(pszSrc)+1);
-        }
-        bWebMercatorToWGS84 =
-            strcmp(pszDstProj4Defn,
-                   "+proj=longlat +ellps=WGS84 +no_defs") == 0 &&
-            strcmp(pszSrcProj4Defn,
-                   "+proj=merc +a=6378137 +b=6378137 +lat_ts=0.0 +lon_0=0.0 "
-                   "+x_0=0.0 +y_0=0 +k=1.0 +units=m +no_defs") == 0;
+        oFastPath = OGRCTFastPath();
     }
+    const bool bUsePROJ = !bWebMercatorToWGS84 &&
+                          oFastPath.eType == OGRCT_FAST_PATH_NONE;
 
 /* -------------------------------------------------------------------- */
 /*      Establish PROJ.4 handle for source if projection.               */
 /* -------------------------------------------------------------------- */
 #if PROJ_VERSION == 4
-    if( !bWebMercatorToWGS84 )
+    if( bUsePROJ && psPJSource == nullptr )
     {
         if( pjctx )
             psPJSource = pfn_pj_init_plus_ctx( pjctx, pszSrcProj4Defn );
@@ -900,7 +1749,7 @@ int OGRProj4CT::InitializeNoLock( OGRSpatialReference * poSourceIn,
         CPLDebug( "OGRCT", "Source: %s", pszSrcProj4Defn );
 
 #if PROJ_VERSION == 4
-    if( !bWebMercatorToWGS84 && psPJSource == nullptr )
+    if( bUsePROJ && psPJSource == nullptr )
     {
         CPLFree( pszSrcProj4Defn );
         CPLFree( pszDstProj4Defn );
@@ -912,7 +1761,7 @@ int OGRProj4CT::InitializeNoLock( OGRSpatialReference * poSourceIn,
 /*      Establish PROJ.4 handle for target if projection.               */
 /* -------------------------------------------------------------------- */
 #if PROJ_VERSION == 4
-    if( !bWebMercatorToWGS84 )
+    if( bUsePROJ && psPJTarget == nullptr )
     {
         if( pjctx )
             psPJTarget = pfn_pj_init_plus_ctx( pjctx, pszDstProj4Defn );
@@ -933,7 +1782,7 @@ int OGRProj4CT::InitializeNoLock( OGRSpatialReference * poSourceIn,
     }
 
 #if PROJ_VERSION >= 5
-    if( !bWebMercatorToWGS84 )
+    if( bUsePROJ && m_pj == nullptr )
     {
         CPLString osPipeline("+proj=pipeline +step ");
         osPipeline += pszSrcProj4Defn;
@@ -957,7 +1806,7 @@ int OGRProj4CT::InitializeNoLock( OGRSpatialReference * poSourceIn,
         }
     }
 #else
-    if( !bWebMercatorToWGS84 && psPJTarget == nullptr )
+    if( bUsePROJ && psPJTarget == nullptr )
     {
         CPLFree( pszSrcProj4Defn );
         CPLFree( pszDstProj4Defn );
@@ -965,6 +1814,28 @@ int OGRProj4CT::InitializeNoLock( OGRSpatialReference * poSourceIn,
     }
 #endif
 
+/* -------------------------------------------------------------------- */
+/*      Remember the definitions for the next transformation between    */
+/*      the same SRS pair.                                              */
+/* -------------------------------------------------------------------- */
+    if( !osCacheKey.empty() )
+    {
+        if( !bCacheHit )
+        {
+            std::shared_ptr<OGRProj4CTCacheEntry> poEntry(
+                new OGRProj4CTCacheEntry());
+            poEntry->osSrcProj4Defn = pszSrcProj4Defn;
+            poEntry->osDstProj4Defn = pszDstProj4Defn;
+            poEntry->bWebMercatorToWGS84 = bWebMercatorToWGS84;
+
+            CPLMutexHolderD( &hCTCacheMutex );
+            OGRProj4CTCache *poCache = GetCTCache_unlocked();
+            if( poCache != nullptr && !poCache->contains(osCacheKey) )
+                poCache->insert(osCacheKey, poEntry);
+        }
+        m_osCacheKey = osCacheKey;
+    }
+
     // Determine if we really have a transformation to do at the proj.4 level
     // (but we may have a unit transformation to do)
     bIdentityTransform = strcmp(pszSrcProj4Defn, pszDstProj4Defn) == 0;
@@ -982,6 +1853,138 @@ int OGRProj4CT::InitializeNoLock( OGRSpatialReference * poSourceIn,
     return TRUE;
 }
 
+/************************************************************************/
+/*                         ComputeProj4Defns()                          */
+/*                                                                      */
+/*      Export the source and target SRS to the PROJ.4 definitions      */
+/*      used to build the transformation.                               */
+/************************************************************************/
+
+int OGRProj4CT::ComputeProj4Defns( char **ppszSrcProj4Defn,
+                                   char **ppszDstProj4Defn )
+
+{
+    char *pszSrcProj4Defn = nullptr;
+
+    if( poSRSSource->exportToProj4( &pszSrcProj4Defn ) != OGRERR_NONE )
+    {
+        CPLFree( pszSrcProj4Defn );
+        return FALSE;
+    }
+
+    if( strlen(pszSrcProj4Defn) == 0 )
+    {
+        CPLFree( pszSrcProj4Defn );
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "No PROJ.4 translation for source SRS, coordinate "
+                  "transformation initialization has failed." );
+        return FALSE;
+    }
+
+    char *pszDstProj4Defn = nullptr;
+
+    if( poSRSTarget->exportToProj4( &pszDstProj4Defn ) != OGRERR_NONE )
+    {
+        CPLFree( pszSrcProj4Defn );
+        CPLFree( pszDstProj4Defn );
+        return FALSE;
+    }
+
+    if( strlen(pszDstProj4Defn) == 0 )
+    {
+        CPLFree( pszSrcProj4Defn );
+        CPLFree( pszDstProj4Defn );
+        CPLError( CE_Failure, CPLE_AppDefined,
+                  "No PROJ.4 translation for destination SRS, coordinate "
+                  "transformation initialization has failed." );
+        return FALSE;
+    }
+
+/* -------------------------------------------------------------------- */
+/*      Optimization to avoid useless nadgrids evaluation.              */
+/*      For example when converting between WGS84 and WebMercator       */
+/* -------------------------------------------------------------------- */
+    if( pszSrcProj4Defn[strlen(pszSrcProj4Defn)-1] == ' ' )
+        pszSrcProj4Defn[strlen(pszSrcProj4Defn)-1] = 0;
+    if( pszDstProj4Defn[strlen(pszDstProj4Defn)-1] == ' ' )
+        pszDstProj4Defn[strlen(pszDstProj4Defn)-1] = 0;
+    char* pszNeedle = strstr(pszSrcProj4Defn, "  ");
+    if( pszNeedle )
+        memmove(pszNeedle, pszNeedle + 1, strlen(pszNeedle + 1)+1);
+    pszNeedle = strstr(pszDstProj4Defn, "  ");
+    if( pszNeedle )
+        memmove(pszNeedle, pszNeedle + 1, strlen(pszNeedle + 1)+1);
+
+    if( (strstr(pszSrcProj4Defn, "+datum=WGS84") != nullptr ||
+         strstr(pszSrcProj4Defn,
+                "+ellps=WGS84 +towgs84=0,0,0,0,0,0,0 ") != nullptr) &&
+        strstr(pszDstProj4Defn, "+nadgrids=@null ") != nullptr &&
+        strstr(pszDstProj4Defn, "+towgs84") == nullptr )
+    {
+        char* pszDst = strstr(pszSrcProj4Defn, "+towgs84=0,0,0,0,0,0,0 ");
+        if( pszDst != nullptr )
+        {
+            char *pszSrc = pszDst + strlen("+towgs84=0,0,0,0,0,0,0 ");
+            memmove(pszDst, pszSrc, strlen(pszSrc)+1);
+        }
+        else
+        {
+            memcpy(strstr(pszSrcProj4Defn, "+datum=WGS84"), "+ellps", 6);
+        }
+
+        pszDst = strstr(pszDstProj4Defn, "+nadgrids=@null ");
+        char *pszSrc = pszDst + strlen("+nadgrids=@null ");
+        memmove(pszDst, pszSrc, strlen(pszSrc)+1);
+
+        pszDst = strstr(pszDstProj4Defn, "+wktext ");
+        if( pszDst )
+        {
+            pszSrc = pszDst + strlen("+wktext ");
+            memmove(pszDst, pszSrc, strlen(pszSrc)+1);
+        }
+    }
+    else
+    if( (strstr(pszDstProj4Defn, "+datum=WGS84") != nullptr ||
+         strstr(pszDstProj4Defn,
+                "+ellps=WGS84 +towgs84=0,0,0,0,0,0,0 ") != nullptr) &&
+        strstr(pszSrcProj4Defn, "+nadgrids=@null ") != nullptr &&
+        strstr(pszSrcProj4Defn, "+towgs84") == nullptr )
+    {
+        char* pszDst = strstr(pszDstProj4Defn, "+towgs84=0,0,0,0,0,0,0 ");
+        if( pszDst != nullptr)
+        {
+            char* pszSrc = pszDst + strlen("+towgs84=0,0,0,0,0,0,0 ");
+            memmove(pszDst, pszSrc, strlen(pszSrc)+1);
+        }
+        else
+        {
+            memcpy(strstr(pszDstProj4Defn, "+datum=WGS84"), "+ellps", 6);
+        }
+
+        pszDst = strstr(pszSrcProj4Defn, "+nadgrids=@null ");
+        char* pszSrc = pszDst + strlen("+nadgrids=@null ");
+        memmove(pszDst, pszSrc, strlen(pszSrc)+1);
+
+        pszDst = strstr(pszSrcProj4Defn, "+wktext ");
+        if( pszDst )
+        {
+            pszSrc = pszDst + strlen("+wktext ");
+            memmove(pszDst, pszSrc, strlen(pszSrc)+1);
+        }
+        bWebMercatorToWGS84 =
+            strcmp(pszDstProj4Defn,
+                   "+proj=longlat +ellps=WGS84 +no_defs") == 0 &&
+            strcmp(pszSrcProj4Defn,
+                   "+proj=merc +a=6378137 +b=6378137 +lat_ts=0.0 +lon_0=0.0 "
+                   "+x_0=0.0 +y_0=0 +k=1.0 +units=m +no_defs") == 0;
+    }
+
+    *ppszSrcProj4Defn = pszSrcProj4Defn;
+    *ppszDstProj4Defn = pszDstProj4Defn;
+
+    return TRUE;
+}
+
 /************************************************************************/
 /*                            GetSourceCS()                             */
 /************************************************************************/
@@ -1128,6 +2131,7 @@ int OGRProj4CT::TransformEx( int nCount, double *x, double *y, double *z,
 /*      Optimized transform from WebMercator to WGS84                   */
 /* -------------------------------------------------------------------- */
     bool bTransformDone = false;
+    int nFastPathErr = 0;
     if( bWebMercatorToWGS84 )
     {
         constexpr double REVERSE_SPHERE_RADIUS = 1.0 / 6378137.0;
@@ -1195,6 +2199,14 @@ int OGRProj4CT::TransformEx( int nCount, double *x, double *y, double *z,
     {
         bTransformDone = true;
     }
+/* -------------------------------------------------------------------- */
+/*      Built-in transformations.                                       */
+/* -------------------------------------------------------------------- */
+    else if( oFastPath.eType != OGRCT_FAST_PATH_NONE )
+    {
+        nFastPathErr = OGRCTApplyFastPath(oFastPath, nCount, x, y, z);
+        bTransformDone = true;
+    }
 
 /* -------------------------------------------------------------------- */
 /*      Do the transformation (or not...) using PROJ.4.                 */
@@ -1211,7 +2223,7 @@ int OGRProj4CT::TransformEx( int nCount, double *x, double *y, double *z,
     int err = 0;
     if( bTransformDone )
     {
-        // err = 0;
+        err = nFastPathErr;
     }
     else if( bCheckWithInvertProj )
     {
@@ -1354,7 +2366,7 @@ int OGRProj4CT::TransformEx( int nCount, double *x, double *y, double *z,
                       err );
         }
 #if PROJ_VERSION == 4
-        if( pjctx == nullptr )
+        if( !bTransformDone && pjctx == nullptr )
             CPLReleaseMutex(hPROJMutex);
 #endif
         return FALSE;
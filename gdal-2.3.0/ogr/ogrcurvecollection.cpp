@@ -160,6 +160,7 @@ OGRErr OGRCurveCollection::addCurveDirectly( OGRGeometry* poGeom,
                                              OGRCurve* poCurve,
                                              int bNeedRealloc )
 {
+    poGeom->invalidateGEOSCache();
     poGeom->HomogenizeDimensionalityWith(poCurve);
 
     if( bNeedRealloc )
@@ -477,6 +478,8 @@ OGRErr OGRCurveCollection::exportToWkb( const OGRGeometry* poGeom,
 
 void OGRCurveCollection::empty( OGRGeometry* poGeom )
 {
+    if( poGeom )
+        poGeom->invalidateGEOSCache();
     if( papoCurves != nullptr )
     {
         for( auto&& poSubGeom: *this )
@@ -110,7 +110,7 @@ OGRGeometry *OGRCurvePolygon::clone() const
         OGRGeometryFactory::createGeometry(getGeometryType())->
             toCurvePolygon();
     poNewPolygon->assignSpatialReference( getSpatialReference() );
-    poNewPolygon->flags = flags;
+    poNewPolygon->flags = flags & ~OGR_G_GEOS_CACHED;
 
     for( int i = 0; i < oCC.nCurveCount; i++ )
     {
@@ -309,6 +309,7 @@ const OGRCurve *OGRCurvePolygon::getInteriorRingCurve( int iRing ) const
 
 OGRCurve *OGRCurvePolygon::stealExteriorRingCurve()
 {
+    invalidateGEOSCache();
     if( oCC.nCurveCount == 0 )
         return nullptr;
     OGRCurve *poRet = oCC.papoCurves[0];
@@ -341,6 +342,7 @@ OGRCurve *OGRCurvePolygon::stealExteriorRingCurve()
 
 OGRErr  OGRCurvePolygon::removeRing(int iIndex, bool bDelete)
 {
+    invalidateGEOSCache();
     return oCC.removeCurve(iIndex, bDelete);
 }
 
@@ -41,10 +41,12 @@
 #include <limits>
 #include <map>
 #include <new>
+#include <utility>
 #include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_multiproc.h"
 #include "cpl_string.h"
 #include "cpl_time.h"
 #include "cpl_vsi.h"
@@ -200,6 +202,208 @@ OGRFeature::~OGRFeature()
     CPLFree(m_pszNativeMediaType);
 }
 
+/************************************************************************/
+/*                               Reset()                                */
+/************************************************************************/
+
+/**
+ * \brief Reset the feature to the state of a newly created feature.
+ *
+ * All fields are unset, geometries are destroyed, and the FID, style string,
+ * style table and native data are cleared. The field and geometry arrays are
+ * kept, which makes it cheaper to fill the same feature object again than to
+ * create a new one. This is what OGRLayer::RecycleFeature() relies on.
+ */
+
+void OGRFeature::Reset()
+
+{
+    const int nFieldCount = poDefn->GetFieldCount();
+    for( int i = 0; pauFields != nullptr && i < nFieldCount; i++ )
+        UnsetField(i);
+
+    const int nGeomFieldCount = poDefn->GetGeomFieldCount();
+    for( int i = 0; papoGeometries != nullptr && i < nGeomFieldCount; i++ )
+    {
+        delete papoGeometries[i];
+        papoGeometries[i] = nullptr;
+    }
+
+    nFID = OGRNullFID;
+    SetStyleString( nullptr );
+    SetStyleTable( nullptr );
+    SetNativeData( nullptr );
+    SetNativeMediaType( nullptr );
+}
+
+/************************************************************************/
+/*                          FreeResetStorage()                          */
+/************************************************************************/
+
+// Free the arrays of a feature that went through Reset(), so that it can be
+// destroyed even if its definition has been modified since then: all its
+// fields are unset, and the destructor must not walk arrays sized for the
+// old definition with the field count of the new one.
+void OGRFeature::FreeResetStorage()
+
+{
+    CPLFree( pauFields );
+    pauFields = nullptr;
+    CPLFree( papoGeometries );
+    papoGeometries = nullptr;
+}
+
+/************************************************************************/
+/*                      Recycled string buffers                         */
+/*                                                                      */
+/*      The buffers of the OFTString fields of a feature given back     */
+/*      with OGRLayer::RecycleFeature() are kept by the layer with the  */
+/*      feature. When the layer returns the feature again, they are     */
+/*      handed to the current thread, so that the SetField() calls      */
+/*      refilling that feature reuse them instead of allocating.        */
+/************************************************************************/
+
+namespace {
+struct OGRRecycledStringBuffers
+{
+    const OGRFeature*   poFeature = nullptr;
+    std::vector<char*>  apszBuffers{};
+    std::vector<size_t> anSizes{};
+
+    void Clear()
+    {
+        for( size_t i = 0; i < apszBuffers.size(); i++ )
+            CPLFree( apszBuffers[i] );
+        apszBuffers.clear();
+        anSizes.clear();
+        poFeature = nullptr;
+    }
+};
+} // namespace
+
+static void OGRFreeRecycledStringBuffers( void* pData )
+{
+    OGRRecycledStringBuffers* psBuffers =
+        static_cast<OGRRecycledStringBuffers*>(pData);
+    psBuffers->Clear();
+    delete psBuffers;
+}
+
+/************************************************************************/
+/*                          TakeStringBuffers()                         */
+/************************************************************************/
+
+// Move the buffers of the set OFTString fields to apszBuffers/anSizes, which
+// must be empty, and unset those fields.
+void OGRFeature::TakeStringBuffers( std::vector<char*>& apszBuffers,
+                                    std::vector<size_t>& anSizes )
+
+{
+    const int nFieldCount = poDefn->GetFieldCount();
+    for( int i = 0; pauFields != nullptr && i < nFieldCount; i++ )
+    {
+        if( !IsFieldSetAndNotNull(i) ||
+            poDefn->GetFieldDefn(i)->GetType() != OFTString ||
+            pauFields[i].String == nullptr )
+        {
+            continue;
+        }
+        if( apszBuffers.empty() )
+        {
+            apszBuffers.resize( nFieldCount, nullptr );
+            anSizes.resize( nFieldCount, 0 );
+        }
+        apszBuffers[i] = pauFields[i].String;
+        anSizes[i] = strlen(pauFields[i].String) + 1;
+        OGR_RawField_SetUnset(&pauFields[i]);
+    }
+}
+
+/************************************************************************/
+/*                          GiveStringBuffers()                         */
+/************************************************************************/
+
+// Hand buffers taken with TakeStringBuffers() to the current thread, for
+// the next CopyStringField() calls on this feature. The buffers left from
+// the previous feature are released, and apszBuffers/anSizes get back
+// empty vectors.
+void OGRFeature::GiveStringBuffers( std::vector<char*>& apszBuffers,
+                                    std::vector<size_t>& anSizes )
+
+{
+    int bMemoryError = FALSE;
+    OGRRecycledStringBuffers* psBuffers =
+        static_cast<OGRRecycledStringBuffers*>(
+            CPLGetTLSEx(CTLS_RECYCLEDSTRINGS, &bMemoryError));
+    if( psBuffers == nullptr && !bMemoryError && !apszBuffers.empty() )
+    {
+        psBuffers = new (std::nothrow) OGRRecycledStringBuffers();
+        if( psBuffers != nullptr )
+        {
+            CPLSetTLSWithFreeFuncEx( CTLS_RECYCLEDSTRINGS, psBuffers,
+                                     OGRFreeRecycledStringBuffers,
+                                     &bMemoryError );
+            if( bMemoryError )
+            {
+                delete psBuffers;
+                psBuffers = nullptr;
+            }
+        }
+    }
+    if( psBuffers == nullptr )
+    {
+        for( size_t i = 0; i < apszBuffers.size(); i++ )
+            CPLFree( apszBuffers[i] );
+        apszBuffers.clear();
+        anSizes.clear();
+        return;
+    }
+
+    psBuffers->Clear();
+    std::swap( psBuffers->apszBuffers, apszBuffers );
+    std::swap( psBuffers->anSizes, anSizes );
+    if( !psBuffers->apszBuffers.empty() )
+        psBuffers->poFeature = this;
+}
+
+/************************************************************************/
+/*                          CopyStringField()                           */
+/************************************************************************/
+
+// Assign a copy of pszValue to OFTString field iField, whose previous value
+// must have been released, reusing a buffer given by GiveStringBuffers() if
+// possible.
+bool OGRFeature::CopyStringField( int iField, const char* pszValue )
+
+{
+    const size_t nSize = strlen(pszValue) + 1;
+
+    int bMemoryError = FALSE;
+    OGRRecycledStringBuffers* psBuffers =
+        static_cast<OGRRecycledStringBuffers*>(
+            CPLGetTLSEx(CTLS_RECYCLEDSTRINGS, &bMemoryError));
+    if( psBuffers != nullptr && psBuffers->poFeature == this &&
+        static_cast<size_t>(iField) < psBuffers->apszBuffers.size() &&
+        psBuffers->apszBuffers[iField] != nullptr &&
+        psBuffers->anSizes[iField] >= nSize )
+    {
+        pauFields[iField].String = psBuffers->apszBuffers[iField];
+        psBuffers->apszBuffers[iField] = nullptr;
+    }
+    else
+    {
+        pauFields[iField].String =
+            static_cast<char *>(VSI_MALLOC_VERBOSE(nSize));
+        if( pauFields[iField].String == nullptr )
+        {
+            OGR_RawField_SetUnset(&pauFields[iField]);
+            return false;
+        }
+    }
+    memcpy( pauFields[iField].String, pszValue, nSize );
+    return true;
+}
+
 /************************************************************************/
 /*                           OGR_F_Destroy()                            */
 /************************************************************************/
@@ -3882,11 +4086,7 @@ void OGRFeature::SetField( int iField, const char * pszValue )
         if( IsFieldSetAndNotNull(iField) )
             CPLFree( pauFields[iField].String );
 
-        pauFields[iField].String = VSI_STRDUP_VERBOSE(pszValue ? pszValue : "");
-        if( pauFields[iField].String == nullptr )
-        {
-            OGR_RawField_SetUnset(&pauFields[iField]);
-        }
+        CopyStringField( iField, pszValue ? pszValue : "" );
     }
     else if( eType == OFTInteger )
     {
@@ -5055,14 +5255,9 @@ bool OGRFeature::SetFieldInternal( int iField, OGRField * puValue )
         else if( OGR_RawField_IsUnset(puValue) ||
                  OGR_RawField_IsNull(puValue) )
             pauFields[iField] = *puValue;
-        else
+        else if( !CopyStringField( iField, puValue->String ) )
         {
-            pauFields[iField].String = VSI_STRDUP_VERBOSE( puValue->String );
-            if( pauFields[iField].String == nullptr )
-            {
-                OGR_RawField_SetUnset(&pauFields[iField]);
-                return false;
-            }
+            return false;
         }
     }
     else if( poFDefn->GetType() == OFTDate
@@ -36,7 +36,9 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <map>
 #include <memory>
+#include <vector>
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
@@ -81,8 +83,593 @@ static void OGRGEOSWarningHandler(const char *fmt, ...)
     CPLErrorV( CE_Warning, CPLE_AppDefined, fmt, args );
     va_end(args);
 }
+/************************************************************************/
+/*                         OGRGEOSThreadContext                         */
+/*                                                                      */
+/*      GEOS context kept per thread, so that predicates do not need    */
+/*      to create and destroy one on each call.                         */
+/************************************************************************/
+
+namespace {
+struct OGRGEOSThreadContext
+{
+    GEOSContextHandle_t hGEOSCtxt = nullptr;
+    bool                bInUse = false;
+};
+} // namespace
+
+static void OGRGEOSFreeThreadContext( void* pData )
+{
+    OGRGEOSThreadContext* psThreadCtxt =
+        static_cast<OGRGEOSThreadContext*>(pData);
+    OGRGeometry::freeGEOSContext( psThreadCtxt->hGEOSCtxt );
+    delete psThreadCtxt;
+}
+
+/************************************************************************/
+/*                     OGRGEOSAcquireThreadContext()                    */
+/*                                                                      */
+/*      Returns the GEOS context of the current thread, or a new        */
+/*      context if it is already in use (re-entrant call from an error  */
+/*      handler for example).  To release with                          */
+/*      OGRGEOSReleaseThreadContext().                                  */
+/************************************************************************/
+
+static GEOSContextHandle_t OGRGEOSAcquireThreadContext()
+{
+    int bMemoryError = FALSE;
+    OGRGEOSThreadContext* psThreadCtxt = static_cast<OGRGEOSThreadContext*>(
+        CPLGetTLSEx( CTLS_GEOSCONTEXT, &bMemoryError ));
+    if( bMemoryError )
+        return OGRGeometry::createGEOSContext();
+    if( psThreadCtxt == nullptr )
+    {
+        psThreadCtxt = new OGRGEOSThreadContext();
+        psThreadCtxt->hGEOSCtxt = OGRGeometry::createGEOSContext();
+        CPLSetTLSWithFreeFuncEx( CTLS_GEOSCONTEXT, psThreadCtxt,
+                                 OGRGEOSFreeThreadContext, &bMemoryError );
+        if( bMemoryError )
+        {
+            OGRGEOSFreeThreadContext( psThreadCtxt );
+            return OGRGeometry::createGEOSContext();
+        }
+    }
+    if( psThreadCtxt->bInUse || psThreadCtxt->hGEOSCtxt == nullptr )
+        return OGRGeometry::createGEOSContext();
+    psThreadCtxt->bInUse = true;
+    return psThreadCtxt->hGEOSCtxt;
+}
+
+/************************************************************************/
+/*                     OGRGEOSReleaseThreadContext()                    */
+/************************************************************************/
+
+static void OGRGEOSReleaseThreadContext( GEOSContextHandle_t hGEOSCtxt )
+{
+    OGRGEOSThreadContext* psThreadCtxt =
+        static_cast<OGRGEOSThreadContext*>(CPLGetTLS( CTLS_GEOSCONTEXT ));
+    if( psThreadCtxt != nullptr && psThreadCtxt->hGEOSCtxt == hGEOSCtxt )
+    {
+        psThreadCtxt->bInUse = false;
+        return;
+    }
+    OGRGeometry::freeGEOSContext( hGEOSCtxt );
+}
 #endif
 
+/************************************************************************/
+/*                         OGRGeometryGEOSCache                         */
+/*                                                                      */
+/*      GEOS and prepared GEOS representations of a geometry, kept      */
+/*      between predicate calls once enableGEOSCache() has been         */
+/*      called on it.  The cache has its own GEOS context, and a mutex  */
+/*      since prepared geometries are not thread-safe.                  */
+/*                                                                      */
+/*      The caches are not stored in the geometries, but in a map that  */
+/*      associates the geometries on which enableGEOSCache() has been   */
+/*      called, and their parts (rings, members, ...), to the caches    */
+/*      to mark dirty when they are modified.  Only such geometries     */
+/*      have the OGR_G_GEOS_CACHED flag, so that the modifiers of the   */
+/*      other ones do not need to look at the map.  A part removes its  */
+/*      entries when it is destroyed, so all the keys of the map are    */
+/*      live geometries.                                                */
+/************************************************************************/
+
+struct OGRGeometryGEOSCache
+{
+#ifdef HAVE_GEOS
+    const OGRGeometry           *poGeom = nullptr;
+    CPLMutex                    *hMutex = nullptr;
+    GEOSContextHandle_t          hGEOSCtxt = nullptr;
+    GEOSGeom                     hGEOSGeom = nullptr;
+    const GEOSPreparedGeometry  *poPreparedGEOSGeom = nullptr;
+    OGREnvelope                  sEnvelope{};
+    bool                         bFilled = false;
+
+    // Protected by hMapMutex.
+    bool                         bDirty = true;
+    std::vector<const OGRGeometry*> apoParts{};
+
+    explicit OGRGeometryGEOSCache( const OGRGeometry* poGeomIn );
+    ~OGRGeometryGEOSCache();
+
+    void Clear();
+    bool Fill();
+
+    static OGRGeometryGEOSCache* Get( const OGRGeometry* poGeom );
+    static void GetEnvelope( const OGRGeometry* poGeom,
+                             OGREnvelope* psEnvelope );
+    static void Enable( const OGRGeometry* poGeom, bool bEnable );
+    static void MarkDirty( const OGRGeometry* poGeom );
+    static void Forget( const OGRGeometry* poGeom );
+
+  private:
+    typedef std::multimap<const OGRGeometry*, OGRGeometryGEOSCache*> Map;
+
+    static CPLMutex *hMapMutex;
+    static Map      *poMap;
+
+    void SetParts();
+    void ReleaseParts();
+    static void CollectParts( const OGRGeometry* poGeom,
+                              std::vector<const OGRGeometry*>& apoParts );
+    static void Register( const OGRGeometry* poGeom,
+                          OGRGeometryGEOSCache* psCache );
+    static bool Unregister( const OGRGeometry* poGeom,
+                            OGRGeometryGEOSCache* psCache );
+    static OGRGeometryGEOSCache* FindLocked( const OGRGeometry* poGeom );
+#endif
+};
+
+#ifdef HAVE_GEOS
+
+CPLMutex *OGRGeometryGEOSCache::hMapMutex = nullptr;
+OGRGeometryGEOSCache::Map *OGRGeometryGEOSCache::poMap = nullptr;
+
+/************************************************************************/
+/*                        OGRGeometryGEOSCache()                        */
+/************************************************************************/
+
+OGRGeometryGEOSCache::OGRGeometryGEOSCache( const OGRGeometry* poGeomIn ) :
+    poGeom(poGeomIn),
+    hGEOSCtxt(OGRGeometry::createGEOSContext())
+{
+}
+
+/************************************************************************/
+/*                       ~OGRGeometryGEOSCache()                        */
+/************************************************************************/
+
+OGRGeometryGEOSCache::~OGRGeometryGEOSCache()
+{
+    Clear();
+    OGRGeometry::freeGEOSContext( hGEOSCtxt );
+    if( hMutex != nullptr )
+        CPLDestroyMutex( hMutex );
+}
+
+/************************************************************************/
+/*                               Clear()                                */
+/************************************************************************/
+
+void OGRGeometryGEOSCache::Clear()
+{
+    if( poPreparedGEOSGeom != nullptr )
+        GEOSPreparedGeom_destroy_r( hGEOSCtxt, poPreparedGEOSGeom );
+    poPreparedGEOSGeom = nullptr;
+    if( hGEOSGeom != nullptr )
+        GEOSGeom_destroy_r( hGEOSCtxt, hGEOSGeom );
+    hGEOSGeom = nullptr;
+    bFilled = false;
+}
+
+/************************************************************************/
+/*                                Fill()                                */
+/*                                                                      */
+/*      Must be called with hMutex held.  Rebuilds the cache if the     */
+/*      geometry has been modified since it was filled.  Returns false  */
+/*      if the geometry cannot be exported to GEOS.                     */
+/************************************************************************/
+
+bool OGRGeometryGEOSCache::Fill()
+{
+    bool bWasDirty = false;
+    {
+        CPLMutexHolderD( &hMapMutex );
+        if( bDirty )
+        {
+            bWasDirty = true;
+            bDirty = false;
+            SetParts();
+        }
+    }
+    if( bWasDirty )
+        Clear();
+
+    if( bFilled )
+        return hGEOSGeom != nullptr;
+
+    bFilled = true;
+    poGeom->getEnvelope( &sEnvelope );
+    hGEOSGeom = poGeom->exportToGEOS( hGEOSCtxt );
+    if( hGEOSGeom == nullptr )
+        return false;
+    // If this fails, predicates are evaluated on the plain GEOS geometry.
+    poPreparedGEOSGeom = GEOSPrepare_r( hGEOSCtxt, hGEOSGeom );
+    return true;
+}
+
+/************************************************************************/
+/*                            CollectParts()                            */
+/************************************************************************/
+
+void OGRGeometryGEOSCache::CollectParts(
+    const OGRGeometry* poGeom, std::vector<const OGRGeometry*>& apoParts )
+{
+    const OGRwkbGeometryType eType = wkbFlatten(poGeom->getGeometryType());
+    if( OGR_GT_IsSubClassOf(eType, wkbCurvePolygon) )
+    {
+        const OGRCurvePolygon* poPoly = poGeom->toCurvePolygon();
+        const OGRCurve* poRing = poPoly->getExteriorRingCurve();
+        if( poRing != nullptr )
+            apoParts.push_back(poRing);
+        for( int i = 0; i < poPoly->getNumInteriorRings(); i++ )
+            apoParts.push_back(poPoly->getInteriorRingCurve(i));
+    }
+    else if( eType == wkbCompoundCurve )
+    {
+        const OGRCompoundCurve* poCC = poGeom->toCompoundCurve();
+        for( int i = 0; i < poCC->getNumCurves(); i++ )
+            apoParts.push_back(poCC->getCurve(i));
+    }
+    else if( OGR_GT_IsSubClassOf(eType, wkbGeometryCollection) )
+    {
+        const OGRGeometryCollection* poGC = poGeom->toGeometryCollection();
+        for( int i = 0; i < poGC->getNumGeometries(); i++ )
+        {
+            apoParts.push_back(poGC->getGeometryRef(i));
+            CollectParts(poGC->getGeometryRef(i), apoParts);
+        }
+    }
+    else if( OGR_GT_IsSubClassOf(eType, wkbPolyhedralSurface) )
+    {
+        const OGRPolyhedralSurface* poPS = poGeom->toPolyhedralSurface();
+        for( int i = 0; i < poPS->getNumGeometries(); i++ )
+        {
+            apoParts.push_back(poPS->getGeometryRef(i));
+            CollectParts(poPS->getGeometryRef(i), apoParts);
+        }
+    }
+}
+
+/************************************************************************/
+/*                              Register()                              */
+/*                                                                      */
+/*      Must be called with hMapMutex held.                             */
+/************************************************************************/
+
+void OGRGeometryGEOSCache::Register( const OGRGeometry* poGeom,
+                                     OGRGeometryGEOSCache* psCache )
+{
+    if( poMap == nullptr )
+        poMap = new Map();
+    poMap->insert(Map::value_type(poGeom, psCache));
+    const_cast<OGRGeometry*>(poGeom)->flags |= OGRGeometry::OGR_G_GEOS_CACHED;
+}
+
+/************************************************************************/
+/*                             Unregister()                             */
+/*                                                                      */
+/*      Must be called with hMapMutex held.  poGeom may have been       */
+/*      destroyed, in which case it has no entry for psCache, and is    */
+/*      not accessed.  Returns whether an entry has been removed.       */
+/************************************************************************/
+
+bool OGRGeometryGEOSCache::Unregister( const OGRGeometry* poGeom,
+                                       OGRGeometryGEOSCache* psCache )
+{
+    if( poMap == nullptr )
+        return false;
+    bool bRemoved = false;
+    auto oRange = poMap->equal_range(poGeom);
+    for( auto oIter = oRange.first; oIter != oRange.second; )
+    {
+        if( oIter->second == psCache )
+        {
+            oIter = poMap->erase(oIter);
+            bRemoved = true;
+        }
+        else
+        {
+            ++oIter;
+        }
+    }
+    if( bRemoved && poMap->find(poGeom) == poMap->end() )
+    {
+        const_cast<OGRGeometry*>(poGeom)->flags &=
+            ~OGRGeometry::OGR_G_GEOS_CACHED;
+    }
+    if( poMap->empty() )
+    {
+        delete poMap;
+        poMap = nullptr;
+    }
+    return bRemoved;
+}
+
+/************************************************************************/
+/*                              SetParts()                              */
+/*                                                                      */
+/*      Must be called with hMapMutex held.  Registers the current      */
+/*      parts of the geometry, so that their modifications mark the     */
+/*      cache dirty.                                                    */
+/************************************************************************/
+
+void OGRGeometryGEOSCache::SetParts()
+{
+    ReleaseParts();
+    CollectParts(poGeom, apoParts);
+    for( const OGRGeometry* poPart : apoParts )
+        Register(poPart, this);
+}
+
+/************************************************************************/
+/*                            ReleaseParts()                            */
+/*                                                                      */
+/*      Must be called with hMapMutex held.                             */
+/************************************************************************/
+
+void OGRGeometryGEOSCache::ReleaseParts()
+{
+    for( const OGRGeometry* poPart : apoParts )
+        Unregister(poPart, this);
+    apoParts.clear();
+}
+
+/************************************************************************/
+/*                             FindLocked()                             */
+/*                                                                      */
+/*      Must be called with hMapMutex held.  Returns the cache enabled  */
+/*      on poGeom itself, if any.                                       */
+/************************************************************************/
+
+OGRGeometryGEOSCache* OGRGeometryGEOSCache::FindLocked(
+    const OGRGeometry* poGeom )
+{
+    if( poMap == nullptr )
+        return nullptr;
+    auto oRange = poMap->equal_range(poGeom);
+    for( auto oIter = oRange.first; oIter != oRange.second; ++oIter )
+    {
+        if( oIter->second->poGeom == poGeom )
+            return oIter->second;
+    }
+    return nullptr;
+}
+
+/************************************************************************/
+/*                                Get()                                 */
+/************************************************************************/
+
+OGRGeometryGEOSCache* OGRGeometryGEOSCache::Get( const OGRGeometry* poGeom )
+{
+    if( !(poGeom->flags & OGRGeometry::OGR_G_GEOS_CACHED) )
+        return nullptr;
+    CPLMutexHolderD( &hMapMutex );
+    return FindLocked(poGeom);
+}
+
+/************************************************************************/
+/*                               Enable()                               */
+/************************************************************************/
+
+void OGRGeometryGEOSCache::Enable( const OGRGeometry* poGeom, bool bEnable )
+{
+    OGRGeometryGEOSCache* psCache = nullptr;
+    {
+        CPLMutexHolderD( &hMapMutex );
+        psCache = FindLocked(poGeom);
+        if( bEnable )
+        {
+            if( psCache == nullptr )
+                Register(poGeom, new OGRGeometryGEOSCache(poGeom));
+            return;
+        }
+        if( psCache == nullptr )
+            return;
+        psCache->ReleaseParts();
+        Unregister(poGeom, psCache);
+    }
+    delete psCache;
+}
+
+/************************************************************************/
+/*                             MarkDirty()                              */
+/************************************************************************/
+
+void OGRGeometryGEOSCache::MarkDirty( const OGRGeometry* poGeom )
+{
+    CPLMutexHolderD( &hMapMutex );
+    if( poMap == nullptr )
+        return;
+    auto oRange = poMap->equal_range(poGeom);
+    for( auto oIter = oRange.first; oIter != oRange.second; ++oIter )
+        oIter->second->bDirty = true;
+}
+
+/************************************************************************/
+/*                               Forget()                               */
+/*                                                                      */
+/*      Called when a geometry with the OGR_G_GEOS_CACHED flag is       */
+/*      destroyed.                                                      */
+/************************************************************************/
+
+void OGRGeometryGEOSCache::Forget( const OGRGeometry* poGeom )
+{
+    OGRGeometryGEOSCache* psOwnCache = nullptr;
+    {
+        CPLMutexHolderD( &hMapMutex );
+        if( poMap == nullptr )
+            return;
+        auto oRange = poMap->equal_range(poGeom);
+        for( auto oIter = oRange.first; oIter != oRange.second; ++oIter )
+        {
+            // A part of a geometry is destroyed when this geometry is
+            // modified or destroyed.
+            if( oIter->second->poGeom == poGeom )
+                psOwnCache = oIter->second;
+            else
+                oIter->second->bDirty = true;
+        }
+        poMap->erase(oRange.first, oRange.second);
+        if( psOwnCache != nullptr )
+            psOwnCache->ReleaseParts();
+        if( poMap != nullptr && poMap->empty() )
+        {
+            delete poMap;
+            poMap = nullptr;
+        }
+    }
+    delete psOwnCache;
+}
+
+/************************************************************************/
+/*                            GetEnvelope()                             */
+/*                                                                      */
+/*      Same as poGeom->getEnvelope(), but uses the cached envelope if  */
+/*      there is one.                                                   */
+/************************************************************************/
+
+void OGRGeometryGEOSCache::GetEnvelope( const OGRGeometry* poGeom,
+                                        OGREnvelope* psEnvelope )
+{
+    OGRGeometryGEOSCache* psCache = Get(poGeom);
+    if( psCache != nullptr )
+    {
+        CPLMutexHolderD( &psCache->hMutex );
+        if( psCache->Fill() )
+        {
+            *psEnvelope = psCache->sEnvelope;
+            return;
+        }
+    }
+    poGeom->getEnvelope( psEnvelope );
+}
+
+/************************************************************************/
+/*                        OGRGEOSCachedPredicate()                      */
+/*                                                                      */
+/*      Evaluates a predicate with the GEOS cache of poSelf, or of      */
+/*      poOtherGeom.  Returns false, without setting bResult, if none   */
+/*      of them has a usable cache.                                     */
+/************************************************************************/
+
+namespace {
+enum OGRGEOSPredicate
+{
+    OGR_GEOS_INTERSECTS,
+    OGR_GEOS_DISJOINT,
+    OGR_GEOS_TOUCHES,
+    OGR_GEOS_CROSSES,
+    OGR_GEOS_WITHIN,
+    OGR_GEOS_CONTAINS,
+    OGR_GEOS_OVERLAPS
+};
+} // namespace
+
+static bool OGRGEOSCachedPredicate( const OGRGeometry* poSelf,
+                                    const OGRGeometry* poOtherGeom,
+                                    OGRGEOSPredicate ePredicate,
+                                    OGRBoolean& bResult )
+{
+    const OGRGeometry* poCachedGeom = poSelf;
+    const OGRGeometry* poProbeGeom = poOtherGeom;
+    OGRGeometryGEOSCache* psCache = OGRGeometryGEOSCache::Get(poSelf);
+    if( psCache == nullptr )
+    {
+        poCachedGeom = poOtherGeom;
+        poProbeGeom = poSelf;
+        psCache = OGRGeometryGEOSCache::Get(poOtherGeom);
+        if( psCache == nullptr )
+            return false;
+    }
+    const bool bSelfCached = poCachedGeom == poSelf;
+
+    CPLMutexHolderD( &psCache->hMutex );
+    if( !psCache->Fill() )
+        return false;
+
+    GEOSContextHandle_t hGEOSCtxt = psCache->hGEOSCtxt;
+    GEOSGeom hProbeGeosGeom = poProbeGeom->exportToGEOS(hGEOSCtxt);
+    if( hProbeGeosGeom == nullptr )
+    {
+        bResult = FALSE;
+        return true;
+    }
+
+    const GEOSPreparedGeometry* poPrepared = psCache->poPreparedGEOSGeom;
+    // Arguments in the order of the original call, for non symmetric
+    // predicates evaluated without the prepared geometry.
+    const GEOSGeometry* hFirst =
+        bSelfCached ? psCache->hGEOSGeom : hProbeGeosGeom;
+    const GEOSGeometry* hSecond =
+        bSelfCached ? hProbeGeosGeom : psCache->hGEOSGeom;
+
+    char nRet = 0;
+    switch( ePredicate )
+    {
+        case OGR_GEOS_INTERSECTS:
+        case OGR_GEOS_DISJOINT:
+        {
+            nRet = poPrepared
+                ? GEOSPreparedIntersects_r(hGEOSCtxt, poPrepared,
+                                           hProbeGeosGeom)
+                : GEOSIntersects_r(hGEOSCtxt, hFirst, hSecond);
+            if( ePredicate == OGR_GEOS_DISJOINT && nRet != 2 )
+                nRet = !nRet;
+            break;
+        }
+
+        case OGR_GEOS_CONTAINS:
+        {
+            // A contains B when the cached geometry is A.
+            nRet = poPrepared && bSelfCached
+                ? GEOSPreparedContains_r(hGEOSCtxt, poPrepared,
+                                         hProbeGeosGeom)
+                : GEOSContains_r(hGEOSCtxt, hFirst, hSecond);
+            break;
+        }
+
+        case OGR_GEOS_WITHIN:
+        {
+            // A within B is B contains A, with the cached geometry as B.
+            nRet = poPrepared && !bSelfCached
+                ? GEOSPreparedContains_r(hGEOSCtxt, poPrepared,
+                                         hProbeGeosGeom)
+                : GEOSWithin_r(hGEOSCtxt, hFirst, hSecond);
+            break;
+        }
+
+        case OGR_GEOS_TOUCHES:
+            nRet = GEOSTouches_r(hGEOSCtxt, hFirst, hSecond);
+            break;
+
+        case OGR_GEOS_CROSSES:
+            nRet = GEOSCrosses_r(hGEOSCtxt, hFirst, hSecond);
+            break;
+
+        case OGR_GEOS_OVERLAPS:
+            nRet = GEOSOverlaps_r(hGEOSCtxt, hFirst, hSecond);
+            break;
+    }
+    GEOSGeom_destroy_r( hGEOSCtxt, hProbeGeosGeom );
+
+    bResult = nRet;
+    return true;
+}
+
+#endif // HAVE_GEOS
+
 /************************************************************************/
 /*                            OGRGeometry()                             */
 /************************************************************************/
@@ -109,7 +696,7 @@ OGRGeometry::OGRGeometry()
 
 OGRGeometry::OGRGeometry( const OGRGeometry& other ) :
     poSRS(other.poSRS),
-    flags(other.flags)
+    flags(other.flags & ~OGR_G_GEOS_CACHED)
 {
     if( poSRS != nullptr )
         poSRS->Reference();
@@ -124,6 +711,10 @@ OGRGeometry::~OGRGeometry()
 {
     if( poSRS != nullptr )
         poSRS->Release();
+#ifdef HAVE_GEOS
+    if( flags & OGR_G_GEOS_CACHED )
+        OGRGeometryGEOSCache::Forget( this );
+#endif
 }
 
 /************************************************************************/
@@ -144,7 +735,9 @@ OGRGeometry& OGRGeometry::operator=( const OGRGeometry& other )
     if( this != &other)
     {
         assignSpatialReference( other.getSpatialReference() );
-        flags = other.flags;
+        invalidateGEOSCache();
+        flags = (other.flags & ~OGR_G_GEOS_CACHED) |
+                (flags & OGR_G_GEOS_CACHED);
     }
     return *this;
 }
@@ -495,10 +1088,14 @@ OGRBoolean OGRGeometry::Intersects( const OGRGeometry *poOtherGeom ) const
         return TRUE;
 
     OGREnvelope oEnv1;
-    getEnvelope( &oEnv1 );
-
     OGREnvelope oEnv2;
+#ifdef HAVE_GEOS
+    OGRGeometryGEOSCache::GetEnvelope( this, &oEnv1 );
+    OGRGeometryGEOSCache::GetEnvelope( poOtherGeom, &oEnv2 );
+#else
+    getEnvelope( &oEnv1 );
     poOtherGeom->getEnvelope( &oEnv2 );
+#endif
 
     if( oEnv1.MaxX < oEnv2.MinX
         || oEnv1.MaxY < oEnv2.MinY
@@ -512,8 +1109,12 @@ OGRBoolean OGRGeometry::Intersects( const OGRGeometry *poOtherGeom ) const
     return TRUE;
 #else
 
+    OGRBoolean bCachedResult = FALSE;
+    if( OGRGEOSCachedPredicate( this, poOtherGeom, OGR_GEOS_INTERSECTS,
+                                bCachedResult ) )
+        return bCachedResult != 0;
 
-    GEOSContextHandle_t hGEOSCtxt = createGEOSContext();
+    GEOSContextHandle_t hGEOSCtxt = OGRGEOSAcquireThreadContext();
     GEOSGeom hThisGeosGeom  = exportToGEOS(hGEOSCtxt);
     GEOSGeom hOtherGeosGeom = poOtherGeom->exportToGEOS(hGEOSCtxt);
 
@@ -526,7 +1127,7 @@ OGRBoolean OGRGeometry::Intersects( const OGRGeometry *poOtherGeom ) const
 
     GEOSGeom_destroy_r( hGEOSCtxt, hThisGeosGeom );
     GEOSGeom_destroy_r( hGEOSCtxt, hOtherGeosGeom );
-    freeGEOSContext( hGEOSCtxt );
+    OGRGEOSReleaseThreadContext( hGEOSCtxt );
 
     return bResult;
 #endif  // HAVE_GEOS
@@ -1007,6 +1608,7 @@ int OGR_G_IsMeasured( OGRGeometryH hGeom )
 void OGRGeometry::setCoordinateDimension( int nNewDimension )
 
 {
+    invalidateGEOSCache();
     if( nNewDimension == 2 )
         flags &= ~OGR_G_3D;
     else
@@ -1030,6 +1632,7 @@ void OGRGeometry::setCoordinateDimension( int nNewDimension )
 void OGRGeometry::set3D( OGRBoolean bIs3D )
 
 {
+    invalidateGEOSCache();
     if( bIs3D )
         flags |= OGR_G_3D;
     else
@@ -1053,6 +1656,7 @@ void OGRGeometry::set3D( OGRBoolean bIs3D )
 void OGRGeometry::setMeasured( OGRBoolean bIsMeasured )
 
 {
+    invalidateGEOSCache();
     if( bIsMeasured )
         flags |= OGR_G_MEASURED;
     else
@@ -2922,6 +3526,70 @@ void OGRGeometry::freeGEOSContext(
 #endif
 }
 
+/************************************************************************/
+/*                          enableGEOSCache()                           */
+/************************************************************************/
+
+/** Enable or disable caching of the GEOS representation of the geometry.
+ *
+ * When enabled, the GEOS geometry, a prepared GEOS geometry and the
+ * envelope of this geometry are computed on the first call to Intersects(),
+ * Disjoint(), Touches(), Crosses(), Within(), Contains() or Overlaps()
+ * involving it, on either side, and reused by later calls, instead of
+ * being computed again at each call.
+ *
+ * The cache is rebuilt on the next call after the geometry, or one of its
+ * parts (rings, members, ...), has been modified.  The cache may be used
+ * from several threads at once, but calls involving it are then
+ * serialized.  Copies and clones of the geometry do not have the cache
+ * enabled.
+ *
+ * This method is the same as the C function OGR_G_EnableGEOSCache().
+ *
+ * @param bEnable true to enable the cache, false to disable it and release
+ * the cached objects.
+ * @since GDAL 2.4
+ */
+void OGRGeometry::enableGEOSCache( UNUSED_IF_NO_GEOS bool bEnable )
+{
+#ifdef HAVE_GEOS
+    OGRGeometryGEOSCache::Enable( this, bEnable );
+#endif
+}
+
+/************************************************************************/
+/*                      invalidateGEOSCacheSlow()                       */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+void OGRGeometry::invalidateGEOSCacheSlow() const
+{
+#ifdef HAVE_GEOS
+    OGRGeometryGEOSCache::MarkDirty( this );
+#endif
+}
+//! @endcond
+
+/************************************************************************/
+/*                       OGR_G_EnableGEOSCache()                        */
+/************************************************************************/
+
+/** Enable or disable caching of the GEOS representation of the geometry.
+ *
+ * This function is the same as the C++ method
+ * OGRGeometry::enableGEOSCache().
+ *
+ * @param hGeom handle on the geometry.
+ * @param bEnable TRUE to enable the cache, FALSE to disable it.
+ * @since GDAL 2.4
+ */
+void OGR_G_EnableGEOSCache( OGRGeometryH hGeom, int bEnable )
+{
+    VALIDATE_POINTER0( hGeom, "OGR_G_EnableGEOSCache" );
+
+    OGRGeometry::FromHandle(hGeom)->enableGEOSCache( CPL_TO_BOOL(bEnable) );
+}
+
 /************************************************************************/
 /*                            exportToGEOS()                            */
 /************************************************************************/
@@ -3472,11 +4140,15 @@ static OGRBoolean OGRGEOSBooleanPredicate(
     const OGRGeometry* poOtherGeom,
     char (*pfnGEOSFunction_r)(GEOSContextHandle_t,
                                        const GEOSGeometry*,
-                                       const GEOSGeometry*) )
+                                       const GEOSGeometry*),
+    OGRGEOSPredicate ePredicate )
 {
     OGRBoolean bResult = FALSE;
 
-    GEOSContextHandle_t hGEOSCtxt = poSelf->createGEOSContext();
+    if( OGRGEOSCachedPredicate( poSelf, poOtherGeom, ePredicate, bResult ) )
+        return bResult;
+
+    GEOSContextHandle_t hGEOSCtxt = OGRGEOSAcquireThreadContext();
     GEOSGeom hThisGeosGeom = poSelf->exportToGEOS(hGEOSCtxt);
     GEOSGeom hOtherGeosGeom = poOtherGeom->exportToGEOS(hGEOSCtxt);
     if( hThisGeosGeom != nullptr && hOtherGeosGeom != nullptr )
@@ -3485,7 +4157,7 @@ static OGRBoolean OGRGEOSBooleanPredicate(
     }
     GEOSGeom_destroy_r( hGEOSCtxt, hThisGeosGeom );
     GEOSGeom_destroy_r( hGEOSCtxt, hOtherGeosGeom );
-    poSelf->freeGEOSContext( hGEOSCtxt );
+    OGRGEOSReleaseThreadContext( hGEOSCtxt );
 
     return bResult;
 }
@@ -4409,7 +5081,8 @@ OGRGeometry::Disjoint( UNUSED_IF_NO_GEOS const OGRGeometry *poOtherGeom ) const
     return FALSE;
 
 #else
-    return OGRGEOSBooleanPredicate(this, poOtherGeom, GEOSDisjoint_r);
+    return OGRGEOSBooleanPredicate(this, poOtherGeom, GEOSDisjoint_r,
+                                   OGR_GEOS_DISJOINT);
 #endif  // HAVE_GEOS
 }
 
@@ -4475,7 +5148,8 @@ OGRGeometry::Touches( UNUSED_IF_NO_GEOS const OGRGeometry *poOtherGeom ) const
     return FALSE;
 
 #else
-    return OGRGEOSBooleanPredicate(this, poOtherGeom, GEOSTouches_r);
+    return OGRGEOSBooleanPredicate(this, poOtherGeom, GEOSTouches_r,
+                                   OGR_GEOS_TOUCHES);
 #endif  // HAVE_GEOS
 }
 
@@ -4571,7 +5245,8 @@ OGRGeometry::Crosses( UNUSED_PARAMETER const OGRGeometry *poOtherGeom ) const
         return FALSE;
 
     #else
-        return OGRGEOSBooleanPredicate(this, poOtherGeom, GEOSCrosses_r);
+        return OGRGEOSBooleanPredicate(this, poOtherGeom, GEOSCrosses_r,
+                                   OGR_GEOS_CROSSES);
     #endif /* HAVE_GEOS */
     }
 }
@@ -4638,7 +5313,8 @@ OGRGeometry::Within( UNUSED_IF_NO_GEOS const OGRGeometry *poOtherGeom ) const
     return FALSE;
 
 #else
-    return OGRGEOSBooleanPredicate(this, poOtherGeom, GEOSWithin_r);
+    return OGRGEOSBooleanPredicate(this, poOtherGeom, GEOSWithin_r,
+                                   OGR_GEOS_WITHIN);
 #endif  // HAVE_GEOS
 }
 
@@ -4704,7 +5380,8 @@ OGRGeometry::Contains( UNUSED_IF_NO_GEOS const OGRGeometry *poOtherGeom ) const
     return FALSE;
 
 #else
-    return OGRGEOSBooleanPredicate(this, poOtherGeom, GEOSContains_r);
+    return OGRGEOSBooleanPredicate(this, poOtherGeom, GEOSContains_r,
+                                   OGR_GEOS_CONTAINS);
 #endif  // HAVE_GEOS
 }
 
@@ -4771,7 +5448,8 @@ OGRGeometry::Overlaps( UNUSED_IF_NO_GEOS const OGRGeometry *poOtherGeom ) const
     return FALSE;
 
 #else
-    return OGRGEOSBooleanPredicate(this, poOtherGeom, GEOSOverlaps_r);
+    return OGRGEOSBooleanPredicate(this, poOtherGeom, GEOSOverlaps_r,
+                                   OGR_GEOS_OVERLAPS);
 #endif  // HAVE_GEOS
 }
 
@@ -5876,6 +6554,7 @@ OGRErr OGRGeometry::importPreambleFromWkb( const unsigned char * pabyData,
                                             OGRwkbByteOrder& eByteOrder,
                                             OGRwkbVariant eWkbVariant )
 {
+    invalidateGEOSCache();
     if( nSize < 9 && nSize != -1 )
         return OGRERR_NOT_ENOUGH_DATA;
 
@@ -5990,7 +6669,7 @@ OGRErr OGRGeometry::importCurveCollectionFromWkt(
     int bHasM = FALSE;
     bool bIsEmpty = false;
     OGRErr eErr = importPreambleFromWkt(ppszInput, &bHasZ, &bHasM, &bIsEmpty);
-    flags = 0;
+    flags &= OGR_G_GEOS_CACHED;
     if( eErr != OGRERR_NONE )
         return eErr;
     if( bHasZ ) flags |= OGR_G_3D;
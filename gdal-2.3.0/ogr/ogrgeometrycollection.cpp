@@ -138,6 +138,7 @@ OGRGeometryCollection& OGRGeometryCollection::operator=(
 void OGRGeometryCollection::empty()
 
 {
+    invalidateGEOSCache();
     if( papoGeoms != nullptr )
     {
         for( auto&& poSubGeom: *this )
@@ -162,7 +163,7 @@ OGRGeometry *OGRGeometryCollection::clone() const
         OGRGeometryFactory::createGeometry(getGeometryType())->
             toGeometryCollection();
     poNewGC->assignSpatialReference( getSpatialReference() );
-    poNewGC->flags = flags;
+    poNewGC->flags = flags & ~OGR_G_GEOS_CACHED;
 
     for( auto&& poSubGeom: *this )
     {
@@ -381,6 +382,7 @@ OGRErr OGRGeometryCollection::addGeometry( const OGRGeometry * poNewGeom )
 OGRErr OGRGeometryCollection::addGeometryDirectly( OGRGeometry * poNewGeom )
 
 {
+    invalidateGEOSCache();
     if( !isCompatibleSubType(poNewGeom->getGeometryType()) )
         return OGRERR_UNSUPPORTED_GEOMETRY_TYPE;
 
@@ -427,6 +429,7 @@ OGRErr OGRGeometryCollection::addGeometryDirectly( OGRGeometry * poNewGeom )
 OGRErr OGRGeometryCollection::removeGeometry( int iGeom, int bDelete )
 
 {
+    invalidateGEOSCache();
     if( iGeom < -1 || iGeom >= nGeomCount )
         return OGRERR_FAILURE;
 
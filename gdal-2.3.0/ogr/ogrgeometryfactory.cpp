@@ -32,6 +32,7 @@
 
 #include "cpl_conv.h"
 #include "cpl_error.h"
+#include "cpl_quad_tree.h"
 #include "cpl_string.h"
 #include "ogr_geometry.h"
 #include "ogr_api.h"
@@ -53,6 +54,7 @@
 #include <cstddef>
 
 #include <algorithm>
+#include <functional>
 #include <limits>
 #include <new>
 #include <utility>
@@ -1346,6 +1348,25 @@ static int OGRGeometryFactoryCompareByIndex(const void* p1, const void* p2)
 
 constexpr int N_CRITICAL_PART_NUMBER = 100;
 
+// Above that number of parts, candidate enclosing polygons are looked up
+// in a quad tree of envelopes rather than by scanning all larger polygons.
+constexpr int N_MIN_PART_NUMBER_FOR_INDEX = 16;
+
+static bool OGRGeometryFactoryEnvelopeIsValid( const OGREnvelope& sEnvelope )
+{
+    return !CPLIsNan(sEnvelope.MinX) && !CPLIsNan(sEnvelope.MinY) &&
+           !CPLIsNan(sEnvelope.MaxX) && !CPLIsNan(sEnvelope.MaxY);
+}
+
+static void OGRGeometryFactoryEnvelopeToRect( const OGREnvelope& sEnvelope,
+                                              CPLRectObj* psRect )
+{
+    psRect->minx = sEnvelope.MinX;
+    psRect->miny = sEnvelope.MinY;
+    psRect->maxx = sEnvelope.MaxX;
+    psRect->maxy = sEnvelope.MaxY;
+}
+
 typedef enum
 {
    METHOD_NORMAL,
@@ -1690,7 +1711,10 @@ OGRGeometry* OGRGeometryFactory::organizePolygons( OGRGeometry **papoPolygons,
           outer ring
        5) Add the top-level polygons to the multipolygon
 
-       Complexity : O(nPolygonCount^2)
+       Complexity : O(nPolygonCount^2) in the worst case. When there are
+       many parts, the candidates of step 2 are fetched from a quad tree of
+       the envelopes of the already processed polygons, and visited in the
+       same order as the exhaustive scan, so that the result is unchanged.
     */
 
     /* Compute how each polygon relate to the other ones
@@ -1728,11 +1752,50 @@ OGRGeometry* OGRGeometryFactory::organizePolygons( OGRGeometry **papoPolygons,
 
     int nCountTopLevel = 1;
 
+    // Only polygons whose envelope intersects the one of the polygon being
+    // tested can be involved in a containment or overlap test, so they are
+    // the only candidates we need to visit.
+    CPLQuadTree* hIndex = nullptr;
+    std::vector<int> anCandidates;
+    if( !bMixedUpGeometries && nPolygonCount >= N_MIN_PART_NUMBER_FOR_INDEX )
+    {
+        OGREnvelope sGlobalEnvelope;
+        for( int i = 0; i < nPolygonCount; i++ )
+        {
+            if( OGRGeometryFactoryEnvelopeIsValid(asPolyEx[i].sEnvelope) )
+                sGlobalEnvelope.Merge(asPolyEx[i].sEnvelope);
+        }
+        if( sGlobalEnvelope.IsInit() )
+        {
+            CPLRectObj sGlobalBounds;
+            OGRGeometryFactoryEnvelopeToRect(sGlobalEnvelope, &sGlobalBounds);
+            hIndex = CPLQuadTreeCreate(&sGlobalBounds, nullptr);
+            CPLQuadTreeSetMaxDepth(
+                hIndex, CPLQuadTreeGetAdvisedMaxDepth(nPolygonCount));
+        }
+    }
+
     // STEP 2.
-    for( int i = 1;
+    for( int i = 0;
          !bMixedUpGeometries && bValidTopology && i<nPolygonCount;
          i++ )
     {
+        // Make the polygons of rank [i-1 ... 0] available as candidates.
+        if( hIndex != nullptr && i > 0 &&
+            OGRGeometryFactoryEnvelopeIsValid(asPolyEx[i-1].sEnvelope) &&
+            !(method == METHOD_ONLY_CCW && !asPolyEx[i-1].bIsCW) )
+        {
+            CPLRectObj sRect;
+            OGRGeometryFactoryEnvelopeToRect(asPolyEx[i-1].sEnvelope, &sRect);
+            CPLQuadTreeInsertWithBounds(
+                hIndex,
+                reinterpret_cast<void*>(static_cast<GUIntptr_t>(i-1)),
+                &sRect);
+        }
+
+        if( i == 0 )
+            continue;
+
         if( method == METHOD_ONLY_CCW && asPolyEx[i].bIsCW )
         {
             nCountTopLevel++;
@@ -1741,9 +1804,37 @@ OGRGeometry* OGRGeometryFactory::organizePolygons( OGRGeometry **papoPolygons,
             continue;
         }
 
-        int j = i - 1;  // Used after for.
-        for( ; bValidTopology && j >= 0; j-- )
+        int nCandidates = i;
+        if( hIndex != nullptr )
+        {
+            anCandidates.clear();
+            if( OGRGeometryFactoryEnvelopeIsValid(asPolyEx[i].sEnvelope) )
+            {
+                CPLRectObj sRect;
+                OGRGeometryFactoryEnvelopeToRect(asPolyEx[i].sEnvelope,
+                                                 &sRect);
+                int nFeatureCount = 0;
+                void** pahFeatures =
+                    CPLQuadTreeSearch(hIndex, &sRect, &nFeatureCount);
+                for( int k = 0; k < nFeatureCount; k++ )
+                {
+                    anCandidates.push_back(static_cast<int>(
+                        reinterpret_cast<GUIntptr_t>(pahFeatures[k])));
+                }
+                CPLFree(pahFeatures);
+            }
+            // Visit candidates from the smallest to the largest one, as
+            // the exhaustive scan does.
+            std::sort(anCandidates.begin(), anCandidates.end(),
+                      std::greater<int>());
+            nCandidates = static_cast<int>(anCandidates.size());
+        }
+
+        int iCandidate = 0;  // Used after for.
+        for( ; bValidTopology && iCandidate < nCandidates; iCandidate++ )
         {
+            const int j = hIndex != nullptr ? anCandidates[iCandidate]
+                                            : i - 1 - iCandidate;
             bool b_i_inside_j = false;
 
             if( method == METHOD_ONLY_CCW && asPolyEx[j].bIsCW == false )
@@ -1907,7 +1998,7 @@ OGRGeometry* OGRGeometryFactory::organizePolygons( OGRGeometry **papoPolygons,
             }
         }
 
-        if( j < 0 )
+        if( iCandidate == nCandidates )
         {
             // We come here because we are not included in anything.
             // We are toplevel.
@@ -1917,6 +2008,9 @@ OGRGeometry* OGRGeometryFactory::organizePolygons( OGRGeometry **papoPolygons,
         }
     }
 
+    if( hIndex != nullptr )
+        CPLQuadTreeDestroy(hIndex);
+
     if( pbIsValidGeometry )
         *pbIsValidGeometry = bValidTopology && !bMixedUpGeometries;
 
@@ -39,6 +39,10 @@
 #include "ogr_geometry.h"
 #include "ogr_p.h"
 
+#if defined(__x86_64) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
 CPL_CVSID("$Id: ogrlinearring.cpp 99132fd3803311ecc233f6d375b94f8c7a016aef 2018-03-28 01:33:40 +0200 Even Rouault $")
 
 /************************************************************************/
@@ -188,6 +192,7 @@ OGRErr OGRLinearRing::_importFromWkb( OGRwkbByteOrder eByteOrder, int _flags,
                                       int& nBytesConsumedOut )
 
 {
+    invalidateGEOSCache();
     nBytesConsumedOut = -1;
     if( nBytesAvailable < 4 && nBytesAvailable != -1 )
         return OGRERR_NOT_ENOUGH_DATA;
@@ -278,22 +283,15 @@ OGRErr OGRLinearRing::_importFromWkb( OGRwkbByteOrder eByteOrder, int _flags,
 /* -------------------------------------------------------------------- */
 /*      Byte swap if needed.                                            */
 /* -------------------------------------------------------------------- */
-    if( OGR_SWAP( eByteOrder ) )
+    if( OGR_SWAP( eByteOrder ) && nPointCount > 0 )
     {
-        for( int i = 0; i < nPointCount; i++ )
-        {
-            CPL_SWAPDOUBLE( &(paoPoints[i].x) );
-            CPL_SWAPDOUBLE( &(paoPoints[i].y) );
+        OGRSwapDoubleArray( paoPoints, 2 * static_cast<size_t>(nPointCount) );
 
-            if( flags & OGR_G_3D )
-            {
-                CPL_SWAPDOUBLE( padfZ + i );
-            }
-            if( flags & OGR_G_MEASURED )
-            {
-                CPL_SWAPDOUBLE( padfM + i );
-            }
-        }
+        if( flags & OGR_G_3D )
+            OGRSwapDoubleArray( padfZ, nPointCount );
+
+        if( flags & OGR_G_MEASURED )
+            OGRSwapDoubleArray( padfM, nPointCount );
     }
 
     return OGRERR_NONE;
@@ -377,10 +375,7 @@ OGRErr OGRLinearRing::_exportToWkb( OGRwkbByteOrder eByteOrder, int _flags,
         int nCount = CPL_SWAP32( nPointCount );
         memcpy( pabyData, &nCount, 4 );
 
-        for( int i = 0; i < nWords; i++ )
-        {
-            CPL_SWAPDOUBLE( pabyData + 4 + 8 * i );
-        }
+        OGRSwapDoubleArray( pabyData + 4, nWords );
     }
 
     return OGRERR_NONE;
@@ -418,7 +413,7 @@ OGRGeometry *OGRLinearRing::clone() const
     poNewLinearRing->assignSpatialReference( getSpatialReference() );
 
     poNewLinearRing->setPoints( nPointCount, paoPoints, padfZ, padfM );
-    poNewLinearRing->flags = flags;
+    poNewLinearRing->flags = flags & ~OGR_G_GEOS_CACHED;
 
     return poNewLinearRing;
 }
@@ -630,11 +625,60 @@ OGRBoolean OGRLinearRing::isPointInRing(const OGRPoint* poPoint,
     // For every point p in ring,
     // test if ray starting from given point crosses segment (p - 1, p)
     int iNumCrossings = 0;
+    int iPoint = 1;
 
-    double prev_diff_x = getX(0) - dfTestX;
-    double prev_diff_y = getY(0) - dfTestY;
+#if defined(__x86_64) || defined(_M_X64)
+    // Process two segments per iteration. The arithmetic is the same as the
+    // scalar loop below, operation by operation, so that the crossing count
+    // is bit-identical. Lanes that do not straddle the ray may divide by
+    // zero, but their result is masked out.
+    {
+        const __m128d xmm_testX = _mm_set1_pd(dfTestX);
+        const __m128d xmm_testY = _mm_set1_pd(dfTestY);
+        const __m128d xmm_zero = _mm_setzero_pd();
+        for( ; iPoint + 1 < iNumPoints; iPoint += 2 )
+        {
+            const __m128d xmm_p0 =
+                _mm_loadu_pd(reinterpret_cast<const double*>(
+                                                &paoPoints[iPoint - 1]));
+            const __m128d xmm_p1 =
+                _mm_loadu_pd(reinterpret_cast<const double*>(
+                                                &paoPoints[iPoint]));
+            const __m128d xmm_p2 =
+                _mm_loadu_pd(reinterpret_cast<const double*>(
+                                                &paoPoints[iPoint + 1]));
+            const __m128d x2 =
+                _mm_sub_pd(_mm_unpacklo_pd(xmm_p0, xmm_p1), xmm_testX);
+            const __m128d y2 =
+                _mm_sub_pd(_mm_unpackhi_pd(xmm_p0, xmm_p1), xmm_testY);
+            const __m128d x1 =
+                _mm_sub_pd(_mm_unpacklo_pd(xmm_p1, xmm_p2), xmm_testX);
+            const __m128d y1 =
+                _mm_sub_pd(_mm_unpackhi_pd(xmm_p1, xmm_p2), xmm_testY);
+
+            const __m128d xmm_straddle = _mm_or_pd(
+                _mm_and_pd(_mm_cmpgt_pd(y1, xmm_zero),
+                           _mm_cmple_pd(y2, xmm_zero)),
+                _mm_and_pd(_mm_cmpgt_pd(y2, xmm_zero),
+                           _mm_cmple_pd(y1, xmm_zero)));
+            const int nStraddleMask = _mm_movemask_pd(xmm_straddle);
+            if( nStraddleMask == 0 )
+                continue;
+
+            const __m128d xmm_intersection = _mm_div_pd(
+                _mm_sub_pd(_mm_mul_pd(x1, y2), _mm_mul_pd(x2, y1)),
+                _mm_sub_pd(y2, y1));
+            const int nMask = nStraddleMask & _mm_movemask_pd(
+                _mm_cmplt_pd(xmm_zero, xmm_intersection));
+            iNumCrossings += (nMask & 1) + (nMask >> 1);
+        }
+    }
+#endif
 
-    for( int iPoint = 1; iPoint < iNumPoints; iPoint++ )
+    double prev_diff_x = getX(iPoint - 1) - dfTestX;
+    double prev_diff_y = getY(iPoint - 1) - dfTestY;
+
+    for( ; iPoint < iNumPoints; iPoint++ )
     {
         const double x1 = getX(iPoint) - dfTestX;
         const double y1 = getY(iPoint) - dfTestY;
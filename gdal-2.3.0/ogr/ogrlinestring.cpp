@@ -35,6 +35,10 @@
 #include <algorithm>
 #include <limits>
 
+#if defined(__x86_64) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
 CPL_CVSID("$Id: ogrlinestring.cpp 971ad299681ca1ea2e1b800e88209f426b77e9aa 2018-04-17 12:14:43 +0200 Even Rouault $")
 
 namespace {
@@ -150,7 +154,7 @@ OGRGeometry *OGRSimpleCurve::clone() const
         delete poCurve;
         return nullptr;
     }
-    poCurve->flags = flags;
+    poCurve->flags = flags & ~OGR_G_GEOS_CACHED;
 
     return poCurve;
 }
@@ -219,6 +223,7 @@ int OGRSimpleCurve::WkbSize() const
 void OGRSimpleCurve::Make2D()
 
 {
+    invalidateGEOSCache();
     if( padfZ != nullptr )
     {
         CPLFree( padfZ );
@@ -234,6 +239,7 @@ void OGRSimpleCurve::Make2D()
 void OGRSimpleCurve::Make3D()
 
 {
+    invalidateGEOSCache();
     if( padfZ == nullptr )
     {
         if( nPointCount == 0 )
@@ -260,6 +266,7 @@ void OGRSimpleCurve::Make3D()
 void OGRSimpleCurve::RemoveM()
 
 {
+    invalidateGEOSCache();
     if( padfM != nullptr )
     {
         CPLFree( padfM );
@@ -275,6 +282,7 @@ void OGRSimpleCurve::RemoveM()
 void OGRSimpleCurve::AddM()
 
 {
+    invalidateGEOSCache();
     if( padfM == nullptr )
     {
         if( nPointCount == 0 )
@@ -434,6 +442,7 @@ double OGRSimpleCurve::getM( int iVertex ) const
 void OGRSimpleCurve::setNumPoints( int nNewPointCount, int bZeroizeNewContent )
 
 {
+    invalidateGEOSCache();
     CPLAssert( nNewPointCount >= 0 );
 
     if( nNewPointCount == 0 )
@@ -558,6 +567,7 @@ void OGRSimpleCurve::setPoint( int iPoint, OGRPoint * poPoint )
 void OGRSimpleCurve::setPoint( int iPoint, double xIn, double yIn, double zIn )
 
 {
+    invalidateGEOSCache();
     if( !(flags & OGR_G_3D) )
         Make3D();
 
@@ -599,6 +609,7 @@ void OGRSimpleCurve::setPoint( int iPoint, double xIn, double yIn, double zIn )
 void OGRSimpleCurve::setPointM( int iPoint, double xIn, double yIn, double mIn )
 
 {
+    invalidateGEOSCache();
     if( !(flags & OGR_G_MEASURED) )
         AddM();
 
@@ -642,6 +653,7 @@ void OGRSimpleCurve::setPoint( int iPoint, double xIn, double yIn,
                                double zIn, double mIn )
 
 {
+    invalidateGEOSCache();
     if( !(flags & OGR_G_3D) )
         Make3D();
     if( !(flags & OGR_G_MEASURED) )
@@ -688,6 +700,7 @@ void OGRSimpleCurve::setPoint( int iPoint, double xIn, double yIn,
 void OGRSimpleCurve::setPoint( int iPoint, double xIn, double yIn )
 
 {
+    invalidateGEOSCache();
     if( iPoint >= nPointCount )
     {
         setNumPoints( iPoint+1 );
@@ -718,6 +731,7 @@ void OGRSimpleCurve::setPoint( int iPoint, double xIn, double yIn )
 
 void OGRSimpleCurve::setZ( int iPoint, double zIn )
 {
+    invalidateGEOSCache();
     if( getCoordinateDimension() == 2 )
         Make3D();
 
@@ -751,6 +765,7 @@ void OGRSimpleCurve::setZ( int iPoint, double zIn )
 
 void OGRSimpleCurve::setM( int iPoint, double mIn )
 {
+    invalidateGEOSCache();
     if( !(flags & OGR_G_MEASURED) )
         AddM();
 
@@ -896,6 +911,7 @@ void OGRSimpleCurve::setPointsM( int nPointsIn,
                                  const double * padfMIn )
 
 {
+    invalidateGEOSCache();
     setNumPoints( nPointsIn, FALSE );
     if( nPointCount < nPointsIn
 #ifdef DEBUG
@@ -947,6 +963,7 @@ void OGRSimpleCurve::setPoints( int nPointsIn,
                                 const double * padfMIn )
 
 {
+    invalidateGEOSCache();
     setNumPoints( nPointsIn, FALSE );
     if( nPointCount < nPointsIn
 #ifdef DEBUG
@@ -1010,6 +1027,7 @@ void OGRSimpleCurve::setPoints( int nPointsIn,
                                 const double * padfZIn )
 
 {
+    invalidateGEOSCache();
     setNumPoints( nPointsIn, FALSE );
     if( nPointCount < nPointsIn
 #ifdef DEBUG
@@ -1061,6 +1079,7 @@ void OGRSimpleCurve::setPoints( int nPointsIn,
                                 const double * padfZIn )
 
 {
+    invalidateGEOSCache();
 /* -------------------------------------------------------------------- */
 /*      Check 2D/3D.                                                    */
 /* -------------------------------------------------------------------- */
@@ -1076,7 +1095,19 @@ void OGRSimpleCurve::setPoints( int nPointsIn,
     if( nPointCount < nPointsIn )
         return;
 
-    for( int i = 0; i < nPointsIn; i++ )
+    int i = 0;
+#if defined(__x86_64) || defined(_M_X64)
+    // Interleave two X and two Y values into two (x,y) pairs at once.
+    double* padfXY = reinterpret_cast<double*>(paoPoints);
+    for( ; i + 1 < nPointsIn; i += 2 )
+    {
+        const __m128d x = _mm_loadu_pd(padfX + i);
+        const __m128d y = _mm_loadu_pd(padfY + i);
+        _mm_storeu_pd(padfXY + 2 * i, _mm_unpacklo_pd(x, y));
+        _mm_storeu_pd(padfXY + 2 * i + 2, _mm_unpackhi_pd(x, y));
+    }
+#endif
+    for( ; i < nPointsIn; i++ )
     {
         paoPoints[i].x = padfX[i];
         paoPoints[i].y = padfY[i];
@@ -1114,6 +1145,7 @@ void OGRSimpleCurve::setPointsM( int nPointsIn,
                                  const double * padfMIn )
 
 {
+    invalidateGEOSCache();
 /* -------------------------------------------------------------------- */
 /*      Check 2D/3D.                                                    */
 /* -------------------------------------------------------------------- */
@@ -1169,6 +1201,7 @@ void OGRSimpleCurve::setPoints( int nPointsIn,
                                 const double * padfMIn )
 
 {
+    invalidateGEOSCache();
 /* -------------------------------------------------------------------- */
 /*      Check 2D/3D.                                                    */
 /* -------------------------------------------------------------------- */
@@ -1378,6 +1411,7 @@ void OGRSimpleCurve::getPoints( void* pabyX, int nXStride,
 void OGRSimpleCurve::reversePoints()
 
 {
+    invalidateGEOSCache();
     for( int i = 0; i < nPointCount/2; i++ )
     {
         const OGRRawPoint sPointTemp = paoPoints[i];
@@ -1584,29 +1618,15 @@ OGRErr OGRSimpleCurve::importFromWkb( const unsigned char *pabyData,
 /* -------------------------------------------------------------------- */
 /*      Byte swap if needed.                                            */
 /* -------------------------------------------------------------------- */
-    if( OGR_SWAP( eByteOrder ) )
+    if( OGR_SWAP( eByteOrder ) && nPointCount > 0 )
     {
-        for( i = 0; i < nPointCount; i++ )
-        {
-            CPL_SWAPDOUBLE( &(paoPoints[i].x) );
-            CPL_SWAPDOUBLE( &(paoPoints[i].y) );
-        }
+        OGRSwapDoubleArray( paoPoints, 2 * static_cast<size_t>(nPointCount) );
 
         if( flags & OGR_G_3D )
-        {
-            for( i = 0; i < nPointCount; i++ )
-            {
-                CPL_SWAPDOUBLE( padfZ + i );
-            }
-        }
+            OGRSwapDoubleArray( padfZ, nPointCount );
 
         if( flags & OGR_G_MEASURED )
-        {
-            for( i = 0; i < nPointCount; i++ )
-            {
-                CPL_SWAPDOUBLE( padfM + i );
-            }
-        }
+            OGRSwapDoubleArray( padfM, nPointCount );
     }
 
     return OGRERR_NONE;
@@ -1700,10 +1720,8 @@ OGRErr OGRSimpleCurve::exportToWkb( OGRwkbByteOrder eByteOrder,
         int nCount = CPL_SWAP32( nPointCount );
         memcpy( pabyData+5, &nCount, 4 );
 
-        for( int i = CoordinateDimension() * nPointCount - 1; i >= 0; i-- )
-        {
-            CPL_SWAP64PTR( pabyData + 9 + 8 * i );
-        }
+        OGRSwapDoubleArray( pabyData + 9, static_cast<size_t>(
+                                CoordinateDimension()) * nPointCount );
     }
 
     return OGRERR_NONE;
@@ -1724,7 +1742,7 @@ OGRErr OGRSimpleCurve::importFromWkt( const char ** ppszInput )
     bool bIsEmpty = false;
     const OGRErr eErr =
         importPreambleFromWkt(ppszInput, &bHasZ, &bHasM, &bIsEmpty);
-    flags = 0;
+    flags &= OGR_G_GEOS_CACHED;
     if( eErr != OGRERR_NONE )
         return eErr;
     if( bHasZ ) flags |= OGR_G_3D;
@@ -1937,8 +1955,29 @@ double OGRSimpleCurve::get_Length() const
 
 {
     double dfLength = 0.0;
+    int i = 0;
 
-    for( int i = 0; i < nPointCount-1; i++ )
+#if defined(__x86_64) || defined(_M_X64)
+    // Compute the lengths of two segments at once, but sum them in the
+    // same order as the scalar loop, so that the result is unchanged.
+    const double* padfXY = reinterpret_cast<const double*>(paoPoints);
+    for( ; i + 2 < nPointCount; i += 2 )
+    {
+        const __m128d p0 = _mm_loadu_pd(padfXY + 2 * i);
+        const __m128d p1 = _mm_loadu_pd(padfXY + 2 * i + 2);
+        const __m128d p2 = _mm_loadu_pd(padfXY + 2 * i + 4);
+        const __m128d d0 = _mm_sub_pd(p1, p0);
+        const __m128d d1 = _mm_sub_pd(p2, p1);
+        const __m128d sq0 = _mm_mul_pd(d0, d0);
+        const __m128d sq1 = _mm_mul_pd(d1, d1);
+        const __m128d len = _mm_sqrt_pd(_mm_add_pd(_mm_unpacklo_pd(sq0, sq1),
+                                                   _mm_unpackhi_pd(sq0, sq1)));
+        dfLength += _mm_cvtsd_f64(len);
+        dfLength += _mm_cvtsd_f64(_mm_unpackhi_pd(len, len));
+    }
+#endif
+
+    for( ; i < nPointCount-1; i++ )
     {
 
         const double dfDeltaX = paoPoints[i+1].x - paoPoints[i].x;
@@ -2292,8 +2331,32 @@ void OGRSimpleCurve::getEnvelope( OGREnvelope * psEnvelope ) const
     double dfMaxX = paoPoints[0].x;
     double dfMinY = paoPoints[0].y;
     double dfMaxY = paoPoints[0].y;
+    int iPoint = 1;
+
+#if defined(__x86_64) || defined(_M_X64)
+    // Process (x,y) pairs as a whole. _mm_min_pd(a, b) is a < b ? a : b,
+    // which is what the scalar loop computes, including with NaN. Points
+    // are visited in order with a single accumulator, so that when 0 and
+    // -0 are both present, the first one is kept, as in the scalar loop.
+    if( nPointCount >= 3 )
+    {
+        const double* padfXY = reinterpret_cast<const double*>(paoPoints);
+        __m128d minXY = _mm_loadu_pd(padfXY);
+        __m128d maxXY = minXY;
+        for( ; iPoint < nPointCount; iPoint++ )
+        {
+            const __m128d p = _mm_loadu_pd(padfXY + 2 * iPoint);
+            minXY = _mm_min_pd(p, minXY);
+            maxXY = _mm_max_pd(p, maxXY);
+        }
+        dfMinX = _mm_cvtsd_f64(minXY);
+        dfMinY = _mm_cvtsd_f64(_mm_unpackhi_pd(minXY, minXY));
+        dfMaxX = _mm_cvtsd_f64(maxXY);
+        dfMaxY = _mm_cvtsd_f64(_mm_unpackhi_pd(maxXY, maxXY));
+    }
+#endif
 
-    for( int iPoint = 1; iPoint < nPointCount; iPoint++ )
+    for( ; iPoint < nPointCount; iPoint++ )
     {
         if( dfMaxX < paoPoints[iPoint].x )
             dfMaxX = paoPoints[iPoint].x;
@@ -2382,6 +2445,7 @@ OGRBoolean OGRSimpleCurve::Equals( const OGRGeometry * poOther ) const
 OGRErr OGRSimpleCurve::transform( OGRCoordinateTransformation *poCT )
 
 {
+    invalidateGEOSCache();
 /* -------------------------------------------------------------------- */
 /*   Make a copy of the points to operate on, so as to be able to       */
 /*   keep only valid reprojected points if partial reprojection enabled */
@@ -2399,15 +2463,27 @@ OGRErr OGRSimpleCurve::transform( OGRCoordinateTransformation *poCT )
         return OGRERR_NOT_ENOUGH_MEMORY;
     }
 
-    for( int i = 0; i < nPointCount; i++ )
+    int iPoint = 0;
+#if defined(__x86_64) || defined(_M_X64)
+    // Split two (x,y) pairs into two X and two Y values at once.
+    const double* padfXY = reinterpret_cast<const double*>(paoPoints);
+    for( ; iPoint + 1 < nPointCount; iPoint += 2 )
     {
-        xyz[i] = paoPoints[i].x;
-        xyz[i+nPointCount] = paoPoints[i].y;
-        if( padfZ )
-            xyz[i+nPointCount*2] = padfZ[i];
-        else
-            xyz[i+nPointCount*2] = 0.0;
+        const __m128d p0 = _mm_loadu_pd(padfXY + 2 * iPoint);
+        const __m128d p1 = _mm_loadu_pd(padfXY + 2 * iPoint + 2);
+        _mm_storeu_pd(xyz + iPoint, _mm_unpacklo_pd(p0, p1));
+        _mm_storeu_pd(xyz + nPointCount + iPoint, _mm_unpackhi_pd(p0, p1));
     }
+#endif
+    for( ; iPoint < nPointCount; iPoint++ )
+    {
+        xyz[iPoint] = paoPoints[iPoint].x;
+        xyz[iPoint+nPointCount] = paoPoints[iPoint].y;
+    }
+    if( padfZ )
+        memcpy( xyz + nPointCount * 2, padfZ, sizeof(double) * nPointCount );
+    else
+        memset( xyz + nPointCount * 2, 0, sizeof(double) * nPointCount );
 
 /* -------------------------------------------------------------------- */
 /*      Transform and reapply.                                          */
@@ -2502,6 +2578,7 @@ OGRBoolean OGRSimpleCurve::IsEmpty() const
 
 void OGRSimpleCurve::segmentize( double dfMaxLength )
 {
+    invalidateGEOSCache();
     if( dfMaxLength <= 0 )
     {
         CPLError(CE_Failure, CPLE_AppDefined,
@@ -2618,6 +2695,7 @@ void OGRSimpleCurve::segmentize( double dfMaxLength )
 
 void OGRSimpleCurve::swapXY()
 {
+    invalidateGEOSCache();
     for( int i = 0; i < nPointCount; i++ )
     {
         std::swap(paoPoints[i].x, paoPoints[i].y);
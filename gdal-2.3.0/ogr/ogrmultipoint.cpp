@@ -259,7 +259,7 @@ OGRErr OGRMultiPoint::importFromWkt( const char ** ppszInput )
     int bHasM = FALSE;
     bool bIsEmpty = false;
     OGRErr eErr = importPreambleFromWkt(ppszInput, &bHasZ, &bHasM, &bIsEmpty);
-    flags = 0;
+    flags &= OGR_G_GEOS_CACHED;
     if( eErr != OGRERR_NONE )
         return eErr;
     if( bHasZ ) flags |= OGR_G_3D;
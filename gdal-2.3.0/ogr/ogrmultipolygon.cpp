@@ -206,6 +206,7 @@ OGRErr OGRMultiPolygon::_addGeometryDirectlyWithExpectedSubGeometryType(
                                       OGRGeometry * poNewGeom,
                                       OGRwkbGeometryType eSubGeometryType )
 {
+    invalidateGEOSCache();
     if ( wkbFlatten(poNewGeom->getGeometryType()) != eSubGeometryType)
         return OGRERR_UNSUPPORTED_GEOMETRY_TYPE;
 
@@ -186,7 +186,7 @@ OGRGeometry *OGRPoint::clone() const
         return nullptr;
 
     poNewPoint->assignSpatialReference( getSpatialReference() );
-    poNewPoint->flags = flags;
+    poNewPoint->flags = flags & ~OGR_G_GEOS_CACHED;
 
     return poNewPoint;
 }
@@ -197,6 +197,7 @@ OGRGeometry *OGRPoint::clone() const
 void OGRPoint::empty()
 
 {
+    invalidateGEOSCache();
     x = 0.0;
     y = 0.0;
     z = 0.0;
@@ -248,6 +249,7 @@ const char * OGRPoint::getGeometryName() const
 void OGRPoint::flattenTo2D()
 
 {
+    invalidateGEOSCache();
     z = 0.0;
     m = 0.0;
     flags &= ~OGR_G_3D;
@@ -261,6 +263,7 @@ void OGRPoint::flattenTo2D()
 void OGRPoint::setCoordinateDimension( int nNewDimension )
 
 {
+    invalidateGEOSCache();
     if( nNewDimension == 2 )
         flattenTo2D();
     else if( nNewDimension == 3 )
@@ -303,7 +306,7 @@ OGRErr OGRPoint::importFromWkb( const unsigned char *pabyData,
     nBytesConsumedOut = -1;
     OGRwkbByteOrder eByteOrder = wkbNDR;
 
-    flags = 0;
+    flags &= OGR_G_GEOS_CACHED;
     OGRErr eErr =
         importPreambleFromWkb( pabyData, nSize, eByteOrder, eWkbVariant );
     pabyData += 5;
@@ -489,7 +492,7 @@ OGRErr OGRPoint::importFromWkt( const char ** ppszInput )
     int bHasM = FALSE;
     bool bIsEmpty = false;
     OGRErr eErr = importPreambleFromWkt(ppszInput, &bHasZ, &bHasM, &bIsEmpty);
-    flags = 0;
+    flags &= OGR_G_GEOS_CACHED;
     if( eErr != OGRERR_NONE )
         return eErr;
     if( bHasZ ) flags |= OGR_G_3D;
@@ -743,6 +746,7 @@ OGRBoolean OGRPoint::Equals( const OGRGeometry * poOther ) const
 OGRErr OGRPoint::transform( OGRCoordinateTransformation *poCT )
 
 {
+    invalidateGEOSCache();
     if( poCT->Transform( 1, &x, &y, &z ) )
     {
         assignSpatialReference( poCT->GetTargetCS() );
@@ -758,6 +762,7 @@ OGRErr OGRPoint::transform( OGRCoordinateTransformation *poCT )
 
 void OGRPoint::swapXY()
 {
+    invalidateGEOSCache();
     std::swap(x, y);
 }
 
@@ -191,6 +191,7 @@ const OGRLinearRing *OGRPolygon::getExteriorRing() const
 
 OGRLinearRing *OGRPolygon::stealExteriorRing()
 {
+    invalidateGEOSCache();
     return stealExteriorRingCurve()->toLinearRing();
 }
 
@@ -264,6 +265,7 @@ const OGRLinearRing *OGRPolygon::getInteriorRing( int iRing ) const
 
 OGRLinearRing *OGRPolygon::stealInteriorRing( int iRing )
 {
+    invalidateGEOSCache();
     if( iRing < 0 || iRing >= oCC.nCurveCount-1 )
         return nullptr;
     OGRLinearRing *poRet = oCC.papoCurves[iRing+1]->toLinearRing();
@@ -451,7 +453,7 @@ OGRErr OGRPolygon::importFromWkt( const char ** ppszInput )
     int bHasM = FALSE;
     bool bIsEmpty = false;
     OGRErr eErr = importPreambleFromWkt(ppszInput, &bHasZ, &bHasM, &bIsEmpty);
-    flags = 0;
+    flags &= OGR_G_GEOS_CACHED;
     if( eErr != OGRERR_NONE )
         return eErr;
     if( bHasZ ) flags |= OGR_G_3D;
@@ -154,6 +154,7 @@ int OGRPolyhedralSurface::getDimension() const
 
 void OGRPolyhedralSurface::empty()
 {
+    invalidateGEOSCache();
     if( oMP.papoGeoms != nullptr )
     {
         for( auto&& poSubGeom: *this )
@@ -177,7 +178,7 @@ OGRGeometry* OGRPolyhedralSurface::clone() const
             toPolyhedralSurface();
 
     poNewPS->assignSpatialReference(getSpatialReference());
-    poNewPS->flags = flags;
+    poNewPS->flags = flags & ~OGR_G_GEOS_CACHED;
 
     for( auto&& poSubGeom: *this )
     {
@@ -363,7 +364,7 @@ OGRErr OGRPolyhedralSurface::importFromWkt( const char ** ppszInput )
     bool bIsEmpty = false;
     OGRErr      eErr = importPreambleFromWkt(
                                         ppszInput, &bHasZ, &bHasM, &bIsEmpty);
-    flags = 0;
+    flags &= OGR_G_GEOS_CACHED;
     if( eErr != OGRERR_NONE )
         return eErr;
     if( bHasZ ) flags |= OGR_G_3D;
@@ -881,6 +882,7 @@ OGRErr OGRPolyhedralSurface::addGeometry (const OGRGeometry *poNewGeom)
 
 OGRErr OGRPolyhedralSurface::addGeometryDirectly (OGRGeometry *poNewGeom)
 {
+    invalidateGEOSCache();
     if (!isCompatibleSubType(poNewGeom->getGeometryType()))
     {
         return OGRERR_UNSUPPORTED_GEOMETRY_TYPE;
@@ -1072,6 +1074,7 @@ OGRBoolean OGRPolyhedralSurface::hasCurveGeometry(int) const
 
 OGRErr OGRPolyhedralSurface::removeGeometry(int iGeom, int bDelete)
 {
+    invalidateGEOSCache();
     return oMP.removeGeometry(iGeom,bDelete);
 }
 
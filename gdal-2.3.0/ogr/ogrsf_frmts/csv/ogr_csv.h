@@ -139,6 +139,13 @@ class OGRCSVLayer : public OGRLayer
 
     StringQuoting       m_eStringQuoting = StringQuoting::IF_AMBIGUOUS;
 
+    // Work buffer and token array reused from one record to the next by
+    // GetNextLineTokens().
+    char               *m_pszLineBuffer = nullptr;
+    size_t              m_nLineBufferSize = 0;
+    char              **m_papszLineTokens = nullptr;
+    size_t              m_nLineTokensSize = 0;
+
     char              **GetNextLineTokens();
 
     static bool         Matches( const char *pszFieldName,
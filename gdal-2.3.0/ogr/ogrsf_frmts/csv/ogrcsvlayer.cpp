@@ -225,6 +225,217 @@ char **OGRCSVReadParseLineL( VSILFILE *fp, char chDelimiter,
     return papszReturn;
 }
 
+/************************************************************************/
+/*                          OGRCSVGrowBuffer()                          */
+/*                                                                      */
+/*      Make sure that *ppBuffer, of *pnSize elements of nEltSize       */
+/*      bytes, can hold nNeeded elements. Returns false, with the       */
+/*      buffer unchanged, if the allocation fails.                      */
+/************************************************************************/
+
+static bool OGRCSVGrowBuffer( void** ppBuffer, size_t* pnSize,
+                              size_t nNeeded, size_t nEltSize )
+{
+    if( nNeeded <= *pnSize )
+        return true;
+    size_t nNewSize = std::max(nNeeded, *pnSize + *pnSize / 2);
+    void* pNewBuffer = VSI_REALLOC_VERBOSE(*ppBuffer, nNewSize * nEltSize);
+    if( pNewBuffer == nullptr )
+        return false;
+    *ppBuffer = pNewBuffer;
+    *pnSize = nNewSize;
+    return true;
+}
+
+/************************************************************************/
+/*                           OGRCSVAddToken()                           */
+/************************************************************************/
+
+static bool OGRCSVAddToken( char**& papszTokens, size_t& nTokensSize,
+                            size_t& nTokens, char* pszToken )
+{
+    void* pTokens = papszTokens;
+    if( !OGRCSVGrowBuffer(&pTokens, &nTokensSize, nTokens + 1,
+                          sizeof(char*)) )
+        return false;
+    papszTokens = static_cast<char **>(pTokens);
+    papszTokens[nTokens++] = pszToken;
+    return true;
+}
+
+/************************************************************************/
+/*                     OGRCSVReadParseLineInPlaceL()                    */
+/*                                                                      */
+/*      Same as OGRCSVReadParseLineL() (without the                     */
+/*      bKeepLeadingAndClosingQuotes option), except that the record    */
+/*      is split in place in pszBuffer and that the returned token      */
+/*      array is papszTokens. Both buffers keep their size from one     */
+/*      call to the next, so reading records does not allocate once     */
+/*      they have grown to the longest record. Returns nullptr at end   */
+/*      of file or if a buffer cannot be grown.                         */
+/************************************************************************/
+
+static char **OGRCSVReadParseLineInPlaceL( VSILFILE *fp, char chDelimiter,
+                                           bool bDontHonourStrings,
+                                           bool bMergeDelimiter,
+                                           char*& pszBuffer,
+                                           size_t& nBufferSize,
+                                           char**& papszTokens,
+                                           size_t& nTokensSize )
+{
+    const char *pszLine = CPLReadLineL(fp);
+    if( pszLine == nullptr )
+        return nullptr;
+
+    // Skip BOM.
+    const GByte *pabyData = reinterpret_cast<const GByte *>(pszLine);
+    if( pabyData[0] == 0xEF && pabyData[1] == 0xBB && pabyData[2] == 0xBF )
+        pszLine += 3;
+
+    // As with OGRCSVReadParseLineL(), anything after a nul character in a
+    // line is ignored.
+    size_t nRecordLen = strlen(pszLine);
+    void* pBuffer = pszBuffer;
+    if( !OGRCSVGrowBuffer(&pBuffer, &nBufferSize, nRecordLen + 1, 1) )
+        return nullptr;
+    pszBuffer = static_cast<char *>(pBuffer);
+    memcpy(pszBuffer, pszLine, nRecordLen + 1);
+
+    size_t nTokens = 0;
+
+    // The NdfcFacilities.xls special case (un-balanced double quotes) and
+    // records without quotes are split on the delimiter only. memchr() is
+    // vectorized by the C library, and is much faster than a character
+    // by character loop on long records.
+    const bool bNdfcSpecialCase = chDelimiter == '\t' && bDontHonourStrings;
+    if( bNdfcSpecialCase ||
+        memchr(pszBuffer, '"', nRecordLen) == nullptr )
+    {
+        char *pszIter = pszBuffer;
+        char * const pszEnd = pszIter + nRecordLen;
+        const bool bMerge = bMergeDelimiter && !bNdfcSpecialCase;
+        while( pszIter != pszEnd )
+        {
+            if( !OGRCSVAddToken(papszTokens, nTokensSize, nTokens,
+                                pszIter) )
+                return nullptr;
+            char *pszDelim = static_cast<char *>(
+                memchr(pszIter, chDelimiter, pszEnd - pszIter));
+            if( pszDelim == nullptr )
+                break;
+            *pszDelim = '\0';
+            pszIter = pszDelim + 1;
+            if( bMerge )
+            {
+                while( pszIter != pszEnd && *pszIter == chDelimiter )
+                    pszIter++;
+            }
+            // Trailing delimiter: add an empty last token.
+            if( pszIter == pszEnd &&
+                !OGRCSVAddToken(papszTokens, nTokensSize, nTokens, pszEnd) )
+                return nullptr;
+        }
+        if( !OGRCSVAddToken(papszTokens, nTokensSize, nTokens, nullptr) )
+            return nullptr;
+        return papszTokens;
+    }
+
+    // We must now count the quotes in our working string, and as
+    // long as it is odd, keep adding new lines.
+    size_t i = 0;
+    int nCount = 0;
+    while( true )
+    {
+        for( ; i < nRecordLen; i++ )
+        {
+            if( pszBuffer[i] == '\"' )
+                nCount++;
+        }
+
+        if( nCount % 2 == 0 )
+            break;
+
+        pszLine = CPLReadLineL(fp);
+        if( pszLine == nullptr )
+            break;
+
+        const size_t nLineLen = strlen(pszLine);
+        pBuffer = pszBuffer;
+        if( !OGRCSVGrowBuffer(&pBuffer, &nBufferSize,
+                              nRecordLen + 1 + nLineLen + 1, 1) )
+            break;
+        pszBuffer = static_cast<char *>(pBuffer);
+
+        // The '\n' gets lost in CPLReadLine().
+        pszBuffer[nRecordLen] = '\n';
+        memcpy(pszBuffer + nRecordLen + 1, pszLine, nLineLen + 1);
+        nRecordLen += 1 + nLineLen;
+    }
+
+    // Same tokenization as CSVSplitLine(), except that the unquoted
+    // tokens are written back over the record, which is safe as they can
+    // only be shorter than their source.
+    char *pszRead = pszBuffer;
+    char *pszWrite = pszRead;
+    while( *pszRead != '\0' )
+    {
+        bool bInString = false;
+        char *pszToken = pszWrite;
+        char chLastRead = '\0';
+
+        // Try to find the next delimiter, marking end of token.
+        for( ; *pszRead != '\0'; pszRead++ )
+        {
+            // End if this is a delimiter skip it and break.
+            if( !bInString && *pszRead == chDelimiter )
+            {
+                chLastRead = chDelimiter;
+                pszRead++;
+                if( bMergeDelimiter )
+                {
+                    while( *pszRead == chDelimiter )
+                        pszRead++;
+                }
+                break;
+            }
+
+            if( *pszRead == '"' )
+            {
+                if( !bInString || pszRead[1] != '"' )
+                {
+                    bInString = !bInString;
+                    chLastRead = '"';
+                    continue;
+                }
+                else  // Doubled quotes in string resolve to one quote.
+                {
+                    pszRead++;
+                }
+            }
+
+            chLastRead = *pszRead;
+            *pszWrite++ = *pszRead;
+        }
+
+        *pszWrite++ = '\0';
+        if( !OGRCSVAddToken(papszTokens, nTokensSize, nTokens, pszToken) )
+            return nullptr;
+
+        // If the last token is an empty token, then we have to catch
+        // it now, otherwise we won't reenter the loop and it will be lost.
+        if( *pszRead == '\0' && chLastRead == chDelimiter )
+        {
+            if( !OGRCSVAddToken(papszTokens, nTokensSize, nTokens, pszRead) )
+                return nullptr;
+            break;
+        }
+    }
+
+    if( !OGRCSVAddToken(papszTokens, nTokensSize, nTokens, nullptr) )
+        return nullptr;
+    return papszTokens;
+}
+
 /************************************************************************/
 /*                            OGRCSVLayer()                             */
 /*                                                                      */
@@ -1366,6 +1577,8 @@ OGRCSVLayer::~OGRCSVLayer()
         WriteHeader();
 
     CPLFree(panGeomFieldIndex);
+    CPLFree(m_pszLineBuffer);
+    CPLFree(m_papszLineTokens);
 
     poFeatureDefn->Release();
     CPLFree(pszFilename);
@@ -1395,6 +1608,9 @@ void OGRCSVLayer::ResetReading()
 
 /************************************************************************/
 /*                        GetNextLineTokens()                           */
+/*                                                                      */
+/*      The returned token list is owned by the layer, and is only      */
+/*      valid until the next call.                                      */
 /************************************************************************/
 
 char **OGRCSVLayer::GetNextLineTokens()
@@ -1402,16 +1618,16 @@ char **OGRCSVLayer::GetNextLineTokens()
     while( true )
     {
         // Read the CSV record.
-        char **papszTokens = OGRCSVReadParseLineL(
-            fpCSV, chDelimiter, bDontHonourStrings, false, bMergeDelimiter);
+        char **papszTokens = OGRCSVReadParseLineInPlaceL(
+            fpCSV, chDelimiter, bDontHonourStrings, bMergeDelimiter,
+            m_pszLineBuffer, m_nLineBufferSize,
+            m_papszLineTokens, m_nLineTokensSize);
 
         if( papszTokens == nullptr )
             return nullptr;
 
         if( papszTokens[0] != nullptr )
             return papszTokens;
-
-        CSLDestroy(papszTokens);
     }
 }
 
@@ -1427,15 +1643,90 @@ OGRFeature *OGRCSVLayer::GetFeature(GIntBig nFID)
         ResetReading();
     while( nNextFID < nFID )
     {
-        char **papszTokens = GetNextLineTokens();
-        if( papszTokens == nullptr )
+        if( GetNextLineTokens() == nullptr )
             return nullptr;
-        CSLDestroy(papszTokens);
         nNextFID++;
     }
     return GetNextUnfilteredFeature();
 }
 
+/************************************************************************/
+/*                         OGRCSVParseNumber()                          */
+/************************************************************************/
+
+// Parse a token that is a plain decimal number: an optional sign, digits with
+// at most one decimal point, and an optional exponent, without spaces. Tokens
+// with more than 18 digits for an integer, or that overflow for a real, are
+// not handled. Those are a subset of the tokens for which CPLGetValueType()
+// returns CPL_VALUE_INTEGER or CPL_VALUE_REAL, and give the same value as
+// OGRFeature::SetField(int, const char*). CPL_VALUE_STRING is returned for
+// all other tokens, which must go through the generic path.
+static CPLValueType OGRCSVParseNumber( const char* pszToken,
+                                       GIntBig& nValue, double& dfValue )
+{
+    const char* pszIter = pszToken;
+    const bool bNegative = *pszIter == '-';
+    if( *pszIter == '-' || *pszIter == '+' )
+        ++pszIter;
+
+    GIntBig nAbsValue = 0;
+    int nDigits = 0;
+    while( *pszIter >= '0' && *pszIter <= '9' )
+    {
+        nAbsValue = nAbsValue * 10 + (*pszIter - '0');
+        ++pszIter;
+        if( ++nDigits > 18 )
+            return CPL_VALUE_STRING;
+    }
+
+    if( *pszIter == '\0' )
+    {
+        if( nDigits == 0 )
+            return CPL_VALUE_STRING;
+        nValue = bNegative ? -nAbsValue : nAbsValue;
+        // Converting the absolute value keeps the sign of "-0", as
+        // CPLAtof() does for Real fields. The conversion of integers of
+        // up to 18 digits rounds to nearest, like CPLStrtod().
+        dfValue = static_cast<double>(nAbsValue);
+        if( bNegative )
+            dfValue = -dfValue;
+        return CPL_VALUE_INTEGER;
+    }
+
+    // Check the syntax of the fractional part and exponent before handing
+    // the token to CPLStrtod(), which also accepts hexadecimal numbers,
+    // infinities, etc.
+    if( *pszIter == '.' )
+    {
+        ++pszIter;
+        while( *pszIter >= '0' && *pszIter <= '9' )
+        {
+            ++pszIter;
+            ++nDigits;
+        }
+    }
+    if( nDigits == 0 )
+        return CPL_VALUE_STRING;
+    if( *pszIter == 'e' || *pszIter == 'E' )
+    {
+        ++pszIter;
+        if( *pszIter == '-' || *pszIter == '+' )
+            ++pszIter;
+        if( !(*pszIter >= '0' && *pszIter <= '9') )
+            return CPL_VALUE_STRING;
+        while( *pszIter >= '0' && *pszIter <= '9' )
+            ++pszIter;
+    }
+    if( *pszIter != '\0' )
+        return CPL_VALUE_STRING;
+
+    char* pszEnd = nullptr;
+    dfValue = CPLStrtod(pszToken, &pszEnd);
+    if( *pszEnd != '\0' || CPLIsInf(dfValue) )
+        return CPL_VALUE_STRING;
+    return CPL_VALUE_REAL;
+}
+
 /************************************************************************/
 /*                      GetNextUnfilteredFeature()                      */
 /************************************************************************/
@@ -1452,7 +1743,7 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
         return nullptr;
 
     // Create the OGR feature.
-    OGRFeature *poFeature = new OGRFeature(poFeatureDefn);
+    OGRFeature *poFeature = AcquireFeature(poFeatureDefn);
 
     // Set attributes for any indicated attribute records.
     int iOGRField = 0;
@@ -1556,10 +1847,34 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
                     if( chComma )
                         *chComma = '.';
                 }
-                eType = CPLGetValueType(papszTokens[iAttr]);
+                // Plain numbers are converted once and stored with the
+                // typed setters. Others (spaces, Fortran exponents, out of
+                // range values...) keep the generic string conversion.
+                GIntBig nValue = 0;
+                double dfValue = 0.0;
+                eType = OGRCSVParseNumber(papszTokens[iAttr], nValue, dfValue);
+                if( eType == CPL_VALUE_INTEGER && eFieldType == OFTInteger &&
+                    nValue >= INT_MIN && nValue <= INT_MAX )
+                {
+                    poFeature->SetField(iOGRField, static_cast<int>(nValue));
+                }
+                else if( eType == CPL_VALUE_INTEGER &&
+                         eFieldType == OFTInteger64 )
+                {
+                    poFeature->SetField(iOGRField, nValue);
+                }
+                else if( eType != CPL_VALUE_STRING && eFieldType == OFTReal )
+                {
+                    poFeature->SetField(iOGRField, dfValue);
+                }
+                else
+                {
+                    eType = CPLGetValueType(papszTokens[iAttr]);
+                    if( eType == CPL_VALUE_INTEGER || eType == CPL_VALUE_REAL )
+                        poFeature->SetField(iOGRField, papszTokens[iAttr]);
+                }
                 if( eType == CPL_VALUE_INTEGER || eType == CPL_VALUE_REAL )
                 {
-                    poFeature->SetField(iOGRField, papszTokens[iAttr]);
                     if( !bWarningBadTypeOrWidth &&
                         (eFieldType == OFTInteger ||
                          eFieldType == OFTInteger64) &&
@@ -1763,8 +2078,6 @@ OGRFeature *OGRCSVLayer::GetNextUnfilteredFeature()
         }
     }
 
-    CSLDestroy(papszTokens);
-
     // Translate the record id.
     poFeature->SetFID(nNextFID++);
 
@@ -1796,7 +2109,7 @@ OGRFeature *OGRCSVLayer::GetNextFeature()
             (m_poAttrQuery == nullptr || m_poAttrQuery->Evaluate(poFeature)) )
             return poFeature;
 
-        delete poFeature;
+        RecycleFeature(poFeature);
     }
 }
 
@@ -2553,15 +2866,9 @@ GIntBig OGRCSVLayer::GetFeatureCount( int bForce )
     else
     {
         nTotalFeatures = 0;
-        while( true )
+        while( GetNextLineTokens() != nullptr )
         {
-            char **papszTokens = GetNextLineTokens();
-            if( papszTokens == nullptr )
-                break;
-
             nTotalFeatures++;
-
-            CSLDestroy(papszTokens);
         }
     }
 
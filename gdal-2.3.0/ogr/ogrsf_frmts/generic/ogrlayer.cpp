@@ -34,13 +34,54 @@
 #include "swq.h"
 #include "ograpispy.h"
 
+#include <utility>
+
 CPL_CVSID("$Id: ogrlayer.cpp e5a287aeb4a9c8665a45b9877e555e16ed93843d 2018-04-18 19:06:22 +0200 Even Rouault $")
 
+// Maximum number of features kept by OGRLayer::RecycleFeature().
+constexpr size_t MAX_RECYCLED_FEATURES = 8;
+
 struct OGRLayer::Private
 {
     bool         m_bInFeatureIterator = false;
+
+    // Features given back with RecycleFeature(), already reset, with the
+    // field counts of their definition at that time and the buffers of
+    // their string fields.
+    struct RecycledFeature
+    {
+        OGRFeature*         poFeature = nullptr;
+        int                 nFieldCount = 0;
+        int                 nGeomFieldCount = 0;
+        std::vector<char*>  apszStrings{};
+        std::vector<size_t> anStringSizes{};
+    };
+    std::vector<RecycledFeature> m_asRecycledFeatures{};
+    // Emptied buffer vectors, kept for their capacity.
+    std::vector<char*>  m_apszSpareStrings{};
+    std::vector<size_t> m_anSpareStringSizes{};
+
+    // Layer to which RecycleFeature() forwards the features, for layers
+    // that return the features of another one, and mutex to take then.
+    OGRLayer*    m_poRecycleTarget = nullptr;
+    CPLMutex*    m_hRecycleMutex = nullptr;
+
+    static void FreeRecycledFeature( RecycledFeature& sRecycled );
 };
 
+/************************************************************************/
+/*                        FreeRecycledFeature()                         */
+/************************************************************************/
+
+void OGRLayer::Private::FreeRecycledFeature( RecycledFeature& sRecycled )
+{
+    for( size_t i = 0; i < sRecycled.apszStrings.size(); i++ )
+        CPLFree( sRecycled.apszStrings[i] );
+    sRecycled.poFeature->FreeResetStorage();
+    delete sRecycled.poFeature;
+    sRecycled.poFeature = nullptr;
+}
+
 /************************************************************************/
 /*                              OGRLayer()                              */
 /************************************************************************/
@@ -97,6 +138,9 @@ OGRLayer::~OGRLayer()
         OGRDestroyPreparedGeometry(m_pPreparedFilterGeom);
         m_pPreparedFilterGeom = nullptr;
     }
+
+    for( auto& sRecycled : m_poPrivate->m_asRecycledFeatures )
+        Private::FreeRecycledFeature( sRecycled );
 }
 
 /************************************************************************/
@@ -533,6 +577,151 @@ OGRErr OGR_L_SetNextByIndex( OGRLayerH hLayer, GIntBig nIndex )
     return OGRLayer::FromHandle(hLayer)->SetNextByIndex( nIndex );
 }
 
+/************************************************************************/
+/*                           RecycleFeature()                           */
+/************************************************************************/
+
+/**
+ \brief Give back a feature returned by GetNextFeature() for reuse.
+
+ This is equivalent to deleting the feature, except that the layer may keep
+ the feature object, with its field array and string buffers, to return it
+ again from a later GetNextFeature() call, once refilled. Drivers that
+ support this (Shapefile, CSV and GeoPackage for instance) then avoid most
+ of the per-feature heap allocations when reading.
+
+ The feature must not be used by the caller after this call. Features that
+ were not produced by this layer are simply destroyed.
+
+ This method is the same as the C function OGR_L_RecycleFeature().
+
+ @param poFeature the feature to give back, or NULL.
+*/
+
+void OGRLayer::RecycleFeature( OGRFeature* poFeature )
+
+{
+    if( poFeature == nullptr )
+        return;
+
+    if( m_poPrivate->m_poRecycleTarget != nullptr )
+    {
+        CPLMutexHolderOptionalLockD(m_poPrivate->m_hRecycleMutex);
+        m_poPrivate->m_poRecycleTarget->RecycleFeature(poFeature);
+        return;
+    }
+
+    OGRFeatureDefn* poDefn = poFeature->GetDefnRef();
+    if( m_poPrivate->m_asRecycledFeatures.size() >= MAX_RECYCLED_FEATURES ||
+        poDefn != GetLayerDefn() )
+    {
+        delete poFeature;
+        return;
+    }
+
+    Private::RecycledFeature sRecycled;
+    sRecycled.poFeature = poFeature;
+    sRecycled.nFieldCount = poDefn->GetFieldCount();
+    sRecycled.nGeomFieldCount = poDefn->GetGeomFieldCount();
+    std::swap( sRecycled.apszStrings, m_poPrivate->m_apszSpareStrings );
+    std::swap( sRecycled.anStringSizes, m_poPrivate->m_anSpareStringSizes );
+    poFeature->TakeStringBuffers( sRecycled.apszStrings,
+                                  sRecycled.anStringSizes );
+    poFeature->Reset();
+    m_poPrivate->m_asRecycledFeatures.push_back( std::move(sRecycled) );
+}
+
+/************************************************************************/
+/*                        OGR_L_RecycleFeature()                        */
+/************************************************************************/
+
+/**
+ \brief Give back a feature returned by OGR_L_GetNextFeature() for reuse.
+
+ This is equivalent to OGR_F_Destroy(), except that the layer may reuse the
+ feature object for a later OGR_L_GetNextFeature() call.
+
+ This function is the same as the C++ method OGRLayer::RecycleFeature().
+
+ @param hLayer handle to the layer that returned the feature.
+ @param hFeat handle to the feature to give back, or NULL.
+*/
+
+void OGR_L_RecycleFeature( OGRLayerH hLayer, OGRFeatureH hFeat )
+
+{
+    VALIDATE_POINTER0( hLayer, "OGR_L_RecycleFeature" );
+
+    OGRLayer::FromHandle(hLayer)->RecycleFeature(
+                                        OGRFeature::FromHandle(hFeat) );
+}
+
+/************************************************************************/
+/*                           AcquireFeature()                           */
+/************************************************************************/
+
+//! @cond Doxygen_Suppress
+/**
+ * \brief Return a new empty feature, reusing one given back with
+ * RecycleFeature() when possible.
+ *
+ * Drivers can call this instead of new OGRFeature(poDefn) in their
+ * GetNextFeature() implementation, and RecycleFeature() instead of deleting
+ * the features they filter out.
+ *
+ * @param poDefn the definition of the feature, normally the layer one.
+ * @return a feature owned by the caller.
+ */
+
+OGRFeature* OGRLayer::AcquireFeature( OGRFeatureDefn* poDefn )
+
+{
+    auto& asRecycled = m_poPrivate->m_asRecycledFeatures;
+    while( !asRecycled.empty() )
+    {
+        Private::RecycledFeature sRecycled( std::move(asRecycled.back()) );
+        asRecycled.pop_back();
+        // Skip features whose definition was modified in the meantime.
+        if( sRecycled.poFeature->GetDefnRef() == poDefn &&
+            sRecycled.nFieldCount == poDefn->GetFieldCount() &&
+            sRecycled.nGeomFieldCount == poDefn->GetGeomFieldCount() )
+        {
+            OGRFeature* poFeature = sRecycled.poFeature;
+            poFeature->GiveStringBuffers( sRecycled.apszStrings,
+                                          sRecycled.anStringSizes );
+            m_poPrivate->m_apszSpareStrings.swap( sRecycled.apszStrings );
+            m_poPrivate->m_anSpareStringSizes.swap( sRecycled.anStringSizes );
+            return poFeature;
+        }
+        Private::FreeRecycledFeature( sRecycled );
+    }
+    return new OGRFeature(poDefn);
+}
+
+/************************************************************************/
+/*                       SetRecycleFeatureTarget()                      */
+/************************************************************************/
+
+/**
+ * \brief Make RecycleFeature() forward the features to another layer.
+ *
+ * Layers whose GetNextFeature() returns the features of another layer, such
+ * as OGRLayerDecorator, call this so that those features are given back to
+ * the layer that produced them.
+ *
+ * @param poLayer the layer to forward to, or NULL to keep the features in
+ * this layer.
+ * @param hMutex mutex to take while forwarding, or NULL.
+ */
+
+void OGRLayer::SetRecycleFeatureTarget( OGRLayer* poLayer, CPLMutex* hMutex )
+
+{
+    m_poPrivate->m_poRecycleTarget = poLayer;
+    m_poPrivate->m_hRecycleMutex = hMutex;
+}
+//! @endcond
+
 /************************************************************************/
 /*                        OGR_L_GetNextFeature()                        */
 /************************************************************************/
@@ -39,6 +39,7 @@ OGRLayerDecorator::OGRLayerDecorator( OGRLayer* poDecoratedLayer,
 {
     CPLAssert(poDecoratedLayer != nullptr);
     SetDescription( poDecoratedLayer->GetDescription() );
+    SetRecycleFeatureTarget( poDecoratedLayer );
 }
 
 OGRLayerDecorator::~OGRLayerDecorator()
@@ -39,6 +39,7 @@ OGRMutexedLayer::OGRMutexedLayer( OGRLayer* poDecoratedLayer,
     OGRLayerDecorator(poDecoratedLayer, bTakeOwnership), m_hMutex(hMutex)
 {
     SetDescription( poDecoratedLayer->GetDescription() );
+    SetRecycleFeatureTarget( poDecoratedLayer, hMutex );
 }
 
 OGRMutexedLayer::~OGRMutexedLayer() {}
@@ -713,7 +713,7 @@ OGRFeature *OGRUnionLayer::GetNextFeature()
         }
 
         OGRFeature* poFeature = TranslateFromSrcLayer(poSrcFeature);
-        delete poSrcFeature;
+        papoSrcLayers[iCurLayer]->RecycleFeature(poSrcFeature);
 
         if( (m_poFilterGeom == nullptr ||
              FilterGeometry( poFeature->GetGeomFieldRef(m_iGeomFieldFilter) ) ) &&
@@ -723,7 +723,7 @@ OGRFeature *OGRUnionLayer::GetNextFeature()
             return poFeature;
         }
 
-        delete poFeature;
+        RecycleFeature(poFeature);
     }
     return nullptr;
 }
@@ -1231,7 +1231,7 @@ OGRFeature* OGRUnionLayer::TranslateFromSrcLayer(OGRFeature* poSrcFeature)
     CPLAssert(poSrcFeature->GetFieldCount() == 0 || panMap != nullptr);
     CPLAssert(iCurLayer >= 0 && iCurLayer < nSrcLayers);
 
-    OGRFeature* poFeature = new OGRFeature(poFeatureDefn);
+    OGRFeature* poFeature = AcquireFeature(poFeatureDefn);
     poFeature->SetFrom(poSrcFeature, panMap, TRUE);
 
     if( !osSourceLayerFieldName.empty() &&
@@ -50,6 +50,9 @@ OGRWarpedLayer::OGRWarpedLayer( OGRLayer* poDecoratedLayer,
 {
     CPLAssert(poCT != nullptr);
     SetDescription( poDecoratedLayer->GetDescription() );
+    // The features returned by this layer are copies of the source ones,
+    // with the warped layer definition, so RecycleFeature() keeps them.
+    SetRecycleFeatureTarget( nullptr );
 
     if( m_poSRS != nullptr )
     {
@@ -165,7 +168,7 @@ void OGRWarpedLayer::SetSpatialFilterRect( int iGeomField, double dfMinX, double
 
 OGRFeature *OGRWarpedLayer::SrcFeatureToWarpedFeature(OGRFeature* poSrcFeature)
 {
-    OGRFeature* poFeature = new OGRFeature(GetLayerDefn());
+    OGRFeature* poFeature = AcquireFeature(GetLayerDefn());
     poFeature->SetFrom(poSrcFeature);
     poFeature->SetFID(poSrcFeature->GetFID());
 
@@ -223,12 +226,12 @@ OGRFeature *OGRWarpedLayer::GetNextFeature()
             return nullptr;
 
         OGRFeature* poFeatureNew = SrcFeatureToWarpedFeature(poFeature);
-        delete poFeature;
+        m_poDecoratedLayer->RecycleFeature(poFeature);
 
         OGRGeometry* poGeom = poFeatureNew->GetGeomFieldRef(m_iGeomField);
         if( m_poFilterGeom != nullptr && !FilterGeometry( poGeom ) )
         {
-            delete poFeatureNew;
+            RecycleFeature(poFeatureNew);
             continue;
         }
 
@@ -41,6 +41,8 @@
 #include "cpl_json_streaming_parser.h"
 #include <ogr_api.h>
 
+#include <memory>
+
 CPL_CVSID("$Id: ogrgeojsonreader.cpp f223bfd7ad60141bbee4dc36df4cb3bf0c890431 2017-12-30 10:20:33Z Even Rouault $")
 
 static
@@ -103,10 +105,45 @@ class OGRGeoJSONReaderStreamingParser: public CPLJSonStreamingParser
         std::vector<OGRFeature*> m_apoFeatures;
         size_t m_nCurFeatureIdx;
 
+        // In the second pass, the "coordinates" array of the feature
+        // geometry is recorded as a flat token stream and the geometry is
+        // built from it directly, instead of going through one json_object
+        // per number. Tokens >= 0 are array starts holding their number of
+        // children. m_poStreamedGeomObj is only set while its object is being
+        // parsed; once built, the geometry is kept with m_poBuiltGeomObj for
+        // ReadFeature(), until another "geometry" member replaces it.
+        enum
+        {
+            COORD_TOKEN_END = -1,
+            COORD_TOKEN_NUMBER = -2
+        };
+        json_object* m_poStreamedGeomObj;
+        json_object* m_poBuiltGeomObj;
+        OGRGeometry* m_poStreamedGeom;
+        bool m_bInStreamedCoordinates;
+        bool m_bHasStreamedCoordinates;
+        CPLString m_osStreamedCoordinatesKey;
+        std::vector<int> m_anCoordTokens;
+        std::vector<double> m_adfCoordValues;
+        std::vector<size_t> m_anCoordOpenArrays;
+        size_t m_iCoordToken;
+        size_t m_iCoordValue;
+
         void AppendObject(json_object* poNewObj);
         void AnalyzeFeature();
         void TooComplex();
 
+        void StartStreamedGeometry(json_object* poGeomObj);
+        void StartStreamedArray();
+        void MaterializeStreamedCoordinates();
+        void BuildStreamedGeometry();
+        void ResetStreamedGeometry();
+        bool ReadStreamedPosition(double& dfX, double& dfY, double& dfZ,
+                                  bool& bHasZ);
+        bool ReadStreamedSimpleCurve(OGRSimpleCurve* poCurve);
+        OGRPolygon* ReadStreamedPolygon();
+        OGRGeometry* ReadStreamedGeometry(GeoJSONObject::Type eType);
+
         CPL_DISALLOW_COPY_ASSIGN(OGRGeoJSONReaderStreamingParser)
 
     public:
@@ -267,7 +304,14 @@ OGRGeoJSONReaderStreamingParser::OGRGeoJSONReaderStreamingParser(
                 m_bKeySet(false),
                 m_bNeedFID64(false),
                 m_bStoreNativeData(bStoreNativeData),
-                m_nCurFeatureIdx(0)
+                m_nCurFeatureIdx(0),
+                m_poStreamedGeomObj(nullptr),
+                m_poBuiltGeomObj(nullptr),
+                m_poStreamedGeom(nullptr),
+                m_bInStreamedCoordinates(false),
+                m_bHasStreamedCoordinates(false),
+                m_iCoordToken(0),
+                m_iCoordValue(0)
 {
 }
 
@@ -283,6 +327,7 @@ OGRGeoJSONReaderStreamingParser::~OGRGeoJSONReaderStreamingParser()
         json_object_put(m_poCurObj);
     for(size_t i = 0; i < m_apoFeatures.size(); i++ )
         delete m_apoFeatures[i];
+    delete m_poStreamedGeom;
 }
 
 /************************************************************************/
@@ -418,6 +463,321 @@ void OGRGeoJSONReaderStreamingParser::AnalyzeFeature()
     }
 }
 
+/************************************************************************/
+/*                       StartStreamedGeometry()                        */
+/************************************************************************/
+
+void OGRGeoJSONReaderStreamingParser::StartStreamedGeometry(
+                                                    json_object* poGeomObj)
+{
+    // Any previous "geometry" member has been dropped by
+    // StartObjectMember(), as json-c frees it when the new value is added.
+    CPLAssert( m_poStreamedGeomObj == nullptr );
+    CPLAssert( m_poStreamedGeom == nullptr );
+    m_poStreamedGeomObj = poGeomObj;
+}
+
+/************************************************************************/
+/*                         StartStreamedArray()                         */
+/************************************************************************/
+
+void OGRGeoJSONReaderStreamingParser::StartStreamedArray()
+{
+    if( !m_anCoordOpenArrays.empty() )
+        m_anCoordTokens[m_anCoordOpenArrays.back()] ++;
+    m_anCoordOpenArrays.push_back( m_anCoordTokens.size() );
+    m_anCoordTokens.push_back( 0 );
+}
+
+/************************************************************************/
+/*                   MaterializeStreamedCoordinates()                   */
+/*                                                                      */
+/*      Turn the recorded coordinates back into json_object, when the   */
+/*      content is not something we can translate directly. If the      */
+/*      "coordinates" array is still being parsed, its open arrays are  */
+/*      pushed on the object stack so that parsing goes on normally.    */
+/************************************************************************/
+
+void OGRGeoJSONReaderStreamingParser::MaterializeStreamedCoordinates()
+{
+    std::vector<json_object*> apoOpenArrays;
+    json_object* poRoot = nullptr;
+    size_t iValue = 0;
+    for( size_t i = 0; i < m_anCoordTokens.size(); i++ )
+    {
+        const int nToken = m_anCoordTokens[i];
+        if( nToken == COORD_TOKEN_END )
+        {
+            apoOpenArrays.pop_back();
+        }
+        else if( nToken == COORD_TOKEN_NUMBER )
+        {
+            json_object_array_add( apoOpenArrays.back(),
+                json_object_new_double( m_adfCoordValues[iValue++] ) );
+        }
+        else
+        {
+            json_object* poArray = json_object_new_array();
+            if( apoOpenArrays.empty() )
+                poRoot = poArray;
+            else
+                json_object_array_add( apoOpenArrays.back(), poArray );
+            apoOpenArrays.push_back( poArray );
+        }
+    }
+
+    json_object_object_add( m_poStreamedGeomObj,
+                            m_osStreamedCoordinatesKey, poRoot );
+    if( m_bInStreamedCoordinates )
+    {
+        m_apoCurObj.insert( m_apoCurObj.end(),
+                            apoOpenArrays.begin(), apoOpenArrays.end() );
+    }
+
+    m_bInStreamedCoordinates = false;
+    m_bHasStreamedCoordinates = false;
+    m_anCoordTokens.clear();
+    m_adfCoordValues.clear();
+    m_anCoordOpenArrays.clear();
+}
+
+/************************************************************************/
+/*                        BuildStreamedGeometry()                       */
+/************************************************************************/
+
+void OGRGeoJSONReaderStreamingParser::BuildStreamedGeometry()
+{
+    json_object* poGeomObj = m_poStreamedGeomObj;
+    if( !m_bHasStreamedCoordinates )
+    {
+        m_poStreamedGeomObj = nullptr;
+        return;
+    }
+
+    // Geometry-level "crs" and GeometryCollection are left to
+    // OGRGeoJSONReadGeometry().
+    OGRGeometry* poGeom = nullptr;
+    if( OGRGeoJSONFindMemberEntryByName( poGeomObj, "crs" ) == nullptr )
+    {
+        m_iCoordToken = 0;
+        m_iCoordValue = 0;
+        poGeom = ReadStreamedGeometry( OGRGeoJSONGetType(poGeomObj) );
+    }
+
+    if( poGeom == nullptr )
+    {
+        MaterializeStreamedCoordinates();
+        m_poStreamedGeomObj = nullptr;
+        return;
+    }
+
+    OGRSpatialReference* poSRS = m_poLayer->GetSpatialRef();
+    poGeom->assignSpatialReference(
+        poSRS ? poSRS : OGRSpatialReference::GetWGS84SRS() );
+    m_poStreamedGeom = poGeom;
+    m_poBuiltGeomObj = poGeomObj;
+
+    m_poStreamedGeomObj = nullptr;
+    m_bHasStreamedCoordinates = false;
+    m_anCoordTokens.clear();
+    m_adfCoordValues.clear();
+    m_anCoordOpenArrays.clear();
+}
+
+/************************************************************************/
+/*                        ResetStreamedGeometry()                       */
+/************************************************************************/
+
+void OGRGeoJSONReaderStreamingParser::ResetStreamedGeometry()
+{
+    m_poStreamedGeomObj = nullptr;
+    m_poBuiltGeomObj = nullptr;
+    delete m_poStreamedGeom;
+    m_poStreamedGeom = nullptr;
+    m_bInStreamedCoordinates = false;
+    m_bHasStreamedCoordinates = false;
+    m_anCoordTokens.clear();
+    m_adfCoordValues.clear();
+    m_anCoordOpenArrays.clear();
+}
+
+/************************************************************************/
+/*                        ReadStreamedPosition()                        */
+/*                                                                      */
+/*      Same semantics as OGRGeoJSONReadRawPoint(), but only succeeds   */
+/*      when it would have succeeded silently.                          */
+/************************************************************************/
+
+bool OGRGeoJSONReaderStreamingParser::ReadStreamedPosition( double& dfX,
+                                                            double& dfY,
+                                                            double& dfZ,
+                                                            bool& bHasZ )
+{
+    const int nCount = m_anCoordTokens[m_iCoordToken];
+    if( nCount < GeoJSONObject::eMinCoordinateDimension )
+        return false;
+    for( int i = 1; i <= nCount; i++ )
+    {
+        if( m_anCoordTokens[m_iCoordToken + i] != COORD_TOKEN_NUMBER )
+            return false;
+    }
+
+    dfX = m_adfCoordValues[m_iCoordValue];
+    dfY = m_adfCoordValues[m_iCoordValue + 1];
+    bHasZ = nCount >= GeoJSONObject::eMaxCoordinateDimension;
+    if( bHasZ )
+        dfZ = m_adfCoordValues[m_iCoordValue + 2];
+
+    m_iCoordValue += nCount;
+    m_iCoordToken += nCount + 2;
+    return true;
+}
+
+/************************************************************************/
+/*                       ReadStreamedSimpleCurve()                      */
+/************************************************************************/
+
+bool OGRGeoJSONReaderStreamingParser::ReadStreamedSimpleCurve(
+                                                    OGRSimpleCurve* poCurve )
+{
+    const int nPoints = m_anCoordTokens[m_iCoordToken];
+    if( nPoints < 0 )
+        return false;
+    m_iCoordToken ++;
+
+    poCurve->setNumPoints( nPoints );
+    for( int i = 0; i < nPoints; i++ )
+    {
+        double dfX = 0.0;
+        double dfY = 0.0;
+        double dfZ = 0.0;
+        bool bHasZ = false;
+        if( !ReadStreamedPosition(dfX, dfY, dfZ, bHasZ) )
+            return false;
+        if( bHasZ )
+            poCurve->setPoint( i, dfX, dfY, dfZ );
+        else
+            poCurve->setPoint( i, dfX, dfY );
+    }
+
+    m_iCoordToken ++;
+    return true;
+}
+
+/************************************************************************/
+/*                         ReadStreamedPolygon()                        */
+/************************************************************************/
+
+OGRPolygon* OGRGeoJSONReaderStreamingParser::ReadStreamedPolygon()
+{
+    const int nRings = m_anCoordTokens[m_iCoordToken];
+    if( nRings <= 0 )
+        return nullptr;
+    m_iCoordToken ++;
+
+    OGRPolygon* poPolygon = new OGRPolygon();
+    for( int i = 0; i < nRings; i++ )
+    {
+        OGRLinearRing* poRing = new OGRLinearRing();
+        poPolygon->addRingDirectly( poRing );
+        if( !ReadStreamedSimpleCurve(poRing) )
+        {
+            delete poPolygon;
+            return nullptr;
+        }
+    }
+
+    m_iCoordToken ++;
+    return poPolygon;
+}
+
+/************************************************************************/
+/*                        ReadStreamedGeometry()                        */
+/************************************************************************/
+
+OGRGeometry* OGRGeoJSONReaderStreamingParser::ReadStreamedGeometry(
+                                                GeoJSONObject::Type eType )
+{
+    double dfX = 0.0;
+    double dfY = 0.0;
+    double dfZ = 0.0;
+    bool bHasZ = false;
+
+    if( eType == GeoJSONObject::ePoint )
+    {
+        if( !ReadStreamedPosition(dfX, dfY, dfZ, bHasZ) )
+            return nullptr;
+        return bHasZ ? new OGRPoint(dfX, dfY, dfZ) : new OGRPoint(dfX, dfY);
+    }
+
+    if( eType == GeoJSONObject::eLineString )
+    {
+        OGRLineString* poLine = new OGRLineString();
+        if( !ReadStreamedSimpleCurve(poLine) )
+        {
+            delete poLine;
+            return nullptr;
+        }
+        return poLine;
+    }
+
+    if( eType == GeoJSONObject::ePolygon )
+        return ReadStreamedPolygon();
+
+    if( eType != GeoJSONObject::eMultiPoint &&
+        eType != GeoJSONObject::eMultiLineString &&
+        eType != GeoJSONObject::eMultiPolygon )
+    {
+        return nullptr;
+    }
+
+    const int nParts = m_anCoordTokens[m_iCoordToken];
+    if( nParts < 0 )
+        return nullptr;
+    m_iCoordToken ++;
+
+    OGRGeometryCollection* poColl =
+        eType == GeoJSONObject::eMultiPoint ?
+            static_cast<OGRGeometryCollection*>(new OGRMultiPoint()) :
+        eType == GeoJSONObject::eMultiLineString ?
+            static_cast<OGRGeometryCollection*>(new OGRMultiLineString()) :
+            static_cast<OGRGeometryCollection*>(new OGRMultiPolygon());
+    for( int i = 0; i < nParts; i++ )
+    {
+        OGRGeometry* poPart = nullptr;
+        if( eType == GeoJSONObject::eMultiPoint )
+        {
+            if( ReadStreamedPosition(dfX, dfY, dfZ, bHasZ) )
+            {
+                poPart = bHasZ ? new OGRPoint(dfX, dfY, dfZ) :
+                                 new OGRPoint(dfX, dfY);
+            }
+        }
+        else if( eType == GeoJSONObject::eMultiLineString )
+        {
+            OGRLineString* poLine = new OGRLineString();
+            if( ReadStreamedSimpleCurve(poLine) )
+                poPart = poLine;
+            else
+                delete poLine;
+        }
+        else
+        {
+            poPart = ReadStreamedPolygon();
+        }
+
+        if( poPart == nullptr )
+        {
+            delete poColl;
+            return nullptr;
+        }
+        poColl->addGeometryDirectly( poPart );
+    }
+
+    m_iCoordToken ++;
+    return poColl;
+}
+
 /************************************************************************/
 /*                            StartObject()                             */
 /************************************************************************/
@@ -450,9 +810,19 @@ void OGRGeoJSONReaderStreamingParser::StartObject()
 
         m_nCurObjMemEstimate += ESTIMATE_OBJECT_SIZE;
 
+        if( m_bInStreamedCoordinates )
+            MaterializeStreamedCoordinates();
+
+        const bool bIsGeometry =
+            !m_bFirstPass && m_bInFeaturesArray && m_nDepth == 3 &&
+            m_bKeySet && EQUAL(m_osCurKey, "geometry");
+
         json_object* poNewObj = json_object_new_object();
         AppendObject( poNewObj );
         m_apoCurObj.push_back( poNewObj );
+
+        if( bIsGeometry )
+            StartStreamedGeometry( poNewObj );
     }
     else if( m_bFirstPass && m_nDepth == 0 )
     {
@@ -505,7 +875,10 @@ void OGRGeoJSONReaderStreamingParser::EndObject()
         else
         {
             OGRFeature* poFeat = m_oReader.ReadFeature(m_poLayer, m_poCurObj,
-                                                       m_osJson.c_str());
+                                                       m_osJson.c_str(),
+                                                       m_poBuiltGeomObj,
+                                                       m_poStreamedGeom);
+            m_poStreamedGeom = nullptr;
             if( poFeat )
             {
                 m_apoFeatures.push_back( poFeat );
@@ -517,6 +890,7 @@ void OGRGeoJSONReaderStreamingParser::EndObject()
         m_apoCurObj.clear();
         m_nCurObjMemEstimate = 0;
         m_bInCoordinates = false;
+        ResetStreamedGeometry();
         m_nTotalOGRFeatureMemEstimate += sizeof(OGRFeature);
         m_osJson.clear();
         m_abFirstMember.clear();
@@ -529,6 +903,9 @@ void OGRGeoJSONReaderStreamingParser::EndObject()
             m_osJson += "}";
         }
 
+        if( m_apoCurObj.back() == m_poStreamedGeomObj )
+            BuildStreamedGeometry();
+
         m_apoCurObj.pop_back();
     }
     else if( m_nDepth == 1 )
@@ -573,6 +950,12 @@ void OGRGeoJSONReaderStreamingParser::StartObjectMember(const char* pszKey,
     {
         m_bInCoordinates = strcmp(pszKey, "coordinates") == 0 ||
                            strcmp(pszKey, "geometries") == 0;
+
+        // A later "geometry" member wins in ReadFeature(), and json-c frees
+        // the previous value if the key is the same: forget the streamed
+        // one before its object goes away.
+        if( !m_bFirstPass && EQUAL(pszKey, "geometry") )
+            ResetStreamedGeometry();
     }
 
     if( m_poCurObj )
@@ -585,6 +968,15 @@ void OGRGeoJSONReaderStreamingParser::StartObjectMember(const char* pszKey,
             m_osJson += CPLJSonStreamingParser::GetSerializedString(pszKey) + ":";
         }
 
+        // Another "coordinates" member in the geometry: keep json-c
+        // ordering so that the same one as before is picked up.
+        if( m_bHasStreamedCoordinates &&
+            m_apoCurObj.back() == m_poStreamedGeomObj &&
+            EQUAL(pszKey, "coordinates") )
+        {
+            MaterializeStreamedCoordinates();
+        }
+
         m_nCurObjMemEstimate += ESTIMATE_OBJECT_ELT_SIZE;
         m_osCurKey.assign(pszKey, nKeyLen);
         m_bKeySet = true;
@@ -617,9 +1009,29 @@ void OGRGeoJSONReaderStreamingParser::StartArray()
 
         m_nCurObjMemEstimate += ESTIMATE_ARRAY_SIZE;
 
-        json_object* poNewObj = json_object_new_array();
-        AppendObject(poNewObj);
-        m_apoCurObj.push_back( poNewObj );
+        if( m_bInStreamedCoordinates )
+        {
+            StartStreamedArray();
+        }
+        else if( m_poStreamedGeomObj != nullptr &&
+                 !m_bHasStreamedCoordinates && m_bKeySet &&
+                 m_apoCurObj.back() == m_poStreamedGeomObj &&
+                 EQUAL(m_osCurKey, "coordinates") &&
+                 OGRGeoJSONFindMemberEntryByName(m_poStreamedGeomObj,
+                                                 "coordinates") == nullptr )
+        {
+            m_osStreamedCoordinatesKey = m_osCurKey;
+            m_osCurKey.clear();
+            m_bKeySet = false;
+            m_bInStreamedCoordinates = true;
+            StartStreamedArray();
+        }
+        else
+        {
+            json_object* poNewObj = json_object_new_array();
+            AppendObject(poNewObj);
+            m_apoCurObj.push_back( poNewObj );
+        }
     }
     m_nDepth ++;
 }
@@ -668,7 +1080,20 @@ void OGRGeoJSONReaderStreamingParser::EndArray()
             m_osJson += "]";
         }
 
-        m_apoCurObj.pop_back();
+        if( m_bInStreamedCoordinates )
+        {
+            m_anCoordTokens.push_back( COORD_TOKEN_END );
+            m_anCoordOpenArrays.pop_back();
+            if( m_anCoordOpenArrays.empty() )
+            {
+                m_bInStreamedCoordinates = false;
+                m_bHasStreamedCoordinates = true;
+            }
+        }
+        else
+        {
+            m_apoCurObj.pop_back();
+        }
     }
 }
 
@@ -703,6 +1128,8 @@ void OGRGeoJSONReaderStreamingParser::String(const char* pszValue, size_t nLen)
         {
             m_osJson += CPLJSonStreamingParser::GetSerializedString(pszValue);
         }
+        if( m_bInStreamedCoordinates )
+            MaterializeStreamedCoordinates();
         AppendObject(json_object_new_string(pszValue));
     }
 }
@@ -738,7 +1165,16 @@ void OGRGeoJSONReaderStreamingParser::Number(const char* pszValue, size_t nLen)
             m_osJson.append(pszValue, nLen);
         }
 
-        if( CPLGetValueType(pszValue) == CPL_VALUE_REAL )
+        if( m_bInStreamedCoordinates )
+        {
+            m_anCoordTokens[m_anCoordOpenArrays.back()] ++;
+            m_anCoordTokens.push_back( COORD_TOKEN_NUMBER );
+            m_adfCoordValues.push_back(
+                CPLGetValueType(pszValue) == CPL_VALUE_REAL ?
+                    CPLAtof(pszValue) :
+                    static_cast<double>(CPLAtoGIntBig(pszValue)) );
+        }
+        else if( CPLGetValueType(pszValue) == CPL_VALUE_REAL )
         {
             AppendObject(json_object_new_double(CPLAtof(pszValue)));
         }
@@ -774,6 +1210,8 @@ void OGRGeoJSONReaderStreamingParser::Boolean(bool bVal)
         {
             m_osJson += bVal ? "true": "false";
         }
+        if( m_bInStreamedCoordinates )
+            MaterializeStreamedCoordinates();
 
         AppendObject( json_object_new_boolean(bVal) );
     }
@@ -799,6 +1237,8 @@ void OGRGeoJSONReaderStreamingParser::Null()
         }
 
         m_nCurObjMemEstimate += ESTIMATE_BASE_OBJECT_SIZE;
+        if( m_bInStreamedCoordinates )
+            MaterializeStreamedCoordinates();
         AppendObject( nullptr );
     }
 }
@@ -2075,8 +2515,15 @@ bool OGRGeoJSONReader::AddFeature( OGRGeoJSONLayer* poLayer,
 OGRGeometry* OGRGeoJSONReader::ReadGeometry( json_object* poObj,
                                              OGRSpatialReference* poLayerSRS )
 {
-    OGRGeometry* poGeometry = OGRGeoJSONReadGeometry( poObj, poLayerSRS );
+    return WrapGeometry( OGRGeoJSONReadGeometry( poObj, poLayerSRS ) );
+}
 
+/************************************************************************/
+/*                           WrapGeometry                               */
+/************************************************************************/
+
+OGRGeometry* OGRGeoJSONReader::WrapGeometry( OGRGeometry* poGeometry )
+{
 /* -------------------------------------------------------------------- */
 /*      Wrap geometry with GeometryCollection as a common denominator.  */
 /*      Sometimes a GeoJSON text may consist of objects of different    */
@@ -2289,10 +2736,16 @@ void OGRGeoJSONReaderSetField( OGRLayer* poLayer,
 
 OGRFeature* OGRGeoJSONReader::ReadFeature( OGRGeoJSONLayer* poLayer,
                                            json_object* poObj,
-                                           const char* pszSerializedObj )
+                                           const char* pszSerializedObj,
+                                           json_object* poStreamedGeomObj,
+                                           OGRGeometry* poStreamedGeomIn )
 {
     CPLAssert( nullptr != poObj );
 
+    // Geometry already built by the streaming parser for the
+    // poStreamedGeomObj member, whose "coordinates" have been omitted.
+    std::unique_ptr<OGRGeometry> poStreamedGeom(poStreamedGeomIn);
+
     OGRFeature* poFeature = new OGRFeature( poLayer->GetLayerDefn() );
 
     if( bStoreNativeData_ )
@@ -2424,8 +2877,11 @@ OGRFeature* OGRGeoJSONReader::ReadFeature( OGRGeoJSONLayer* poLayer,
         // NOTE: If geometry can not be parsed or read correctly
         //       then NULL geometry is assigned to a feature and
         //       geometry type for layer is classified as wkbUnknown.
-        OGRGeometry* poGeometry = ReadGeometry( poObjGeom,
-                                                poLayer->GetSpatialRef() );
+        OGRGeometry* poGeometry = nullptr;
+        if( poObjGeom == poStreamedGeomObj && poStreamedGeom != nullptr )
+            poGeometry = WrapGeometry( poStreamedGeom.release() );
+        else
+            poGeometry = ReadGeometry( poObjGeom, poLayer->GetSpatialRef() );
         if( nullptr != poGeometry )
         {
             poFeature->SetGeometryDirectly( poGeometry );
@@ -171,8 +171,11 @@ class OGRGeoJSONReader
     static bool AddFeature( OGRGeoJSONLayer* poLayer, OGRFeature* poFeature );
 
     OGRGeometry* ReadGeometry( json_object* poObj, OGRSpatialReference* poLayerSRS );
+    OGRGeometry* WrapGeometry( OGRGeometry* poGeometry );
     OGRFeature* ReadFeature( OGRGeoJSONLayer* poLayer, json_object* poObj,
-                             const char* pszSerializedObj );
+                             const char* pszSerializedObj,
+                             json_object* poStreamedGeomObj = nullptr,
+                             OGRGeometry* poStreamedGeom = nullptr );
     void ReadFeatureCollection( OGRGeoJSONLayer* poLayer, json_object* poObj );
     size_t SkipPrologEpilogAndUpdateJSonPLikeWrapper( size_t nRead );
 };
@@ -144,7 +144,7 @@ OGRFeature *OGRGeoPackageLayer::GetNextFeature()
                 || m_poAttrQuery->Evaluate( poFeature )) )
             return poFeature;
 
-        delete poFeature;
+        RecycleFeature( poFeature );
     }
 }
 
@@ -158,7 +158,7 @@ OGRFeature *OGRGeoPackageLayer::TranslateFeature( sqlite3_stmt* hStmt )
 /* -------------------------------------------------------------------- */
 /*      Create a feature from the current result.                       */
 /* -------------------------------------------------------------------- */
-    OGRFeature *poFeature = new OGRFeature( m_poFeatureDefn );
+    OGRFeature *poFeature = AcquireFeature( m_poFeatureDefn );
 
 /* -------------------------------------------------------------------- */
 /*      Set FID if we have a column to set it from.                     */
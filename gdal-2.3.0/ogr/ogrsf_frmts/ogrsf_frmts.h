@@ -236,8 +236,13 @@ class CPL_DLL OGRLayer : public GDALMajorObject
     /* non virtual : convenience wrapper for ReorderFields() */
     OGRErr              ReorderField( int iOldFieldPos, int iNewFieldPos );
 
+    void                RecycleFeature( OGRFeature* poFeature );
+
 //! @cond Doxygen_Suppress
     int                 AttributeFilterEvaluationNeedsGeometry();
+    OGRFeature         *AcquireFeature( OGRFeatureDefn* poDefn );
+    void                SetRecycleFeatureTarget( OGRLayer* poLayer,
+                                                 CPLMutex* hMutex = nullptr );
 
     /* consider these private */
     OGRErr               InitializeIndexSupport( const char * );
@@ -780,7 +780,8 @@ OGRFeature *OGRShapeLayer::FetchShape( int iShapeId )
             || psShape->nSHPType == SHPT_NULL )
         {
             poFeature = SHPReadOGRFeature( hSHP, hDBF, poFeatureDefn,
-                                           iShapeId, psShape, osEncoding );
+                                           iShapeId, psShape, osEncoding,
+                                           AcquireFeature(poFeatureDefn) );
         }
         else if( m_sFilterEnvelope.MaxX < psShape->dfXMin
                  || m_sFilterEnvelope.MaxY < psShape->dfYMin
@@ -793,13 +794,15 @@ OGRFeature *OGRShapeLayer::FetchShape( int iShapeId )
         else
         {
             poFeature = SHPReadOGRFeature( hSHP, hDBF, poFeatureDefn,
-                                           iShapeId, psShape, osEncoding );
+                                           iShapeId, psShape, osEncoding,
+                                           AcquireFeature(poFeatureDefn) );
         }
     }
     else
     {
         poFeature = SHPReadOGRFeature( hSHP, hDBF, poFeatureDefn,
-                                       iShapeId, nullptr, osEncoding );
+                                       iShapeId, nullptr, osEncoding,
+                                       AcquireFeature(poFeatureDefn) );
     }
 
     return poFeature;
@@ -886,7 +889,7 @@ OGRFeature *OGRShapeLayer::GetNextFeature()
                 return poFeature;
             }
 
-            delete poFeature;
+            RecycleFeature( poFeature );
         }
     }
 }
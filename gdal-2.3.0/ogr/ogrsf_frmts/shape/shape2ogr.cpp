@@ -1140,9 +1140,12 @@ OGRFeatureDefn *SHPReadOGRFeatureDefn( const char * pszName,
 /*                         SHPReadOGRFeature()                          */
 /************************************************************************/
 
+// poFeatureIn, if not NULL, is an empty feature of poDefn to fill (see
+// OGRLayer::AcquireFeature()). It is destroyed in case of failure.
 OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
                                OGRFeatureDefn * poDefn, int iShape,
-                               SHPObject *psShape, const char *pszSHPEncoding )
+                               SHPObject *psShape, const char *pszSHPEncoding,
+                               OGRFeature *poFeatureIn )
 
 {
     if( iShape < 0
@@ -1152,6 +1155,7 @@ OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
         CPLError( CE_Failure, CPLE_AppDefined,
                   "Attempt to read shape with feature id (%d) out of available"
                   " range.", iShape );
+        delete poFeatureIn;
         return nullptr;
     }
 
@@ -1163,10 +1167,12 @@ OGRFeature *SHPReadOGRFeature( SHPHandle hSHP, DBFHandle hDBF,
                   iShape );
         if( psShape != nullptr )
             SHPDestroyObject(psShape);
+        delete poFeatureIn;
         return nullptr;
     }
 
-    OGRFeature  *poFeature = new OGRFeature( poDefn );
+    OGRFeature  *poFeature =
+        poFeatureIn != nullptr ? poFeatureIn : new OGRFeature( poDefn );
 
 /* -------------------------------------------------------------------- */
 /*      Fetch geometry from Shapefile to OGRFeature.                    */
@@ -8175,6 +8175,7 @@ void CleanupESRIDatumMappingTable();
 CPL_C_END
 static void CleanupSRSWGS84Mutex();
 void CleanupFindMatchesCacheAndMutex();
+void CleanupEPSGImportCache();
 
 /**
  * \brief Cleanup cached SRS related memory.
@@ -8187,9 +8188,11 @@ void OSRCleanup( void )
 {
     CleanupESRIDatumMappingTable();
     CSVDeaccess( nullptr );
+    OCTCleanupTransformationCache();
     OCTCleanupProjMutex();
     CleanupSRSWGS84Mutex();
     CleanupFindMatchesCacheAndMutex();
+    CleanupEPSGImportCache();
 }
 
 /************************************************************************/
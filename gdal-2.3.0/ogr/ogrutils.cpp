@@ -39,6 +39,10 @@
 #include <cctype>
 #include <limits>
 
+#if defined(__x86_64) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
 #include "cpl_conv.h"
 #include "cpl_error.h"
 #include "cpl_string.h"
@@ -64,6 +68,148 @@ inline bool CPLIsDoubleAnInt(double d)
     return d == static_cast<double>(static_cast<int>(d));
 }
 
+/************************************************************************/
+/*                       OGRFormatDoubleFast()                          */
+/*                                                                      */
+/*      Exact replacement for snprintf("%.<nPrecision>f") on values in  */
+/*      ]-1,1[ and for snprintf("%.<nPrecision>g") on values whose      */
+/*      integer part has at most nPrecision digits. The value m * 2^e   */
+/*      is scaled by a power of ten with 128 bit integer arithmetic and */
+/*      rounded half to even, as glibc does in the default rounding     */
+/*      mode. Returns false if the value is not handled.                */
+/************************************************************************/
+
+static bool OGRFormatDoubleFast( char *pszBuffer, int nBufferLen,
+                                 double dfVal, int nPrecision,
+                                 char chConversionSpecifier )
+{
+#ifdef __SIZEOF_INT128__
+    constexpr GUInt64 anPow10[] =
+    {
+        1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+        10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+        100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+        100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+        100000000000000000ULL
+    };
+    if( nPrecision < 1 || nPrecision > 17 )
+        return false;
+
+    const double dfAbs = fabs(dfVal);
+    int nDecimals = 0;
+    if( chConversionSpecifier == 'f' )
+    {
+        if( !(dfAbs < 1.0) )
+            return false;
+        nDecimals = nPrecision;
+    }
+    else if( chConversionSpecifier == 'g' )
+    {
+        if( !(dfAbs >= 1.0 &&
+              dfAbs < static_cast<double>(anPow10[nPrecision])) )
+            return false;
+        int nIntDigits = 1;
+        while( nIntDigits < nPrecision &&
+               dfAbs >= static_cast<double>(anPow10[nIntDigits]) )
+            nIntDigits++;
+        nDecimals = nPrecision - nIntDigits;
+    }
+    else
+    {
+        return false;
+    }
+
+    // dfAbs = nMantissa * 2^nExp
+    GUInt64 nBits = 0;
+    memcpy(&nBits, &dfAbs, sizeof(nBits));
+    const int nBiasedExp = static_cast<int>(nBits >> 52);
+    GUInt64 nMantissa = nBits & ((static_cast<GUInt64>(1) << 52) - 1);
+    int nExp = -1074;
+    if( nBiasedExp != 0 )
+    {
+        nMantissa |= static_cast<GUInt64>(1) << 52;
+        nExp = nBiasedExp - 1075;
+    }
+
+    typedef unsigned __int128 OGRUInt128;
+    const OGRUInt128 nScaled =
+        static_cast<OGRUInt128>(nMantissa) * anPow10[nDecimals];
+    OGRUInt128 nRounded = 0;
+    if( nExp >= 0 )
+    {
+        // Only possible for large integral values in 'g' mode.
+        if( nExp > 10 )
+            return false;
+        nRounded = nScaled << nExp;
+    }
+    else if( nExp > -128 )
+    {
+        const int nShift = -nExp;
+        nRounded = nScaled >> nShift;
+        const OGRUInt128 nRemainder = nScaled - (nRounded << nShift);
+        const OGRUInt128 nHalf = static_cast<OGRUInt128>(1) << (nShift - 1);
+        if( nRemainder > nHalf || (nRemainder == nHalf && (nRounded & 1)) )
+            nRounded++;
+    }
+    // else: nScaled < 2^114 is less than half of 2^128, so rounds to zero.
+
+    // In 'g' mode, a carry to the next power of ten changes the exponent.
+    if( chConversionSpecifier == 'g' &&
+        nRounded >= static_cast<OGRUInt128>(anPow10[nPrecision]) )
+        return false;
+
+    const GUInt64 nValue = static_cast<GUInt64>(nRounded);
+    GUInt64 nIntPart = nValue / anPow10[nDecimals];
+    GUInt64 nFracPart = nValue % anPow10[nDecimals];
+
+    char szTmp[48] = {};
+    int iPos = static_cast<int>(sizeof(szTmp)) - 1;
+    if( nDecimals > 0 )
+    {
+        int nFracDigits = nDecimals;
+        // %g strips trailing zeros, and the decimal point if nothing is
+        // left after it.
+        if( chConversionSpecifier == 'g' )
+        {
+            while( nFracDigits > 0 && (nFracPart % 10) == 0 )
+            {
+                nFracPart /= 10;
+                nFracDigits--;
+            }
+        }
+        if( nFracDigits > 0 )
+        {
+            for( int i = 0; i < nFracDigits; i++ )
+            {
+                szTmp[--iPos] = static_cast<char>('0' + nFracPart % 10);
+                nFracPart /= 10;
+            }
+            szTmp[--iPos] = '.';
+        }
+    }
+    do
+    {
+        szTmp[--iPos] = static_cast<char>('0' + nIntPart % 10);
+        nIntPart /= 10;
+    } while( nIntPart != 0 );
+    if( std::signbit(dfVal) )
+        szTmp[--iPos] = '-';
+
+    const int nLen = static_cast<int>(sizeof(szTmp)) - 1 - iPos;
+    if( nLen >= nBufferLen )
+        return false;
+    memcpy(pszBuffer, szTmp + iPos, nLen + 1);
+    return true;
+#else
+    CPL_IGNORE_RET_VAL(pszBuffer);
+    CPL_IGNORE_RET_VAL(nBufferLen);
+    CPL_IGNORE_RET_VAL(dfVal);
+    CPL_IGNORE_RET_VAL(nPrecision);
+    CPL_IGNORE_RET_VAL(chConversionSpecifier);
+    return false;
+#endif
+}
+
 /************************************************************************/
 /*                        OGRFormatDouble()                             */
 /************************************************************************/
@@ -91,13 +237,17 @@ void OGRFormatDouble( char *pszBuffer, int nBufferLen, double dfVal,
     snprintf(szFormat, sizeof(szFormat),
              "%%.%d%c", nPrecision, chConversionSpecifier);
 
-    int ret = CPLsnprintf(pszBuffer, nBufferLen, szFormat, dfVal);
-    // Windows CRT does not conform with C99 and returns -1 when buffer is
-    // truncated.
-    if( ret >= nBufferLen || ret == -1 )
+    if( !OGRFormatDoubleFast(pszBuffer, nBufferLen, dfVal, nPrecision,
+                             chConversionSpecifier) )
     {
-        CPLsnprintf(pszBuffer, nBufferLen, "%s", "too_big");
-        return;
+        int ret = CPLsnprintf(pszBuffer, nBufferLen, szFormat, dfVal);
+        // Windows CRT does not conform with C99 and returns -1 when buffer is
+        // truncated.
+        if( ret >= nBufferLen || ret == -1 )
+        {
+            CPLsnprintf(pszBuffer, nBufferLen, "%s", "too_big");
+            return;
+        }
     }
 
     if( chConversionSpecifier == 'g' && strchr(pszBuffer, 'e') )
@@ -504,6 +654,142 @@ const char *OGRWktReadToken( const char * pszInput, char * pszToken )
     return pszInput;
 }
 
+/************************************************************************/
+/*                         OGRSwapDoubleArray()                         */
+/************************************************************************/
+
+/** Byte-swap in place an array of nCount 64 bit values, that need not be
+ * aligned. Used by the WKB import/export code. */
+void OGRSwapDoubleArray( void *pData, size_t nCount )
+{
+    GByte *pabyData = static_cast<GByte *>(pData);
+    size_t i = 0;
+#if defined(__x86_64) || defined(_M_X64)
+    // Swap bytes within 16 bit words, then reverse the order of the 16 bit
+    // words within each 64 bit half.
+    for( ; i + 4 <= nCount; i += 4 )
+    {
+        __m128i xmm0 = _mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(pabyData + i * 8));
+        __m128i xmm1 = _mm_loadu_si128(
+            reinterpret_cast<const __m128i *>(pabyData + i * 8 + 16));
+        xmm0 = _mm_or_si128(_mm_slli_epi16(xmm0, 8), _mm_srli_epi16(xmm0, 8));
+        xmm1 = _mm_or_si128(_mm_slli_epi16(xmm1, 8), _mm_srli_epi16(xmm1, 8));
+        xmm0 = _mm_shufflehi_epi16(
+            _mm_shufflelo_epi16(xmm0, _MM_SHUFFLE(0, 1, 2, 3)),
+            _MM_SHUFFLE(0, 1, 2, 3));
+        xmm1 = _mm_shufflehi_epi16(
+            _mm_shufflelo_epi16(xmm1, _MM_SHUFFLE(0, 1, 2, 3)),
+            _MM_SHUFFLE(0, 1, 2, 3));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(pabyData + i * 8), xmm0);
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i *>(pabyData + i * 8 + 16), xmm1);
+    }
+#endif
+    for( ; i < nCount; i++ )
+    {
+        CPL_SWAP64PTR( pabyData + i * 8 );
+    }
+}
+
+/************************************************************************/
+/*                             OGRWktAtof()                             */
+/*                                                                      */
+/*      Exact replacement for CPLAtof() on WKT number tokens. Decimal   */
+/*      numbers with a significand of at most 2^53 and a power of ten   */
+/*      of at most 22 in absolute value are converted with a single     */
+/*      exact multiplication or division (Clinger's fast path), which   */
+/*      yields the correctly rounded result. Anything else goes through */
+/*      CPLAtof().                                                      */
+/************************************************************************/
+
+static double OGRWktAtof( const char *pszToken )
+{
+    constexpr double adfTenPower[] =
+    {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+        1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20,
+        1e21, 1e22
+    };
+    constexpr GUInt64 nMaxExactMantissa = static_cast<GUInt64>(1) << 53;
+
+    const char *p = pszToken;
+    bool bNegative = false;
+    if( *p == '-' )
+    {
+        bNegative = true;
+        ++p;
+    }
+    else if( *p == '+' )
+    {
+        ++p;
+    }
+
+    GUInt64 nMantissa = 0;
+    int nDigits = 0;
+    int nExp10 = 0;
+    for( ; *p >= '0' && *p <= '9'; ++p, ++nDigits )
+    {
+        if( nMantissa > (nMaxExactMantissa - 9) / 10 )
+            return CPLAtof(pszToken);
+        nMantissa = nMantissa * 10 + (*p - '0');
+    }
+    if( *p == '.' )
+    {
+        ++p;
+        for( ; *p >= '0' && *p <= '9'; ++p, ++nDigits )
+        {
+            if( nMantissa > (nMaxExactMantissa - 9) / 10 )
+                return CPLAtof(pszToken);
+            nMantissa = nMantissa * 10 + (*p - '0');
+            --nExp10;
+        }
+    }
+    if( nDigits == 0 )
+        return CPLAtof(pszToken);
+    if( *p == 'e' || *p == 'E' )
+    {
+        ++p;
+        bool bNegativeExp = false;
+        if( *p == '-' )
+        {
+            bNegativeExp = true;
+            ++p;
+        }
+        else if( *p == '+' )
+        {
+            ++p;
+        }
+        if( !(*p >= '0' && *p <= '9') )
+            return CPLAtof(pszToken);
+        int nExpPart = 0;
+        for( ; *p >= '0' && *p <= '9'; ++p )
+        {
+            if( nExpPart > 1000 )
+                return CPLAtof(pszToken);
+            nExpPart = nExpPart * 10 + (*p - '0');
+        }
+        nExp10 += bNegativeExp ? -nExpPart : nExpPart;
+    }
+    if( *p != '\0' )
+        return CPLAtof(pszToken);
+
+    double dfVal = static_cast<double>(nMantissa);
+    if( nExp10 < 0 )
+    {
+        if( nExp10 < -22 )
+            return CPLAtof(pszToken);
+        dfVal /= adfTenPower[-nExp10];
+    }
+    else if( nExp10 > 0 )
+    {
+        if( nExp10 > 22 )
+            return CPLAtof(pszToken);
+        dfVal *= adfTenPower[nExp10];
+    }
+    return bNegative ? -dfVal : dfVal;
+}
+
 /************************************************************************/
 /*                          OGRWktReadPoints()                          */
 /*                                                                      */
@@ -584,8 +870,8 @@ const char * OGRWktReadPoints( const char * pszInput,
 /* -------------------------------------------------------------------- */
 /*      Add point to list.                                              */
 /* -------------------------------------------------------------------- */
-        (*ppaoPoints)[*pnPointsRead].x = CPLAtof(szTokenX);
-        (*ppaoPoints)[*pnPointsRead].y = CPLAtof(szTokenY);
+        (*ppaoPoints)[*pnPointsRead].x = OGRWktAtof(szTokenX);
+        (*ppaoPoints)[*pnPointsRead].y = OGRWktAtof(szTokenY);
 
 /* -------------------------------------------------------------------- */
 /*      Do we have a Z coordinate?                                      */
@@ -600,7 +886,7 @@ const char * OGRWktReadPoints( const char * pszInput,
                     CPLCalloc(sizeof(double), *pnMaxPoints) );
             }
 
-            (*ppadfZ)[*pnPointsRead] = CPLAtof(szDelim);
+            (*ppadfZ)[*pnPointsRead] = OGRWktAtof(szDelim);
 
             pszInput = OGRWktReadToken( pszInput, szDelim );
         }
@@ -728,8 +1014,8 @@ const char * OGRWktReadPointsM( const char * pszInput,
 /* -------------------------------------------------------------------- */
 /*      Add point to list.                                              */
 /* -------------------------------------------------------------------- */
-        (*ppaoPoints)[*pnPointsRead].x = CPLAtof(szTokenX);
-        (*ppaoPoints)[*pnPointsRead].y = CPLAtof(szTokenY);
+        (*ppaoPoints)[*pnPointsRead].x = OGRWktAtof(szTokenX);
+        (*ppaoPoints)[*pnPointsRead].y = OGRWktAtof(szTokenY);
 
 /* -------------------------------------------------------------------- */
 /*      Read the next token.                                            */
@@ -761,7 +1047,7 @@ const char * OGRWktReadPointsM( const char * pszInput,
             }
             if( isdigit(szDelim[0]) || szDelim[0] == '-' || szDelim[0] == '.' )
             {
-                (*ppadfZ)[*pnPointsRead] = CPLAtof(szDelim);
+                (*ppadfZ)[*pnPointsRead] = OGRWktAtof(szDelim);
                 pszInput = OGRWktReadToken( pszInput, szDelim );
             }
             else
@@ -807,7 +1093,7 @@ const char * OGRWktReadPointsM( const char * pszInput,
             }
             if( isdigit(szDelim[0]) || szDelim[0] == '-' || szDelim[0] == '.' )
             {
-                (*ppadfM)[*pnPointsRead] = CPLAtof(szDelim);
+                (*ppadfM)[*pnPointsRead] = OGRWktAtof(szDelim);
                 pszInput = OGRWktReadToken( pszInput, szDelim );
             }
             else
@@ -836,7 +1122,7 @@ const char * OGRWktReadPointsM( const char * pszInput,
                     CPLCalloc(sizeof(double), *pnMaxPoints) );
             }
             (*ppadfZ)[*pnPointsRead] = (*ppadfM)[*pnPointsRead];
-            (*ppadfM)[*pnPointsRead] = CPLAtof(szDelim);
+            (*ppadfM)[*pnPointsRead] = OGRWktAtof(szDelim);
             pszInput = OGRWktReadToken( pszInput, szDelim );
         }
 
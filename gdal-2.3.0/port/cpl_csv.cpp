@@ -44,6 +44,33 @@
 
 CPL_CVSID("$Id: cpl_csv.cpp 090ecb96506b67d811929bf888e6192d4a02f1b1 2018-02-11 20:01:07Z Even Rouault $")
 
+/* ==================================================================== */
+/*      The CSVIngestedData is the in-memory copy of a whole CSV        */
+/*      file, with its line index.  It is read-only once built, and     */
+/*      shared, reference counted, by the CSVTable of all threads       */
+/*      accessing the same file.  The list and the reference counts     */
+/*      are protected by hCSVIngestedMutex; the content itself is       */
+/*      read without lock.                                              */
+/* ==================================================================== */
+typedef struct cid {
+    struct cid *psNext;
+    char       *pszFilename;
+    int         nRefCount;
+    bool        bListed;
+
+    /* Size and modification time of the file when it was ingested. */
+    vsi_l_offset nFileSize;
+    GIntBig     nMTime;
+
+    int         nLineCount;
+    char      **papszLines;
+    int        *panLineIndex;
+    char       *pszRawData;
+} CSVIngestedData;
+
+static CPLMutex *hCSVIngestedMutex = nullptr;
+static CSVIngestedData *psCSVIngestedList = nullptr;
+
 /* ==================================================================== */
 /*      The CSVTable is a persistent set of info about an open CSV      */
 /*      table.  While it doesn't currently maintain a record index,     */
@@ -61,7 +88,8 @@ typedef struct ctb {
     int         iLastLine;
     bool        bNonUniqueKey;
 
-    /* Cache for whole file */
+    /* Cache for whole file, pointing into psIngested */
+    CSVIngestedData *psIngested;
     int         nLineCount;
     char      **papszLines;
     int        *panLineIndex;
@@ -80,8 +108,71 @@ static void CSVFreeTLS( void* pData )
     CPLFree(pData);
 }
 
-/* It would likely be better to share this list between threads, but
-   that will require some rework. */
+/* The list of tables is per thread, but the ingested content of the    */
+/* files, which is the expensive part, is shared between threads.      */
+
+/************************************************************************/
+/*                     CSVReleaseIngestedData()                         */
+/************************************************************************/
+
+static void CSVFreeIngestedData( CSVIngestedData* psData )
+{
+    CPLFree( psData->pszFilename );
+    CPLFree( psData->panLineIndex );
+    CPLFree( psData->pszRawData );
+    CPLFree( psData->papszLines );
+    CPLFree( psData );
+}
+
+/* Must be called with hCSVIngestedMutex held. */
+static void CSVUnlistIngestedData( CSVIngestedData* psData )
+{
+    if( !psData->bListed )
+        return;
+
+    CSVIngestedData** ppsIter = &psCSVIngestedList;
+    while( *ppsIter != psData )
+        ppsIter = &((*ppsIter)->psNext);
+    *ppsIter = psData->psNext;
+    psData->psNext = nullptr;
+    psData->bListed = false;
+}
+
+/* When bUnlist is set, the content is also made unreachable for later */
+/* ingestions, so that they read the file again, but stays valid for    */
+/* the tables of the other threads that still reference it.             */
+static void CSVReleaseIngestedData( CSVIngestedData* psData, bool bUnlist )
+{
+    {
+        CPLMutexHolderD( &hCSVIngestedMutex );
+
+        if( bUnlist )
+            CSVUnlistIngestedData( psData );
+
+        psData->nRefCount--;
+        if( psData->nRefCount > 0 )
+            return;
+
+        CSVUnlistIngestedData( psData );
+    }
+
+    CSVFreeIngestedData( psData );
+}
+
+/************************************************************************/
+/*                         CPLCleanupCSVMutex()                         */
+/************************************************************************/
+
+// Not exported: called from GDALDestroyDriverManager(), after which no
+// table should be referenced anymore.
+void CPLCleanupCSVMutex( void );
+
+void CPLCleanupCSVMutex( void )
+{
+    if( hCSVIngestedMutex != nullptr )
+        CPLDestroyMutex( hCSVIngestedMutex );
+    hCSVIngestedMutex = nullptr;
+}
 
 /************************************************************************/
 /*                             CSVAccess()                              */
@@ -242,9 +333,10 @@ static void CSVDeaccessInternal( CSVTable **ppsCSVTableList, bool bCanUseTLS,
     CPLFree( psTable->panFieldNamesLength );
     CSLDestroy( psTable->papszRecFields );
     CPLFree( psTable->pszFilename );
-    CPLFree( psTable->panLineIndex );
-    CPLFree( psTable->pszRawData );
-    CPLFree( psTable->papszLines );
+    // An explicit deaccess means the caller wants the file to be read
+    // again on next access, possibly because it has been modified.
+    if( psTable->psIngested != nullptr )
+        CSVReleaseIngestedData( psTable->psIngested, bCanUseTLS );
 
     CPLFree( psTable );
 
@@ -437,49 +529,54 @@ static char *CSVFindNextLine( char *pszThisLine )
 /************************************************************************/
 
 // TODO(schwehr): Clean up all the casting in CSVIngest.
-static void CSVIngest( CSVTable *psTable )
+static CSVIngestedData *CSVIngestFile( VSILFILE* fp, const char* pszFilename )
 
 {
-    if( psTable->pszRawData != nullptr )
-        return;
-
 /* -------------------------------------------------------------------- */
 /*      Ingest whole file.                                              */
 /* -------------------------------------------------------------------- */
-    if( VSIFSeekL( psTable->fp, 0, SEEK_END ) != 0 )
+    if( VSIFSeekL( fp, 0, SEEK_END ) != 0 )
     {
         CPLError( CE_Failure, CPLE_FileIO,
                   "Failed using seek end and tell to get file length: %s",
-                  psTable->pszFilename );
-        return;
+                  pszFilename );
+        return nullptr;
     }
-    const vsi_l_offset nFileLen = VSIFTellL( psTable->fp );
+    const vsi_l_offset nFileLen = VSIFTellL( fp );
     if( static_cast<long>(nFileLen) == -1 )
     {
         CPLError( CE_Failure, CPLE_FileIO,
                   "Failed using seek end and tell to get file length: %s",
-                  psTable->pszFilename );
-        return;
+                  pszFilename );
+        return nullptr;
     }
-    VSIRewindL( psTable->fp );
+    VSIRewindL( fp );
 
-    psTable->pszRawData = static_cast<char *>(
+    CSVIngestedData* psData = static_cast<CSVIngestedData *>(
+        VSI_CALLOC_VERBOSE( sizeof(CSVIngestedData), 1 ) );
+    if( psData == nullptr )
+        return nullptr;
+
+    psData->pszRawData = static_cast<char *>(
         VSI_MALLOC_VERBOSE( static_cast<size_t>(nFileLen) + 1) );
-    if( psTable->pszRawData == nullptr )
-        return;
-    if( VSIFReadL( psTable->pszRawData, 1,
-                   static_cast<size_t>(nFileLen), psTable->fp )
+    if( psData->pszRawData == nullptr )
+    {
+        CPLFree( psData );
+        return nullptr;
+    }
+    if( VSIFReadL( psData->pszRawData, 1,
+                   static_cast<size_t>(nFileLen), fp )
         != static_cast<size_t>(nFileLen) )
     {
-        CPLFree( psTable->pszRawData );
-        psTable->pszRawData = nullptr;
+        CPLFree( psData->pszRawData );
+        CPLFree( psData );
 
         CPLError( CE_Failure, CPLE_FileIO, "Read of file %s failed.",
-                  psTable->pszFilename );
-        return;
+                  pszFilename );
+        return nullptr;
     }
 
-    psTable->pszRawData[nFileLen] = '\0';
+    psData->pszRawData[nFileLen] = '\0';
 
 /* -------------------------------------------------------------------- */
 /*      Get count of newlines so we can allocate line array.            */
@@ -487,14 +584,18 @@ static void CSVIngest( CSVTable *psTable )
     int nMaxLineCount = 0;
     for( int i = 0; i < static_cast<int>(nFileLen); i++ )
     {
-        if( psTable->pszRawData[i] == 10 )
+        if( psData->pszRawData[i] == 10 )
             nMaxLineCount++;
     }
 
-    psTable->papszLines = static_cast<char **>(
+    psData->papszLines = static_cast<char **>(
         VSI_CALLOC_VERBOSE( sizeof(char*), nMaxLineCount ) );
-    if( psTable->papszLines == nullptr )
-        return;
+    if( psData->papszLines == nullptr && nMaxLineCount > 0 )
+    {
+        CPLFree( psData->pszRawData );
+        CPLFree( psData );
+        return nullptr;
+    }
 
 /* -------------------------------------------------------------------- */
 /*      Build a list of record pointers into the raw data buffer        */
@@ -502,40 +603,126 @@ static void CSVIngest( CSVTable *psTable )
 /*      strings.                                                        */
 /* -------------------------------------------------------------------- */
     /* skip header line */
-    char *pszThisLine = CSVFindNextLine( psTable->pszRawData );
+    char *pszThisLine = CSVFindNextLine( psData->pszRawData );
 
     int iLine = 0;
     while( pszThisLine != nullptr && iLine < nMaxLineCount )
     {
         if( pszThisLine[0] != '#' )
-            psTable->papszLines[iLine++] = pszThisLine;
+            psData->papszLines[iLine++] = pszThisLine;
         pszThisLine = CSVFindNextLine( pszThisLine );
     }
 
-    psTable->nLineCount = iLine;
+    psData->nLineCount = iLine;
 
 /* -------------------------------------------------------------------- */
 /*      Allocate and populate index array.  Ensure they are in          */
 /*      ascending order so that binary searches can be done on the      */
 /*      array.                                                          */
 /* -------------------------------------------------------------------- */
-    psTable->panLineIndex = static_cast<int *>(
-        VSI_MALLOC_VERBOSE( sizeof(int) * psTable->nLineCount ) );
-    if( psTable->panLineIndex == nullptr )
+    psData->panLineIndex = static_cast<int *>(
+        VSI_MALLOC_VERBOSE( sizeof(int) * psData->nLineCount ) );
+    if( psData->panLineIndex != nullptr )
+    {
+        for( int i = 0; i < psData->nLineCount; i++ )
+        {
+            psData->panLineIndex[i] = atoi(psData->papszLines[i]);
+
+            if( i > 0 &&
+                psData->panLineIndex[i] < psData->panLineIndex[i-1] )
+            {
+                CPLFree( psData->panLineIndex );
+                psData->panLineIndex = nullptr;
+                break;
+            }
+        }
+    }
+
+    psData->pszFilename = CPLStrdup( pszFilename );
+    return psData;
+}
+
+static void CSVIngest( CSVTable *psTable )
+
+{
+    if( psTable->pszRawData != nullptr )
         return;
 
-    for( int i = 0; i < psTable->nLineCount; i++ )
+/* -------------------------------------------------------------------- */
+/*      Reuse the content ingested by another thread if available       */
+/*      and if the file has not changed since, otherwise ingest the     */
+/*      file and make it available to others.  The file is read         */
+/*      without holding the lock, so that ingesting one file does not   */
+/*      block the lookups of other threads.                             */
+/* -------------------------------------------------------------------- */
+    VSIStatBufL sStat;
+    if( VSIStatL( psTable->pszFilename, &sStat ) != 0 )
+    {
+        sStat.st_size = 0;
+        sStat.st_mtime = 0;
+    }
+    const vsi_l_offset nFileSize = static_cast<vsi_l_offset>(sStat.st_size);
+    const GIntBig nMTime = static_cast<GIntBig>(sStat.st_mtime);
+
+    CSVIngestedData* psData = nullptr;
+    for( int iPass = 0; psData == nullptr && iPass < 2; iPass++ )
     {
-        psTable->panLineIndex[i] = atoi(psTable->papszLines[i]);
+        CSVIngestedData* psNewData = nullptr;
+        if( iPass == 1 )
+        {
+            psNewData = CSVIngestFile( psTable->fp, psTable->pszFilename );
+            if( psNewData == nullptr )
+                return;
+            psNewData->nFileSize = nFileSize;
+            psNewData->nMTime = nMTime;
+        }
 
-        if( i > 0 && psTable->panLineIndex[i] < psTable->panLineIndex[i-1] )
+        CPLMutexHolderD( &hCSVIngestedMutex );
+
+        for( psData = psCSVIngestedList;
+             psData != nullptr;
+             psData = psData->psNext )
         {
-            CPLFree( psTable->panLineIndex );
-            psTable->panLineIndex = nullptr;
-            break;
+            if( EQUAL(psData->pszFilename, psTable->pszFilename) )
+                break;
         }
+
+        // Drop an outdated copy from the list.  Listed copies are always
+        // referenced, and the tables still using it keep it alive.
+        if( psData != nullptr &&
+            (psData->nFileSize != nFileSize || psData->nMTime != nMTime) )
+        {
+            CSVUnlistIngestedData( psData );
+            psData = nullptr;
+        }
+
+        if( psNewData != nullptr )
+        {
+            if( psData == nullptr )
+            {
+                psData = psNewData;
+                psData->bListed = true;
+                psData->psNext = psCSVIngestedList;
+                psCSVIngestedList = psData;
+            }
+            else
+            {
+                // Another thread ingested the file in the meantime.
+                CSVFreeIngestedData( psNewData );
+            }
+        }
+
+        if( psData != nullptr )
+            psData->nRefCount++;
     }
+    if( psData == nullptr )
+        return;
 
+    psTable->psIngested = psData;
+    psTable->nLineCount = psData->nLineCount;
+    psTable->papszLines = psData->papszLines;
+    psTable->panLineIndex = psData->panLineIndex;
+    psTable->pszRawData = psData->pszRawData;
     psTable->iLastLine = -1;
 
 /* -------------------------------------------------------------------- */
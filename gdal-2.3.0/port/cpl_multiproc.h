@@ -206,7 +206,7 @@ class CPL_DLL CPLLockHolder
 #define CTLS_GDALDATASET_REC_PROTECT_MAP 6        /* gdaldataset.cpp */
 #define CTLS_PATHBUF                     7         /* cpl_path.cpp */
 #define CTLS_ABSTRACTARCHIVE_SPLIT       8         /* cpl_vsil_abstract_archive.cpp */
-#define CTLS_UNUSED4                     9
+#define CTLS_GEOSCONTEXT                 9         /* ogrgeometry.cpp */
 #define CTLS_CPLSPRINTF                 10         /* cpl_string.h */
 #define CTLS_RESPONSIBLEPID             11         /* gdaldataset.cpp */
 #define CTLS_VERSIONINFO                12         /* gdal_misc.cpp */
@@ -214,6 +214,9 @@ class CPL_DLL CPLLockHolder
 #define CTLS_CONFIGOPTIONS              14         /* cpl_conv.cpp */
 #define CTLS_FINDFILE                   15         /* cpl_findfile.cpp */
 #define CTLS_VSIERRORCONTEXT            16         /* cpl_vsi_error.cpp */
+#define CTLS_PROXYPOOL_DISABLEREFCOUNT  17         /* gdalproxypool.cpp */
+#define CTLS_VRTSOURCEREADJOB           18         /* vrtdataset.cpp */
+#define CTLS_RECYCLEDSTRINGS            19         /* ogrfeature.cpp */
 
 #define CTLS_MAX                        32
 
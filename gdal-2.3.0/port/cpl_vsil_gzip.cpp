@@ -92,6 +92,9 @@
 #  include <sys/stat.h>
 #endif
 #include <zlib.h>
+#ifdef HAVE_LIBDEFLATE
+#  include "libdeflate.h"
+#endif
 
 #include <algorithm>
 #include <map>
@@ -2693,6 +2696,40 @@ void* CPLZLibDeflate( const void* ptr,
                       size_t nOutAvailableBytes,
                       size_t* pnOutBytes )
 {
+#ifdef HAVE_LIBDEFLATE
+    // libdeflate compresses the whole buffer in a single call, much faster
+    // than zlib. Use level 6, the default of zlib, since nLevel is ignored
+    // by the zlib code path too. If it does not fit in the provided output
+    // buffer, let zlib try.
+    struct libdeflate_compressor* enc = libdeflate_alloc_compressor(6);
+    if( enc != nullptr )
+    {
+        void* pOut = outptr;
+        size_t nOutSize = nOutAvailableBytes;
+        if( pOut == nullptr )
+        {
+            nOutSize = libdeflate_zlib_compress_bound(enc, nBytes);
+            pOut = VSIMalloc(nOutSize);
+        }
+        const size_t nOutBytes = pOut == nullptr ? 0 :
+            libdeflate_zlib_compress(enc, ptr, nBytes, pOut, nOutSize);
+        libdeflate_free_compressor(enc);
+        if( nOutBytes != 0 )
+        {
+            if( pnOutBytes != nullptr )
+                *pnOutBytes = nOutBytes;
+            return pOut;
+        }
+        if( pOut != outptr )
+        {
+            VSIFree(pOut);
+            if( pnOutBytes != nullptr )
+                *pnOutBytes = 0;
+            return nullptr;
+        }
+    }
+#endif
+
     z_stream strm;
     strm.zalloc = nullptr;
     strm.zfree = nullptr;
@@ -2768,6 +2805,41 @@ void* CPLZLibInflate( const void* ptr, size_t nBytes,
                       void* outptr, size_t nOutAvailableBytes,
                       size_t* pnOutBytes )
 {
+#ifdef HAVE_LIBDEFLATE
+    // When the output buffer is provided, its size bounds the whole
+    // uncompressed stream, so libdeflate can decode it in a single call.
+    // Anything it does not accept (e.g. concatenated gzip members) is left
+    // to zlib.
+    if( outptr != nullptr && nBytes >= 2 )
+    {
+        struct libdeflate_decompressor* dec = libdeflate_alloc_decompressor();
+        if( dec != nullptr )
+        {
+            const GByte* pabyIn = static_cast<const GByte*>(ptr);
+            size_t nOutBytes = 0;
+            enum libdeflate_result res;
+            if( pabyIn[0] == 0x1f && pabyIn[1] == 0x8b )
+                res = libdeflate_gzip_decompress(dec, ptr, nBytes,
+                                                 outptr, nOutAvailableBytes,
+                                                 &nOutBytes);
+            else
+                res = libdeflate_zlib_decompress(dec, ptr, nBytes,
+                                                 outptr, nOutAvailableBytes,
+                                                 &nOutBytes);
+            libdeflate_free_decompressor(dec);
+            if( res == LIBDEFLATE_SUCCESS )
+            {
+                // Nul-terminate if possible.
+                if( nOutBytes < nOutAvailableBytes )
+                    static_cast<char*>(outptr)[nOutBytes] = '\0';
+                if( pnOutBytes != nullptr )
+                    *pnOutBytes = nOutBytes;
+                return outptr;
+            }
+        }
+    }
+#endif
+
     z_stream strm;
     strm.zalloc = nullptr;
     strm.zfree = nullptr;